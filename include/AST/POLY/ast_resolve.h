@@ -45,6 +45,20 @@ errorcode_t ast_resolve_expr_list_polymorphs(
     ast_expr_list_t *exprs
 );
 
+// ---------------- ast_resolve_expr_list_polymorphs_into ----------------
+// Creates a version of a list of template statements with any polymorphic variables resolved.
+// Statements that don't involve any polymorphic variables are borrowed from the template
+// instead of being cloned (see 'ast_expr_share'), so only the parts that differ get duplicated
+// NOTE: Gives the same result to rtti_collector as 'ast_resolve_expr_list_polymorphs' would
+errorcode_t ast_resolve_expr_list_polymorphs_into(
+    compiler_t *compiler,
+    rtti_collector_t *rtti_collector,
+    ast_poly_catalog_t *catalog,
+    ast_expr_list_t *template_exprs,
+    ast_expr_list_t *out_exprs,
+    ast_expr_list_t *shared_exprs
+);
+
 #ifdef __cplusplus
 }
 #endif
@@ -25,20 +25,21 @@ extern "C" {
 
 // ---------------- ast_type_make_base ----------------
 // Makes a simple base type (e.g. void, int, ubyte, GameData, ptr)
-ast_type_t ast_type_make_base(strong_cstr_t base);
+// NOTE: Base names are interned, 'base' is not taken ownership of
+ast_type_t ast_type_make_base(const char *base);
 
 // ---------------- ast_type_make_base_ptr ----------------
 // Makes a pointer-to-simple-base type (e.g. *ubyte, *int, *GameData)
-ast_type_t ast_type_make_base_ptr(strong_cstr_t base);
+ast_type_t ast_type_make_base_ptr(const char *base);
 
 // ---------------- ast_type_make_base_ptr_ptr ----------------
 // Makes a pointer-to-pointer-to-simple-base type (e.g. **ubyte, **int)
-ast_type_t ast_type_make_base_ptr_ptr(strong_cstr_t base);
+ast_type_t ast_type_make_base_ptr_ptr(const char *base);
 
 // ---------------- ast_type_make_base_with_polymorphs ----------------
 // Makes base type with polymorphic parameter subtypes (e.g. <$T> List, <$K, $V> Pair)
 // NOTE: Creates copies of strings that are inside 'generics'
-ast_type_t ast_type_make_base_with_polymorphs(strong_cstr_t base, weak_cstr_t *generics, length_t length);
+ast_type_t ast_type_make_base_with_polymorphs(const char *base, weak_cstr_t *generics, length_t length);
 
 // ---------------- ast_type_make_polymorph ----------------
 // Makes a polymorphic parameter type (e.g. $T, $K)
@@ -97,12 +98,13 @@ ast_elem_t *ast_elem_empty_make(unsigned int id, source_t source);
 
 // ---------------- ast_elem_base_make ----------------
 // Makes a base element (e.g. void, int, ubyte, GameData, ptr)
-ast_elem_t *ast_elem_base_make(strong_cstr_t base, source_t source);
+// NOTE: Base names are interned, 'base' is not taken ownership of
+ast_elem_t *ast_elem_base_make(const char *base, source_t source);
 
 // ---------------- ast_elem_generic_base_make ----------------
 // Makes a generic base element (e.g. <int> List, <$T> List, <$K, $V> Pair, <float> Array)
 // NOTE: Ownership of both the elements and the array 'generics' are taken
-ast_elem_t *ast_elem_generic_base_make(strong_cstr_t base, source_t source, ast_type_t *generics, length_t generics_length);
+ast_elem_t *ast_elem_generic_base_make(const char *base, source_t source, ast_type_t *generics, length_t generics_length);
 
 // ---------------- ast_elem_polymorph_make ----------------
 // Makes a polymorph element (e.g. $T, $K, $V, $InitializerList)
@@ -0,0 +1,79 @@
+
+#ifndef _ISAAC_AST_TYPE_TABLE_H
+#define _ISAAC_AST_TYPE_TABLE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ============================ ast_type_table.h ============================
+    Definitions for hash-consing AST types
+
+    Each distinct AST type is stored once in a table and handed out as a
+    canonical type. Canonical types from the same table are equal if and
+    only if they are the same pointer, and their hashes are cached.
+
+    For most types, being equal is the same as being identical (see
+    'ast_types_identical'), so they can be compared by pointer. The rest
+    are marked as not exact, and are compared the regular way.
+    --------------------------------------------------------------------------
+*/
+
+#include <stdbool.h>
+
+#include "AST/ast_type_lean.h"
+#include "UTIL/arena.h"
+#include "UTIL/ground.h"
+#include "UTIL/hash.h"
+#include "UTIL/set.h"
+
+// ---------------- ast_canonical_type_t ----------------
+// Storage for a canonical AST type
+// NOTE: 'type' must be first, so canonical types can be used as 'ast_type_t*'
+typedef struct {
+    ast_type_t type;
+    hash_t hash;
+    bool exact; // Whether 'type' is only identical to itself (unlike 'usize', which is identical to 'ulong')
+} ast_canonical_type_t;
+
+// ---------------- ast_type_table_t ----------------
+// Hash-consed storage for AST types
+// Zero-initialized tables are valid and empty.
+typedef struct {
+    set_t impl;      // Set of ast_canonical_type_t*
+    arena_t storage; // Storage for canonical types
+} ast_type_table_t;
+
+// ---------------- ast_type_table_free ----------------
+// Frees an AST type table, along with all of its canonical types
+void ast_type_table_free(ast_type_table_t *table);
+
+// ---------------- ast_type_table_canonical ----------------
+// Returns the canonical version of an AST type,
+// adding a copy of it to the table if necessary
+// NOTE: The returned type is valid until the table is freed and must not be modified
+// NOTE: Sources aren't considered, the canonical type keeps the first source it was seen with
+const ast_type_t *ast_type_table_canonical(ast_type_table_t *table, const ast_type_t *type);
+
+// ---------------- ast_type_table_find ----------------
+// Returns the canonical version of an AST type,
+// or NULL if the table doesn't have it
+// NOTE: Never modifies the table
+const ast_type_t *ast_type_table_find(const ast_type_table_t *table, const ast_type_t *type);
+
+// ---------------- ast_canonical_type_hash ----------------
+// Returns the cached hash of a canonical AST type
+// (Same value as 'ast_type_hash')
+#define ast_canonical_type_hash(CANONICAL_TYPE) (((const ast_canonical_type_t*) (CANONICAL_TYPE))->hash)
+
+// ---------------- ast_canonical_types_identical ----------------
+// Equivalent to 'ast_types_identical' for canonical types from the same table
+// NOTE: Exact canonical types are compared by pointer
+bool ast_canonical_types_identical(const ast_type_t *a, const ast_type_t *b);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_AST_TYPE_TABLE_H
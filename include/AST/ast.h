@@ -15,11 +15,13 @@ extern "C" {
 #include <stdbool.h>
 #include <stdio.h>
 
+#include "AST/ast_composite_index.h"
 #include "AST/ast_expr.h"
 #include "AST/ast_layout.h"
 #include "AST/ast_named_expression.h"
 #include "AST/ast_type.h"
 #include "AST/meta_directives.h"
+#include "UTIL/arena.h"
 #include "UTIL/color.h"
 #include "UTIL/ground.h"
 #include "UTIL/index_id_list.h"
@@ -30,7 +32,7 @@ struct compiler;
 // ---------------- ast_func_t ----------------
 // A function within the root AST
 typedef struct {
-    strong_cstr_t name;
+    weak_cstr_t name; // Interned (see 'intern_name')
     strong_cstr_t *arg_names;
     ast_type_t *arg_types;
     source_t *arg_sources;
@@ -110,7 +112,7 @@ typedef struct {
 // ------------------ ast_func_head_t ------------------
 // Information about the head of function declaration
 typedef struct {
-    strong_cstr_t name;
+    weak_cstr_t name;
     source_t source;
     bool is_foreign : 1,
          is_entry   : 1;
@@ -122,7 +124,7 @@ typedef struct {
 // Common fields for all ast_composite_*_t derivatives
 // NOTE: `parent` may be AST_TYPE_NONE
 #define DERIVE_AST_COMPOSITE struct { \
-    strong_cstr_t name; \
+    weak_cstr_t name; /* Interned (see 'intern_name') */ \
     ast_layout_t layout; \
     source_t source; \
     ast_type_t parent; \
@@ -182,7 +184,7 @@ typedef struct {
 // ---------------- ast_enum_t ----------------
 // An enum AST node
 typedef struct {
-    weak_cstr_t name;
+    weak_cstr_t name; // Interned (see 'intern_name')
     weak_cstr_t *kinds;
     length_t length;
     source_t source;
@@ -250,6 +252,17 @@ typedef struct {
     ast_poly_composite_t *poly_composites;
     length_t poly_composites_length;
     length_t poly_composites_capacity;
+
+    // Lookup for both kinds of composites (maintained by 'ast_add_composite' and 'ast_add_poly_composite')
+    // Regular composites are stored with zero generics
+    ast_composite_index_t composite_index;
+
+    // Statements that polymorphic instantiations borrow from their templates (see 'ast_expr_share')
+    ast_expr_list_t shared_exprs;
+
+    // Where expressions and type elements created while parsing are allocated
+    // (see 'ast_node_arena_use'), released all at once by 'ast_free'
+    arena_t node_arena;
 } ast_t;
 
 #define LIBRARY_KIND_NONE           0x00
@@ -301,6 +314,7 @@ func_id_t ast_new_func(ast_t *ast);
 
 // ---------------- ast_func_create_template ----------------
 // Fills out a blank template for a new function
+// NOTE: The function's name is interned, 'options->name' is not taken ownership of
 void ast_func_create_template(struct compiler *compiler, ast_func_t *func, const ast_func_head_t *options);
 
 // ---------------- ast_func_has_polymorphic_signature ----------------
@@ -317,10 +331,12 @@ void ast_enum_init(ast_enum_t *enum_definition, weak_cstr_t name, weak_cstr_t *k
 
 // ---------------- ast_composite_find_exact ----------------
 // Finds a composite by its exact name
+// NOTE: 'name' must be interned (see 'intern_name')
 ast_composite_t *ast_composite_find_exact(ast_t *ast, const char *name);
 
 // ---------------- ast_poly_composite_find_exact (and friends) ----------------
 // Finds a polymorphic composite by its exact name
+// NOTE: 'name' must be interned (see 'intern_name')
 ast_poly_composite_t *ast_poly_composite_find_exact_from_elem(ast_t *ast, ast_elem_generic_base_t *elem);
 ast_poly_composite_t *ast_poly_composite_find_exact(ast_t *ast, const char *name, length_t num_generics);
 
@@ -366,7 +382,8 @@ void ast_add_alias(ast_t *ast, strong_cstr_t name, ast_type_t strong_type, stron
 
 // ---------------- ast_add_enum ----------------
 // Adds an enum to the global scope of an AST
-void ast_add_enum(ast_t *ast, weak_cstr_t name, weak_cstr_t *kinds, length_t length, source_t source);
+// NOTE: The enum's name is interned, 'name' is not taken ownership of
+void ast_add_enum(ast_t *ast, const char *name, weak_cstr_t *kinds, length_t length, source_t source);
 
 // ---------------- ast_add_global_named_expression ----------------
 // Adds a named expression to the global scope of an AST
@@ -379,9 +396,10 @@ void ast_add_poly_func(ast_t *ast, weak_cstr_t func_name_persistent, func_id_t a
 // ---------------- ast_add_composite ----------------
 // Adds a composite to the global scope of an AST
 // NOTE: 'maybe_parent' may be 'AST_TYPE_NONE'
+// NOTE: The composite's name is interned, 'name' is not taken ownership of
 ast_composite_t *ast_add_composite(
     ast_t *ast,
-    strong_cstr_t name,
+    const char *name,
     ast_layout_t layout,
     source_t source,
     ast_type_t maybe_parent,
@@ -391,9 +409,10 @@ ast_composite_t *ast_add_composite(
 // ---------------- ast_add_poly_composite ----------------
 // Adds a polymorphic composite to the global scope of an AST
 // NOTE: 'maybe_parent' may be 'AST_TYPE_NONE'
+// NOTE: The composite's name is interned, 'name' is not taken ownership of
 ast_poly_composite_t *ast_add_poly_composite(
     ast_t *ast,
-    strong_cstr_t name,
+    const char *name,
     ast_layout_t layout,
     source_t source,
     ast_type_t maybe_parent,
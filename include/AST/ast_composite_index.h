@@ -0,0 +1,56 @@
+
+#ifndef _ISAAC_AST_COMPOSITE_INDEX_H
+#define _ISAAC_AST_COMPOSITE_INDEX_H
+
+/*
+    ============================= ast_composite_index.h ==============================
+    Module for looking up composites by name and number of generics
+    ---------------------------------------------------------------------------
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "UTIL/arena.h"
+#include "UTIL/ground.h"
+#include "UTIL/set.h"
+
+// ---------------- ast_composite_index_entry_t ----------------
+// An entry in a composite index
+typedef struct {
+    weak_cstr_t name;
+    length_t generics_length;
+    length_t position;
+} ast_composite_index_entry_t;
+
+// ---------------- ast_composite_index_t ----------------
+// Hash index from (name, generics count) to the position of a composite.
+// Positions are used instead of pointers so that entries stay valid
+// when the composite arrays they refer to are reallocated.
+// Zero-initialized composite indices are valid and empty.
+// NOTE: Names must be interned (see 'intern_name')
+typedef struct {
+    set_t impl;      // Set of ast_composite_index_entry_t*
+    arena_t entries; // Storage for entries
+} ast_composite_index_t;
+
+// ---------------- ast_composite_index_free ----------------
+// Frees a composite index
+void ast_composite_index_free(ast_composite_index_t *index);
+
+// ---------------- ast_composite_index_insert ----------------
+// Records the position of a composite
+// If a composite with the same name and generics count already
+// exists, the index is left unchanged (the earliest one wins)
+void ast_composite_index_insert(ast_composite_index_t *index, weak_cstr_t name, length_t generics_length, length_t position);
+
+// ---------------- ast_composite_index_find ----------------
+// Finds the position of a composite, returns -1 if none exists
+maybe_index_t ast_composite_index_find(ast_composite_index_t *index, const char *name, length_t generics_length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_AST_COMPOSITE_INDEX_H
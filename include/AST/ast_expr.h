@@ -205,6 +205,7 @@ typedef struct {
 
 // ---------------- ast_expr_variable_t ----------------
 // Expression for accessing a variable
+// NOTE: 'name' is interned (see 'intern_name')
 typedef struct { DERIVE_AST_EXPR; weak_cstr_t name; } ast_expr_variable_t;
 
 // ---------------- ast_expr_member_t ----------------
@@ -595,6 +596,7 @@ void ast_expr_create_call_method_in_place(ast_expr_call_method_t *out_expr, stro
 
 // ---------------- ast_expr_create_variable ----------------
 // Creates a variable expression
+// NOTE: The variable's name is interned
 ast_expr_t *ast_expr_create_variable(weak_cstr_t name, source_t source);
 
 // ---------------- ast_expr_create_enum_value ----------------
@@ -720,6 +722,18 @@ ast_expr_list_t ast_expr_list_create(length_t initial_capacity);
 // All contained expressions will be fully freed
 void ast_expr_list_free(ast_expr_list_t *list);
 
+// ---------------- ast_expr_share ----------------
+// Marks an expression as being borrowed by more than one owner,
+// and adds it to 'shared_exprs' the first time it becomes shared.
+// Shared expressions are ignored by 'ast_expr_free_fully',
+// so they stay alive until 'ast_shared_exprs_free' is called on the list
+void ast_expr_share(ast_expr_t *expr, ast_expr_list_t *shared_exprs);
+
+// ---------------- ast_shared_exprs_free ----------------
+// Frees a list of expressions given to 'ast_expr_share'
+// NOTE: Must be called after all of their owners have been freed
+void ast_shared_exprs_free(ast_expr_list_t *shared_exprs);
+
 // ---------------- ast_expr_list_append ----------------
 // Appends an expression to an ast_expr_list_t
 #define ast_expr_list_append(LIST, VALUE) list_append((LIST), (VALUE), ast_expr_t*)
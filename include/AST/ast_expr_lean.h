@@ -17,6 +17,8 @@ extern "C" {
 
 #define DERIVE_AST_EXPR struct { \
     unsigned int id;  /* What type of expression */ \
+    bool in_arena;    /* Whether allocated inside of an AST node arena */ \
+    bool is_shared;   /* Whether borrowed by more than one owner (see 'ast_expr_share') */ \
     source_t source;  /* Where in source code */ \
 }
 
@@ -14,6 +14,7 @@
 #include "AST/ast_type_lean.h"
 #include "UTIL/ground.h"
 #include "UTIL/hash.h"
+#include "UTIL/set.h"
 #include "UTIL/trait.h"
 
 // ---------------- AST_LAYOUT_ENDPOINT_END_INDEX ----------------
@@ -102,6 +103,20 @@ typedef struct {
     ast_layout_endpoint_t endpoint; // Where the name maps to
 } ast_field_arrow_t;
 
+// ---------------- AST_FIELD_MAP_INDEX_THRESHOLD ----------------
+// Number of arrows a field map needs before lookups build a hash index for it
+#define AST_FIELD_MAP_INDEX_THRESHOLD 16
+
+// ---------------- ast_field_map_index_t ----------------
+// Hash index over the arrows of a large 'ast_field_map_t',
+// both from names and from endpoints.
+// Sets hold pointers into 'arrows', so the index is rebuilt whenever the arrows move
+typedef struct {
+    set_t by_name;     // Set of ast_field_arrow_t*
+    set_t by_endpoint; // Set of ast_field_arrow_t*
+    const ast_field_arrow_t *arrows;
+} ast_field_map_index_t;
+
 // ---------------- ast_field_map_t ----------------
 // A collection of 'ast_field_arrow_t's that represent
 // what names map to what locations.
@@ -113,6 +128,9 @@ typedef struct {
 
     // Whether this field map doesn't contain any overlapping fields
     bool is_simple;
+
+    // Lazily created once a lookup is done on a large field map
+    ast_field_map_index_t *maybe_index;
 } ast_field_map_t;
 
 // ---------------- ast_field_map_init ----------------
@@ -308,13 +326,18 @@ void ast_field_map_add(ast_field_map_t *field_map, strong_cstr_t name, ast_layou
 // an 'ast_field_map_t'
 successful_t ast_field_map_find(ast_field_map_t *field_map, const char *name, ast_layout_endpoint_t *out_endpoint);
 
+// ---------------- ast_field_maps_allow_indexing ----------------
+// Sets whether lookups done by this thread may create indices for large field maps (allowed by default)
+// Lookups that can't create indices never modify field maps, so other threads can do them at the same time
+void ast_field_maps_allow_indexing(bool allow);
+
 // ---------------- ast_field_map_get_name_of_endpoint ----------------
 // Finds the first name which points to an endpoint within
 // an 'ast_field_map_t'
 // Returns NULL if none was found
 maybe_null_weak_cstr_t ast_field_map_get_name_of_endpoint(ast_field_map_t *field_map, ast_layout_endpoint_t endpoint);
 
-// ---------------- ast_field_map_get_name_of_endpoint ----------------
+// ---------------- ast_field_map_print ----------------
 // Prints an 'ast_field_map_t' to stdout for debugging
 // 'maybe_skeleton' is optional, but can be supplied in order to include field types
 void ast_field_map_print(ast_field_map_t *field_map, ast_layout_skeleton_t *maybe_skeleton);
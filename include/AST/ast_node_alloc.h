@@ -0,0 +1,58 @@
+
+#ifndef _ISAAC_AST_NODE_ALLOC_H
+#define _ISAAC_AST_NODE_ALLOC_H
+
+/*
+    ============================= ast_node_alloc.h =============================
+    Module for allocating AST expressions and type elements
+    ---------------------------------------------------------------------------
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "UTIL/arena.h"
+#include "UTIL/ground.h"
+
+// NOTE: AST nodes are allocated from the arena most recently given to
+// 'ast_node_arena_use' on the current thread, or from the heap if there isn't one.
+// Nodes remember where they came from via their 'in_arena' field, so that
+// freeing them with 'ast_node_free' only releases heap allocated nodes.
+// Arena allocated nodes are all released at once when their arena is freed,
+// so they must not be used (or freed) after that.
+
+// ---------------- AST_NODE_ARENA_CHUNK_SIZE ----------------
+// Usual size of the chunks that AST node arenas allocate
+#define AST_NODE_ARENA_CHUNK_SIZE (64 * 1024)
+
+// ---------------- ast_node_arena_use ----------------
+// Sets the arena that AST nodes created on this thread are allocated from
+// (NULL for the heap), and returns the one that was previously used
+arena_t *ast_node_arena_use(arena_t *arena);
+
+// ---------------- ast_node_alloc ----------------
+// Allocates zeroed memory for an AST expression or type element.
+// The 'id' and 'source' fields are left for the caller to fill in.
+// NOTE: The node must not be overwritten as a whole afterwards,
+// since that would forget where it was allocated from
+void *ast_node_alloc(length_t size);
+
+// ---------------- ast_node_memclone ----------------
+// Allocates a copy of an AST expression or type element
+void *ast_node_memclone(const void *node, length_t size);
+
+// ---------------- ast_node_alloc_init ----------------
+// Like 'malloc_init', except allocates an AST expression or type element
+#define ast_node_alloc_init(TYPE, ...) (TYPE*) ast_node_memclone((TYPE[]){ __VA_ARGS__ }, sizeof(TYPE))
+
+// ---------------- ast_node_free ----------------
+// Frees the memory of an AST expression or type element
+// (does nothing for nodes that live in an arena)
+void ast_node_free(void *node);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_AST_NODE_ALLOC_H
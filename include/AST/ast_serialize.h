@@ -0,0 +1,79 @@
+
+#ifndef _ISAAC_AST_SERIALIZE_H
+#define _ISAAC_AST_SERIALIZE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ============================= ast_serialize.h =============================
+    Module for converting abstract syntax trees to and from a compact binary form
+
+    Serialized ASTs can be read back without lexing or parsing, which is
+    what precompiled packages (.dep files) are made of. The format is only
+    readable by the same version of the compiler that wrote it.
+    ---------------------------------------------------------------------------
+*/
+
+#include <stdbool.h>
+
+#include "AST/ast.h"
+#include "UTIL/arena.h"
+#include "UTIL/ground.h"
+
+// ---------------- AST_SERIALIZE_FORMAT_VERSION ----------------
+// Version of the binary AST format
+// NOTE: Must be incremented whenever the format changes
+#define AST_SERIALIZE_FORMAT_VERSION 2
+
+// ---------------- ast_snapshot_t ----------------
+// How many of each kind of declaration an AST had at some point
+typedef struct {
+    length_t enums_length;
+    length_t composites_length;
+    length_t globals_length;
+    length_t funcs_length;
+    length_t aliases_length;
+    length_t libraries_length;
+    length_t func_aliases_length;
+    length_t poly_composites_length;
+    length_t named_expressions_length;
+    length_t meta_definitions_length;
+    length_t poly_funcs_length;
+    length_t polymorphic_methods_length;
+    bool has_variadic_array;
+    bool has_initializer_list;
+} ast_snapshot_t;
+
+// ---------------- ast_snapshot ----------------
+// Remembers how many declarations an AST currently has
+void ast_snapshot(ast_t *ast, ast_snapshot_t *out_snapshot);
+
+// ---------------- ast_serialize ----------------
+// Converts an AST into its binary form
+// Fails if the AST contains anything that only exists during later
+// compilation stages (such as phantom expressions)
+errorcode_t ast_serialize(ast_t *ast, strong_cstr_t *out_buffer, length_t *out_length);
+
+// ---------------- ast_serialize_since ----------------
+// Same as 'ast_serialize', except only converts the declarations
+// that were added to 'ast' after the snapshot 'since' was taken
+// Fails if those declarations refer to functions from before the snapshot
+errorcode_t ast_serialize_since(ast_t *ast, const ast_snapshot_t *since, strong_cstr_t *out_buffer, length_t *out_length);
+
+// ---------------- ast_deserialize ----------------
+// Reads declarations from the binary form of an AST and appends them to 'ast'
+// Weak strings (such as variable names) are allocated inside of 'strings',
+// and names are interned (see 'intern_name')
+// If 'relocate_object_index' isn't -1, then every source will
+// refer to that object instead of where it originally came from
+// NOTE: Built-in declarations (those without a source) that
+// already exist in 'ast' are skipped
+errorcode_t ast_deserialize(ast_t *ast, const char *buffer, length_t length, arena_t *strings, maybe_index_t relocate_object_index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_AST_SERIALIZE_H
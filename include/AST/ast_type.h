@@ -58,8 +58,9 @@ enum {
 // Type element for base structure or primitive
 typedef struct {
     unsigned int id;
+    bool in_arena;
     source_t source;
-    strong_cstr_t base;
+    weak_cstr_t base; // Interned (see 'intern_name')
 } ast_elem_base_t;
 
 // ---------------- ast_elem_pointer_t ----------------
@@ -74,6 +75,7 @@ typedef ast_elem_t ast_elem_array_t;
 // Type element for a fixed array
 typedef struct {
     unsigned int id;
+    bool in_arena;
     source_t source;
     length_t length;
 } ast_elem_fixed_array_t;
@@ -94,6 +96,7 @@ typedef ast_elem_t ast_elem_generic_float_t;
 // sizeof(ast_elem_var_fixed_array_t) <= sizeof(ast_elem_fixed_array_t)
 typedef struct {
     unsigned int id;
+    bool in_arena;
     source_t source;
     ast_expr_t *length;
 } ast_elem_var_fixed_array_t;
@@ -102,6 +105,7 @@ typedef struct {
 // Type element for a function pointer
 typedef struct {
     unsigned int id;
+    bool in_arena;
     source_t source;
     ast_type_t *arg_types;
     length_t arity;
@@ -114,6 +118,7 @@ typedef struct {
 // Type element for a polymorphic type variable
 #define DERIVE_ELEM_POLYMORPH struct { \
     unsigned int id; \
+    bool in_arena; \
     source_t source; \
     strong_cstr_t name; \
     bool allow_auto_conversion; \
@@ -127,6 +132,7 @@ typedef struct {
 // Type element for a polymorphic count variable
 typedef struct {
     unsigned int id;
+    bool in_arena;
     source_t source;
     strong_cstr_t name;
 } ast_elem_polycount_t;
@@ -146,8 +152,9 @@ typedef struct {
 // Type element for a variant of a generic base
 typedef struct {
     unsigned int id;
+    bool in_arena;
     source_t source;
-    strong_cstr_t name;
+    weak_cstr_t name; // Interned (see 'intern_name')
     ast_type_t *generics;
     length_t generics_length;
     bool name_is_polymorphic;
@@ -157,6 +164,7 @@ typedef struct {
 // Type element for an anonymous composite
 typedef struct {
     unsigned int id;
+    bool in_arena;
     source_t source;
     ast_layout_t layout;
 } ast_elem_layout_t;
@@ -166,6 +174,7 @@ typedef struct {
 // Type element for an unknown enum value
 typedef struct {
     unsigned int id;
+    bool in_arena;
     source_t source;
     weak_cstr_t kind_name;
 } ast_elem_unknown_enum_t;
@@ -188,6 +197,7 @@ typedef struct {
 */
 typedef struct {
     unsigned int id;
+    bool in_arena;
     source_t source;
     strong_cstr_list_t kinds;
 } ast_elem_unknown_plural_enum_t;
@@ -197,6 +207,7 @@ typedef struct {
 // NOTE: `kinds` must be a sorted and contain distinct members
 typedef struct {
     unsigned int id;
+    bool in_arena;
     source_t source;
     strong_cstr_list_t kinds;
 } ast_elem_anonymous_enum_t;
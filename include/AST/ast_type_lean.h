@@ -18,6 +18,7 @@ extern "C" {
 // General purpose struct for a type element
 typedef struct {
     unsigned int id;
+    bool in_arena; // Whether allocated inside of an AST node arena (see 'ast_node_alloc')
     source_t source;
 } ast_elem_t;
 
@@ -18,6 +18,7 @@ extern "C" {
 #include "AST/ast_type_lean.h"
 #include "UTIL/ground.h"
 #include "UTIL/list.h"
+#include "UTIL/set.h"
 #include "UTIL/trait.h"
 
 #ifndef ADEPT_INSIGHT_BUILD
@@ -31,7 +32,7 @@ extern "C" {
 #define BRIDGE_VAR_STATIC       TRAIT_4 // Variable is to static (global-like)
 
 typedef struct {
-    weak_cstr_t name;
+    weak_cstr_t name; // Interned (see 'intern_name')
     ast_type_t *ast_type;
 
     index_id_t id;           // ID of the variable within the function stack (only applies to non-static variables)
@@ -56,6 +57,23 @@ typedef listof(bridge_var_t, variables) bridge_var_list_t;
 typedef listof(struct bridge_scope_t*, scopes) bridge_scope_ref_list_t;
 #define bridge_scope_ref_list_append(LIST, VALUE) list_append((LIST), (VALUE), struct bridge_scope_t*)
 
+// ---------------- bridge_var_location_t ----------------
+// Where a variable is stored within a tree of bridge scopes
+// (Variables are referred to by position since variable lists can move)
+typedef struct {
+    struct bridge_scope_t *scope;
+    length_t index;
+} bridge_var_location_t;
+
+// ---------------- bridge_var_location_list_t ----------------
+// A list of variable locations
+typedef listof(bridge_var_location_t, locations) bridge_var_location_list_t;
+#define bridge_var_location_list_append(LIST, VALUE) list_append((LIST), (VALUE), bridge_var_location_t)
+
+// ---------------- BRIDGE_SCOPE_HASH_THRESHOLD ----------------
+// Number of variables a scope needs before its names are hashed
+#define BRIDGE_SCOPE_HASH_THRESHOLD 8
+
 // ---------------- bridge_scope_t ----------------
 // A variable scope that contains a list of variables
 // within the scope as well as a reference to the
@@ -64,6 +82,15 @@ typedef struct bridge_scope_t {
     struct bridge_scope_t *parent;
     bridge_var_list_t list;
 
+    // Set of bridge_var_t* in 'list', keyed by name
+    // (Only used once 'list' has at least BRIDGE_SCOPE_HASH_THRESHOLD variables,
+    // rebuilt whenever 'list' moves)
+    set_t names;
+
+    // Locations of variables by id for the entire function
+    // (Only used by root scopes)
+    bridge_var_location_list_t by_id;
+
     // First variable id contained within this scope
     // or the child scope. (Used for finding by id)
     length_t first_var_id;
@@ -83,8 +110,15 @@ void bridge_scope_init(bridge_scope_t *out_scope, bridge_scope_t *parent);
 // Frees a bridge scope
 void bridge_scope_free(bridge_scope_t *scope);
 
+// ---------------- bridge_scope_add_var ----------------
+// Adds a variable to a bridge scope, and returns a pointer
+// to it that is valid until the next variable is added to the scope
+// NOTE: The variable's name must be interned (see 'intern_name')
+bridge_var_t *bridge_scope_add_var(bridge_scope_t *scope, bridge_var_t var);
+
 // ---------------- bridge_scope_find_var ----------------
 // Finds a variable within a bridge variable scope
+// NOTE: 'name' must be interned (see 'intern_name')
 bridge_var_t* bridge_scope_find_var(bridge_scope_t *scope, const char *name);
 
 // ---------------- bridge_scope_find_var_by_id ----------------
@@ -95,6 +129,7 @@ bridge_var_t *bridge_scope_find_var_by_id(bridge_scope_t *scope, length_t id);
 // Checks to see if a variable with that name was already declared
 // within the variable list of the given scope.
 // NOTE: THIS DOESN'T CHECK PARENT SCOPES, ONLY THE SCOPE GIVEN IS CHECKED
+// NOTE: 'name' must be interned (see 'intern_name')
 bool bridge_scope_var_already_in_list(bridge_scope_t *scope, const char *name);
 
 // ---------------- bridge_scope_var_nearest ----------------
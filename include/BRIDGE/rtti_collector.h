@@ -3,8 +3,10 @@
 #define _ISAAC_RTTI_COLLECTOR_H
 
 #include "AST/TYPE/ast_type_set.h"
+#include "AST/TYPE/ast_type_table.h"
 #include "AST/TYPE/ast_type_make.h"
 #include "UTIL/ground.h"
+#include "UTIL/list.h"
 #include "UTIL/string.h"
 
 // ---------------- rtti_collector_t ----------------
@@ -13,13 +15,24 @@ typedef struct {
     ast_type_set_t ast_types_used;
 } rtti_collector_t;
 
-void rtti_collector_init(rtti_collector_t *collector);
+// ---------------- rtti_collector_mentions_t ----------------
+// List of AST types that were mentioned while mentions were deferred
+typedef listof(ast_type_t, types) rtti_collector_mentions_t;
+
+void rtti_collector_init(rtti_collector_t *collector, ast_type_table_t *type_table);
 void rtti_collector_free(rtti_collector_t *collector);
 
 // ---------------- rtti_collector_mention ----------------
 // Mentions an AST type to an RTTI collector
 void rtti_collector_mention(rtti_collector_t *collector, ast_type_t *type);
 
+// ---------------- rtti_collector_defer_mentions ----------------
+// Makes this thread record mentions of types that a collector doesn't already have
+// into 'mentions' instead of changing the collector (pass NULL to stop).
+// This lets several threads mention types to the same collector at once, as long as
+// no thread changes it in the meantime. The recorded types are owned by the list
+void rtti_collector_defer_mentions(rtti_collector_mentions_t *mentions);
+
 // ---------------- rtti_collector_mention_base ----------------
 // Helper to mention a simple base AST type to an RTTI collector.
 // Used for mentioning built-in types
@@ -0,0 +1,141 @@
+
+#ifndef _ISAAC_AST_CACHE_H
+#define _ISAAC_AST_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    =============================== ast_cache.h ===============================
+    Module for caching the parsed declarations of files on disk
+
+    Cache entries are keyed by a hash of the file contents, so unchanged
+    files (such as the standard library) can skip lexing and parsing in
+    later builds regardless of where they are imported from.
+
+    An entry is a sequence of records, which are either serialized
+    declarations or imports. Declarations that come from imported
+    files aren't part of the entry, those files are imported again
+    when the entry is used (and can have entries of their own).
+    ---------------------------------------------------------------------------
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "AST/ast.h"
+#include "AST/ast_serialize.h"
+#include "UTIL/ground.h"
+
+struct compiler;
+struct object;
+
+// ---------------- AST_CACHE_FORMAT_VERSION ----------------
+// Version of the on-disk format of cache entries
+// NOTE: Must be incremented whenever the format or what gets recorded changes
+#define AST_CACHE_FORMAT_VERSION 1
+
+// ---------------- ast_cache_entry_t ----------------
+// Cached declarations of a file
+typedef struct {
+    char *records;        // Records of the entry (NULL if there isn't an entry)
+    length_t length;      // Length of 'records' in bytes
+    uint64_t config_hash; // Hash of the compiler settings that the file was parsed with
+} ast_cache_entry_t;
+
+// Possible kinds of records
+#define AST_CACHE_RECORD_DECLARATIONS 0x00
+#define AST_CACHE_RECORD_IMPORT       0x01
+
+// ---------------- ast_cache_record_t ----------------
+// Single record of a cache entry
+// For declarations, 'data' is a serialized AST (see 'ast_serialize_since'),
+// for imports, 'data' is a null-terminated filename or standard library component
+// NOTE: 'source.object_index' is meaningless
+typedef struct {
+    char kind;
+    char *data;
+    length_t length;
+    bool is_standard_library_component;
+    source_t source;
+} ast_cache_record_t;
+
+// ---------------- ast_cache_default_directory ----------------
+// Returns the default directory to cache declarations in,
+// or NULL if the compiler's root folder is unknown
+maybe_null_strong_cstr_t ast_cache_default_directory(struct compiler *compiler);
+
+// ---------------- ast_cache_config_hash ----------------
+// Hashes the compiler settings that affect how files are parsed
+uint64_t ast_cache_config_hash(struct compiler *compiler);
+
+// ---------------- ast_cache_entry_filename ----------------
+// Returns the filename of the cache entry for a text buffer that was parsed with 'config_hash'
+strong_cstr_t ast_cache_entry_filename(weak_cstr_t directory, uint64_t config_hash, const char *buffer, length_t buffer_length);
+
+// ---------------- ast_cache_load ----------------
+// Loads the cache entry for a text buffer that was parsed with 'config_hash'
+// Returns false if there isn't a usable entry
+bool ast_cache_load(weak_cstr_t directory, uint64_t config_hash, const char *buffer, length_t buffer_length, ast_cache_entry_t *out_entry);
+
+// ---------------- ast_cache_entry_next ----------------
+// Reads the record at 'inout_position' and advances past it
+// Returns false once there aren't any records left
+// NOTE: 'inout_position' should start at zero
+bool ast_cache_entry_next(ast_cache_entry_t *entry, length_t *inout_position, ast_cache_record_t *out_record);
+
+// ---------------- ast_cache_entry_free ----------------
+// Frees a cache entry
+void ast_cache_entry_free(ast_cache_entry_t *entry);
+
+// ---------------- ast_cache_lex ----------------
+// Equivalent to 'lex', except files that have an entry in 'directory'
+// aren't lexed, and get the trait OBJECT_CACHED instead
+errorcode_t ast_cache_lex(struct compiler *compiler, struct object *object, weak_cstr_t directory);
+
+// ---------------- ast_cache_lex_buffer ----------------
+// Equivalent to 'lex_buffer', except files that have an entry in 'directory'
+// aren't lexed, and get the trait OBJECT_CACHED instead
+errorcode_t ast_cache_lex_buffer(struct compiler *compiler, struct object *object, weak_cstr_t directory);
+
+// ---------------- ast_cache_recording_t ----------------
+// Cache entry that is being made while a file is parsed
+// Once 'cacheable' is false, nothing will be stored
+typedef struct {
+    char *records;
+    length_t length;
+    length_t capacity;
+    ast_snapshot_t segment_start;
+    uint64_t config_hash;
+    bool cacheable;
+} ast_cache_recording_t;
+
+// ---------------- ast_cache_recording_init ----------------
+// Starts recording the declarations that will be added to 'ast'
+void ast_cache_recording_init(ast_cache_recording_t *recording, ast_t *ast, uint64_t config_hash);
+
+// ---------------- ast_cache_record_import ----------------
+// Records the declarations added so far, followed by an import
+// NOTE: 'ast_cache_record_skip' should be called once the import is finished
+void ast_cache_record_import(ast_cache_recording_t *recording, ast_t *ast, weak_cstr_t target, bool is_standard_library_component, source_t source);
+
+// ---------------- ast_cache_record_skip ----------------
+// Leaves out any declarations that were added to 'ast' since the last record
+// (such as the declarations of an imported file)
+void ast_cache_record_skip(ast_cache_recording_t *recording, ast_t *ast);
+
+// ---------------- ast_cache_recording_store ----------------
+// Records the remaining declarations and stores the entry for a text buffer into the cache
+// Returns false if the entry wasn't cacheable or couldn't be written
+bool ast_cache_recording_store(ast_cache_recording_t *recording, ast_t *ast, weak_cstr_t directory, const char *buffer, length_t buffer_length);
+
+// ---------------- ast_cache_recording_free ----------------
+// Frees a recording
+void ast_cache_recording_free(ast_cache_recording_t *recording);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_AST_CACHE_H
@@ -20,10 +20,13 @@ extern "C" {
 #include "AST/ast_type_lean.h"
 #include "DRVR/config.h"
 #include "DRVR/object.h"
+#include "DRVR/prefetch.h"
+#include "DRVR/server.h"
 #include "UTIL/ground.h"
 #include "UTIL/index_id_list.h"
 #include "UTIL/string_builder.h"
 #include "UTIL/string_list.h"
+#include "UTIL/string_map.h"
 #include "UTIL/trait.h"
 
 // Possible compiler trait options
@@ -47,6 +50,7 @@ extern "C" {
 #define COMPILER_TYPE_COLON               TRAIT_2_3
 #define COMPILER_WINDOWED                 TRAIT_2_4
 #define COMPILER_OUTPUT_DYNAMIC_LIBRARY   TRAIT_2_5
+#define COMPILER_LAZY_IR                  TRAIT_2_6
 
 // Possible compiler trait checks
 #define COMPILER_NULL_CHECKS      TRAIT_1
@@ -97,6 +101,17 @@ typedef struct compiler {
     length_t objects_length;
     length_t objects_capacity;
 
+    // Files lexed ahead of time (only used when 'threads' > 1)
+    prefetched_files_t prefetched;
+
+    // State kept between builds when running as a compile server (otherwise NULL)
+    resident_t *resident;
+
+    // Import lookup tables
+    string_map_t imported_files;     // Absolute filename -> object_t* (weak keys)
+    string_map_t import_resolutions; // Import request -> found filename (owned keys and values)
+    string_map_t absolute_filenames; // Filename -> absolute filename (owned keys and values)
+
     // Compiler persistent configuration options
     config_t config;
     maybe_null_strong_cstr_t config_filename;
@@ -111,6 +126,8 @@ typedef struct compiler {
     troolean use_pic;          // Generate using PIC relocation model
     bool use_libm;             // Link to libm using '-lm'
     bool extract_import_order;   // Parse file to extract order of all imported files
+    length_t threads;          // Number of threads to use for parallel stages (1 for none)
+    maybe_null_strong_cstr_t ast_cache_directory; // Where to cache the declarations of parsed files (NULL for no caching)
     trait_t debug_traits;      // COMPILER_DEBUG_* options
 
     // Default standard library to import from (global version)
@@ -216,10 +233,18 @@ void compiler_add_user_linker_option(compiler_t *compiler, weak_cstr_t option);
 // Adds user-supplied search path
 void compiler_add_user_search_path(compiler_t *compiler, weak_cstr_t search_path, maybe_null_weak_cstr_t current_file);
 
+// ---------------- COMPILER_PACKAGE_MAGIC ----------------
+// First eight bytes of every package file
+#define COMPILER_PACKAGE_MAGIC "ADEPTPKG"
+
 // ---------------- compiler_create_package ----------------
-// Creates and exports a package
+// Creates and exports a package from the parsed AST of an object
 errorcode_t compiler_create_package(compiler_t *compiler, object_t *object);
 
+// ---------------- compiler_import_package ----------------
+// Adds the contents of a package object read by 'compiler_read_file' to an AST
+errorcode_t compiler_import_package(compiler_t *compiler, object_t *object, ast_t *ast);
+
 // ---------------- compiler_read_file ----------------
 // Reads either a package or adept code file into tokens for an object
 errorcode_t compiler_read_file(compiler_t *compiler, object_t *object);
@@ -13,6 +13,7 @@ extern "C" {
 */
 
 #include "AST/ast.h"
+#include "DRVR/ast_cache.h"
 #include "LEX/token.h"
 #include "UTIL/ground.h"
 #include "UTIL/trait.h"
@@ -38,7 +39,11 @@ typedef struct object {
     strong_cstr_t full_filename; // Absolute filename (used for testing duplicate imports)
     strong_cstr_t buffer;        // Text buffer
     length_t buffer_length;      // Length of text buffer
+    length_t buffer_mapping_size;// Size of memory mapping for text buffer (zero when heap-allocated)
+    length_t *newlines;          // Offset of every newline in text buffer (built by the lexer)
+    length_t newlines_length;    // Number of newlines in text buffer
     tokenlist_t tokenlist;       // Token list
+    ast_cache_entry_t cached_ast;// Cached declarations to use instead of tokens (only for OBJECT_CACHED)
     ast_t ast;                   // Abstract syntax tree
 
     #ifndef ADEPT_INSIGHT_BUILD
@@ -57,8 +62,10 @@ typedef struct object {
 } object_t;
 
 // Possible traits for object_t
-#define OBJECT_NONE    TRAIT_NONE
-#define OBJECT_PACKAGE TRAIT_1    // Is an imported package
+#define OBJECT_NONE     TRAIT_NONE
+#define OBJECT_PACKAGE  TRAIT_1   // Is an imported package
+#define OBJECT_RESIDENT TRAIT_2   // Text and tokens are borrowed from a compile server
+#define OBJECT_CACHED   TRAIT_3   // Declarations come from the AST cache instead of being parsed
 
 // ------------------ object_init_ast ------------------
 // Initializes the AST portion of an object_t
@@ -68,6 +75,16 @@ void object_init_ast(object_t *object, unsigned int cross_compile_for);
 void object_create_module(object_t *object);
 #endif
 
+// ------------------ object_get_location ------------------
+// Retrieves line and column of an index in an object's text buffer
+// Uses the newline index when available, so this is O(log lines)
+// NOTE: Packages have no text, so their locations are always 1:1
+void object_get_location(object_t *object, length_t index, int *line, int *column);
+
+// ------------------ object_line_start ------------------
+// Returns the index in an object's text buffer where a line (starting at 1) begins
+length_t object_line_start(object_t *object, int line);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,74 @@
+#ifndef _ISAAC_PREFETCH_H
+#define _ISAAC_PREFETCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ================================ prefetch.h ================================
+    Module for lexing the files that a program imports ahead of time,
+    using multiple threads
+    ----------------------------------------------------------------------------
+*/
+
+#include <stdbool.h>
+
+#include "DRVR/ast_cache.h"
+#include "DRVR/object.h"
+#include "LEX/token.h"
+#include "UTIL/ground.h"
+#include "UTIL/list.h"
+#include "UTIL/string_map.h"
+
+struct compiler;
+
+// ---------------- prefetched_file_t ----------------
+// A file that was lexed before it was imported
+typedef struct {
+    strong_cstr_t filename;      // Filename (as it would be imported)
+    strong_cstr_t full_filename; // Absolute filename
+    strong_cstr_t buffer;        // Text buffer
+    length_t buffer_length;      // Length of text buffer
+    length_t buffer_mapping_size;// Size of memory mapping for text buffer (zero when heap-allocated)
+    length_t *newlines;          // Offset of every newline in text buffer
+    length_t newlines_length;    // Number of newlines in text buffer
+    tokenlist_t tokenlist;       // Token list
+    ast_cache_entry_t cached_ast;// Cached declarations, used instead of 'tokenlist' when 'cached_ast.records' isn't NULL
+    bool lexed;                  // Whether 'buffer' and either 'tokenlist' or 'cached_ast' are valid
+    bool taken;                  // Whether 'buffer' and 'tokenlist' were given to an object
+} prefetched_file_t;
+
+// ---------------- prefetched_files_t ----------------
+// List of prefetched files
+// NOTE: Starts with the same fields as 'listof' so that list functions can be used
+typedef struct {
+    prefetched_file_t *files;
+    length_t length;
+    length_t capacity;
+    string_map_t lookup; // Absolute filename -> prefetched_file_t* (only valid once discovery is finished)
+} prefetched_files_t;
+
+// ---------------- compiler_prefetch_imports ----------------
+// Discovers the files that 'root_object' (transitively) imports,
+// and lexes them in parallel using 'compiler->threads' threads.
+// Files that have entries in the AST cache are loaded from it instead of being lexed.
+// Discovery is only a prediction, parsing still decides what is actually imported.
+// NOTE: 'root_object' must already be lexed
+void compiler_prefetch_imports(struct compiler *compiler, object_t *root_object);
+
+// ---------------- prefetched_files_take ----------------
+// Gives an object the tokens of its file if it was prefetched.
+// Returns whether the object was given a buffer and tokenlist.
+// NOTE: 'object->full_filename' and 'object->index' must be set
+bool prefetched_files_take(prefetched_files_t *prefetched, object_t *object);
+
+// ---------------- prefetched_files_free ----------------
+// Frees a list of prefetched files
+void prefetched_files_free(prefetched_files_t *prefetched);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_PREFETCH_H
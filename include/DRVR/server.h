@@ -0,0 +1,72 @@
+
+#ifndef _ISAAC_SERVER_H
+#define _ISAAC_SERVER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ================================= server.h =================================
+    Module for running the compiler as a long-lived compile server
+
+    The server listens on a local (Unix domain) socket and compiles using the
+    same arguments that the command line accepts. Everything that doesn't
+    change between builds stays in memory, so rebuilds only pay for the files
+    that actually changed.
+    ----------------------------------------------------------------------------
+*/
+
+#include "DRVR/object.h"
+#include "LEX/token.h"
+#include "UTIL/ground.h"
+#include "UTIL/string_map.h"
+
+struct compiler;
+
+// ---------------- resident_file_t ----------------
+// A lexed file kept in memory between builds
+typedef struct {
+    strong_cstr_t full_filename;  // Absolute filename
+    strong_cstr_t buffer;         // Text buffer (always heap-allocated)
+    length_t buffer_length;       // Length of text buffer
+    length_t *newlines;           // Offset of every newline in text buffer
+    length_t newlines_length;     // Number of newlines in text buffer
+    tokenlist_t tokenlist;        // Token list
+} resident_file_t;
+
+// ---------------- resident_t ----------------
+// State that a compile server keeps between builds
+typedef struct resident {
+    string_map_t files;  // Absolute filename -> resident_file_t* (owned by values)
+    length_t hits;       // Files reused during the current build
+    length_t misses;     // Files lexed during the current build
+} resident_t;
+
+// ---------------- resident_free ----------------
+// Frees state kept by a compile server
+void resident_free(resident_t *resident);
+
+// ---------------- resident_lex ----------------
+// Equivalent to 'lex', except that the tokens of files which haven't changed
+// since the previous build are borrowed from 'resident' instead of being lexed again.
+// Newly lexed files are kept in 'resident' for the next build.
+// NOTE: Borrowing objects are marked with 'OBJECT_RESIDENT'
+errorcode_t resident_lex(struct compiler *compiler, object_t *object, resident_t *resident);
+
+// ---------------- server_run ----------------
+// Runs a compile server that listens on 'socket_path' until it's told to stop
+// Returns the exit code for the server process
+int server_run(weak_cstr_t program_name, weak_cstr_t socket_path);
+
+// ---------------- server_connect ----------------
+// Has the compile server listening on 'socket_path' compile using
+// the command line arguments 'argv' (which doesn't include the program name)
+// Returns the exit code of the compilation
+int server_connect(weak_cstr_t socket_path, int argc, char **argv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_SERVER_H
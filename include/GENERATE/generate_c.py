@@ -16,6 +16,7 @@
 # the 'token_aliases' array later in this file
 
 from enum import IntEnum, auto, unique
+import random
 import time
 import os
 
@@ -239,6 +240,58 @@ token_aliases = [
 
 extra_data_format_encode_offset = ord('a') - 1
 
+# Keywords are recognized using a perfect hash, so that the lexer
+# can tell whether a word is a keyword without any string comparisons
+# (other than the final check against the only possible keyword)
+#
+# hash(word) = (length + associated_values[word[0]] + associated_values[word[1]]
+#               + associated_values[word[length - 2]] + associated_values[word[length - 1]]) % keyword_hash_table_size
+keyword_hash_table_size = 128
+
+def keyword_hash_characters(name):
+    return (name[0], name[1], name[-2], name[-1])
+
+def keyword_hash(name, associated_values):
+    return (len(name) + sum(associated_values[ord(c)] for c in keyword_hash_characters(name))) % keyword_hash_table_size
+
+def count_keyword_hash_collisions(keywords, associated_values):
+    seen = set()
+    collisions = 0
+    for keyword in keywords:
+        slot = keyword_hash(keyword, associated_values)
+        if slot in seen:
+            collisions += 1
+        seen.add(slot)
+    return collisions
+
+def find_keyword_associated_values(keywords):
+    # Randomized hill climbing with a fixed seed, so that output is reproducible
+    rng = random.Random(0)
+    characters = sorted({ord(c) for keyword in keywords for c in keyword_hash_characters(keyword)})
+
+    for attempt in range(1000):
+        associated_values = [0] * 256
+        for c in characters:
+            associated_values[c] = rng.randrange(keyword_hash_table_size)
+        
+        collisions = count_keyword_hash_collisions(keywords, associated_values)
+
+        for iteration in range(20000):
+            if collisions == 0:
+                return associated_values
+            
+            c = rng.choice(characters)
+            old_value = associated_values[c]
+            associated_values[c] = rng.randrange(keyword_hash_table_size)
+
+            new_collisions = count_keyword_hash_collisions(keywords, associated_values)
+            if new_collisions > collisions:
+                associated_values[c] = old_value
+            else:
+                collisions = new_collisions
+    
+    raise RuntimeError("find_keyword_associated_values() failed to find perfect hash for keywords")
+
 def generate_header(filename):
     head = "\n// This file was auto-generated by 'include/TOKEN/generate_c.py'\n\n#ifndef _ISAAC_TOKEN_DATA_H\n#define _ISAAC_TOKEN_DATA_H\n\n"
     iteration_version = "#define TOKEN_ITERATION_VERSION 0x%0.8X\n\n" % int(time.time())
@@ -266,6 +319,18 @@ def generate_header(filename):
     f.write("\n");
     f.write("extern const char *global_token_keywords_list[];\n");
     f.write("extern unsigned long long global_token_keywords_list_length;\n");
+    f.write("\n");
+    keywords = [token.short_name for token in tokens if token.token_type == TokenType.KEYWORD]
+    f.write("#define TOKEN_KEYWORD_MIN_LENGTH %d\n" % min(len(keyword) for keyword in keywords))
+    f.write("#define TOKEN_KEYWORD_MAX_LENGTH %d\n" % max(len(keyword) for keyword in keywords))
+    f.write("#define TOKEN_KEYWORD_HASH_TABLE_SIZE %d\n" % keyword_hash_table_size)
+    f.write("\n");
+    f.write("// Perfect hash for keywords (see 'lex_keyword_index')\n");
+    f.write("// hash(word) = (length + associated_values[word[0]] + associated_values[word[1]]\n");
+    f.write("//               + associated_values[word[length - 2]] + associated_values[word[length - 1]]) % TOKEN_KEYWORD_HASH_TABLE_SIZE\n");
+    f.write("extern const unsigned char global_token_keywords_hash_associated_values[];\n");
+    f.write("extern const unsigned char global_token_keywords_hash_table[];\n");
+    f.write("extern const unsigned char global_token_keywords_length_list[];\n");
     f.write(tail)
     f.close()
     print("[done] Generated token_data.h")
@@ -306,6 +371,27 @@ def generate_source(filename):
     f.write("};\n");
     f.write("\n");
     f.write("unsigned long long global_token_keywords_list_length = {0};\n".format(num_keywords));
+    f.write("\n");
+    keywords = [token.short_name for token in tokens if token.token_type == TokenType.KEYWORD]
+    associated_values = find_keyword_associated_values(keywords)
+    f.write("const unsigned char global_token_keywords_hash_associated_values[] = {\n");
+    for i in range(0, 256, 16):
+        f.write("    " + ", ".join("%3d" % value for value in associated_values[i:i + 16]) + ",\n")
+    f.write("};\n");
+    f.write("\n");
+    hash_table = [0] * keyword_hash_table_size
+    for i in range(0, len(keywords)):
+        hash_table[keyword_hash(keywords[i], associated_values)] = i + 1
+    f.write("// Keyword index + 1 for each hash slot (or 0 if no keyword has that hash)\n");
+    f.write("const unsigned char global_token_keywords_hash_table[] = {\n");
+    for i in range(0, keyword_hash_table_size, 16):
+        f.write("    " + ", ".join("%3d" % value for value in hash_table[i:i + 16]) + ",\n")
+    f.write("};\n");
+    f.write("\n");
+    f.write("const unsigned char global_token_keywords_length_list[] = {\n");
+    for i in range(0, len(keywords), 16):
+        f.write("    " + ", ".join("%2d" % len(keyword) for keyword in keywords[i:i + 16]) + ",\n")
+    f.write("};\n");
     f.close()
     print("[done] Generated token_data.c")
 
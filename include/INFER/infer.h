@@ -20,6 +20,7 @@
 #include "DRVR/object.h"
 #include "UTIL/ground.h"
 #include "UTIL/list.h"
+#include "UTIL/string_map.h"
 
 // ---------------- infer_var_t ----------------
 // Variable mapping used for inference stage
@@ -36,12 +37,20 @@ typedef struct {
 typedef listof(infer_var_t, variables) infer_var_list_t;
 #define infer_var_list_append(LIST, VALUE) list_append((LIST), (VALUE), infer_var_t);
 
+// ---------------- INFER_VAR_SCOPE_HASH_THRESHOLD ----------------
+// Number of variables a scope needs before its names are hashed
+#define INFER_VAR_SCOPE_HASH_THRESHOLD 8
+
 // ---------------- infer_var_scope_t ----------------
 // Variable scope used for inference stage
 typedef struct infer_var_scope_t {
     struct infer_var_scope_t *parent;
     infer_var_list_t list;
 
+    // Maps variable names to one more than their index in 'list'
+    // (Only used once 'list' has at least INFER_VAR_SCOPE_HASH_THRESHOLD variables)
+    string_map_t names;
+
     ast_named_expression_list_t named_expressions;
 } infer_var_scope_t;
 
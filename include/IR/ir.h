@@ -477,6 +477,7 @@ typedef struct {
     bridge_scope_t *scope;
     length_t variable_count;
     weak_cstr_t export_as;
+    func_id_t ast_func_id;
 } ir_func_t;
 
 // Possible traits for ir_func_t
@@ -488,6 +489,7 @@ typedef struct {
 #define IR_FUNC_VALIDATE_VTABLE TRAIT_6
 #define IR_FUNC_INIT            TRAIT_7
 #define IR_FUNC_DEINIT          TRAIT_8
+#define IR_FUNC_UNREACHED       TRAIT_9 // Body is deferred until something references the function (--lazy-ir)
 
 // ---------------- ir_job_list_t ----------------
 // List of jobs required during IR generation
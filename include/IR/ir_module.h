@@ -10,6 +10,7 @@
 
 #include <stdbool.h>
 
+#include "AST/TYPE/ast_type_table.h"
 #include "BRIDGE/rtti_collector.h"
 #include "BRIDGEIR/rtti_table.h"
 #include "IR/ir.h"
@@ -20,6 +21,15 @@
 #include "IRGEN/ir_cache.h"
 #include "UTIL/ground.h"
 
+// ---------------- ir_speculation_stats_t ----------------
+// Statistics of function bodies that were speculatively generated (see 'ir_gen_parallel.h')
+typedef struct {
+    length_t waves;       // Groups of function bodies that were speculatively generated at once
+    length_t committed;   // Function bodies that were used as speculatively generated
+    length_t aborted;     // Function bodies that gave up while speculating
+    length_t invalidated; // Function bodies that depended on candidates that changed during their wave
+} ir_speculation_stats_t;
+
 // ---------------- ir_module_t ----------------
 // An intermediate representation module
 typedef struct ir_module {
@@ -32,7 +42,11 @@ typedef struct ir_module {
     ir_global_t *globals;
     length_t globals_length;
     ir_anon_globals_t anon_globals;
+    ast_type_table_t type_table; // Canonical AST types used by 'sf_cache', 'poly_cache', 'proc_cache' and 'rtti_collector'
     ir_gen_sf_cache_t sf_cache;
+    ir_gen_poly_cache_t poly_cache;
+    ir_gen_proc_cache_t proc_cache;
+    ir_speculation_stats_t speculation_stats;
     rtti_collector_t *rtti_collector;
     rtti_table_t *rtti_table;
     rtti_relocations_t rtti_relocations;
@@ -57,6 +71,11 @@ void ir_module_free(ir_module_t *ir_module);
 // Creates a new function mapping
 void ir_module_create_func_mapping(ir_module_t *module, weak_cstr_t function_name, ir_func_endpoint_t endpoint, bool add_to_job_list);
 
+// ---------------- ir_module_reach_func ----------------
+// Marks an IR function as referenced, queueing the generation
+// of its body if it was deferred until then
+void ir_module_reach_func(ir_module_t *module, func_id_t ir_func_id);
+
 // ---------------- ir_module_create_method_mapping ----------------
 // Create a new method mapping
 void ir_module_create_method_mapping(ir_module_t *module, weak_cstr_t struct_name, weak_cstr_t method_name, ir_func_endpoint_t endpoint);
@@ -59,6 +59,18 @@ ir_pool_snapshot_t ir_pool_snapshot_capture(ir_pool_t *pool);
 // Restores an IR pool to a previous memory usage snapshot
 void ir_pool_snapshot_restore(ir_pool_t *pool, ir_pool_snapshot_t *snapshot);
 
+// ---------------- ir_pool_redirect ----------------
+// Makes this thread allocate from 'to' whenever it is asked to allocate from 'from',
+// so that several threads can build IR for the same module at once (pass NULL to stop).
+// Snapshots of 'from' are redirected as well
+void ir_pool_redirect(ir_pool_t *from, ir_pool_t *to);
+
+// ---------------- ir_pool_adopt ----------------
+// Moves all memory of an IR pool into another IR pool,
+// after which 'other' no longer needs to be freed
+// NOTE: Snapshots of 'pool' taken beforehand are invalidated
+void ir_pool_adopt(ir_pool_t *pool, ir_pool_t *other);
+
 // ---------------- ir_pool_memclone ----------------
 // Creates a pool-allocated copy of a portion of memory
 void *ir_pool_memclone(ir_pool_t *pool, const void *bytes, length_t num_bytes);
@@ -12,26 +12,41 @@ extern "C" {
     ---------------------------------------------------------------------------
 */
 
+#include <stdbool.h>
+
 #include "IR/ir_pool.h"
 #include "IR/ir_func_endpoint.h"
 #include "UTIL/ground.h"
+#include "UTIL/hash.h"
+#include "UTIL/set.h"
+
+// ---------------- ir_proc_map_hash_func_t ----------------
+// A function that a procedure map uses to hash its keys
+typedef hash_t (*ir_proc_map_hash_func_t)(const void *key);
+
+// ---------------- ir_proc_map_equals_func_t ----------------
+// A function that a procedure map uses to determine if two keys are equal
+typedef bool (*ir_proc_map_equals_func_t)(const void *a, const void *b);
 
 // ---------------- ir_proc_map_t ----------------
 // IR procedure map, used to map a value of a generic 'key'
-// type to a list of possible function endpoints
+// type to a list of possible function endpoints.
+// Endpoint lists are stored in insertion order,
+// and are found by looking up their keys in a hash set.
 typedef struct {
-    void *keys;
     ir_func_endpoint_list_t **endpoint_lists;
     length_t length;
     length_t capacity;
 
     // Implementation details
+    length_t sizeof_key;
+    set_t keys; // Set of keys (each stored alongside its endpoint list in 'endpoint_pool')
     ir_pool_t endpoint_pool;
 } ir_proc_map_t;
 
 // ---------------- ir_proc_map_init ----------------
 // Initializes a procedure map
-void ir_proc_map_init(ir_proc_map_t *map, length_t sizeof_key, length_t estimated_keys);
+void ir_proc_map_init(ir_proc_map_t *map, length_t sizeof_key, length_t estimated_keys, ir_proc_map_hash_func_t hash_func, ir_proc_map_equals_func_t equals_func);
 
 // ---------------- ir_proc_map_free ----------------
 // Frees a procedure map
@@ -41,16 +56,21 @@ void ir_proc_map_free(ir_proc_map_t *map);
 // ---------------- ir_proc_map_insert ----------------
 // Inserts an endpoint into the endpoint list for a given key
 // If the given key doesn't already exist in the map, it will be created
-void ir_proc_map_insert(ir_proc_map_t *map, const void *key, length_t sizeof_key, ir_func_endpoint_t endpoint, int (*key_compare)(const void*, const void*));
+void ir_proc_map_insert(ir_proc_map_t *map, const void *key, ir_func_endpoint_t endpoint);
 
 // ---------------- ir_proc_map_find ----------------
 // Looks up a key inside of the map and returns a stable pointer
 // to its corresponding endpoint list. Returns NULL if the supplied
 // key doesn't exist in the map
 // NOTE: Guaranteed to return a stable pointer (the pointer will be valid until 'map' is freed)
-ir_func_endpoint_list_t *ir_proc_map_find(ir_proc_map_t *map, const void *key, length_t sizeof_key, int (*key_compare)(const void*, const void*));
+ir_func_endpoint_list_t *ir_proc_map_find(ir_proc_map_t *map, const void *key);
+
+// ---------------- ir_proc_map_key_at ----------------
+// Returns the key of the endpoint list at 'index' in 'map->endpoint_lists'
+const void *ir_proc_map_key_at(const ir_proc_map_t *map, length_t index);
 
 // ---------------- ir_func_key_t ----------------
+// NOTE: Names must be interned (see 'intern_name')
 typedef struct {
     weak_cstr_t name;
 } ir_func_key_t;
@@ -62,13 +82,25 @@ typedef struct {
     weak_cstr_t method_name;
 } ir_method_key_t;
 
-// ---------------- compare_ir_func_key ----------------
-// Compare function for ir_func_key_t
-int compare_ir_func_key(const void*, const void*);
+// ---------------- hash_ir_func_key ----------------
+// Hash function for ir_func_key_t
+hash_t hash_ir_func_key(const void *key);
+
+// ---------------- equals_ir_func_key ----------------
+// Equality function for ir_func_key_t
+bool equals_ir_func_key(const void *a, const void *b);
+
+// ---------------- hash_ir_method_key ----------------
+// Hash function for ir_method_key_t
+hash_t hash_ir_method_key(const void *key);
+
+// ---------------- equals_ir_method_key ----------------
+// Equality function for ir_method_key_t
+bool equals_ir_method_key(const void *a, const void *b);
 
 // ---------------- compare_ir_method_key ----------------
-// Compare function for ir_method_key_t
-int compare_ir_method_key(const void*, const void*);
+// Comparison function for ir_method_key_t (by struct name, then by method name)
+int compare_ir_method_key(const void *a, const void *b);
 
 #ifdef __cplusplus
 }
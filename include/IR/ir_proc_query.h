@@ -167,6 +167,7 @@ struct ir_proc_query {
     source_t from_source;
     bool for_dispatcher;
     length_t instantiation_depth;
+    const ast_type_t **canonical_arg_types; // Canonical versions of the argument types when known (nullable)
 };
 
 #ifdef __cplusplus
@@ -11,11 +11,12 @@
 #include "IR/ir_type.h"
 #include "UTIL/ground.h"
 #include "UTIL/list.h"
+#include "UTIL/set.h"
 
 // ---------------- ir_type_mapping_t ----------------
 // Mapping for a name to an IR type
 typedef struct {
-    weak_cstr_t name;
+    weak_cstr_t name; // Interned (see 'intern_name')
     ir_type_t *type;
 } ir_type_mapping_t;
 
@@ -23,18 +24,30 @@ typedef struct {
 
 // ---------------- ir_type_map_t ----------------
 // A list of mappings from names to IR types
-typedef listof(ir_type_mapping_t, mappings) ir_type_map_t;
+// Once every mapping is appended, 'ir_type_map_index' must be called before searching
+typedef struct {
+    ir_type_mapping_t *mappings;
+    length_t length;
+    length_t capacity;
+    set_t by_name; // Set of ir_type_mapping_t*, keyed by name
+} ir_type_map_t;
 
 // ---------------- ir_type_map_append ----------------
 // Appends a mapping to a type map
 #define ir_type_map_append(LIST, VALUE) list_append(LIST, VALUE, ir_type_mapping_t)
 
+// ---------------- ir_type_map_index ----------------
+// Prepares a type map for searching
+// NOTE: If a name is mapped more than once, the first mapping wins
+void ir_type_map_index(ir_type_map_t *type_map);
+
 // ---------------- ir_type_map_free ----------------
 // Frees the data of a type map
 void ir_type_map_free(ir_type_map_t *type_map);
 
 // ---------------- ir_type_map_find ----------------
 // Finds a type inside an IR type map by name
+// NOTE: 'name' must be interned (see 'intern_name')
 successful_t ir_type_map_find(ir_type_map_t *type_map, const char *name, ir_type_t **type_ptr);
 
 #endif // _ISAAC_IR_TYPE_MAP_H
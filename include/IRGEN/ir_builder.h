@@ -62,6 +62,10 @@ typedef struct ir_builder {
     length_t next_var_id;
     troolean has_string_struct;
     ir_job_list_t *job_list;
+    ir_vtable_init_list_t *vtable_init_list;
+    ir_vtable_dispatch_list_t *vtable_dispatch_list;
+    rtti_relocations_t *rtti_relocations;
+    free_list_t *defer_free;
     ast_type_t static_bool;
     ast_elem_base_t static_bool_base;
     ast_elem_t *static_bool_elems;
@@ -75,6 +79,7 @@ typedef struct ir_builder {
 
 // ---------------- ir_builder_init ----------------
 // Initializes an IR builder
+// Non-static builders are given a new root scope, which the caller takes ownership of
 void ir_builder_init(ir_builder_t *builder, compiler_t *compiler, object_t *object, func_id_t ast_func_id, func_id_t ir_func_id, bool static_builder);
 
 // ---------------- build_basicblock ----------------
@@ -136,6 +141,7 @@ void ir_builder_pop_loop_label(ir_builder_t *builder);
 // ---------------- ir_builder_add_variable ----------------
 // Adds a variable to the current bridge_scope_t
 // Returns a temporary pointer to the constructed variable
+// NOTE: The variable's name is interned
 bridge_var_t *ir_builder_add_variable(ir_builder_t *builder, weak_cstr_t name, ast_type_t *ast_type, ir_type_t *ir_type, trait_t traits);
 
 // ---------------- handle_deference_for_variables ----------------
@@ -302,6 +308,11 @@ errorcode_t ir_gen_actualize_unknown_plural_enum_to_anonymous(ir_builder_t *buil
 // Gets the current instantiation depth of a builder
 length_t ir_builder_instantiation_depth(ir_builder_t *builder);
 
+// ---------------- ir_builder_reach_func ----------------
+// Lets an IR function know that it is referenced by the function being built,
+// so that its body will be generated
+void ir_builder_reach_func(ir_builder_t *builder, func_id_t ir_func_id);
+
 // ---------------- ir_instrs_snapshot_t ----------------
 // Snapshot used to easily reset the forward generation of IR instructions
 typedef struct {
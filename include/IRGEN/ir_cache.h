@@ -12,26 +12,44 @@
     - __pass__
     - __defer__
     - __assign__
+
+    It also contains the polymorphic instantiation cache, which remembers
+    which concrete function was created for each polymorphic function and
+    set of polymorphic bindings, and the overload resolution cache, which
+    remembers which of a long list of candidate procedures was suitable
+    for each kind of call
     --------------------------------------------------------------------------
 */
 
 #include <stdio.h>
 
+#include "AST/TYPE/ast_type_table.h"
 #include "AST/ast.h"
+#include "AST/ast_poly_catalog.h"
 #include "AST/ast_type_lean.h"
+#include "IR/ir_func_endpoint.h"
+#include "UTIL/arena.h"
 #include "UTIL/func_pair.h"
 #include "UTIL/ground.h"
+#include "UTIL/hash.h"
+#include "UTIL/set.h"
+#include "UTIL/trait.h"
+
+#define IR_GEN_SF_CACHE_SUGGESTED_STARTING_CAPACITY 256
+#define IR_GEN_POLY_CACHE_SUGGESTED_STARTING_CAPACITY 64
+#define IR_GEN_PROC_CACHE_SUGGESTED_STARTING_CAPACITY 256
 
-#define IR_GEN_SF_CACHE_SUGGESTED_NUM_BUCKETS 1024
+// ---------------- IR_GEN_PROC_CACHE_MIN_CANDIDATES ----------------
+// Lists of candidate procedures shorter than this are always swept,
+// since trying each candidate is cheaper than looking up the cache
+#define IR_GEN_PROC_CACHE_MIN_CANDIDATES 8
 
 // ---------------- ir_gen_sf_cache_entry_t ----------------
 // Special Functions cache entry.
 // The structural layout is squished together tightly, since we
-// know that there will be a huge array of them
-#define ir_gen_sf_cache_entry_is_occupied(a) ((a)->ast_type.elements_length != 0)
-
-typedef struct ir_gen_sf_cache_entry {
-    ast_type_t ast_type;
+// know that there will be a huge number of them
+typedef struct {
+    const ast_type_t *ast_type; // Canonical type (owned by the cache's type table)
 
     troolean has_pass : 2,
              has_defer : 2,
@@ -40,20 +58,25 @@ typedef struct ir_gen_sf_cache_entry {
     func_pair_t pass;   // __pass__
     func_pair_t defer;  // __defer__
     func_pair_t assign; // __assign__
-    
-    struct ir_gen_sf_cache_entry *next;
 } ir_gen_sf_cache_entry_t;
 
 // ---------------- ir_gen_sf_cache_t ----------------
 // Special functions cache
+// Entries live in 'entries_arena' so that pointers to them stay valid as the cache grows
 typedef struct {
-    ir_gen_sf_cache_entry_t *storage;
-    length_t capacity;
+    set_t entries; // Set of ir_gen_sf_cache_entry_t*
+    arena_t entries_arena;
+    ast_type_table_t *type_table;
+
+    // Statistics
+    length_t hits;   // Lookups that found an existing entry
+    length_t misses; // Lookups that had to create a new entry
 } ir_gen_sf_cache_t;
 
 // ---------------- ir_gen_sf_cache_init ----------------
 // Initializes special functions cache
-void ir_gen_sf_cache_init(ir_gen_sf_cache_t *cache, length_t num_buckets);
+// Entries are keyed by canonical types from 'type_table'
+void ir_gen_sf_cache_init(ir_gen_sf_cache_t *cache, ast_type_table_t *type_table, length_t starting_capacity);
 
 // ---------------- ir_gen_sf_cache_free ----------------
 // Frees special functions cache
@@ -69,10 +92,169 @@ errorcode_t ir_gen_sf_cache_read(troolean has, func_pair_t maybe_pair, optional_
 // If one doesn't exist yet, one will be created
 // Will never return NULL
 // NOTE: Does not take any ownership of 'type'
+// NOTE: The returned pointer stays valid until the cache is freed
 ir_gen_sf_cache_entry_t *ir_gen_sf_cache_locate_or_insert(ir_gen_sf_cache_t *cache, ast_type_t *type);
 
+// ---------------- ir_gen_sf_cache_locate ----------------
+// Locates the cache entry for AST type in special functions cache
+// Returns NULL if one doesn't exist, and never changes the cache
+ir_gen_sf_cache_entry_t *ir_gen_sf_cache_locate(const ir_gen_sf_cache_t *cache, const ast_type_t *type);
+
 // ---------------- ir_gen_sf_cache_dump ----------------
-// Dumps a visual representation of an special function cache
+// Dumps statistics and a visual representation of an special function cache
+// (Each line is a run of occupied slots, with one '+' per slot)
 void ir_gen_sf_cache_dump(FILE *file, ir_gen_sf_cache_t *sf_cache);
 
+// ---------------- ir_gen_poly_cache_binding_t ----------------
+// Polymorphic type binding as stored in a polymorphic instantiation cache
+typedef struct {
+    weak_cstr_t name;
+    const ast_type_t *binding; // Canonical type (owned by the cache's type table)
+} ir_gen_poly_cache_binding_t;
+
+// ---------------- ir_gen_poly_cache_entry_t ----------------
+// Polymorphic instantiation cache entry
+typedef struct {
+    func_id_t ast_poly_func_id;
+    ir_gen_poly_cache_binding_t *types;
+    length_t types_length;
+    ast_poly_catalog_count_t *counts;
+    length_t counts_length;
+    ir_func_endpoint_t instance;
+} ir_gen_poly_cache_entry_t;
+
+// ---------------- ir_gen_poly_cache_t ----------------
+// Polymorphic instantiation cache
+// Keyed by polymorphic function and bindings, where the order of the bindings doesn't matter
+typedef struct {
+    set_t entries; // Set of ir_gen_poly_cache_entry_t*
+    arena_t entries_arena;
+    ast_type_table_t *type_table;
+
+    // Statistics (kept by the user of the cache)
+    length_t reused;  // Instantiations that were found in the cache
+    length_t created; // Instantiations that had to be created
+} ir_gen_poly_cache_t;
+
+// ---------------- ir_gen_poly_cache_init ----------------
+// Initializes polymorphic instantiation cache
+// Bindings are stored as canonical types from 'type_table'
+void ir_gen_poly_cache_init(ir_gen_poly_cache_t *cache, ast_type_table_t *type_table, length_t starting_capacity);
+
+// ---------------- ir_gen_poly_cache_free ----------------
+// Frees polymorphic instantiation cache
+void ir_gen_poly_cache_free(ir_gen_poly_cache_t *cache);
+
+// ---------------- ir_gen_poly_cache_locate_or_insert ----------------
+// Locates the cache entry for a polymorphic function and catalog of bindings
+// If one doesn't exist yet, one will be created with an invalid 'instance.ir_func_id'
+// Will never return NULL
+// NOTE: Does not take any ownership of 'catalog'
+// NOTE: The returned pointer stays valid until the cache is freed
+ir_gen_poly_cache_entry_t *ir_gen_poly_cache_locate_or_insert(ir_gen_poly_cache_t *cache, func_id_t ast_poly_func_id, ast_poly_catalog_t *catalog);
+
+// ---------------- ir_gen_poly_cache_locate ----------------
+// Locates the cache entry for a polymorphic function and catalog of bindings
+// Returns NULL if one doesn't exist, and never changes the cache
+ir_gen_poly_cache_entry_t *ir_gen_poly_cache_locate(const ir_gen_poly_cache_t *cache, func_id_t ast_poly_func_id, ast_poly_catalog_t *catalog);
+
+// ---------------- ir_gen_poly_cache_dump ----------------
+// Dumps statistics of a polymorphic instantiation cache
+void ir_gen_poly_cache_dump(FILE *file, ir_gen_poly_cache_t *poly_cache);
+
+// ---------------- ir_gen_proc_cache_key_t ----------------
+// Everything other than argument types that decides which
+// candidate procedure a sweep over a list of candidates will choose
+typedef struct {
+    const ir_func_endpoint_list_t *candidates;
+    trait_t conform_mode;
+    trait_t traits_mask;
+    trait_t traits_match;
+    trait_t forbid_traits;
+    bool conform;
+    bool is_method;
+} ir_gen_proc_cache_key_t;
+
+// ---------------- ir_gen_proc_cache_entry_t ----------------
+// Overload resolution cache entry
+// Only up to date while the list of candidates has 'candidates_length' candidates,
+// since adding a candidate can change which one is suitable
+typedef struct {
+    ir_gen_proc_cache_key_t key;
+    const ast_type_t **arg_types; // Canonical types (owned by the cache's type table)
+    length_t arg_types_length;
+    const ast_type_t *gives;      // Canonical type (owned by the cache's type table), or NULL for any return type
+    length_t candidates_length;   // Zero until a result is recorded
+    length_t chosen;              // Index of the first suitable candidate, or 'candidates_length' for none
+} ir_gen_proc_cache_entry_t;
+
+// ---------------- ir_gen_proc_cache_t ----------------
+// Overload resolution cache
+typedef struct {
+    set_t entries; // Set of ir_gen_proc_cache_entry_t*
+    arena_t entries_arena;
+    ast_type_table_t *type_table;
+
+    // Canonical argument types of AST functions, indexed by function ID
+    // (NULL for functions whose argument types haven't been canonicalized)
+    const ast_type_t ***func_arg_types;
+    length_t func_arg_types_length;
+
+    // Statistics (kept by the user of the cache)
+    length_t hits;   // Lookups that could use a recorded result
+    length_t misses; // Lookups that had to sweep the candidates
+} ir_gen_proc_cache_t;
+
+// ---------------- ir_gen_proc_cache_init ----------------
+// Initializes overload resolution cache
+// Argument and return types are stored as canonical types from 'type_table'
+void ir_gen_proc_cache_init(ir_gen_proc_cache_t *cache, ast_type_table_t *type_table, length_t starting_capacity);
+
+// ---------------- ir_gen_proc_cache_free ----------------
+// Frees overload resolution cache
+void ir_gen_proc_cache_free(ir_gen_proc_cache_t *cache);
+
+// ---------------- ir_gen_proc_cache_can_locate ----------------
+// Returns whether argument types can be used to look up an overload resolution cache entry
+// (types that haven't been collapsed yet can't be)
+bool ir_gen_proc_cache_can_locate(ast_type_t *arg_types, length_t arg_types_length, ast_type_t *optional_gives);
+
+// ---------------- ir_gen_proc_cache_locate_or_insert ----------------
+// Locates the cache entry for sweeping a list of candidates with the given argument types
+// If one doesn't exist yet, one will be created without a recorded result
+// Will never return NULL
+// NOTE: Does not take any ownership of 'arg_types' or 'optional_gives'
+// NOTE: The returned pointer stays valid until the cache is freed
+ir_gen_proc_cache_entry_t *ir_gen_proc_cache_locate_or_insert(
+    ir_gen_proc_cache_t *cache,
+    const ir_gen_proc_cache_key_t *key,
+    ast_type_t *arg_types,
+    length_t arg_types_length,
+    ast_type_t *optional_gives
+);
+
+// ---------------- ir_gen_proc_cache_locate ----------------
+// Locates the cache entry for sweeping a list of candidates with the given argument types
+// Returns NULL if one doesn't exist, and never changes the cache
+ir_gen_proc_cache_entry_t *ir_gen_proc_cache_locate(
+    const ir_gen_proc_cache_t *cache,
+    const ir_gen_proc_cache_key_t *key,
+    ast_type_t *arg_types,
+    length_t arg_types_length,
+    ast_type_t *optional_gives
+);
+
+// ---------------- ir_gen_proc_cache_func_arg_types ----------------
+// Returns the canonical argument types of an AST function,
+// so that they can be compared with the argument types of entries by pointer
+// (see 'ast_canonical_types_identical')
+// If they haven't been canonicalized yet, they will be if 'may_insert' is true,
+// otherwise NULL is returned. NULL is also returned for argument types that can't be canonicalized
+// NOTE: The returned array stays valid until the cache is freed
+const ast_type_t **ir_gen_proc_cache_func_arg_types(ir_gen_proc_cache_t *cache, ast_func_t *func, func_id_t ast_func_id, bool may_insert);
+
+// ---------------- ir_gen_proc_cache_dump ----------------
+// Dumps statistics of an overload resolution cache
+void ir_gen_proc_cache_dump(FILE *file, ir_gen_proc_cache_t *proc_cache);
+
 #endif // _ISAAC_IR_GEN_CACHE_H
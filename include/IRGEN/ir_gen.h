@@ -34,6 +34,11 @@ errorcode_t ir_gen_vtables(compiler_t *compiler, object_t *object);
 // Generates IR function skeletons for AST functions.
 errorcode_t ir_gen_functions(compiler_t *compiler, object_t *object);
 
+// ---------------- ir_gen_defer_unreached_functions ----------------
+// Removes all queued function bodies that can't be entered without being
+// referenced, leaving them to be generated once they are reached
+void ir_gen_defer_unreached_functions(object_t *object);
+
 // ---------------- ir_gen_auxiliary_builders ----------------
 // Generates init/deinit builders
 errorcode_t ir_gen_auxiliary_builders(compiler_t *compiler, object_t *object);
@@ -27,6 +27,12 @@ extern "C" {
 // the arguments supplied.
 successful_t func_args_match(ast_func_t *func, ast_type_t *type_list, length_t type_list_length);
 
+// ---------------- func_args_match_canonical ----------------
+// Equivalent to 'func_args_match' for canonical types
+// 'func_arg_types' must be the canonical argument types of 'func',
+// from the same type table as 'type_list'
+successful_t func_args_match_canonical(ast_func_t *func, const ast_type_t **func_arg_types, const ast_type_t **type_list, length_t type_list_length);
+
 // ---------------- func_args_conform ----------------
 // Returns whether a function's arguments conform
 // to the arguments supplied.
@@ -0,0 +1,173 @@
+
+#ifndef _ISAAC_IR_GEN_PARALLEL_H
+#define _ISAAC_IR_GEN_PARALLEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ============================ ir_gen_parallel.h ============================
+    Module for generating IR function bodies using multiple threads
+
+    Function bodies are taken off of the job list in waves, and each body
+    of a wave is speculatively generated on its own thread. While speculating,
+    a thread only reads from the module. Its IR is allocated from a pool of
+    its own, and the changes it would make to the module (such as queueing the
+    functions it reaches) are recorded instead of made.
+
+    Anything else that would change the module or report a problem, such as
+    instantiating a polymorphic function, gives up on the speculation.
+
+    Once a wave is finished, its bodies are committed one at a time in the
+    same order that they would be generated in using a single thread. Bodies
+    that gave up, or that depended on candidate functions that changed since
+    the wave started, are generated again normally at that point, so the
+    resulting module is the same no matter how many threads are used.
+    ---------------------------------------------------------------------------
+*/
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "AST/ast.h"
+#include "BRIDGE/bridge.h"
+#include "BRIDGE/rtti_collector.h"
+#include "DRVR/compiler.h"
+#include "DRVR/object.h"
+#include "IR/ir.h"
+#include "IR/ir_func_endpoint.h"
+#include "IR/ir_module.h"
+#include "IR/ir_pool.h"
+#include "IR/ir_proc_map.h"
+#include "IRGEN/ir_builder.h"
+#include "IRGEN/ir_cache.h"
+#include "UTIL/ground.h"
+#include "UTIL/list.h"
+
+// ---------------- IR_GEN_PARALLEL_JOBS_PER_THREAD ----------------
+// Number of function bodies each thread is given per wave
+#define IR_GEN_PARALLEL_JOBS_PER_THREAD 16
+
+// ---------------- IR_GEN_PARALLEL_MIN_JOBS ----------------
+// Fewer queued function bodies than this are generated without starting a wave,
+// since they aren't worth starting threads for
+#define IR_GEN_PARALLEL_MIN_JOBS 32
+
+// ---------------- ir_gen_proc_read_t ----------------
+// A list of candidate procedures that a speculative function body depended on,
+// and how many candidates it had at the time
+typedef struct {
+    ir_func_endpoint_list_t *endpoint_list;
+    length_t length;
+} ir_gen_proc_read_t;
+
+// ---------------- ir_gen_proc_reads_t ----------------
+// List of 'ir_gen_proc_read_t'
+typedef listof(ir_gen_proc_read_t, reads) ir_gen_proc_reads_t;
+
+// ---------------- ir_gen_proc_miss_t ----------------
+// An overload resolution that a speculative function body couldn't find in the cache,
+// which will be recorded in the cache if the function body is committed
+typedef struct {
+    ir_gen_proc_cache_key_t key;
+    ast_type_t *arg_types;
+    length_t arg_types_length;
+    ast_type_t gives; // (empty type for none)
+    length_t candidates_length;
+    length_t chosen;
+} ir_gen_proc_miss_t;
+
+// ---------------- ir_gen_proc_misses_t ----------------
+// List of 'ir_gen_proc_miss_t'
+typedef listof(ir_gen_proc_miss_t, misses) ir_gen_proc_misses_t;
+
+// ---------------- ir_gen_speculation_t ----------------
+// A function body that is being (or was) speculatively generated
+typedef struct {
+    ir_func_endpoint_t job;
+    bool aborted;
+    errorcode_t errorcode;
+
+    // Generated function body
+    ir_pool_t pool;
+    ast_func_t ast_func;
+    ir_basicblocks_t basicblocks;
+    bridge_scope_t *scope;
+    length_t variable_count;
+
+    // Changes to make to the module once committed
+    ir_job_list_t reached;
+    ir_vtable_init_list_t vtable_init_list;
+    ir_vtable_dispatch_list_t vtable_dispatch_list;
+    rtti_relocations_t rtti_relocations;
+    free_list_t defer_free;
+    rtti_collector_mentions_t mentions;
+
+    // What the function body depended on
+    ir_gen_proc_reads_t proc_reads;
+    bool missed_func_map;   // Looked for a function name that had no candidates
+    bool missed_method_map; // Looked for a method name that had no candidates
+
+    // Cache lookups to account for once committed
+    length_t sf_hits;
+    length_t poly_reused;
+    length_t proc_hits;
+    ir_gen_proc_misses_t proc_misses;
+} ir_gen_speculation_t;
+
+// ---------------- ir_gen_functions_body_parallel ----------------
+// Generates all queued IR function bodies using 'compiler->threads' threads
+// Behaves the same as 'ir_gen_functions_body'
+errorcode_t ir_gen_functions_body_parallel(compiler_t *compiler, object_t *object, ir_job_list_t *optional_out_completed_jobs);
+
+// ---------------- ir_gen_speculation_current ----------------
+// Returns the function body that this thread is speculatively generating, or NULL if none
+ir_gen_speculation_t *ir_gen_speculation_current(void);
+
+// ---------------- ir_gen_speculating ----------------
+// Returns whether this thread is speculatively generating a function body
+#define ir_gen_speculating() (ir_gen_speculation_current() != NULL)
+
+// ---------------- ir_gen_speculation_abort ----------------
+// Gives up on the function body that this thread is speculatively generating (if any)
+// Returns whether it did, in which case the caller must fail without changing the module.
+// The function body will be generated again later without speculating
+bool ir_gen_speculation_abort(void);
+
+// ---------------- ir_gen_speculation_attach ----------------
+// Makes a builder for a speculative function body record its changes to the module
+void ir_gen_speculation_attach(ir_gen_speculation_t *speculation, ir_builder_t *builder);
+
+// ---------------- ir_gen_speculation_read_procs ----------------
+// Remembers that the function body being speculatively generated (if any) depended on
+// the candidates that a procedure map has for a name (NULL 'endpoint_list' for none)
+void ir_gen_speculation_read_procs(ir_module_t *module, ir_proc_map_t *proc_map, ir_func_endpoint_list_t *endpoint_list);
+
+// ---------------- ir_gen_speculation_proc_miss ----------------
+// Remembers the outcome of an overload resolution that the function body being
+// speculatively generated couldn't find in the cache
+// NOTE: Does not take any ownership of 'arg_types' or 'optional_gives'
+void ir_gen_speculation_proc_miss(
+    const ir_gen_proc_cache_key_t *key,
+    ast_type_t *arg_types,
+    length_t arg_types_length,
+    ast_type_t *optional_gives,
+    length_t candidates_length,
+    length_t chosen
+);
+
+// ---------------- ir_gen_speculation_sf_cache_entry ----------------
+// Same as 'ir_gen_sf_cache_locate_or_insert', except that when speculating,
+// the cache is left unchanged and NULL is returned (after giving up) if there is no entry yet
+ir_gen_sf_cache_entry_t *ir_gen_speculation_sf_cache_entry(ir_gen_sf_cache_t *cache, ast_type_t *type);
+
+// ---------------- ir_gen_speculation_stats_dump ----------------
+// Dumps statistics of the function bodies that were speculatively generated for a module
+void ir_gen_speculation_stats_dump(FILE *file, ir_speculation_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_IR_GEN_PARALLEL_H
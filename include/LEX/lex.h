@@ -26,10 +26,18 @@ errorcode_t lex(compiler_t *compiler, object_t *object);
 // Lex the text buffer attached to the given object
 // NOTE: The attached buffer 'object->buffer' must be terminated with '\n\0'
 // NOTE: The final \0 is not included in the 'object->buffer_size'
+// NOTE: 'compiler' may be NULL to lex without reporting errors
+// NOTE: Also builds the newline index 'object->newlines'
 errorcode_t lex_buffer(compiler_t *compiler, object_t *object);
 
+// ---------------- lex_keyword_index ----------------
+// Returns the index of the keyword (in 'global_token_keywords_list') that a word is, or -1 if the word isn't a keyword
+// NOTE: 'word' does not need to be null-terminated
+maybe_index_t lex_keyword_index(const char *word, length_t length);
+
 // ---------------- lex_get_location ----------------
 // Retrieves line and column of an index in a buffer
+// NOTE: Scans the whole buffer up to 'i', prefer 'object_get_location' when possible
 void lex_get_location(const char *buffer, length_t i, int *line, int *column);
 
 #ifdef __cplusplus
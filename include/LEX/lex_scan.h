@@ -0,0 +1,66 @@
+
+#ifndef _ISAAC_LEX_SCAN_H
+#define _ISAAC_LEX_SCAN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    =============================== lex_scan.h ===============================
+    Module for quickly scanning over runs of characters while lexing
+
+    Each scanner looks at 16 (SSE2) or 32 (AVX2) characters at a time when
+    the target supports it, and falls back to checking one character
+    at a time otherwise. All implementations produce identical results.
+    ---------------------------------------------------------------------------
+*/
+
+#include <stdbool.h>
+
+#include "UTIL/ground.h"
+
+// ---------------- lex_scan_impl_t ----------------
+// Implementation used for scanning
+typedef enum {
+    LEX_SCAN_SCALAR,
+    LEX_SCAN_SSE2,
+    LEX_SCAN_AVX2,
+} lex_scan_impl_t;
+
+// ---------------- lex_scan_get_impl ----------------
+// Returns the implementation currently used for scanning
+// (the best one supported by this machine unless overridden)
+lex_scan_impl_t lex_scan_get_impl(void);
+
+// ---------------- lex_scan_set_impl ----------------
+// Overrides the implementation used for scanning
+// Returns false if 'impl' isn't supported by this machine
+// NOTE: Mostly useful for testing that all implementations agree
+bool lex_scan_set_impl(lex_scan_impl_t impl);
+
+// ---------------- lex_scan_blanks ----------------
+// Returns pointer to the first character that isn't a space or tab,
+// or 'eof' if there isn't one
+const char *lex_scan_blanks(const char *p, const char *eof);
+
+// ---------------- lex_scan_line ----------------
+// Returns pointer to the next newline character,
+// or 'eof' if there isn't one
+const char *lex_scan_line(const char *p, const char *eof);
+
+// ---------------- lex_scan_identifier ----------------
+// Returns pointer to the first character that isn't in [A-Za-z0-9_],
+// or 'eof' if there isn't one
+const char *lex_scan_identifier(const char *p, const char *eof);
+
+// ---------------- lex_scan_either ----------------
+// Returns pointer to the first occurrence of either 'a' or 'b',
+// or 'eof' if there isn't one
+const char *lex_scan_either(const char *p, const char *eof, char a, char b);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_LEX_SCAN_H
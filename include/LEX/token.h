@@ -12,7 +12,10 @@ extern "C" {
     ---------------------------------------------------------------------------
 */
 
+#include <stdint.h>
+
 #include "TOKEN/token_data.h"
+#include "UTIL/arena.h"
 #include "UTIL/ground.h"
 
 // ---------------- tokenid_t ----------------
@@ -21,6 +24,7 @@ typedef unsigned short tokenid_t;
 
 // ---------------- token_t ----------------
 // Structure for an individual token
+// NOTE: Tokenlists don't store tokens in this form, see 'tokenlist_t'
 typedef struct {
     tokenid_t id;
     void *data;
@@ -33,15 +37,65 @@ typedef struct {
     length_t length;
 } token_string_data_t;
 
+// ---------------- TOKEN_NO_DATA ----------------
+// Data index of tokens that don't have any data
+#define TOKEN_NO_DATA UINT32_MAX
+
+// ---------------- token_span_t ----------------
+// Compact location of a token within the buffer of its object,
+// and where its data is in the side table of its tokenlist (or TOKEN_NO_DATA)
+typedef struct {
+    uint32_t index;
+    uint32_t stride;
+    uint32_t data_index;
+} token_span_t;
+
 // ---------------- tokenlist_t ----------------
-// List of tokens and their sources
+// List of tokens and their sources, stored as parallel arrays
+// NOTE: Only tokens that have data get an entry in the side table 'data',
+// which is ordered by token index
+// NOTE: Token data lives in 'payloads', except for TOKEN_STRING and TOKEN_CSTRING
+// which are individually heap-allocated
 typedef struct {
-    token_t *tokens;
+    tokenid_t *ids;
+    token_span_t *spans;
     length_t length;
     length_t capacity;
-    source_t *sources;
+    length_t object_index;
+    void **data;
+    length_t data_length;
+    length_t data_capacity;
+    arena_t payloads;
 } tokenlist_t;
 
+// ---------------- tokenlist_data ----------------
+// Gets the data of a token (or NULL if the token doesn't have any)
+static inline void *tokenlist_data(const tokenlist_t *tokenlist, length_t index){
+    uint32_t data_index = tokenlist->spans[index].data_index;
+    return data_index == TOKEN_NO_DATA ? NULL : tokenlist->data[data_index];
+}
+
+// ---------------- tokenlist_source ----------------
+// Gets the source of a token
+static inline source_t tokenlist_source(const tokenlist_t *tokenlist, length_t index){
+    token_span_t span = tokenlist->spans[index];
+
+    return (source_t){
+        .index = span.index,
+        .stride = span.stride,
+        .object_index = tokenlist->object_index,
+    };
+}
+
+// ---------------- tokenlist_token ----------------
+// Gets the id and data of a token
+static inline token_t tokenlist_token(const tokenlist_t *tokenlist, length_t index){
+    return (token_t){
+        .id = tokenlist->ids[index],
+        .data = tokenlist_data(tokenlist, index),
+    };
+}
+
 // ---------------- tokenlist_print ----------------
 // Prints a tokenlist to the terminal
 void tokenlist_print(tokenlist_t *tokenlist, const char *buffer);
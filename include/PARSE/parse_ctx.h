@@ -9,6 +9,7 @@ extern "C" {
 #include <stdbool.h>
 
 #include "AST/ast.h"
+#include "DRVR/ast_cache.h"
 #include "DRVR/compiler.h"
 #include "DRVR/object.h"
 #include "LEX/lex.h"
@@ -54,6 +55,9 @@ typedef struct {
     // Token ID required to close struct definition
     tokenid_t struct_closer;
     char struct_closer_char;
+
+    // Cache entry being made for the object (NULL if not caching)
+    ast_cache_recording_t *ast_cache_recording;
 } parse_ctx_t;
 
 // ------------------ parse_ctx_init ------------------
@@ -64,6 +68,11 @@ void parse_ctx_init(parse_ctx_t *ctx, compiler_t *compiler, object_t *object);
 // Forks an existing parse context for parsing
 void parse_ctx_fork(parse_ctx_t *ctx, object_t *new_object, parse_ctx_t *out_ctx_fork);
 
+// ------------------ parse_ctx_forbid_caching ------------------
+// Prevents the declarations of the current object from being cached
+// Used when parsing depends on or affects anything besides the object's own declarations
+void parse_ctx_forbid_caching(parse_ctx_t *ctx);
+
 // ------------------ parse_ctx_set_meta_else_allowed ------------------
 // Sets whether #else is allowed at a certain ends-expected depth
 // NOTE: 'at_ends_expected' must be between 1-256 inclusive
@@ -110,8 +119,8 @@ maybe_null_weak_cstr_t parse_eat_string(parse_ctx_t *ctx, const char *error);
 // ==================================================
 
 // ------------------ parse_take_word ------------------
-// NOTE: THIS FUNCTION TAKES OWNERSHIP AND RETURNS IT.
-// Takes ownership of the string held by a word
+// NOTE: THIS FUNCTION RETURNS OWNERSHIP.
+// Returns an owned copy of the string held by a word
 // at the current token index. If the current token isn't
 // a word, 'error' will be spit out and NULL will be returned.
 // (NOTE: error can be NULL to indicate no error should be printed)
@@ -149,23 +158,21 @@ maybe_null_weak_cstr_t parse_grab_string(parse_ctx_t *ctx, const char *error);
 void parse_prepend_namespace(parse_ctx_t *ctx, strong_cstr_t *inout_name);
 
 // ------------------ parse_ctx_peek ------------------
-// Equivalent to: 'ctx->tokenlist->tokens[*ctx->i].id'
+// Equivalent to: 'ctx->tokenlist->ids[*ctx->i]'
 tokenid_t parse_ctx_peek(parse_ctx_t *ctx);
 
 // ------------------ parse_ctx_peek_source ------------------
-// Equivalent to: 'ctx->tokenlist->sources[*ctx->i]'
+// Equivalent to: 'tokenlist_source(ctx->tokenlist, *ctx->i)'
 source_t parse_ctx_peek_source(parse_ctx_t *ctx);
 
 // ------------------ parse_ctx_peek_data ------------------
-// Equivalent to: 'ctx->tokenlist->tokens[*ctx->i].data'
+// Equivalent to: 'tokenlist_data(ctx->tokenlist, *ctx->i)'
 void *parse_ctx_peek_data(parse_ctx_t *ctx);
 
 // ------------------ parse_ctx_peek_data_take ------------------
-// Equivalent to: {
-//     void *tmp = ctx->tokenlist->tokens[*ctx->i].data;
-//     ctx->tokenlist->tokens[*ctx->i].data = NULL;
-//     tmp
-// }
+// Equivalent to: 'strclone(tokenlist_data(ctx->tokenlist, *ctx->i))'
+// NOTE: Only valid for tokens whose data is a string (e.g. TOKEN_WORD)
+// NOTE: Token data lives in the tokenlist's arena, so an owned copy is made
 void *parse_ctx_peek_data_take(parse_ctx_t *ctx);
 
 // ------------------ parse_ctx_at_end ------------------
@@ -15,6 +15,10 @@ extern "C" {
 // Parses an 'import' statement
 errorcode_t parse_import(parse_ctx_t* ctx);
 
+// ------------------ parse_import_dependency ------------------
+// Imports a file or a standard library component (such as "a/b/c")
+errorcode_t parse_import_dependency(parse_ctx_t *ctx, weak_cstr_t target, bool is_standard_library_component, source_t source);
+
 // ------------------ parse_do_import ------------------
 // Performs an 'import' statement
 errorcode_t parse_do_import(parse_ctx_t *ctx, weak_cstr_t file, source_t source, bool allow_local);
@@ -32,6 +36,13 @@ errorcode_t parse_import_object(parse_ctx_t *ctx, strong_cstr_t relative_filenam
 // NOTE: Returns NULL on error
 maybe_null_strong_cstr_t parse_find_import(parse_ctx_t *ctx, weak_cstr_t filename, source_t source, bool allow_local_import);
 
+// ------------------ parse_find_import_quietly ------------------
+// Same as 'parse_find_import', except without a parse context and without reporting errors
+// 'current_filename' is the filename of the file doing the importing.
+// Successful lookups are remembered in 'compiler->import_resolutions'
+// NOTE: Returns NULL if no such file exists
+maybe_null_strong_cstr_t parse_find_import_quietly(compiler_t *compiler, weak_cstr_t current_filename, weak_cstr_t filename, bool allow_local_import);
+
 // ------------------ parse_standard_library_component ------------------
 // Parses a standard library component such as "a/b/c/d" into a string
 maybe_null_strong_cstr_t parse_standard_library_component(parse_ctx_t *ctx, source_t *out_source);
@@ -41,8 +52,15 @@ maybe_null_strong_cstr_t parse_standard_library_component(parse_ctx_t *ctx, sour
 // NOTE: Returns NULL on error
 maybe_null_strong_cstr_t parse_resolve_import(parse_ctx_t *ctx, weak_cstr_t filename);
 
+// ------------------ parse_resolve_import_quietly ------------------
+// Same as 'parse_resolve_import', except without a parse context and without reporting errors.
+// Results are remembered, so each filename is only ever resolved once
+// NOTE: Returns NULL on error
+maybe_null_strong_cstr_t parse_resolve_import_quietly(compiler_t *compiler, weak_cstr_t filename);
+
 // ------------------ already_imported ------------------
 // Returns whether or not the file has already been imported
+// 'filename' must be an absolute filename
 bool already_imported(parse_ctx_t *ctx, weak_cstr_t filename);
 
 #ifdef __cplusplus
@@ -4,7 +4,7 @@
 #ifndef _ISAAC_TOKEN_DATA_H
 #define _ISAAC_TOKEN_DATA_H
 
-#define TOKEN_ITERATION_VERSION 0x63FCD5C0
+#define TOKEN_ITERATION_VERSION 0x6AD2F8E3
 
 #define TOKEN_NONE                  0x00000000
 #define TOKEN_WORD                  0x00000001
@@ -170,4 +170,15 @@ extern const char global_token_extra_format_table[];
 extern const char *global_token_keywords_list[];
 extern unsigned long long global_token_keywords_list_length;
 
+#define TOKEN_KEYWORD_MIN_LENGTH 2
+#define TOKEN_KEYWORD_MAX_LENGTH 12
+#define TOKEN_KEYWORD_HASH_TABLE_SIZE 128
+
+// Perfect hash for keywords (see 'lex_keyword_index')
+// hash(word) = (length + associated_values[word[0]] + associated_values[word[1]]
+//               + associated_values[word[length - 2]] + associated_values[word[length - 1]]) % TOKEN_KEYWORD_HASH_TABLE_SIZE
+extern const unsigned char global_token_keywords_hash_associated_values[];
+extern const unsigned char global_token_keywords_hash_table[];
+extern const unsigned char global_token_keywords_length_list[];
+
 #endif // _ISAAC_TOKEN_DATA_H
@@ -0,0 +1,61 @@
+#ifndef _ISAAC_ARENA_H
+#define _ISAAC_ARENA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ================================= arena.h =================================
+    Module for region-based memory allocation
+    ---------------------------------------------------------------------------
+*/
+
+#include "UTIL/ground.h"
+
+// ---------------- arena_chunk_t ----------------
+// A block of memory that an arena allocates from
+typedef struct arena_chunk {
+    struct arena_chunk *prev;
+    length_t used;
+    length_t capacity;
+} arena_chunk_t;
+
+// ---------------- arena_t ----------------
+// Region of memory where allocations are all freed at once.
+// Zero-initialized arenas are valid and empty.
+typedef struct {
+    arena_chunk_t *head;
+    length_t chunk_size; // Usual size of new chunks (0 for default)
+} arena_t;
+
+// ---------------- arena_init ----------------
+// Initializes an arena that allocates in chunks of (usually) 'chunk_size' bytes
+void arena_init(arena_t *arena, length_t chunk_size);
+
+// ---------------- arena_alloc ----------------
+// Allocates memory inside of an arena
+// NOTE: 'alignment' must be a power of two
+void *arena_alloc(arena_t *arena, length_t size, length_t alignment);
+
+// ---------------- arena_memclone ----------------
+// Copies a block of memory into an arena (with maximum alignment)
+void *arena_memclone(arena_t *arena, const void *data, length_t size);
+
+// ---------------- arena_strndup ----------------
+// Copies 'length' characters into an arena as a null-terminated string
+char *arena_strndup(arena_t *arena, const char *string, length_t length);
+
+// ---------------- arena_free ----------------
+// Frees all memory allocated by an arena
+void arena_free(arena_t *arena);
+
+// ---------------- arena_alloc_init ----------------
+// Like 'malloc_init', except allocates inside of an arena
+#define arena_alloc_init(ARENA, TYPE, ...) (TYPE*) arena_memclone((ARENA), (TYPE[]){ __VA_ARGS__ }, sizeof(TYPE))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_ARENA_H
@@ -61,6 +61,10 @@ void filename_auto_ext(strong_cstr_t *out_filename, unsigned int cross_compile_f
 // doesn't already end in it
 void filename_append_if_missing(strong_cstr_t *out_filename, const char *addition);
 
+// ---------------- filename_is_package ----------------
+// Returns whether a filename refers to a precompiled package (.dep)
+bool filename_is_package(const char *filename);
+
 // ---------------- filename_without_ext ----------------
 // Returns the filename without the extension
 char *filename_without_ext(char *filename);
@@ -28,6 +28,10 @@ hash_t hash_string(const char *s);
 // Hashes an array of C strings
 hash_t hash_strings(char *strings[], length_t num_strings);
 
+// ---------------- hash_pointer ----------------
+// Hashes the address of a pointer (not the data it points to)
+hash_t hash_pointer(const void *pointer);
+
 // ---------------- hash_combine ----------------
 // Combines two hashes into one
 hash_t hash_combine(hash_t h1, hash_t h2);
@@ -0,0 +1,63 @@
+
+#ifndef _ISAAC_INTERN_H
+#define _ISAAC_INTERN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ================================= intern.h =================================
+    Module for interning strings
+
+    Each distinct string is stored once and handed out as an "atom" (a stable
+    pointer to the stored copy). Two atoms from the same table are equal if and
+    only if they are the same pointer.
+
+    Names in the AST (functions, types, composites, enums and variables) are
+    atoms of a single process-wide table, see 'intern_name'.
+    ----------------------------------------------------------------------------
+*/
+
+#include "UTIL/arena.h"
+#include "UTIL/ground.h"
+#include "UTIL/set.h"
+
+// ---------------- intern_table_t ----------------
+// A set of interned strings.
+// Zero-initialized intern tables are valid and empty.
+typedef struct {
+    set_t atoms;     // Set of atoms
+    arena_t strings; // Storage for atoms
+} intern_table_t;
+
+// ---------------- intern_table_free ----------------
+// Frees an intern table, along with all of its atoms
+void intern_table_free(intern_table_t *table);
+
+// ---------------- intern ----------------
+// Returns the atom for a string, adding it to the table if necessary
+// NOTE: The returned atom is valid until the table is freed
+weak_cstr_t intern(intern_table_t *table, const char *string);
+
+// ---------------- intern_find ----------------
+// Returns the atom for a string, or NULL if it was never interned
+maybe_null_weak_cstr_t intern_find(intern_table_t *table, const char *string);
+
+// ---------------- intern_name ----------------
+// Returns the atom for a name in the process-wide table of names
+// NOTE: Atoms of names stay valid until the process exits
+// NOTE: Safe to call from multiple threads at once
+weak_cstr_t intern_name(const char *name);
+
+// ---------------- intern_name_find ----------------
+// Returns the atom for a name in the process-wide table of names,
+// or NULL if it was never interned
+// NOTE: Safe to call from multiple threads at once
+maybe_null_weak_cstr_t intern_name_find(const char *name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_INTERN_H
@@ -30,17 +30,22 @@ typedef void (*set_traverse_func_t)(void *item);
 typedef void (*set_collect_func_t)(void *item, void *user_pointer);
 
 // ---------------- set_entry_t ----------------
-// An entry in a set collection
-typedef struct set_entry {
+// An entry in a set collection (empty when 'data' is NULL)
+typedef struct {
     void *data;
-    struct set_entry *next;
+    hash_t hash;
 } set_entry_t;
 
 // ---------------- set_t ----------------
-// A set collection
+// A set collection, using open addressing.
+// Grows automatically to keep its load factor at or below 3/4
+// Zero-initialized sets are valid and empty, but must be initialized before anything is inserted.
+// Items are usually pointers to entries that contain their own keys, which lets a set be used
+// as a map by looking up a partially filled in entry (see 'set_find')
+// NOTE: NULL cannot be stored as an item
 typedef struct {
-    set_entry_t **entries;
-    length_t capacity;
+    set_entry_t *entries;
+    length_t capacity; // Always a power of two
     length_t count;
 
     set_hash_func_t hash_func;
@@ -49,7 +54,7 @@ typedef struct {
 } set_t;
 
 // ---------------- set_init ----------------
-// Initializes a set collection
+// Initializes a set collection with room for at least 'starting_capacity' items
 void set_init(
     set_t *set,
     length_t starting_capacity,
@@ -68,6 +73,25 @@ void set_free(set_t *set, set_free_item_func_t optional_free_func);
 // The pointer `item` will be taken as-is unless `set->optional_preinsert_clone_func` is used to change this behavior
 bool set_insert(set_t *set, void *item);
 
+// ---------------- set_insert_hashed ----------------
+// Same as 'set_insert', except uses an already computed hash for `item`
+// NOTE: `hash` must be what `set->hash_func` would return for `item`
+bool set_insert_hashed(set_t *set, void *item, hash_t hash);
+
+// ---------------- set_find ----------------
+// Returns the item in a set that is equal to `item`, or NULL if there isn't one
+// `item` only needs to have the parts that `set->hash_func` and `set->equals_func` look at
+void *set_find(const set_t *set, const void *item);
+
+// ---------------- set_find_hashed ----------------
+// Same as 'set_find', except uses an already computed hash for `item`
+// NOTE: `hash` must be what `set->hash_func` would return for `item`
+void *set_find_hashed(const set_t *set, const void *item, hash_t hash);
+
+// ---------------- set_contains ----------------
+// Returns whether a set has an item equal to `item`
+bool set_contains(const set_t *set, const void *item);
+
 // ---------------- set_traverse ----------------
 // Traverses a set without any outside influence
 void set_traverse(set_t *set, set_traverse_func_t run_func);
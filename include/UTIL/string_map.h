@@ -0,0 +1,62 @@
+#ifndef _ISAAC_STRING_MAP_H
+#define _ISAAC_STRING_MAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ============================== string_map.h ==============================
+    Module for hash maps keyed by C strings
+    --------------------------------------------------------------------------
+*/
+
+#include <stdbool.h>
+
+#include "UTIL/arena.h"
+#include "UTIL/ground.h"
+#include "UTIL/set.h"
+
+// ---------------- string_map_entry_t ----------------
+// An entry in a string map
+typedef struct {
+    weak_cstr_t key;
+    void *value;
+} string_map_entry_t;
+
+// ---------------- string_map_t ----------------
+// A hash map from C strings to pointers
+// Zero-initialized string maps are valid and empty.
+// NOTE: Keys are not copied, they must outlive the map
+typedef struct {
+    set_t impl;      // Set of string_map_entry_t*
+    arena_t entries; // Storage for entries
+} string_map_t;
+
+// ---------------- string_map_init ----------------
+// Initializes a string map with room for at least 'starting_capacity' entries
+void string_map_init(string_map_t *map, length_t starting_capacity);
+
+// ---------------- string_map_free ----------------
+// Frees a string map
+// NOTE: Keys and values are not freed
+void string_map_free(string_map_t *map);
+
+// ---------------- string_map_find ----------------
+// Finds the value for a key, returns NULL if none exists
+void *string_map_find(string_map_t *map, const char *key);
+
+// ---------------- string_map_has ----------------
+// Returns whether a key exists in a string map
+bool string_map_has(string_map_t *map, const char *key);
+
+// ---------------- string_map_insert ----------------
+// Inserts a key/value pair into a string map.
+// Returns false and leaves the map unchanged if the key already exists
+bool string_map_insert(string_map_t *map, weak_cstr_t key, void *value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_STRING_MAP_H
@@ -0,0 +1,71 @@
+#ifndef _ISAAC_THREADS_H
+#define _ISAAC_THREADS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ================================ threads.h ================================
+    Module for portable mutexes and simple parallel work distribution
+    ---------------------------------------------------------------------------
+*/
+
+#include "UTIL/ground.h"
+
+#if defined(ADEPT_INSIGHT_BUILD) || defined(__EMSCRIPTEN__)
+#define ADEPT_NO_THREADS
+#endif
+
+#if defined(ADEPT_NO_THREADS)
+typedef struct { int unused; } adept_mutex_t;
+#define ADEPT_MUTEX_INITIALIZER {0}
+#elif defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+typedef SRWLOCK adept_mutex_t;
+#define ADEPT_MUTEX_INITIALIZER SRWLOCK_INIT
+#else
+#include <pthread.h>
+typedef pthread_mutex_t adept_mutex_t;
+#define ADEPT_MUTEX_INITIALIZER PTHREAD_MUTEX_INITIALIZER
+#endif
+
+// ---------------- ADEPT_THREAD_LOCAL ----------------
+// Storage class for variables that each thread has its own copy of
+#if defined(ADEPT_NO_THREADS)
+#define ADEPT_THREAD_LOCAL
+#elif defined(_MSC_VER)
+#define ADEPT_THREAD_LOCAL __declspec(thread)
+#else
+#define ADEPT_THREAD_LOCAL _Thread_local
+#endif
+
+// ---------------- adept_mutex_init (and friends) ----------------
+// Portable mutual exclusion lock
+// Mutexes with static storage can be initialized with ADEPT_MUTEX_INITIALIZER instead
+void adept_mutex_init(adept_mutex_t *mutex);
+void adept_mutex_lock(adept_mutex_t *mutex);
+void adept_mutex_unlock(adept_mutex_t *mutex);
+void adept_mutex_destroy(adept_mutex_t *mutex);
+
+// ---------------- parallel_task_func_t ----------------
+// A task that can be run by 'parallel_for'
+typedef void (*parallel_task_func_t)(length_t task_index, void *user_data);
+
+// ---------------- parallel_for ----------------
+// Runs 'task' for every index in [0, count) using up to 'num_threads' threads
+// (including the calling thread). Returns once every task has finished.
+// NOTE: Tasks may run in any order, so each task should only write to
+// storage that belongs to its own index
+void parallel_for(length_t count, length_t num_threads, parallel_task_func_t task, void *user_data);
+
+// ---------------- threads_available ----------------
+// Returns the number of hardware threads available (always at least 1)
+length_t threads_available(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_THREADS_H
@@ -56,6 +56,18 @@ bool file_exists(weak_cstr_t filename);
 // Returns whether successful
 bool file_text_contents(weak_cstr_t filename, strong_cstr_t *out_contents, length_t *out_length, bool append_newline);
 
+// ---------------- file_text_contents_mapped ----------------
+// Same as 'file_text_contents' with 'append_newline', except that larger
+// files are memory-mapped instead of being copied into a heap buffer.
+// 'out_mapping_size' will be the size of the mapping, or zero if
+// the contents ended up being heap-allocated.
+// NOTE: Contents must be released with 'file_text_contents_release'
+bool file_text_contents_mapped(weak_cstr_t filename, char **out_contents, length_t *out_length, length_t *out_mapping_size);
+
+// ---------------- file_text_contents_release ----------------
+// Releases contents obtained from 'file_text_contents_mapped'
+void file_text_contents_release(char *contents, length_t mapping_size);
+
 // ---------------- file_binary_contents ----------------
 // Reads binary contents of a file.
 // When successful, 'out_contents' will be a newly allocated
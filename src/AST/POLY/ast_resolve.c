@@ -7,6 +7,7 @@
 
 #include "AST/TYPE/ast_type_make.h"
 #include "AST/ast_expr.h"
+#include "AST/ast_node_alloc.h"
 #include "AST/ast_type.h"
 #include "UTIL/string.h"
 #include "UTIL/util.h"
@@ -62,7 +63,7 @@ errorcode_t ast_resolve_type_polymorphs(compiler_t *compiler, rtti_collector_t *
                     }
                 }
 
-                elements[length++] = ast_elem_generic_base_make(strclone(generic_base_elem->name), generic_base_elem->source, resolved, generic_base_elem->generics_length);
+                elements[length++] = ast_elem_generic_base_make(generic_base_elem->name, generic_base_elem->source, resolved, generic_base_elem->generics_length);
             }
             break;
         case AST_ELEM_POLYMORPH: {
@@ -360,3 +361,311 @@ errorcode_t ast_resolve_exprs_polymorphs(compiler_t *compiler, rtti_collector_t
 errorcode_t ast_resolve_expr_list_polymorphs(compiler_t *compiler, rtti_collector_t *rtti_collector, ast_poly_catalog_t *catalog, ast_expr_list_t *exprs){
     return ast_resolve_exprs_polymorphs(compiler, rtti_collector, catalog, exprs->statements, exprs->length);
 }
+
+static bool ast_resolve_type_is_needed(compiler_t *compiler, rtti_collector_t *rtti_collector, ast_type_t *type){
+    // Determines whether 'ast_resolve_type_polymorphs' would change a type.
+    // If it wouldn't, then the type is mentioned the same way that resolving it would have
+    for(length_t i = 0; i != type->elements_length; i++){
+        switch(type->elements[i]->id){
+        case AST_ELEM_FUNC: {
+                ast_elem_func_t *func = (ast_elem_func_t*) type->elements[i];
+
+                for(length_t a = 0; a != func->arity; a++){
+                    if(ast_resolve_type_is_needed(compiler, rtti_collector, &func->arg_types[a])) return true;
+                }
+
+                if(ast_resolve_type_is_needed(compiler, rtti_collector, func->return_type)) return true;
+            }
+            break;
+        case AST_ELEM_GENERIC_BASE: {
+                ast_elem_generic_base_t *generic_base_elem = (ast_elem_generic_base_t*) type->elements[i];
+                if(generic_base_elem->name_is_polymorphic) return true;
+
+                for(length_t g = 0; g != generic_base_elem->generics_length; g++){
+                    if(ast_resolve_type_is_needed(compiler, rtti_collector, &generic_base_elem->generics[g])) return true;
+                }
+            }
+            break;
+        case AST_ELEM_POLYMORPH:
+        case AST_ELEM_POLYCOUNT:
+            return true;
+        default:
+            // Cloned as-is by 'ast_resolve_type_polymorphs'
+            break;
+        }
+    }
+
+    if(rtti_collector && !(compiler->traits & COMPILER_NO_TYPEINFO)){
+        rtti_collector_mention(rtti_collector, type);
+    }
+
+    return false;
+}
+
+static bool ast_resolve_exprs_is_needed(compiler_t *compiler, rtti_collector_t *rtti_collector, ast_expr_t **exprs, length_t count);
+
+static bool ast_resolve_expr_is_needed(compiler_t *compiler, rtti_collector_t *rtti_collector, ast_expr_t *expr){
+    // Determines whether 'ast_resolve_expr_polymorphs' would change an expression,
+    // visiting the same parts of it that 'ast_resolve_expr_polymorphs' does
+    #define NEEDS_TYPE(TYPE)   ast_resolve_type_is_needed(compiler, rtti_collector, (TYPE))
+    #define NEEDS_EXPR(EXPR)   ((EXPR) != NULL && ast_resolve_expr_is_needed(compiler, rtti_collector, (EXPR)))
+    #define NEEDS_EXPRS(EXPRS, COUNT) ast_resolve_exprs_is_needed(compiler, rtti_collector, (EXPRS), (COUNT))
+    #define NEEDS_LIST(LIST)   NEEDS_EXPRS((LIST)->statements, (LIST)->length)
+
+    switch(expr->id){
+    case EXPR_RETURN: {
+            ast_expr_return_t *return_stmt = (ast_expr_return_t*) expr;
+            return NEEDS_EXPR(return_stmt->value) || NEEDS_LIST(&return_stmt->last_minute);
+        }
+    case EXPR_CALL: {
+            ast_expr_call_t *call_stmt = (ast_expr_call_t*) expr;
+            return NEEDS_EXPRS(call_stmt->args, call_stmt->arity)
+                || (call_stmt->gives.elements_length != 0 && NEEDS_TYPE(&call_stmt->gives));
+        }
+    case EXPR_DECLARE: case EXPR_DECLAREUNDEF: {
+            ast_expr_declare_t *declare_stmt = (ast_expr_declare_t*) expr;
+            return NEEDS_TYPE(&declare_stmt->type)
+                || NEEDS_EXPR(declare_stmt->value)
+                || (declare_stmt->inputs.has && NEEDS_LIST(&declare_stmt->inputs.value));
+        }
+    case EXPR_ASSIGN: case EXPR_ADD_ASSIGN: case EXPR_SUBTRACT_ASSIGN:
+    case EXPR_MULTIPLY_ASSIGN: case EXPR_DIVIDE_ASSIGN: case EXPR_MODULUS_ASSIGN:
+    case EXPR_AND_ASSIGN: case EXPR_OR_ASSIGN: case EXPR_XOR_ASSIGN:
+    case EXPR_LSHIFT_ASSIGN: case EXPR_RSHIFT_ASSIGN:
+    case EXPR_LGC_LSHIFT_ASSIGN: case EXPR_LGC_RSHIFT_ASSIGN: {
+            ast_expr_assign_t *assign_stmt = (ast_expr_assign_t*) expr;
+            return NEEDS_EXPR(assign_stmt->destination) || NEEDS_EXPR(assign_stmt->value);
+        }
+    case EXPR_IF: case EXPR_UNLESS: case EXPR_WHILE: case EXPR_UNTIL: {
+            ast_expr_if_t *conditional = (ast_expr_if_t*) expr;
+            return NEEDS_EXPR(conditional->value) || NEEDS_LIST(&conditional->statements);
+        }
+    case EXPR_IFELSE: case EXPR_UNLESSELSE: {
+            ast_expr_ifelse_t *complex_conditional = (ast_expr_ifelse_t*) expr;
+            return NEEDS_EXPR(complex_conditional->value)
+                || NEEDS_LIST(&complex_conditional->statements)
+                || NEEDS_LIST(&complex_conditional->else_statements);
+        }
+    case EXPR_WHILECONTINUE: case EXPR_UNTILBREAK:
+        return NEEDS_LIST(&((ast_expr_whilecontinue_t*) expr)->statements);
+    case EXPR_CALL_METHOD: {
+            ast_expr_call_method_t *call_stmt = (ast_expr_call_method_t*) expr;
+            return NEEDS_EXPR(call_stmt->value)
+                || NEEDS_EXPRS(call_stmt->args, call_stmt->arity)
+                || (call_stmt->gives.elements_length != 0 && NEEDS_TYPE(&call_stmt->gives));
+        }
+    case EXPR_DELETE:
+        return NEEDS_EXPR(((ast_expr_unary_t*) expr)->value);
+    case EXPR_EACH_IN: {
+            ast_expr_each_in_t *loop = (ast_expr_each_in_t*) expr;
+            return NEEDS_TYPE(loop->it_type)
+                || NEEDS_EXPR(loop->low_array)
+                || NEEDS_EXPR(loop->length)
+                || NEEDS_EXPR(loop->list)
+                || NEEDS_LIST(&loop->statements);
+        }
+    case EXPR_REPEAT: {
+            ast_expr_repeat_t *loop = (ast_expr_repeat_t*) expr;
+            return NEEDS_EXPR(loop->limit) || NEEDS_LIST(&loop->statements);
+        }
+    case EXPR_SWITCH: {
+            ast_expr_switch_t *switch_stmt = (ast_expr_switch_t*) expr;
+            if(NEEDS_EXPR(switch_stmt->value) || NEEDS_LIST(&switch_stmt->or_default)) return true;
+
+            for(length_t c = 0; c != switch_stmt->cases.length; c++){
+                ast_case_t *expr_case = &switch_stmt->cases.cases[c];
+                if(NEEDS_EXPR(expr_case->condition) || NEEDS_LIST(&expr_case->statements)) return true;
+            }
+            return false;
+        }
+    case EXPR_ADD:
+    case EXPR_SUBTRACT:
+    case EXPR_MULTIPLY:
+    case EXPR_DIVIDE:
+    case EXPR_MODULUS:
+    case EXPR_EQUALS:
+    case EXPR_NOTEQUALS:
+    case EXPR_GREATER:
+    case EXPR_LESSER:
+    case EXPR_GREATEREQ:
+    case EXPR_LESSEREQ:
+    case EXPR_BIT_AND:
+    case EXPR_BIT_OR:
+    case EXPR_BIT_XOR:
+    case EXPR_BIT_LSHIFT:
+    case EXPR_BIT_RSHIFT:
+    case EXPR_BIT_LGC_LSHIFT:
+    case EXPR_BIT_LGC_RSHIFT:
+    case EXPR_AND:
+    case EXPR_OR:
+        return NEEDS_EXPR(((ast_expr_math_t*) expr)->a) || NEEDS_EXPR(((ast_expr_math_t*) expr)->b);
+    case EXPR_MEMBER:
+        return NEEDS_EXPR(((ast_expr_member_t*) expr)->value);
+    case EXPR_ADDRESS:
+    case EXPR_DEREFERENCE:
+    case EXPR_NOT:
+    case EXPR_BIT_COMPLEMENT:
+    case EXPR_NEGATE:
+        return NEEDS_EXPR(((ast_expr_unary_t*) expr)->value);
+    case EXPR_FUNC_ADDR: {
+            ast_expr_func_addr_t *func_addr = (ast_expr_func_addr_t*) expr;
+
+            if(func_addr->match_args != NULL) for(length_t a = 0; a != func_addr->match_args_length; a++){
+                if(NEEDS_TYPE(&func_addr->match_args[a])) return true;
+            }
+            return false;
+        }
+    case EXPR_AT:
+    case EXPR_ARRAY_ACCESS:
+        return NEEDS_EXPR(((ast_expr_array_access_t*) expr)->index) || NEEDS_EXPR(((ast_expr_array_access_t*) expr)->value);
+    case EXPR_CAST:
+        return NEEDS_TYPE(&((ast_expr_cast_t*) expr)->to) || NEEDS_EXPR(((ast_expr_cast_t*) expr)->from);
+    case EXPR_SIZEOF:
+    case EXPR_ALIGNOF:
+    case EXPR_TYPEINFO:
+    case EXPR_TYPENAMEOF:
+        return NEEDS_TYPE(&((ast_expr_unary_type_t*) expr)->type);
+    case EXPR_NEW: {
+            ast_expr_new_t *new_expr = (ast_expr_new_t*) expr;
+            return NEEDS_TYPE(&new_expr->type)
+                || NEEDS_EXPR(new_expr->amount)
+                || (new_expr->inputs.has && NEEDS_LIST(&new_expr->inputs.value));
+        }
+    case EXPR_STATIC_ARRAY: {
+            ast_expr_static_data_t *static_array = (ast_expr_static_data_t*) expr;
+            return NEEDS_TYPE(&static_array->type) || NEEDS_EXPRS(static_array->values, static_array->length);
+        }
+    case EXPR_STATIC_STRUCT:
+        return NEEDS_TYPE(&((ast_expr_static_data_t*) expr)->type);
+    case EXPR_TERNARY: {
+            ast_expr_ternary_t *ternary = (ast_expr_ternary_t*) expr;
+            return NEEDS_EXPR(ternary->condition) || NEEDS_EXPR(ternary->if_true) || NEEDS_EXPR(ternary->if_false);
+        }
+    case EXPR_ILDECLARE: case EXPR_ILDECLAREUNDEF: {
+            ast_expr_inline_declare_t *def = (ast_expr_inline_declare_t*) expr;
+            return NEEDS_TYPE(&def->type) || NEEDS_EXPR(def->value);
+        }
+    case EXPR_POLYCOUNT:
+        return true;
+    default:
+        // Left as-is by 'ast_resolve_expr_polymorphs'
+        break;
+    }
+
+    #undef NEEDS_TYPE
+    #undef NEEDS_EXPR
+    #undef NEEDS_EXPRS
+    #undef NEEDS_LIST
+    return false;
+}
+
+static bool ast_resolve_exprs_is_needed(compiler_t *compiler, rtti_collector_t *rtti_collector, ast_expr_t **exprs, length_t count){
+    for(length_t i = 0; i != count; i++){
+        if(ast_resolve_expr_is_needed(compiler, rtti_collector, exprs[i])) return true;
+    }
+    return false;
+}
+
+static errorcode_t ast_resolve_expr_clone_polymorphs(compiler_t *compiler, rtti_collector_t *rtti_collector, ast_poly_catalog_t *catalog, ast_expr_t *expr, ast_expr_t **out_expr){
+    *out_expr = ast_expr_clone_if_not_null(expr);
+    return *out_expr ? ast_resolve_expr_polymorphs(compiler, rtti_collector, catalog, *out_expr) : SUCCESS;
+}
+
+static errorcode_t ast_resolve_stmt_polymorphs_into(
+    compiler_t *compiler,
+    rtti_collector_t *rtti_collector,
+    ast_poly_catalog_t *catalog,
+    ast_expr_t *stmt,
+    ast_expr_t **out_stmt,
+    ast_expr_list_t *shared_exprs
+){
+    // NOTE: '*out_stmt' is set as soon as there is something for the caller to free on failure
+
+    if(!ast_resolve_expr_is_needed(compiler, rtti_collector, stmt)){
+        ast_expr_share(stmt, shared_exprs);
+        *out_stmt = stmt;
+        return SUCCESS;
+    }
+
+    switch(stmt->id){
+    case EXPR_IF: case EXPR_UNLESS: case EXPR_WHILE: case EXPR_UNTIL:
+    case EXPR_WHILECONTINUE: case EXPR_UNTILBREAK: {
+            ast_expr_if_t *original = (ast_expr_if_t*) stmt;
+
+            ast_expr_if_t *conditional = ast_node_alloc_init(ast_expr_if_t, {
+                .id = original->id,
+                .source = original->source,
+                .label = original->label,
+            });
+
+            *out_stmt = (ast_expr_t*) conditional;
+
+            if(stmt->id == EXPR_WHILECONTINUE || stmt->id == EXPR_UNTILBREAK){
+                conditional->value = ast_expr_clone_if_not_null(original->value);
+            } else if(ast_resolve_expr_clone_polymorphs(compiler, rtti_collector, catalog, original->value, &conditional->value)){
+                return FAILURE;
+            }
+
+            return ast_resolve_expr_list_polymorphs_into(compiler, rtti_collector, catalog, &original->statements, &conditional->statements, shared_exprs);
+        }
+    case EXPR_IFELSE: case EXPR_UNLESSELSE: {
+            ast_expr_ifelse_t *original = (ast_expr_ifelse_t*) stmt;
+
+            ast_expr_ifelse_t *complex_conditional = ast_node_alloc_init(ast_expr_ifelse_t, {
+                .id = original->id,
+                .source = original->source,
+                .label = original->label,
+            });
+
+            *out_stmt = (ast_expr_t*) complex_conditional;
+
+            return ast_resolve_expr_clone_polymorphs(compiler, rtti_collector, catalog, original->value, &complex_conditional->value)
+                || ast_resolve_expr_list_polymorphs_into(compiler, rtti_collector, catalog, &original->statements, &complex_conditional->statements, shared_exprs)
+                || ast_resolve_expr_list_polymorphs_into(compiler, rtti_collector, catalog, &original->else_statements, &complex_conditional->else_statements, shared_exprs);
+        }
+    case EXPR_REPEAT: {
+            ast_expr_repeat_t *original = (ast_expr_repeat_t*) stmt;
+
+            ast_expr_repeat_t *loop = ast_node_alloc_init(ast_expr_repeat_t, {
+                .id = original->id,
+                .source = original->source,
+                .label = original->label,
+                .is_static = original->is_static,
+                .idx_name = original->idx_name,
+            });
+
+            *out_stmt = (ast_expr_t*) loop;
+
+            return ast_resolve_expr_clone_polymorphs(compiler, rtti_collector, catalog, original->limit, &loop->limit)
+                || ast_resolve_expr_list_polymorphs_into(compiler, rtti_collector, catalog, &original->statements, &loop->statements, shared_exprs);
+        }
+    default:
+        // Anything else that involves polymorphs is cloned and resolved as a whole
+        return ast_resolve_expr_clone_polymorphs(compiler, rtti_collector, catalog, stmt, out_stmt);
+    }
+}
+
+errorcode_t ast_resolve_expr_list_polymorphs_into(
+    compiler_t *compiler,
+    rtti_collector_t *rtti_collector,
+    ast_poly_catalog_t *catalog,
+    ast_expr_list_t *template_exprs,
+    ast_expr_list_t *out_exprs,
+    ast_expr_list_t *shared_exprs
+){
+    ast_expr_list_t exprs = ast_expr_list_create(template_exprs->length);
+
+    for(length_t i = 0; i != template_exprs->length; i++){
+        ast_expr_t **slot = &exprs.statements[exprs.length++];
+        *slot = NULL;
+
+        if(ast_resolve_stmt_polymorphs_into(compiler, rtti_collector, catalog, template_exprs->statements[i], slot, shared_exprs)){
+            ast_expr_list_free(&exprs);
+            *out_exprs = (ast_expr_list_t){0};
+            return FAILURE;
+        }
+    }
+
+    *out_exprs = exprs;
+    return SUCCESS;
+}
@@ -5,6 +5,7 @@
 
 #include "AST/ast_expr.h"
 #include "AST/ast_layout.h"
+#include "AST/ast_node_alloc.h"
 #include "AST/ast_type.h"
 #include "UTIL/color.h"
 #include "UTIL/ground.h"
@@ -74,65 +75,43 @@ ast_elem_t *ast_elem_clone(const ast_elem_t *original){
 }
 
 static ast_elem_t *ast_elem_empty_clone(const ast_elem_t *original){
-    return (ast_elem_t*) memcpy(
-        malloc(sizeof(ast_elem_t)),
-        original,
-        sizeof(ast_elem_t)
-    );
+    return (ast_elem_t*) ast_node_memclone(original, sizeof(ast_elem_t));
 }
 
 static ast_elem_t *ast_elem_base_clone(const ast_elem_base_t *original){
-    ast_elem_base_t *clone = malloc(sizeof *original);
-
-    *clone = (ast_elem_base_t){
+    return (ast_elem_t*) ast_node_alloc_init(ast_elem_base_t, {
         .id = AST_ELEM_BASE,
         .source = original->source,
-        .base = strclone(original->base),
-    };
-
-    return (ast_elem_t*) clone;
+        .base = original->base,
+    });
 }
 
 static ast_elem_t *ast_elem_fixed_array_clone(const ast_elem_fixed_array_t *original){
-    ast_elem_fixed_array_t *clone = malloc(sizeof *original);
-
-    *clone = (ast_elem_fixed_array_t){
+    return (ast_elem_t*) ast_node_alloc_init(ast_elem_fixed_array_t, {
         .id = AST_ELEM_FIXED_ARRAY,
         .source = original->source,
         .length = original->length,
-    };
-
-    return (ast_elem_t*) clone;
+    });
 }
 
 static ast_elem_t *ast_elem_var_fixed_array_clone(const ast_elem_var_fixed_array_t *original){
-    ast_elem_var_fixed_array_t *clone = malloc(sizeof *original);
-
-    *clone = (ast_elem_var_fixed_array_t){
+    return (ast_elem_t*) ast_node_alloc_init(ast_elem_var_fixed_array_t, {
         .id = AST_ELEM_VAR_FIXED_ARRAY,
         .source = original->source,
         .length = ast_expr_clone(original->length),
-    };
-
-    return (ast_elem_t*) clone;
+    });
 }
 
 static ast_elem_t *ast_elem_polycount_clone(const ast_elem_polycount_t *original){
-    ast_elem_polycount_t *clone = malloc(sizeof *original);
-
-    *clone = (ast_elem_polycount_t){
+    return (ast_elem_t*) ast_node_alloc_init(ast_elem_polycount_t, {
         .id = AST_ELEM_POLYCOUNT,
         .source = original->source,
         .name = strclone(original->name),
-    };
-
-    return (ast_elem_t*) clone;
+    });
 }
 
 static ast_elem_t *ast_elem_func_clone(const ast_elem_func_t *original){
-    ast_elem_func_t *clone = malloc(sizeof *original);
-
-    *clone = (ast_elem_func_t){
+    return (ast_elem_t*) ast_node_alloc_init(ast_elem_func_t, {
         .id = AST_ELEM_FUNC,
         .source = original->source,
         .arg_types = ast_types_clone(original->arg_types, original->arity),
@@ -140,68 +119,50 @@ static ast_elem_t *ast_elem_func_clone(const ast_elem_func_t *original){
         .return_type = ast_types_clone(original->return_type, 1),
         .traits = original->traits,
         .ownership = true,
-    };
-
-    return (ast_elem_t*) clone;
+    });
 }
 
 static ast_elem_t *ast_elem_polymorph_clone(const ast_elem_polymorph_t *original){
-    ast_elem_polymorph_t *clone = malloc(sizeof *original);
-
-    *clone = (ast_elem_polymorph_t){
+    return (ast_elem_t*) ast_node_alloc_init(ast_elem_polymorph_t, {
         .id = AST_ELEM_POLYMORPH,
         .source = original->source,
         .name = strclone(original->name),
         .allow_auto_conversion = original->allow_auto_conversion,
-    };
-
-    return (ast_elem_t*) clone;
+    });
 }
 
 static ast_elem_t *ast_elem_polymorph_prereq_clone(const ast_elem_polymorph_prereq_t *original){
-    ast_elem_polymorph_prereq_t *clone = malloc(sizeof *original);
-
-    *clone = (ast_elem_polymorph_prereq_t){
+    return (ast_elem_t*) ast_node_alloc_init(ast_elem_polymorph_prereq_t, {
         .id = AST_ELEM_POLYMORPH_PREREQ,
         .source = original->source,
         .name = strclone(original->name),
         .allow_auto_conversion = original->allow_auto_conversion,
-        .similarity_prerequisite = strclone(original->similarity_prerequisite),
+        .similarity_prerequisite = original->similarity_prerequisite ? strclone(original->similarity_prerequisite) : NULL,
         .extends = original->extends.elements_length == 0 ? (ast_type_t){0} : ast_type_clone(&original->extends),
-    };
-
-    return (ast_elem_t*) clone;
+    });
 }
 
 static ast_elem_t *ast_elem_generic_base_clone(const ast_elem_generic_base_t *original){
-    ast_elem_generic_base_t *clone = malloc(sizeof *original);
-
-    *clone = (ast_elem_generic_base_t){
+    return (ast_elem_t*) ast_node_alloc_init(ast_elem_generic_base_t, {
         .id = AST_ELEM_GENERIC_BASE,
         .source = original->source,
-        .name = strclone(original->name),
+        .name = original->name,
         .generics = ast_types_clone(original->generics, original->generics_length),
         .generics_length = original->generics_length,
         .name_is_polymorphic = original->name_is_polymorphic,
-    };
-
-    return (ast_elem_t*) clone;
+    });
 }
 
 static ast_elem_t *ast_elem_layout_clone(const ast_elem_layout_t *original){
-    ast_elem_layout_t *clone = malloc(sizeof *original);
-
-    *clone = (ast_elem_layout_t){
+    return (ast_elem_t*) ast_node_alloc_init(ast_elem_layout_t, {
         .id = AST_ELEM_LAYOUT,
         .source = original->source,
         .layout = ast_layout_clone(&original->layout),
-    };
-
-    return (ast_elem_t*) clone;
+    });
 }
 
 static ast_elem_t *ast_elem_unknown_enum_clone(const ast_elem_unknown_enum_t *original){
-    return (ast_elem_t*) malloc_init(ast_elem_unknown_enum_t, {
+    return (ast_elem_t*) ast_node_alloc_init(ast_elem_unknown_enum_t, {
         .id = AST_ELEM_UNKNOWN_ENUM,
         .source = original->source,
         .kind_name = original->kind_name,
@@ -209,7 +170,7 @@ static ast_elem_t *ast_elem_unknown_enum_clone(const ast_elem_unknown_enum_t *or
 }
 
 static ast_elem_t *ast_elem_unknown_plural_enum_clone(const ast_elem_unknown_plural_enum_t *original){
-    return (ast_elem_t*) malloc_init(ast_elem_unknown_plural_enum_t, {
+    return (ast_elem_t*) ast_node_alloc_init(ast_elem_unknown_plural_enum_t, {
         .id = AST_ELEM_UNKNOWN_PLURAL_ENUM,
         .source = original->source,
         .kinds = strong_cstr_list_clone(&original->kinds),
@@ -217,7 +178,7 @@ static ast_elem_t *ast_elem_unknown_plural_enum_clone(const ast_elem_unknown_plu
 }
 
 static ast_elem_t *ast_elem_anonymous_enum_clone(const ast_elem_anonymous_enum_t *original){
-    return (ast_elem_t*) malloc_init(ast_elem_anonymous_enum_t, {
+    return (ast_elem_t*) ast_node_alloc_init(ast_elem_anonymous_enum_t, {
         .id = AST_ELEM_ANONYMOUS_ENUM,
         .source = original->source,
         .kinds = strong_cstr_list_clone(&original->kinds),
@@ -3,6 +3,7 @@
 
 #include "AST/ast_expr.h"
 #include "AST/ast_layout.h"
+#include "AST/ast_node_alloc.h"
 #include "AST/ast_type.h"
 #include "UTIL/color.h"
 #include "UTIL/ground.h"
@@ -33,8 +34,6 @@ void ast_elems_free(ast_elem_t **elements, length_t elements_length){
 
         switch(elem->id){
         case AST_ELEM_BASE:
-            free(((ast_elem_base_t*) elem)->base);
-            break;
         case AST_ELEM_POINTER:
         case AST_ELEM_ARRAY:
         case AST_ELEM_FIXED_ARRAY:
@@ -68,7 +67,6 @@ void ast_elems_free(ast_elem_t **elements, length_t elements_length){
         case AST_ELEM_GENERIC_BASE: {
                 ast_elem_generic_base_t *generic_base_elem = (ast_elem_generic_base_t*) elem;
                 ast_types_free_fully(generic_base_elem->generics, generic_base_elem->generics_length);
-                free(generic_base_elem->name);
             }
             break;
         case AST_ELEM_LAYOUT:
@@ -89,7 +87,7 @@ void ast_elems_free(ast_elem_t **elements, length_t elements_length){
             die("ast_elems_free() - Unrecognized type element ID %zu at index %zu\n", (size_t) elem->id, i);
         }
 
-        free(elem);
+        ast_node_free(elem);
     }
 }
 
@@ -24,7 +24,8 @@ static hash_t ast_elem_func_hash(const ast_elem_func_t *elem, hash_t working_has
 }
 
 static hash_t ast_elem_polymorph_hash(const ast_elem_polymorph_t *elem, hash_t working_hash){
-    return hash_combine(working_hash, hash_string(elem->name));
+    working_hash = elem->allow_auto_conversion ? hash_combine(working_hash, hash_string("~")) : working_hash;
+    return         hash_combine(working_hash, hash_string(elem->name));
 }
 
 static hash_t ast_elem_polycount_hash(const ast_elem_polycount_t *elem, hash_t working_hash){
@@ -33,7 +34,8 @@ static hash_t ast_elem_polycount_hash(const ast_elem_polycount_t *elem, hash_t w
 }
 
 static hash_t ast_elem_polymorph_prereq_hash(const ast_elem_polymorph_prereq_t *elem, hash_t working_hash){
-    working_hash = hash_combine(working_hash, hash_string(elem->similarity_prerequisite));
+    working_hash = elem->allow_auto_conversion ? hash_combine(working_hash, hash_string("~")) : working_hash;
+    working_hash = elem->similarity_prerequisite ? hash_combine(working_hash, hash_string(elem->similarity_prerequisite)) : working_hash;
     working_hash = hash_combine(working_hash, hash_string(elem->name));
     working_hash = elem->extends.elements_length != 0 ? hash_combine(working_hash, ast_type_hash(&elem->extends)) : working_hash;
     return working_hash;
@@ -5,6 +5,7 @@
 
 #include "AST/TYPE/ast_type_make.h"
 #include "AST/ast_layout.h"
+#include "AST/ast_node_alloc.h"
 #include "AST/ast_type.h"
 #include "UTIL/color.h"
 #include "UTIL/ground.h"
@@ -93,7 +94,7 @@ void ast_type_dereference(ast_type_t *inout_type){
 
     // Modify ast_type_t to remove a pointer element from the front
     // DANGEROUS: Manually deleting ast_elem_pointer_t
-    free(inout_type->elements[0]);
+    ast_node_free(inout_type->elements[0]);
     memmove(inout_type->elements, &inout_type->elements[1], sizeof(ast_elem_t*) * (inout_type->elements_length - 1));
     inout_type->elements_length--; // Reduce length accordingly
     inout_type->source = inout_type->elements[0]->source;
@@ -114,7 +115,7 @@ void ast_type_unwrap_fixed_array(ast_type_t *inout_type){
 
     // Modify ast_type_t to remove a fixed-array element from the front
     // DANGEROUS: Manually deleting ast_elem_fixed_array_t
-    free(inout_type->elements[0]);
+    ast_node_free(inout_type->elements[0]);
     memmove(inout_type->elements, &inout_type->elements[1], sizeof(ast_elem_t*) * (inout_type->elements_length - 1));
     inout_type->elements_length--; // Reduce length accordingly
 }
@@ -3,8 +3,10 @@
 #include <stdlib.h>
 
 #include "AST/TYPE/ast_type_make.h"
+#include "AST/ast_node_alloc.h"
 #include "AST/ast_type.h"
 #include "UTIL/ground.h"
+#include "UTIL/intern.h"
 #include "UTIL/string.h"
 #include "UTIL/trait.h"
 
@@ -13,25 +15,25 @@
 // =====================================================================
 
 ast_elem_t *ast_elem_empty_make(unsigned int id, source_t source){
-    return (ast_elem_t*) malloc_init(ast_elem_t, {
+    return (ast_elem_t*) ast_node_alloc_init(ast_elem_t, {
         .id = id,
         .source = source,
     });
 }
 
-ast_elem_t *ast_elem_base_make(strong_cstr_t base, source_t source){
-    return (ast_elem_t*) malloc_init(ast_elem_base_t, {
+ast_elem_t *ast_elem_base_make(const char *base, source_t source){
+    return (ast_elem_t*) ast_node_alloc_init(ast_elem_base_t, {
         .id = AST_ELEM_BASE,
         .source = source,
-        .base = base,
+        .base = intern_name(base),
     });
 }
 
-ast_elem_t *ast_elem_generic_base_make(strong_cstr_t base, source_t source, ast_type_t *generics, length_t generics_length){
-    return (ast_elem_t*) malloc_init(ast_elem_generic_base_t, {
+ast_elem_t *ast_elem_generic_base_make(const char *base, source_t source, ast_type_t *generics, length_t generics_length){
+    return (ast_elem_t*) ast_node_alloc_init(ast_elem_generic_base_t, {
         .id = AST_ELEM_GENERIC_BASE,
         .source = source,
-        .name = base,
+        .name = intern_name(base),
         .name_is_polymorphic = false,
         .generics = generics,
         .generics_length = generics_length,
@@ -39,7 +41,7 @@ ast_elem_t *ast_elem_generic_base_make(strong_cstr_t base, source_t source, ast_
 }
 
 ast_elem_t *ast_elem_polymorph_make(strong_cstr_t name, source_t source, bool allow_auto_conversion){
-    return (ast_elem_t*) malloc_init(ast_elem_polymorph_t, {
+    return (ast_elem_t*) ast_node_alloc_init(ast_elem_polymorph_t, {
         .id = AST_ELEM_POLYMORPH,
         .source = source,
         .name = name,
@@ -48,7 +50,7 @@ ast_elem_t *ast_elem_polymorph_make(strong_cstr_t name, source_t source, bool al
 }
 
 ast_elem_t *ast_elem_polymorph_prereq_make(strong_cstr_t name, source_t source, bool allow_auto_conversion, maybe_null_strong_cstr_t similarity_prerequisite, ast_type_t extends){
-    return (ast_elem_t*) malloc_init(ast_elem_polymorph_prereq_t, {
+    return (ast_elem_t*) ast_node_alloc_init(ast_elem_polymorph_prereq_t, {
         .id = AST_ELEM_POLYMORPH_PREREQ,
         .source = source,
         .name = name,
@@ -59,7 +61,7 @@ ast_elem_t *ast_elem_polymorph_prereq_make(strong_cstr_t name, source_t source,
 }
 
 ast_elem_t *ast_elem_func_make(source_t source, ast_type_t *arg_types, length_t arity, ast_type_t *return_type, trait_t traits, bool have_ownership){
-    return (ast_elem_t*) malloc_init(ast_elem_func_t, {
+    return (ast_elem_t*) ast_node_alloc_init(ast_elem_func_t, {
         .id = AST_ELEM_FUNC,
         .source = source,
         .arg_types = arg_types,
@@ -71,7 +73,7 @@ ast_elem_t *ast_elem_func_make(source_t source, ast_type_t *arg_types, length_t
 }
 
 ast_elem_t *ast_elem_fixed_array_make(source_t source, length_t count){
-    return (ast_elem_t*) malloc_init(ast_elem_fixed_array_t, {
+    return (ast_elem_t*) ast_node_alloc_init(ast_elem_fixed_array_t, {
         .id = AST_ELEM_FIXED_ARRAY,
         .source = source,
         .length = count,
@@ -79,7 +81,7 @@ ast_elem_t *ast_elem_fixed_array_make(source_t source, length_t count){
 }
 
 ast_elem_t *ast_elem_var_fixed_array_make(source_t source, ast_expr_t *length){
-    return (ast_elem_t*) malloc_init(ast_elem_var_fixed_array_t, {
+    return (ast_elem_t*) ast_node_alloc_init(ast_elem_var_fixed_array_t, {
         .id = AST_ELEM_VAR_FIXED_ARRAY,
         .source = source,
         .length = length,
@@ -87,7 +89,7 @@ ast_elem_t *ast_elem_var_fixed_array_make(source_t source, ast_expr_t *length){
 }
 
 ast_elem_t *ast_elem_unknown_enum_make(source_t source, weak_cstr_t kind_name){
-    return (ast_elem_t*) malloc_init(ast_elem_unknown_enum_t, {
+    return (ast_elem_t*) ast_node_alloc_init(ast_elem_unknown_enum_t, {
         .id = AST_ELEM_UNKNOWN_ENUM,
         .source = source,
         .kind_name = kind_name,
@@ -95,7 +97,7 @@ ast_elem_t *ast_elem_unknown_enum_make(source_t source, weak_cstr_t kind_name){
 }
 
 ast_elem_t *ast_elem_unknown_plural_enum_make(source_t source, strong_cstr_list_t kinds){
-    return (ast_elem_t*) malloc_init(ast_elem_unknown_plural_enum_t, {
+    return (ast_elem_t*) ast_node_alloc_init(ast_elem_unknown_plural_enum_t, {
         .id = AST_ELEM_UNKNOWN_PLURAL_ENUM,
         .source = source,
         .kinds = kinds,
@@ -119,7 +121,7 @@ ast_elem_t *ast_elem_anonymous_enum_make(source_t source, const char **raw_kinds
     strong_cstr_list_sort(&kinds);
 
     // Return completed anonymous enum type element
-    return (ast_elem_t*) malloc_init(ast_elem_anonymous_enum_t, {
+    return (ast_elem_t*) ast_node_alloc_init(ast_elem_anonymous_enum_t, {
         .id = AST_ELEM_ANONYMOUS_ENUM,
         .source = source,
         .kinds = kinds,
@@ -164,20 +166,20 @@ static ast_type_t from_3elems(ast_elem_t *a, ast_elem_t *b, ast_elem_t *c){
 // =                          ast_type_make_*                          =
 // =====================================================================
 
-ast_type_t ast_type_make_base(strong_cstr_t base){
+ast_type_t ast_type_make_base(const char *base){
     return from_1elems(
         ast_elem_base_make(base, NULL_SOURCE)
     );
 }
 
-ast_type_t ast_type_make_base_ptr(strong_cstr_t base){
+ast_type_t ast_type_make_base_ptr(const char *base){
     return from_2elems(
         ast_elem_pointer_make(NULL_SOURCE),
         ast_elem_base_make(base, NULL_SOURCE)
     );
 }
 
-ast_type_t ast_type_make_base_ptr_ptr( strong_cstr_t base){
+ast_type_t ast_type_make_base_ptr_ptr(const char *base){
     return from_3elems(
         ast_elem_pointer_make(NULL_SOURCE),
         ast_elem_pointer_make(NULL_SOURCE),
@@ -185,7 +187,7 @@ ast_type_t ast_type_make_base_ptr_ptr( strong_cstr_t base){
     );
 }
 
-ast_type_t ast_type_make_base_with_polymorphs(strong_cstr_t base, weak_cstr_t *generics, length_t length){
+ast_type_t ast_type_make_base_with_polymorphs(const char *base, weak_cstr_t *generics, length_t length){
     ast_type_t *polymorphs = ast_type_make_polymorph_list(generics, length);
 
     return from_1elems(
@@ -0,0 +1,127 @@
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "AST/TYPE/ast_type_hash.h"
+#include "AST/TYPE/ast_type_identical.h"
+#include "AST/TYPE/ast_type_table.h"
+#include "AST/ast.h"
+#include "AST/ast_type.h"
+#include "UTIL/arena.h"
+#include "UTIL/ground.h"
+#include "UTIL/hash.h"
+#include "UTIL/set.h"
+#include "UTIL/string.h"
+
+static hash_t ast_type_table_hash(const void *canonical){
+    return ast_type_hash(&((const ast_canonical_type_t*) canonical)->type);
+}
+
+static bool ast_type_table_equals(const void *a, const void *b){
+    return ast_types_identical(&((const ast_canonical_type_t*) a)->type, &((const ast_canonical_type_t*) b)->type);
+}
+
+static bool ast_type_table_is_exact(const ast_type_t *type);
+
+static bool ast_type_table_are_exact(const ast_type_t *types, length_t length){
+    for(length_t i = 0; i != length; i++){
+        if(!ast_type_table_is_exact(&types[i])) return false;
+    }
+    return true;
+}
+
+static bool ast_type_table_is_exact(const ast_type_t *type){
+    // Returns whether a type can only be identical to types that have the same hash
+    // NOTE: 'ast_types_identical' treats some different types as the same (such as 'usize' and 'ulong'),
+    //       and can't compare some types at all (such as uncollapsed variable fixed arrays)
+
+    for(length_t i = 0; i != type->elements_length; i++){
+        const ast_elem_t *elem = type->elements[i];
+
+        switch(elem->id){
+        case AST_ELEM_BASE: {
+                weak_cstr_t base = ((const ast_elem_base_t*) elem)->base;
+
+                if(streq(base, "usize") || streq(base, "ulong") || streq(base, "successful") || streq(base, "bool")){
+                    return false;
+                }
+            }
+            break;
+        case AST_ELEM_FUNC: {
+                const ast_elem_func_t *func = (const ast_elem_func_t*) elem;
+
+                // Only some traits are compared, but all of them are hashed
+                if(func->traits & ~(AST_FUNC_VARARG | AST_FUNC_STDCALL)) return false;
+                if(!ast_type_table_are_exact(func->arg_types, func->arity) || !ast_type_table_is_exact(func->return_type)) return false;
+            }
+            break;
+        case AST_ELEM_GENERIC_BASE: {
+                const ast_elem_generic_base_t *generic_base = (const ast_elem_generic_base_t*) elem;
+                if(!ast_type_table_are_exact(generic_base->generics, generic_base->generics_length)) return false;
+            }
+            break;
+        case AST_ELEM_POLYMORPH_PREREQ:
+            if(!ast_type_table_is_exact(&((const ast_elem_polymorph_prereq_t*) elem)->extends)) return false;
+            break;
+        case AST_ELEM_LAYOUT:
+        case AST_ELEM_VAR_FIXED_ARRAY:
+            return false;
+        default:
+            break;
+        }
+    }
+
+    return true;
+}
+
+void ast_type_table_free(ast_type_table_t *table){
+    for(length_t i = 0; i != table->impl.capacity; i++){
+        ast_canonical_type_t *canonical = table->impl.entries[i].data;
+        if(canonical) ast_type_free(&canonical->type);
+    }
+
+    set_free(&table->impl, NULL);
+    arena_free(&table->storage);
+}
+
+const ast_type_t *ast_type_table_canonical(ast_type_table_t *table, const ast_type_t *type){
+    if(table->impl.capacity == 0){
+        set_init(&table->impl, 48, &ast_type_table_hash, &ast_type_table_equals, NULL);
+    }
+
+    // Lookups only need the type part of a canonical type
+    ast_canonical_type_t probe = (ast_canonical_type_t){
+        .type = *type,
+        .hash = ast_type_hash(type),
+    };
+
+    ast_canonical_type_t *canonical = set_find_hashed(&table->impl, &probe, probe.hash);
+
+    if(canonical == NULL){
+        probe.type = ast_type_clone(type);
+        probe.exact = ast_type_table_is_exact(type);
+        canonical = arena_memclone(&table->storage, &probe, sizeof probe);
+        set_insert_hashed(&table->impl, canonical, probe.hash);
+    }
+
+    return &canonical->type;
+}
+
+const ast_type_t *ast_type_table_find(const ast_type_table_t *table, const ast_type_t *type){
+    if(table->impl.count == 0) return NULL;
+
+    ast_canonical_type_t probe = (ast_canonical_type_t){
+        .type = *type,
+    };
+
+    ast_canonical_type_t *canonical = set_find_hashed(&table->impl, &probe, ast_type_hash(type));
+    return canonical ? &canonical->type : NULL;
+}
+
+bool ast_canonical_types_identical(const ast_type_t *a, const ast_type_t *b){
+    const ast_canonical_type_t *canonical_a = (const ast_canonical_type_t*) a;
+    const ast_canonical_type_t *canonical_b = (const ast_canonical_type_t*) b;
+
+    if(canonical_a->exact && canonical_b->exact) return a == b;
+    return ast_types_identical(a, b);
+}
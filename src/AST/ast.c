@@ -9,8 +9,10 @@
 #include "AST/TYPE/ast_type_make.h"
 #include "AST/UTIL/string_builder_extensions.h"
 #include "AST/ast_expr.h"
+#include "AST/ast_node_alloc.h"
 #include "AST/ast_type.h"
 #include "DRVR/compiler.h"
+#include "UTIL/intern.h"
 #include "UTIL/string.h"
 #include "UTIL/string_builder.h"
 #include "UTIL/util.h"
@@ -43,8 +45,8 @@ void ast_init(ast_t *ast, unsigned int cross_compile_for){
     ast->library_kinds = NULL;
     ast->libraries_length = 0;
     ast->libraries_capacity = 0;
-    ast->common.ast_int_type = ast_type_make_base(strclone("int"));
-    ast->common.ast_usize_type = ast_type_make_base(strclone("usize"));
+    ast->common.ast_int_type = ast_type_make_base("int");
+    ast->common.ast_usize_type = ast_type_make_base("usize");
     ast->common.ast_variadic_array = NULL;
     ast->common.ast_initializer_list = NULL;
 
@@ -60,6 +62,9 @@ void ast_init(ast_t *ast, unsigned int cross_compile_for){
     ast->poly_composites = NULL;
     ast->poly_composites_length = 0;
     ast->poly_composites_capacity = 0;
+    ast->composite_index = (ast_composite_index_t){0};
+    ast->shared_exprs = (ast_expr_list_t){0};
+    arena_init(&ast->node_arena, AST_NODE_ARENA_CHUNK_SIZE);
 
     // Add relevant standard meta definitions
 
@@ -210,12 +215,18 @@ void ast_free(ast_t *ast){
     }
 
     free(ast->poly_composites);
+    ast_composite_index_free(&ast->composite_index);
+
+    // Must come after freeing the functions that borrow them
+    ast_shared_exprs_free(&ast->shared_exprs);
+
+    // Must be last, since freeing everything else has to look at the nodes
+    arena_free(&ast->node_arena);
 }
 
 void ast_free_functions(ast_func_t *functions, length_t functions_length){
     for(length_t i = 0; i != functions_length; i++){
         ast_func_t *func = &functions[i];
-        free(func->name);
 
         if(func->arg_names){
             free_strings(func->arg_names, func->arity);
@@ -250,7 +261,6 @@ void ast_free_composites(ast_composite_t *composites, length_t composites_length
 
         ast_layout_free(&composite->layout);
         ast_type_free(&composite->parent);
-        free(composite->name);
     }
 }
 
@@ -274,9 +284,7 @@ void ast_free_globals(ast_global_t *globals, length_t globals_length){
 
 void ast_free_enums(ast_enum_t *enums, length_t enums_length){
     for(length_t i = 0; i != enums_length; i++){
-        ast_enum_t *enum_definition = &enums[i];
-        free(enum_definition->name);
-        free(enum_definition->kinds);
+        free(enums[i].kinds);
     }
 }
 
@@ -367,7 +375,7 @@ func_id_t ast_new_func(ast_t *ast){
 }
 
 void ast_func_create_template(compiler_t *compiler, ast_func_t *func, const ast_func_head_t *options){
-    func->name = options->name;
+    func->name = intern_name(options->name);
     func->arg_names = NULL;
     func->arg_types = NULL;
     func->arg_sources = NULL;
@@ -438,13 +446,8 @@ void ast_enum_init(ast_enum_t *enum_definition,  weak_cstr_t name, weak_cstr_t *
 }
 
 ast_composite_t *ast_composite_find_exact(ast_t *ast, const char *name){
-    // TODO: CLEANUP: SPEED: Maybe sort and do a binary search or something
-    for(length_t i = 0; i != ast->composites_length; i++){
-        if(streq(ast->composites[i].name, name)){
-            return &ast->composites[i];
-        }
-    }
-    return NULL;
+    maybe_index_t position = ast_composite_index_find(&ast->composite_index, name, 0);
+    return position >= 0 ? &ast->composites[position] : NULL;
 }
 
 successful_t ast_composite_find_exact_field(ast_composite_t *composite, const char *name, ast_layout_endpoint_t *out_endpoint, ast_layout_endpoint_path_t *out_path){
@@ -458,47 +461,22 @@ ast_poly_composite_t *ast_poly_composite_find_exact_from_elem(ast_t *ast, ast_el
 }
 
 ast_poly_composite_t *ast_poly_composite_find_exact(ast_t *ast, const char *name, length_t num_generics){
-    // TODO: Maybe sort and do a binary search or something
-    for(length_t i = 0; i != ast->poly_composites_length; i++){
-        ast_poly_composite_t *poly_composite = &ast->poly_composites[i];
-        if(streq(poly_composite->name, name) && poly_composite->generics_length == num_generics){
-            return poly_composite;
-        }
-    }
-    return NULL;
+    // Polymorphic composites always have at least one generic,
+    // so they never collide with regular composites in the index
+    if(num_generics == 0) return NULL;
+
+    maybe_index_t position = ast_composite_index_find(&ast->composite_index, name, num_generics);
+    return position >= 0 ? &ast->poly_composites[position] : NULL;
 }
 
 ast_composite_t *ast_find_composite(ast_t *ast, const ast_type_t *type){
     if(type->elements_length != 1) return NULL;
 
     switch(type->elements[0]->id){
-    case AST_ELEM_BASE: {
-            const char *target_name = ((ast_elem_base_t*) type->elements[0])->base;
-
-            for(length_t i = 0; i != ast->composites_length; i++){
-                ast_composite_t *composite = &ast->composites[i];
-
-                if(streq(composite->name, target_name)){
-                    return composite;
-                }
-            }
-        }
-        break;
-    case AST_ELEM_GENERIC_BASE: {
-            ast_elem_generic_base_t *generic_base_elem = (ast_elem_generic_base_t*) type->elements[0];
-
-            const char *target_name = generic_base_elem->name;
-            length_t generics_count = generic_base_elem->generics_length;
-
-            for(length_t i = 0; i != ast->poly_composites_length; i++){
-                ast_poly_composite_t *poly_composite = &ast->poly_composites[i];
-
-                if(streq(poly_composite->name, target_name) && poly_composite->generics_length == generics_count){
-                    return (ast_composite_t*) poly_composite;
-                }
-            }
-        }
-        break;
+    case AST_ELEM_BASE:
+        return ast_composite_find_exact(ast, ((ast_elem_base_t*) type->elements[0])->base);
+    case AST_ELEM_GENERIC_BASE:
+        return (ast_composite_t*) ast_poly_composite_find_exact_from_elem(ast, (ast_elem_generic_base_t*) type->elements[0]);
     }
 
     return NULL;
@@ -624,9 +602,9 @@ void ast_add_alias(ast_t *ast, strong_cstr_t name, ast_type_t strong_type, stron
     ast_alias_init(alias, name, strong_type, generics, generics_length, traits, source);
 }
 
-void ast_add_enum(ast_t *ast, strong_cstr_t name, weak_cstr_t *kinds, length_t length, source_t source){
+void ast_add_enum(ast_t *ast, const char *name, weak_cstr_t *kinds, length_t length, source_t source){
     expand((void**) &ast->enums, sizeof(ast_enum_t), ast->enums_length, &ast->enums_capacity, 1, 4);
-    ast_enum_init(&ast->enums[ast->enums_length++], name, kinds, length, source);
+    ast_enum_init(&ast->enums[ast->enums_length++], intern_name(name), kinds, length, source);
 }
 
 void ast_add_global_named_expression(ast_t *ast, ast_named_expression_t named_expression){
@@ -644,7 +622,7 @@ void ast_add_poly_func(ast_t *ast, weak_cstr_t func_name_persistent, func_id_t a
 
 ast_composite_t *ast_add_composite(
     ast_t *ast,
-    strong_cstr_t name,
+    const char *name,
     ast_layout_t layout,
     source_t source,
     ast_type_t maybe_parent,
@@ -652,10 +630,12 @@ ast_composite_t *ast_add_composite(
 ){
     expand((void**) &ast->composites, sizeof(ast_composite_t), ast->composites_length, &ast->composites_capacity, 1, 4);
 
+    weak_cstr_t atom = intern_name(name);
+    ast_composite_index_insert(&ast->composite_index, atom, 0, ast->composites_length);
     ast_composite_t *composite = &ast->composites[ast->composites_length++];
 
     *composite = (ast_composite_t){
-        .name = name,
+        .name = atom,
         .layout = layout,
         .source = source,
         .parent = maybe_parent,
@@ -669,7 +649,7 @@ ast_composite_t *ast_add_composite(
 
 ast_poly_composite_t *ast_add_poly_composite(
     ast_t *ast,
-    strong_cstr_t name,
+    const char *name,
     ast_layout_t layout,
     source_t source,
     ast_type_t maybe_parent,
@@ -679,10 +659,12 @@ ast_poly_composite_t *ast_add_poly_composite(
 ){
     expand((void**) &ast->poly_composites, sizeof(ast_poly_composite_t), ast->poly_composites_length, &ast->poly_composites_capacity, 1, 4);
 
+    weak_cstr_t atom = intern_name(name);
+    ast_composite_index_insert(&ast->composite_index, atom, generics_length, ast->poly_composites_length);
     ast_poly_composite_t *poly_composite = &ast->poly_composites[ast->poly_composites_length++];
 
     *poly_composite = (ast_poly_composite_t){
-        .name = name,
+        .name = atom,
         .layout = layout,
         .source = source,
         .parent = maybe_parent,
@@ -727,11 +709,11 @@ void va_args_inject_ast(compiler_t *compiler, ast_t *ast){
         };
 
         ast_type_t types[1] = {
-            ast_type_make_base(strclone("ptr")),
+            ast_type_make_base("ptr"),
         };
 
         ast_layout_init_with_struct_fields(&layout, names, types, NUM_ITEMS(names));
-        ast_add_composite(ast, strclone("va_list"), layout, NULL_SOURCE, AST_TYPE_NONE, false);
+        ast_add_composite(ast, "va_list", layout, NULL_SOURCE, AST_TYPE_NONE, false);
     } else {
         // Larger Intel x86_64 va_list
 
@@ -751,14 +733,14 @@ void va_args_inject_ast(compiler_t *compiler, ast_t *ast){
         };
 
         ast_type_t types[4] = {
-            ast_type_make_base(strclone("int")),
-            ast_type_make_base(strclone("int")),
-            ast_type_make_base(strclone("ptr")),
-            ast_type_make_base(strclone("ptr")),
+            ast_type_make_base("int"),
+            ast_type_make_base("int"),
+            ast_type_make_base("ptr"),
+            ast_type_make_base("ptr"),
         };
         
         ast_layout_init_with_struct_fields(&layout, names, types, NUM_ITEMS(names));
-        ast_add_composite(ast, strclone("va_list"), layout, NULL_SOURCE, AST_TYPE_NONE, false);
+        ast_add_composite(ast, "va_list", layout, NULL_SOURCE, AST_TYPE_NONE, false);
     }
 }
 
@@ -0,0 +1,54 @@
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "AST/ast_composite_index.h"
+#include "UTIL/arena.h"
+#include "UTIL/ground.h"
+#include "UTIL/hash.h"
+#include "UTIL/set.h"
+
+static hash_t ast_composite_index_hash(const void *raw_entry){
+    const ast_composite_index_entry_t *entry = raw_entry;
+    return hash_combine(hash_pointer(entry->name), entry->generics_length);
+}
+
+static bool ast_composite_index_equals(const void *raw_a, const void *raw_b){
+    const ast_composite_index_entry_t *a = raw_a;
+    const ast_composite_index_entry_t *b = raw_b;
+
+    // Names are interned, so their addresses identify them
+    return a->name == b->name && a->generics_length == b->generics_length;
+}
+
+void ast_composite_index_free(ast_composite_index_t *index){
+    set_free(&index->impl, NULL);
+    arena_free(&index->entries);
+}
+
+void ast_composite_index_insert(ast_composite_index_t *index, weak_cstr_t name, length_t generics_length, length_t position){
+    if(index->impl.capacity == 0){
+        set_init(&index->impl, 0, &ast_composite_index_hash, &ast_composite_index_equals, NULL);
+    }
+
+    ast_composite_index_entry_t key = (ast_composite_index_entry_t){
+        .name = name,
+        .generics_length = generics_length,
+    };
+
+    hash_t hash = ast_composite_index_hash(&key);
+    if(set_find_hashed(&index->impl, &key, hash)) return;
+
+    key.position = position;
+    set_insert_hashed(&index->impl, arena_memclone(&index->entries, &key, sizeof key), hash);
+}
+
+maybe_index_t ast_composite_index_find(ast_composite_index_t *index, const char *name, length_t generics_length){
+    ast_composite_index_entry_t key = (ast_composite_index_entry_t){
+        .name = (weak_cstr_t) name,
+        .generics_length = generics_length,
+    };
+
+    ast_composite_index_entry_t *entry = set_find(&index->impl, &key);
+    return entry ? (maybe_index_t) entry->position : -1;
+}
@@ -12,11 +12,16 @@
 #include "AST/ast_type.h"
 #include "UTIL/color.h"
 #include "UTIL/ground.h"
+#include "UTIL/hash.h"
+#include "UTIL/set.h"
 #include "UTIL/string.h"
 #include "UTIL/string_builder.h"
+#include "UTIL/threads.h"
 #include "UTIL/trait.h"
 #include "UTIL/util.h"
 
+static ADEPT_THREAD_LOCAL bool ast_field_maps_may_index = true;
+
 void ast_layout_init(ast_layout_t *layout, ast_layout_kind_t kind, ast_field_map_t field_map, ast_layout_skeleton_t skeleton, trait_t traits){
     layout->kind = kind;
     layout->field_map = field_map;
@@ -522,11 +527,76 @@ ast_type_t *ast_layout_skeleton_get_type_at_index(ast_layout_skeleton_t *skeleto
     return &bone->type;
 }
 
+static hash_t ast_layout_endpoint_hash(const ast_layout_endpoint_t *endpoint){
+    // Only hashes up until the end index, to agree with 'ast_layout_endpoint_equals'
+    hash_t hash = 0;
+
+    for(length_t i = 0; i != AST_LAYOUT_MAX_DEPTH && endpoint->indices[i] != AST_LAYOUT_ENDPOINT_END_INDEX; i++){
+        hash = hash_combine(hash, endpoint->indices[i]);
+    }
+
+    return hash;
+}
+
+static hash_t ast_field_map_index_hash_name(const void *arrow){
+    return hash_string(((const ast_field_arrow_t*) arrow)->name);
+}
+
+static bool ast_field_map_index_equals_name(const void *a, const void *b){
+    return streq(((const ast_field_arrow_t*) a)->name, ((const ast_field_arrow_t*) b)->name);
+}
+
+static hash_t ast_field_map_index_hash_endpoint(const void *arrow){
+    return ast_layout_endpoint_hash(&((const ast_field_arrow_t*) arrow)->endpoint);
+}
+
+static bool ast_field_map_index_equals_endpoint(const void *a, const void *b){
+    return ast_layout_endpoint_equals(&((ast_field_arrow_t*) a)->endpoint, &((ast_field_arrow_t*) b)->endpoint);
+}
+
+static void ast_field_map_index_insert(ast_field_map_index_t *index, ast_field_arrow_t *arrow){
+    // NOTE: Earlier arrows take priority over later ones, just like a linear search
+    set_insert(&index->by_name, arrow);
+    set_insert(&index->by_endpoint, arrow);
+}
+
+static void ast_field_map_index_build(ast_field_map_t *field_map){
+    ast_field_map_index_t *index = malloc(sizeof(ast_field_map_index_t));
+    index->arrows = field_map->arrows;
+
+    set_init(&index->by_name, field_map->arrows_capacity, &ast_field_map_index_hash_name, &ast_field_map_index_equals_name, NULL);
+    set_init(&index->by_endpoint, field_map->arrows_capacity, &ast_field_map_index_hash_endpoint, &ast_field_map_index_equals_endpoint, NULL);
+
+    for(length_t i = 0; i != field_map->arrows_length; i++){
+        ast_field_map_index_insert(index, &field_map->arrows[i]);
+    }
+
+    field_map->maybe_index = index;
+}
+
+static void ast_field_map_index_free(ast_field_map_t *field_map){
+    if(field_map->maybe_index){
+        set_free(&field_map->maybe_index->by_name, NULL);
+        set_free(&field_map->maybe_index->by_endpoint, NULL);
+        free(field_map->maybe_index);
+        field_map->maybe_index = NULL;
+    }
+}
+
+static ast_field_map_index_t *ast_field_map_get_index(ast_field_map_t *field_map){
+    if(field_map->maybe_index == NULL && field_map->arrows_length >= AST_FIELD_MAP_INDEX_THRESHOLD && ast_field_maps_may_index){
+        ast_field_map_index_build(field_map);
+    }
+
+    return field_map->maybe_index;
+}
+
 void ast_field_map_init(ast_field_map_t *field_map){
     field_map->arrows = NULL;
     field_map->arrows_length = 0;
     field_map->arrows_capacity = 0;
     field_map->is_simple = true;
+    field_map->maybe_index = NULL;
 }
 
 void ast_field_map_free(ast_field_map_t *field_map){
@@ -534,6 +604,7 @@ void ast_field_map_free(ast_field_map_t *field_map){
         free(field_map->arrows[i].name);
     }
     free(field_map->arrows);
+    ast_field_map_index_free(field_map);
 }
 
 ast_field_map_t ast_field_map_clone(const ast_field_map_t *field_map){
@@ -542,6 +613,7 @@ ast_field_map_t ast_field_map_clone(const ast_field_map_t *field_map){
     clone.arrows_length = field_map->arrows_length;
     clone.arrows_capacity = field_map->arrows_length; // (on purpose)
     clone.is_simple = field_map->is_simple;
+    clone.maybe_index = NULL;
 
     for(length_t i = 0; i != field_map->arrows_length; i++){
         ast_field_arrow_t *clone_arrow = &clone.arrows[i];
@@ -551,6 +623,12 @@ ast_field_map_t ast_field_map_clone(const ast_field_map_t *field_map){
         clone_arrow->endpoint = original_arrow->endpoint;
     }
 
+    if(field_map->maybe_index){
+        // Clones of indexed field maps are indexed right away,
+        // since lookups on them may not be allowed to create indices
+        ast_field_map_index_build(&clone);
+    }
+
     return clone;
 }
 
@@ -587,9 +665,31 @@ void ast_field_map_add(ast_field_map_t *field_map, strong_cstr_t name, ast_layou
     ast_field_arrow_t *arrow = &field_map->arrows[field_map->arrows_length++];
     arrow->name = name;
     arrow->endpoint = endpoint;
+
+    // Keep existing index up to date, rebuilding it if the arrows moved
+    if(field_map->maybe_index){
+        if(field_map->maybe_index->arrows != field_map->arrows){
+            ast_field_map_index_free(field_map);
+            ast_field_map_index_build(field_map);
+        } else {
+            ast_field_map_index_insert(field_map->maybe_index, arrow);
+        }
+    }
+}
+
+void ast_field_maps_allow_indexing(bool allow){
+    ast_field_maps_may_index = allow;
 }
 
 successful_t ast_field_map_find(ast_field_map_t *field_map, const char *name, ast_layout_endpoint_t *out_endpoint){
+    ast_field_map_index_t *index = ast_field_map_get_index(field_map);
+
+    if(index){
+        ast_field_arrow_t *arrow = set_find(&index->by_name, &(ast_field_arrow_t){ .name = (strong_cstr_t) name });
+        if(arrow) *out_endpoint = arrow->endpoint;
+        return arrow != NULL;
+    }
+
     for(length_t i = 0; i != field_map->arrows_length; i++){
         ast_field_arrow_t *arrow = &field_map->arrows[i];
 
@@ -605,6 +705,13 @@ successful_t ast_field_map_find(ast_field_map_t *field_map, const char *name, as
 maybe_null_weak_cstr_t ast_field_map_get_name_of_endpoint(ast_field_map_t *field_map, ast_layout_endpoint_t endpoint){
     // Returns NULL if no name exists for an endpoint
 
+    ast_field_map_index_t *index = ast_field_map_get_index(field_map);
+
+    if(index){
+        ast_field_arrow_t *arrow = set_find(&index->by_endpoint, &(ast_field_arrow_t){ .endpoint = endpoint });
+        return arrow ? arrow->name : NULL;
+    }
+
     for(length_t i = 0; i != field_map->arrows_length; i++){
         ast_field_arrow_t *arrow = &field_map->arrows[i];
         
@@ -641,7 +748,7 @@ hash_t ast_field_map_hash(const ast_field_map_t *field_map){
         ast_field_arrow_t *arrow = &field_map->arrows[i];
 
         hash = hash_combine(hash, hash_data(arrow->name, strlen(arrow->name)));
-        hash = hash_combine(hash, hash_data(&arrow->endpoint, sizeof arrow->endpoint));
+        hash = hash_combine(hash, ast_layout_endpoint_hash(&arrow->endpoint));
     }
 
     return hash;
@@ -0,0 +1,41 @@
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "AST/ast_node_alloc.h"
+#include "AST/ast_type_lean.h"
+#include "UTIL/arena.h"
+#include "UTIL/ground.h"
+#include "UTIL/threads.h"
+
+// Every AST node field is at most as aligned as a pointer-sized integer or double
+#define AST_NODE_ALIGNMENT 8
+
+static ADEPT_THREAD_LOCAL arena_t *ast_node_arena = NULL;
+
+arena_t *ast_node_arena_use(arena_t *arena){
+    arena_t *previous = ast_node_arena;
+    ast_node_arena = arena;
+    return previous;
+}
+
+void *ast_node_alloc(length_t size){
+    // NOTE: Every AST node starts with the same header as 'ast_elem_t'
+    ast_elem_t *node = ast_node_arena ? arena_alloc(ast_node_arena, size, AST_NODE_ALIGNMENT) : malloc(size);
+    memset(node, 0, size);
+    node->in_arena = ast_node_arena != NULL;
+    return node;
+}
+
+void *ast_node_memclone(const void *node, length_t size){
+    ast_elem_t *clone = ast_node_arena ? arena_alloc(ast_node_arena, size, AST_NODE_ALIGNMENT) : malloc(size);
+    memcpy(clone, node, size);
+    clone->in_arena = ast_node_arena != NULL;
+    return clone;
+}
+
+void ast_node_free(void *node){
+    if(node && !((ast_elem_t*) node)->in_arena){
+        free(node);
+    }
+}
@@ -0,0 +1,1973 @@
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "AST/ast.h"
+#include "AST/ast_expr.h"
+#include "AST/ast_layout.h"
+#include "AST/ast_named_expression.h"
+#include "AST/ast_node_alloc.h"
+#include "AST/ast_serialize.h"
+#include "AST/ast_type.h"
+#include "AST/meta_directives.h"
+#include "UTIL/arena.h"
+#include "UTIL/ground.h"
+#include "UTIL/intern.h"
+#include "UTIL/string.h"
+#include "UTIL/string_list.h"
+#include "UTIL/util.h"
+
+/*
+    Format overview
+
+    Every integer is stored as an unsigned LEB128 variable-length integer
+    (signed values are stored as their two's complement bit pattern),
+    and floating point values are stored as the bits of a double.
+    Strings are stored as their length plus one followed by their bytes,
+    where a length of zero means NULL.
+
+    Expressions and type elements begin with their id followed by their source,
+    and a NULL expression is stored as just EXPR_NONE.
+
+    The declarations of the AST follow a short header, with each list
+    beginning with the number of items in it.
+*/
+
+#define AST_SERIALIZE_MAGIC "ADEPTAST"
+
+// ---------------- ast_writer_t ----------------
+// Growable buffer that an AST is serialized into
+// Once 'failed' is set, the contents are meaningless
+typedef struct {
+    char *buffer;
+    length_t length;
+    length_t capacity;
+    length_t func_offset;
+    bool failed;
+} ast_writer_t;
+
+// ---------------- ast_reader_t ----------------
+// Cursor for reading a serialized AST
+// Once 'failed' is set, every read returns zero or NULL,
+// so partially read declarations can always be freed normally
+typedef struct {
+    const char *data;
+    length_t length;
+    length_t position;
+    arena_t *strings;
+    maybe_index_t relocate_object_index;
+    length_t func_offset;
+    length_t funcs_length;
+    bool failed;
+} ast_reader_t;
+
+static void ast_serialize_expr(ast_writer_t *writer, ast_expr_t *expr);
+static void ast_serialize_type(ast_writer_t *writer, const ast_type_t *type);
+static void ast_serialize_layout(ast_writer_t *writer, const ast_layout_t *layout);
+static ast_expr_t *ast_deserialize_expr(ast_reader_t *reader);
+static ast_type_t ast_deserialize_type(ast_reader_t *reader);
+static ast_layout_t ast_deserialize_layout(ast_reader_t *reader);
+
+static void ast_serialize_bytes(ast_writer_t *writer, const void *bytes, length_t size){
+    if(size == 0) return;
+
+    expand((void**) &writer->buffer, sizeof(char), writer->length, &writer->capacity, size, 4096);
+    memcpy(&writer->buffer[writer->length], bytes, size);
+    writer->length += size;
+}
+
+static void ast_serialize_u64(ast_writer_t *writer, uint64_t value){
+    unsigned char bytes[10];
+    length_t size = 0;
+
+    do {
+        unsigned char byte = value & 0x7F;
+        value >>= 7;
+        bytes[size++] = value ? byte | 0x80 : byte;
+    } while(value);
+
+    ast_serialize_bytes(writer, bytes, size);
+}
+
+static void ast_serialize_i64(ast_writer_t *writer, int64_t value){
+    ast_serialize_u64(writer, (uint64_t) value);
+}
+
+static void ast_serialize_bool(ast_writer_t *writer, bool value){
+    ast_serialize_u64(writer, value);
+}
+
+static void ast_serialize_double(ast_writer_t *writer, double value){
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof bits);
+    ast_serialize_u64(writer, bits);
+}
+
+static void ast_serialize_string_of_length(ast_writer_t *writer, const char *array, length_t length){
+    if(array == NULL){
+        ast_serialize_u64(writer, 0);
+        return;
+    }
+
+    ast_serialize_u64(writer, (uint64_t) length + 1);
+    ast_serialize_bytes(writer, array, length);
+}
+
+static void ast_serialize_string(ast_writer_t *writer, maybe_null_weak_cstr_t string){
+    ast_serialize_string_of_length(writer, string, string ? strlen(string) : 0);
+}
+
+static void ast_serialize_source(ast_writer_t *writer, source_t source){
+    ast_serialize_u64(writer, source.index);
+    ast_serialize_u64(writer, source.object_index);
+    ast_serialize_u64(writer, source.stride);
+}
+
+static void ast_serialize_func_id(ast_writer_t *writer, func_id_t id){
+    // Function ids are stored relative to the first serialized function,
+    // so functions that weren't serialized can't be referred to
+    if(id != INVALID_FUNC_ID && id < writer->func_offset){
+        writer->failed = true;
+        return;
+    }
+
+    ast_serialize_u64(writer, id == INVALID_FUNC_ID ? INVALID_FUNC_ID : id - writer->func_offset);
+}
+
+static void ast_serialize_types(ast_writer_t *writer, const ast_type_t *types, length_t length){
+    for(length_t i = 0; i != length; i++){
+        ast_serialize_type(writer, &types[i]);
+    }
+}
+
+static void ast_serialize_maybe_type(ast_writer_t *writer, const ast_type_t *maybe_type){
+    ast_serialize_bool(writer, maybe_type != NULL);
+    if(maybe_type) ast_serialize_type(writer, maybe_type);
+}
+
+static void ast_serialize_string_list(ast_writer_t *writer, const strong_cstr_list_t *list){
+    ast_serialize_u64(writer, list->length);
+
+    for(length_t i = 0; i != list->length; i++){
+        ast_serialize_string(writer, list->items[i]);
+    }
+}
+
+static void ast_serialize_elem(ast_writer_t *writer, const ast_elem_t *elem){
+    ast_serialize_u64(writer, elem->id);
+    ast_serialize_source(writer, elem->source);
+
+    switch(elem->id){
+    case AST_ELEM_BASE:
+        ast_serialize_string(writer, ((ast_elem_base_t*) elem)->base);
+        break;
+    case AST_ELEM_POINTER:
+    case AST_ELEM_ARRAY:
+    case AST_ELEM_GENERIC_INT:
+    case AST_ELEM_GENERIC_FLOAT:
+        break;
+    case AST_ELEM_FIXED_ARRAY:
+        ast_serialize_u64(writer, ((ast_elem_fixed_array_t*) elem)->length);
+        break;
+    case AST_ELEM_VAR_FIXED_ARRAY:
+        ast_serialize_expr(writer, ((ast_elem_var_fixed_array_t*) elem)->length);
+        break;
+    case AST_ELEM_FUNC: {
+            ast_elem_func_t *func_elem = (ast_elem_func_t*) elem;
+            ast_serialize_u64(writer, func_elem->arity);
+            ast_serialize_types(writer, func_elem->arg_types, func_elem->arity);
+            ast_serialize_type(writer, func_elem->return_type);
+            ast_serialize_u64(writer, func_elem->traits);
+        }
+        break;
+    case AST_ELEM_POLYMORPH:
+        ast_serialize_string(writer, ((ast_elem_polymorph_t*) elem)->name);
+        ast_serialize_bool(writer, ((ast_elem_polymorph_t*) elem)->allow_auto_conversion);
+        break;
+    case AST_ELEM_POLYCOUNT:
+        ast_serialize_string(writer, ((ast_elem_polycount_t*) elem)->name);
+        break;
+    case AST_ELEM_POLYMORPH_PREREQ: {
+            ast_elem_polymorph_prereq_t *prereq = (ast_elem_polymorph_prereq_t*) elem;
+            ast_serialize_string(writer, prereq->name);
+            ast_serialize_bool(writer, prereq->allow_auto_conversion);
+            ast_serialize_string(writer, prereq->similarity_prerequisite);
+            ast_serialize_type(writer, &prereq->extends);
+        }
+        break;
+    case AST_ELEM_GENERIC_BASE: {
+            ast_elem_generic_base_t *generic_base = (ast_elem_generic_base_t*) elem;
+            ast_serialize_string(writer, generic_base->name);
+            ast_serialize_u64(writer, generic_base->generics_length);
+            ast_serialize_types(writer, generic_base->generics, generic_base->generics_length);
+            ast_serialize_bool(writer, generic_base->name_is_polymorphic);
+        }
+        break;
+    case AST_ELEM_LAYOUT:
+        ast_serialize_layout(writer, &((ast_elem_layout_t*) elem)->layout);
+        break;
+    case AST_ELEM_UNKNOWN_ENUM:
+        ast_serialize_string(writer, ((ast_elem_unknown_enum_t*) elem)->kind_name);
+        break;
+    case AST_ELEM_UNKNOWN_PLURAL_ENUM:
+        ast_serialize_string_list(writer, &((ast_elem_unknown_plural_enum_t*) elem)->kinds);
+        break;
+    case AST_ELEM_ANONYMOUS_ENUM:
+        ast_serialize_string_list(writer, &((ast_elem_anonymous_enum_t*) elem)->kinds);
+        break;
+    default:
+        writer->failed = true;
+    }
+}
+
+static void ast_serialize_type(ast_writer_t *writer, const ast_type_t *type){
+    ast_serialize_u64(writer, type->elements_length);
+
+    for(length_t i = 0; i != type->elements_length; i++){
+        ast_serialize_elem(writer, type->elements[i]);
+    }
+
+    ast_serialize_source(writer, type->source);
+}
+
+static void ast_serialize_skeleton(ast_writer_t *writer, const ast_layout_skeleton_t *skeleton){
+    ast_serialize_u64(writer, skeleton->bones_length);
+
+    for(length_t i = 0; i != skeleton->bones_length; i++){
+        ast_layout_bone_t *bone = &skeleton->bones[i];
+        ast_serialize_u64(writer, bone->kind);
+        ast_serialize_u64(writer, bone->traits);
+
+        if(bone->kind == AST_LAYOUT_BONE_KIND_TYPE){
+            ast_serialize_type(writer, &bone->type);
+        } else {
+            ast_serialize_skeleton(writer, &bone->children);
+        }
+    }
+}
+
+static void ast_serialize_layout(ast_writer_t *writer, const ast_layout_t *layout){
+    ast_serialize_u64(writer, layout->kind);
+    ast_serialize_u64(writer, layout->traits);
+    ast_serialize_bool(writer, layout->field_map.is_simple);
+    ast_serialize_u64(writer, layout->field_map.arrows_length);
+
+    for(length_t i = 0; i != layout->field_map.arrows_length; i++){
+        ast_field_arrow_t *arrow = &layout->field_map.arrows[i];
+        ast_serialize_string(writer, arrow->name);
+
+        // NOTE: Indices after the end index are left uninitialized, so they aren't stored
+        for(length_t j = 0; j != AST_LAYOUT_MAX_DEPTH; j++){
+            ast_serialize_u64(writer, arrow->endpoint.indices[j]);
+            if(arrow->endpoint.indices[j] == AST_LAYOUT_ENDPOINT_END_INDEX) break;
+        }
+    }
+
+    ast_serialize_skeleton(writer, &layout->skeleton);
+}
+
+static void ast_serialize_exprs(ast_writer_t *writer, ast_expr_t **exprs, length_t length){
+    ast_serialize_u64(writer, length);
+
+    for(length_t i = 0; i != length; i++){
+        ast_serialize_expr(writer, exprs[i]);
+    }
+}
+
+static void ast_serialize_expr_list(ast_writer_t *writer, const ast_expr_list_t *list){
+    ast_serialize_exprs(writer, list->statements, list->length);
+}
+
+static void ast_serialize_optional_expr_list(ast_writer_t *writer, const optional_ast_expr_list_t *list){
+    ast_serialize_bool(writer, list->has);
+    if(list->has) ast_serialize_expr_list(writer, &list->value);
+}
+
+static void ast_serialize_named_expression(ast_writer_t *writer, const ast_named_expression_t *named_expression){
+    ast_serialize_string(writer, named_expression->name);
+    ast_serialize_expr(writer, named_expression->expression);
+    ast_serialize_u64(writer, named_expression->traits);
+    ast_serialize_source(writer, named_expression->source);
+}
+
+static void ast_serialize_expr(ast_writer_t *writer, ast_expr_t *expr){
+    if(expr == NULL){
+        ast_serialize_u64(writer, EXPR_NONE);
+        return;
+    }
+
+    ast_serialize_u64(writer, expr->id);
+    ast_serialize_source(writer, expr->source);
+
+    switch(expr->id){
+    case EXPR_BYTE:
+        ast_serialize_i64(writer, ((ast_expr_byte_t*) expr)->value);
+        break;
+    case EXPR_UBYTE:
+        ast_serialize_u64(writer, ((ast_expr_ubyte_t*) expr)->value);
+        break;
+    case EXPR_SHORT:
+        ast_serialize_i64(writer, ((ast_expr_short_t*) expr)->value);
+        break;
+    case EXPR_USHORT:
+        ast_serialize_u64(writer, ((ast_expr_ushort_t*) expr)->value);
+        break;
+    case EXPR_INT:
+        ast_serialize_i64(writer, ((ast_expr_int_t*) expr)->value);
+        break;
+    case EXPR_UINT:
+        ast_serialize_u64(writer, ((ast_expr_uint_t*) expr)->value);
+        break;
+    case EXPR_LONG:
+        ast_serialize_i64(writer, ((ast_expr_long_t*) expr)->value);
+        break;
+    case EXPR_ULONG:
+        ast_serialize_u64(writer, ((ast_expr_ulong_t*) expr)->value);
+        break;
+    case EXPR_USIZE:
+        ast_serialize_u64(writer, ((ast_expr_usize_t*) expr)->value);
+        break;
+    case EXPR_FLOAT:
+        ast_serialize_double(writer, ((ast_expr_float_t*) expr)->value);
+        break;
+    case EXPR_DOUBLE:
+        ast_serialize_double(writer, ((ast_expr_double_t*) expr)->value);
+        break;
+    case EXPR_BOOLEAN:
+        ast_serialize_bool(writer, ((ast_expr_boolean_t*) expr)->value);
+        break;
+    case EXPR_STR:
+    case EXPR_CSTR:
+        ast_serialize_string_of_length(writer, ((ast_expr_str_t*) expr)->array, ((ast_expr_str_t*) expr)->length);
+        break;
+    case EXPR_GENERIC_INT:
+        ast_serialize_i64(writer, ((ast_expr_generic_int_t*) expr)->value);
+        break;
+    case EXPR_GENERIC_FLOAT:
+        ast_serialize_double(writer, ((ast_expr_generic_float_t*) expr)->value);
+        break;
+    case EXPR_NULL:
+    case EXPR_BREAK:
+    case EXPR_CONTINUE:
+    case EXPR_FALLTHROUGH:
+        break;
+    case EXPR_ADD:
+    case EXPR_SUBTRACT:
+    case EXPR_MULTIPLY:
+    case EXPR_DIVIDE:
+    case EXPR_MODULUS:
+    case EXPR_EQUALS:
+    case EXPR_NOTEQUALS:
+    case EXPR_GREATER:
+    case EXPR_LESSER:
+    case EXPR_GREATEREQ:
+    case EXPR_LESSEREQ:
+    case EXPR_AND:
+    case EXPR_OR:
+    case EXPR_BIT_AND:
+    case EXPR_BIT_OR:
+    case EXPR_BIT_XOR:
+    case EXPR_BIT_LSHIFT:
+    case EXPR_BIT_RSHIFT:
+    case EXPR_BIT_LGC_LSHIFT:
+    case EXPR_BIT_LGC_RSHIFT:
+        ast_serialize_expr(writer, ((ast_expr_math_t*) expr)->a);
+        ast_serialize_expr(writer, ((ast_expr_math_t*) expr)->b);
+        break;
+    case EXPR_ADDRESS:
+    case EXPR_DEREFERENCE:
+    case EXPR_BIT_COMPLEMENT:
+    case EXPR_NOT:
+    case EXPR_NEGATE:
+    case EXPR_DELETE:
+    case EXPR_PREINCREMENT:
+    case EXPR_PREDECREMENT:
+    case EXPR_POSTINCREMENT:
+    case EXPR_POSTDECREMENT:
+    case EXPR_TOGGLE:
+    case EXPR_VA_START:
+    case EXPR_VA_END:
+    case EXPR_SIZEOF_VALUE:
+        ast_serialize_expr(writer, ((ast_expr_unary_t*) expr)->value);
+        break;
+    case EXPR_AT:
+    case EXPR_ARRAY_ACCESS:
+        ast_serialize_expr(writer, ((ast_expr_array_access_t*) expr)->value);
+        ast_serialize_expr(writer, ((ast_expr_array_access_t*) expr)->index);
+        break;
+    case EXPR_CALL: {
+            ast_expr_call_t *call = (ast_expr_call_t*) expr;
+            ast_serialize_string(writer, call->name);
+            ast_serialize_exprs(writer, call->args, call->arity);
+            ast_serialize_type(writer, &call->gives);
+            ast_serialize_bool(writer, call->is_tentative);
+            ast_serialize_bool(writer, call->only_implicit);
+            ast_serialize_bool(writer, call->no_user_casts);
+            ast_serialize_bool(writer, call->no_discard);
+        }
+        break;
+    case EXPR_SUPER:
+        ast_serialize_exprs(writer, ((ast_expr_super_t*) expr)->args, ((ast_expr_super_t*) expr)->arity);
+        ast_serialize_bool(writer, ((ast_expr_super_t*) expr)->is_tentative);
+        break;
+    case EXPR_VARIABLE:
+        ast_serialize_string(writer, ((ast_expr_variable_t*) expr)->name);
+        break;
+    case EXPR_MEMBER:
+        ast_serialize_expr(writer, ((ast_expr_member_t*) expr)->value);
+        ast_serialize_string(writer, ((ast_expr_member_t*) expr)->member);
+        break;
+    case EXPR_FUNC_ADDR: {
+            ast_expr_func_addr_t *func_addr = (ast_expr_func_addr_t*) expr;
+            ast_serialize_string(writer, func_addr->name);
+            ast_serialize_bool(writer, func_addr->match_args != NULL);
+            ast_serialize_u64(writer, func_addr->match_args_length);
+            if(func_addr->match_args) ast_serialize_types(writer, func_addr->match_args, func_addr->match_args_length);
+            ast_serialize_u64(writer, func_addr->traits);
+            ast_serialize_bool(writer, func_addr->tentative);
+            ast_serialize_bool(writer, func_addr->has_match_args);
+        }
+        break;
+    case EXPR_CAST:
+        ast_serialize_type(writer, &((ast_expr_cast_t*) expr)->to);
+        ast_serialize_expr(writer, ((ast_expr_cast_t*) expr)->from);
+        break;
+    case EXPR_SIZEOF:
+    case EXPR_ALIGNOF:
+    case EXPR_TYPENAMEOF:
+    case EXPR_TYPEINFO:
+        ast_serialize_type(writer, &((ast_expr_unary_type_t*) expr)->type);
+        break;
+    case EXPR_CALL_METHOD: {
+            ast_expr_call_method_t *call = (ast_expr_call_method_t*) expr;
+            ast_serialize_string(writer, call->name);
+            ast_serialize_expr(writer, call->value);
+            ast_serialize_exprs(writer, call->args, call->arity);
+            ast_serialize_type(writer, &call->gives);
+            ast_serialize_bool(writer, call->is_tentative);
+            ast_serialize_bool(writer, call->allow_drop);
+            ast_serialize_bool(writer, call->no_discard);
+        }
+        break;
+    case EXPR_NEW: {
+            ast_expr_new_t *new_expr = (ast_expr_new_t*) expr;
+            ast_serialize_type(writer, &new_expr->type);
+            ast_serialize_expr(writer, new_expr->amount);
+            ast_serialize_bool(writer, new_expr->is_undef);
+            ast_serialize_optional_expr_list(writer, &new_expr->inputs);
+        }
+        break;
+    case EXPR_NEW_CSTRING:
+        ast_serialize_string_of_length(writer, ((ast_expr_new_cstring_t*) expr)->array, ((ast_expr_new_cstring_t*) expr)->length);
+        break;
+    case EXPR_ENUM_VALUE:
+        ast_serialize_string(writer, ((ast_expr_enum_value_t*) expr)->enum_name);
+        ast_serialize_string(writer, ((ast_expr_enum_value_t*) expr)->kind_name);
+        break;
+    case EXPR_GENERIC_ENUM_VALUE:
+        ast_serialize_string(writer, ((ast_expr_generic_enum_value_t*) expr)->kind_name);
+        break;
+    case EXPR_STATIC_ARRAY:
+    case EXPR_STATIC_STRUCT:
+        ast_serialize_type(writer, &((ast_expr_static_data_t*) expr)->type);
+        ast_serialize_exprs(writer, ((ast_expr_static_data_t*) expr)->values, ((ast_expr_static_data_t*) expr)->length);
+        break;
+    case EXPR_TERNARY:
+        ast_serialize_expr(writer, ((ast_expr_ternary_t*) expr)->condition);
+        ast_serialize_expr(writer, ((ast_expr_ternary_t*) expr)->if_true);
+        ast_serialize_expr(writer, ((ast_expr_ternary_t*) expr)->if_false);
+        break;
+    case EXPR_VA_ARG:
+        ast_serialize_expr(writer, ((ast_expr_va_arg_t*) expr)->va_list);
+        ast_serialize_type(writer, &((ast_expr_va_arg_t*) expr)->arg_type);
+        break;
+    case EXPR_INITLIST:
+        ast_serialize_exprs(writer, ((ast_expr_initlist_t*) expr)->elements, ((ast_expr_initlist_t*) expr)->length);
+        break;
+    case EXPR_POLYCOUNT:
+        ast_serialize_string(writer, ((ast_expr_polycount_t*) expr)->name);
+        break;
+    case EXPR_LLVM_ASM: {
+            ast_expr_llvm_asm_t *llvm_asm = (ast_expr_llvm_asm_t*) expr;
+            ast_serialize_string(writer, llvm_asm->assembly);
+            ast_serialize_string(writer, llvm_asm->constraints);
+            ast_serialize_exprs(writer, llvm_asm->args, llvm_asm->arity);
+            ast_serialize_bool(writer, llvm_asm->has_side_effects);
+            ast_serialize_bool(writer, llvm_asm->is_stack_align);
+            ast_serialize_bool(writer, llvm_asm->is_intel);
+        }
+        break;
+    case EXPR_EMBED:
+        ast_serialize_string(writer, ((ast_expr_embed_t*) expr)->filename);
+        break;
+    case EXPR_DECLARE:
+    case EXPR_DECLAREUNDEF:
+    case EXPR_ILDECLARE:
+    case EXPR_ILDECLAREUNDEF: {
+            ast_expr_declare_t *declare = (ast_expr_declare_t*) expr;
+            ast_serialize_string(writer, declare->name);
+            ast_serialize_type(writer, &declare->type);
+            ast_serialize_expr(writer, declare->value);
+            ast_serialize_u64(writer, declare->traits);
+            ast_serialize_optional_expr_list(writer, &declare->inputs);
+        }
+        break;
+    case EXPR_ASSIGN:
+    case EXPR_ADD_ASSIGN:
+    case EXPR_SUBTRACT_ASSIGN:
+    case EXPR_MULTIPLY_ASSIGN:
+    case EXPR_DIVIDE_ASSIGN:
+    case EXPR_MODULUS_ASSIGN:
+    case EXPR_AND_ASSIGN:
+    case EXPR_OR_ASSIGN:
+    case EXPR_XOR_ASSIGN:
+    case EXPR_LSHIFT_ASSIGN:
+    case EXPR_RSHIFT_ASSIGN:
+    case EXPR_LGC_LSHIFT_ASSIGN:
+    case EXPR_LGC_RSHIFT_ASSIGN:
+        ast_serialize_expr(writer, ((ast_expr_assign_t*) expr)->destination);
+        ast_serialize_expr(writer, ((ast_expr_assign_t*) expr)->value);
+        ast_serialize_bool(writer, ((ast_expr_assign_t*) expr)->is_pod);
+        break;
+    case EXPR_RETURN:
+        ast_serialize_expr(writer, ((ast_expr_return_t*) expr)->value);
+        ast_serialize_expr_list(writer, &((ast_expr_return_t*) expr)->last_minute);
+        break;
+    case EXPR_IF:
+    case EXPR_UNLESS:
+    case EXPR_WHILE:
+    case EXPR_UNTIL:
+    case EXPR_WHILECONTINUE:
+    case EXPR_UNTILBREAK:
+        ast_serialize_string(writer, ((ast_expr_conditional_t*) expr)->label);
+        ast_serialize_expr(writer, ((ast_expr_conditional_t*) expr)->value);
+        ast_serialize_expr_list(writer, &((ast_expr_conditional_t*) expr)->statements);
+        break;
+    case EXPR_IFELSE:
+    case EXPR_UNLESSELSE:
+        ast_serialize_string(writer, ((ast_expr_conditional_else_t*) expr)->label);
+        ast_serialize_expr(writer, ((ast_expr_conditional_else_t*) expr)->value);
+        ast_serialize_expr_list(writer, &((ast_expr_conditional_else_t*) expr)->statements);
+        ast_serialize_expr_list(writer, &((ast_expr_conditional_else_t*) expr)->else_statements);
+        break;
+    case EXPR_EACH_IN: {
+            ast_expr_each_in_t *each_in = (ast_expr_each_in_t*) expr;
+            ast_serialize_string(writer, each_in->label);
+            ast_serialize_string(writer, each_in->it_name);
+            ast_serialize_maybe_type(writer, each_in->it_type);
+            ast_serialize_expr(writer, each_in->length);
+            ast_serialize_expr(writer, each_in->low_array);
+            ast_serialize_expr(writer, each_in->list);
+            ast_serialize_expr_list(writer, &each_in->statements);
+            ast_serialize_bool(writer, each_in->is_static);
+        }
+        break;
+    case EXPR_REPEAT: {
+            ast_expr_repeat_t *repeat = (ast_expr_repeat_t*) expr;
+            ast_serialize_string(writer, repeat->label);
+            ast_serialize_expr(writer, repeat->limit);
+            ast_serialize_expr_list(writer, &repeat->statements);
+            ast_serialize_string(writer, repeat->idx_name);
+            ast_serialize_bool(writer, repeat->is_static);
+        }
+        break;
+    case EXPR_BREAK_TO:
+    case EXPR_CONTINUE_TO:
+        ast_serialize_source(writer, ((ast_expr_break_to_t*) expr)->label_source);
+        ast_serialize_string(writer, ((ast_expr_break_to_t*) expr)->label);
+        break;
+    case EXPR_SWITCH: {
+            ast_expr_switch_t *switch_expr = (ast_expr_switch_t*) expr;
+            ast_serialize_expr(writer, switch_expr->value);
+            ast_serialize_u64(writer, switch_expr->cases.length);
+
+            for(length_t i = 0; i != switch_expr->cases.length; i++){
+                ast_case_t *single_case = &switch_expr->cases.cases[i];
+                ast_serialize_expr(writer, single_case->condition);
+                ast_serialize_expr_list(writer, &single_case->statements);
+                ast_serialize_source(writer, single_case->source);
+            }
+
+            ast_serialize_expr_list(writer, &switch_expr->or_default);
+            ast_serialize_bool(writer, switch_expr->is_exhaustive);
+        }
+        break;
+    case EXPR_VA_COPY:
+        ast_serialize_expr(writer, ((ast_expr_va_copy_t*) expr)->dest_value);
+        ast_serialize_expr(writer, ((ast_expr_va_copy_t*) expr)->src_value);
+        break;
+    case EXPR_FOR: {
+            ast_expr_for_t *for_expr = (ast_expr_for_t*) expr;
+            ast_serialize_string(writer, for_expr->label);
+            ast_serialize_expr_list(writer, &for_expr->before);
+            ast_serialize_expr_list(writer, &for_expr->after);
+            ast_serialize_expr(writer, for_expr->condition);
+            ast_serialize_expr_list(writer, &for_expr->statements);
+        }
+        break;
+    case EXPR_DECLARE_NAMED_EXPRESSION:
+        ast_serialize_named_expression(writer, &((ast_expr_declare_named_expression_t*) expr)->named_expression);
+        break;
+    case EXPR_CONDITIONLESS_BLOCK:
+        ast_serialize_expr_list(writer, &((ast_expr_conditionless_block_t*) expr)->statements);
+        break;
+    case EXPR_ASSERT:
+        ast_serialize_expr(writer, ((ast_expr_assert_t*) expr)->assertion);
+        ast_serialize_expr(writer, ((ast_expr_assert_t*) expr)->message);
+        break;
+    default:
+        // Phantom expressions (and anything else that only exists after parsing) can't be serialized
+        writer->failed = true;
+    }
+}
+
+static void ast_serialize_composite(ast_writer_t *writer, const ast_composite_t *composite){
+    ast_serialize_string(writer, composite->name);
+    ast_serialize_layout(writer, &composite->layout);
+    ast_serialize_source(writer, composite->source);
+    ast_serialize_type(writer, &composite->parent);
+    ast_serialize_bool(writer, composite->is_class);
+    ast_serialize_bool(writer, composite->has_constructor);
+}
+
+static void ast_serialize_func(ast_writer_t *writer, const ast_func_t *func){
+    ast_serialize_string(writer, func->name);
+    ast_serialize_u64(writer, func->arity);
+
+    ast_serialize_bool(writer, func->arg_names != NULL);
+    for(length_t i = 0; func->arg_names && i != func->arity; i++){
+        ast_serialize_string(writer, func->arg_names[i]);
+    }
+
+    ast_serialize_bool(writer, func->arg_types != NULL);
+    if(func->arg_types) ast_serialize_types(writer, func->arg_types, func->arity);
+
+    ast_serialize_bool(writer, func->arg_sources != NULL);
+    for(length_t i = 0; func->arg_sources && i != func->arity; i++){
+        ast_serialize_source(writer, func->arg_sources[i]);
+    }
+
+    ast_serialize_bool(writer, func->arg_flows != NULL);
+    for(length_t i = 0; func->arg_flows && i != func->arity; i++){
+        ast_serialize_u64(writer, (unsigned char) func->arg_flows[i]);
+    }
+
+    ast_serialize_bool(writer, func->arg_type_traits != NULL);
+    for(length_t i = 0; func->arg_type_traits && i != func->arity; i++){
+        ast_serialize_u64(writer, func->arg_type_traits[i]);
+    }
+
+    ast_serialize_bool(writer, func->arg_defaults != NULL);
+    for(length_t i = 0; func->arg_defaults && i != func->arity; i++){
+        ast_serialize_expr(writer, func->arg_defaults[i]);
+    }
+
+    ast_serialize_type(writer, &func->return_type);
+    ast_serialize_u64(writer, func->traits);
+    ast_serialize_string(writer, func->variadic_arg_name);
+    ast_serialize_source(writer, func->variadic_source);
+    ast_serialize_expr_list(writer, &func->statements);
+    ast_serialize_source(writer, func->source);
+    ast_serialize_string(writer, func->export_as);
+    ast_serialize_u64(writer, func->instantiation_depth);
+    ast_serialize_func_id(writer, func->virtual_origin);
+
+    #ifdef ADEPT_INSIGHT_BUILD
+    ast_serialize_source(writer, func->end_source);
+    #endif
+}
+
+static void ast_serialize_meta_expr(ast_writer_t *writer, meta_expr_t *value){
+    ast_serialize_u64(writer, value->id);
+
+    switch(value->id){
+    case META_EXPR_UNDEF:
+    case META_EXPR_NULL:
+    case META_EXPR_TRUE:
+    case META_EXPR_FALSE:
+        break;
+    case META_EXPR_STR:
+        ast_serialize_string(writer, ((meta_expr_str_t*) value)->value);
+        break;
+    case META_EXPR_INT:
+        ast_serialize_i64(writer, ((meta_expr_int_t*) value)->value);
+        break;
+    case META_EXPR_FLOAT:
+        ast_serialize_double(writer, ((meta_expr_float_t*) value)->value);
+        break;
+    default:
+        // Meta definitions are always collapsed once parsed
+        writer->failed = true;
+    }
+}
+
+static void ast_serialize_poly_funcs(ast_writer_t *writer, const ast_poly_func_t *poly_funcs, length_t length){
+    // NOTE: Names are always the names of the functions, so only ids are stored
+    ast_serialize_u64(writer, length);
+
+    for(length_t i = 0; i != length; i++){
+        ast_serialize_func_id(writer, poly_funcs[i].ast_func_id);
+    }
+}
+
+void ast_snapshot(ast_t *ast, ast_snapshot_t *out_snapshot){
+    *out_snapshot = (ast_snapshot_t){
+        .enums_length = ast->enums_length,
+        .composites_length = ast->composites_length,
+        .globals_length = ast->globals_length,
+        .funcs_length = ast->funcs_length,
+        .aliases_length = ast->aliases_length,
+        .libraries_length = ast->libraries_length,
+        .func_aliases_length = ast->func_aliases_length,
+        .poly_composites_length = ast->poly_composites_length,
+        .named_expressions_length = ast->named_expressions.length,
+        .meta_definitions_length = ast->meta_definitions_length,
+        .poly_funcs_length = ast->poly_funcs_length,
+        .polymorphic_methods_length = ast->polymorphic_methods_length,
+        .has_variadic_array = ast->common.ast_variadic_array != NULL,
+        .has_initializer_list = ast->common.ast_initializer_list != NULL,
+    };
+}
+
+errorcode_t ast_serialize(ast_t *ast, strong_cstr_t *out_buffer, length_t *out_length){
+    ast_snapshot_t nothing = (ast_snapshot_t){0};
+    return ast_serialize_since(ast, &nothing, out_buffer, out_length);
+}
+
+errorcode_t ast_serialize_since(ast_t *ast, const ast_snapshot_t *since, strong_cstr_t *out_buffer, length_t *out_length){
+    ast_writer_t writer = (ast_writer_t){
+        .func_offset = since->funcs_length,
+    };
+
+    ast_serialize_bytes(&writer, AST_SERIALIZE_MAGIC, 8);
+    ast_serialize_u64(&writer, AST_SERIALIZE_FORMAT_VERSION);
+    ast_serialize_string(&writer, ADEPT_VERSION_STRING);
+
+    ast_serialize_u64(&writer, ast->enums_length - since->enums_length);
+    for(length_t i = since->enums_length; i != ast->enums_length; i++){
+        ast_enum_t *enum_definition = &ast->enums[i];
+        ast_serialize_string(&writer, enum_definition->name);
+        ast_serialize_u64(&writer, enum_definition->length);
+
+        for(length_t j = 0; j != enum_definition->length; j++){
+            ast_serialize_string(&writer, enum_definition->kinds[j]);
+        }
+
+        ast_serialize_source(&writer, enum_definition->source);
+    }
+
+    ast_serialize_u64(&writer, ast->composites_length - since->composites_length);
+    for(length_t i = since->composites_length; i != ast->composites_length; i++){
+        ast_serialize_composite(&writer, &ast->composites[i]);
+    }
+
+    ast_serialize_u64(&writer, ast->globals_length - since->globals_length);
+    for(length_t i = since->globals_length; i != ast->globals_length; i++){
+        ast_global_t *global = &ast->globals[i];
+        ast_serialize_string(&writer, global->name);
+        ast_serialize_type(&writer, &global->type);
+        ast_serialize_expr(&writer, global->initial);
+        ast_serialize_u64(&writer, global->traits);
+        ast_serialize_source(&writer, global->source);
+    }
+
+    ast_serialize_u64(&writer, ast->funcs_length - since->funcs_length);
+    for(length_t i = since->funcs_length; i != ast->funcs_length; i++){
+        ast_serialize_func(&writer, &ast->funcs[i]);
+    }
+
+    ast_serialize_u64(&writer, ast->aliases_length - since->aliases_length);
+    for(length_t i = since->aliases_length; i != ast->aliases_length; i++){
+        ast_alias_t *alias = &ast->aliases[i];
+        ast_serialize_string(&writer, alias->name);
+        ast_serialize_type(&writer, &alias->type);
+        ast_serialize_u64(&writer, alias->generics_length);
+
+        for(length_t j = 0; j != alias->generics_length; j++){
+            ast_serialize_string(&writer, alias->generics[j]);
+        }
+
+        ast_serialize_u64(&writer, alias->traits);
+        ast_serialize_source(&writer, alias->source);
+    }
+
+    ast_serialize_u64(&writer, ast->libraries_length - since->libraries_length);
+    for(length_t i = since->libraries_length; i != ast->libraries_length; i++){
+        ast_serialize_string(&writer, ast->libraries[i]);
+        ast_serialize_u64(&writer, (unsigned char) ast->library_kinds[i]);
+    }
+
+    ast_serialize_u64(&writer, ast->func_aliases_length - since->func_aliases_length);
+    for(length_t i = since->func_aliases_length; i != ast->func_aliases_length; i++){
+        ast_func_alias_t *func_alias = &ast->func_aliases[i];
+        ast_serialize_string(&writer, func_alias->from);
+        ast_serialize_string(&writer, func_alias->to);
+        ast_serialize_u64(&writer, func_alias->arity);
+        ast_serialize_bool(&writer, func_alias->arg_types != NULL);
+        if(func_alias->arg_types) ast_serialize_types(&writer, func_alias->arg_types, func_alias->arity);
+        ast_serialize_u64(&writer, func_alias->required_traits);
+        ast_serialize_source(&writer, func_alias->source);
+        ast_serialize_bool(&writer, func_alias->match_first_of_name);
+    }
+
+    ast_serialize_u64(&writer, ast->poly_composites_length - since->poly_composites_length);
+    for(length_t i = since->poly_composites_length; i != ast->poly_composites_length; i++){
+        ast_poly_composite_t *poly_composite = &ast->poly_composites[i];
+        ast_serialize_composite(&writer, (ast_composite_t*) poly_composite);
+        ast_serialize_u64(&writer, poly_composite->generics_length);
+
+        for(length_t j = 0; j != poly_composite->generics_length; j++){
+            ast_serialize_string(&writer, poly_composite->generics[j]);
+        }
+    }
+
+    ast_serialize_u64(&writer, ast->named_expressions.length - since->named_expressions_length);
+    for(length_t i = since->named_expressions_length; i != ast->named_expressions.length; i++){
+        ast_serialize_named_expression(&writer, &ast->named_expressions.expressions[i]);
+    }
+
+    ast_type_t *variadic_array = since->has_variadic_array ? NULL : ast->common.ast_variadic_array;
+    ast_serialize_maybe_type(&writer, variadic_array);
+    if(variadic_array) ast_serialize_source(&writer, ast->common.ast_variadic_source);
+
+    ast_type_t *initializer_list = since->has_initializer_list ? NULL : ast->common.ast_initializer_list;
+    ast_serialize_maybe_type(&writer, initializer_list);
+    if(initializer_list) ast_serialize_source(&writer, ast->common.ast_initializer_list_source);
+
+    ast_serialize_u64(&writer, ast->meta_definitions_length - since->meta_definitions_length);
+    for(length_t i = since->meta_definitions_length; i != ast->meta_definitions_length; i++){
+        ast_serialize_string(&writer, ast->meta_definitions[i].name);
+        ast_serialize_meta_expr(&writer, ast->meta_definitions[i].value);
+    }
+
+    ast_serialize_poly_funcs(&writer, &ast->poly_funcs[since->poly_funcs_length], ast->poly_funcs_length - since->poly_funcs_length);
+    ast_serialize_poly_funcs(&writer, &ast->polymorphic_methods[since->polymorphic_methods_length], ast->polymorphic_methods_length - since->polymorphic_methods_length);
+
+    if(writer.failed){
+        free(writer.buffer);
+        return FAILURE;
+    }
+
+    *out_buffer = writer.buffer;
+    *out_length = writer.length;
+    return SUCCESS;
+}
+
+static const char *ast_deserialize_bytes(ast_reader_t *reader, length_t size){
+    if(reader->failed || size > reader->length - reader->position){
+        reader->failed = true;
+        return NULL;
+    }
+
+    const char *bytes = &reader->data[reader->position];
+    reader->position += size;
+    return bytes;
+}
+
+static uint64_t ast_deserialize_u64(ast_reader_t *reader){
+    uint64_t value = 0;
+
+    for(unsigned int shift = 0; shift < 64 && !reader->failed && reader->position != reader->length; shift += 7){
+        unsigned char byte = reader->data[reader->position++];
+        value |= (uint64_t) (byte & 0x7F) << shift;
+        if(!(byte & 0x80)) return value;
+    }
+
+    reader->failed = true;
+    return 0;
+}
+
+static int64_t ast_deserialize_i64(ast_reader_t *reader){
+    return (int64_t) ast_deserialize_u64(reader);
+}
+
+static bool ast_deserialize_bool(ast_reader_t *reader){
+    return ast_deserialize_u64(reader) != 0;
+}
+
+static double ast_deserialize_double(ast_reader_t *reader){
+    uint64_t bits = ast_deserialize_u64(reader);
+    double value;
+    memcpy(&value, &bits, sizeof value);
+    return value;
+}
+
+static length_t ast_deserialize_count(ast_reader_t *reader){
+    // Every item in a list takes up at least one byte,
+    // so larger counts can only come from corrupted data
+    uint64_t count = ast_deserialize_u64(reader);
+
+    if(count > reader->length - reader->position){
+        reader->failed = true;
+        return 0;
+    }
+
+    return count;
+}
+
+static const char *ast_deserialize_string_view(ast_reader_t *reader, length_t *out_length){
+    uint64_t encoded_length = ast_deserialize_u64(reader);
+    *out_length = 0;
+
+    if(encoded_length == 0 || reader->failed) return NULL;
+
+    const char *array = ast_deserialize_bytes(reader, encoded_length - 1);
+    if(array) *out_length = encoded_length - 1;
+    return array;
+}
+
+static maybe_null_strong_cstr_t ast_deserialize_strong_string(ast_reader_t *reader){
+    length_t length;
+    const char *array = ast_deserialize_string_view(reader, &length);
+    if(array == NULL) return NULL;
+
+    strong_cstr_t string = malloc(length + 1);
+    memcpy(string, array, length);
+    string[length] = '\0';
+    return string;
+}
+
+static maybe_null_weak_cstr_t ast_deserialize_weak_string_of_length(ast_reader_t *reader, length_t *out_length){
+    const char *array = ast_deserialize_string_view(reader, out_length);
+    return array ? arena_strndup(reader->strings, array, *out_length) : NULL;
+}
+
+static maybe_null_weak_cstr_t ast_deserialize_weak_string(ast_reader_t *reader){
+    length_t length;
+    return ast_deserialize_weak_string_of_length(reader, &length);
+}
+
+static maybe_null_weak_cstr_t ast_deserialize_interned_string(ast_reader_t *reader){
+    strong_cstr_t string = ast_deserialize_strong_string(reader);
+    if(string == NULL) return NULL;
+
+    weak_cstr_t atom = intern_name(string);
+    free(string);
+    return atom;
+}
+
+static source_t ast_deserialize_source(ast_reader_t *reader){
+    source_t source;
+    source.index = ast_deserialize_u64(reader);
+    source.object_index = ast_deserialize_u64(reader);
+    source.stride = ast_deserialize_u64(reader);
+
+    if(reader->relocate_object_index != -1 && !SOURCE_IS_NULL(source)){
+        source.object_index = reader->relocate_object_index;
+    }
+
+    return source;
+}
+
+static func_id_t ast_deserialize_func_id(ast_reader_t *reader){
+    uint64_t id = ast_deserialize_u64(reader);
+    if(id == INVALID_FUNC_ID) return INVALID_FUNC_ID;
+
+    if(id >= reader->funcs_length){
+        reader->failed = true;
+        return INVALID_FUNC_ID;
+    }
+
+    return (func_id_t) (id + reader->func_offset);
+}
+
+static ast_type_t *ast_deserialize_types(ast_reader_t *reader, length_t length){
+    ast_type_t *types = malloc(sizeof(ast_type_t) * length);
+
+    for(length_t i = 0; i != length; i++){
+        types[i] = ast_deserialize_type(reader);
+    }
+
+    return types;
+}
+
+static ast_type_t *ast_deserialize_maybe_type(ast_reader_t *reader){
+    if(!ast_deserialize_bool(reader)) return NULL;
+
+    ast_type_t *type = malloc(sizeof(ast_type_t));
+    *type = ast_deserialize_type(reader);
+    return type;
+}
+
+static strong_cstr_list_t ast_deserialize_string_list(ast_reader_t *reader){
+    length_t length = ast_deserialize_count(reader);
+
+    strong_cstr_list_t list = (strong_cstr_list_t){
+        .items = malloc(sizeof(strong_cstr_t) * length),
+        .length = length,
+        .capacity = length,
+    };
+
+    for(length_t i = 0; i != length; i++){
+        list.items[i] = ast_deserialize_strong_string(reader);
+    }
+
+    return list;
+}
+
+static ast_elem_t *ast_deserialize_elem(ast_reader_t *reader){
+    unsigned int id = ast_deserialize_u64(reader);
+    source_t source = ast_deserialize_source(reader);
+    if(reader->failed) return NULL;
+
+    ast_elem_t *elem;
+
+    switch(id){
+    case AST_ELEM_BASE: {
+            ast_elem_base_t *base = ast_node_alloc(sizeof(ast_elem_base_t));
+            base->base = ast_deserialize_interned_string(reader);
+            elem = (ast_elem_t*) base;
+        }
+        break;
+    case AST_ELEM_POINTER:
+    case AST_ELEM_ARRAY:
+    case AST_ELEM_GENERIC_INT:
+    case AST_ELEM_GENERIC_FLOAT:
+        elem = ast_node_alloc(sizeof(ast_elem_t));
+        break;
+    case AST_ELEM_FIXED_ARRAY: {
+            ast_elem_fixed_array_t *fixed_array = ast_node_alloc(sizeof(ast_elem_fixed_array_t));
+            fixed_array->length = ast_deserialize_u64(reader);
+            elem = (ast_elem_t*) fixed_array;
+        }
+        break;
+    case AST_ELEM_VAR_FIXED_ARRAY: {
+            ast_elem_var_fixed_array_t *var_fixed_array = ast_node_alloc(sizeof(ast_elem_var_fixed_array_t));
+            var_fixed_array->length = ast_deserialize_expr(reader);
+            elem = (ast_elem_t*) var_fixed_array;
+        }
+        break;
+    case AST_ELEM_FUNC: {
+            ast_elem_func_t *func_elem = ast_node_alloc(sizeof(ast_elem_func_t));
+            func_elem->arity = ast_deserialize_count(reader);
+            func_elem->arg_types = ast_deserialize_types(reader, func_elem->arity);
+            func_elem->return_type = malloc(sizeof(ast_type_t));
+            *func_elem->return_type = ast_deserialize_type(reader);
+            func_elem->traits = ast_deserialize_u64(reader);
+            func_elem->ownership = true;
+            elem = (ast_elem_t*) func_elem;
+        }
+        break;
+    case AST_ELEM_POLYMORPH: {
+            ast_elem_polymorph_t *polymorph = ast_node_alloc(sizeof(ast_elem_polymorph_t));
+            polymorph->name = ast_deserialize_strong_string(reader);
+            polymorph->allow_auto_conversion = ast_deserialize_bool(reader);
+            elem = (ast_elem_t*) polymorph;
+        }
+        break;
+    case AST_ELEM_POLYCOUNT: {
+            ast_elem_polycount_t *polycount = ast_node_alloc(sizeof(ast_elem_polycount_t));
+            polycount->name = ast_deserialize_strong_string(reader);
+            elem = (ast_elem_t*) polycount;
+        }
+        break;
+    case AST_ELEM_POLYMORPH_PREREQ: {
+            ast_elem_polymorph_prereq_t *prereq = ast_node_alloc(sizeof(ast_elem_polymorph_prereq_t));
+            prereq->name = ast_deserialize_strong_string(reader);
+            prereq->allow_auto_conversion = ast_deserialize_bool(reader);
+            prereq->similarity_prerequisite = ast_deserialize_strong_string(reader);
+            prereq->extends = ast_deserialize_type(reader);
+            elem = (ast_elem_t*) prereq;
+        }
+        break;
+    case AST_ELEM_GENERIC_BASE: {
+            ast_elem_generic_base_t *generic_base = ast_node_alloc(sizeof(ast_elem_generic_base_t));
+            generic_base->name = ast_deserialize_interned_string(reader);
+            generic_base->generics_length = ast_deserialize_count(reader);
+            generic_base->generics = ast_deserialize_types(reader, generic_base->generics_length);
+            generic_base->name_is_polymorphic = ast_deserialize_bool(reader);
+            elem = (ast_elem_t*) generic_base;
+        }
+        break;
+    case AST_ELEM_LAYOUT: {
+            ast_elem_layout_t *layout_elem = ast_node_alloc(sizeof(ast_elem_layout_t));
+            layout_elem->layout = ast_deserialize_layout(reader);
+            elem = (ast_elem_t*) layout_elem;
+        }
+        break;
+    case AST_ELEM_UNKNOWN_ENUM: {
+            ast_elem_unknown_enum_t *unknown_enum = ast_node_alloc(sizeof(ast_elem_unknown_enum_t));
+            unknown_enum->kind_name = ast_deserialize_weak_string(reader);
+            elem = (ast_elem_t*) unknown_enum;
+        }
+        break;
+    case AST_ELEM_UNKNOWN_PLURAL_ENUM: {
+            ast_elem_unknown_plural_enum_t *unknown_plural_enum = ast_node_alloc(sizeof(ast_elem_unknown_plural_enum_t));
+            unknown_plural_enum->kinds = ast_deserialize_string_list(reader);
+            elem = (ast_elem_t*) unknown_plural_enum;
+        }
+        break;
+    case AST_ELEM_ANONYMOUS_ENUM: {
+            ast_elem_anonymous_enum_t *anonymous_enum = ast_node_alloc(sizeof(ast_elem_anonymous_enum_t));
+            anonymous_enum->kinds = ast_deserialize_string_list(reader);
+            elem = (ast_elem_t*) anonymous_enum;
+        }
+        break;
+    default:
+        reader->failed = true;
+        return NULL;
+    }
+
+    elem->id = id;
+    elem->source = source;
+    return elem;
+}
+
+static ast_type_t ast_deserialize_type(ast_reader_t *reader){
+    length_t length = ast_deserialize_count(reader);
+
+    ast_type_t type = (ast_type_t){
+        .elements = length ? malloc(sizeof(ast_elem_t*) * length) : NULL,
+        .elements_length = 0,
+    };
+
+    for(length_t i = 0; i != length; i++){
+        ast_elem_t *elem = ast_deserialize_elem(reader);
+        if(elem == NULL) break;
+
+        type.elements[type.elements_length++] = elem;
+    }
+
+    type.source = ast_deserialize_source(reader);
+    return type;
+}
+
+static ast_layout_skeleton_t ast_deserialize_skeleton(ast_reader_t *reader){
+    length_t length = ast_deserialize_count(reader);
+
+    ast_layout_skeleton_t skeleton = (ast_layout_skeleton_t){
+        .bones = malloc(sizeof(ast_layout_bone_t) * length),
+        .bones_length = length,
+        .bones_capacity = length,
+    };
+
+    for(length_t i = 0; i != length; i++){
+        ast_layout_bone_t *bone = &skeleton.bones[i];
+        uint64_t kind = ast_deserialize_u64(reader);
+        bone->traits = ast_deserialize_u64(reader);
+
+        if(kind == AST_LAYOUT_BONE_KIND_STRUCT || kind == AST_LAYOUT_BONE_KIND_UNION){
+            bone->kind = kind;
+            bone->children = ast_deserialize_skeleton(reader);
+        } else {
+            if(kind != AST_LAYOUT_BONE_KIND_TYPE) reader->failed = true;
+            bone->kind = AST_LAYOUT_BONE_KIND_TYPE;
+            bone->type = ast_deserialize_type(reader);
+        }
+    }
+
+    return skeleton;
+}
+
+static ast_layout_t ast_deserialize_layout(ast_reader_t *reader){
+    ast_layout_t layout;
+    layout.kind = ast_deserialize_u64(reader) == AST_LAYOUT_UNION ? AST_LAYOUT_UNION : AST_LAYOUT_STRUCT;
+    layout.traits = ast_deserialize_u64(reader);
+
+    ast_field_map_t *field_map = &layout.field_map;
+    field_map->is_simple = ast_deserialize_bool(reader);
+    field_map->arrows_length = ast_deserialize_count(reader);
+    field_map->arrows_capacity = field_map->arrows_length;
+    field_map->arrows = malloc(sizeof(ast_field_arrow_t) * field_map->arrows_length);
+    field_map->maybe_index = NULL;
+
+    for(length_t i = 0; i != field_map->arrows_length; i++){
+        ast_field_arrow_t *arrow = &field_map->arrows[i];
+        arrow->name = ast_deserialize_strong_string(reader);
+
+        for(length_t j = 0; j != AST_LAYOUT_MAX_DEPTH; j++){
+            arrow->endpoint.indices[j] = ast_deserialize_u64(reader);
+            if(arrow->endpoint.indices[j] == AST_LAYOUT_ENDPOINT_END_INDEX) break;
+        }
+    }
+
+    layout.skeleton = ast_deserialize_skeleton(reader);
+    return layout;
+}
+
+static ast_expr_t **ast_deserialize_exprs(ast_reader_t *reader, length_t *out_length){
+    length_t length = ast_deserialize_count(reader);
+    ast_expr_t **exprs = malloc(sizeof(ast_expr_t*) * length);
+
+    for(length_t i = 0; i != length; i++){
+        exprs[i] = ast_deserialize_expr(reader);
+    }
+
+    *out_length = length;
+    return exprs;
+}
+
+static ast_expr_list_t ast_deserialize_expr_list(ast_reader_t *reader){
+    ast_expr_list_t list;
+    list.statements = ast_deserialize_exprs(reader, &list.length);
+    list.capacity = list.length;
+    return list;
+}
+
+static optional_ast_expr_list_t ast_deserialize_optional_expr_list(ast_reader_t *reader){
+    if(!ast_deserialize_bool(reader)) return NO_AST_EXPR_LIST;
+
+    return (optional_ast_expr_list_t){
+        .has = true,
+        .value = ast_deserialize_expr_list(reader),
+    };
+}
+
+static ast_named_expression_t ast_deserialize_named_expression(ast_reader_t *reader){
+    ast_named_expression_t named_expression;
+    named_expression.name = ast_deserialize_strong_string(reader);
+    named_expression.expression = ast_deserialize_expr(reader);
+    named_expression.traits = ast_deserialize_u64(reader);
+    named_expression.source = ast_deserialize_source(reader);
+    return named_expression;
+}
+
+static void *ast_deserialize_new_expr(length_t size, unsigned int id, source_t source){
+    ast_expr_t *expr = ast_node_alloc(size);
+    expr->id = id;
+    expr->source = source;
+    return expr;
+}
+
+static ast_expr_t *ast_deserialize_expr(ast_reader_t *reader){
+    unsigned int id = ast_deserialize_u64(reader);
+    if(id == EXPR_NONE || reader->failed) return NULL;
+
+    source_t source = ast_deserialize_source(reader);
+
+    switch(id){
+    case EXPR_BYTE: {
+            ast_expr_byte_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->value = ast_deserialize_i64(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_UBYTE: {
+            ast_expr_ubyte_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->value = ast_deserialize_u64(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_SHORT: {
+            ast_expr_short_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->value = ast_deserialize_i64(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_USHORT: {
+            ast_expr_ushort_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->value = ast_deserialize_u64(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_INT: {
+            ast_expr_int_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->value = ast_deserialize_i64(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_UINT: {
+            ast_expr_uint_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->value = ast_deserialize_u64(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_LONG: {
+            ast_expr_long_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->value = ast_deserialize_i64(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_ULONG: {
+            ast_expr_ulong_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->value = ast_deserialize_u64(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_USIZE: {
+            ast_expr_usize_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->value = ast_deserialize_u64(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_FLOAT: {
+            ast_expr_float_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->value = ast_deserialize_double(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_DOUBLE: {
+            ast_expr_double_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->value = ast_deserialize_double(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_BOOLEAN: {
+            ast_expr_boolean_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->value = ast_deserialize_bool(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_STR:
+    case EXPR_CSTR: {
+            ast_expr_str_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->array = ast_deserialize_weak_string_of_length(reader, &expr->length);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_GENERIC_INT: {
+            ast_expr_generic_int_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->value = ast_deserialize_i64(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_GENERIC_FLOAT: {
+            ast_expr_generic_float_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->value = ast_deserialize_double(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_NULL:
+    case EXPR_BREAK:
+    case EXPR_CONTINUE:
+    case EXPR_FALLTHROUGH:
+        return ast_deserialize_new_expr(sizeof(ast_expr_t), id, source);
+    case EXPR_ADD:
+    case EXPR_SUBTRACT:
+    case EXPR_MULTIPLY:
+    case EXPR_DIVIDE:
+    case EXPR_MODULUS:
+    case EXPR_EQUALS:
+    case EXPR_NOTEQUALS:
+    case EXPR_GREATER:
+    case EXPR_LESSER:
+    case EXPR_GREATEREQ:
+    case EXPR_LESSEREQ:
+    case EXPR_AND:
+    case EXPR_OR:
+    case EXPR_BIT_AND:
+    case EXPR_BIT_OR:
+    case EXPR_BIT_XOR:
+    case EXPR_BIT_LSHIFT:
+    case EXPR_BIT_RSHIFT:
+    case EXPR_BIT_LGC_LSHIFT:
+    case EXPR_BIT_LGC_RSHIFT: {
+            ast_expr_math_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->a = ast_deserialize_expr(reader);
+            expr->b = ast_deserialize_expr(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_ADDRESS:
+    case EXPR_DEREFERENCE:
+    case EXPR_BIT_COMPLEMENT:
+    case EXPR_NOT:
+    case EXPR_NEGATE:
+    case EXPR_DELETE:
+    case EXPR_PREINCREMENT:
+    case EXPR_PREDECREMENT:
+    case EXPR_POSTINCREMENT:
+    case EXPR_POSTDECREMENT:
+    case EXPR_TOGGLE:
+    case EXPR_VA_START:
+    case EXPR_VA_END:
+    case EXPR_SIZEOF_VALUE: {
+            ast_expr_unary_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->value = ast_deserialize_expr(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_AT:
+    case EXPR_ARRAY_ACCESS: {
+            ast_expr_array_access_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->value = ast_deserialize_expr(reader);
+            expr->index = ast_deserialize_expr(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_CALL: {
+            ast_expr_call_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->name = ast_deserialize_strong_string(reader);
+            expr->args = ast_deserialize_exprs(reader, &expr->arity);
+            expr->gives = ast_deserialize_type(reader);
+            expr->is_tentative = ast_deserialize_bool(reader);
+            expr->only_implicit = ast_deserialize_bool(reader);
+            expr->no_user_casts = ast_deserialize_bool(reader);
+            expr->no_discard = ast_deserialize_bool(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_SUPER: {
+            ast_expr_super_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->args = ast_deserialize_exprs(reader, &expr->arity);
+            expr->is_tentative = ast_deserialize_bool(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_VARIABLE: {
+            ast_expr_variable_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->name = ast_deserialize_interned_string(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_MEMBER: {
+            ast_expr_member_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->value = ast_deserialize_expr(reader);
+            expr->member = ast_deserialize_strong_string(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_FUNC_ADDR: {
+            ast_expr_func_addr_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->name = ast_deserialize_weak_string(reader);
+            bool has_match_args_array = ast_deserialize_bool(reader);
+            expr->match_args_length = ast_deserialize_count(reader);
+            expr->match_args = has_match_args_array ? ast_deserialize_types(reader, expr->match_args_length) : NULL;
+            expr->traits = ast_deserialize_u64(reader);
+            expr->tentative = ast_deserialize_bool(reader);
+            expr->has_match_args = ast_deserialize_bool(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_CAST: {
+            ast_expr_cast_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->to = ast_deserialize_type(reader);
+            expr->from = ast_deserialize_expr(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_SIZEOF:
+    case EXPR_ALIGNOF:
+    case EXPR_TYPENAMEOF:
+    case EXPR_TYPEINFO: {
+            ast_expr_unary_type_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->type = ast_deserialize_type(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_CALL_METHOD: {
+            ast_expr_call_method_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->name = ast_deserialize_strong_string(reader);
+            expr->value = ast_deserialize_expr(reader);
+            expr->args = ast_deserialize_exprs(reader, &expr->arity);
+            expr->gives = ast_deserialize_type(reader);
+            expr->is_tentative = ast_deserialize_bool(reader);
+            expr->allow_drop = ast_deserialize_bool(reader);
+            expr->no_discard = ast_deserialize_bool(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_NEW: {
+            ast_expr_new_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->type = ast_deserialize_type(reader);
+            expr->amount = ast_deserialize_expr(reader);
+            expr->is_undef = ast_deserialize_bool(reader);
+            expr->inputs = ast_deserialize_optional_expr_list(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_NEW_CSTRING: {
+            ast_expr_new_cstring_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->array = ast_deserialize_weak_string_of_length(reader, &expr->length);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_ENUM_VALUE: {
+            ast_expr_enum_value_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->enum_name = ast_deserialize_weak_string(reader);
+            expr->kind_name = ast_deserialize_weak_string(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_GENERIC_ENUM_VALUE: {
+            ast_expr_generic_enum_value_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->kind_name = ast_deserialize_weak_string(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_STATIC_ARRAY:
+    case EXPR_STATIC_STRUCT: {
+            ast_expr_static_data_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->type = ast_deserialize_type(reader);
+            expr->values = ast_deserialize_exprs(reader, &expr->length);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_TERNARY: {
+            ast_expr_ternary_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->condition = ast_deserialize_expr(reader);
+            expr->if_true = ast_deserialize_expr(reader);
+            expr->if_false = ast_deserialize_expr(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_VA_ARG: {
+            ast_expr_va_arg_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->va_list = ast_deserialize_expr(reader);
+            expr->arg_type = ast_deserialize_type(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_INITLIST: {
+            ast_expr_initlist_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->elements = ast_deserialize_exprs(reader, &expr->length);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_POLYCOUNT: {
+            ast_expr_polycount_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->name = ast_deserialize_strong_string(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_LLVM_ASM: {
+            ast_expr_llvm_asm_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->assembly = ast_deserialize_strong_string(reader);
+            expr->constraints = ast_deserialize_weak_string(reader);
+            expr->args = ast_deserialize_exprs(reader, &expr->arity);
+            expr->has_side_effects = ast_deserialize_bool(reader);
+            expr->is_stack_align = ast_deserialize_bool(reader);
+            expr->is_intel = ast_deserialize_bool(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_EMBED: {
+            ast_expr_embed_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->filename = ast_deserialize_strong_string(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_DECLARE:
+    case EXPR_DECLAREUNDEF:
+    case EXPR_ILDECLARE:
+    case EXPR_ILDECLAREUNDEF: {
+            ast_expr_declare_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->name = ast_deserialize_weak_string(reader);
+            expr->type = ast_deserialize_type(reader);
+            expr->value = ast_deserialize_expr(reader);
+            expr->traits = ast_deserialize_u64(reader);
+            expr->inputs = ast_deserialize_optional_expr_list(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_ASSIGN:
+    case EXPR_ADD_ASSIGN:
+    case EXPR_SUBTRACT_ASSIGN:
+    case EXPR_MULTIPLY_ASSIGN:
+    case EXPR_DIVIDE_ASSIGN:
+    case EXPR_MODULUS_ASSIGN:
+    case EXPR_AND_ASSIGN:
+    case EXPR_OR_ASSIGN:
+    case EXPR_XOR_ASSIGN:
+    case EXPR_LSHIFT_ASSIGN:
+    case EXPR_RSHIFT_ASSIGN:
+    case EXPR_LGC_LSHIFT_ASSIGN:
+    case EXPR_LGC_RSHIFT_ASSIGN: {
+            ast_expr_assign_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->destination = ast_deserialize_expr(reader);
+            expr->value = ast_deserialize_expr(reader);
+            expr->is_pod = ast_deserialize_bool(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_RETURN: {
+            ast_expr_return_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->value = ast_deserialize_expr(reader);
+            expr->last_minute = ast_deserialize_expr_list(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_IF:
+    case EXPR_UNLESS:
+    case EXPR_WHILE:
+    case EXPR_UNTIL:
+    case EXPR_WHILECONTINUE:
+    case EXPR_UNTILBREAK: {
+            ast_expr_conditional_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->label = ast_deserialize_weak_string(reader);
+            expr->value = ast_deserialize_expr(reader);
+            expr->statements = ast_deserialize_expr_list(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_IFELSE:
+    case EXPR_UNLESSELSE: {
+            ast_expr_conditional_else_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->label = ast_deserialize_weak_string(reader);
+            expr->value = ast_deserialize_expr(reader);
+            expr->statements = ast_deserialize_expr_list(reader);
+            expr->else_statements = ast_deserialize_expr_list(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_EACH_IN: {
+            ast_expr_each_in_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->label = ast_deserialize_weak_string(reader);
+            expr->it_name = ast_deserialize_strong_string(reader);
+            expr->it_type = ast_deserialize_maybe_type(reader);
+            expr->length = ast_deserialize_expr(reader);
+            expr->low_array = ast_deserialize_expr(reader);
+            expr->list = ast_deserialize_expr(reader);
+            expr->statements = ast_deserialize_expr_list(reader);
+            expr->is_static = ast_deserialize_bool(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_REPEAT: {
+            ast_expr_repeat_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->label = ast_deserialize_weak_string(reader);
+            expr->limit = ast_deserialize_expr(reader);
+            expr->statements = ast_deserialize_expr_list(reader);
+            expr->idx_name = ast_deserialize_weak_string(reader);
+            expr->is_static = ast_deserialize_bool(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_BREAK_TO:
+    case EXPR_CONTINUE_TO: {
+            ast_expr_break_to_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->label_source = ast_deserialize_source(reader);
+            expr->label = ast_deserialize_weak_string(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_SWITCH: {
+            ast_expr_switch_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->value = ast_deserialize_expr(reader);
+            expr->cases = (ast_case_list_t){0};
+
+            length_t cases_length = ast_deserialize_count(reader);
+
+            for(length_t i = 0; i != cases_length; i++){
+                ast_case_t single_case;
+                single_case.condition = ast_deserialize_expr(reader);
+                single_case.statements = ast_deserialize_expr_list(reader);
+                single_case.source = ast_deserialize_source(reader);
+                ast_case_list_append(&expr->cases, single_case);
+            }
+
+            expr->or_default = ast_deserialize_expr_list(reader);
+            expr->is_exhaustive = ast_deserialize_bool(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_VA_COPY: {
+            ast_expr_va_copy_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->dest_value = ast_deserialize_expr(reader);
+            expr->src_value = ast_deserialize_expr(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_FOR: {
+            ast_expr_for_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->label = ast_deserialize_weak_string(reader);
+            expr->before = ast_deserialize_expr_list(reader);
+            expr->after = ast_deserialize_expr_list(reader);
+            expr->condition = ast_deserialize_expr(reader);
+            expr->statements = ast_deserialize_expr_list(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_DECLARE_NAMED_EXPRESSION: {
+            ast_expr_declare_named_expression_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->named_expression = ast_deserialize_named_expression(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_CONDITIONLESS_BLOCK: {
+            ast_expr_conditionless_block_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->statements = ast_deserialize_expr_list(reader);
+            return (ast_expr_t*) expr;
+        }
+    case EXPR_ASSERT: {
+            ast_expr_assert_t *expr = ast_deserialize_new_expr(sizeof *expr, id, source);
+            expr->assertion = ast_deserialize_expr(reader);
+            expr->message = ast_deserialize_expr(reader);
+            return (ast_expr_t*) expr;
+        }
+    }
+
+    reader->failed = true;
+    return NULL;
+}
+
+static void ast_deserialize_composite(ast_reader_t *reader, ast_composite_t *out_composite){
+    out_composite->name = ast_deserialize_interned_string(reader);
+    out_composite->layout = ast_deserialize_layout(reader);
+    out_composite->source = ast_deserialize_source(reader);
+    out_composite->parent = ast_deserialize_type(reader);
+    out_composite->is_class = ast_deserialize_bool(reader);
+    out_composite->has_constructor = ast_deserialize_bool(reader);
+}
+
+static void ast_deserialize_func(ast_reader_t *reader, ast_func_t *out_func){
+    ast_func_t *func = out_func;
+    func->name = ast_deserialize_interned_string(reader);
+    func->arity = ast_deserialize_count(reader);
+
+    func->arg_names = NULL;
+    if(ast_deserialize_bool(reader)){
+        func->arg_names = malloc(sizeof(strong_cstr_t) * func->arity);
+        for(length_t i = 0; i != func->arity; i++) func->arg_names[i] = ast_deserialize_strong_string(reader);
+    }
+
+    func->arg_types = ast_deserialize_bool(reader) ? ast_deserialize_types(reader, func->arity) : NULL;
+
+    func->arg_sources = NULL;
+    if(ast_deserialize_bool(reader)){
+        func->arg_sources = malloc(sizeof(source_t) * func->arity);
+        for(length_t i = 0; i != func->arity; i++) func->arg_sources[i] = ast_deserialize_source(reader);
+    }
+
+    func->arg_flows = NULL;
+    if(ast_deserialize_bool(reader)){
+        func->arg_flows = malloc(sizeof(char) * func->arity);
+        for(length_t i = 0; i != func->arity; i++) func->arg_flows[i] = ast_deserialize_u64(reader);
+    }
+
+    func->arg_type_traits = NULL;
+    if(ast_deserialize_bool(reader)){
+        func->arg_type_traits = malloc(sizeof(trait_t) * func->arity);
+        for(length_t i = 0; i != func->arity; i++) func->arg_type_traits[i] = ast_deserialize_u64(reader);
+    }
+
+    func->arg_defaults = NULL;
+    if(ast_deserialize_bool(reader)){
+        func->arg_defaults = malloc(sizeof(ast_expr_t*) * func->arity);
+        for(length_t i = 0; i != func->arity; i++) func->arg_defaults[i] = ast_deserialize_expr(reader);
+    }
+
+    func->return_type = ast_deserialize_type(reader);
+    func->traits = ast_deserialize_u64(reader);
+    func->variadic_arg_name = ast_deserialize_strong_string(reader);
+    func->variadic_source = ast_deserialize_source(reader);
+    func->statements = ast_deserialize_expr_list(reader);
+    func->source = ast_deserialize_source(reader);
+    func->export_as = ast_deserialize_strong_string(reader);
+    func->instantiation_depth = ast_deserialize_u64(reader);
+    func->virtual_origin = ast_deserialize_func_id(reader);
+
+    #ifdef ADEPT_INSIGHT_BUILD
+    func->end_source = ast_deserialize_source(reader);
+    #endif
+}
+
+static strong_cstr_t *ast_deserialize_generics(ast_reader_t *reader, length_t *out_length){
+    length_t length = ast_deserialize_count(reader);
+    strong_cstr_t *generics = malloc(sizeof(strong_cstr_t) * length);
+
+    for(length_t i = 0; i != length; i++){
+        generics[i] = ast_deserialize_strong_string(reader);
+    }
+
+    *out_length = length;
+    return generics;
+}
+
+static meta_expr_t *ast_deserialize_meta_expr(ast_reader_t *reader){
+    unsigned int id = ast_deserialize_u64(reader);
+
+    switch(id){
+    case META_EXPR_STR: {
+            meta_expr_str_t *value = malloc(sizeof(meta_expr_str_t));
+            value->id = id;
+            value->value = ast_deserialize_strong_string(reader);
+            if(value->value == NULL) value->value = strclone("");
+            return (meta_expr_t*) value;
+        }
+    case META_EXPR_INT: {
+            meta_expr_int_t *value = malloc(sizeof(meta_expr_int_t));
+            value->id = id;
+            value->value = ast_deserialize_i64(reader);
+            return (meta_expr_t*) value;
+        }
+    case META_EXPR_FLOAT: {
+            meta_expr_float_t *value = malloc(sizeof(meta_expr_float_t));
+            value->id = id;
+            value->value = ast_deserialize_double(reader);
+            return (meta_expr_t*) value;
+        }
+    default: {
+            if(!(id == META_EXPR_UNDEF || id == META_EXPR_NULL || id == META_EXPR_TRUE || id == META_EXPR_FALSE)){
+                reader->failed = true;
+                id = META_EXPR_UNDEF;
+            }
+
+            meta_expr_t *value = malloc(sizeof(meta_expr_t));
+            value->id = id;
+            return value;
+        }
+    }
+}
+
+static void ast_deserialize_poly_funcs(ast_reader_t *reader, ast_t *ast, bool methods){
+    length_t length = ast_deserialize_count(reader);
+
+    for(length_t i = 0; i != length && !reader->failed; i++){
+        func_id_t ast_func_id = ast_deserialize_func_id(reader);
+        if(ast_func_id == INVALID_FUNC_ID) reader->failed = true;
+        if(reader->failed) return;
+
+        if(methods){
+            expand((void**) &ast->polymorphic_methods, sizeof(ast_poly_func_t), ast->polymorphic_methods_length, &ast->polymorphic_methods_capacity, 1, 4);
+
+            ast->polymorphic_methods[ast->polymorphic_methods_length++] = (ast_poly_func_t){
+                .name = ast->funcs[ast_func_id].name,
+                .ast_func_id = ast_func_id,
+                .is_beginning_of_group = -1,
+            };
+        } else {
+            ast_add_poly_func(ast, ast->funcs[ast_func_id].name, ast_func_id);
+        }
+    }
+}
+
+static bool ast_deserialize_is_existing_builtin(source_t source, const char *name, const void *items, length_t length, length_t item_size){
+    // Built-in declarations (such as 'Any') are injected into every AST,
+    // so there's no need to import them twice
+    // NOTE: Relies on every declaration struct beginning with its name
+    if(!SOURCE_IS_NULL(source) || name == NULL) return false;
+
+    for(length_t i = 0; i != length; i++){
+        const char *item_name = *(const char**) ((const char*) items + i * item_size);
+        if(streq(item_name, name)) return true;
+    }
+
+    return false;
+}
+
+errorcode_t ast_deserialize(ast_t *ast, const char *buffer, length_t length, arena_t *strings, maybe_index_t relocate_object_index){
+    ast_reader_t reader = (ast_reader_t){
+        .data = buffer,
+        .length = length,
+        .position = 0,
+        .strings = strings,
+        .relocate_object_index = relocate_object_index,
+        .func_offset = ast->funcs_length,
+        .funcs_length = 0,
+        .failed = false,
+    };
+
+    const char *magic = ast_deserialize_bytes(&reader, 8);
+    if(magic == NULL || memcmp(magic, AST_SERIALIZE_MAGIC, 8) != 0) return FAILURE;
+    if(ast_deserialize_u64(&reader) != AST_SERIALIZE_FORMAT_VERSION) return FAILURE;
+
+    length_t version_length;
+    const char *version = ast_deserialize_string_view(&reader, &version_length);
+    if(version == NULL || version_length != strlen(ADEPT_VERSION_STRING) || memcmp(version, ADEPT_VERSION_STRING, version_length) != 0) return FAILURE;
+
+    length_t enums_length = ast_deserialize_count(&reader);
+    for(length_t i = 0; i != enums_length && !reader.failed; i++){
+        weak_cstr_t name = ast_deserialize_interned_string(&reader);
+        length_t kinds_length = ast_deserialize_count(&reader);
+        weak_cstr_t *kinds = malloc(sizeof(weak_cstr_t) * kinds_length);
+
+        for(length_t j = 0; j != kinds_length; j++){
+            kinds[j] = ast_deserialize_weak_string(&reader);
+        }
+
+        source_t source = ast_deserialize_source(&reader);
+
+        if(reader.failed || ast_deserialize_is_existing_builtin(source, name, ast->enums, ast->enums_length, sizeof(ast_enum_t))){
+            free(kinds);
+        } else {
+            ast_add_enum(ast, name, kinds, kinds_length, source);
+        }
+    }
+
+    length_t composites_length = ast_deserialize_count(&reader);
+    for(length_t i = 0; i != composites_length && !reader.failed; i++){
+        ast_composite_t composite;
+        ast_deserialize_composite(&reader, &composite);
+
+        if(reader.failed || ast_deserialize_is_existing_builtin(composite.source, composite.name, ast->composites, ast->composites_length, sizeof(ast_composite_t))){
+            ast_free_composites(&composite, 1);
+        } else {
+            ast_add_composite(ast, composite.name, composite.layout, composite.source, composite.parent, composite.is_class)->has_constructor = composite.has_constructor;
+        }
+    }
+
+    length_t globals_length = ast_deserialize_count(&reader);
+    for(length_t i = 0; i != globals_length && !reader.failed; i++){
+        strong_cstr_t name = ast_deserialize_strong_string(&reader);
+        ast_type_t type = ast_deserialize_type(&reader);
+        ast_expr_t *initial = ast_deserialize_expr(&reader);
+        trait_t traits = ast_deserialize_u64(&reader);
+        source_t source = ast_deserialize_source(&reader);
+
+        if(reader.failed || name == NULL || ast_deserialize_is_existing_builtin(source, name, ast->globals, ast->globals_length, sizeof(ast_global_t))){
+            free(name);
+            ast_type_free(&type);
+            ast_expr_free_fully(initial);
+        } else {
+            ast_add_global(ast, name, type, initial, traits, source);
+        }
+    }
+
+    reader.funcs_length = ast_deserialize_count(&reader);
+    for(length_t i = 0; i != reader.funcs_length && !reader.failed; i++){
+        // NOTE: Functions are always added, so that function ids only need to be offset
+        ast_func_t func;
+        ast_deserialize_func(&reader, &func);
+
+        // NOTE: 'ast_new_func' may move 'ast->funcs', so it must be called before indexing
+        func_id_t ast_func_id = ast_new_func(ast);
+        ast->funcs[ast_func_id] = func;
+    }
+
+    length_t aliases_length = ast_deserialize_count(&reader);
+    for(length_t i = 0; i != aliases_length && !reader.failed; i++){
+        strong_cstr_t name = ast_deserialize_strong_string(&reader);
+        ast_type_t type = ast_deserialize_type(&reader);
+        length_t generics_length;
+        strong_cstr_t *generics = ast_deserialize_generics(&reader, &generics_length);
+        trait_t traits = ast_deserialize_u64(&reader);
+        source_t source = ast_deserialize_source(&reader);
+
+        if(reader.failed || ast_deserialize_is_existing_builtin(source, name, ast->aliases, ast->aliases_length, sizeof(ast_alias_t))){
+            free(name);
+            ast_type_free(&type);
+            free_strings(generics, generics_length);
+        } else {
+            ast_add_alias(ast, name, type, generics, generics_length, traits, source);
+        }
+    }
+
+    length_t libraries_length = ast_deserialize_count(&reader);
+    for(length_t i = 0; i != libraries_length && !reader.failed; i++){
+        strong_cstr_t library = ast_deserialize_strong_string(&reader);
+        char kind = ast_deserialize_u64(&reader);
+
+        if(reader.failed || library == NULL){
+            free(library);
+        } else {
+            ast_add_foreign_library(ast, library, kind);
+        }
+    }
+
+    length_t func_aliases_length = ast_deserialize_count(&reader);
+    for(length_t i = 0; i != func_aliases_length && !reader.failed; i++){
+        ast_func_alias_t func_alias;
+        func_alias.from = ast_deserialize_strong_string(&reader);
+        func_alias.to = ast_deserialize_weak_string(&reader);
+        func_alias.arity = ast_deserialize_count(&reader);
+        func_alias.arg_types = ast_deserialize_bool(&reader) ? ast_deserialize_types(&reader, func_alias.arity) : NULL;
+        func_alias.required_traits = ast_deserialize_u64(&reader);
+        func_alias.source = ast_deserialize_source(&reader);
+        func_alias.match_first_of_name = ast_deserialize_bool(&reader);
+
+        expand((void**) &ast->func_aliases, sizeof(ast_func_alias_t), ast->func_aliases_length, &ast->func_aliases_capacity, 1, 8);
+        ast->func_aliases[ast->func_aliases_length++] = func_alias;
+    }
+
+    length_t poly_composites_length = ast_deserialize_count(&reader);
+    for(length_t i = 0; i != poly_composites_length && !reader.failed; i++){
+        ast_composite_t composite;
+        ast_deserialize_composite(&reader, &composite);
+
+        length_t generics_length;
+        strong_cstr_t *generics = ast_deserialize_generics(&reader, &generics_length);
+
+        if(reader.failed || ast_deserialize_is_existing_builtin(composite.source, composite.name, ast->poly_composites, ast->poly_composites_length, sizeof(ast_poly_composite_t))){
+            ast_free_composites(&composite, 1);
+            free_strings(generics, generics_length);
+        } else {
+            ast_add_poly_composite(ast, composite.name, composite.layout, composite.source, composite.parent, composite.is_class, generics, generics_length)->has_constructor = composite.has_constructor;
+        }
+    }
+
+    length_t named_expressions_length = ast_deserialize_count(&reader);
+    for(length_t i = 0; i != named_expressions_length && !reader.failed; i++){
+        ast_add_global_named_expression(ast, ast_deserialize_named_expression(&reader));
+    }
+
+    ast_type_t *variadic_array = ast_deserialize_maybe_type(&reader);
+    source_t variadic_source = variadic_array ? ast_deserialize_source(&reader) : NULL_SOURCE;
+
+    if(variadic_array && ast->common.ast_variadic_array == NULL){
+        ast->common.ast_variadic_array = variadic_array;
+        ast->common.ast_variadic_source = variadic_source;
+    } else {
+        ast_type_free_fully(variadic_array);
+    }
+
+    ast_type_t *initializer_list = ast_deserialize_maybe_type(&reader);
+    source_t initializer_list_source = initializer_list ? ast_deserialize_source(&reader) : NULL_SOURCE;
+
+    if(initializer_list && ast->common.ast_initializer_list == NULL){
+        ast->common.ast_initializer_list = initializer_list;
+        ast->common.ast_initializer_list_source = initializer_list_source;
+    } else {
+        ast_type_free_fully(initializer_list);
+    }
+
+    length_t meta_definitions_length = ast_deserialize_count(&reader);
+    for(length_t i = 0; i != meta_definitions_length && !reader.failed; i++){
+        weak_cstr_t name = ast_deserialize_weak_string(&reader);
+        meta_expr_t *value = ast_deserialize_meta_expr(&reader);
+
+        if(reader.failed || name == NULL || meta_definition_find(ast->meta_definitions, ast->meta_definitions_length, name)){
+            meta_expr_free_fully(value);
+        } else {
+            meta_definition_add(&ast->meta_definitions, &ast->meta_definitions_length, &ast->meta_definitions_capacity, name, value);
+        }
+    }
+
+    ast_deserialize_poly_funcs(&reader, ast, false);
+    ast_deserialize_poly_funcs(&reader, ast, true);
+
+    return reader.failed || reader.position != reader.length ? FAILURE : SUCCESS;
+}
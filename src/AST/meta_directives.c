@@ -8,7 +8,6 @@
 #include "AST/meta_directives.h"
 #include "DRVR/compiler.h"
 #include "DRVR/object.h"
-#include "LEX/lex.h"
 #include "UTIL/color.h"
 #include "UTIL/ground.h"
 #include "UTIL/search.h"
@@ -647,7 +646,7 @@ meta_expr_t *meta_get_special_variable(compiler_t *compiler, object_t *object, w
     switch(special_index){
     case 0: { // __column__
             int line, column;
-            lex_get_location(compiler->objects[variable_source.object_index]->buffer, variable_source.index, &line, &column);
+            object_get_location(compiler->objects[variable_source.object_index], variable_source.index, &line, &column);
             
             result = malloc(sizeof(meta_expr_int_t));
             ((meta_expr_int_t*) result)->id = META_EXPR_INT;
@@ -662,7 +661,7 @@ meta_expr_t *meta_get_special_variable(compiler_t *compiler, object_t *object, w
         break;
     case 2: { // __line__
             int line, column;
-            lex_get_location(compiler->objects[variable_source.object_index]->buffer, variable_source.index, &line, &column);
+            object_get_location(compiler->objects[variable_source.object_index], variable_source.index, &line, &column);
             
             result = malloc(sizeof(meta_expr_int_t));
             ((meta_expr_int_t*) result)->id = META_EXPR_INT;
@@ -374,11 +374,17 @@ static errorcode_t emit_to_file(
 }
 
 errorcode_t ir_to_llvm(compiler_t *compiler, object_t *object){
-    LLVMInitializeAllTargetInfos();
-    LLVMInitializeAllTargets();
-    LLVMInitializeAllTargetMCs();
-    LLVMInitializeAllAsmParsers();
-    LLVMInitializeAllAsmPrinters();
+    // Targets only need to be initialized once per process (which matters for compile servers)
+    static bool targets_initialized = false;
+
+    if(!targets_initialized){
+        LLVMInitializeAllTargetInfos();
+        LLVMInitializeAllTargets();
+        LLVMInitializeAllTargetMCs();
+        LLVMInitializeAllAsmParsers();
+        LLVMInitializeAllAsmPrinters();
+        targets_initialized = true;
+    }
 
     ir_module_t *ir_module = &object->ir_module;
     weak_cstr_t module_name = filename_name_const(object->filename);
@@ -276,10 +276,10 @@ LLVMValueRef ir_to_llvm_value(llvm_context_t *llvm, ir_value_t *value){
             LLVMValueRef value = llvm_string_table_find(&llvm->string_table, cstr_of_len->array, cstr_of_len->size);
 
             if(value == NULL){
-                // DANGEROUS: TODO: Remove this!!!
-                static int i = 0;
+                // Every new string constant is added to the string table,
+                // so its length works as a per-module counter
                 char name_buffer[256];
-                snprintf(name_buffer, sizeof name_buffer, "S%X", i++);
+                snprintf(name_buffer, sizeof name_buffer, "S%X", (unsigned int) llvm->string_table.length);
 
                 LLVMTypeRef raw_characters_type = LLVMArrayType(LLVMInt8Type(), cstr_of_len->size);
 
@@ -395,6 +395,14 @@ errorcode_t ir_to_llvm_functions(llvm_context_t *llvm, object_t *object){
 
     for(length_t ir_func_id = 0; ir_func_id != module_funcs_length; ir_func_id++){
         ir_func_t *ir_func = &module_funcs[ir_func_id];
+
+        // Functions that were never referenced don't exist in the output
+        if(ir_func->traits & IR_FUNC_UNREACHED){
+            func_skeletons[ir_func_id] = NULL;
+            func_skeleton_types[ir_func_id] = NULL;
+            continue;
+        }
+
         LLVMTypeRef parameters[length_max(1, ir_func->arity)];
 
         for(length_t a = 0; a != ir_func->arity; a++){
@@ -472,6 +480,8 @@ errorcode_t ir_to_llvm_function_bodies(llvm_context_t *llvm, object_t *object){
     llvm->relocation_list = (llvm_phi2_relocation_list_t){0};
 
     for(length_t f = 0; f != module_funcs_length; f++){
+        if(module_funcs[f].traits & IR_FUNC_UNREACHED) continue;
+
         LLVMBuilderRef builder = LLVMCreateBuilder();
         ir_basicblocks_t basicblocks = module_funcs[f].basicblocks;
 
@@ -46,15 +46,15 @@ void any_inject_ast_Any(ast_t *ast){
     };
 
     ast_type_t types[2] = {
-        ast_type_make_base_ptr(strclone("AnyType")),
-        ast_type_make_base(strclone("ulong")),
+        ast_type_make_base_ptr("AnyType"),
+        ast_type_make_base("ulong"),
     };
 
     static_assert(NUM_ITEMS(names) == NUM_ITEMS(types), "");
 
     ast_layout_t layout;
     ast_layout_init_with_struct_fields(&layout, names, types, NUM_ITEMS(types));
-    ast_add_composite(ast, strclone("Any"), layout, NULL_SOURCE, AST_TYPE_NONE, false);
+    ast_add_composite(ast, "Any", layout, NULL_SOURCE, AST_TYPE_NONE, false);
 }
 
 void any_inject_ast_AnyType(ast_t *ast){
@@ -69,17 +69,17 @@ void any_inject_ast_AnyType(ast_t *ast){
     };
 
     ast_type_t types[4] = {
-        ast_type_make_base(strclone("AnyTypeKind")),
-        ast_type_make_base_ptr(strclone("ubyte")),
-        ast_type_make_base(strclone("bool")),
-        ast_type_make_base(strclone("usize")),
+        ast_type_make_base("AnyTypeKind"),
+        ast_type_make_base_ptr("ubyte"),
+        ast_type_make_base("bool"),
+        ast_type_make_base("usize"),
     };
 
     static_assert(NUM_ITEMS(names) == NUM_ITEMS(types), "");
 
     ast_layout_t layout;
     ast_layout_init_with_struct_fields(&layout, names, types, NUM_ITEMS(types));
-    ast_add_composite(ast, strclone("AnyType"), layout, NULL_SOURCE, AST_TYPE_NONE, false);
+    ast_add_composite(ast, "AnyType", layout, NULL_SOURCE, AST_TYPE_NONE, false);
 }
 
 void any_inject_ast_AnyTypeKind(ast_t *ast){
@@ -111,7 +111,7 @@ void any_inject_ast_AnyTypeKind(ast_t *ast){
     kinds[16] = "FIXED_ARRAY";
     kinds[17] = "ENUM";
 
-    ast_add_enum(ast, strclone("AnyTypeKind"), kinds, 18, NULL_SOURCE);
+    ast_add_enum(ast, "AnyTypeKind", kinds, 18, NULL_SOURCE);
 }
 
 void any_inject_ast_AnyPtrType(ast_t *ast){
@@ -127,18 +127,18 @@ void any_inject_ast_AnyPtrType(ast_t *ast){
     };
 
     ast_type_t types[5] = {
-        ast_type_make_base(strclone("AnyTypeKind")),
-        ast_type_make_base_ptr(strclone("ubyte")),
-        ast_type_make_base(strclone("bool")),
-        ast_type_make_base(strclone("usize")),
-        ast_type_make_base_ptr(strclone("AnyType")),
+        ast_type_make_base("AnyTypeKind"),
+        ast_type_make_base_ptr("ubyte"),
+        ast_type_make_base("bool"),
+        ast_type_make_base("usize"),
+        ast_type_make_base_ptr("AnyType"),
     };
 
     static_assert(NUM_ITEMS(names) == NUM_ITEMS(types), "");
 
     ast_layout_t layout;
     ast_layout_init_with_struct_fields(&layout, names, types, NUM_ITEMS(types));
-    ast_add_composite(ast, strclone("AnyPtrType"), layout, NULL_SOURCE, AST_TYPE_NONE, false);
+    ast_add_composite(ast, "AnyPtrType", layout, NULL_SOURCE, AST_TYPE_NONE, false);
 }
 
 void any_inject_ast_AnyCompositeType(ast_t *ast){
@@ -158,22 +158,22 @@ void any_inject_ast_AnyCompositeType(ast_t *ast){
     };
 
     ast_type_t types[9] = {
-        ast_type_make_base(strclone("AnyTypeKind")),
-        ast_type_make_base_ptr(strclone("ubyte")),
-        ast_type_make_base(strclone("bool")),
-        ast_type_make_base(strclone("usize")),
-        ast_type_make_base_ptr_ptr(strclone("AnyType")),
-        ast_type_make_base(strclone("usize")),
-        ast_type_make_base_ptr(strclone("usize")),
-        ast_type_make_base_ptr_ptr(strclone("ubyte")),
-        ast_type_make_base(strclone("bool")),
+        ast_type_make_base("AnyTypeKind"),
+        ast_type_make_base_ptr("ubyte"),
+        ast_type_make_base("bool"),
+        ast_type_make_base("usize"),
+        ast_type_make_base_ptr_ptr("AnyType"),
+        ast_type_make_base("usize"),
+        ast_type_make_base_ptr("usize"),
+        ast_type_make_base_ptr_ptr("ubyte"),
+        ast_type_make_base("bool"),
     };
 
     static_assert(NUM_ITEMS(names) == NUM_ITEMS(types), "");
 
     ast_layout_t layout;
     ast_layout_init_with_struct_fields(&layout, names, types, NUM_ITEMS(types));
-    ast_add_composite(ast, strclone("AnyCompositeType"), layout, NULL_SOURCE, AST_TYPE_NONE, false);
+    ast_add_composite(ast, "AnyCompositeType", layout, NULL_SOURCE, AST_TYPE_NONE, false);
 }
 
 void any_inject_ast_AnyStructType(ast_t *ast){
@@ -182,7 +182,7 @@ void any_inject_ast_AnyStructType(ast_t *ast){
 
     // alias AnyStructType = AnyCompositeType
 
-    ast_type_t strong_type = ast_type_make_base(strclone("AnyCompositeType"));
+    ast_type_t strong_type = ast_type_make_base("AnyCompositeType");
 
     ast_add_alias(ast, strclone("AnyStructType"), strong_type, NULL, 0, TRAIT_NONE, NULL_SOURCE);
 }
@@ -193,7 +193,7 @@ void any_inject_ast_AnyUnionType(ast_t *ast){
 
     // alias AnyUnionType = AnyCompositeType
 
-    ast_type_t strong_type = ast_type_make_base(strclone("AnyCompositeType"));
+    ast_type_t strong_type = ast_type_make_base("AnyCompositeType");
 
     ast_add_alias(ast, strclone("AnyUnionType"), strong_type, NULL, 0, TRAIT_NONE, NULL_SOURCE);
 }
@@ -215,22 +215,22 @@ void any_inject_ast_AnyFuncPtrType(ast_t *ast){
     };
 
     ast_type_t types[9] = {
-        ast_type_make_base(strclone("AnyTypeKind")),
-        ast_type_make_base_ptr(strclone("ubyte")),
-        ast_type_make_base(strclone("bool")),
-        ast_type_make_base(strclone("usize")),
-        ast_type_make_base_ptr_ptr(strclone("AnyType")),
-        ast_type_make_base(strclone("usize")),
-        ast_type_make_base_ptr(strclone("AnyType")),
-        ast_type_make_base(strclone("bool")),
-        ast_type_make_base(strclone("bool")),
+        ast_type_make_base("AnyTypeKind"),
+        ast_type_make_base_ptr("ubyte"),
+        ast_type_make_base("bool"),
+        ast_type_make_base("usize"),
+        ast_type_make_base_ptr_ptr("AnyType"),
+        ast_type_make_base("usize"),
+        ast_type_make_base_ptr("AnyType"),
+        ast_type_make_base("bool"),
+        ast_type_make_base("bool"),
     };
 
     static_assert(NUM_ITEMS(names) == NUM_ITEMS(types), "");
 
     ast_layout_t layout;
     ast_layout_init_with_struct_fields(&layout, names, types, NUM_ITEMS(types));
-    ast_add_composite(ast, strclone("AnyFuncPtrType"), layout, NULL_SOURCE, AST_TYPE_NONE, false);
+    ast_add_composite(ast, "AnyFuncPtrType", layout, NULL_SOURCE, AST_TYPE_NONE, false);
 }
 
 void any_inject_ast_AnyFixedArrayType(ast_t *ast){
@@ -247,19 +247,19 @@ void any_inject_ast_AnyFixedArrayType(ast_t *ast){
     };
 
     ast_type_t types[6] = {
-        ast_type_make_base(strclone("AnyTypeKind")),
-        ast_type_make_base_ptr(strclone("ubyte")),
-        ast_type_make_base(strclone("bool")),
-        ast_type_make_base(strclone("usize")),
-        ast_type_make_base_ptr(strclone("AnyType")),
-        ast_type_make_base(strclone("usize")),
+        ast_type_make_base("AnyTypeKind"),
+        ast_type_make_base_ptr("ubyte"),
+        ast_type_make_base("bool"),
+        ast_type_make_base("usize"),
+        ast_type_make_base_ptr("AnyType"),
+        ast_type_make_base("usize"),
     };
 
     static_assert(NUM_ITEMS(names) == NUM_ITEMS(types), "");
 
     ast_layout_t layout;
     ast_layout_init_with_struct_fields(&layout, names, types, NUM_ITEMS(types));
-    ast_add_composite(ast, strclone("AnyFixedArrayType"), layout, NULL_SOURCE, AST_TYPE_NONE, false);
+    ast_add_composite(ast, "AnyFixedArrayType", layout, NULL_SOURCE, AST_TYPE_NONE, false);
 }
 
 void any_inject_ast_AnyEnumType(ast_t *ast){
@@ -276,26 +276,26 @@ void any_inject_ast_AnyEnumType(ast_t *ast){
     };
 
     ast_type_t types[6] = {
-        ast_type_make_base(strclone("AnyTypeKind")),
-        ast_type_make_base_ptr(strclone("ubyte")),
-        ast_type_make_base(strclone("bool")),
-        ast_type_make_base(strclone("usize")),
-        ast_type_pointer_to(ast_type_make_base_ptr(strclone("ubyte"))),
-        ast_type_make_base(strclone("usize")),
+        ast_type_make_base("AnyTypeKind"),
+        ast_type_make_base_ptr("ubyte"),
+        ast_type_make_base("bool"),
+        ast_type_make_base("usize"),
+        ast_type_pointer_to(ast_type_make_base_ptr("ubyte")),
+        ast_type_make_base("usize"),
     };
 
     static_assert(NUM_ITEMS(names) == NUM_ITEMS(types), "");
 
     ast_layout_t layout;
     ast_layout_init_with_struct_fields(&layout, names, types, NUM_ITEMS(types));
-    ast_add_composite(ast, strclone("AnyEnumType"), layout, NULL_SOURCE, AST_TYPE_NONE, false);
+    ast_add_composite(ast, "AnyEnumType", layout, NULL_SOURCE, AST_TYPE_NONE, false);
 }
 
 void any_inject_ast___types__(ast_t *ast){
 
     /* __types__ **AnyType */
 
-    ast_type_t type = ast_type_make_base_ptr_ptr(strclone("AnyType"));
+    ast_type_t type = ast_type_make_base_ptr_ptr("AnyType");
 
     ast_add_global(ast, strclone("__types__"), type, NULL, AST_GLOBAL_SPECIAL | AST_GLOBAL___TYPES__, NULL_SOURCE);
 }
@@ -304,7 +304,7 @@ void any_inject_ast___types_length__(ast_t *ast){
 
     /* __types_length__ usize */
 
-    ast_type_t type = ast_type_make_base(strclone("usize"));
+    ast_type_t type = ast_type_make_base("usize");
 
     ast_add_global(ast, strclone("__types_length__"), type, NULL, AST_GLOBAL_SPECIAL | AST_GLOBAL___TYPES_LENGTH__, NULL_SOURCE);
 }
@@ -313,7 +313,7 @@ void any_inject_ast___type_kinds__(ast_t *ast){
 
     /* __type_kinds__ **ubyte */
 
-    ast_type_t type = ast_type_make_base_ptr_ptr(strclone("ubyte"));
+    ast_type_t type = ast_type_make_base_ptr_ptr("ubyte");
 
     ast_add_global(ast, strclone("__type_kinds__"), type, NULL, AST_GLOBAL_SPECIAL | AST_GLOBAL___TYPE_KINDS__, NULL_SOURCE);
 }
@@ -322,7 +322,7 @@ void any_inject_ast___type_kinds_length__(ast_t *ast){
 
     /* __type_kinds_length__ usize */
 
-    ast_type_t type = ast_type_make_base(strclone("usize"));
+    ast_type_t type = ast_type_make_base("usize");
 
     ast_add_global(ast, strclone("__type_kinds_length__"), type, NULL, AST_GLOBAL_SPECIAL | AST_GLOBAL___TYPE_KINDS_LENGTH__, NULL_SOURCE);
 }
@@ -4,7 +4,9 @@
 
 #include "BRIDGE/bridge.h"
 #include "UTIL/ground.h"
+#include "UTIL/hash.h"
 #include "UTIL/levenshtein.h"
+#include "UTIL/set.h"
 
 void bridge_scope_init(bridge_scope_t *out_scope, bridge_scope_t *parent){
     *out_scope = (bridge_scope_t){
@@ -12,7 +14,8 @@ void bridge_scope_init(bridge_scope_t *out_scope, bridge_scope_t *parent){
         .list = (bridge_var_list_t){0},
         .first_var_id = 0,
         .following_var_id = 0,
-        .children = (bridge_scope_ref_list_t){0}
+        .children = (bridge_scope_ref_list_t){0},
+        .by_id = (bridge_var_location_list_t){0},
     };
 }
 
@@ -25,23 +28,96 @@ void bridge_scope_free(bridge_scope_t *scope){
 
     free(scope->list.variables);
     free(scope->children.scopes);
+    set_free(&scope->names, NULL);
+    free(scope->by_id.locations);
+}
 
+static hash_t bridge_var_hash(const void *var){
+    return hash_pointer(((const bridge_var_t*) var)->name);
 }
-bridge_var_t* bridge_scope_find_var(bridge_scope_t *scope, const char *name){
+
+static bool bridge_var_equals(const void *a, const void *b){
+    // Names are interned, so their addresses identify them
+    return ((const bridge_var_t*) a)->name == ((const bridge_var_t*) b)->name;
+}
+
+static void bridge_scope_hash_vars(bridge_scope_t *scope){
+    set_free(&scope->names, NULL);
+    set_init(&scope->names, scope->list.capacity, &bridge_var_hash, &bridge_var_equals, NULL);
+
+    // NOTE: Earlier variables take priority over later ones of the same name
     for(length_t i = 0; i != scope->list.length; i++){
-        if(streq(scope->list.variables[i].name, name)){
-            return &scope->list.variables[i];
-        }
+        set_insert(&scope->names, &scope->list.variables[i]);
     }
+}
 
-    if(scope->parent){
-        return bridge_scope_find_var(scope->parent, name);
-    } else {
-        return NULL;
+static maybe_index_t bridge_scope_var_index(bridge_scope_t *scope, const char *name){
+    // Finds the index of a variable within the variable list of a single scope
+
+    if(scope->list.length >= BRIDGE_SCOPE_HASH_THRESHOLD){
+        bridge_var_t *found = set_find(&scope->names, &(bridge_var_t){ .name = (weak_cstr_t) name });
+        return found ? (maybe_index_t) (found - scope->list.variables) : -1;
+    }
+
+    for(length_t i = 0; i != scope->list.length; i++){
+        if(scope->list.variables[i].name == name) return i;
+    }
+
+    return -1;
+}
+
+bridge_var_t *bridge_scope_add_var(bridge_scope_t *scope, bridge_var_t var){
+    bridge_var_t *previous_variables = scope->list.variables;
+    bridge_var_list_append(&scope->list, var);
+
+    length_t index = scope->list.length - 1;
+
+    if(scope->list.length == BRIDGE_SCOPE_HASH_THRESHOLD || (scope->list.length > BRIDGE_SCOPE_HASH_THRESHOLD && scope->list.variables != previous_variables)){
+        // Start hashing the names of variables in this scope (or re-hash them since they moved)
+        bridge_scope_hash_vars(scope);
+    } else if(scope->list.length > BRIDGE_SCOPE_HASH_THRESHOLD){
+        set_insert(&scope->names, &scope->list.variables[index]);
     }
+
+    if(var.id != INVALID_INDEX_ID){
+        // Record where the variable lives in the root scope
+        bridge_scope_t *root = scope;
+        while(root->parent) root = root->parent;
+
+        while(root->by_id.length <= var.id){
+            bridge_var_location_list_append(&root->by_id, ((bridge_var_location_t){
+                .scope = NULL,
+                .index = 0,
+            }));
+        }
+
+        root->by_id.locations[var.id] = (bridge_var_location_t){
+            .scope = scope,
+            .index = index,
+        };
+    }
+
+    return &scope->list.variables[index];
+}
+
+bridge_var_t* bridge_scope_find_var(bridge_scope_t *scope, const char *name){
+    do {
+        maybe_index_t index = bridge_scope_var_index(scope, name);
+        if(index >= 0) return &scope->list.variables[index];
+    } while((scope = scope->parent));
+
+    return NULL;
 }
 
 bridge_var_t* bridge_scope_find_var_by_id(bridge_scope_t *scope, length_t id){
+    if(scope->parent == NULL){
+        // Root scopes know where all of their variables are
+        if(id >= scope->by_id.length) return NULL;
+
+        bridge_var_location_t location = scope->by_id.locations[id];
+        return location.scope ? &location.scope->list.variables[location.index] : NULL;
+    }
+
     length_t starting_id = scope->first_var_id;
     length_t ending_id = scope->following_var_id;
     length_t count = scope->list.length;
@@ -65,10 +141,7 @@ bridge_var_t* bridge_scope_find_var_by_id(bridge_scope_t *scope, length_t id){
 }
 
 bool bridge_scope_var_already_in_list(bridge_scope_t *scope, const char *name){
-    for(length_t i = 0; i != scope->list.length; i++){
-        if(streq(scope->list.variables[i].name, name)) return true;
-    }
-    return false;
+    return bridge_scope_var_index(scope, name) >= 0;
 }
 
 const char* bridge_scope_var_nearest(bridge_scope_t *scope, const char *name){
@@ -1,8 +1,11 @@
 
 #include "BRIDGE/rtti_collector.h"
+#include "UTIL/threads.h"
 
-void rtti_collector_init(rtti_collector_t *collector){
-    ast_type_set_init(&collector->ast_types_used, 2048);
+static ADEPT_THREAD_LOCAL rtti_collector_mentions_t *deferred_mentions;
+
+void rtti_collector_init(rtti_collector_t *collector, ast_type_table_t *type_table){
+    ast_type_set_init(&collector->ast_types_used, type_table, 256);
 }
 
 void rtti_collector_free(rtti_collector_t *collector){
@@ -10,11 +13,22 @@ void rtti_collector_free(rtti_collector_t *collector){
 }
 
 void rtti_collector_mention(rtti_collector_t *collector, ast_type_t *type){
+    if(deferred_mentions){
+        if(!ast_type_set_contains(&collector->ast_types_used, type)){
+            list_append(deferred_mentions, ast_type_clone(type), ast_type_t);
+        }
+        return;
+    }
+
     ast_type_set_insert(&collector->ast_types_used, type);
 }
 
+void rtti_collector_defer_mentions(rtti_collector_mentions_t *mentions){
+    deferred_mentions = mentions;
+}
+
 bool rtti_collector_mention_base(rtti_collector_t *collector, const char *name){
-    ast_type_t type = ast_type_make_base(strclone(name));
+    ast_type_t type = ast_type_make_base(name);
     bool inserted = ast_type_set_insert(&collector->ast_types_used, &type);
     ast_type_free(&type);
     return inserted;
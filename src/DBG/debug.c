@@ -11,6 +11,8 @@
 #include "DRVR/compiler.h"
 #include "IR/ir_dump.h"
 #include "IR/ir_module.h"
+#include "IRGEN/ir_cache.h"
+#include "IRGEN/ir_gen_parallel.h"
 
 void handle_debug_signal(compiler_t *compiler, unsigned int sig, void *data){
     #define OPTIONAL_NOTIF_MACRO(optional_trait, message) { \
@@ -32,7 +34,34 @@ void handle_debug_signal(compiler_t *compiler, unsigned int sig, void *data){
         if(compiler->debug_traits & COMPILER_DEBUG_DUMP) ast_dump((ast_t*) data, "infer.txt");
         break;
     case DEBUG_SIGNAL_AT_IR_MODULE_DUMP:
-        if(compiler->debug_traits & COMPILER_DEBUG_DUMP) ir_module_dump((ir_module_t*) data, "ir.txt");
+        if(compiler->debug_traits & COMPILER_DEBUG_DUMP){
+            ir_module_t *ir_module = (ir_module_t*) data;
+            ir_module_dump(ir_module, "ir.txt");
+
+            FILE *file = fopen("sf_cache.txt", "w");
+            if(file){
+                ir_gen_sf_cache_dump(file, &ir_module->sf_cache);
+                fclose(file);
+            }
+
+            file = fopen("poly_cache.txt", "w");
+            if(file){
+                ir_gen_poly_cache_dump(file, &ir_module->poly_cache);
+                fclose(file);
+            }
+
+            file = fopen("proc_cache.txt", "w");
+            if(file){
+                ir_gen_proc_cache_dump(file, &ir_module->proc_cache);
+                fclose(file);
+            }
+
+            file = fopen("speculation.txt", "w");
+            if(file){
+                ir_gen_speculation_stats_dump(file, &ir_module->speculation_stats);
+                fclose(file);
+            }
+        }
         break;
     default:
         printf("Unknown debug signal %08X\n", (int) sig);
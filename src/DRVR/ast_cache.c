@@ -0,0 +1,332 @@
+
+#ifdef _WIN32
+    #include <direct.h>
+    #include <process.h>
+
+    #define makedir(a) _mkdir(a)
+    #define getpid() _getpid()
+#else
+    #include <sys/stat.h>
+    #include <unistd.h>
+
+    #define makedir(a) mkdir(a, 0777)
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "AST/ast.h"
+#include "AST/ast_serialize.h"
+#include "DRVR/ast_cache.h"
+#include "DRVR/compiler.h"
+#include "DRVR/object.h"
+#include "LEX/lex.h"
+#include "LEX/token.h"
+#include "UTIL/color.h"
+#include "UTIL/ground.h"
+#include "UTIL/hash.h"
+#include "UTIL/string.h"
+#include "UTIL/trait.h"
+#include "UTIL/util.h"
+
+// ---------------- ast_cache_header_t ----------------
+// Header at the beginning of every cache entry
+// NOTE: Cache entries are only valid for the machine that wrote them,
+// since everything is stored in native byte order
+typedef struct {
+    char magic[8];
+    uint32_t format_version;
+    uint32_t serialize_format_version;
+    uint64_t compiler_version_hash;
+    uint64_t config_hash;
+    uint64_t content_hash;
+    uint64_t content_length;
+    uint64_t records_hash;
+    uint64_t records_length;
+} ast_cache_header_t;
+
+#define AST_CACHE_MAGIC "ADEPTAC\0"
+
+maybe_null_strong_cstr_t ast_cache_default_directory(compiler_t *compiler){
+    if(compiler->root == NULL) return NULL;
+    return mallocandsprintf("%scache/", compiler->root);
+}
+
+uint64_t ast_cache_config_hash(compiler_t *compiler){
+    // NOTE: Must cover everything in 'compiler' that the parser looks at
+    trait_t syntax_traits = compiler->traits & (COMPILER_COLON_COLON | COMPILER_TYPE_COLON);
+
+    hash_t hash = hash_data(&syntax_traits, sizeof syntax_traits);
+    return hash_combine(hash, compiler->entry_point ? hash_string(compiler->entry_point) : 0);
+}
+
+static uint64_t ast_cache_compiler_version_hash(void){
+    return hash_string(ADEPT_VERSION_STRING);
+}
+
+static strong_cstr_t ast_cache_filename(weak_cstr_t directory, uint64_t content_hash, uint64_t config_hash){
+    length_t directory_length = strlen(directory);
+    char final_character = directory_length == 0 ? 0x00 : directory[directory_length - 1];
+    const char *separator = final_character == '/' || final_character == '\\' || directory_length == 0 ? "" : "/";
+
+    char name[32];
+    snprintf(name, sizeof name, "%016llx.ast", (unsigned long long) hash_combine(content_hash, config_hash));
+    return mallocandsprintf("%s%s%s", directory, separator, name);
+}
+
+strong_cstr_t ast_cache_entry_filename(weak_cstr_t directory, uint64_t config_hash, const char *buffer, length_t buffer_length){
+    return ast_cache_filename(directory, hash_data(buffer, buffer_length), config_hash);
+}
+
+static bool ast_cache_read(const ast_cache_entry_t *entry, length_t *inout_position, void *destination, length_t size){
+    // NOTE: Values in cache entries aren't necessarily aligned, so they are always copied out
+    if(size > entry->length - *inout_position) return false;
+
+    memcpy(destination, &entry->records[*inout_position], size);
+    *inout_position += size;
+    return true;
+}
+
+bool ast_cache_entry_next(ast_cache_entry_t *entry, length_t *inout_position, ast_cache_record_t *out_record){
+    // NOTE: The position is only advanced for valid records
+    length_t position = *inout_position;
+    unsigned char kind;
+    uint64_t length;
+
+    if(!ast_cache_read(entry, &position, &kind, sizeof kind)) return false;
+
+    ast_cache_record_t record = (ast_cache_record_t){
+        .kind = kind,
+        .source = NULL_SOURCE,
+    };
+
+    switch(kind){
+    case AST_CACHE_RECORD_DECLARATIONS:
+        break;
+    case AST_CACHE_RECORD_IMPORT: {
+            unsigned char is_standard_library_component;
+            uint64_t index, stride;
+
+            if(!ast_cache_read(entry, &position, &is_standard_library_component, sizeof is_standard_library_component)
+            || !ast_cache_read(entry, &position, &index, sizeof index)
+            || !ast_cache_read(entry, &position, &stride, sizeof stride)){
+                return false;
+            }
+
+            record.is_standard_library_component = is_standard_library_component;
+            record.source.index = index;
+            record.source.stride = stride;
+        }
+        break;
+    default:
+        return false;
+    }
+
+    if(!ast_cache_read(entry, &position, &length, sizeof length)) return false;
+
+    // Imports are followed by a null-terminator
+    uint64_t size = kind == AST_CACHE_RECORD_IMPORT ? length + 1 : length;
+    if(size == 0 || size > entry->length - position) return false;
+
+    record.data = &entry->records[position];
+    record.length = length;
+
+    if(kind == AST_CACHE_RECORD_IMPORT && (record.data[length] != '\0' || memchr(record.data, '\0', length))){
+        return false;
+    }
+
+    *out_record = record;
+    *inout_position = position + size;
+    return true;
+}
+
+bool ast_cache_load(weak_cstr_t directory, uint64_t config_hash, const char *buffer, length_t buffer_length, ast_cache_entry_t *out_entry){
+    uint64_t content_hash = hash_data(buffer, buffer_length);
+    strong_cstr_t filename = ast_cache_filename(directory, content_hash, config_hash);
+
+    char *contents;
+    length_t contents_length;
+    bool exists = file_binary_contents(filename, &contents, &contents_length);
+    free(filename);
+
+    if(!exists) return false;
+
+    ast_cache_header_t header;
+
+    if(contents_length < sizeof header) goto failure;
+    memcpy(&header, contents, sizeof header);
+
+    if(memcmp(header.magic, AST_CACHE_MAGIC, sizeof header.magic) != 0
+    || header.format_version != AST_CACHE_FORMAT_VERSION
+    || header.serialize_format_version != AST_SERIALIZE_FORMAT_VERSION
+    || header.compiler_version_hash != ast_cache_compiler_version_hash()
+    || header.config_hash != config_hash
+    || header.content_hash != content_hash
+    || header.content_length != buffer_length
+    || header.records_length != contents_length - sizeof header
+    || header.records_hash != hash_data(&contents[sizeof header], header.records_length)){
+        goto failure;
+    }
+
+    // Records are kept at the beginning of the allocation so they can be freed normally
+    memmove(contents, &contents[sizeof header], header.records_length);
+
+    ast_cache_entry_t entry = (ast_cache_entry_t){
+        .records = contents,
+        .length = header.records_length,
+        .config_hash = config_hash,
+    };
+
+    // Make sure every record is well-formed before anything uses the entry
+    length_t position = 0;
+    ast_cache_record_t record;
+    while(ast_cache_entry_next(&entry, &position, &record));
+    if(position != entry.length) goto failure;
+
+    *out_entry = entry;
+    return true;
+
+failure:
+    free(contents);
+    return false;
+}
+
+void ast_cache_entry_free(ast_cache_entry_t *entry){
+    free(entry->records);
+    *entry = (ast_cache_entry_t){0};
+}
+
+errorcode_t ast_cache_lex(compiler_t *compiler, object_t *object, weak_cstr_t directory){
+    if(!file_text_contents_mapped(object->filename, &object->buffer, &object->buffer_length, &object->buffer_mapping_size)){
+        redprintf("The file '%s' doesn't exist or can't be accessed\n", object->filename);
+        return FAILURE;
+    }
+
+    return ast_cache_lex_buffer(compiler, object, directory);
+}
+
+errorcode_t ast_cache_lex_buffer(compiler_t *compiler, object_t *object, weak_cstr_t directory){
+    if(!ast_cache_load(directory, ast_cache_config_hash(compiler), object->buffer, object->buffer_length, &object->cached_ast)){
+        return lex_buffer(compiler, object);
+    }
+
+    // The parser will use the cached declarations instead of tokens
+    object->traits |= OBJECT_CACHED;
+    object->tokenlist = (tokenlist_t){0};
+    object->tokenlist.object_index = object->index;
+    object->compilation_stage = COMPILATION_STAGE_TOKENLIST;
+    return SUCCESS;
+}
+
+static void ast_cache_append(ast_cache_recording_t *recording, const void *bytes, length_t size){
+    expand((void**) &recording->records, 1, recording->length, &recording->capacity, size, 4096);
+    memcpy(&recording->records[recording->length], bytes, size);
+    recording->length += size;
+}
+
+static void ast_cache_append_u8(ast_cache_recording_t *recording, unsigned char value){
+    ast_cache_append(recording, &value, sizeof value);
+}
+
+static void ast_cache_append_u64(ast_cache_recording_t *recording, uint64_t value){
+    ast_cache_append(recording, &value, sizeof value);
+}
+
+static void ast_cache_record_declarations(ast_cache_recording_t *recording, ast_t *ast){
+    if(!recording->cacheable) return;
+
+    strong_cstr_t serialized;
+    length_t serialized_length;
+
+    if(ast_serialize_since(ast, &recording->segment_start, &serialized, &serialized_length)){
+        recording->cacheable = false;
+        return;
+    }
+
+    ast_cache_append_u8(recording, AST_CACHE_RECORD_DECLARATIONS);
+    ast_cache_append_u64(recording, serialized_length);
+    ast_cache_append(recording, serialized, serialized_length);
+    free(serialized);
+}
+
+void ast_cache_recording_init(ast_cache_recording_t *recording, ast_t *ast, uint64_t config_hash){
+    *recording = (ast_cache_recording_t){
+        .config_hash = config_hash,
+        .cacheable = true,
+    };
+
+    ast_snapshot(ast, &recording->segment_start);
+}
+
+void ast_cache_record_import(ast_cache_recording_t *recording, ast_t *ast, weak_cstr_t target, bool is_standard_library_component, source_t source){
+    ast_cache_record_declarations(recording, ast);
+    if(!recording->cacheable) return;
+
+    length_t target_length = strlen(target);
+    ast_cache_append_u8(recording, AST_CACHE_RECORD_IMPORT);
+    ast_cache_append_u8(recording, is_standard_library_component);
+    ast_cache_append_u64(recording, source.index);
+    ast_cache_append_u64(recording, source.stride);
+    ast_cache_append_u64(recording, target_length);
+    ast_cache_append(recording, target, target_length + 1);
+}
+
+void ast_cache_record_skip(ast_cache_recording_t *recording, ast_t *ast){
+    ast_snapshot(ast, &recording->segment_start);
+}
+
+static bool ast_cache_write(FILE *file, ast_cache_recording_t *recording, const char *buffer, length_t buffer_length){
+    ast_cache_header_t header = (ast_cache_header_t){
+        .format_version = AST_CACHE_FORMAT_VERSION,
+        .serialize_format_version = AST_SERIALIZE_FORMAT_VERSION,
+        .compiler_version_hash = ast_cache_compiler_version_hash(),
+        .config_hash = recording->config_hash,
+        .content_hash = hash_data(buffer, buffer_length),
+        .content_length = buffer_length,
+        .records_hash = hash_data(recording->records, recording->length),
+        .records_length = recording->length,
+    };
+    memcpy(header.magic, AST_CACHE_MAGIC, sizeof header.magic);
+
+    return fwrite(&header, sizeof header, 1, file) == 1
+        && fwrite(recording->records, 1, recording->length, file) == recording->length;
+}
+
+bool ast_cache_recording_store(ast_cache_recording_t *recording, ast_t *ast, weak_cstr_t directory, const char *buffer, length_t buffer_length){
+    ast_cache_record_declarations(recording, ast);
+    if(!recording->cacheable) return false;
+
+    strong_cstr_t filename = ast_cache_filename(directory, hash_data(buffer, buffer_length), recording->config_hash);
+
+    // Write to a temporary file first, so that other compiler processes never see partial entries
+    char suffix[64];
+    snprintf(suffix, sizeof suffix, ".%d.tmp", (int) getpid());
+    strong_cstr_t temporary_filename = mallocandsprintf("%s%s", filename, suffix);
+    FILE *file = fopen(temporary_filename, "wb");
+
+    if(file == NULL){
+        makedir(directory);
+        file = fopen(temporary_filename, "wb");
+    }
+
+    bool successful = file != NULL && ast_cache_write(file, recording, buffer, buffer_length);
+    if(file != NULL && fclose(file) != 0) successful = false;
+
+    if(successful && rename(temporary_filename, filename) != 0){
+        // Another compiler process might have already created the same entry
+        successful = file_exists(filename);
+    }
+
+    if(file != NULL) remove(temporary_filename);
+
+    free(temporary_filename);
+    free(filename);
+    return successful;
+}
+
+void ast_cache_recording_free(ast_cache_recording_t *recording){
+    free(recording->records);
+}
@@ -25,19 +25,24 @@
 #include "AST/ast_dump.h"
 #include "AST/ast_expr.h"
 #include "AST/ast_poly_catalog.h"
+#include "AST/ast_serialize.h"
 #include "AST/ast_type.h"
+#include "DRVR/ast_cache.h"
 #include "DRVR/compiler.h"
 #include "DRVR/config.h"
 #include "DRVR/object.h"
+#include "DRVR/prefetch.h"
 #include "LEX/lex.h"
 #include "LEX/token.h"
 #include "PARSE/parse.h"
 #include "UTIL/color.h"
 #include "UTIL/filename.h"
 #include "UTIL/ground.h"
+#include "UTIL/intern.h"
 #include "UTIL/string.h"
 #include "UTIL/string_builder.h"
 #include "UTIL/string_list.h"
+#include "UTIL/threads.h"
 #include "UTIL/trait.h"
 #include "UTIL/util.h"
 
@@ -47,6 +52,7 @@
 #include "INFER/infer.h"
 #include "IR/ir_module.h"
 #include "IRGEN/ir_gen.h"
+#include "IRGEN/ir_gen_parallel.h"
 #include "IRGEN/ir_gen_polymorphable.h"
 #endif
 
@@ -54,6 +60,14 @@
 #include "NET/stash.h"
 #endif
 
+// Function bodies that are being speculatively generated give up instead of reporting problems,
+// since they will be generated again (and report them) if they are needed
+#ifndef ADEPT_INSIGHT_BUILD
+#define compiler_speculation_abort() ir_gen_speculation_abort()
+#else
+#define compiler_speculation_abort() false
+#endif
+
 errorcode_t compiler_run(compiler_t *compiler, int argc, char **argv){
     // A wrapper function around 'compiler_invoke'
     compiler_invoke(compiler, argc, argv);
@@ -144,6 +158,8 @@ void compiler_invoke(compiler_t *compiler, int argc, char **argv){
         compiler->config_filename = mallocandsprintf("%sadept.config", compiler->root);
         weak_cstr_t config_warning = NULL;
 
+        // NOTE: Compile servers read the config file for every build too,
+        // so that changes to it take effect without restarting the server
         if(!config_read(&compiler->config, compiler->config_filename, no_update, &config_warning) && config_warning){
             yellowprintf("%s\n", config_warning);
         }
@@ -160,6 +176,10 @@ void compiler_invoke(compiler_t *compiler, int argc, char **argv){
     // Compile / Package the code
     if(compiler_read_file(compiler, object)) return;
 
+    // Lex the files that will be imported ahead of time if we have threads to spare
+    // (compile servers already have them in memory)
+    if(compiler->threads > 1 && compiler->resident == NULL) compiler_prefetch_imports(compiler, object);
+
     if(compiler->traits & COMPILER_INFLATE_PACKAGE){
         // Inflate the package and exit
         #ifndef ADEPT_INSIGHT_BUILD
@@ -180,6 +200,12 @@ void compiler_invoke(compiler_t *compiler, int argc, char **argv){
 
     if(parse(compiler, object)) return;
 
+    if(compiler->traits & COMPILER_MAKE_PACKAGE){
+        // Export the parsed code as a package and exit
+        if(compiler_create_package(compiler, object) == SUCCESS) compiler->result_flags |= COMPILER_RESULT_SUCCESS;
+        return;
+    }
+
     #ifndef ADEPT_INSIGHT_BUILD
     debug_signal(compiler, DEBUG_SIGNAL_AT_AST_DUMP, &object->ast);
     debug_signal(compiler, DEBUG_SIGNAL_AT_INFERENCE, NULL);
@@ -232,6 +258,11 @@ void compiler_init(compiler_t *compiler){
     compiler->objects = malloc(sizeof(object_t*) * 4);
     compiler->objects_length = 0;
     compiler->objects_capacity = 4;
+    compiler->prefetched = (prefetched_files_t){0};
+    compiler->resident = NULL;
+    compiler->imported_files = (string_map_t){0};
+    compiler->import_resolutions = (string_map_t){0};
+    compiler->absolute_filenames = (string_map_t){0};
     config_prepare(&compiler->config, NULL);
     compiler->config_filename = NULL;
     compiler->traits = TRAIT_NONE;
@@ -248,6 +279,8 @@ void compiler_init(compiler_t *compiler){
 
     compiler->use_libm = TROOLEAN_FALSE;
     compiler->extract_import_order = false;
+    compiler->threads = 1;
+    compiler->ast_cache_directory = NULL;
 
     #ifdef ENABLE_DEBUG_FEATURES
     compiler->debug_traits = TRAIT_NONE;
@@ -272,15 +305,32 @@ void compiler_init(compiler_t *compiler){
     compiler->deinit_point = NULL;
 }
 
+static void compiler_free_owned_string_map(string_map_t *map){
+    for(length_t i = 0; i != map->impl.capacity; i++){
+        string_map_entry_t *entry = map->impl.entries[i].data;
+
+        if(entry){
+            free((char*) entry->key);
+            free(entry->value);
+        }
+    }
+
+    string_map_free(map);
+}
+
 void compiler_free(compiler_t *compiler){
     free(compiler->location);
     free(compiler->root);
     free(compiler->output_filename);
+    free(compiler->ast_cache_directory);
     string_builder_abandon(&compiler->user_linker_options);
     strong_cstr_list_free(&compiler->user_search_paths);
     strong_cstr_list_free(&compiler->windows_resources);
 
     compiler_free_objects(compiler);
+    prefetched_files_free(&compiler->prefetched);
+    compiler_free_owned_string_map(&compiler->import_resolutions);
+    compiler_free_owned_string_map(&compiler->absolute_filenames);
     compiler_free_error(compiler);
     compiler_free_warnings(compiler);
     config_free(&compiler->config);
@@ -302,8 +352,14 @@ void compiler_free_objects(compiler_t *compiler){
             free(object->current_namespace);
             // fallthrough
         case COMPILATION_STAGE_TOKENLIST:
-            free(object->buffer);
-            tokenlist_free(&object->tokenlist);
+            // Resident text and tokens belong to the compile server
+            if(!(object->traits & OBJECT_RESIDENT)){
+                file_text_contents_release(object->buffer, object->buffer_mapping_size);
+                free(object->newlines);
+                tokenlist_free(&object->tokenlist);
+            }
+
+            ast_cache_entry_free(&object->cached_ast);
             // fallthrough
         case COMPILATION_STAGE_FILENAME:
             free(object->filename);
@@ -319,6 +375,8 @@ void compiler_free_objects(compiler_t *compiler){
         free(object); // Free memory that the object is stored in
     }
 
+    // Keys were owned by the objects
+    string_map_free(&compiler->imported_files);
     free(compiler->objects);
     
     compiler->objects = NULL;
@@ -498,6 +556,38 @@ errorcode_t parse_arguments(compiler_t *compiler, object_t *object, int argc, ch
                 compiler->use_libm = true;
             } else if(streq(arg, "--libm")){
                 compiler->use_libm = true;
+            } else if(streq(arg, "--threads")){
+                if(arg_index + 1 == argc){
+                    redprintf("Expected thread count after '--threads' flag\n");
+                    return FAILURE;
+                }
+
+                const char *count_text = argv[++arg_index];
+                char *count_end;
+                long count = strtol(count_text, &count_end, 10);
+
+                if(count_text[0] == '\0' || *count_end != '\0' || count < 0){
+                    redprintf("Invalid thread count '%s' for '--threads' flag, expected a non-negative integer\n", count_text);
+                    return FAILURE;
+                }
+
+                // A thread count of 0 means to use all available hardware threads
+                // NOTE: Threads beyond the available hardware threads can't run at the same time,
+                // and only make waves of speculation larger (and more likely to be invalidated)
+                compiler->threads = count > 0 ? length_min((length_t) count, threads_available()) : threads_available();
+            } else if(streq(arg, "--lazy-ir")){
+                compiler->traits |= COMPILER_LAZY_IR;
+            } else if(streq(arg, "--ast-cache")){
+                free(compiler->ast_cache_directory);
+                compiler->ast_cache_directory = ast_cache_default_directory(compiler);
+            } else if(streq(arg, "--ast-cache-dir")){
+                if(arg_index + 1 == argc){
+                    redprintf("Expected directory after '--ast-cache-dir' flag\n");
+                    return FAILURE;
+                }
+
+                free(compiler->ast_cache_directory);
+                compiler->ast_cache_directory = strclone(argv[++arg_index]);
             } else if(streq(arg, "--extract-import-order")){
                 compiler->extract_import_order = true; 
             } else if(strncmp(arg, "-std=", 5) == 0){
@@ -741,6 +831,8 @@ void show_help(bool show_advanced_options){
         printf("    -I<PATH>          Add directory to import search path\n");
         printf("    -L<PATH>          Add directory to native library search path\n");
         printf("    -l<LIBRARY>       Link against native library\n");
+        printf("    -p, --package     Emit precompiled package (.dep) instead of executable\n");
+        printf("    -i, --inflate     Dump the contents of a package to a text file (.idep)\n");
     }
     
     printf("    -O0,-O1,-O2,-O3   Set optimization level\n");
@@ -763,6 +855,17 @@ void show_help(bool show_advanced_options){
         printf("    --null-checks     Enable runtime null-checks\n");
         printf("    --entry           Set the entry point of the program\n");
 
+        printf("\nPerformance Options:\n");
+        printf("    --threads N       Use up to N threads for parallel compilation stages (0 for all)\n");
+        printf("    --lazy-ir         Only generate functions reachable from the entry point and exports\n");
+        printf("    --ast-cache       Cache the declarations of parsed files in the compiler's root folder\n");
+        printf("    --ast-cache-dir DIRECTORY\n");
+        printf("                      Cache the declarations of parsed files in DIRECTORY\n");
+        printf("    --server SOCKET   Run as a compile server listening on SOCKET (must be first)\n");
+        printf("    --connect SOCKET  Compile using the compile server on SOCKET (must be first)\n");
+        printf("    --connect SOCKET --stop-server\n");
+        printf("                      Stop the compile server on SOCKET\n");
+
         printf("\nMachine Code Options:\n");
         printf("    --PIC             Forces PIC relocation model\n");
         printf("    --no-PIC          Forbids PIC relocation model\n");
@@ -879,19 +982,147 @@ void compiler_add_user_search_path(compiler_t *compiler, weak_cstr_t search_path
 }
 
 errorcode_t compiler_create_package(compiler_t *compiler, object_t *object){
-    (void) compiler;
-    
-    object_panic_plain(object, "Exporting compressed package is no longer supported");
-    return FAILURE;
+    // Package Layout:
+    //     "ADEPTPKG"
+    //     u32 number of packaged files
+    //     (u32 length, bytes) absolute filename of each packaged file
+    //     serialized AST
+
+    strong_cstr_t ast_buffer;
+    length_t ast_buffer_length;
+
+    if(ast_serialize(&object->ast, &ast_buffer, &ast_buffer_length)){
+        object_panic_plain(object, "Failed to serialize package");
+        return FAILURE;
+    }
+
+    strong_cstr_t package_filename;
+
+    if(compiler->output_filename){
+        package_filename = strclone(compiler->output_filename);
+        filename_auto_ext(&package_filename, compiler->cross_compile_for, FILENAME_AUTO_PACKAGE, false);
+    } else {
+        package_filename = filename_ext(object->filename, "dep");
+    }
+
+    FILE *file = fopen(package_filename, "wb");
+
+    if(file == NULL){
+        redprintf("Failed to create package file '%s'\n", package_filename);
+        free(package_filename);
+        free(ast_buffer);
+        return FAILURE;
+    }
+
+    uint32_t files_length = compiler->objects_length;
+    bool failed = fwrite(COMPILER_PACKAGE_MAGIC, 8, 1, file) != 1 || fwrite(&files_length, sizeof files_length, 1, file) != 1;
+
+    for(length_t i = 0; i != compiler->objects_length && !failed; i++){
+        weak_cstr_t full_filename = compiler->objects[i]->full_filename;
+        uint32_t full_filename_length = strlen(full_filename);
+
+        failed = fwrite(&full_filename_length, sizeof full_filename_length, 1, file) != 1
+              || fwrite(full_filename, 1, full_filename_length, file) != full_filename_length;
+    }
+
+    failed = failed || fwrite(ast_buffer, 1, ast_buffer_length, file) != ast_buffer_length;
+    failed = fclose(file) != 0 || failed;
+    free(ast_buffer);
+
+    if(failed){
+        redprintf("Failed to write package file '%s'\n", package_filename);
+        free(package_filename);
+        return FAILURE;
+    }
+
+    free(package_filename);
+    return SUCCESS;
 }
 
-errorcode_t compiler_read_file(compiler_t *compiler, object_t *object){
-    length_t filename_length = strlen(object->filename);
+errorcode_t compiler_import_package(compiler_t *compiler, object_t *object, ast_t *ast){
+    const char *buffer = object->buffer;
+    length_t length = object->buffer_length;
+    length_t position = 8 + sizeof(uint32_t);
+    uint32_t files_length;
+
+    if(length < position || memcmp(buffer, COMPILER_PACKAGE_MAGIC, 8) != 0){
+        object_panic_plain(object, "Not a valid package");
+        return FAILURE;
+    }
+
+    memcpy(&files_length, &buffer[8], sizeof files_length);
+
+    for(uint32_t i = 0; i != files_length; i++){
+        uint32_t full_filename_length;
+
+        if(length - position < sizeof full_filename_length){
+            object_panic_plain(object, "Not a valid package");
+            return FAILURE;
+        }
+
+        memcpy(&full_filename_length, &buffer[position], sizeof full_filename_length);
+        position += sizeof full_filename_length;
 
-    if(filename_length >= 4 && streq(&object->filename[filename_length - 4], ".dep")){
-        object_panic_plain(object, "Importing compressed package is no longer supported");
+        if(length - position < full_filename_length){
+            object_panic_plain(object, "Not a valid package");
+            return FAILURE;
+        }
+
+        // Files that make up the package are already included by it,
+        // so importing them again later is a no-op
+        weak_cstr_t full_filename = arena_strndup(&object->tokenlist.payloads, &buffer[position], full_filename_length);
+        position += full_filename_length;
+
+        if(!string_map_has(&compiler->imported_files, full_filename)){
+            string_map_insert(&compiler->imported_files, full_filename, object);
+        }
+    }
+
+    if(ast_deserialize(ast, &buffer[position], length - position, &object->tokenlist.payloads, object->index)){
+        object_panic_plain(object, "Package was made with a different version of the compiler or is corrupted");
         return FAILURE;
+    }
+
+    return SUCCESS;
+}
+
+errorcode_t compiler_read_file(compiler_t *compiler, object_t *object){
+    if(filename_is_package(object->filename)){
+        string_map_insert(&compiler->imported_files, object->full_filename, object);
+
+        if(!file_binary_contents(object->filename, &object->buffer, &object->buffer_length)){
+            object_panic_plain(object, "Failed to read package");
+            return FAILURE;
+        }
+
+        // Packages are imported whole by the parser instead of being lexed
+        object->buffer_mapping_size = 0;
+        object->traits |= OBJECT_PACKAGE;
+        object->tokenlist = (tokenlist_t){0};
+        object->tokenlist.object_index = object->index;
+        object->compilation_stage = COMPILATION_STAGE_TOKENLIST;
+        return SUCCESS;
     } else {
+        string_map_insert(&compiler->imported_files, object->full_filename, object);
+
+        // Use the tokens from the previous build if this file hasn't changed since
+        if(compiler->resident) return resident_lex(compiler, object, compiler->resident);
+
+        // Use the tokens (or cached declarations) from before if this file was prefetched
+        if(prefetched_files_take(&compiler->prefetched, object)){
+            // Cached declarations can't be used if parsing settings changed since
+            if(object->traits & OBJECT_CACHED && object->cached_ast.config_hash != ast_cache_config_hash(compiler)){
+                ast_cache_entry_free(&object->cached_ast);
+                object->traits &= ~OBJECT_CACHED;
+                return lex_buffer(compiler, object);
+            }
+
+            return SUCCESS;
+        }
+
+        // Use the declarations from a previous build if this file hasn't changed
+        if(compiler->ast_cache_directory) return ast_cache_lex(compiler, object, compiler->ast_cache_directory);
+
         return lex(compiler, object);
     }
 }
@@ -921,10 +1152,7 @@ void compiler_print_source(compiler_t *compiler, int line, source_t source){
         return;
     }
 
-    length_t line_index = 0;
-    for(int current_line = 1; current_line != line; line_index++){
-        if(relevant_object->buffer[line_index] == '\n') current_line++;
-    }
+    length_t line_index = object_line_start(relevant_object, line);
 
     char prefix[128];
     snprintf(prefix, sizeof prefix, "  %d| ", line);
@@ -956,6 +1184,8 @@ void compiler_print_source(compiler_t *compiler, int line, source_t source){
 }
 
 void compiler_panic(compiler_t *compiler, source_t source, const char *message){
+    if(compiler_speculation_abort()) return;
+
     #if !defined(ADEPT_INSIGHT_BUILD) || defined(__EMSCRIPTEN__)
     object_t *relevant_object = compiler->objects[source.object_index];
     int line, column;
@@ -965,7 +1195,7 @@ void compiler_panic(compiler_t *compiler, source_t source, const char *message){
             printf("%s:?:?:", filename_name_const(relevant_object->filename));
             redprintf(" error:\n");
         } else {
-            lex_get_location(relevant_object->buffer, source.index, &line, &column);
+            object_get_location(relevant_object, source.index, &line, &column);
             printf("%s:%d:%d:", filename_name_const(relevant_object->filename), line, column);
             redprintf(" error:\n");
             compiler_print_source(compiler, line, source);
@@ -978,7 +1208,7 @@ void compiler_panic(compiler_t *compiler, source_t source, const char *message){
         redprintf("error: ");
         printf("%s\n", message);
     } else {
-        lex_get_location(relevant_object->buffer, source.index, &line, &column);
+        object_get_location(relevant_object, source.index, &line, &column);
         printf("%s:%d:%d: ", filename_name_const(relevant_object->filename), line, column);
         redprintf("error: ");
         printf("%s\n", message);
@@ -999,6 +1229,8 @@ void compiler_panicf(compiler_t *compiler, source_t source, const char *format,
 }
 
 void compiler_vpanicf(compiler_t *compiler, source_t source, const char *format, va_list args){
+    if(compiler_speculation_abort()) return;
+
     #if !defined(ADEPT_INSIGHT_BUILD) || defined(__EMSCRIPTEN__)
     object_t *relevant_object = compiler->objects[source.object_index];
     int line, column;
@@ -1014,7 +1246,7 @@ void compiler_vpanicf(compiler_t *compiler, source_t source, const char *format,
             printf("%s:?:?: ", filename_name_const(relevant_object->filename));
             redprintf("error: \n");
         } else {
-            lex_get_location(relevant_object->buffer, source.index, &line, &column);
+            object_get_location(relevant_object, source.index, &line, &column);
             printf("%s:%d:%d: ", filename_name_const(relevant_object->filename), line, column);
             redprintf("error: \n");
             compiler_print_source(compiler, line, source);
@@ -1027,7 +1259,7 @@ void compiler_vpanicf(compiler_t *compiler, source_t source, const char *format,
         column = 1;
         printf("%s:?:?: ", filename_name_const(relevant_object->filename));
     } else {
-        lex_get_location(relevant_object->buffer, source.index, &line, &column);
+        object_get_location(relevant_object, source.index, &line, &column);
         printf("%s:%d:%d: ", filename_name_const(relevant_object->filename), line, column);
     }
 
@@ -1051,6 +1283,7 @@ bool compiler_warn(compiler_t *compiler, source_t source, const char *message){
     // Returns whether program should exit
 
     if(compiler->traits & COMPILER_NO_WARN) return false;
+    if(compiler_speculation_abort()) return true;
 
     #if !defined(ADEPT_INSIGHT_BUILD) || defined(__EMSCRIPTEN__)
     if(compiler->traits & COMPILER_WARN_AS_ERROR){
@@ -1060,8 +1293,16 @@ bool compiler_warn(compiler_t *compiler, source_t source, const char *message){
     
     object_t *relevant_object = compiler->objects[source.object_index];
     int line, column;
-    lex_get_location(relevant_object->buffer, source.index, &line, &column);
-    printf("%s:%d:%d: ", filename_name_const(relevant_object->filename), line, column);
+
+    if(relevant_object->traits & OBJECT_PACKAGE){
+        line = 1;
+        column = 1;
+        printf("%s:?:?: ", filename_name_const(relevant_object->filename));
+    } else {
+        object_get_location(relevant_object, source.index, &line, &column);
+        printf("%s:%d:%d: ", filename_name_const(relevant_object->filename), line, column);
+    }
+
     yellowprintf("warning: ");
     printf("%s\n", message);
 
@@ -1076,6 +1317,7 @@ bool compiler_warn(compiler_t *compiler, source_t source, const char *message){
 
 bool compiler_warnf(compiler_t *compiler, source_t source, const char *format, ...){
     if(compiler->traits & COMPILER_NO_WARN) return false;
+    if(compiler_speculation_abort()) return true;
     
     va_list args;
     va_start(args, format);
@@ -1094,6 +1336,7 @@ bool compiler_warnf(compiler_t *compiler, source_t source, const char *format, .
 
 void compiler_vwarnf(compiler_t *compiler, source_t source, const char *format, va_list args){
     if(compiler->traits & COMPILER_NO_WARN) return;
+    if(compiler_speculation_abort()) return;
 
     #if !defined(ADEPT_INSIGHT_BUILD) || defined(__EMSCRIPTEN__)
     object_t *relevant_object = compiler->objects[source.object_index];
@@ -1110,7 +1353,7 @@ void compiler_vwarnf(compiler_t *compiler, source_t source, const char *format,
         column = 1;
         printf("%s:?:?: ", filename_name_const(relevant_object->filename));
     } else {
-        lex_get_location(relevant_object->buffer, source.index, &line, &column);
+        object_get_location(relevant_object, source.index, &line, &column);
         printf("%s:%d:%d: ", filename_name_const(relevant_object->filename), line, column);
     }
 
@@ -1132,6 +1375,8 @@ void compiler_vwarnf(compiler_t *compiler, source_t source, const char *format,
 #if !defined(ADEPT_INSIGHT_BUILD) || defined(__EMSCRIPTEN__)
 void compiler_undeclared_function(compiler_t *compiler, object_t *object, source_t source,
         weak_cstr_t name, ast_type_t *types, length_t arity, ast_type_t *gives, bool is_method){
+
+    if(compiler_speculation_abort()) return;
     
     // Allow for '.elements_length' to be zero to indicate no return matching
     if(gives && gives->elements_length == 0) gives = NULL;
@@ -1,5 +1,6 @@
 
 #include "DRVR/object.h"
+#include "LEX/lex.h"
 
 void object_init_ast(object_t *object, unsigned int cross_compile_for){
     ast_init(&object->ast, cross_compile_for);
@@ -18,3 +19,47 @@ void object_create_module(object_t *object){
     object->compilation_stage = COMPILATION_STAGE_IR_MODULE;
 }
 #endif
+
+void object_get_location(object_t *object, length_t index, int *line, int *column){
+    if(object->traits & OBJECT_PACKAGE){
+        *line = 1;
+        *column = 1;
+        return;
+    }
+
+    if(object->newlines == NULL){
+        lex_get_location(object->buffer, index, line, column);
+        return;
+    }
+
+    // Find the number of newlines before 'index'
+    length_t low = 0;
+    length_t high = object->newlines_length;
+
+    while(low != high){
+        length_t middle = low + (high - low) / 2;
+
+        if(object->newlines[middle] < index){
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    *line = 1 + (int) low;
+    *column = low != 0 ? (int)(index - object->newlines[low - 1]) : (int) index + 1;
+}
+
+length_t object_line_start(object_t *object, int line){
+    if(line <= 1) return 0;
+
+    if(object->newlines != NULL){
+        return (length_t) line - 2 < object->newlines_length ? object->newlines[line - 2] + 1 : object->buffer_length;
+    }
+
+    length_t index = 0;
+    for(int current_line = 1; current_line != line; index++){
+        if(object->buffer[index] == '\n') current_line++;
+    }
+    return index;
+}
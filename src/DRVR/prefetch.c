@@ -0,0 +1,314 @@
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "DRVR/ast_cache.h"
+#include "DRVR/compiler.h"
+#include "DRVR/object.h"
+#include "DRVR/prefetch.h"
+#include "LEX/lex.h"
+#include "LEX/token.h"
+#include "PARSE/parse_dependency.h"
+#include "TOKEN/token_data.h"
+#include "UTIL/filename.h"
+#include "UTIL/ground.h"
+#include "UTIL/list.h"
+#include "UTIL/string.h"
+#include "UTIL/string_builder.h"
+#include "UTIL/string_map.h"
+#include "UTIL/threads.h"
+#include "UTIL/util.h"
+
+typedef struct {
+    compiler_t *compiler;
+    prefetched_files_t *prefetched;
+
+    // Best guess at what 'compiler->default_stdlib' will be while parsing
+    maybe_null_weak_cstr_t default_stdlib;
+
+    // Absolute filenames of files that have been discovered
+    string_map_t known;
+} prefetch_ctx_t;
+
+typedef struct {
+    prefetched_files_t *prefetched;
+    length_t first;
+    maybe_null_weak_cstr_t ast_cache_directory;
+    uint64_t ast_cache_config_hash;
+} prefetch_wave_t;
+
+static void prefetch_add(prefetch_ctx_t *ctx, weak_cstr_t current_filename, weak_cstr_t filename, bool allow_local){
+    maybe_null_strong_cstr_t target = parse_find_import_quietly(ctx->compiler, current_filename, filename, allow_local);
+    if(target == NULL) return;
+
+    // Packages aren't lexed, so there's nothing to prefetch
+    if(filename_is_package(target)){
+        free(target);
+        return;
+    }
+
+    maybe_null_strong_cstr_t absolute = parse_resolve_import_quietly(ctx->compiler, target);
+
+    if(absolute == NULL || string_map_has(&ctx->known, absolute)){
+        free(target);
+        free(absolute);
+        return;
+    }
+
+    string_map_insert(&ctx->known, absolute, NULL);
+
+    list_append(ctx->prefetched, ((prefetched_file_t){
+        .filename = target,
+        .full_filename = absolute,
+        .buffer = NULL,
+        .buffer_length = 0,
+        .buffer_mapping_size = 0,
+        .newlines = NULL,
+        .newlines_length = 0,
+        .tokenlist = (tokenlist_t){0},
+        .cached_ast = (ast_cache_entry_t){0},
+        .lexed = false,
+        .taken = false,
+    }), prefetched_file_t);
+}
+
+static maybe_null_weak_cstr_t prefetch_string_at(tokenlist_t *tokenlist, length_t i){
+    if(i >= tokenlist->length) return NULL;
+
+    tokenid_t id = tokenlist->ids[i];
+    if(id != TOKEN_STRING && id != TOKEN_CSTRING) return NULL;
+
+    return ((token_string_data_t*) tokenlist_data(tokenlist, i))->array;
+}
+
+static maybe_null_strong_cstr_t prefetch_stdlib_component_at(tokenlist_t *tokenlist, length_t i, weak_cstr_t stdlib){
+    // Mirrors 'parse_standard_library_component'
+    if(i >= tokenlist->length || tokenlist->ids[i] != TOKEN_WORD) return NULL;
+
+    string_builder_t builder;
+    string_builder_init(&builder);
+    string_builder_append(&builder, stdlib);
+
+    length_t stdlib_length = strlen(stdlib);
+    char final_character = stdlib_length == 0 ? 0x00 : stdlib[stdlib_length - 1];
+    if(final_character != '/' && final_character != '\\') string_builder_append_char(&builder, '/');
+
+    string_builder_append(&builder, tokenlist_data(tokenlist, i));
+
+    while(i + 2 < tokenlist->length && tokenlist->ids[i + 1] == TOKEN_DIVIDE && tokenlist->ids[i + 2] == TOKEN_WORD){
+        string_builder_append_char(&builder, '/');
+        string_builder_append(&builder, tokenlist_data(tokenlist, i + 2));
+        i += 2;
+    }
+
+    string_builder_append(&builder, ".adept");
+    return string_builder_finalize(&builder);
+}
+
+static void prefetch_scan(prefetch_ctx_t *ctx, weak_cstr_t current_filename, tokenlist_t *tokenlist, bool is_root){
+    // Finds imports in a tokenlist without parsing it, in the same order that parsing would
+
+    tokenid_t *ids = tokenlist->ids;
+    maybe_null_weak_cstr_t object_default_stdlib = NULL;
+    bool force_stdlib = ctx->compiler->traits & COMPILER_FORCE_STDLIB;
+
+    for(length_t i = 0; i + 1 < tokenlist->length; i++){
+        tokenid_t id = ids[i];
+
+        if(id == TOKEN_PRAGMA && ids[i + 1] == TOKEN_WORD){
+            weak_cstr_t directive = tokenlist_data(tokenlist, i + 1);
+            maybe_null_weak_cstr_t value = prefetch_string_at(tokenlist, i + 2);
+            if(value == NULL || force_stdlib) continue;
+
+            if(streq(directive, "default_stdlib")){
+                object_default_stdlib = value;
+                if(is_root) ctx->default_stdlib = value;
+            } else if(ctx->default_stdlib == NULL && streq(directive, "compiler_version")){
+                ctx->default_stdlib = value;
+            }
+            continue;
+        }
+
+        bool is_import = id == TOKEN_IMPORT;
+        bool is_meta_import = id == TOKEN_META && streq(tokenlist_data(tokenlist, i), "import");
+        if(!is_import && !is_meta_import) continue;
+
+        maybe_null_weak_cstr_t local_filename = prefetch_string_at(tokenlist, i + 1);
+
+        // '#import' takes a meta expression, so only predict it when it's a lone string
+        if(is_meta_import && local_filename && (i + 2 >= tokenlist->length || ids[i + 2] != TOKEN_NEWLINE)){
+            continue;
+        }
+
+        if(local_filename){
+            prefetch_add(ctx, current_filename, local_filename, true);
+            continue;
+        }
+
+        // Standard library components look like 'import a/b/c' and '#import <a/b/c>'
+        length_t component_start = is_meta_import && ids[i + 1] == TOKEN_LESSTHAN ? i + 2 : i + 1;
+        weak_cstr_t stdlib = object_default_stdlib ? object_default_stdlib : ctx->default_stdlib ? ctx->default_stdlib : ADEPT_VERSION_STRING;
+        maybe_null_strong_cstr_t component_filename = prefetch_stdlib_component_at(tokenlist, component_start, stdlib);
+
+        if(component_filename){
+            prefetch_add(ctx, current_filename, component_filename, false);
+            free(component_filename);
+        }
+    }
+}
+
+static void prefetch_scan_cached(prefetch_ctx_t *ctx, weak_cstr_t current_filename, ast_cache_entry_t *entry){
+    // Finds imports in the AST cache entry of a file
+    // NOTE: Files with pragmas are never cached, so only the default standard library matters
+
+    length_t position = 0;
+    ast_cache_record_t record;
+
+    while(ast_cache_entry_next(entry, &position, &record)){
+        if(record.kind != AST_CACHE_RECORD_IMPORT) continue;
+
+        if(!record.is_standard_library_component){
+            prefetch_add(ctx, current_filename, record.data, true);
+            continue;
+        }
+
+        weak_cstr_t stdlib = ctx->default_stdlib ? ctx->default_stdlib : ADEPT_VERSION_STRING;
+        length_t stdlib_length = strlen(stdlib);
+        char final_character = stdlib_length == 0 ? 0x00 : stdlib[stdlib_length - 1];
+        bool append_slash = final_character != '/' && final_character != '\\';
+
+        strong_cstr_t component_filename = mallocandsprintf(append_slash ? "%s/%s.adept" : "%s%s.adept", stdlib, record.data);
+        prefetch_add(ctx, current_filename, component_filename, false);
+        free(component_filename);
+    }
+}
+
+static void prefetch_lex_task(length_t task_index, void *user_data){
+    prefetch_wave_t *wave = (prefetch_wave_t*) user_data;
+    prefetched_file_t *file = &wave->prefetched->files[wave->first + task_index];
+
+    // Temporary object to lex into, sources will be fixed up once the file is taken
+    object_t temporary = {
+        .filename = file->filename,
+        .full_filename = file->full_filename,
+        .index = 0,
+    };
+
+    if(!file_text_contents_mapped(file->filename, &temporary.buffer, &temporary.buffer_length, &temporary.buffer_mapping_size)) return;
+
+    maybe_null_weak_cstr_t ast_cache_directory = wave->ast_cache_directory;
+
+    if(ast_cache_directory && ast_cache_load(ast_cache_directory, wave->ast_cache_config_hash, temporary.buffer, temporary.buffer_length, &file->cached_ast)){
+        // Cached files don't need to be lexed
+    } else if(lex_buffer(NULL, &temporary)){
+        // Lex quietly, if it fails then lexing will be redone later when errors can be reported
+        file_text_contents_release(temporary.buffer, temporary.buffer_mapping_size);
+        return;
+    }
+
+    file->buffer = temporary.buffer;
+    file->buffer_length = temporary.buffer_length;
+    file->buffer_mapping_size = temporary.buffer_mapping_size;
+    file->newlines = temporary.newlines;
+    file->newlines_length = temporary.newlines_length;
+    file->tokenlist = temporary.tokenlist;
+    file->lexed = true;
+}
+
+void compiler_prefetch_imports(compiler_t *compiler, object_t *root_object){
+    prefetch_ctx_t ctx = {
+        .compiler = compiler,
+        .prefetched = &compiler->prefetched,
+        .default_stdlib = compiler->default_stdlib,
+    };
+
+    string_map_insert(&ctx.known, root_object->full_filename, NULL);
+
+    if(root_object->traits & OBJECT_CACHED){
+        prefetch_scan_cached(&ctx, root_object->filename, &root_object->cached_ast);
+    } else {
+        prefetch_scan(&ctx, root_object->filename, &root_object->tokenlist, true);
+    }
+
+    // Lex one layer of the import graph at a time, discovering the next layer as we go
+    length_t wave_start = 0;
+
+    while(wave_start != ctx.prefetched->length){
+        length_t wave_end = ctx.prefetched->length;
+
+        prefetch_wave_t wave = {
+            .prefetched = ctx.prefetched,
+            .first = wave_start,
+            .ast_cache_directory = compiler->ast_cache_directory,
+            .ast_cache_config_hash = ast_cache_config_hash(compiler),
+        };
+
+        parallel_for(wave_end - wave_start, compiler->threads, prefetch_lex_task, &wave);
+
+        for(length_t i = wave_start; i != wave_end; i++){
+            // NOTE: Copied since 'prefetch_scan' may grow the list
+            prefetched_file_t file = ctx.prefetched->files[i];
+
+            if(file.lexed && file.cached_ast.records){
+                prefetch_scan_cached(&ctx, file.filename, &file.cached_ast);
+            } else if(file.lexed){
+                prefetch_scan(&ctx, file.filename, &file.tokenlist, false);
+            }
+        }
+
+        wave_start = wave_end;
+    }
+
+    string_map_free(&ctx.known);
+
+    // Now that the list won't move anymore, index it for when files are taken
+    for(length_t i = 0; i != ctx.prefetched->length; i++){
+        prefetched_file_t *file = &ctx.prefetched->files[i];
+        if(file->lexed) string_map_insert(&ctx.prefetched->lookup, file->full_filename, file);
+    }
+}
+
+bool prefetched_files_take(prefetched_files_t *prefetched, object_t *object){
+    prefetched_file_t *file = string_map_find(&prefetched->lookup, object->full_filename);
+    if(file == NULL || file->taken) return false;
+
+    object->buffer = file->buffer;
+    object->buffer_length = file->buffer_length;
+    object->buffer_mapping_size = file->buffer_mapping_size;
+    object->newlines = file->newlines;
+    object->newlines_length = file->newlines_length;
+    object->tokenlist = file->tokenlist;
+    object->cached_ast = file->cached_ast;
+    object->compilation_stage = COMPILATION_STAGE_TOKENLIST;
+
+    object->tokenlist.object_index = object->index;
+    if(object->cached_ast.records) object->traits |= OBJECT_CACHED;
+
+    file->buffer = NULL;
+    file->newlines = NULL;
+    file->tokenlist = (tokenlist_t){0};
+    file->cached_ast = (ast_cache_entry_t){0};
+    file->taken = true;
+    return true;
+}
+
+void prefetched_files_free(prefetched_files_t *prefetched){
+    for(length_t i = 0; i != prefetched->length; i++){
+        prefetched_file_t *file = &prefetched->files[i];
+
+        if(file->lexed && !file->taken){
+            file_text_contents_release(file->buffer, file->buffer_mapping_size);
+            free(file->newlines);
+            tokenlist_free(&file->tokenlist);
+            ast_cache_entry_free(&file->cached_ast);
+        }
+
+        free(file->filename);
+        free(file->full_filename);
+    }
+
+    free(prefetched->files);
+    string_map_free(&prefetched->lookup);
+    *prefetched = (prefetched_files_t){0};
+}
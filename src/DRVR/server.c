@@ -0,0 +1,436 @@
+
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define ADEPT_CAN_SERVE 1
+#else
+#define ADEPT_CAN_SERVE 0
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "DRVR/compiler.h"
+#include "DRVR/object.h"
+#include "DRVR/server.h"
+#include "LEX/lex.h"
+#include "LEX/token.h"
+#include "UTIL/color.h"
+#include "UTIL/ground.h"
+#include "UTIL/string.h"
+#include "UTIL/string_map.h"
+#include "UTIL/util.h"
+
+/*
+    Protocol
+
+    Request (client -> server):
+        u32 length + bytes  compiler version of the client
+        u32 length + bytes  working directory of the client
+        u32                 number of arguments
+        u32 length + bytes  each argument
+
+    Response (server -> client):
+        u32                 exit code
+        u64                 length of output
+        bytes               everything the compiler printed
+
+    Integers are in native byte order, since both sides are on the same machine.
+    The special argument '--stop-server' stops the server after responding.
+*/
+
+#define SERVER_MAX_ARGUMENTS 4096
+#define SERVER_MAX_STRING_LENGTH (1024 * 1024)
+
+static void resident_file_release(resident_file_t *file){
+    free(file->buffer);
+    free(file->newlines);
+    tokenlist_free(&file->tokenlist);
+}
+
+void resident_free(resident_t *resident){
+    for(length_t i = 0; i != resident->files.impl.capacity; i++){
+        string_map_entry_t *entry = resident->files.impl.entries[i].data;
+        if(entry == NULL) continue;
+
+        resident_file_t *file = entry->value;
+
+        resident_file_release(file);
+        free(file->full_filename);
+        free(file);
+    }
+
+    string_map_free(&resident->files);
+}
+
+static void resident_lend(resident_file_t *file, object_t *object){
+    object->buffer = file->buffer;
+    object->buffer_length = file->buffer_length;
+    object->buffer_mapping_size = 0;
+    object->newlines = file->newlines;
+    object->newlines_length = file->newlines_length;
+    object->tokenlist = file->tokenlist;
+    object->tokenlist.object_index = object->index;
+    object->compilation_stage = COMPILATION_STAGE_TOKENLIST;
+    object->traits |= OBJECT_RESIDENT;
+}
+
+errorcode_t resident_lex(compiler_t *compiler, object_t *object, resident_t *resident){
+    // NOTE: Resident buffers are never memory-mapped, since mapped
+    // contents would change along with the file
+    strong_cstr_t buffer;
+    length_t buffer_length;
+
+    if(!file_text_contents(object->filename, &buffer, &buffer_length, true)){
+        redprintf("The file '%s' doesn't exist or can't be accessed\n", object->filename);
+        return FAILURE;
+    }
+
+    resident_file_t *file = string_map_find(&resident->files, object->full_filename);
+
+    // Reuse the tokens from the previous build if the file hasn't changed
+    if(file && file->buffer_length == buffer_length && memcmp(file->buffer, buffer, buffer_length) == 0){
+        free(buffer);
+        resident_lend(file, object);
+        resident->hits++;
+        return SUCCESS;
+    }
+
+    object->buffer = buffer;
+    object->buffer_length = buffer_length;
+    object->buffer_mapping_size = 0;
+
+    if(lex_buffer(compiler, object)) return FAILURE;
+
+    if(file){
+        resident_file_release(file);
+    } else {
+        file = malloc(sizeof(resident_file_t));
+        file->full_filename = strclone(object->full_filename);
+        string_map_insert(&resident->files, file->full_filename, file);
+    }
+
+    // Keep the newly lexed file for later builds
+    file->buffer = object->buffer;
+    file->buffer_length = object->buffer_length;
+    file->newlines = object->newlines;
+    file->newlines_length = object->newlines_length;
+    file->tokenlist = object->tokenlist;
+
+    resident_lend(file, object);
+    resident->misses++;
+    return SUCCESS;
+}
+
+#if ADEPT_CAN_SERVE
+
+static bool server_write(int fd, const void *data, length_t size){
+    const char *bytes = data;
+
+    while(size != 0){
+        ssize_t written = write(fd, bytes, size);
+        if(written <= 0) return false;
+
+        bytes += written;
+        size -= written;
+    }
+
+    return true;
+}
+
+static bool server_read(int fd, void *data, length_t size){
+    char *bytes = data;
+
+    while(size != 0){
+        ssize_t amount = read(fd, bytes, size);
+        if(amount <= 0) return false;
+
+        bytes += amount;
+        size -= amount;
+    }
+
+    return true;
+}
+
+static bool server_write_string(int fd, const char *string){
+    uint32_t length = strlen(string);
+    return server_write(fd, &length, sizeof length) && server_write(fd, string, length);
+}
+
+static maybe_null_strong_cstr_t server_read_string(int fd){
+    uint32_t length;
+    if(!server_read(fd, &length, sizeof length) || length > SERVER_MAX_STRING_LENGTH) return NULL;
+
+    strong_cstr_t string = malloc(length + 1);
+
+    if(!server_read(fd, string, length)){
+        free(string);
+        return NULL;
+    }
+
+    string[length] = '\0';
+    return string;
+}
+
+static bool server_respond(int fd, uint32_t exitcode, const char *output, uint64_t output_length){
+    return server_write(fd, &exitcode, sizeof exitcode)
+        && server_write(fd, &output_length, sizeof output_length)
+        && server_write(fd, output, output_length);
+}
+
+static bool server_address(weak_cstr_t socket_path, struct sockaddr_un *out_address){
+    memset(out_address, 0, sizeof *out_address);
+    out_address->sun_family = AF_UNIX;
+
+    if(strlen(socket_path) >= sizeof out_address->sun_path){
+        redprintf("Socket path '%s' is too long\n", socket_path);
+        return false;
+    }
+
+    strcpy(out_address->sun_path, socket_path);
+    return true;
+}
+
+static int server_compile(resident_t *resident, weak_cstr_t program_name, weak_cstr_t working_directory, int argc, char **argv, strong_cstr_t *out_output, length_t *out_output_length){
+    // Runs a single build as if the compiler was invoked from 'working_directory',
+    // and captures everything that it prints
+
+    FILE *capture = tmpfile();
+    strong_cstr_t previous_directory = getcwd(NULL, 0);
+
+    if(capture == NULL || previous_directory == NULL || chdir(working_directory) != 0){
+        if(capture) fclose(capture);
+        free(previous_directory);
+        *out_output = mallocandsprintf("Compile server couldn't enter directory '%s'\n", working_directory);
+        *out_output_length = strlen(*out_output);
+        return 1;
+    }
+
+    fflush(stdout);
+    fflush(stderr);
+    int saved_stdout = dup(STDOUT_FILENO);
+    int saved_stderr = dup(STDERR_FILENO);
+    dup2(fileno(capture), STDOUT_FILENO);
+    dup2(fileno(capture), STDERR_FILENO);
+
+    // The program name goes in front of the arguments, like it would for 'main'
+    char **full_argv = malloc(sizeof(char*) * (argc + 1));
+    full_argv[0] = (char*) program_name;
+    memcpy(&full_argv[1], argv, sizeof(char*) * argc);
+
+    resident->hits = 0;
+    resident->misses = 0;
+
+    compiler_t compiler;
+    compiler_init(&compiler);
+    compiler.resident = resident;
+    int exitcode = compiler_run(&compiler, argc + 1, full_argv);
+    compiler_free(&compiler);
+    free(full_argv);
+
+    fflush(stdout);
+    fflush(stderr);
+    dup2(saved_stdout, STDOUT_FILENO);
+    dup2(saved_stderr, STDERR_FILENO);
+    close(saved_stdout);
+    close(saved_stderr);
+
+    if(chdir(previous_directory) != 0){
+        redprintf("Compile server couldn't return to directory '%s'\n", previous_directory);
+    }
+    free(previous_directory);
+
+    // Read back captured output
+    long output_length = ftell(capture);
+    if(output_length < 0) output_length = 0;
+
+    *out_output = malloc(output_length + 1);
+    rewind(capture);
+    *out_output_length = fread(*out_output, 1, output_length, capture);
+    fclose(capture);
+
+    printf("Build finished with exit code %d (%zu files reused, %zu files lexed)\n", exitcode, (size_t) resident->hits, (size_t) resident->misses);
+    fflush(stdout);
+    return exitcode;
+}
+
+static bool server_handle(int client, resident_t *resident, weak_cstr_t program_name){
+    // Returns whether the server should stop
+
+    strong_cstr_t version = server_read_string(client);
+    strong_cstr_t working_directory = version ? server_read_string(client) : NULL;
+    uint32_t argc = 0;
+
+    if(working_directory == NULL || !server_read(client, &argc, sizeof argc) || argc > SERVER_MAX_ARGUMENTS){
+        free(version);
+        free(working_directory);
+        return false;
+    }
+
+    char **argv = calloc(argc + 1, sizeof(char*));
+    bool received = true;
+
+    for(uint32_t i = 0; i != argc && received; i++){
+        argv[i] = server_read_string(client);
+        received = argv[i] != NULL;
+    }
+
+    bool stop = false;
+
+    if(!received){
+        // Client went away, nothing to respond to
+    } else if(!streq(version, ADEPT_VERSION_STRING)){
+        strong_cstr_t message = mallocandsprintf("Compile server is running a different version of the compiler (%s)\n", ADEPT_VERSION_STRING);
+        server_respond(client, 1, message, strlen(message));
+        free(message);
+    } else if(argc == 1 && streq(argv[0], "--stop-server")){
+        const char *message = "Compile server stopped\n";
+        server_respond(client, 0, message, strlen(message));
+        stop = true;
+    } else {
+        strong_cstr_t output;
+        length_t output_length;
+        int exitcode = server_compile(resident, program_name, working_directory, argc, argv, &output, &output_length);
+        server_respond(client, exitcode, output, output_length);
+        free(output);
+    }
+
+    for(uint32_t i = 0; i != argc; i++) free(argv[i]);
+    free(argv);
+    free(version);
+    free(working_directory);
+    return stop;
+}
+
+int server_run(weak_cstr_t program_name, weak_cstr_t socket_path){
+    struct sockaddr_un address;
+    if(!server_address(socket_path, &address)) return 1;
+
+    // Clients that disconnect early shouldn't take the server down with them
+    signal(SIGPIPE, SIG_IGN);
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(listener < 0){
+        redprintf("Failed to create socket for compile server\n");
+        return 1;
+    }
+
+    // Only remove an existing socket if no server is listening on it anymore
+    if(connect(listener, (struct sockaddr*) &address, sizeof address) == 0){
+        redprintf("A compile server is already running on '%s'\n", socket_path);
+        close(listener);
+        return 1;
+    }
+
+    close(listener);
+    unlink(socket_path);
+
+    listener = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if(listener < 0 || bind(listener, (struct sockaddr*) &address, sizeof address) != 0 || chmod(socket_path, 0600) != 0 || listen(listener, 16) != 0){
+        redprintf("Failed to listen on '%s'\n", socket_path);
+        if(listener >= 0) close(listener);
+        return 1;
+    }
+
+    printf("Compile server listening on '%s'\n", socket_path);
+    fflush(stdout);
+
+    resident_t resident = (resident_t){0};
+    bool stop = false;
+
+    while(!stop){
+        int client = accept(listener, NULL, NULL);
+        if(client < 0) continue;
+
+        stop = server_handle(client, &resident, program_name);
+        close(client);
+    }
+
+    close(listener);
+    unlink(socket_path);
+    resident_free(&resident);
+    return 0;
+}
+
+int server_connect(weak_cstr_t socket_path, int argc, char **argv){
+    struct sockaddr_un address;
+    if(!server_address(socket_path, &address)) return 1;
+
+    strong_cstr_t working_directory = getcwd(NULL, 0);
+    int server = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if(working_directory == NULL || server < 0 || connect(server, (struct sockaddr*) &address, sizeof address) != 0){
+        redprintf("Failed to connect to compile server on '%s'\n", socket_path);
+        if(server >= 0) close(server);
+        free(working_directory);
+        return 1;
+    }
+
+    uint32_t argument_count = argc;
+    bool sent = server_write_string(server, ADEPT_VERSION_STRING)
+             && server_write_string(server, working_directory)
+             && server_write(server, &argument_count, sizeof argument_count);
+
+    for(int i = 0; i != argc && sent; i++){
+        sent = server_write_string(server, argv[i]);
+    }
+
+    free(working_directory);
+
+    uint32_t exitcode;
+    uint64_t output_length;
+
+    if(!sent || !server_read(server, &exitcode, sizeof exitcode) || !server_read(server, &output_length, sizeof output_length)){
+        redprintf("Lost connection to compile server\n");
+        close(server);
+        return 1;
+    }
+
+    // Forward the output of the compiler
+    char chunk[4096];
+
+    while(output_length != 0){
+        length_t size = output_length < sizeof chunk ? output_length : sizeof chunk;
+
+        if(!server_read(server, chunk, size)){
+            redprintf("Lost connection to compile server\n");
+            close(server);
+            return 1;
+        }
+
+        fwrite(chunk, 1, size, stdout);
+        output_length -= size;
+    }
+
+    fflush(stdout);
+    close(server);
+    return exitcode;
+}
+
+#else
+
+int server_run(weak_cstr_t program_name, weak_cstr_t socket_path){
+    (void) program_name;
+    (void) socket_path;
+
+    redprintf("Compile servers aren't supported on this platform\n");
+    return 1;
+}
+
+int server_connect(weak_cstr_t socket_path, int argc, char **argv){
+    (void) socket_path;
+    (void) argc;
+    (void) argv;
+
+    redprintf("Compile servers aren't supported on this platform\n");
+    return 1;
+}
+
+#endif // ADEPT_CAN_SERVE
@@ -2,17 +2,21 @@
 #include "INFER/infer.h"
 
 #include <assert.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 
 #include "AST/ast_expr.h"
+#include "AST/ast_node_alloc.h"
 #include "AST/ast_type.h"
 #include "AST/ast_poly_catalog.h"
 #include "AST/POLY/ast_resolve.h"
 #include "UTIL/builtin_type.h"
 #include "UTIL/color.h"
+#include "UTIL/intern.h"
 #include "UTIL/levenshtein.h"
 #include "UTIL/string.h"
+#include "UTIL/string_map.h"
 #include "UTIL/util.h"
 
 errorcode_t infer(compiler_t *compiler, object_t *object){
@@ -939,7 +943,7 @@ found_named_expression:
     }
 
     // DANGEROUS: Manually freeing variable expression
-    free(*expr);
+    ast_node_free(*expr);
 
     // Clone expression of named expression
     *expr = ast_expr_clone(named_expression->expression);
@@ -1246,16 +1250,16 @@ errorcode_t infer_type_inner(infer_ctx_t *ctx, ast_type_t *type, source_t origin
                     // Substitute '*void' with 'ptr'
 
                     // Create replacement element
-                    ast_elem_base_t *ptr_elem = malloc(sizeof(ast_elem_base_t));
+                    ast_elem_base_t *ptr_elem = ast_node_alloc(sizeof(ast_elem_base_t));
                     ptr_elem->id = AST_ELEM_BASE;
                     ptr_elem->source = type->elements[elem_i]->source;
-                    ptr_elem->base = strclone("ptr");
+                    ptr_elem->base = intern_name("ptr");
 
                     // Free base type element 'void' that will disappear
                     ast_elem_free(elem);
 
                     // DANGEROUS: Manually freeing pointer ast_elem_pointer_t element
-                    free(new_elements[length - 1]);
+                    ast_node_free(new_elements[length - 1]);
 
                     // Replace previous '*' with 'ptr'
                     new_elements[length - 1] = (ast_elem_t*) ptr_elem;
@@ -1372,6 +1376,7 @@ errorcode_t infer_type_inner(infer_ctx_t *ctx, ast_type_t *type, source_t origin
 
                 *((ast_elem_fixed_array_t*) var_fixed_array_elem) = (ast_elem_fixed_array_t){
                     .id = AST_ELEM_FIXED_ARRAY,
+                    .in_arena = var_fixed_array_elem->in_arena,
                     .length = value,
                     .source = var_fixed_array_elem->source,
                 };
@@ -1402,6 +1407,7 @@ errorcode_t infer_type_inner(infer_ctx_t *ctx, ast_type_t *type, source_t origin
 void infer_var_scope_init(infer_var_scope_t *out_scope, infer_var_scope_t *parent){
     out_scope->parent = parent;
     out_scope->list = (infer_var_list_t){0};
+    out_scope->names = (string_map_t){0};
     out_scope->named_expressions = (ast_named_expression_list_t){0};
 }
 
@@ -1422,6 +1428,7 @@ void infer_var_scope_free(compiler_t *compiler, infer_var_scope_t *scope){
     }
 
     free(scope->list.variables);
+    string_map_free(&scope->names);
     ast_named_expression_list_free(&scope->named_expressions);
 }
 
@@ -1445,13 +1452,21 @@ void infer_var_scope_pop(compiler_t *compiler, infer_var_scope_t **scope){
 }
 
 infer_var_t* infer_var_scope_find(infer_var_scope_t *scope, const char *name){
-    for(length_t i = 0; i != scope->list.length; i++){
-        if(streq(scope->list.variables[i].name, name)){
-            return &scope->list.variables[i];
+    do {
+        if(scope->list.length >= INFER_VAR_SCOPE_HASH_THRESHOLD){
+            uintptr_t found = (uintptr_t) string_map_find(&scope->names, name);
+            if(found) return &scope->list.variables[found - 1];
+            continue;
         }
-    }
 
-    return scope->parent ? infer_var_scope_find(scope->parent, name) : NULL;
+        for(length_t i = 0; i != scope->list.length; i++){
+            if(streq(scope->list.variables[i].name, name)){
+                return &scope->list.variables[i];
+            }
+        }
+    } while((scope = scope->parent));
+
+    return NULL;
 }
 
 ast_named_expression_t* infer_var_scope_find_named_expression(infer_var_scope_t *scope, const char *name){
@@ -1473,6 +1488,16 @@ void infer_var_scope_ir_builder_add_variable(infer_var_scope_t *scope, weak_cstr
         .used = force_used || name[0] == '_',
         .is_const = is_const,
     }));
+
+    // NOTE: Earlier variables take priority over later ones of the same name
+    if(scope->list.length == INFER_VAR_SCOPE_HASH_THRESHOLD){
+        // Start hashing the names of variables in this scope
+        for(length_t i = 0; i != scope->list.length; i++){
+            string_map_insert(&scope->names, scope->list.variables[i].name, (void*) (uintptr_t) (i + 1));
+        }
+    } else if(scope->list.length > INFER_VAR_SCOPE_HASH_THRESHOLD){
+        string_map_insert(&scope->names, name, (void*) (uintptr_t) scope->list.length);
+    }
 }
 
 void infer_var_scope_add_named_expression(infer_var_scope_t *scope, ast_named_expression_t named_expression){
@@ -71,6 +71,7 @@ void ir_dump_function(FILE *file, ir_func_t *function, func_id_t ir_func_id, ir_
 
 void ir_dump_functions(FILE *file, ir_funcs_t *funcs){
     for(length_t i = 0; i != funcs->length; i++){
+        if(funcs->funcs[i].traits & IR_FUNC_UNREACHED) continue;
         ir_dump_function(file, &funcs->funcs[i], i, funcs->funcs);
     }
 }
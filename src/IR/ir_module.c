@@ -8,9 +8,9 @@
 #include "IRGEN/ir_builder.h"
 #include "UTIL/builtin_type.h"
 
-static rtti_collector_t *create_rtti_collector(ir_pool_t *pool){
+static rtti_collector_t *create_rtti_collector(ir_pool_t *pool, ast_type_table_t *type_table){
     rtti_collector_t *rtti_collector = ir_pool_alloc(pool, sizeof(rtti_collector_t));
-    rtti_collector_init(rtti_collector);
+    rtti_collector_init(rtti_collector, type_table);
 
     // Mention builtin primitive types to RTTI collector
     for(length_t i = 0; i < NUM_ITEMS(global_primitives_extended); i++){
@@ -30,17 +30,21 @@ void ir_module_init(ir_module_t *ir_module, length_t funcs_capacity, length_t gl
         .capacity = funcs_capacity,
     };
 
-    ir_proc_map_init(&ir_module->func_map, sizeof(ir_func_key_t), number_of_function_names_guess);
-    ir_proc_map_init(&ir_module->method_map, sizeof(ir_method_key_t), 0);
+    ir_proc_map_init(&ir_module->func_map, sizeof(ir_func_key_t), number_of_function_names_guess, &hash_ir_func_key, &equals_ir_func_key);
+    ir_proc_map_init(&ir_module->method_map, sizeof(ir_method_key_t), 0, &hash_ir_method_key, &equals_ir_method_key);
 
-    ir_module->type_map.mappings = NULL;
+    ir_module->type_map = (ir_type_map_t){0};
     ir_module->globals = malloc(sizeof(ir_global_t) * globals_length);
     ir_module->globals_length = 0;
     ir_module->anon_globals = (ir_anon_globals_t){0};
 
-    ir_gen_sf_cache_init(&ir_module->sf_cache, IR_GEN_SF_CACHE_SUGGESTED_NUM_BUCKETS);
+    ir_module->type_table = (ast_type_table_t){0};
+    ir_gen_sf_cache_init(&ir_module->sf_cache, &ir_module->type_table, IR_GEN_SF_CACHE_SUGGESTED_STARTING_CAPACITY);
+    ir_gen_poly_cache_init(&ir_module->poly_cache, &ir_module->type_table, IR_GEN_POLY_CACHE_SUGGESTED_STARTING_CAPACITY);
+    ir_gen_proc_cache_init(&ir_module->proc_cache, &ir_module->type_table, IR_GEN_PROC_CACHE_SUGGESTED_STARTING_CAPACITY);
+    ir_module->speculation_stats = (ir_speculation_stats_t){0};
 
-    ir_module->rtti_collector = create_rtti_collector(pool);
+    ir_module->rtti_collector = create_rtti_collector(pool, &ir_module->type_table);
     ir_module->rtti_table = NULL;
 
     ir_module->rtti_relocations = (rtti_relocations_t){0};
@@ -73,6 +77,8 @@ void ir_module_free(ir_module_t *ir_module){
     free(ir_module->globals);
     free(ir_module->anon_globals.globals);
     ir_gen_sf_cache_free(&ir_module->sf_cache);
+    ir_gen_poly_cache_free(&ir_module->poly_cache);
+    ir_gen_proc_cache_free(&ir_module->proc_cache);
 
     // Free init_builder
     if(ir_module->init_builder){
@@ -101,6 +107,7 @@ void ir_module_free(ir_module_t *ir_module){
     free_list_free(&ir_module->defer_free);
     ir_vtable_init_list_free(&ir_module->vtable_init_list);
     ir_vtable_dispatch_list_free(&ir_module->vtable_dispatch_list);
+    ast_type_table_free(&ir_module->type_table);
 
     ir_pool_free(&ir_module->pool);
 }
@@ -110,20 +117,33 @@ void ir_module_create_func_mapping(ir_module_t *module, weak_cstr_t function_nam
         .name = function_name,
     };
 
-    ir_proc_map_insert(&module->func_map, &key, sizeof key, endpoint, &compare_ir_func_key);
+    ir_proc_map_insert(&module->func_map, &key, endpoint);
 
     if(add_to_job_list){
         ir_job_list_append(&module->job_list, endpoint);
     }
 }
 
+void ir_module_reach_func(ir_module_t *module, func_id_t ir_func_id){
+    ir_func_t *ir_func = &module->funcs.funcs[ir_func_id];
+
+    if(ir_func->traits & IR_FUNC_UNREACHED){
+        ir_func->traits &= ~IR_FUNC_UNREACHED;
+
+        ir_job_list_append(&module->job_list, ((ir_func_endpoint_t){
+            .ast_func_id = ir_func->ast_func_id,
+            .ir_func_id = ir_func_id,
+        }));
+    }
+}
+
 void ir_module_create_method_mapping(ir_module_t *module, weak_cstr_t struct_name, weak_cstr_t method_name, ir_func_endpoint_t endpoint){
     ir_method_key_t key = (ir_method_key_t){
         .method_name = method_name,
         .struct_name = struct_name,
     };
 
-    ir_proc_map_insert(&module->method_map, &key, sizeof key, endpoint, &compare_ir_method_key);
+    ir_proc_map_insert(&module->method_map, &key, endpoint);
 }
 
 ir_value_t *ir_module_create_anon_global(ir_module_t *module, ir_type_t *type, bool is_constant, ir_value_t *initializer_or_null){
@@ -1,9 +1,13 @@
 
 #include "IR/ir_pool.h"
+#include "UTIL/threads.h"
 
 #include <stdlib.h>
 #include <string.h>
 
+static ADEPT_THREAD_LOCAL ir_pool_t *ir_pool_redirect_from;
+static ADEPT_THREAD_LOCAL ir_pool_t *ir_pool_redirect_to;
+
 void ir_pool_init(ir_pool_t *pool){
     *pool = (ir_pool_t){
         .fragments = malloc(sizeof(ir_pool_fragment_t) * 4),
@@ -19,6 +23,8 @@ void ir_pool_init(ir_pool_t *pool){
 }
 
 void* ir_pool_alloc(ir_pool_t *pool, length_t bytes){
+    if(pool == ir_pool_redirect_from) pool = ir_pool_redirect_to;
+
     ir_pool_fragment_t *recent_fragment = &pool->fragments[pool->length - 1];
 
     // Force alignment of every allocation to have alignment POOL_ALLOCATION_ALIGNMENT
@@ -62,6 +68,8 @@ void ir_pool_free(ir_pool_t *pool){
 }
 
 ir_pool_snapshot_t ir_pool_snapshot_capture(ir_pool_t *pool){
+    if(pool == ir_pool_redirect_from) pool = ir_pool_redirect_to;
+
     return (ir_pool_snapshot_t){
         .used = pool->fragments[pool->length - 1].used,
         .fragments_length = pool->length,
@@ -69,6 +77,8 @@ ir_pool_snapshot_t ir_pool_snapshot_capture(ir_pool_t *pool){
 }
 
 void ir_pool_snapshot_restore(ir_pool_t *pool, ir_pool_snapshot_t *snapshot){
+    if(pool == ir_pool_redirect_from) pool = ir_pool_redirect_to;
+
     for(length_t f = pool->length; f != snapshot->fragments_length; f--){
         free(pool->fragments[f - 1].memory);
     }
@@ -77,6 +87,25 @@ void ir_pool_snapshot_restore(ir_pool_t *pool, ir_pool_snapshot_t *snapshot){
     pool->fragments[snapshot->fragments_length - 1].used = snapshot->used;
 }
 
+void ir_pool_redirect(ir_pool_t *from, ir_pool_t *to){
+    ir_pool_redirect_from = from;
+    ir_pool_redirect_to = to;
+}
+
+void ir_pool_adopt(ir_pool_t *pool, ir_pool_t *other){
+    // The fragments of 'other' go after ours, so that allocations continue in its most recent fragment
+    if(pool->length + other->length > pool->capacity){
+        while(pool->length + other->length > pool->capacity) pool->capacity *= 2;
+        pool->fragments = realloc(pool->fragments, sizeof(ir_pool_fragment_t) * pool->capacity);
+    }
+
+    memcpy(&pool->fragments[pool->length], other->fragments, sizeof(ir_pool_fragment_t) * other->length);
+    pool->length += other->length;
+
+    free(other->fragments);
+    *other = (ir_pool_t){0};
+}
+
 void *ir_pool_memclone(ir_pool_t *pool, const void *bytes, length_t num_bytes){
     return memcpy(ir_pool_alloc(pool, num_bytes), bytes, num_bytes);
 }
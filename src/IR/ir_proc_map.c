@@ -1,84 +1,102 @@
-
 #include "IR/ir_proc_map.h"
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "UTIL/ground.h"
+#include "UTIL/hash.h"
+#include "UTIL/set.h"
 #include "UTIL/util.h"
 
-static void ir_proc_map_expand(ir_proc_map_t *map, length_t sizeof_key){
-    coexpand(
-        (void**) &map->keys, sizeof_key,
-        (void**) &map->endpoint_lists, sizeof *map->endpoint_lists,
-        map->length, &map->capacity,
-        1, 4
-    );
+// ---------------- ir_proc_map_record_t ----------------
+// Endpoint list of a key, followed by a copy of the key
+typedef struct {
+    ir_func_endpoint_list_t endpoint_list;
+    void *key[]; // (Pointer-aligned storage for the key)
+} ir_proc_map_record_t;
+
+static ir_func_endpoint_list_t *ir_proc_map_endpoint_list_of(void *stored_key){
+    return &((ir_proc_map_record_t*) ((char*) stored_key - offsetof(ir_proc_map_record_t, key)))->endpoint_list;
+}
+
+static void ir_proc_map_expand(ir_proc_map_t *map){
+    expand((void**) &map->endpoint_lists, sizeof *map->endpoint_lists, map->length, &map->capacity, 1, 4);
 }
 
-void ir_proc_map_init(ir_proc_map_t *map, length_t sizeof_key, length_t estimated_keys){
+void ir_proc_map_init(ir_proc_map_t *map, length_t sizeof_key, length_t estimated_keys, ir_proc_map_hash_func_t hash_func, ir_proc_map_equals_func_t equals_func){
     *map = (ir_proc_map_t){
-        .keys = malloc(sizeof_key * estimated_keys),
-        .endpoint_lists = malloc(sizeof(ir_func_endpoint_t) * estimated_keys),
+        .endpoint_lists = malloc(sizeof(ir_func_endpoint_list_t*) * estimated_keys),
         .length = 0,
         .capacity = estimated_keys,
+        .sizeof_key = sizeof_key,
         .endpoint_pool = {0},
     };
 
+    set_init(&map->keys, estimated_keys, hash_func, equals_func, NULL);
     ir_pool_init(&map->endpoint_pool);
 }
 
 void ir_proc_map_free(ir_proc_map_t *map){
-    free(map->keys);
-
     for(length_t i = 0; i < map->length; i++){
         ir_func_endpoint_list_free(map->endpoint_lists[i]);
     }
 
     free(map->endpoint_lists);
+    set_free(&map->keys, NULL);
 
     ir_pool_free(&map->endpoint_pool);
 }
 
-void ir_proc_map_insert(ir_proc_map_t *map, const void *key, length_t sizeof_key, ir_func_endpoint_t endpoint, int (*key_compare)(const void*, const void*)){
-    length_t position = find_insert_position(map->keys, map->length, key_compare, key, sizeof_key);
+void ir_proc_map_insert(ir_proc_map_t *map, const void *key, ir_func_endpoint_t endpoint){
+    hash_t hash = (*map->keys.hash_func)(key);
+    void *stored_key = set_find_hashed(&map->keys, key, hash);
 
-    if(position < map->length && (*key_compare)(key, (char*) map->keys + sizeof_key * (position)) == 0){
-        // Key already exists in map
-    } else {
+    if(stored_key == NULL){
         // Key doesn't already exist in map
+        ir_proc_map_record_t *record = ir_pool_alloc(&map->endpoint_pool, sizeof(ir_proc_map_record_t) + map->sizeof_key);
+        memset(&record->endpoint_list, 0, sizeof(ir_func_endpoint_list_t));
+        stored_key = memcpy(record->key, key, map->sizeof_key);
 
-        ir_proc_map_expand(map, sizeof_key);
+        set_insert_hashed(&map->keys, stored_key, hash);
 
-        memmove((char*) map->keys + sizeof_key * (position + 1), (char*) map->keys + sizeof_key * (position), sizeof_key * (map->length - position));
-        memmove(&map->endpoint_lists[position + 1], &map->endpoint_lists[position], sizeof(*map->endpoint_lists) * (map->length - position));
+        ir_proc_map_expand(map);
+        map->endpoint_lists[map->length++] = &record->endpoint_list;
+    }
 
-        memcpy((char*) map->keys + sizeof_key * position, key, sizeof_key);
-        map->endpoint_lists[position] = (ir_func_endpoint_list_t*) ir_pool_alloc(&map->endpoint_pool, sizeof(ir_func_endpoint_list_t));
-        map->length += 1;
+    ir_func_endpoint_list_insert(ir_proc_map_endpoint_list_of(stored_key), endpoint);
+}
 
-        memset(map->endpoint_lists[position], 0, sizeof(ir_func_endpoint_list_t));
-    }
+ir_func_endpoint_list_t *ir_proc_map_find(ir_proc_map_t *map, const void *key){
+    void *stored_key = set_find(&map->keys, key);
+    return stored_key ? ir_proc_map_endpoint_list_of(stored_key) : NULL;
+}
 
-    ir_func_endpoint_list_insert(map->endpoint_lists[position], endpoint);
+const void *ir_proc_map_key_at(const ir_proc_map_t *map, length_t index){
+    // Endpoint lists are the first member of their records
+    return ((ir_proc_map_record_t*) map->endpoint_lists[index])->key;
 }
 
-ir_func_endpoint_list_t *ir_proc_map_find(ir_proc_map_t *map, const void *key, length_t sizeof_key, int (*key_compare)(const void*, const void*)){
-    void **found_key = bsearch(key, map->keys, map->length, sizeof_key, key_compare);
+hash_t hash_ir_func_key(const void *key){
+    // Function names are interned, so their addresses identify them
+    return hash_pointer(((const ir_func_key_t*) key)->name);
+}
 
-    if(found_key != NULL){
-        // Use index of found key to access corresponding endpoint list
-        length_t co_index = (length_t)((char*) found_key - (char*) map->keys) / sizeof_key;
-        return map->endpoint_lists[co_index];
-    } else {
-        return NULL;
-    }
+bool equals_ir_func_key(const void *a, const void *b){
+    return ((const ir_func_key_t*) a)->name == ((const ir_func_key_t*) b)->name;
 }
 
-int compare_ir_func_key(const void *raw_a, const void *raw_b){
-    const ir_func_key_t *a = raw_a;
-    const ir_func_key_t *b = raw_b;
-    return strcmp(a->name, b->name);
+hash_t hash_ir_method_key(const void *raw_key){
+    const ir_method_key_t *key = raw_key;
+    return hash_combine(hash_string(key->struct_name), hash_string(key->method_name));
+}
+
+bool equals_ir_method_key(const void *raw_a, const void *raw_b){
+    const ir_method_key_t *a = raw_a;
+    const ir_method_key_t *b = raw_b;
+    return streq(a->struct_name, b->struct_name) && streq(a->method_name, b->method_name);
 }
 
 int compare_ir_method_key(const void *raw_a, const void *raw_b){
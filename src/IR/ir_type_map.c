@@ -3,30 +3,37 @@
 
 #include <stdbool.h>
 #include <stdlib.h>
-#include <string.h>
 
-void ir_type_map_free(ir_type_map_t *type_map){
-    free(type_map->mappings);
-}
+#include "UTIL/hash.h"
+#include "UTIL/set.h"
 
-successful_t ir_type_map_find(ir_type_map_t *type_map, const char *name, ir_type_t **type_ptr){
-    // Does a binary search on the type map to find the requested type by name
+static hash_t ir_type_mapping_hash(const void *mapping){
+    return hash_pointer(((const ir_type_mapping_t*) mapping)->name);
+}
 
-    ir_type_mapping_t *mappings = type_map->mappings;
+static bool ir_type_mapping_equals(const void *a, const void *b){
+    // Names are interned, so their addresses identify them
+    return ((const ir_type_mapping_t*) a)->name == ((const ir_type_mapping_t*) b)->name;
+}
 
-    long long first = 0, middle, last = (long long) type_map->length - 1, comparison;
+void ir_type_map_free(ir_type_map_t *type_map){
+    set_free(&type_map->by_name, NULL);
+    free(type_map->mappings);
+}
 
-    while(first <= last){
-        middle = (first + last) / 2;
-        comparison = strcmp(mappings[middle].name, name);
+void ir_type_map_index(ir_type_map_t *type_map){
+    set_free(&type_map->by_name, NULL);
+    set_init(&type_map->by_name, type_map->length, &ir_type_mapping_hash, &ir_type_mapping_equals, NULL);
 
-        if(comparison == 0){
-            *type_ptr = mappings[middle].type;
-            return true;
-        }
-        else if(comparison > 0) last = middle - 1;
-        else first = middle + 1;
+    for(length_t i = 0; i != type_map->length; i++){
+        set_insert(&type_map->by_name, &type_map->mappings[i]);
     }
+}
+
+successful_t ir_type_map_find(ir_type_map_t *type_map, const char *name, ir_type_t **type_ptr){
+    ir_type_mapping_t *mapping = set_find(&type_map->by_name, &(ir_type_mapping_t){ .name = (weak_cstr_t) name });
+    if(mapping == NULL) return false;
 
-    return false;
+    *type_ptr = mapping->type;
+    return true;
 }
@@ -1,7 +1,8 @@
 
+#include "DRVR/object.h"
+#include "IR/ir_module.h"
 #include "IRGEN/ir_build_instr.h"
 #include "IRGEN/ir_build_literal.h"
-#include "LEX/lex.h"
 
 #define BUILD_VALUE(TYPE, ...) ( \
     *((TYPE*) build_instruction(builder, sizeof(TYPE))) = ((TYPE[]){ __VA_ARGS__ })[0], \
@@ -81,7 +82,7 @@ ir_value_t *build_load(ir_builder_t *builder, ir_value_t *value, source_t code_s
 
     // If null checks enabled, remember origin line/column
     if(builder->compiler->checks & COMPILER_NULL_CHECKS) {
-        lex_get_location(builder->compiler->objects[code_source.object_index]->buffer, code_source.index, &line, &column);
+        object_get_location(builder->compiler->objects[code_source.object_index], code_source.index, &line, &column);
     }
 
     return BUILD_VALUE(ir_instr_load_t, {
@@ -98,7 +99,7 @@ ir_instr_store_t *build_store(ir_builder_t *builder, ir_value_t *value, ir_value
 
     // If null checks enabled, remember origin line/column
     if(builder->compiler->checks & COMPILER_NULL_CHECKS) {
-        lex_get_location(builder->compiler->objects[code_source.object_index]->buffer, code_source.index, &line, &column);
+        object_get_location(builder->compiler->objects[code_source.object_index], code_source.index, &line, &column);
     }
 
     BUILD_INSTR(ir_instr_store_t, {
@@ -124,9 +125,12 @@ ir_value_t *build_call(ir_builder_t *builder, func_id_t ir_func_id, ir_type_t *r
 void build_call_ignore_result(ir_builder_t *builder, func_id_t ir_func_id, ir_type_t *result_type, ir_value_t **arguments, length_t arguments_length, source_t code_source){
     int line = -1, column = -1;
 
+    // Generate the body of the callee if it hasn't been already
+    ir_builder_reach_func(builder, ir_func_id);
+
     // If vtable validation is enabled, remember origin line/column
     if(builder->object->ir_module.funcs.funcs[ir_func_id].traits & IR_FUNC_VALIDATE_VTABLE){
-        lex_get_location(builder->compiler->objects[code_source.object_index]->buffer, code_source.index, &line, &column);
+        object_get_location(builder->compiler->objects[code_source.object_index], code_source.index, &line, &column);
     }
 
     BUILD_INSTR(ir_instr_call_t, {
@@ -195,7 +199,7 @@ ir_value_t *build_array_access_ex(ir_builder_t *builder, ir_value_t *value, ir_v
 
     // If null checks enabled, remember origin line/column
     if(builder->compiler->checks & COMPILER_NULL_CHECKS) {
-        lex_get_location(builder->compiler->objects[code_source.object_index]->buffer, code_source.index, &line, &column);
+        object_get_location(builder->compiler->objects[code_source.object_index], code_source.index, &line, &column);
     }
 
     return BUILD_VALUE(ir_instr_array_access_t, {
@@ -213,7 +217,7 @@ ir_value_t *build_member(ir_builder_t *builder, ir_value_t *value, length_t memb
 
     // If null checks enabled, remember origin line/column
     if(builder->compiler->checks & COMPILER_NULL_CHECKS) {
-        lex_get_location(builder->compiler->objects[code_source.object_index]->buffer, code_source.index, &line, &column);
+        object_get_location(builder->compiler->objects[code_source.object_index], code_source.index, &line, &column);
     }
 
     return BUILD_VALUE(ir_instr_member_t, {
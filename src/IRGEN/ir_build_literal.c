@@ -1,5 +1,7 @@
 
 #include "IRGEN/ir_build_literal.h"
+#include "IRGEN/ir_gen_parallel.h"
+#include "UTIL/intern.h"
 
 ir_value_t *build_struct_literal(ir_module_t *module, ir_type_t *type, ir_value_t **values, length_t length, bool make_mutable){
     // Create struct literal
@@ -121,6 +123,9 @@ ir_value_t *build_literal_str(ir_builder_t *builder, char *array, length_t lengt
     ir_type_t *ir_string_type = builder->object->ir_module.common.ir_string_struct;
 
     if(ir_string_type == NULL){
+        // Speculative function bodies can't report problems
+        if(ir_gen_speculation_abort()) return NULL;
+
         redprintf("Can't create string literal without String type present");
         printf("\nTry importing '%s/String.adept'\n", ADEPT_VERSION_STRING);
         return NULL;
@@ -158,7 +163,7 @@ ir_value_t *build_literal_cstr_of_size(ir_builder_t *builder, char *array, lengt
 ir_value_t *build_literal_cstr_of_size_ex(ir_pool_t *pool, ir_type_map_t *type_map, char *array, length_t size){
     ir_type_t *ir_ubyte_type;
 
-    if(!ir_type_map_find(type_map, "ubyte", &ir_ubyte_type)){
+    if(!ir_type_map_find(type_map, intern_name("ubyte"), &ir_ubyte_type)){
         die("build_literal_cstr_of_size_ex() - Failed to find 'ubyte' type mapping\n");
     }
 
@@ -30,6 +30,7 @@
 #include "IRGEN/ir_gen_expr.h"
 #include "IRGEN/ir_gen_find.h"
 #include "IRGEN/ir_gen_find_sf.h"
+#include "IRGEN/ir_gen_parallel.h"
 #include "IRGEN/ir_gen_type.h"
 #include "LEX/lex.h"
 #include "UTIL/builtin_type.h"
@@ -37,6 +38,7 @@
 #include "UTIL/datatypes.h"
 #include "UTIL/func_pair.h"
 #include "UTIL/ground.h"
+#include "UTIL/intern.h"
 #include "UTIL/string.h"
 #include "UTIL/trait.h"
 
@@ -77,23 +79,25 @@ void ir_builder_init(ir_builder_t *builder, compiler_t *compiler, object_t *obje
     builder->block_stack = (block_stack_t){0};
 
     if(!static_builder){
-        ir_func_t *module_func = &object->ir_module.funcs.funcs[ir_func_id];
-        module_func->scope = malloc(sizeof(bridge_scope_t));
-        bridge_scope_init(module_func->scope, NULL);
-        module_func->scope->first_var_id = 0;
-        builder->scope = module_func->scope;
+        builder->scope = malloc(sizeof(bridge_scope_t));
+        bridge_scope_init(builder->scope, NULL);
+        builder->scope->first_var_id = 0;
     } else {
         builder->scope = NULL;
     }
 
     builder->job_list = &object->ir_module.job_list;
+    builder->vtable_init_list = &object->ir_module.vtable_init_list;
+    builder->vtable_dispatch_list = &object->ir_module.vtable_dispatch_list;
+    builder->rtti_relocations = &object->ir_module.rtti_relocations;
+    builder->defer_free = &object->ir_module.defer_free;
 
     source_t object_source = { .index = 0, .object_index = builder->object->index, .stride = 0 };
 
     builder->static_bool_base = (ast_elem_base_t){
         .id = AST_ELEM_BASE,
         .source = object_source,
-        .base = "bool",
+        .base = intern_name("bool"),
     };
 
     builder->static_bool_elems = (ast_elem_t*) &builder->static_bool_base;
@@ -182,7 +186,7 @@ ir_value_t *build_value_from_prev_instruction(ir_builder_t *builder){
 }
 
 void ir_builder_add_rtti_relocation(ir_builder_t *builder, strong_cstr_t human_notation, adept_usize *id_ref, source_t source_on_failure){
-    rtti_relocations_append(&builder->object->ir_module.rtti_relocations, (
+    rtti_relocations_append(builder->rtti_relocations, (
         (rtti_relocation_t){
             .human_notation = human_notation,
             .id_ref = id_ref,
@@ -218,6 +222,9 @@ maybe_index_t ir_builder___types__(ir_builder_t *builder, source_t source_on_fai
         compiler_panic(builder->compiler, source_on_failure, "Failed to find __types__ global variable");
         return -1;
     case TROOLEAN_UNKNOWN:
+        // Speculative function bodies can't remember where it is
+        if(ir_gen_speculation_abort()) return -1;
+
         // TODO: SPEED: It works, but the global variable lookup could be faster
         for(length_t index = 0; index != ir_module->globals_length; index++){
             if(streq("__types__", ir_module->globals[index].name)){
@@ -269,8 +276,6 @@ void ir_builder_pop_loop_label(ir_builder_t *builder){
 }
 
 bridge_var_t *ir_builder_add_variable(ir_builder_t *builder, weak_cstr_t name, ast_type_t *ast_type, ir_type_t *ir_type, trait_t traits){
-    bridge_var_list_t *list = &builder->scope->list;
-
     index_id_t id = INVALID_INDEX_ID;
     index_id_t static_id = INVALID_INDEX_ID;
 
@@ -287,16 +292,14 @@ bridge_var_t *ir_builder_add_variable(ir_builder_t *builder, weak_cstr_t name, a
         id = builder->next_var_id++;
     }
 
-    bridge_var_list_append(list, ((bridge_var_t){
-        .name = name,
+    return bridge_scope_add_var(builder->scope, ((bridge_var_t){
+        .name = intern_name(name),
         .ast_type = ast_type,
         .traits = traits,
         .ir_type = ir_type,
         .id = id,
         .static_id = static_id,
     }));
-
-    return &list->variables[list->length - 1];
 }
 
 errorcode_t handle_deference_for_variables(ir_builder_t *builder, bridge_var_list_t *list){
@@ -884,6 +887,37 @@ ir_value_t *handle_access_management(
     return build_call(builder, pair.ir_func_id, result_ir_type, arguments, 2, source);
 }
 
+static bool instantiation_is_reusable(object_t *object, ast_func_t *poly_func, ir_func_endpoint_t instance, ast_type_t *types, length_t types_list_length, ast_poly_catalog_t *catalog){
+    ir_funcs_t *ir_funcs = &object->ir_module.funcs;
+
+    // Instantiations are forgotten when an instruction snapshot from before them is restored
+    if(instance.ir_func_id >= ir_funcs->length || ir_funcs->funcs[instance.ir_func_id].ast_func_id != instance.ast_func_id){
+        return false;
+    }
+
+    ast_func_t *func = &object->ast.funcs[instance.ast_func_id];
+
+    // Polymorphic parameters take on the types of the arguments they were instantiated with,
+    // so those must be the same too
+    for(length_t i = 0; i != poly_func->arity; i++){
+        ast_type_t *template_arg_type = &poly_func->arg_types[i];
+        if(!ast_type_has_polymorph(template_arg_type)) continue;
+
+        if(i >= types_list_length) return false;
+
+        ast_type_t *arg_type = &types[i];
+
+        if(ast_type_is_unknown_enum(arg_type) && ast_type_is_polymorph(template_arg_type)){
+            ast_elem_polymorph_t *polymorph = (ast_elem_polymorph_t*) template_arg_type->elements[0];
+            arg_type = &ast_poly_catalog_find_type(catalog, polymorph->name)->binding;
+        }
+
+        if(!ast_types_identical(&func->arg_types[i], arg_type)) return false;
+    }
+
+    return true;
+}
+
 errorcode_t instantiate_poly_func(compiler_t *compiler, object_t *object, source_t instantiation_source, func_id_t ast_poly_func_id, ast_type_t *types,
         length_t types_list_length, ast_poly_catalog_t *catalog, length_t instantiation_depth, ir_func_endpoint_t *out_endpoint){
 
@@ -925,6 +959,25 @@ errorcode_t instantiate_poly_func(compiler_t *compiler, object_t *object, source
         // and leave processing and conforming the default arguments to higher level functions
     }
     
+    // Reuse the existing instantiation for these bindings if there is one
+    ir_gen_poly_cache_t *poly_cache = &object->ir_module.poly_cache;
+    ir_gen_speculation_t *speculation = ir_gen_speculation_current();
+
+    ir_gen_poly_cache_entry_t *cache_entry = speculation
+        ? ir_gen_poly_cache_locate(poly_cache, ast_poly_func_id, catalog)
+        : ir_gen_poly_cache_locate_or_insert(poly_cache, ast_poly_func_id, catalog);
+
+    if(cache_entry && instantiation_is_reusable(object, poly_func, cache_entry->instance, types, types_list_length, catalog)){
+        if(speculation) speculation->poly_reused++;
+        else            poly_cache->reused++;
+
+        if(out_endpoint) *out_endpoint = cache_entry->instance;
+        return SUCCESS;
+    }
+
+    // Speculative function bodies can't create new instantiations
+    if(ir_gen_speculation_abort()) return FAILURE;
+
     ast_t *ast = &object->ast;
     func_id_t ast_func_id = ast_new_func(ast);
 
@@ -946,7 +999,7 @@ errorcode_t instantiate_poly_func(compiler_t *compiler, object_t *object, source
     };
 
     ast_func_create_template(compiler, func, &(ast_func_head_t){
-        .name = strclone(poly_func->name),
+        .name = poly_func->name,
         .source = poly_func->source,
         .is_foreign = false,
         .is_entry = is_entry,
@@ -1016,11 +1069,10 @@ errorcode_t instantiate_poly_func(compiler_t *compiler, object_t *object, source
     func->arity = poly_func->arity;
     func->return_type = (ast_type_t){0};
     
-    func->statements = ast_expr_list_clone(&poly_func->statements);
-
     rtti_collector_t *rtti_collector = object->ir_module.rtti_collector;
 
-    if(ast_resolve_expr_list_polymorphs(compiler, rtti_collector, catalog, &func->statements)
+    // Only the parts of the template that involve polymorphs are copied, the rest is shared
+    if(ast_resolve_expr_list_polymorphs_into(compiler, rtti_collector, catalog, &poly_func->statements, &func->statements, &ast->shared_exprs)
     || ast_resolve_type_polymorphs(compiler, rtti_collector, catalog, &poly_func->return_type, &func->return_type)){
         goto failure;
     }
@@ -1042,6 +1094,9 @@ errorcode_t instantiate_poly_func(compiler_t *compiler, object_t *object, source
         func->virtual_origin = ast_concrete_virtual_origin;
     }
 
+    cache_entry->instance = newest_endpoint;
+    poly_cache->created++;
+
     if(out_endpoint) *out_endpoint = newest_endpoint;
     return SUCCESS;
 
@@ -1146,12 +1201,16 @@ errorcode_t attempt_autogen___defer__(compiler_t *compiler, object_t *object, as
 
     ast_t *ast = &object->ast;
     ir_gen_sf_cache_t *cache = &object->ir_module.sf_cache;
-    ir_gen_sf_cache_entry_t *entry = ir_gen_sf_cache_locate_or_insert(cache, &dereferenced_view);
+    ir_gen_sf_cache_entry_t *entry = ir_gen_speculation_sf_cache_entry(cache, &dereferenced_view);
+    if(entry == NULL) return ALT_FAILURE;
 
     if(ir_gen_sf_cache_read(entry->has_defer, entry->defer, result) == SUCCESS){
         return SUCCESS;
     }
 
+    // Speculative function bodies can't auto-generate functions
+    if(ir_gen_speculation_abort()) return ALT_FAILURE;
+
     if(ast->funcs_length >= MAX_FUNC_ID){
         compiler_panic(compiler, arg_types[0].source, "Maximum number of AST functions reached\n");
         return FAILURE;
@@ -1233,7 +1292,7 @@ errorcode_t attempt_autogen___defer__(compiler_t *compiler, object_t *object, as
     ast_func_t *func = &ast->funcs[ast_func_id];
 
     ast_func_create_template(compiler, func, &(ast_func_head_t){
-        .name = strclone("__defer__"),
+        .name = "__defer__",
         .source = NULL_SOURCE,
         .is_foreign = false,
         .is_entry = false,
@@ -1257,7 +1316,7 @@ errorcode_t attempt_autogen___defer__(compiler_t *compiler, object_t *object, as
     func->arity = 1;
 
     memset(&func->statements, 0, sizeof(ast_expr_list_t));
-    func->return_type = ast_type_make_base(strclone("void"));
+    func->return_type = ast_type_make_base("void");
     func->instantiation_depth = instantiation_depth + 1;
 
     // Create IR function
@@ -1291,12 +1350,16 @@ errorcode_t attempt_autogen___pass__(compiler_t *compiler, object_t *object, ast
     }
 
     ir_gen_sf_cache_t *cache = &object->ir_module.sf_cache;
-    ir_gen_sf_cache_entry_t *entry = ir_gen_sf_cache_locate_or_insert(cache, &arg_types[0]);
+    ir_gen_sf_cache_entry_t *entry = ir_gen_speculation_sf_cache_entry(cache, &arg_types[0]);
+    if(entry == NULL) return ALT_FAILURE;
 
     if(ir_gen_sf_cache_read(entry->has_pass, entry->pass, result) == SUCCESS){
         return SUCCESS;
     }
 
+    // Speculative function bodies can't auto-generate functions
+    if(ir_gen_speculation_abort()) return ALT_FAILURE;
+
     ast_t *ast = &object->ast;
 
     if(is_base){
@@ -1333,7 +1396,7 @@ errorcode_t attempt_autogen___pass__(compiler_t *compiler, object_t *object, ast
     ast_func_t *func = &ast->funcs[ast_func_id];
     
     ast_func_create_template(compiler, func, &(ast_func_head_t){
-        .name = strclone("__pass__"),
+        .name = "__pass__",
         .source = NULL_SOURCE,
         .is_foreign = false,
         .is_entry = false,
@@ -1398,12 +1461,16 @@ errorcode_t attempt_autogen___assign__(compiler_t *compiler, object_t *object, a
     ast_t *ast = &object->ast;
     ir_gen_sf_cache_t *cache = &object->ir_module.sf_cache;
 
-    ir_gen_sf_cache_entry_t *entry = ir_gen_sf_cache_locate_or_insert(cache, &dereferenced_view);
+    ir_gen_sf_cache_entry_t *entry = ir_gen_speculation_sf_cache_entry(cache, &dereferenced_view);
+    if(entry == NULL) return ALT_FAILURE;
 
     if(ir_gen_sf_cache_read(entry->has_assign, entry->assign, result) == SUCCESS){
         return SUCCESS;
     }
 
+    // Speculative function bodies can't auto-generate functions
+    if(ir_gen_speculation_abort()) return ALT_FAILURE;
+
     if(ast->funcs_length >= MAX_FUNC_ID){
         compiler_panic(compiler, arg_types[0].source, "Maximum number of AST functions reached\n");
         return FAILURE;
@@ -1499,7 +1566,7 @@ errorcode_t attempt_autogen___assign__(compiler_t *compiler, object_t *object, a
     ast_func_t *func = &ast->funcs[ast_func_id];
 
     ast_func_create_template(compiler, func, &(ast_func_head_t){
-        .name = strclone("__assign__"),
+        .name = "__assign__",
         .source = NULL_SOURCE,
         .is_foreign = false,
         .is_entry = false,
@@ -1531,7 +1598,7 @@ errorcode_t attempt_autogen___assign__(compiler_t *compiler, object_t *object, a
     func->arg_type_traits[1] = AST_FUNC_ARG_TYPE_TRAIT_POD;
     func->arity = 2;
     func->statements = ast_expr_list_create(field_map.arrows_length);
-    func->return_type = ast_type_make_base(strclone("void"));
+    func->return_type = ast_type_make_base("void");
     func->instantiation_depth = instantiation_depth + 1;
 
     // Generate assignment statements
@@ -1739,6 +1806,25 @@ length_t ir_builder_instantiation_depth(ir_builder_t *builder){
     return builder->object->ast.funcs[builder->ast_func_id].instantiation_depth;
 }
 
+void ir_builder_reach_func(ir_builder_t *builder, func_id_t ir_func_id){
+    ir_module_t *module = &builder->object->ir_module;
+
+    if(ir_gen_speculating()){
+        // Speculative function bodies only remember the functions they reach,
+        // which are then queued if the body is committed
+        ir_func_t *ir_func = &module->funcs.funcs[ir_func_id];
+
+        if(ir_func->traits & IR_FUNC_UNREACHED){
+            ir_job_list_append(builder->job_list, ((ir_func_endpoint_t){
+                .ast_func_id = ir_func->ast_func_id,
+                .ir_func_id = ir_func_id,
+            }));
+        }
+    } else {
+        ir_module_reach_func(module, ir_func_id);
+    }
+}
+
 ir_instrs_snapshot_t ir_instrs_snapshot_capture(ir_builder_t *builder){
     return (ir_instrs_snapshot_t ){
         .current_block_id = builder->current_block_id,
@@ -1754,6 +1840,20 @@ void ir_instrs_snapshot_restore(ir_builder_t *builder, ir_instrs_snapshot_t *sna
     builder->current_block = &builder->basicblocks.blocks[builder->current_block_id];
     builder->current_block->instructions.length = snapshot->current_basicblock_instructions_length;
     builder->basicblocks.length = snapshot->basicblocks_length;
-    builder->object->ir_module.funcs.length = snapshot->funcs_length;
+
+    // (Speculative function bodies never create functions, and mustn't write to the module)
+    ir_funcs_t *ir_funcs = &builder->object->ir_module.funcs;
+    if(ir_funcs->length != snapshot->funcs_length) ir_funcs->length = snapshot->funcs_length;
+
+    // Functions that already existed but were only queued since the snapshot
+    // must have been deferred ones that were reached, so defer them again
+    for(length_t i = snapshot->job_list_length; i < builder->job_list->length; i++){
+        func_id_t ir_func_id = builder->job_list->jobs[i].ir_func_id;
+
+        if(ir_func_id < snapshot->funcs_length && !(ir_funcs->funcs[ir_func_id].traits & IR_FUNC_UNREACHED)){
+            ir_funcs->funcs[ir_func_id].traits |= IR_FUNC_UNREACHED;
+        }
+    }
+
     builder->job_list->length = snapshot->job_list_length;
 }
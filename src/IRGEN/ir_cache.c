@@ -4,40 +4,40 @@
 #include <stdlib.h>
 #include <string.h>
 
-#include "AST/TYPE/ast_type_hash.h"
-#include "AST/TYPE/ast_type_identical.h"
+#include "AST/TYPE/ast_type_table.h"
 #include "AST/ast_type.h"
 #include "IRGEN/ir_cache.h"
+#include "UTIL/arena.h"
 #include "UTIL/ground.h"
 #include "UTIL/hash.h"
+#include "UTIL/set.h"
+#include "UTIL/util.h"
 
-void ir_gen_sf_cache_init(ir_gen_sf_cache_t *cache, length_t num_buckets){
-    cache->capacity = num_buckets;
-    cache->storage = malloc(sizeof(ir_gen_sf_cache_entry_t) * cache->capacity);
-    memset(cache->storage, 0, sizeof(ir_gen_sf_cache_entry_t) * cache->capacity);
+static hash_t ir_gen_sf_cache_hash(const void *entry){
+    return ast_canonical_type_hash(((const ir_gen_sf_cache_entry_t*) entry)->ast_type);
 }
 
-void ir_gen_sf_cache_free(ir_gen_sf_cache_t *cache){
-    for(length_t i = 0; i != cache->capacity; i++){
-        if(!ir_gen_sf_cache_entry_is_occupied(&cache->storage[i])) continue;
-
-        bool is_first = true;
-        ir_gen_sf_cache_entry_t *head = &cache->storage[i];
+static bool ir_gen_sf_cache_equals(const void *a, const void *b){
+    // Canonical types are identical only if they are the same
+    return ((const ir_gen_sf_cache_entry_t*) a)->ast_type == ((const ir_gen_sf_cache_entry_t*) b)->ast_type;
+}
 
-        while(head){
-            ir_gen_sf_cache_entry_t *previous = head;
-            head = head->next;
+void ir_gen_sf_cache_init(ir_gen_sf_cache_t *cache, ast_type_table_t *type_table, length_t starting_capacity){
+    *cache = (ir_gen_sf_cache_t){
+        .entries_arena = {0},
+        .type_table = type_table,
+        .hits = 0,
+        .misses = 0,
+    };
 
-            // Assume occupied since first is occupied and rest were allocated
-            ast_type_free(&previous->ast_type);
-            if(!is_first) free(previous);
-            
-            is_first = false;
-        }
-    }
-    free(cache->storage);
+    set_init(&cache->entries, starting_capacity, &ir_gen_sf_cache_hash, &ir_gen_sf_cache_equals, NULL);
+    arena_init(&cache->entries_arena, sizeof(ir_gen_sf_cache_entry_t) * 128);
 }
 
+void ir_gen_sf_cache_free(ir_gen_sf_cache_t *cache){
+    set_free(&cache->entries, NULL);
+    arena_free(&cache->entries_arena);
+}
 
 errorcode_t ir_gen_sf_cache_read(troolean has, func_pair_t maybe_pair, optional_func_pair_t *result){
     switch(has){
@@ -52,51 +52,380 @@ errorcode_t ir_gen_sf_cache_read(troolean has, func_pair_t maybe_pair, optional_
     return FAILURE;
 }
 
+ir_gen_sf_cache_entry_t *ir_gen_sf_cache_locate(const ir_gen_sf_cache_t *cache, const ast_type_t *type){
+    const ast_type_t *canonical_type = ast_type_table_find(cache->type_table, type);
+    return canonical_type ? set_find(&cache->entries, &(ir_gen_sf_cache_entry_t){ .ast_type = canonical_type }) : NULL;
+}
+
 ir_gen_sf_cache_entry_t *ir_gen_sf_cache_locate_or_insert(ir_gen_sf_cache_t *cache, ast_type_t *type){
-    hash_t hash = ast_type_hash(type);
-    ir_gen_sf_cache_entry_t *entry = &cache->storage[hash % cache->capacity];
-
-    if(ir_gen_sf_cache_entry_is_occupied(entry)){
-        // Space already occupied, so put it in the linked list
-        // for that space
-
-        while(true){
-            if(ast_types_identical(type, &entry->ast_type)) return entry;
-
-            if(entry->next == NULL){
-                // New entry here
-                entry->next = malloc(sizeof(ir_gen_sf_cache_entry_t));
-                entry = entry->next;
-
-                memset(entry, 0, sizeof(ir_gen_sf_cache_entry_t));
-                entry->ast_type = ast_type_clone(type);
-                entry->has_pass = TROOLEAN_UNKNOWN;
-                entry->has_defer = TROOLEAN_UNKNOWN;
-                entry->has_assign = TROOLEAN_UNKNOWN;
-                return entry;
-            }
-            entry = entry->next;
-        }
+    ir_gen_sf_cache_entry_t probe = (ir_gen_sf_cache_entry_t){
+        .ast_type = ast_type_table_canonical(cache->type_table, type),
+        .has_pass = TROOLEAN_UNKNOWN,
+        .has_defer = TROOLEAN_UNKNOWN,
+        .has_assign = TROOLEAN_UNKNOWN,
+    };
+
+    hash_t hash = ast_canonical_type_hash(probe.ast_type);
+    ir_gen_sf_cache_entry_t *entry = set_find_hashed(&cache->entries, &probe, hash);
+
+    if(entry){
+        cache->hits++;
+        return entry;
     }
 
     // New entry here
-    entry->ast_type = ast_type_clone(type);
-    entry->has_pass = TROOLEAN_UNKNOWN;
-    entry->has_defer = TROOLEAN_UNKNOWN;
-    entry->has_assign = TROOLEAN_UNKNOWN;
+    entry = arena_memclone(&cache->entries_arena, &probe, sizeof probe);
+    set_insert_hashed(&cache->entries, entry, hash);
+    cache->misses++;
     return entry;
 }
 
 void ir_gen_sf_cache_dump(FILE *file, ir_gen_sf_cache_t *sf_cache){
-    for(length_t i = 0; i < sf_cache->capacity; i++){
-        ir_gen_sf_cache_entry_t *entry = &sf_cache->storage[i];
-        if(ir_gen_sf_cache_entry_is_occupied(entry)) fprintf(file, "+");
+    set_t *entries = &sf_cache->entries;
+    length_t lookups = sf_cache->hits + sf_cache->misses;
 
-        while(entry->next){
+    fprintf(file, "[sf cache statistics : %d entries, %d slots, alpha=%f, %d hits, %d misses, hit rate=%f]\n",
+        (int) entries->count,
+        (int) entries->capacity,
+        (double) entries->count / (double) entries->capacity,
+        (int) sf_cache->hits,
+        (int) sf_cache->misses,
+        lookups ? (double) sf_cache->hits / (double) lookups : 0.0
+    );
+
+    for(length_t i = 0; i < entries->capacity; i++){
+        if(entries->entries[i].data == NULL) continue;
+
+        while(i < entries->capacity && entries->entries[i].data){
             fprintf(file, "+");
-            entry = entry->next;
+            i++;
         }
 
         fprintf(file, "\n");
     }
 }
+
+static hash_t ir_gen_poly_cache_hash(const void *raw_entry){
+    // Bindings are summed, so that the order they were discovered in doesn't matter
+    const ir_gen_poly_cache_entry_t *entry = raw_entry;
+    hash_t sum = 0;
+
+    for(length_t i = 0; i != entry->types_length; i++){
+        sum += hash_combine(hash_string(entry->types[i].name), ast_canonical_type_hash(entry->types[i].binding));
+    }
+
+    for(length_t i = 0; i != entry->counts_length; i++){
+        sum += hash_combine(hash_string(entry->counts[i].name), hash_data(&entry->counts[i].binding, sizeof(length_t)));
+    }
+
+    return hash_combine(hash_data(&entry->ast_poly_func_id, sizeof(func_id_t)), sum);
+}
+
+static bool ir_gen_poly_cache_equals(const void *raw_a, const void *raw_b){
+    const ir_gen_poly_cache_entry_t *a = raw_a;
+    const ir_gen_poly_cache_entry_t *b = raw_b;
+
+    if(a->ast_poly_func_id != b->ast_poly_func_id
+    || a->types_length != b->types_length
+    || a->counts_length != b->counts_length){
+        return false;
+    }
+
+    // Names are never bound twice, so it's enough for every binding of 'a' to be in 'b'
+    // Canonical types are identical only if they are the same
+    for(length_t i = 0; i != a->types_length; i++){
+        length_t j = 0;
+
+        while(j != b->types_length && !streq(b->types[j].name, a->types[i].name)) j++;
+
+        if(j == b->types_length || b->types[j].binding != a->types[i].binding){
+            return false;
+        }
+    }
+
+    for(length_t i = 0; i != a->counts_length; i++){
+        length_t j = 0;
+
+        while(j != b->counts_length && !streq(b->counts[j].name, a->counts[i].name)) j++;
+
+        if(j == b->counts_length || b->counts[j].binding != a->counts[i].binding){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void ir_gen_poly_cache_init(ir_gen_poly_cache_t *cache, ast_type_table_t *type_table, length_t starting_capacity){
+    *cache = (ir_gen_poly_cache_t){
+        .entries_arena = {0},
+        .type_table = type_table,
+        .reused = 0,
+        .created = 0,
+    };
+
+    set_init(&cache->entries, starting_capacity, &ir_gen_poly_cache_hash, &ir_gen_poly_cache_equals, NULL);
+    arena_init(&cache->entries_arena, sizeof(ir_gen_poly_cache_entry_t) * 64);
+}
+
+void ir_gen_poly_cache_free(ir_gen_poly_cache_t *cache){
+    set_free(&cache->entries, NULL);
+    arena_free(&cache->entries_arena);
+}
+
+ir_gen_poly_cache_entry_t *ir_gen_poly_cache_locate(const ir_gen_poly_cache_t *cache, func_id_t ast_poly_func_id, ast_poly_catalog_t *catalog){
+    length_t types_length = catalog->types.length;
+    ir_gen_poly_cache_binding_t types[length_max(1, types_length)];
+
+    for(length_t i = 0; i != types_length; i++){
+        ast_poly_catalog_type_t *type = &catalog->types.types[i];
+
+        types[i] = (ir_gen_poly_cache_binding_t){
+            .name = type->name,
+            .binding = ast_type_table_find(cache->type_table, &type->binding),
+        };
+
+        // Bindings that were never seen can't be part of any entry
+        if(types[i].binding == NULL) return NULL;
+    }
+
+    return set_find(&cache->entries, &(ir_gen_poly_cache_entry_t){
+        .ast_poly_func_id = ast_poly_func_id,
+        .types = types,
+        .types_length = types_length,
+        .counts = catalog->counts.counts,
+        .counts_length = catalog->counts.length,
+    });
+}
+
+ir_gen_poly_cache_entry_t *ir_gen_poly_cache_locate_or_insert(ir_gen_poly_cache_t *cache, func_id_t ast_poly_func_id, ast_poly_catalog_t *catalog){
+    length_t types_length = catalog->types.length;
+    ir_gen_poly_cache_binding_t types[length_max(1, types_length)];
+
+    for(length_t i = 0; i != types_length; i++){
+        ast_poly_catalog_type_t *type = &catalog->types.types[i];
+
+        types[i] = (ir_gen_poly_cache_binding_t){
+            .name = type->name,
+            .binding = ast_type_table_canonical(cache->type_table, &type->binding),
+        };
+    }
+
+    ir_gen_poly_cache_entry_t probe = (ir_gen_poly_cache_entry_t){
+        .ast_poly_func_id = ast_poly_func_id,
+        .types = types,
+        .types_length = types_length,
+        .counts = catalog->counts.counts,
+        .counts_length = catalog->counts.length,
+        .instance = (ir_func_endpoint_t){
+            .ast_func_id = INVALID_FUNC_ID,
+            .ir_func_id = INVALID_FUNC_ID,
+        },
+    };
+
+    hash_t hash = ir_gen_poly_cache_hash(&probe);
+    ir_gen_poly_cache_entry_t *entry = set_find_hashed(&cache->entries, &probe, hash);
+    if(entry) return entry;
+
+    // New entry here
+    probe.types = types_length ? arena_memclone(&cache->entries_arena, types, sizeof(ir_gen_poly_cache_binding_t) * types_length) : NULL;
+    probe.counts = probe.counts_length ? arena_memclone(&cache->entries_arena, probe.counts, sizeof(ast_poly_catalog_count_t) * probe.counts_length) : NULL;
+
+    entry = arena_memclone(&cache->entries_arena, &probe, sizeof probe);
+    set_insert_hashed(&cache->entries, entry, hash);
+    return entry;
+}
+
+void ir_gen_poly_cache_dump(FILE *file, ir_gen_poly_cache_t *poly_cache){
+    set_t *entries = &poly_cache->entries;
+    length_t instantiations = poly_cache->reused + poly_cache->created;
+
+    fprintf(file, "[poly cache statistics : %d entries, %d slots, alpha=%f, %d reused, %d created, reuse rate=%f]\n",
+        (int) entries->count,
+        (int) entries->capacity,
+        (double) entries->count / (double) entries->capacity,
+        (int) poly_cache->reused,
+        (int) poly_cache->created,
+        instantiations ? (double) poly_cache->reused / (double) instantiations : 0.0
+    );
+}
+
+static hash_t ir_gen_proc_cache_hash(const void *raw_entry){
+    // NOTE: Keys are hashed field by field, since their padding isn't guaranteed to be zeroed
+    const ir_gen_proc_cache_entry_t *entry = raw_entry;
+    const ir_gen_proc_cache_key_t *key = &entry->key;
+
+    hash_t hash = hash_data(&key->candidates, sizeof key->candidates);
+    hash = hash_combine(hash, hash_data(&key->conform_mode, sizeof key->conform_mode));
+    hash = hash_combine(hash, hash_data(&key->traits_mask, sizeof key->traits_mask));
+    hash = hash_combine(hash, hash_data(&key->traits_match, sizeof key->traits_match));
+    hash = hash_combine(hash, hash_data(&key->forbid_traits, sizeof key->forbid_traits));
+    hash = hash_combine(hash, (hash_t) key->conform << 1 | (hash_t) key->is_method);
+
+    for(length_t i = 0; i != entry->arg_types_length; i++){
+        hash = hash_combine(hash, ast_canonical_type_hash(entry->arg_types[i]));
+    }
+
+    return entry->gives ? hash_combine(hash, ast_canonical_type_hash(entry->gives)) : hash;
+}
+
+static bool ir_gen_proc_cache_equals(const void *raw_a, const void *raw_b){
+    const ir_gen_proc_cache_entry_t *a = raw_a;
+    const ir_gen_proc_cache_entry_t *b = raw_b;
+
+    if(a->key.candidates != b->key.candidates
+    || a->key.conform_mode != b->key.conform_mode
+    || a->key.traits_mask != b->key.traits_mask
+    || a->key.traits_match != b->key.traits_match
+    || a->key.forbid_traits != b->key.forbid_traits
+    || a->key.conform != b->key.conform
+    || a->key.is_method != b->key.is_method
+    || a->arg_types_length != b->arg_types_length
+    || a->gives != b->gives){
+        return false;
+    }
+
+    // Canonical types are identical only if they are the same
+    for(length_t i = 0; i != a->arg_types_length; i++){
+        if(a->arg_types[i] != b->arg_types[i]) return false;
+    }
+
+    return true;
+}
+
+void ir_gen_proc_cache_init(ir_gen_proc_cache_t *cache, ast_type_table_t *type_table, length_t starting_capacity){
+    *cache = (ir_gen_proc_cache_t){
+        .entries_arena = {0},
+        .type_table = type_table,
+        .func_arg_types = NULL,
+        .func_arg_types_length = 0,
+        .hits = 0,
+        .misses = 0,
+    };
+
+    set_init(&cache->entries, starting_capacity, &ir_gen_proc_cache_hash, &ir_gen_proc_cache_equals, NULL);
+    arena_init(&cache->entries_arena, sizeof(ir_gen_proc_cache_entry_t) * 128);
+}
+
+void ir_gen_proc_cache_free(ir_gen_proc_cache_t *cache){
+    set_free(&cache->entries, NULL);
+    arena_free(&cache->entries_arena);
+    free(cache->func_arg_types);
+}
+
+static bool ir_gen_proc_cache_can_locate_type(ast_type_t *type){
+    for(length_t i = 0; i != type->elements_length; i++){
+        if(type->elements[i]->id == AST_ELEM_VAR_FIXED_ARRAY) return false;
+    }
+    return true;
+}
+
+bool ir_gen_proc_cache_can_locate(ast_type_t *arg_types, length_t arg_types_length, ast_type_t *optional_gives){
+    for(length_t i = 0; i != arg_types_length; i++){
+        if(!ir_gen_proc_cache_can_locate_type(&arg_types[i])) return false;
+    }
+
+    return optional_gives == NULL || ir_gen_proc_cache_can_locate_type(optional_gives);
+}
+
+ir_gen_proc_cache_entry_t *ir_gen_proc_cache_locate(
+    const ir_gen_proc_cache_t *cache,
+    const ir_gen_proc_cache_key_t *key,
+    ast_type_t *arg_types,
+    length_t arg_types_length,
+    ast_type_t *optional_gives
+){
+    // Types that were never seen can't be part of any entry
+    const ast_type_t *canonical_arg_types[length_max(1, arg_types_length)];
+
+    for(length_t i = 0; i != arg_types_length; i++){
+        canonical_arg_types[i] = ast_type_table_find(cache->type_table, &arg_types[i]);
+        if(canonical_arg_types[i] == NULL) return NULL;
+    }
+
+    const ast_type_t *gives = optional_gives ? ast_type_table_find(cache->type_table, optional_gives) : NULL;
+    if(optional_gives && gives == NULL) return NULL;
+
+    return set_find(&cache->entries, &(ir_gen_proc_cache_entry_t){
+        .key = *key,
+        .arg_types = canonical_arg_types,
+        .arg_types_length = arg_types_length,
+        .gives = gives,
+    });
+}
+
+ir_gen_proc_cache_entry_t *ir_gen_proc_cache_locate_or_insert(
+    ir_gen_proc_cache_t *cache,
+    const ir_gen_proc_cache_key_t *key,
+    ast_type_t *arg_types,
+    length_t arg_types_length,
+    ast_type_t *optional_gives
+){
+    const ast_type_t *canonical_arg_types[length_max(1, arg_types_length)];
+
+    for(length_t i = 0; i != arg_types_length; i++){
+        canonical_arg_types[i] = ast_type_table_canonical(cache->type_table, &arg_types[i]);
+    }
+
+    ir_gen_proc_cache_entry_t probe = (ir_gen_proc_cache_entry_t){
+        .key = *key,
+        .arg_types = canonical_arg_types,
+        .arg_types_length = arg_types_length,
+        .gives = optional_gives ? ast_type_table_canonical(cache->type_table, optional_gives) : NULL,
+        .candidates_length = 0,
+        .chosen = 0,
+    };
+
+    hash_t hash = ir_gen_proc_cache_hash(&probe);
+    ir_gen_proc_cache_entry_t *entry = set_find_hashed(&cache->entries, &probe, hash);
+    if(entry) return entry;
+
+    // New entry here
+    probe.arg_types = arg_types_length ? arena_memclone(&cache->entries_arena, canonical_arg_types, sizeof(const ast_type_t*) * arg_types_length) : NULL;
+
+    entry = arena_memclone(&cache->entries_arena, &probe, sizeof probe);
+    set_insert_hashed(&cache->entries, entry, hash);
+    return entry;
+}
+
+const ast_type_t **ir_gen_proc_cache_func_arg_types(ir_gen_proc_cache_t *cache, ast_func_t *func, func_id_t ast_func_id, bool may_insert){
+    if(ast_func_id < cache->func_arg_types_length && cache->func_arg_types[ast_func_id]){
+        return cache->func_arg_types[ast_func_id];
+    }
+
+    if(!may_insert || !ir_gen_proc_cache_can_locate(func->arg_types, func->arity, NULL)) return NULL;
+
+    if(ast_func_id >= cache->func_arg_types_length){
+        length_t new_length = length_max(ast_func_id + 1, cache->func_arg_types_length * 2);
+        grow((void**) &cache->func_arg_types, sizeof(const ast_type_t**), new_length);
+
+        for(length_t i = cache->func_arg_types_length; i != new_length; i++){
+            cache->func_arg_types[i] = NULL;
+        }
+
+        cache->func_arg_types_length = new_length;
+    }
+
+    const ast_type_t **arg_types = arena_alloc(&cache->entries_arena, sizeof(const ast_type_t*) * length_max(1, func->arity), sizeof(const ast_type_t*));
+
+    for(length_t i = 0; i != func->arity; i++){
+        arg_types[i] = ast_type_table_canonical(cache->type_table, &func->arg_types[i]);
+    }
+
+    cache->func_arg_types[ast_func_id] = arg_types;
+    return arg_types;
+}
+
+void ir_gen_proc_cache_dump(FILE *file, ir_gen_proc_cache_t *proc_cache){
+    set_t *entries = &proc_cache->entries;
+    length_t lookups = proc_cache->hits + proc_cache->misses;
+
+    fprintf(file, "[proc cache statistics : %d entries, %d slots, alpha=%f, %d hits, %d misses, hit rate=%f]\n",
+        (int) entries->count,
+        (int) entries->capacity,
+        (double) entries->count / (double) entries->capacity,
+        (int) proc_cache->hits,
+        (int) proc_cache->misses,
+        lookups ? (double) proc_cache->hits / (double) lookups : 0.0
+    );
+}
@@ -28,17 +28,18 @@
 #include "IRGEN/ir_gen.h"
 #include "IRGEN/ir_gen_expr.h"
 #include "IRGEN/ir_gen_find.h"
+#include "IRGEN/ir_gen_parallel.h"
 #include "IRGEN/ir_gen_rtti.h"
 #include "IRGEN/ir_gen_stmt.h"
 #include "IRGEN/ir_gen_type.h"
 #include "IRGEN/ir_gen_vtree.h"
 #include "IRGEN/ir_vtree.h"
-#include "LEX/lex.h"
 #include "UTIL/builtin_type.h"
 #include "UTIL/color.h"
 #include "UTIL/datatypes.h"
 #include "UTIL/func_pair.h"
 #include "UTIL/ground.h"
+#include "UTIL/intern.h"
 #include "UTIL/string.h"
 #include "UTIL/string_builder.h"
 #include "UTIL/trait.h"
@@ -58,6 +59,10 @@ errorcode_t ir_gen(compiler_t *compiler, object_t *object){
         || ir_gen_fill_in_rtti(object);
 }
 
+static int compare_ir_method_key_ptrs(const void *a, const void *b){
+    return compare_ir_method_key(*(const ir_method_key_t**) a, *(const ir_method_key_t**) b);
+}
+
 errorcode_t ir_gen_vtables(compiler_t *compiler, object_t *object){
     ast_t *ast = &object->ast;
     ir_module_t *module = &object->ir_module;
@@ -74,9 +79,22 @@ errorcode_t ir_gen_vtables(compiler_t *compiler, object_t *object){
     virtual_addition_list_t additions = {0};
     ir_job_list_t recent_jobs = {0};
 
+    // Visit methods in order of struct name and then method name, so that vtrees are created
+    // in the same order no matter what order methods were declared in
+    // (the method map itself is in insertion order)
+    // NOTE: The layout of each vtable doesn't depend on this, since 'vtree_append_virtual'
+    // keeps virtual methods in the order they were declared in
+    const ir_method_key_t **method_keys = malloc(sizeof(const ir_method_key_t*) * length_max(1, method_map.length));
+
+    for(length_t i = 0; i != method_map.length; i++){
+        method_keys[i] = ir_proc_map_key_at(&method_map, i);
+    }
+
+    qsort(method_keys, method_map.length, sizeof(const ir_method_key_t*), &compare_ir_method_key_ptrs);
+
     // Collect all concrete virtual methods along with determining root classes
     for(length_t i = 0; i != method_map.length; i++){
-        ir_func_endpoint_list_t *endpoint_list = method_map.endpoint_lists[i];
+        ir_func_endpoint_list_t *endpoint_list = ir_proc_map_find(&module->method_map, method_keys[i]);
         
         for(length_t i = 0; i != endpoint_list->length; i++){
             ir_func_endpoint_t endpoint = endpoint_list->endpoints[i];
@@ -90,6 +108,8 @@ errorcode_t ir_gen_vtables(compiler_t *compiler, object_t *object){
         }
     }
 
+    free(method_keys);
+
     // Grab all remaining descendent classes of root classes by examining all existing concrete class constructors
     for(length_t i = 0; i != ast->funcs_length; i++){
         ast_func_t *func = &ast->funcs[i];
@@ -324,6 +344,11 @@ errorcode_t ir_gen_functions(compiler_t *compiler, object_t *object){
         }
     }
 
+    // Only generate the bodies of functions that are actually used
+    if(compiler->traits & COMPILER_LAZY_IR){
+        ir_gen_defer_unreached_functions(object);
+    }
+
     // Generate function aliases
     trait_t req_traits_mask = AST_FUNC_VARARG | AST_FUNC_VARIADIC;
     for(length_t i = 0; i != ast->func_aliases_length; i++){
@@ -359,7 +384,7 @@ errorcode_t ir_gen_functions(compiler_t *compiler, object_t *object){
             .ir_func_id = pair.ir_func_id,
         };
         
-        ir_module_create_func_mapping(ir_module, falias->from, endpoint, false);
+        ir_module_create_func_mapping(ir_module, intern_name(falias->from), endpoint, false);
     }
 
     errorcode_t error;
@@ -371,9 +396,37 @@ errorcode_t ir_gen_functions(compiler_t *compiler, object_t *object){
     return SUCCESS;
 }
 
+void ir_gen_defer_unreached_functions(object_t *object){
+    ast_func_t *ast_funcs = object->ast.funcs;
+    ir_module_t *module = &object->ir_module;
+    ir_job_list_t *job_list = &module->job_list;
+
+    // Functions that can be entered without being referenced from IR
+    const trait_t root_traits = AST_FUNC_FOREIGN | AST_FUNC_MAIN | AST_FUNC_WINMAIN | AST_FUNC_INIT | AST_FUNC_DEINIT | AST_FUNC_VIRTUAL | AST_FUNC_OVERRIDE;
+
+    length_t kept = 0;
+
+    for(length_t i = 0; i != job_list->length; i++){
+        ir_func_endpoint_t job = job_list->jobs[i];
+        ast_func_t *ast_func = &ast_funcs[job.ast_func_id];
+
+        if(ast_func->traits & root_traits || ast_func->export_as){
+            job_list->jobs[kept++] = job;
+        } else {
+            // Wait for 'ir_module_reach_func' to queue it
+            module->funcs.funcs[job.ir_func_id].traits |= IR_FUNC_UNREACHED;
+        }
+    }
+
+    job_list->length = kept;
+}
+
 errorcode_t ir_gen_func_template(compiler_t *compiler, object_t *object, weak_cstr_t name, source_t from_source, func_id_t *out_ir_func_id){
     ir_module_t *module = &object->ir_module;
 
+    // Speculative function bodies can't create functions
+    if(ir_gen_speculation_abort()) return FAILURE;
+
     if(module->funcs.length >= MAX_FUNC_ID){
         compiler_panic(compiler, from_source, "Maximum number of IR functions reached\n");
         return FAILURE;
@@ -401,6 +454,7 @@ errorcode_t ir_gen_func_head(compiler_t *compiler, object_t *object, ast_func_t
     ir_func_t *module_func = &module->funcs.funcs[ir_func_id];
 
     module_func->export_as = ast_func->export_as;
+    module_func->ast_func_id = ast_func_id;
     module_func->argument_types = malloc(sizeof(ir_type_t*) * (ast_func->traits & AST_FUNC_VARIADIC ? ast_func->arity + 1 : ast_func->arity));
 
     module_func->maybe_definition_string = ir_gen_ast_definition_string(&module->pool, ast_func);        
@@ -408,7 +462,7 @@ errorcode_t ir_gen_func_head(compiler_t *compiler, object_t *object, ast_func_t
 
     if(compiler->checks & COMPILER_NULL_CHECKS){
         int line, column;
-        lex_get_location(compiler->objects[ast_func->source.object_index]->buffer, ast_func->source.index, &line, &column);
+        object_get_location(compiler->objects[ast_func->source.object_index], ast_func->source.index, &line, &column);
         module_func->maybe_line_number = line;
         module_func->maybe_column_number = column;
     }
@@ -579,6 +633,10 @@ errorcode_t ir_gen_auxiliary_builders(compiler_t *compiler, object_t *object){
 errorcode_t ir_gen_functions_body(compiler_t *compiler, object_t *object, ir_job_list_t *optional_out_completed_jobs){
     // NOTE: Only ir_gens function body; assumes skeleton already exists
 
+    if(compiler->threads > 1){
+        return ir_gen_functions_body_parallel(compiler, object, optional_out_completed_jobs);
+    }
+
     ast_func_t **ast_funcs = &object->ast.funcs;
     ir_job_list_t *job_list = &object->ir_module.job_list;
 
@@ -615,6 +673,10 @@ errorcode_t ir_gen_functions_body_statements(compiler_t *compiler, object_t *obj
     bool is_init_like = ast_func.traits & AST_FUNC_MAIN || ast_func.traits & AST_FUNC_WINMAIN || ast_func.traits & AST_FUNC_INIT;
     bool is_deinit_like = ast_func.traits & AST_FUNC_MAIN || ast_func.traits & AST_FUNC_WINMAIN || ast_func.traits & AST_FUNC_DEINIT;
 
+    // Speculative function bodies can't use the global initialization/cleanup builders
+    ir_gen_speculation_t *speculation = ir_gen_speculation_current();
+    if((is_init_like || is_deinit_like) && ir_gen_speculation_abort()) return FAILURE;
+
     bool show_is_empty_warning = ast_func.statements.length == 0
                               && !(ast_func.traits & AST_FUNC_GENERATED)
                               && !(ast_func.traits & AST_FUNC_CLASS_CONSTRUCTOR)
@@ -632,6 +694,15 @@ errorcode_t ir_gen_functions_body_statements(compiler_t *compiler, object_t *obj
     ir_builder_t builder;
     ir_builder_init(&builder, compiler, object, ast_func_id, ir_func_id, false);
 
+    // Root scope of the function
+    bridge_scope_t *scope = builder.scope;
+
+    if(speculation){
+        ir_gen_speculation_attach(speculation, &builder);
+    } else {
+        ir_funcs->funcs[ir_func_id].scope = scope;
+    }
+
     for(length_t i = 0; i != ast_func.arity; i++){
         trait_t arg_traits = BRIDGE_VAR_UNDEF;
 
@@ -656,7 +727,7 @@ errorcode_t ir_gen_functions_body_statements(compiler_t *compiler, object_t *obj
         ast_type_t subject_type = ast_type_dereferenced_view(&ast_func.arg_types[0]);
         
         // Find 'this' argument
-        bridge_var_t *bridge_var = bridge_scope_find_var(builder.scope, "this");
+        bridge_var_t *bridge_var = bridge_scope_find_var(builder.scope, intern_name("this"));
         assert(bridge_var);
 
         // Get value of 'this'
@@ -679,7 +750,7 @@ errorcode_t ir_gen_functions_body_statements(compiler_t *compiler, object_t *obj
         assert(store_instr->id == INSTRUCTION_STORE);
 
         // Append vtable initialization for later processing
-        ir_vtable_init_list_append(&builder.object->ir_module.vtable_init_list, ((ir_vtable_init_t){
+        ir_vtable_init_list_append(builder.vtable_init_list, ((ir_vtable_init_t){
             .store_instr = store_instr,
             .subject_type = ast_type_clone(&subject_type),
         }));
@@ -687,7 +758,7 @@ errorcode_t ir_gen_functions_body_statements(compiler_t *compiler, object_t *obj
 
     if(ast_func.traits & AST_FUNC_DISPATCHER){
         // Find 'this' argument
-        bridge_var_t *bridge_var = bridge_scope_find_var(builder.scope, "this");
+        bridge_var_t *bridge_var = bridge_scope_find_var(builder.scope, intern_name("this"));
         assert(bridge_var);
 
         // Get value of 'this'
@@ -739,7 +810,7 @@ errorcode_t ir_gen_functions_body_statements(compiler_t *compiler, object_t *obj
             .index_value = index,
         };
 
-        ir_vtable_dispatch_list_append(&builder.object->ir_module.vtable_dispatch_list, dispatch);
+        ir_vtable_dispatch_list_append(builder.vtable_dispatch_list, dispatch);
         goto success;
     }
 
@@ -790,13 +861,22 @@ errorcode_t ir_gen_functions_body_statements(compiler_t *compiler, object_t *obj
     }
 
 success:
-    ir_funcs->funcs[ir_func_id].scope->following_var_id = builder.next_var_id;
-    ir_funcs->funcs[ir_func_id].variable_count = builder.next_var_id;
+    scope->following_var_id = builder.next_var_id;
     errorcode = SUCCESS;
 
 failure:
-    ir_funcs->funcs[ir_func_id].basicblocks = builder.basicblocks;
-    object->ast.funcs[ast_func_id] = ast_func;
+    if(speculation){
+        // Kept until the function body is either committed or discarded
+        speculation->ast_func = ast_func;
+        speculation->basicblocks = builder.basicblocks;
+        speculation->scope = scope;
+        speculation->variable_count = errorcode == SUCCESS ? builder.next_var_id : 0;
+    } else {
+        if(errorcode == SUCCESS) ir_funcs->funcs[ir_func_id].variable_count = builder.next_var_id;
+        ir_funcs->funcs[ir_func_id].basicblocks = builder.basicblocks;
+        object->ast.funcs[ast_func_id] = ast_func;
+    }
+
     free(builder.block_stack.blocks);
     return errorcode;
 }
@@ -871,6 +951,7 @@ errorcode_t ir_gen_build_rtti_table(object_t *object){
 
     ir_module->rtti_table = ir_pool_alloc(&ir_module->pool, sizeof(rtti_table_t));
     *ir_module->rtti_table = rtti_table_create(rtti_collector, &object->ast);
+    rtti_collector_free(&rtti_collector);
     return SUCCESS;
 }
 
@@ -914,7 +995,7 @@ errorcode_t ir_gen_special_global(compiler_t *compiler, object_t *object, ast_gl
     if(ast_global->traits & AST_GLOBAL___TYPE_KINDS__){
         ir_type_t *ubyte_ptr_type, *ubyte_ptr_ptr_type;
 
-        if(!ir_type_map_find(&ir_module->type_map, "ubyte", &ubyte_ptr_type)){
+        if(!ir_type_map_find(&ir_module->type_map, intern_name("ubyte"), &ubyte_ptr_type)){
             internalerrorprintf("ir_gen_special_global() - Failed to find critical 'ubyte' type used by the runtime type table that should exist\n");
             return FAILURE;
         }
@@ -1268,6 +1349,8 @@ void bad_printf_format(compiler_t *compiler, source_t source, ast_type_t *given_
     if(specifier == 'z') additional_part = "u";
 
     compiler_panicf(compiler, source, "Got value of incorrect type for format specifier '%%%s%c%s'", modifiers, specifier, additional_part);
+    if(ir_gen_speculating()) return;
+
     printf("\n");
 
     strong_cstr_t incorrect_type = ast_type_str(given_type);
@@ -5,6 +5,7 @@
 
 #include "AST/POLY/ast_resolve.h"
 #include "AST/TYPE/ast_type_identical.h"
+#include "AST/TYPE/ast_type_table.h"
 #include "AST/ast.h"
 #include "AST/ast_expr_lean.h"
 #include "AST/ast_poly_catalog.h"
@@ -34,6 +35,22 @@ successful_t func_args_match(ast_func_t *func, ast_type_t *type_list, length_t t
     return ast_type_lists_identical(arg_types, type_list, arity);
 }
 
+successful_t func_args_match_canonical(ast_func_t *func, const ast_type_t **func_arg_types, const ast_type_t **type_list, length_t type_list_length){
+    length_t arity = func->arity;
+
+    if(func->traits & AST_FUNC_VARARG){
+        if(type_list_length < arity) return false;
+    } else {
+        if(type_list_length != arity) return false;
+    }
+
+    for(length_t i = 0; i != arity; i++){
+        if(!ast_canonical_types_identical(func_arg_types[i], type_list[i])) return false;
+    }
+
+    return true;
+}
+
 successful_t func_args_conform(ir_builder_t *builder, ast_func_t *func, ir_value_t **arg_value_list,
             ast_type_t *arg_type_list, length_t type_list_length, ast_type_t *gives, trait_t conform_mode){
 
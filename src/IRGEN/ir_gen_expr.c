@@ -32,6 +32,7 @@
 #include "IRGEN/ir_gen.h"
 #include "IRGEN/ir_gen_expr.h"
 #include "IRGEN/ir_gen_find.h"
+#include "IRGEN/ir_gen_parallel.h"
 #include "IRGEN/ir_gen_qualifiers.h"
 #include "IRGEN/ir_gen_stmt.h"
 #include "IRGEN/ir_gen_type.h"
@@ -40,6 +41,7 @@
 #include "UTIL/datatypes.h"
 #include "UTIL/func_pair.h"
 #include "UTIL/ground.h"
+#include "UTIL/intern.h"
 #include "UTIL/string.h"
 #include "UTIL/string_list.h"
 #include "UTIL/trait.h"
@@ -66,13 +68,14 @@ errorcode_t ir_gen_expr(ir_builder_t *builder, ast_expr_t *expr, ir_value_t **ir
         (*ir_value)->value_type = VALUE_TYPE_LITERAL;                                    \
                                                                                          \
         /* Store the literal value and resolve the IR type */                            \
-        ir_type_map_find(builder->type_map, typename, &((*ir_value)->type));             \
+        weak_cstr_t type_atom = intern_name(typename);                                   \
+        ir_type_map_find(builder->type_map, type_atom, &((*ir_value)->type));            \
         (*ir_value)->extra = ir_pool_alloc(builder->pool, sizeof(storage_type));         \
         *((storage_type*) (*ir_value)->extra) = ((ast_expr_type*) expr)->value;          \
                                                                                          \
         /* Result type is an AST type with that typename */                              \
         if(out_expr_type != NULL){                                                       \
-            *out_expr_type = ast_type_make_base(strclone(typename));                     \
+            *out_expr_type = ast_type_make_base(type_atom);                              \
         }\
     }
 
@@ -116,7 +119,7 @@ errorcode_t ir_gen_expr(ir_builder_t *builder, ast_expr_t *expr, ir_value_t **ir
     #undef build_literal_ir_value
     case EXPR_NULL:
         if(out_expr_type != NULL){
-            *out_expr_type = ast_type_make_base(strclone("ptr"));
+            *out_expr_type = ast_type_make_base("ptr");
         }
 
         *ir_value = build_null_pointer(builder->pool);
@@ -326,7 +329,7 @@ errorcode_t ir_gen_expr_pre_andor(ir_builder_t *builder, ast_expr_math_t *andor_
         return FAILURE;
     }
 
-    ast_type_t bool_ast_type = ast_type_make_base(strclone("bool"));
+    ast_type_t bool_ast_type = ast_type_make_base("bool");
 
     // Force 'a' value to be a boolean
     if(!ast_types_identical(&ast_type_a, &bool_ast_type) && !ast_types_conform(builder, a, &ast_type_a, &bool_ast_type, CONFORM_MODE_CALCULATION)){
@@ -380,7 +383,7 @@ errorcode_t ir_gen_expr_str(ir_builder_t *builder, ast_expr_str_t *expr, ir_valu
     
     // Has type of 'String'
     if(out_expr_type != NULL){
-        *out_expr_type = ast_type_make_base(strclone("String"));
+        *out_expr_type = ast_type_make_base("String");
     }
 
     return SUCCESS;
@@ -391,7 +394,7 @@ errorcode_t ir_gen_expr_cstr(ir_builder_t *builder, ast_expr_cstr_t *expr, ir_va
 
     // Has type of '*ubyte'
     if(out_expr_type != NULL){
-        *out_expr_type = ast_type_make_base_ptr(strclone("ubyte"));
+        *out_expr_type = ast_type_make_base_ptr("ubyte");
     }
 
     return SUCCESS;
@@ -446,7 +449,7 @@ errorcode_t ir_gen_expr_variable(ir_builder_t *builder, ast_expr_variable_t *exp
 
     // No suitable variable or global variable found
     compiler_panicf(builder->compiler, ((ast_expr_variable_t*) expr)->source, "Undeclared variable '%s'", variable_name);
-    const char *nearest = bridge_scope_var_nearest(builder->scope, variable_name);
+    const char *nearest = ir_gen_speculating() ? NULL : bridge_scope_var_nearest(builder->scope, variable_name);
     if(nearest) printf("\nDid you mean '%s'?\n", nearest);
     return FAILURE;
 }
@@ -472,7 +475,9 @@ errorcode_t ir_gen_expr_call(ir_builder_t *builder, ast_expr_call_t *expr, ir_va
     ir_type_t *tmp_ir_variable_type;
 
     // Check for variable of name in nearby scope
-    bridge_var_t *var = bridge_scope_find_var(builder->scope, expr->name);
+    // (names that were never interned can't belong to any variable)
+    maybe_null_weak_cstr_t var_name = intern_name_find(expr->name);
+    bridge_var_t *var = var_name ? bridge_scope_find_var(builder->scope, var_name) : NULL;
     bool is_var_function_like = var && ast_type_is_func(var->ast_type);
 
     // Found variable of name in nearby scope
@@ -500,7 +505,7 @@ errorcode_t ir_gen_expr_call(ir_builder_t *builder, ast_expr_call_t *expr, ir_va
         // The function pointer couldn't be called, but the call is tentative, so we pretend like it didn't happen
         if(error == ALT_FAILURE){
             if(out_expr_type != NULL){
-                *out_expr_type = ast_type_make_base(strclone("void"));
+                *out_expr_type = ast_type_make_base("void");
             }
 
             return SUCCESS;
@@ -535,7 +540,7 @@ errorcode_t ir_gen_expr_call(ir_builder_t *builder, ast_expr_call_t *expr, ir_va
             }
 
             if(out_expr_type != NULL){
-                *out_expr_type = ast_type_make_base(strclone("void"));
+                *out_expr_type = ast_type_make_base("void");
             }
 
             ast_types_free_fully(arg_types, arg_arity);
@@ -562,7 +567,7 @@ errorcode_t ir_gen_expr_call(ir_builder_t *builder, ast_expr_call_t *expr, ir_va
         // If requires implicit, fail if conforming function isn't marked as implicit
         if(expr->only_implicit && expr->is_tentative && !(ast_func_traits & AST_FUNC_IMPLICIT)){
             if(out_expr_type != NULL){
-                *out_expr_type = ast_type_make_base(strclone("void"));
+                *out_expr_type = ast_type_make_base("void");
             }
 
             ast_types_free_fully(arg_types, arg_arity);
@@ -639,7 +644,7 @@ errorcode_t ir_gen_expr_call(ir_builder_t *builder, ast_expr_call_t *expr, ir_va
             // Ignore failure if the call expression is tentative
             if(expr->is_tentative){
                 if(out_expr_type != NULL){
-                    *out_expr_type = ast_type_make_base(strclone("void"));
+                    *out_expr_type = ast_type_make_base("void");
                 }
 
                 ast_types_free_fully(arg_types, arg_arity);
@@ -668,7 +673,7 @@ errorcode_t ir_gen_expr_call(ir_builder_t *builder, ast_expr_call_t *expr, ir_va
         // If calling the function pointer value failed, but the call was tentative, then ignore the failure
         if(error == ALT_FAILURE){
             if(out_expr_type != NULL){
-                *out_expr_type = ast_type_make_base(strclone("void"));
+                *out_expr_type = ast_type_make_base("void");
             }
 
             return SUCCESS;
@@ -695,7 +700,7 @@ errorcode_t ir_gen_expr_call(ir_builder_t *builder, ast_expr_call_t *expr, ir_va
     // If the call expression was tentative, then ignore the failure
     if(expr->is_tentative){
         if(out_expr_type != NULL){
-            *out_expr_type = ast_type_make_base(strclone("void"));
+            *out_expr_type = ast_type_make_base("void");
         }
 
         ast_types_free_fully(arg_types, arg_arity);
@@ -712,7 +717,7 @@ errorcode_t ir_gen_expr_super(ir_builder_t *builder, ast_expr_super_t *expr, ir_
     // super(a, b, c, d)  ->  (this as Super).__constructor__(a, b, c); this.__vtable__ = <__vtable__>
 
     // Find 'this' argument
-    bridge_var_t *bridge_var = bridge_scope_find_var(builder->scope, "this");
+    bridge_var_t *bridge_var = bridge_scope_find_var(builder->scope, intern_name("this"));
     assert(bridge_var);
 
     ast_type_t subject_type = ast_type_dereferenced_view(bridge_var->ast_type);
@@ -760,7 +765,7 @@ errorcode_t ir_gen_expr_super(ir_builder_t *builder, ast_expr_super_t *expr, ir_
         assert(store_instr->id == INSTRUCTION_STORE);
 
         // Append vtable initialization for later processing
-        ir_vtable_init_list_append(&builder->object->ir_module.vtable_init_list, ((ir_vtable_init_t){
+        ir_vtable_init_list_append(builder->vtable_init_list, ((ir_vtable_init_t){
             .store_instr = store_instr,
             .subject_type = ast_type_clone(&subject_type),
         }));
@@ -768,7 +773,7 @@ errorcode_t ir_gen_expr_super(ir_builder_t *builder, ast_expr_super_t *expr, ir_
         *ir_value = NULL;
 
         if(out_expr_type != NULL){
-            *out_expr_type = ast_type_make_base(strclone("void"));
+            *out_expr_type = ast_type_make_base("void");
         }
     }
 
@@ -863,7 +868,7 @@ errorcode_t ir_gen_expr_call_procedure_handle_variadic_packing(ir_builder_t *bui
 
     // Obtain IR type of '*AnyType' type if typeinfo is enabled
     if(!(builder->compiler->traits & COMPILER_NO_TYPEINFO)){
-        ast_type_t any_type = ast_type_make_base_ptr(strclone("AnyType"));
+        ast_type_t any_type = ast_type_make_base_ptr("AnyType");
 
         if(ir_gen_resolve_type(builder->compiler, builder->object, &any_type, &pAnyType_ir_type)){
             ast_type_free(&any_type);
@@ -1308,7 +1313,7 @@ errorcode_t ir_gen_expr_initlist(ir_builder_t *builder, ast_expr_initlist_t *exp
         .ir_value = build_literal_usize(builder->pool, expr->length),
         .source = NULL_SOURCE,
         .is_mutable = false,
-        .type = ast_type_make_base(strclone("usize")),
+        .type = ast_type_make_base("usize"),
     };
 
     // Setup AST values to call special function
@@ -1341,7 +1346,7 @@ errorcode_t ir_gen_expr_initlist(ir_builder_t *builder, ast_expr_initlist_t *exp
 
     if(ast_type_is_void(&temporary_type)){
         compiler_panicf(builder->compiler, expr->source, "__initializer_list__ must be defined in order to use initializer lists");
-        printf("\nTry importing '%s/InitializerList.adept'\n", ADEPT_VERSION_STRING);
+        if(!ir_gen_speculating()) printf("\nTry importing '%s/InitializerList.adept'\n", ADEPT_VERSION_STRING);
         ast_type_free(&temporary_type);
         return FAILURE;
     }
@@ -1424,6 +1429,7 @@ errorcode_t ir_gen_expr_func_addr(ir_builder_t *builder, ast_expr_func_addr_t *e
         *ir_value = build_func_addr_by_name(builder->pool, ir_funcptr_type, expr->name);
     } else {
         *ir_value = build_func_addr(builder->pool, ir_funcptr_type, pair.ir_func_id);
+        ir_builder_reach_func(builder, pair.ir_func_id);
     }
 
     // Write resulting type if requested
@@ -1450,7 +1456,7 @@ fail_tentatively:
     *ir_value = build_null_pointer(builder->pool);
 
     if(out_expr_type != NULL){
-        *out_expr_type = ast_type_make_base(strclone("ptr"));
+        *out_expr_type = ast_type_make_base("ptr");
     }
 
     return SUCCESS;
@@ -1490,7 +1496,7 @@ errorcode_t ir_gen_expr_func_addr_noop_result_for_defer(ir_builder_t *builder, a
         args[0] = ast_type_clone(match_arg);
 
         ast_type_t *void_ast_type = malloc(sizeof(ast_type_t));
-        *void_ast_type = ast_type_make_base(strclone("void"));
+        *void_ast_type = ast_type_make_base("void");
 
         *out_expr_type = ast_type_make_func_ptr(source_on_error, args, 1, void_ast_type, TRAIT_NONE, true);
     }
@@ -1673,7 +1679,7 @@ errorcode_t ir_gen_expr_sizeof(ir_builder_t *builder, ast_expr_sizeof_t *expr, i
 
     // Return type is always usize
     if(out_expr_type != NULL){
-        *out_expr_type = ast_type_make_base(strclone("usize"));
+        *out_expr_type = ast_type_make_base("usize");
     }
 
     return SUCCESS;
@@ -1716,7 +1722,7 @@ errorcode_t ir_gen_expr_sizeof_value(ir_builder_t *builder, ast_expr_sizeof_valu
 
     // Return type is always usize
     if(out_expr_type != NULL){
-        *out_expr_type = ast_type_make_base(strclone("usize"));
+        *out_expr_type = ast_type_make_base("usize");
     }
 
     return SUCCESS;
@@ -1784,7 +1790,7 @@ errorcode_t ir_gen_expr_call_method(ir_builder_t *builder, ast_expr_call_method_
 
         if(expr->is_tentative){
             if(out_expr_type != NULL){
-                *out_expr_type = ast_type_make_base(strclone("void"));
+                *out_expr_type = ast_type_make_base("void");
             }
 
             ast_types_free_fully(arg_types, 1);
@@ -1823,7 +1829,7 @@ errorcode_t ir_gen_expr_call_method(ir_builder_t *builder, ast_expr_call_method_
 
         // The method call is tentative, so ignore the failure
         if(out_expr_type != NULL){
-            *out_expr_type = ast_type_make_base(strclone("void"));
+            *out_expr_type = ast_type_make_base("void");
         }
 
         return SUCCESS;
@@ -1836,7 +1842,7 @@ errorcode_t ir_gen_expr_call_method(ir_builder_t *builder, ast_expr_call_method_
         ast_types_free_fully(arg_types, arg_arity);
 
         if(out_expr_type != NULL){
-            *out_expr_type = ast_type_make_base(strclone("void"));
+            *out_expr_type = ast_type_make_base("void");
         }
 
         return SUCCESS;
@@ -1950,7 +1956,7 @@ errorcode_t ir_gen_expr_unary(ir_builder_t *builder, ast_expr_unary_t *expr, ir_
 
         // Result type is bool
         if(out_expr_type != NULL){
-            *out_expr_type = ast_type_make_base(strclone("bool"));
+            *out_expr_type = ast_type_make_base("bool");
         }
     } else {
         // Build '-' or '~'
@@ -2057,7 +2063,7 @@ errorcode_t ir_gen_expr_new_cstring(ir_builder_t *builder, ast_expr_new_cstring_
 
     // Result type is *ubyte
     if(out_expr_type != NULL){
-        *out_expr_type = ast_type_make_base_ptr(strclone("ubyte"));
+        *out_expr_type = ast_type_make_base_ptr("ubyte");
     }
 
     *ir_value = result;
@@ -2092,7 +2098,7 @@ errorcode_t ir_gen_expr_enum_value(compiler_t *compiler, object_t *object, ast_e
 
     // Result type is the enum
     if(out_expr_type != NULL){
-        *out_expr_type = ast_type_make_base(strclone(expr->enum_name));
+        *out_expr_type = ast_type_make_base(expr->enum_name);
     }
 
     return SUCCESS;
@@ -2220,6 +2226,9 @@ errorcode_t ir_gen_expr_static_struct(ir_builder_t *builder, ast_expr_static_dat
         ast_type_free(&member_type);
     }
 
+    // Speculative function bodies can't add anonymous globals to the module
+    if(ir_gen_speculation_abort()) return FAILURE;
+
     // Build struct literal IR value
     *ir_value = build_struct_literal(&builder->object->ir_module, type, values, length, true);
 
@@ -2245,7 +2254,7 @@ errorcode_t ir_gen_expr_typeinfo(ir_builder_t *builder, ast_expr_typeinfo_t *exp
 
     // Result type is *AnyType
     if(out_expr_type != NULL){
-        *out_expr_type = ast_type_make_base_ptr(strclone("AnyType"));
+        *out_expr_type = ast_type_make_base_ptr("AnyType");
     }
 
     return SUCCESS;
@@ -2530,7 +2539,9 @@ errorcode_t ir_gen_expr_inline_declare(ir_builder_t *builder, ast_expr_inline_de
     bool is_assign_pod = def->traits & AST_EXPR_DECLARATION_ASSIGN_POD;
 
     // Ensure no variable with the same name already exists in this scope
-    if(bridge_scope_var_already_in_list(builder->scope, def->name)){
+    maybe_null_weak_cstr_t name = intern_name_find(def->name);
+
+    if(name && bridge_scope_var_already_in_list(builder->scope, name)){
         compiler_panicf(builder->compiler, def->source, "Variable '%s' already declared", def->name);
         return FAILURE;
     }
@@ -2602,7 +2613,7 @@ errorcode_t ir_gen_expr_typenameof(ir_builder_t *builder, ast_expr_typenameof_t
     *ir_value = build_literal_cstr_of_size(builder, name, size);
 
     if(out_expr_type != NULL){
-        *out_expr_type = ast_type_make_base_ptr(strclone("ubyte"));
+        *out_expr_type = ast_type_make_base_ptr("ubyte");
     }
 
     return SUCCESS;
@@ -2618,10 +2629,10 @@ errorcode_t ir_gen_expr_embed(ir_builder_t *builder, ast_expr_embed_t *expr, ir_
     }
     
     *ir_value = build_literal_str(builder, array, length);
-    ir_module_defer_free(&builder->object->ir_module, array);
+    free_list_append(builder->defer_free, array);
 
     if(out_expr_type != NULL){
-        *out_expr_type = ast_type_make_base(strclone("String"));
+        *out_expr_type = ast_type_make_base("String");
     }
 
     return SUCCESS;
@@ -2638,7 +2649,7 @@ errorcode_t ir_gen_expr_alignof(ir_builder_t *builder, ast_expr_alignof_t *expr,
 
     // Return type is always usize
     if(out_expr_type != NULL){
-        *out_expr_type = ast_type_make_base(strclone("usize"));
+        *out_expr_type = ast_type_make_base("usize");
     }
 
     return SUCCESS;
@@ -2752,7 +2763,7 @@ errorcode_t ir_gen_math(
     // Write the result type, will either be a boolean or the same type as the given arguments
     if(out_expr_type != NULL){
         if(info->result_is_boolean){
-            *out_expr_type = ast_type_make_base(strclone("bool"));
+            *out_expr_type = ast_type_make_base("bool");
             ast_type_free(&common_ast_type);
         } else {
             *out_expr_type = common_ast_type;
@@ -2821,6 +2832,8 @@ errorcode_t ir_gen_call_function_value(ir_builder_t *builder, ast_type_t *tmp_as
 
         if(!ir_types_identical(param_types[i], arg_values[i]->type)){
             compiler_panic(builder->compiler, call->source, "INTERNAL ERROR: Expected actual and calling argument types to be the same");
+            if(ir_gen_speculating()) return FAILURE;
+
             strong_cstr_t a = ir_type_str(param_types[i]);
             strong_cstr_t b = ir_type_str(arg_values[i]->type);
             printf("Expected: %s vs Actual: %s for argument #%d\n", a, b, 1 + (int) i);
@@ -17,14 +17,17 @@
 #include "IR/ir_proc_query.h"
 #include "IR/ir_value.h"
 #include "IRGEN/ir_builder.h"
+#include "IRGEN/ir_cache.h"
 #include "IRGEN/ir_gen_args.h"
 #include "IRGEN/ir_gen_expr.h"
 #include "IRGEN/ir_gen_find.h"
+#include "IRGEN/ir_gen_parallel.h"
 #include "IRGEN/ir_gen_polymorphable.h"
 #include "IRGEN/ir_gen_type.h"
 #include "UTIL/color.h"
 #include "UTIL/func_pair.h"
 #include "UTIL/ground.h"
+#include "UTIL/intern.h"
 #include "UTIL/trait.h"
 
 static const trait_t normal_forbidden_traits = AST_FUNC_VIRTUAL | AST_FUNC_OVERRIDE;
@@ -205,7 +208,7 @@ static errorcode_t actualize_suitable_polymorphic(ir_proc_query_t *query, option
         compiler_panicf(compiler, poly_func->source, "Cannot instantiate polymorphic function with given types", display);
 
         if(SOURCE_IS_NULL(query->from_source)){
-            errorprintf("Could not instantiate `%s` due to errors\n", display);
+            if(!ir_gen_speculation_abort()) errorprintf("Could not instantiate `%s` due to errors\n", display);
         } else {
             compiler_panicf(compiler, query->from_source, "Could not instantiate `%s` due to errors", display);
         }
@@ -279,7 +282,16 @@ static errorcode_t ir_gen_find_proc_sweep_partial(ir_proc_query_t *query, option
         if(query->conform){
             was_successful = func_args_conform(query->conform_params.builder, ast_func, arg_values, arg_types, arg_types_length, query->optional_gives, conform_mode_if_applicable);
         } else {
-            was_successful = func_args_match(ast_func, arg_types, arg_types_length);
+            // Canonical argument types can mostly be compared by pointer
+            const ast_type_t **canonical_func_arg_types = query->canonical_arg_types
+                ? ir_gen_proc_cache_func_arg_types(&object->ir_module.proc_cache, ast_func, endpoint.ast_func_id, !ir_gen_speculating())
+                : NULL;
+
+            if(canonical_func_arg_types){
+                was_successful = func_args_match_canonical(ast_func, canonical_func_arg_types, query->canonical_arg_types, arg_types_length);
+            } else {
+                was_successful = func_args_match(ast_func, arg_types, arg_types_length);
+            }
         }
 
         if(was_successful){
@@ -290,35 +302,131 @@ static errorcode_t ir_gen_find_proc_sweep_partial(ir_proc_query_t *query, option
     return FAILURE;
 }
 
-static errorcode_t ir_gen_find_proc_sweep_endpoint_list(
+static errorcode_t ir_gen_find_proc_sweep_endpoint_list_from(
     ir_proc_query_t *query,
     optional_func_pair_t *result,
     unsigned int conform_mode_if_applicable,
-    ir_func_endpoint_list_t *endpoint_list
+    ir_func_endpoint_list_t *endpoint_list,
+    length_t *out_chosen
 ){
-    if(endpoint_list == NULL) return FAILURE;
+    // Tries each candidate in order, and gives back the index of the one that
+    // was suitable (or the number of candidates if none were)
 
     for(length_t i = 0; i != endpoint_list->length; i++){
         ir_func_endpoint_t endpoint = endpoint_list->endpoints[i];
 
         errorcode_t res = ir_gen_find_proc_sweep_partial(query, result, conform_mode_if_applicable, endpoint);
-        if(res != FAILURE) return res;
+
+        if(res != FAILURE){
+            *out_chosen = i;
+            return res;
+        }
     }
 
+    *out_chosen = endpoint_list->length;
     return FAILURE;
 }
 
+static errorcode_t ir_gen_find_proc_sweep_endpoint_list_cached(
+    ir_proc_query_t *query,
+    optional_func_pair_t *result,
+    unsigned int conform_mode_if_applicable,
+    ir_func_endpoint_list_t *endpoint_list
+){
+    // Whether a candidate is suitable only depends on the argument types and the kind of query,
+    // so the candidate that was chosen for a call can be reused for any later call just like it,
+    // as long as no candidates have been added since
+
+    ir_gen_proc_cache_t *proc_cache = &ir_proc_query_getter_object(query)->ir_module.proc_cache;
+    ast_type_t *arg_types = ir_proc_query_getter_arg_types(query);
+    length_t arg_types_length = ir_proc_query_getter_length(query);
+    length_t chosen;
+
+    if(!ir_gen_proc_cache_can_locate(arg_types, arg_types_length, query->optional_gives)){
+        return ir_gen_find_proc_sweep_endpoint_list_from(query, result, conform_mode_if_applicable, endpoint_list, &chosen);
+    }
+
+    ir_gen_proc_cache_key_t key = {
+        .candidates = endpoint_list,
+        .conform_mode = query->conform ? conform_mode_if_applicable : CONFORM_MODE_NOT_APPLICABLE,
+        .traits_mask = query->traits_mask,
+        .traits_match = query->traits_match,
+        .forbid_traits = query->forbid_traits,
+        .conform = query->conform,
+        .is_method = ir_proc_query_is_method(query),
+    };
+
+    // Speculative function bodies can't fill in the cache themselves
+    bool speculating = ir_gen_speculating();
+
+    ir_gen_proc_cache_entry_t *entry = speculating
+        ? ir_gen_proc_cache_locate(proc_cache, &key, arg_types, arg_types_length, query->optional_gives)
+        : ir_gen_proc_cache_locate_or_insert(proc_cache, &key, arg_types, arg_types_length, query->optional_gives);
+
+    bool is_hit = entry && entry->candidates_length == endpoint_list->length;
+
+    // The argument types of queries that don't conform never change, so they can be swept using canonical types
+    if(entry && !query->conform){
+        query->canonical_arg_types = entry->arg_types;
+    }
+
+    if(is_hit){
+        if(speculating) ir_gen_speculation_current()->proc_hits++;
+        else            proc_cache->hits++;
+
+        if(entry->chosen == entry->candidates_length){
+            return FAILURE;
+        }
+
+        errorcode_t res = ir_gen_find_proc_sweep_partial(query, result, conform_mode_if_applicable, endpoint_list->endpoints[entry->chosen]);
+        if(res != FAILURE) return res;
+    } else if(!speculating){
+        proc_cache->misses++;
+    }
+
+    length_t candidates_length = endpoint_list->length;
+    errorcode_t res = ir_gen_find_proc_sweep_endpoint_list_from(query, result, conform_mode_if_applicable, endpoint_list, &chosen);
+
+    // Only remember the outcome if the candidates stayed the same while sweeping
+    // (instantiating a polymorphic candidate adds the instance as another candidate)
+    if(res != ALT_FAILURE && endpoint_list->length == candidates_length){
+        if(!speculating){
+            entry->candidates_length = candidates_length;
+            entry->chosen = chosen;
+        } else if(!is_hit){
+            ir_gen_speculation_proc_miss(&key, arg_types, arg_types_length, query->optional_gives, candidates_length, chosen);
+        }
+    }
+
+    return res;
+}
+
+static errorcode_t ir_gen_find_proc_sweep_endpoint_list(
+    ir_proc_query_t *query,
+    optional_func_pair_t *result,
+    unsigned int conform_mode_if_applicable,
+    ir_func_endpoint_list_t *endpoint_list
+){
+    if(endpoint_list == NULL) return FAILURE;
+
+    if(endpoint_list->length >= IR_GEN_PROC_CACHE_MIN_CANDIDATES){
+        return ir_gen_find_proc_sweep_endpoint_list_cached(query, result, conform_mode_if_applicable, endpoint_list);
+    }
+
+    length_t chosen;
+    return ir_gen_find_proc_sweep_endpoint_list_from(query, result, conform_mode_if_applicable, endpoint_list, &chosen);
+}
+
 static errorcode_t ir_gen_find_proc_sweep_proc_map(
     ir_proc_query_t *query,
     optional_func_pair_t *result,
     unsigned int conform_mode_if_applicable,
     ir_proc_map_t *proc_map,
-    void *key,
-    length_t sizeof_key,
-    int (*compare)(const void*, const void*)
+    void *key
 ){
-    ir_func_endpoint_list_t *endpoint_list = ir_proc_map_find(proc_map, key, sizeof_key, compare);
-    
+    ir_func_endpoint_list_t *endpoint_list = ir_proc_map_find(proc_map, key);
+    ir_gen_speculation_read_procs(&ir_proc_query_getter_object(query)->ir_module, proc_map, endpoint_list);
+
     return ir_gen_find_proc_sweep_endpoint_list(query, result, conform_mode_if_applicable, endpoint_list);
 }
 
@@ -338,9 +446,7 @@ static errorcode_t ir_gen_find_proc_sweep(ir_proc_query_t *query, optional_func_
             &(ir_method_key_t){
                 .method_name = query->proc_name,
                 .struct_name = query->struct_name,
-            },
-            sizeof(ir_method_key_t),
-            &compare_ir_method_key
+            }
         );
 
         if(res != FAILURE) return res;
@@ -354,19 +460,24 @@ static errorcode_t ir_gen_find_proc_sweep(ir_proc_query_t *query, optional_func_
     }
 
     // Search the function procedure map
-    res = ir_gen_find_proc_sweep_proc_map(
-        query,
-        result,
-        conform_mode_if_applicable,
-        &ir_module->func_map,
-        &(ir_func_key_t){
-            .name = query->proc_name
-        },
-        sizeof(ir_func_key_t),
-        &compare_ir_func_key
-    );
+    // (names that were never interned can't belong to any function)
+    maybe_null_weak_cstr_t proc_name = intern_name_find(query->proc_name);
 
-    if(res != FAILURE) return res;
+    if(proc_name == NULL){
+        ir_gen_speculation_read_procs(ir_module, &ir_module->func_map, NULL);
+    } else {
+        res = ir_gen_find_proc_sweep_proc_map(
+            query,
+            result,
+            conform_mode_if_applicable,
+            &ir_module->func_map,
+            &(ir_func_key_t){
+                .name = proc_name
+            }
+        );
+
+        if(res != FAILURE) return res;
+    }
 
     return try_to_autogen_proc_to_fill_query(query, result);
 }
@@ -397,14 +508,22 @@ static errorcode_t try_to_autogen_proc_to_fill_query(ir_proc_query_t *query, opt
 }
 
 errorcode_t ir_gen_find_func_named(object_t *object, weak_cstr_t name, bool *out_is_unique, func_pair_t *result, bool allow_polymorphic){
+    // Names that were never interned can't belong to any function
+    maybe_null_weak_cstr_t atom = intern_name_find(name);
+
+    if(atom == NULL){
+        ir_gen_speculation_read_procs(&object->ir_module, &object->ir_module.func_map, NULL);
+        return FAILURE;
+    }
+
     // Find list of function endpoints for the given name
     ir_func_endpoint_list_t *endpoint_list = ir_proc_map_find(
         &object->ir_module.func_map,
-        &(ir_func_key_t){ .name = name },
-        sizeof(ir_func_key_t),
-        &compare_ir_func_key
+        &(ir_func_key_t){ .name = atom }
     );
 
+    ir_gen_speculation_read_procs(&object->ir_module, &object->ir_module.func_map, endpoint_list);
+
     if(endpoint_list == NULL) return FAILURE;
 
     ir_func_endpoint_t endpoint;
@@ -11,6 +11,7 @@
 #include "IRGEN/ir_cache.h"
 #include "IRGEN/ir_gen_find.h"
 #include "IRGEN/ir_gen_find_sf.h"
+#include "IRGEN/ir_gen_parallel.h"
 #include "UTIL/func_pair.h"
 #include "UTIL/ground.h"
 
@@ -20,12 +21,16 @@ errorcode_t ir_gen_find_pass_func(compiler_t *compiler, object_t *object, ast_ty
     //               FAILURE when a function wasn't found and
     //               ALT_FAILURE when something goes wrong
 
-    ir_gen_sf_cache_entry_t *cache_entry = ir_gen_sf_cache_locate_or_insert(&object->ir_module.sf_cache, arg_type);
+    ir_gen_sf_cache_entry_t *cache_entry = ir_gen_speculation_sf_cache_entry(&object->ir_module.sf_cache, arg_type);
+    if(cache_entry == NULL) return ALT_FAILURE;
 
     if(ir_gen_sf_cache_read(cache_entry->has_pass, cache_entry->pass, result) == SUCCESS){
         return SUCCESS;
     }
 
+    // Speculative function bodies can't fill in the cache
+    if(ir_gen_speculation_abort()) return ALT_FAILURE;
+
     errorcode_t errorcode = ir_gen_find_func_regular(compiler, object, "__pass__", arg_type, 1, TRAIT_NONE, TRAIT_NONE, instantiation_depth, NULL_SOURCE, result);
 
     if(errorcode == SUCCESS && result->has){
@@ -44,12 +49,16 @@ errorcode_t ir_gen_find_defer_func(compiler_t *compiler, object_t *object, ast_t
     //               FAILURE when a function wasn't found and
     //               ALT_FAILURE when something goes wrong
 
-    ir_gen_sf_cache_entry_t *cache_entry = ir_gen_sf_cache_locate_or_insert(&object->ir_module.sf_cache, arg_type);
+    ir_gen_sf_cache_entry_t *cache_entry = ir_gen_speculation_sf_cache_entry(&object->ir_module.sf_cache, arg_type);
+    if(cache_entry == NULL) return ALT_FAILURE;
 
     if(ir_gen_sf_cache_read(cache_entry->has_defer, cache_entry->defer, result) == SUCCESS){
         return result->has ? SUCCESS : FAILURE;
     }
 
+    // Speculative function bodies can't fill in the cache
+    if(ir_gen_speculation_abort()) return ALT_FAILURE;
+
     // Create temporary AST pointer type without allocating on the heap
     // Will be used as AST type for subject of method during lookup
     ast_type_t ast_type_ptr;
@@ -88,12 +97,16 @@ errorcode_t ir_gen_find_assign_func(compiler_t *compiler, object_t *object, ast_
     //               FAILURE when a function wasn't found and
     //               ALT_FAILURE when something goes wrong
 
-    ir_gen_sf_cache_entry_t *cache_entry = ir_gen_sf_cache_locate_or_insert(&object->ir_module.sf_cache, arg_type);
+    ir_gen_sf_cache_entry_t *cache_entry = ir_gen_speculation_sf_cache_entry(&object->ir_module.sf_cache, arg_type);
+    if(cache_entry == NULL) return ALT_FAILURE;
 
     if(ir_gen_sf_cache_read(cache_entry->has_assign, cache_entry->assign, result) == SUCCESS){
         return result->has ? SUCCESS : FAILURE;
     }
 
+    // Speculative function bodies can't fill in the cache
+    if(ir_gen_speculation_abort()) return ALT_FAILURE;
+
     // Create temporary AST pointer type without allocating on the heap
     // Will be used as AST type for subject of method during lookup
     ast_type_t ast_type_ptr;
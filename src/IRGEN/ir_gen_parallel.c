@@ -0,0 +1,370 @@
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "AST/ast.h"
+#include "AST/ast_layout.h"
+#include "AST/ast_type.h"
+#include "BRIDGE/bridge.h"
+#include "BRIDGE/rtti_collector.h"
+#include "DRVR/compiler.h"
+#include "DRVR/object.h"
+#include "IR/ir.h"
+#include "IR/ir_func_endpoint.h"
+#include "IR/ir_module.h"
+#include "IR/ir_pool.h"
+#include "IR/ir_proc_map.h"
+#include "IRGEN/ir_builder.h"
+#include "IRGEN/ir_cache.h"
+#include "IRGEN/ir_gen.h"
+#include "IRGEN/ir_gen_parallel.h"
+#include "UTIL/ground.h"
+#include "UTIL/list.h"
+#include "UTIL/threads.h"
+#include "UTIL/trait.h"
+
+static ADEPT_THREAD_LOCAL ir_gen_speculation_t *current_speculation;
+
+typedef struct {
+    compiler_t *compiler;
+    object_t *object;
+    ir_job_list_t *optional_out_completed_jobs;
+} ir_gen_parallel_ctx_t;
+
+typedef struct {
+    ir_gen_parallel_ctx_t *ctx;
+    ir_gen_speculation_t *speculations;
+} ir_gen_parallel_wave_t;
+
+static errorcode_t ir_gen_functions_body_until(ir_gen_parallel_ctx_t *ctx, length_t stop_length);
+
+ir_gen_speculation_t *ir_gen_speculation_current(void){
+    return current_speculation;
+}
+
+bool ir_gen_speculation_abort(void){
+    if(current_speculation == NULL) return false;
+
+    current_speculation->aborted = true;
+    return true;
+}
+
+void ir_gen_speculation_attach(ir_gen_speculation_t *speculation, ir_builder_t *builder){
+    builder->job_list = &speculation->reached;
+    builder->vtable_init_list = &speculation->vtable_init_list;
+    builder->vtable_dispatch_list = &speculation->vtable_dispatch_list;
+    builder->rtti_relocations = &speculation->rtti_relocations;
+    builder->defer_free = &speculation->defer_free;
+}
+
+void ir_gen_speculation_read_procs(ir_module_t *module, ir_proc_map_t *proc_map, ir_func_endpoint_list_t *endpoint_list){
+    ir_gen_speculation_t *speculation = current_speculation;
+    if(speculation == NULL) return;
+
+    if(endpoint_list){
+        list_append(&speculation->proc_reads, ((ir_gen_proc_read_t){
+            .endpoint_list = endpoint_list,
+            .length = endpoint_list->length,
+        }), ir_gen_proc_read_t);
+    } else if(proc_map == &module->method_map){
+        speculation->missed_method_map = true;
+    } else {
+        speculation->missed_func_map = true;
+    }
+}
+
+void ir_gen_speculation_proc_miss(
+    const ir_gen_proc_cache_key_t *key,
+    ast_type_t *arg_types,
+    length_t arg_types_length,
+    ast_type_t *optional_gives,
+    length_t candidates_length,
+    length_t chosen
+){
+    ir_gen_speculation_t *speculation = current_speculation;
+    if(speculation == NULL) return;
+
+    list_append(&speculation->proc_misses, ((ir_gen_proc_miss_t){
+        .key = *key,
+        .arg_types = ast_types_clone(arg_types, arg_types_length),
+        .arg_types_length = arg_types_length,
+        .gives = optional_gives ? ast_type_clone(optional_gives) : (ast_type_t){0},
+        .candidates_length = candidates_length,
+        .chosen = chosen,
+    }), ir_gen_proc_miss_t);
+}
+
+ir_gen_sf_cache_entry_t *ir_gen_speculation_sf_cache_entry(ir_gen_sf_cache_t *cache, ast_type_t *type){
+    ir_gen_speculation_t *speculation = current_speculation;
+
+    if(speculation == NULL){
+        return ir_gen_sf_cache_locate_or_insert(cache, type);
+    }
+
+    ir_gen_sf_cache_entry_t *entry = ir_gen_sf_cache_locate(cache, type);
+
+    if(entry){
+        speculation->sf_hits++;
+    } else {
+        ir_gen_speculation_abort();
+    }
+
+    return entry;
+}
+
+static void ir_gen_proc_misses_free(ir_gen_proc_misses_t *misses){
+    for(length_t i = 0; i != misses->length; i++){
+        ir_gen_proc_miss_t *miss = &misses->misses[i];
+        ast_types_free_fully(miss->arg_types, miss->arg_types_length);
+        ast_type_free(&miss->gives);
+    }
+    free(misses->misses);
+}
+
+static void ir_gen_speculate_task(length_t task_index, void *user_data){
+    ir_gen_parallel_wave_t *wave = (ir_gen_parallel_wave_t*) user_data;
+    ir_gen_speculation_t *speculation = &wave->speculations[task_index];
+    object_t *object = wave->ctx->object;
+
+    // Redirect everything that would change the module
+    ir_pool_init(&speculation->pool);
+    ir_pool_redirect(&object->ir_module.pool, &speculation->pool);
+    rtti_collector_defer_mentions(&speculation->mentions);
+    ast_field_maps_allow_indexing(false);
+    current_speculation = speculation;
+
+    speculation->errorcode = ir_gen_functions_body_statements(wave->ctx->compiler, object, speculation->job.ast_func_id, speculation->job.ir_func_id);
+
+    current_speculation = NULL;
+    ast_field_maps_allow_indexing(true);
+    rtti_collector_defer_mentions(NULL);
+    ir_pool_redirect(NULL, NULL);
+}
+
+static bool ir_gen_speculation_is_valid(ir_gen_speculation_t *speculation, ir_module_t *module, length_t func_map_length, length_t method_map_length){
+    // Failed function bodies are generated again in order to report their errors
+    if(speculation->aborted || speculation->errorcode != SUCCESS) return false;
+
+    // Names without any candidates may have gotten some since the wave started
+    if(speculation->missed_func_map && module->func_map.length != func_map_length) return false;
+    if(speculation->missed_method_map && module->method_map.length != method_map_length) return false;
+
+    // Overload resolution may have chosen differently if new candidates were added
+    for(length_t i = 0; i != speculation->proc_reads.length; i++){
+        ir_gen_proc_read_t *read = &speculation->proc_reads.reads[i];
+        if(read->endpoint_list->length != read->length) return false;
+    }
+
+    return true;
+}
+
+static void ir_gen_speculation_commit(object_t *object, ir_gen_speculation_t *speculation){
+    // Makes the changes to the module that generating the function body would've made
+    ir_module_t *module = &object->ir_module;
+    ir_func_t *ir_func = &module->funcs.funcs[speculation->job.ir_func_id];
+
+    ir_pool_adopt(&module->pool, &speculation->pool);
+
+    ir_func->scope = speculation->scope;
+    ir_func->basicblocks = speculation->basicblocks;
+    ir_func->variable_count = speculation->variable_count;
+    object->ast.funcs[speculation->job.ast_func_id] = speculation->ast_func;
+
+    for(length_t i = 0; i != speculation->reached.length; i++){
+        ir_module_reach_func(module, speculation->reached.jobs[i].ir_func_id);
+    }
+
+    for(length_t i = 0; i != speculation->vtable_init_list.length; i++){
+        ir_vtable_init_list_append(&module->vtable_init_list, speculation->vtable_init_list.initializations[i]);
+    }
+
+    for(length_t i = 0; i != speculation->vtable_dispatch_list.length; i++){
+        ir_vtable_dispatch_list_append(&module->vtable_dispatch_list, speculation->vtable_dispatch_list.dispatches[i]);
+    }
+
+    for(length_t i = 0; i != speculation->rtti_relocations.length; i++){
+        rtti_relocations_append(&module->rtti_relocations, speculation->rtti_relocations.relocations[i]);
+    }
+
+    for(length_t i = 0; i != speculation->defer_free.length; i++){
+        ir_module_defer_free(module, speculation->defer_free.pointers[i]);
+    }
+
+    for(length_t i = 0; i != speculation->mentions.length; i++){
+        rtti_collector_mention(module->rtti_collector, &speculation->mentions.types[i]);
+    }
+
+    // Account for cache lookups the same way as if they had been done now
+    module->sf_cache.hits += speculation->sf_hits;
+    module->poly_cache.reused += speculation->poly_reused;
+    module->proc_cache.hits += speculation->proc_hits;
+
+    for(length_t i = 0; i != speculation->proc_misses.length; i++){
+        ir_gen_proc_miss_t *miss = &speculation->proc_misses.misses[i];
+        ast_type_t *optional_gives = miss->gives.elements_length ? &miss->gives : NULL;
+
+        ir_gen_proc_cache_entry_t *entry = ir_gen_proc_cache_locate_or_insert(&module->proc_cache, &miss->key, miss->arg_types, miss->arg_types_length, optional_gives);
+
+        if(entry->candidates_length == miss->candidates_length){
+            module->proc_cache.hits++;
+        } else {
+            module->proc_cache.misses++;
+            entry->candidates_length = miss->candidates_length;
+            entry->chosen = miss->chosen;
+        }
+    }
+
+    // Everything that was moved into the module is no longer owned by the speculation
+    ir_job_list_free(&speculation->reached);
+    free(speculation->vtable_init_list.initializations);
+    ir_vtable_dispatch_list_free(&speculation->vtable_dispatch_list);
+    free(speculation->rtti_relocations.relocations);
+    free(speculation->defer_free.pointers);
+    ast_types_free_fully(speculation->mentions.types, speculation->mentions.length);
+    free(speculation->proc_reads.reads);
+    ir_gen_proc_misses_free(&speculation->proc_misses);
+}
+
+static void ir_gen_speculation_discard(ir_gen_speculation_t *speculation){
+    if(speculation->scope){
+        bridge_scope_free(speculation->scope);
+        free(speculation->scope);
+    }
+
+    ir_basicblocks_free(&speculation->basicblocks);
+    ir_job_list_free(&speculation->reached);
+    ir_vtable_init_list_free(&speculation->vtable_init_list);
+    ir_vtable_dispatch_list_free(&speculation->vtable_dispatch_list);
+    rtti_relocations_free(&speculation->rtti_relocations);
+    free_list_free(&speculation->defer_free);
+    ast_types_free_fully(speculation->mentions.types, speculation->mentions.length);
+    free(speculation->proc_reads.reads);
+    ir_gen_proc_misses_free(&speculation->proc_misses);
+    ir_pool_free(&speculation->pool);
+}
+
+static void ir_gen_function_body_completed(ir_gen_parallel_ctx_t *ctx, ir_func_endpoint_t job){
+    if(ctx->optional_out_completed_jobs != NULL){
+        ir_job_list_append(ctx->optional_out_completed_jobs, job);
+    }
+}
+
+static errorcode_t ir_gen_functions_body_wave(ir_gen_parallel_ctx_t *ctx, length_t count){
+    // Takes the top 'count' jobs off of the job list and speculatively generates them all at once,
+    // then commits them in the same order that they would've been generated in one at a time
+
+    object_t *object = ctx->object;
+    ir_module_t *module = &object->ir_module;
+    ir_job_list_t *job_list = &module->job_list;
+
+    ir_gen_speculation_t *speculations = malloc(sizeof(ir_gen_speculation_t) * count);
+    length_t length = 0;
+
+    for(length_t i = 0; i != count; i++){
+        ir_func_endpoint_t job = job_list->jobs[--job_list->length];
+
+        if(!(object->ast.funcs[job.ast_func_id].traits & AST_FUNC_FOREIGN)){
+            speculations[length++] = (ir_gen_speculation_t){ .job = job };
+        }
+    }
+
+    // Jobs queued by each function body are finished before moving on to the next one
+    length_t base_length = job_list->length;
+    length_t func_map_length = module->func_map.length;
+    length_t method_map_length = module->method_map.length;
+
+    ir_gen_parallel_wave_t wave = {
+        .ctx = ctx,
+        .speculations = speculations,
+    };
+
+    parallel_for(length, ctx->compiler->threads, ir_gen_speculate_task, &wave);
+    module->speculation_stats.waves++;
+
+    errorcode_t errorcode = SUCCESS;
+
+    for(length_t i = 0; i != length; i++){
+        ir_gen_speculation_t *speculation = &speculations[i];
+
+        if(errorcode != SUCCESS){
+            ir_gen_speculation_discard(speculation);
+            continue;
+        }
+
+        if(ir_gen_speculation_is_valid(speculation, module, func_map_length, method_map_length)){
+            ir_gen_speculation_commit(object, speculation);
+            module->speculation_stats.committed++;
+        } else {
+            if(speculation->aborted || speculation->errorcode != SUCCESS){
+                module->speculation_stats.aborted++;
+            } else {
+                module->speculation_stats.invalidated++;
+            }
+
+            ir_gen_speculation_discard(speculation);
+
+            if(ir_gen_functions_body_statements(ctx->compiler, object, speculation->job.ast_func_id, speculation->job.ir_func_id)){
+                errorcode = FAILURE;
+                continue;
+            }
+        }
+
+        ir_gen_function_body_completed(ctx, speculation->job);
+        errorcode = ir_gen_functions_body_until(ctx, base_length);
+    }
+
+    free(speculations);
+    return errorcode;
+}
+
+static errorcode_t ir_gen_functions_body_until(ir_gen_parallel_ctx_t *ctx, length_t stop_length){
+    // Generates queued function bodies until the job list is back down to 'stop_length' jobs
+
+    object_t *object = ctx->object;
+    ir_job_list_t *job_list = &object->ir_module.job_list;
+    length_t max_wave_length = ctx->compiler->threads * IR_GEN_PARALLEL_JOBS_PER_THREAD;
+
+    while(job_list->length > stop_length){
+        length_t pending = job_list->length - stop_length;
+
+        if(pending >= IR_GEN_PARALLEL_MIN_JOBS){
+            if(ir_gen_functions_body_wave(ctx, pending < max_wave_length ? pending : max_wave_length)) return FAILURE;
+            continue;
+        }
+
+        ir_func_endpoint_t job = job_list->jobs[--job_list->length];
+        if(object->ast.funcs[job.ast_func_id].traits & AST_FUNC_FOREIGN) continue;
+
+        if(ir_gen_functions_body_statements(ctx->compiler, object, job.ast_func_id, job.ir_func_id)){
+            return FAILURE;
+        }
+
+        ir_gen_function_body_completed(ctx, job);
+    }
+
+    return SUCCESS;
+}
+
+errorcode_t ir_gen_functions_body_parallel(compiler_t *compiler, object_t *object, ir_job_list_t *optional_out_completed_jobs){
+    ir_gen_parallel_ctx_t ctx = {
+        .compiler = compiler,
+        .object = object,
+        .optional_out_completed_jobs = optional_out_completed_jobs,
+    };
+
+    return ir_gen_functions_body_until(&ctx, 0);
+}
+
+void ir_gen_speculation_stats_dump(FILE *file, ir_speculation_stats_t *stats){
+    length_t speculated = stats->committed + stats->aborted + stats->invalidated;
+
+    fprintf(file, "[speculation statistics : %d waves, %d speculated, %d committed, %d aborted, %d invalidated, commit rate=%f]\n",
+        (int) stats->waves,
+        (int) speculated,
+        (int) stats->committed,
+        (int) stats->aborted,
+        (int) stats->invalidated,
+        speculated ? (double) stats->committed / (double) speculated : 0.0
+    );
+}
@@ -16,6 +16,7 @@
 #include "IRGEN/ir_gen_polymorphable.h"
 #include "UTIL/color.h"
 #include "UTIL/ground.h"
+#include "UTIL/intern.h"
 #include "UTIL/util.h"
 
 static errorcode_t enforce_polymorph(
@@ -158,7 +159,9 @@ static errorcode_t enforce_prereq(
     // Enforce struct-field prerequisites
     // `$T~MyStruct`
     if(prereq->similarity_prerequisite){
-        ast_composite_t *similar = ast_composite_find_exact(ast, prereq->similarity_prerequisite);
+        // Names that were never interned can't belong to any composite
+        maybe_null_weak_cstr_t similar_name = intern_name_find(prereq->similarity_prerequisite);
+        ast_composite_t *similar = similar_name ? ast_composite_find_exact(ast, similar_name) : NULL;
 
         if(similar == NULL){
             compiler_panicf(compiler, prereq->source, "Undeclared struct '%s'", prereq->similarity_prerequisite);
@@ -23,6 +23,7 @@
 #include "UTIL/builtin_type.h" // IWYU pragma: keep
 #include "UTIL/color.h"
 #include "UTIL/ground.h"
+#include "UTIL/intern.h"
 
 static inline ir_value_t *as_vernacular_pointer(ir_module_t *ir_module, ir_value_t *value){
     // Removes compile-time type information from an IR pointer (aka transforms it into a `ptr`)
@@ -61,12 +62,12 @@ errorcode_t ir_gen_rtti_fetch_rtti_representation_types(ir_module_t *ir_module,
     ir_type_map_t *type_map = &ir_module->type_map;
 
     // Fetch IR Types for RTTI
-    if(!ir_type_map_find(type_map, "AnyType", &out_rtti_types->any_type_type)
-    || !ir_type_map_find(type_map, "AnyCompositeType", &out_rtti_types->any_composite_type_type)
-    || !ir_type_map_find(type_map, "AnyPtrType", &out_rtti_types->any_ptr_type_type)
-    || !ir_type_map_find(type_map, "AnyFuncPtrType", &out_rtti_types->any_funcptr_type_type)
-    || !ir_type_map_find(type_map, "AnyFixedArrayType", &out_rtti_types->any_fixed_array_type_type)
-    || !ir_type_map_find(type_map, "AnyEnumType", &out_rtti_types->any_enum_type_type)){
+    if(!ir_type_map_find(type_map, intern_name("AnyType"), &out_rtti_types->any_type_type)
+    || !ir_type_map_find(type_map, intern_name("AnyCompositeType"), &out_rtti_types->any_composite_type_type)
+    || !ir_type_map_find(type_map, intern_name("AnyPtrType"), &out_rtti_types->any_ptr_type_type)
+    || !ir_type_map_find(type_map, intern_name("AnyFuncPtrType"), &out_rtti_types->any_funcptr_type_type)
+    || !ir_type_map_find(type_map, intern_name("AnyFixedArrayType"), &out_rtti_types->any_fixed_array_type_type)
+    || !ir_type_map_find(type_map, intern_name("AnyEnumType"), &out_rtti_types->any_enum_type_type)){
         internalerrorprintf("ir_gen_rtti_fetch_rtti_representation_types() - Failed to find critical types used by the runtime type table, which should already exist\n");
         return FAILURE;
     }
@@ -82,7 +83,7 @@ errorcode_t ir_gen__types__placeholder(object_t *object, ir_global_t *ir_global)
 
     // Fetch 'AnyType' IR Type
     ir_type_t *any_type_type;
-    if(!ir_type_map_find(&ir_module->type_map, "AnyType", &any_type_type)){
+    if(!ir_type_map_find(&ir_module->type_map, intern_name("AnyType"), &any_type_type)){
         internalerrorprintf("ir_gen__types__placeholder() - Failed to get critical type 'AnyType' which should exist\n");
         redprintf("    (when creating null pointer to initialize __types__ because type info was disabled)\n");
         return FAILURE;
@@ -703,17 +704,15 @@ ir_value_t *ir_gen__types__get_rtti_pointer_for(object_t *object, ast_type_t *as
 }
 
 static void collect_into_preallocated_rtti_table_entry_list(void *item, void *user_pointer){
-    ast_type_t *ast_type = (ast_type_t*) item;
+    const ast_type_t *ast_type = (const ast_type_t*) item;
     rtti_table_entry_list_t *list = (rtti_table_entry_list_t*) user_pointer;
 
     rtti_table_entry_list_append_unchecked(list, (rtti_table_entry_t){
         .name = ast_type_str(ast_type),
-        .resolved_ast_type = *ast_type,
+        .resolved_ast_type = ast_type_clone(ast_type),
         .traits = TRAIT_NONE,
         .ir_type = NULL,
     });
-
-    *ast_type = AST_TYPE_NONE;
 }
 
 rtti_table_entry_list_t rtti_collector_collect(rtti_collector_t *rtti_collector){
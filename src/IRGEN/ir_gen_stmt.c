@@ -22,12 +22,13 @@
 #include "IRGEN/ir_builder.h"
 #include "IRGEN/ir_gen_expr.h"
 #include "IRGEN/ir_gen_find.h"
+#include "IRGEN/ir_gen_parallel.h"
 #include "IRGEN/ir_gen_stmt.h"
 #include "IRGEN/ir_gen_type.h"
-#include "LEX/lex.h"
 #include "UTIL/builtin_type.h"
 #include "UTIL/func_pair.h"
 #include "UTIL/ground.h"
+#include "UTIL/intern.h"
 #include "UTIL/string.h"
 #include "UTIL/trait.h"
 
@@ -444,7 +445,7 @@ errorcode_t ir_gen_stmts(ir_builder_t *builder, ast_expr_list_t *stmt_list, bool
                 if(for_loop->condition){
                     if(ir_gen_expr(builder, for_loop->condition, &condition_value, false, &temporary_type)) return FAILURE;
                 } else {
-                    temporary_type = ast_type_make_base(strclone("bool"));
+                    temporary_type = ast_type_make_base("bool");
                     condition_value = build_bool(builder->pool, true);
                 }
 
@@ -453,7 +454,7 @@ errorcode_t ir_gen_stmts(ir_builder_t *builder, ast_expr_list_t *stmt_list, bool
                 bool_base.id = AST_ELEM_BASE;
                 bool_base.source = NULL_SOURCE;
                 bool_base.source.object_index = builder->object->index;
-                bool_base.base = "bool";
+                bool_base.base = intern_name("bool");
                 ast_elem_t *bool_type_elem = (ast_elem_t*) &bool_base;
                 ast_type_t bool_type;
                 bool_type.elements = &bool_type_elem;
@@ -707,7 +708,9 @@ errorcode_t ir_gen_stmt_call_like(ir_builder_t *builder, ast_expr_t *call_like_s
 
 errorcode_t ir_gen_stmt_declare(ir_builder_t *builder, ast_expr_declare_t *stmt){
     // Don't allow multiple variables with the same name in the same scope
-    if(bridge_scope_var_already_in_list(builder->scope, stmt->name)){
+    maybe_null_weak_cstr_t name = intern_name_find(stmt->name);
+
+    if(name && bridge_scope_var_already_in_list(builder->scope, name)){
         compiler_panicf(builder->compiler, stmt->source, "Variable '%s' already declared", stmt->name);
         return FAILURE;
     }
@@ -720,6 +723,9 @@ errorcode_t ir_gen_stmt_declare(ir_builder_t *builder, ast_expr_declare_t *stmt)
     if(stmt->traits & AST_EXPR_DECLARATION_STATIC) traits |= BRIDGE_VAR_STATIC;
     if(is_undef)                                   traits |= BRIDGE_VAR_UNDEF;
 
+    // Speculative function bodies can't add static variables to the module
+    if(traits & BRIDGE_VAR_STATIC && ir_gen_speculation_abort()) return FAILURE;
+
     // Resolve AST type to IR type
     if(ir_gen_resolve_type(builder->compiler, builder->object, &stmt->type, &ir_type)) return FAILURE;
 
@@ -1373,6 +1379,7 @@ errorcode_t ir_gen_stmt_each(ir_builder_t *builder, ast_expr_each_in_t *stmt){
             if(!ast_types_identical(&remaining_type, stmt->it_type)){
                 compiler_panic(builder->compiler, stmt->it_type->source,
                     "Element type doesn't match given array's element type");
+                if(ir_gen_speculating()) goto failure;
 
                 char *s1 = ast_type_str(stmt->it_type);
                 char *s2 = ast_type_str(&remaining_type);
@@ -1505,7 +1512,7 @@ errorcode_t ir_gen_stmt_each(ir_builder_t *builder, ast_expr_each_in_t *stmt){
 
             char *s1 = ast_type_str(stmt->it_type);
             char *s2 = ast_type_str(&temporary_type);
-            printf("(given element type : '%s', array element type : '%s')\n", s1, s2);
+            if(!ir_gen_speculating()) printf("(given element type : '%s', array element type : '%s')\n", s1, s2);
             free(s1);
             free(s2);
 
@@ -1720,7 +1727,7 @@ errorcode_t ir_gen_stmt_assert(ir_builder_t *builder, ast_expr_assert_t *stmt){
     }
     
     int line, column;
-    lex_get_location(src_object->buffer, stmt->source.index, &line, &column);
+    object_get_location(src_object, stmt->source.index, &line, &column);
 
     length_t num_args = 6;
     ast_expr_t **args = malloc(sizeof *args * num_args);
@@ -1793,6 +1800,8 @@ errorcode_t exhaustive_switch_check(ir_builder_t *builder, weak_cstr_t enum_name
             is_missing_case = true;
 
             compiler_panic(builder->compiler, switch_source, "Not all cases covered in exhaustive switch");
+            if(ir_gen_speculating()) return FAILURE;
+
             printf("\nMissing cases:\n");
         }
         
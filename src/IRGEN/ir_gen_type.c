@@ -24,37 +24,43 @@
 #include "IRGEN/ir_build_literal.h"
 #include "IRGEN/ir_builder.h"
 #include "IRGEN/ir_gen_expr.h"
+#include "IRGEN/ir_gen_parallel.h"
 #include "IRGEN/ir_gen_polymorphable.h"
 #include "IRGEN/ir_gen_type.h"
 #include "UTIL/builtin_type.h"
 #include "UTIL/color.h"
 #include "UTIL/ground.h"
+#include "UTIL/intern.h"
 #include "UTIL/trait.h"
 
 ir_type_map_t ir_type_map_create(ast_t *ast, ir_module_t *module){
     ir_pool_t *pool = &module->pool;
 
     length_t estimate = ast->composites_length + ast->enums_length + 24;
-    ir_type_map_t type_map = list_create(ir_type_map_t, ir_type_mapping_t, estimate);
+    ir_type_map_t type_map = (ir_type_map_t){
+        .mappings = malloc(sizeof(ir_type_mapping_t) * estimate),
+        .length = 0,
+        .capacity = estimate,
+    };
 
     // Create type mappings for all builtin types
     ir_type_mapping_t builtin_type_mappings[] = {
-        ir_type_mapping_create("bool", module->common.ir_bool),
-        ir_type_mapping_create("byte", ir_type_make(pool, TYPE_KIND_S8, NULL)),
-        ir_type_mapping_create("ubyte", ir_type_make(pool, TYPE_KIND_U8, NULL)),
-        ir_type_mapping_create("short", ir_type_make(pool, TYPE_KIND_S16, NULL)),
-        ir_type_mapping_create("ushort", ir_type_make(pool, TYPE_KIND_U16, NULL)),
-        ir_type_mapping_create("int", ir_type_make(pool, TYPE_KIND_S32, NULL)),
-        ir_type_mapping_create("uint", ir_type_make(pool, TYPE_KIND_U32, NULL)),
-        ir_type_mapping_create("long", ir_type_make(pool, TYPE_KIND_S64, NULL)),
-        ir_type_mapping_create("ulong", ir_type_make(pool, TYPE_KIND_U64, NULL)),
-        ir_type_mapping_create("half", ir_type_make(pool, TYPE_KIND_HALF, NULL)),
-        ir_type_mapping_create("float", ir_type_make(pool, TYPE_KIND_FLOAT, NULL)),
-        ir_type_mapping_create("double", ir_type_make(pool, TYPE_KIND_DOUBLE, NULL)),
-        ir_type_mapping_create("ptr", module->common.ir_ptr),
-        ir_type_mapping_create("usize", module->common.ir_usize),
-        ir_type_mapping_create("successful", module->common.ir_bool),
-        ir_type_mapping_create("void", ir_type_make(pool, TYPE_KIND_VOID, NULL))
+        ir_type_mapping_create(intern_name("bool"), module->common.ir_bool),
+        ir_type_mapping_create(intern_name("byte"), ir_type_make(pool, TYPE_KIND_S8, NULL)),
+        ir_type_mapping_create(intern_name("ubyte"), ir_type_make(pool, TYPE_KIND_U8, NULL)),
+        ir_type_mapping_create(intern_name("short"), ir_type_make(pool, TYPE_KIND_S16, NULL)),
+        ir_type_mapping_create(intern_name("ushort"), ir_type_make(pool, TYPE_KIND_U16, NULL)),
+        ir_type_mapping_create(intern_name("int"), ir_type_make(pool, TYPE_KIND_S32, NULL)),
+        ir_type_mapping_create(intern_name("uint"), ir_type_make(pool, TYPE_KIND_U32, NULL)),
+        ir_type_mapping_create(intern_name("long"), ir_type_make(pool, TYPE_KIND_S64, NULL)),
+        ir_type_mapping_create(intern_name("ulong"), ir_type_make(pool, TYPE_KIND_U64, NULL)),
+        ir_type_mapping_create(intern_name("half"), ir_type_make(pool, TYPE_KIND_HALF, NULL)),
+        ir_type_mapping_create(intern_name("float"), ir_type_make(pool, TYPE_KIND_FLOAT, NULL)),
+        ir_type_mapping_create(intern_name("double"), ir_type_make(pool, TYPE_KIND_DOUBLE, NULL)),
+        ir_type_mapping_create(intern_name("ptr"), module->common.ir_ptr),
+        ir_type_mapping_create(intern_name("usize"), module->common.ir_usize),
+        ir_type_mapping_create(intern_name("successful"), module->common.ir_bool),
+        ir_type_mapping_create(intern_name("void"), ir_type_make(pool, TYPE_KIND_VOID, NULL))
     };
 
     for(length_t i = 0; i < NUM_ITEMS(builtin_type_mappings); i++){
@@ -78,6 +84,7 @@ ir_type_map_t ir_type_map_create(ast_t *ast, ir_module_t *module){
 
     // Sort the mappings for easily lookup later on
     qsort(type_map.mappings, type_map.length, sizeof(ir_type_mapping_t), ir_type_mapping_cmp);
+    ir_type_map_index(&type_map);
     
     // Return created type map
     return type_map;
@@ -119,7 +126,7 @@ errorcode_t ir_gen_type_mappings(compiler_t *compiler, object_t *object){
 
     // Pre-validate string type (if it exists)
     ir_type_t *ir_string_type;
-    if(ir_type_map_find(type_map, "String", &ir_string_type)){
+    if(ir_type_map_find(type_map, intern_name("String"), &ir_string_type)){
         ast_composite_t *composite = (ast_composite_t*) ir_string_type->extra;
 
         if(ir_string_type->kind != TYPE_KIND_UNBUILT_COMPOSITE
@@ -153,7 +160,7 @@ errorcode_t ir_gen_type_mappings(compiler_t *compiler, object_t *object){
     }
 
     // Cache string IR type
-    ir_type_map_find(type_map, "String", &module->common.ir_string_struct);
+    ir_type_map_find(type_map, intern_name("String"), &module->common.ir_string_struct);
     return SUCCESS;
 }
 
@@ -563,7 +570,7 @@ successful_t ast_types_conform(ir_builder_t *builder, ir_value_t **ir_value, ast
             values[1] = build_literal_usize(builder->pool, 0);
         }
 
-        if(!ir_type_map_find(builder->type_map, "Any", &any_type)){
+        if(!ir_type_map_find(builder->type_map, intern_name("Any"), &any_type)){
             internalerrorprintf("ast_types_conform() - Failed to find critical 'Any' type used by the runtime type table that should exist\n");
             return false;
         }
@@ -7,13 +7,14 @@
 #include "DRVR/compiler.h"
 #include "DRVR/object.h"
 #include "LEX/lex.h"
+#include "LEX/lex_scan.h"
 #include "LEX/token.h"
 #include "TOKEN/token_data.h"
+#include "UTIL/arena.h"
 #include "UTIL/color.h"
 #include "UTIL/datatypes.h"
 #include "UTIL/filename.h"
 #include "UTIL/ground.h"
-#include "UTIL/search.h"
 #include "UTIL/string.h"
 #include "UTIL/util.h"
 
@@ -38,15 +39,29 @@ typedef struct {
 } lex_ctx_t;
 
 static inline void add_token(tokenlist_t *tokenlist, token_t token, source_t source){
+    // NOTE: Sources are stored as 32-bit spans, and the object index is shared by the whole tokenlist
     coexpand(
-        (void**) &tokenlist->tokens, sizeof(token_t),
-        (void**) &tokenlist->sources, sizeof(source_t),
+        (void**) &tokenlist->ids, sizeof(tokenid_t),
+        (void**) &tokenlist->spans, sizeof(token_span_t),
         tokenlist->length, &tokenlist->capacity,
         /* amount */ 1, /* default capacity */ 4
     );
 
-    tokenlist->tokens[tokenlist->length] = token;
-    tokenlist->sources[tokenlist->length++] = source;
+    tokenlist->ids[tokenlist->length] = token.id;
+    tokenlist->spans[tokenlist->length] = (token_span_t){
+        .index = (uint32_t) source.index,
+        .stride = (uint32_t) source.stride,
+        .data_index = TOKEN_NO_DATA,
+    };
+
+    if(token.data){
+        expand((void**) &tokenlist->data, sizeof(void*), tokenlist->data_length, &tokenlist->data_capacity, 1, 4);
+
+        tokenlist->spans[tokenlist->length].data_index = (uint32_t) tokenlist->data_length;
+        tokenlist->data[tokenlist->data_length++] = token.data;
+    }
+
+    tokenlist->length++;
 }
 
 static inline token_t character_to_token(char c){
@@ -116,19 +131,23 @@ static inline const char *escapable_until_or_null(const char *beginning, const c
     const char *end = beginning;
 
     while(end < eof){
+        end = lex_scan_either(end, eof, terminator, escape_prefix);
+        if(end >= eof) break;
+
         if(*end == terminator){
             return end;
-        } else if(*end == escape_prefix){
-            end += 2;
-        } else {
-            end += 1;
         }
+
+        // Skip escaped character
+        end += 2;
     }
 
     return NULL;
 }
 
 static inline void error_unterminated_string(lex_ctx_t *ctx, compiler_t *compiler){
+    if(compiler == NULL) return;
+
     source_t source = {
         .index = ctx->i,
         .stride = 1,
@@ -139,6 +158,8 @@ static inline void error_unterminated_string(lex_ctx_t *ctx, compiler_t *compile
 }
 
 static inline void error_unknown_escape_sequence(lex_ctx_t *ctx, compiler_t *compiler, string_unescape_error_t *error){
+    if(compiler == NULL) return;
+
     length_t position = ctx->i + 1 + error->relative_position;
     const char invalid_escape_char = ctx->buffer[position + 1];
 
@@ -221,14 +242,20 @@ static inline errorcode_t cstring(lex_ctx_t *ctx, compiler_t *compiler){
         if(suffix_start + 2 <= eof){
             if(memcmp(suffix_start, "ub", 2) == 0){
                 // Actually a 'ubyte' character literal
-                add_token(&ctx->tokenlist, (token_t){TOKEN_UBYTE, (adept_ubyte*) string}, (source_t){ctx->i, size + 4, ctx->object_index});
+                adept_ubyte *value = arena_alloc_init(&ctx->tokenlist.payloads, adept_ubyte, string[0]);
+                free(string);
+
+                add_token(&ctx->tokenlist, (token_t){TOKEN_UBYTE, value}, (source_t){ctx->i, size + 4, ctx->object_index});
                 ctx->i += size + 4;
                 return SUCCESS;
             }
 
             if(memcmp(suffix_start, "sb", 2) == 0){
                 // Actually a 'byte' character literal
-                add_token(&ctx->tokenlist, (token_t){TOKEN_BYTE, (adept_byte*) string}, (source_t){ctx->i, size + 4, ctx->object_index});
+                adept_byte *value = arena_alloc_init(&ctx->tokenlist.payloads, adept_byte, string[0]);
+                free(string);
+
+                add_token(&ctx->tokenlist, (token_t){TOKEN_BYTE, value}, (source_t){ctx->i, size + 4, ctx->object_index});
                 ctx->i += size + 4;
                 return SUCCESS;
             }
@@ -323,103 +350,104 @@ static inline errorcode_t number(lex_ctx_t *ctx, compiler_t *optional_error_comp
         switch(*(end + 1)){
         case 'b':
             token_id = TOKEN_UBYTE;
-            data = malloc_init(adept_ubyte, string_to_uint8(buf, base));
+            data = arena_alloc_init(&ctx->tokenlist.payloads, adept_ubyte, string_to_uint8(buf, base));
             stride += 2;
             break;
         case 's':
             token_id = TOKEN_USHORT;
-            data = malloc_init(adept_ushort, string_to_uint16(buf, base));
+            data = arena_alloc_init(&ctx->tokenlist.payloads, adept_ushort, string_to_uint16(buf, base));
             stride += 2;
             break;
         case 'i':
             token_id = TOKEN_UINT;
-            data = malloc_init(adept_uint, string_to_uint32(buf, base));
+            data = arena_alloc_init(&ctx->tokenlist.payloads, adept_uint, string_to_uint32(buf, base));
             stride += 2;
             break;
         case 'l':
             token_id = TOKEN_ULONG;
-            data = malloc_init(adept_ulong, string_to_uint64(buf, base));
+            data = arena_alloc_init(&ctx->tokenlist.payloads, adept_ulong, string_to_uint64(buf, base));
             stride += 2;
             break;
         case 'z':
             token_id = TOKEN_USIZE;
-            data = malloc_init(adept_usize, string_to_uint64(buf, base));
+            data = arena_alloc_init(&ctx->tokenlist.payloads, adept_usize, string_to_uint64(buf, base));
             stride += 2;
             break;
-        default: {
+        default:
+            if(optional_error_compiler && optional_error_object){
                 int line, column;
                 lex_get_location(ctx->buffer, ctx->i + (end - beginning + 1), &line, &column);
                 redprintf("%s:%d:%d: Expected valid number suffix after 'u' base suffix\n", filename_name_const(optional_error_object->filename), line, column);
-                return FAILURE;
             }
+            return FAILURE;
         }
         break;
     case 's':
         switch(*(end + 1)){
         case 'b':
             token_id = TOKEN_BYTE;
-            data = malloc_init(adept_byte, string_to_int8(buf, base));
+            data = arena_alloc_init(&ctx->tokenlist.payloads, adept_byte, string_to_int8(buf, base));
             stride += 2;
             break;
         case 's':
             token_id = TOKEN_SHORT;
-            data = malloc_init(adept_short, string_to_int16(buf, base));
+            data = arena_alloc_init(&ctx->tokenlist.payloads, adept_short, string_to_int16(buf, base));
             stride += 2;
             break;
         case 'i':
             token_id = TOKEN_INT;
-            data = malloc_init(adept_int, string_to_int32(buf, base));
+            data = arena_alloc_init(&ctx->tokenlist.payloads, adept_int, string_to_int32(buf, base));
             stride += 2;
             break;
         case 'l':
             token_id = TOKEN_LONG;
-            data = malloc_init(adept_long, string_to_int64(buf, base));
+            data = arena_alloc_init(&ctx->tokenlist.payloads, adept_long, string_to_int64(buf, base));
             stride += 2;
             break;
         default:
             token_id = TOKEN_SHORT;
-            data = malloc_init(adept_short, string_to_int16(buf, base));
+            data = arena_alloc_init(&ctx->tokenlist.payloads, adept_short, string_to_int16(buf, base));
             stride += 1;
         }
         break;
     case 'b':
         token_id = TOKEN_BYTE;
-        data = malloc_init(adept_byte, string_to_int8(buf, base));
+        data = arena_alloc_init(&ctx->tokenlist.payloads, adept_byte, string_to_int8(buf, base));
         stride += 1;
         break;
     case 'i':
         token_id = TOKEN_INT;
-        data = malloc_init(adept_int, string_to_int32(buf, base));
+        data = arena_alloc_init(&ctx->tokenlist.payloads, adept_int, string_to_int32(buf, base));
         stride += 1;
         break;
     case 'l':
         token_id = TOKEN_LONG;
-        data = malloc_init(adept_long, string_to_int64(buf, base));
+        data = arena_alloc_init(&ctx->tokenlist.payloads, adept_long, string_to_int64(buf, base));
         stride += 1;
         break;
     case 'f':
         token_id = TOKEN_FLOAT;
-        data = malloc_init(adept_float, string_to_float32(buf));
+        data = arena_alloc_init(&ctx->tokenlist.payloads, adept_float, string_to_float32(buf));
         stride += 1;
         break;
     case 'd':
         token_id = TOKEN_DOUBLE;
-        data = malloc_init(adept_double, string_to_float64(buf));
+        data = arena_alloc_init(&ctx->tokenlist.payloads, adept_double, string_to_float64(buf));
         stride += 1;
         break;
     default:
         if((!is_hex && !can_dot) || did_exp){
             // Default to normal generic floating-point
             token_id = TOKEN_GENERIC_FLOAT;
-            data = malloc_init(adept_generic_float, string_to_float64(buf));
+            data = arena_alloc_init(&ctx->tokenlist.payloads, adept_generic_float, string_to_float64(buf));
         } else if(string_to_int_must_be_uint64(buf, put, base)){
             // Numbers that cannot be expressed using int64 will be promoted to uint64
             token_id = TOKEN_ULONG;
-            data = malloc_init(adept_ulong, string_to_uint64(buf, base));
+            data = arena_alloc_init(&ctx->tokenlist.payloads, adept_ulong, string_to_uint64(buf, base));
         } else {
             // Otherwise, default to normal generic integer
             token_id = TOKEN_GENERIC_INT;
-            data = malloc_init(adept_generic_int, string_to_int64(buf, base));
+            data = arena_alloc_init(&ctx->tokenlist.payloads, adept_generic_int, string_to_int64(buf, base));
         }
     }
     
@@ -440,12 +468,10 @@ static inline void running(lex_ctx_t *ctx, tokenid_t intent){
     const char *eof = ctx->buffer + ctx->buffer_length;
 
     while(end < eof){
-        char c = *end;
+        end = lex_scan_identifier(end, eof);
+        if(end == eof) break;
 
-        if(c == '_' || isalnum(c)){
-            end++;
-            continue;
-        }
+        char c = *end;
 
         if(intent == TOKEN_WORD){
             if(c == '\\' || (c == ':' && (isalnum(end[1]) || c == '_'))){
@@ -475,30 +501,29 @@ static inline void running(lex_ctx_t *ctx, tokenid_t intent){
     // Calculate size
     length_t size = end - beginning;
 
-    // Create heap-allocated string to hold identifier
-    char *identifier = memcpy(malloc(size + 1), beginning, size);
-    identifier[size] = '\0';
-
     if(intent == TOKEN_WORD){
-        maybe_index_t keyword_index = binary_string_search_const(global_token_keywords_list, global_token_keywords_list_length, identifier);
+        maybe_index_t keyword_index = lex_keyword_index(beginning, size);
         
         // Handle word tokens that should be keywords
         if(keyword_index != -1){
             add_token(&ctx->tokenlist, (token_t){BEGINNING_OF_KEYWORD_TOKENS + (unsigned int) keyword_index, NULL}, (source_t){ctx->i, size, ctx->object_index});
             ctx->i += size;
-            free(identifier);
             return;
         } else if(size == 4 && memcmp(beginning, "elif", 4) == 0){
             // Legacy alternative syntax 'elif'
             add_token(&ctx->tokenlist, (token_t){TOKEN_ELSE, NULL}, (source_t){ctx->i, 2, ctx->object_index});
             add_token(&ctx->tokenlist, (token_t){TOKEN_IF, NULL}, (source_t){ctx->i + 2, 2, ctx->object_index});
             ctx->i += 4;
-            free(identifier);
             return;
         }
 
         // Otherwise not a keyword...
+    }
 
+    // Create string to hold identifier
+    char *identifier = arena_strndup(&ctx->tokenlist.payloads, beginning, size);
+
+    if(intent == TOKEN_WORD){
         // Legacy alternative syntax ':' instead of '\\' as a namespace character
         // This will be removed in the future
         for(char *s = identifier; *s; s++){
@@ -511,8 +536,50 @@ static inline void running(lex_ctx_t *ctx, tokenid_t intent){
     ctx->i += size + flag_length;
 }
 
+static void lex_index_newlines(object_t *object){
+    // NOTE: 'memchr' is usually vectorized, so this is much faster than checking each character
+    const char *buffer = object->buffer;
+    const char *end = buffer + object->buffer_length;
+
+    length_t *newlines = NULL;
+    length_t length = 0;
+    length_t capacity = 0;
+
+    for(const char *newline = memchr(buffer, '\n', end - buffer); newline; newline = memchr(newline + 1, '\n', end - (newline + 1))){
+        expand((void**) &newlines, sizeof(length_t), length, &capacity, 1, 256);
+        newlines[length++] = newline - buffer;
+    }
+
+    object->newlines = newlines;
+    object->newlines_length = length;
+}
+
+maybe_index_t lex_keyword_index(const char *word, length_t length){
+    if(length < TOKEN_KEYWORD_MIN_LENGTH || length > TOKEN_KEYWORD_MAX_LENGTH) return -1;
+
+    // Mirrors 'keyword_hash' in 'include/GENERATE/generate_c.py'
+    const unsigned char *associated_values = global_token_keywords_hash_associated_values;
+    const unsigned char *characters = (const unsigned char*) word;
+
+    length_t hash = length
+        + associated_values[characters[0]]
+        + associated_values[characters[1]]
+        + associated_values[characters[length - 2]]
+        + associated_values[characters[length - 1]];
+
+    unsigned char slot = global_token_keywords_hash_table[hash % TOKEN_KEYWORD_HASH_TABLE_SIZE];
+    if(slot == 0) return -1;
+
+    // The only keyword that could match, so check whether it actually does
+    maybe_index_t keyword_index = slot - 1;
+    bool matches = global_token_keywords_length_list[keyword_index] == length
+        && memcmp(global_token_keywords_list[keyword_index], word, length) == 0;
+
+    return matches ? keyword_index : -1;
+}
+
 errorcode_t lex(compiler_t *compiler, object_t *object){
-    if(!file_text_contents(object->filename, &object->buffer, &object->buffer_length, true)){
+    if(!file_text_contents_mapped(object->filename, &object->buffer, &object->buffer_length, &object->buffer_mapping_size)){
         redprintf("The file '%s' doesn't exist or can't be accessed\n", object->filename);
         return FAILURE;
     }
@@ -528,15 +595,26 @@ errorcode_t lex_buffer(compiler_t *compiler, object_t *object){
     length_t buffer_length = object->buffer_length;
     length_t estimate = buffer_length / 3;
 
+    // Token sources are stored as 32-bit spans
+    if(buffer_length > UINT32_MAX){
+        if(compiler) errorprintf("File '%s' is too large to compile\n", filename_name_const(object->filename));
+        return FAILURE;
+    }
+
     lex_ctx_t ctx = (lex_ctx_t){
         .buffer = buffer,
         .buffer_length = buffer_length,
         .object_index = object->index,
         .tokenlist = (tokenlist_t){
-            .tokens = malloc(sizeof(token_t) * estimate),
+            .ids = malloc(sizeof(tokenid_t) * estimate),
+            .spans = malloc(sizeof(token_span_t) * estimate),
             .length = 0,
             .capacity = estimate,
-            .sources = malloc(sizeof(source_t) * estimate),
+            .object_index = object->index,
+            .payloads = (arena_t){
+                .head = NULL,
+                .chunk_size = length_max(4096, buffer_length / 4),
+            },
         },
         .i = 0
     };
@@ -545,7 +623,7 @@ errorcode_t lex_buffer(compiler_t *compiler, object_t *object){
         switch(buffer[ctx.i]){
         case ' ':
         case '\t':
-            ctx.i += 1;
+            ctx.i = lex_scan_blanks(&buffer[ctx.i + 1], &buffer[buffer_length]) - buffer;
             break;
         case '(': case ')':
         case '{': case '}':
@@ -566,13 +644,16 @@ errorcode_t lex_buffer(compiler_t *compiler, object_t *object){
         case '/':
             switch(buffer[ctx.i + 1]){
             case '/':
-                do ctx.i += 1; while(buffer[ctx.i] != '\n');
+                ctx.i = lex_scan_line(&buffer[ctx.i + 2], &buffer[buffer_length]) - buffer;
                 break;
             case '*': {
                     const char *end = &buffer[ctx.i];
                     const char *eof = &buffer[buffer_length];
 
-                    while(end < eof && memcmp(end, "*/", 2) != 0){
+                    // NOTE: Starts at '/', so the '*' of the opening '/*' can also begin the closing '*/'
+                    while(end < eof){
+                        end = lex_scan_either(end, eof, '*', '*');
+                        if(end >= eof || end[1] == '/') break;
                         end++;
                     }
 
@@ -583,7 +664,7 @@ errorcode_t lex_buffer(compiler_t *compiler, object_t *object){
                             .object_index = ctx.object_index,
                         };
 
-                        compiler_panic(compiler, source, "Unterminated multi-line comment");
+                        if(compiler) compiler_panic(compiler, source, "Unterminated multi-line comment");
                         goto failure;
                     } else {
                         ctx.i += end - &buffer[ctx.i] + 2;
@@ -666,10 +747,12 @@ errorcode_t lex_buffer(compiler_t *compiler, object_t *object){
                     break;
                 }
 
-                int line, column;
-                lex_get_location(buffer, ctx.i, &line, &column);
-                redprintf("%s:%d:%d: Unrecognized symbol '%c' (0x%02X)\n", filename_name_const(object->filename), line, column, buffer[ctx.i], (int) buffer[ctx.i]);
-                compiler_print_source(compiler, line, (source_t){ctx.i, 0, ctx.object_index});
+                if(compiler){
+                    int line, column;
+                    lex_get_location(buffer, ctx.i, &line, &column);
+                    redprintf("%s:%d:%d: Unrecognized symbol '%c' (0x%02X)\n", filename_name_const(object->filename), line, column, buffer[ctx.i], (int) buffer[ctx.i]);
+                    compiler_print_source(compiler, line, (source_t){ctx.i, 0, ctx.object_index});
+                }
                 goto failure;
             }
         }
@@ -677,6 +760,7 @@ errorcode_t lex_buffer(compiler_t *compiler, object_t *object){
 
     object->compilation_stage = COMPILATION_STAGE_TOKENLIST;
     object->tokenlist = ctx.tokenlist;
+    lex_index_newlines(object);
     return SUCCESS;
 
 failure:
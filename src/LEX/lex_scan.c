@@ -0,0 +1,234 @@
+
+#include <stdbool.h>
+
+#include "LEX/lex_scan.h"
+#include "UTIL/ground.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LEX_SCAN_HAS_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(LEX_SCAN_HAS_SSE2) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define LEX_SCAN_HAS_AVX2
+#include <immintrin.h>
+#define LEX_SCAN_AVX2_FUNCTION __attribute__((target("avx2")))
+#endif
+
+// Implementation forced by 'lex_scan_set_impl', or -1 to use the best available
+static int lex_scan_override = -1;
+
+static inline lex_scan_impl_t lex_scan_best_impl(void){
+    #if defined(LEX_SCAN_HAS_AVX2)
+    if(__builtin_cpu_supports("avx2")) return LEX_SCAN_AVX2;
+    #endif
+
+    #if defined(LEX_SCAN_HAS_SSE2)
+    return LEX_SCAN_SSE2;
+    #else
+    return LEX_SCAN_SCALAR;
+    #endif
+}
+
+lex_scan_impl_t lex_scan_get_impl(void){
+    return lex_scan_override != -1 ? (lex_scan_impl_t) lex_scan_override : lex_scan_best_impl();
+}
+
+bool lex_scan_set_impl(lex_scan_impl_t impl){
+    if(impl > lex_scan_best_impl()) return false;
+
+    lex_scan_override = impl;
+    return true;
+}
+
+static inline bool lex_scan_is_blank(char c){
+    return c == ' ' || c == '\t';
+}
+
+static inline bool lex_scan_is_identifier(char c){
+    // NOTE: Equivalent to 'c == '_' || isalnum(c)' in the "C" locale
+    return (unsigned char) (c - '0') < 10 || (unsigned char) ((c | 0x20) - 'a') < 26 || c == '_';
+}
+
+#ifdef LEX_SCAN_HAS_SSE2
+static inline __m128i lex_scan_sse2_in_range(__m128i chunk, char low, char high){
+    // NOTE: Bytes >= 0x80 are negative, so they are never considered within ASCII ranges
+    return _mm_and_si128(_mm_cmpgt_epi8(chunk, _mm_set1_epi8(low - 1)), _mm_cmplt_epi8(chunk, _mm_set1_epi8(high + 1)));
+}
+
+static inline __m128i lex_scan_sse2_identifier_mask(__m128i chunk){
+    __m128i digit = lex_scan_sse2_in_range(chunk, '0', '9');
+    __m128i alpha = lex_scan_sse2_in_range(_mm_or_si128(chunk, _mm_set1_epi8(0x20)), 'a', 'z');
+    __m128i underscore = _mm_cmpeq_epi8(chunk, _mm_set1_epi8('_'));
+    return _mm_or_si128(_mm_or_si128(digit, alpha), underscore);
+}
+#endif
+
+#ifdef LEX_SCAN_HAS_AVX2
+LEX_SCAN_AVX2_FUNCTION
+static inline __m256i lex_scan_avx2_in_range(__m256i chunk, char low, char high){
+    return _mm256_and_si256(_mm256_cmpgt_epi8(chunk, _mm256_set1_epi8(low - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8(high + 1), chunk));
+}
+
+LEX_SCAN_AVX2_FUNCTION
+static inline __m256i lex_scan_avx2_identifier_mask(__m256i chunk){
+    __m256i digit = lex_scan_avx2_in_range(chunk, '0', '9');
+    __m256i alpha = lex_scan_avx2_in_range(_mm256_or_si256(chunk, _mm256_set1_epi8(0x20)), 'a', 'z');
+    __m256i underscore = _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('_'));
+    return _mm256_or_si256(_mm256_or_si256(digit, alpha), underscore);
+}
+
+LEX_SCAN_AVX2_FUNCTION
+static const char *lex_scan_blanks_avx2(const char *p, const char *eof){
+    while(eof - p >= 32){
+        __m256i chunk = _mm256_loadu_si256((const __m256i*) p);
+        __m256i blank = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\t')));
+        unsigned int mask = ~(unsigned int) _mm256_movemask_epi8(blank);
+        if(mask) return p + __builtin_ctz(mask);
+        p += 32;
+    }
+    return p;
+}
+
+LEX_SCAN_AVX2_FUNCTION
+static const char *lex_scan_identifier_avx2(const char *p, const char *eof){
+    while(eof - p >= 32){
+        __m256i chunk = _mm256_loadu_si256((const __m256i*) p);
+        unsigned int mask = ~(unsigned int) _mm256_movemask_epi8(lex_scan_avx2_identifier_mask(chunk));
+        if(mask) return p + __builtin_ctz(mask);
+        p += 32;
+    }
+    return p;
+}
+
+LEX_SCAN_AVX2_FUNCTION
+static const char *lex_scan_either_avx2(const char *p, const char *eof, char a, char b){
+    __m256i wanted_a = _mm256_set1_epi8(a);
+    __m256i wanted_b = _mm256_set1_epi8(b);
+
+    while(eof - p >= 32){
+        __m256i chunk = _mm256_loadu_si256((const __m256i*) p);
+        unsigned int mask = (unsigned int) _mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, wanted_a), _mm256_cmpeq_epi8(chunk, wanted_b)));
+        if(mask) return p + __builtin_ctz(mask);
+        p += 32;
+    }
+    return p;
+}
+#endif
+
+#ifdef LEX_SCAN_HAS_SSE2
+static inline int lex_scan_first_set(unsigned int mask){
+    #if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(mask);
+    #else
+    int index = 0;
+    while(!(mask & 1)){
+        mask >>= 1;
+        index++;
+    }
+    return index;
+    #endif
+}
+
+static const char *lex_scan_blanks_sse2(const char *p, const char *eof){
+    while(eof - p >= 16){
+        __m128i chunk = _mm_loadu_si128((const __m128i*) p);
+        __m128i blank = _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\t')));
+        unsigned int mask = ~(unsigned int) _mm_movemask_epi8(blank) & 0xFFFF;
+        if(mask) return p + lex_scan_first_set(mask);
+        p += 16;
+    }
+    return p;
+}
+
+static const char *lex_scan_identifier_sse2(const char *p, const char *eof){
+    while(eof - p >= 16){
+        __m128i chunk = _mm_loadu_si128((const __m128i*) p);
+        unsigned int mask = ~(unsigned int) _mm_movemask_epi8(lex_scan_sse2_identifier_mask(chunk)) & 0xFFFF;
+        if(mask) return p + lex_scan_first_set(mask);
+        p += 16;
+    }
+    return p;
+}
+
+static const char *lex_scan_either_sse2(const char *p, const char *eof, char a, char b){
+    __m128i wanted_a = _mm_set1_epi8(a);
+    __m128i wanted_b = _mm_set1_epi8(b);
+
+    while(eof - p >= 16){
+        __m128i chunk = _mm_loadu_si128((const __m128i*) p);
+        unsigned int mask = (unsigned int) _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, wanted_a), _mm_cmpeq_epi8(chunk, wanted_b)));
+        if(mask) return p + lex_scan_first_set(mask);
+        p += 16;
+    }
+    return p;
+}
+#endif
+
+// NOTE: The vectorized scanners only look at whole chunks that are before 'eof',
+// so they stop early on a match or when fewer than a chunk of characters remain.
+// The rest is always finished one character at a time.
+
+const char *lex_scan_blanks(const char *p, const char *eof){
+    switch(lex_scan_get_impl()){
+    #ifdef LEX_SCAN_HAS_AVX2
+    case LEX_SCAN_AVX2:
+        p = lex_scan_blanks_avx2(p, eof);
+        break;
+    #endif
+    #ifdef LEX_SCAN_HAS_SSE2
+    case LEX_SCAN_SSE2:
+        p = lex_scan_blanks_sse2(p, eof);
+        break;
+    #endif
+    default:
+        break;
+    }
+
+    while(p < eof && lex_scan_is_blank(*p)) p++;
+    return p;
+}
+
+const char *lex_scan_line(const char *p, const char *eof){
+    return lex_scan_either(p, eof, '\n', '\n');
+}
+
+const char *lex_scan_identifier(const char *p, const char *eof){
+    switch(lex_scan_get_impl()){
+    #ifdef LEX_SCAN_HAS_AVX2
+    case LEX_SCAN_AVX2:
+        p = lex_scan_identifier_avx2(p, eof);
+        break;
+    #endif
+    #ifdef LEX_SCAN_HAS_SSE2
+    case LEX_SCAN_SSE2:
+        p = lex_scan_identifier_sse2(p, eof);
+        break;
+    #endif
+    default:
+        break;
+    }
+
+    while(p < eof && lex_scan_is_identifier(*p)) p++;
+    return p;
+}
+
+const char *lex_scan_either(const char *p, const char *eof, char a, char b){
+    switch(lex_scan_get_impl()){
+    #ifdef LEX_SCAN_HAS_AVX2
+    case LEX_SCAN_AVX2:
+        p = lex_scan_either_avx2(p, eof, a, b);
+        break;
+    #endif
+    #ifdef LEX_SCAN_HAS_SSE2
+    case LEX_SCAN_SSE2:
+        p = lex_scan_either_sse2(p, eof, a, b);
+        break;
+    #endif
+    default:
+        break;
+    }
+
+    while(p < eof && *p != a && *p != b) p++;
+    return p;
+}
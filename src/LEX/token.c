@@ -20,11 +20,12 @@ void tokenlist_print(tokenlist_t *tokenlist, const char *buffer){
     for(length_t i = 0; i != tokenlist->length; i++){
         if(buffer != NULL){
             int line, column;
-            lex_get_location(buffer, tokenlist->sources[i].index, &line, &column);
-            printf("%d:%d~%d ", line, column, (int) tokenlist->sources[i].stride);
+            lex_get_location(buffer, tokenlist->spans[i].index, &line, &column);
+            printf("%d:%d~%d ", line, column, (int) tokenlist->spans[i].stride);
         }
 
-        token_t *token = &tokenlist->tokens[i];
+        token_t token_value = tokenlist_token(tokenlist, i);
+        token_t *token = &token_value;
 
         switch(global_token_extra_format_table[token->id]){
         case TOKEN_EXTRA_DATA_FORMAT_ID_ONLY:
@@ -116,11 +117,17 @@ void token_print_literal_value(token_t *token){
 
 void tokenlist_free(tokenlist_t *tokenlist){
     for(length_t i = 0; i != tokenlist->length; i++){
-        if(tokenlist->tokens[i].id == TOKEN_STRING){
-            free(((token_string_data_t*) tokenlist->tokens[i].data)->array);
+        tokenid_t id = tokenlist->ids[i];
+        uint32_t data_index = tokenlist->spans[i].data_index;
+
+        // NOTE: Partially loaded tokenlists may not have the data of every token yet
+        if((id == TOKEN_STRING || id == TOKEN_CSTRING) && data_index < tokenlist->data_length){
+            free(((token_string_data_t*) tokenlist->data[data_index])->array);
+            free(tokenlist->data[data_index]);
         }
-        free(tokenlist->tokens[i].data);
     }
-    free(tokenlist->tokens);
-    free(tokenlist->sources);
+    free(tokenlist->ids);
+    free(tokenlist->spans);
+    free(tokenlist->data);
+    arena_free(&tokenlist->payloads);
 }
@@ -5,12 +5,18 @@
 #endif // _WIN32
 
 #include "DRVR/compiler.h"
+#include "DRVR/server.h"
+#include "UTIL/string.h"
 
 int main(int argc, char **argv){
     #ifdef _WIN32
     SetConsoleOutputCP(CP_UTF8);
     #endif
 
+    // Compile server mode
+    if(argc >= 3 && streq(argv[1], "--server")) return server_run(argv[0], argv[2]);
+    if(argc >= 3 && streq(argv[1], "--connect")) return server_connect(argv[2], argc - 3, &argv[3]);
+
     compiler_t compiler;
     compiler_init(&compiler);
     int exitcode = compiler_run(&compiler, argc, argv);
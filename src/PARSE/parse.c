@@ -3,7 +3,10 @@
 #include <stdlib.h>
 
 #include "AST/ast.h"
+#include "AST/ast_node_alloc.h"
+#include "AST/ast_serialize.h"
 #include "BRIDGE/any.h"
+#include "DRVR/ast_cache.h"
 #include "DRVR/compiler.h"
 #include "DRVR/object.h"
 #include "LEX/token.h"
@@ -22,23 +25,29 @@
 #include "TOKEN/token_data.h"
 #include "UTIL/ground.h"
 
+static errorcode_t parse_cached(parse_ctx_t *ctx);
+static errorcode_t parse_declarations(parse_ctx_t *ctx);
+
 errorcode_t parse(compiler_t *compiler, object_t *object){
     parse_ctx_t ctx;
 
     object_init_ast(object, compiler->cross_compile_for);
     parse_ctx_init(&ctx, compiler, object);
+
+    // Allocate the nodes of everything we parse (including imports) together
+    arena_t *previous_node_arena = ast_node_arena_use(&object->ast.node_arena);
     
     if(!(compiler->traits & COMPILER_INFLATE_PACKAGE)){
         any_inject_ast(ctx.ast);
         va_args_inject_ast(compiler, ctx.ast);
     }
-    
-    if(parse_tokens(&ctx)){
-        if(ctx.prename) free(ctx.prename);
-        return FAILURE;
-    }
+
+    errorcode_t errorcode = parse_tokens(&ctx);
+    ast_node_arena_use(previous_node_arena);
 
     if(ctx.prename) free(ctx.prename);
+    if(errorcode) return FAILURE;
+
     qsort(object->ast.poly_funcs, object->ast.poly_funcs_length, sizeof(ast_poly_func_t), &ast_poly_funcs_cmp);
     qsort(object->ast.polymorphic_methods, object->ast.polymorphic_methods_length, sizeof(ast_poly_func_t), &ast_poly_funcs_cmp);
     return SUCCESS;
@@ -47,17 +56,72 @@ errorcode_t parse(compiler_t *compiler, object_t *object){
 errorcode_t parse_tokens(parse_ctx_t *ctx){
     // Expects from 'ctx': compiler, object, tokenlist, ast
 
+    // Packages already contain their parsed declarations
+    if(ctx->object->traits & OBJECT_PACKAGE){
+        return compiler_import_package(ctx->compiler, ctx->object, ctx->ast);
+    }
+
+    // So do files that are in the AST cache
+    if(ctx->object->traits & OBJECT_CACHED){
+        return parse_cached(ctx);
+    }
+
+    if(ctx->compiler->ast_cache_directory == NULL){
+        return parse_declarations(ctx);
+    }
+
+    // Record what gets declared, so that this file won't have to be parsed next time
+    ast_cache_recording_t recording;
+    ast_cache_recording_init(&recording, ctx->ast, ast_cache_config_hash(ctx->compiler));
+    ctx->ast_cache_recording = &recording;
+
+    errorcode_t errorcode = parse_declarations(ctx);
+    ctx->ast_cache_recording = NULL;
+
+    // Imported files may have changed the settings that this file was parsed with
+    if(!errorcode && recording.config_hash == ast_cache_config_hash(ctx->compiler)){
+        // Failing to cache isn't an error, since the file can always be parsed again
+        ast_cache_recording_store(&recording, ctx->ast, ctx->compiler->ast_cache_directory, ctx->object->buffer, ctx->object->buffer_length);
+    }
+
+    ast_cache_recording_free(&recording);
+    return errorcode;
+}
+
+static errorcode_t parse_cached(parse_ctx_t *ctx){
+    object_t *object = ctx->object;
+    length_t position = 0;
+    ast_cache_record_t record;
+
+    while(ast_cache_entry_next(&object->cached_ast, &position, &record)){
+        if(record.kind == AST_CACHE_RECORD_IMPORT){
+            source_t source = record.source;
+            source.object_index = object->index;
+
+            if(parse_import_dependency(ctx, record.data, record.is_standard_library_component, source)) return FAILURE;
+        } else if(ast_deserialize(ctx->ast, record.data, record.length, &object->tokenlist.payloads, object->index)){
+            object_panic_plain(object, "Cached declarations are corrupted, try deleting the AST cache");
+            return FAILURE;
+        }
+    }
+
+    // Everything needed from the entry has been copied out of it
+    ast_cache_entry_free(&object->cached_ast);
+    return SUCCESS;
+}
+
+static errorcode_t parse_declarations(parse_ctx_t *ctx){
     length_t i = 0;
-    token_t *tokens = ctx->tokenlist->tokens;
+    tokenid_t *ids = ctx->tokenlist->ids;
     length_t tokens_length = ctx->tokenlist->length;
 
     for(ctx->i = &i; i != tokens_length; i++){
-        switch(tokens[i].id){
+        switch(ids[i]){
         case TOKEN_NEWLINE:
             break;
         case TOKEN_IN:
-            if(tokens[i + 1].id != TOKEN_CONSTRUCTOR){
-                compiler_panicf(ctx->compiler, ctx->tokenlist->sources[i], "Expected 'constructor' keyword after 'in'");
+            if(ids[i + 1] != TOKEN_CONSTRUCTOR){
+                compiler_panicf(ctx->compiler, tokenlist_source(ctx->tokenlist, i), "Expected 'constructor' keyword after 'in'");
                 return FAILURE;
             }
             /* fall through */
@@ -65,7 +129,7 @@ errorcode_t parse_tokens(parse_ctx_t *ctx){
             if(parse_func(ctx)) return FAILURE;
             break;
         case TOKEN_FOREIGN: {
-                tokenid_t next = tokens[i + 1].id;
+                tokenid_t next = ids[i + 1];
 
                 if(next == TOKEN_STRING || next == TOKEN_CSTRING){
                     if(parse_foreign_library(ctx)) return FAILURE;
@@ -87,7 +151,7 @@ errorcode_t parse_tokens(parse_ctx_t *ctx){
             if(parse_global_named_expression_definition(ctx)) return FAILURE;
             break;
         case TOKEN_WORD:
-            if(ctx->compiler->traits & COMPILER_COLON_COLON && tokens[i + 1].id == TOKEN_ASSOCIATE){
+            if(ctx->compiler->traits & COMPILER_COLON_COLON && ids[i + 1] == TOKEN_ASSOCIATE){
                 if(ctx->prename) free(ctx->prename);
                 ctx->prename = parse_take_word(ctx, "Expected pre-name for ::");
                 break;
@@ -95,7 +159,7 @@ errorcode_t parse_tokens(parse_ctx_t *ctx){
             if(parse_global(ctx)) return FAILURE;
             break;
         case TOKEN_EXTERNAL: {
-                tokenid_t next = tokens[i + 1].id;
+                tokenid_t next = ids[i + 1];
                 if(next == TOKEN_FUNC || next == TOKEN_STDCALL || next == TOKEN_VERBATIM || next == TOKEN_IMPLICIT){
                     if(parse_func(ctx)) return FAILURE;
                 } else {
@@ -143,7 +207,7 @@ errorcode_t parse_tokens(parse_ctx_t *ctx){
             if(parse_namespace(ctx)) return FAILURE;
             break;
         default:
-            parse_panic_token(ctx, ctx->tokenlist->sources[i], tokens[i].id, ctx->composite_association ? "Unexpected token '%s' in domain of composite" : "Unexpected token '%s' in global scope");
+            parse_panic_token(ctx, tokenlist_source(ctx->tokenlist, i), ids[i], ctx->composite_association ? "Unexpected token '%s' in domain of composite" : "Unexpected token '%s' in global scope");
             return FAILURE;
         }
     }
@@ -22,7 +22,7 @@ errorcode_t parse_alias(parse_ctx_t *ctx){
     ast_t *ast = ctx->ast;
 
     ast_type_t type;
-    source_t source = ctx->tokenlist->sources[(*ctx->i)++];
+    source_t source = tokenlist_source(ctx->tokenlist, (*ctx->i)++);
 
     if(ctx->composite_association != NULL){
         compiler_panicf(ctx->compiler, source, "Cannot declare type alias within struct domain");
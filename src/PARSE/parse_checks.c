@@ -109,6 +109,9 @@ errorcode_t validate_func_requirements(parse_ctx_t *ctx, ast_func_t *func, sourc
     }
 
     if(streq(func->name, "__variadic_array__")){
+        // Whether this is a redefinition depends on other files
+        parse_ctx_forbid_caching(ctx);
+
         // Don't allow multiple User-Defined Variadic Array Types
         if(ctx->ast->common.ast_variadic_array != NULL){
             compiler_panic(ctx->compiler, source, "Special function __variadic_array__ can only be defined once");
@@ -148,6 +151,9 @@ errorcode_t validate_func_requirements(parse_ctx_t *ctx, ast_func_t *func, sourc
     }
 
     if(streq(func->name, "__initializer_list__")){
+        // Only the first definition counts, which depends on other files
+        parse_ctx_forbid_caching(ctx);
+
         // Must return what the User-Defined Variadic InitializerList Type will be
         if(ast_type_is_void(&func->return_type)){
             compiler_panic(ctx->compiler, source, "Special function __initializer_list__ must return a value");
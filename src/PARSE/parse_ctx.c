@@ -9,6 +9,7 @@
 #include "PARSE/parse_ctx.h"
 #include "TOKEN/token_data.h"
 #include "UTIL/ground.h"
+#include "UTIL/string.h"
 #include "UTIL/trait.h"
 #include "UTIL/util.h"
 
@@ -30,6 +31,7 @@ void parse_ctx_init(parse_ctx_t *ctx, compiler_t *compiler, object_t *object){
     ctx->prename = NULL;
     ctx->struct_closer = TOKEN_CLOSE;
     ctx->struct_closer_char = ')';
+    ctx->ast_cache_recording = NULL;
 }
 
 void parse_ctx_fork(parse_ctx_t *ctx, object_t *new_object, parse_ctx_t *out_ctx_fork){
@@ -47,6 +49,11 @@ void parse_ctx_fork(parse_ctx_t *ctx, object_t *new_object, parse_ctx_t *out_ctx
     out_ctx_fork->allow_polymorphic_prereqs = false;
     out_ctx_fork->next_builtin_traits = TRAIT_NONE;
     out_ctx_fork->prename = NULL;
+    out_ctx_fork->ast_cache_recording = NULL;
+}
+
+void parse_ctx_forbid_caching(parse_ctx_t *ctx){
+    if(ctx->ast_cache_recording) ctx->ast_cache_recording->cacheable = false;
 }
 
 void parse_ctx_set_meta_else_allowed(parse_ctx_t *ctx, length_t at_ends_expected, bool allowed){
@@ -103,7 +110,7 @@ maybe_null_weak_cstr_t parse_eat_word(parse_ctx_t *ctx, const char *error){
         return NULL;
     }
 
-    return ctx->tokenlist->tokens[(*ctx->i)++].data;
+    return tokenlist_data(ctx->tokenlist, (*ctx->i)++);
 }
 
 maybe_null_weak_cstr_t parse_eat_string(parse_ctx_t *ctx, const char *error){
@@ -115,7 +122,7 @@ maybe_null_weak_cstr_t parse_eat_string(parse_ctx_t *ctx, const char *error){
 
     if(id == TOKEN_CSTRING || id == TOKEN_STRING){
         // Do lazy conversion to weak c-string
-        return ((token_string_data_t*) ctx->tokenlist->tokens[(*ctx->i)++].data)->array;
+        return ((token_string_data_t*) tokenlist_data(ctx->tokenlist, (*ctx->i)++))->array;
     }
 
     // ERROR: That token isn't a string
@@ -154,9 +161,9 @@ maybe_null_strong_cstr_t parse_take_string(parse_ctx_t *ctx, const char *error){
         return NULL;
     }
 
-    strong_cstr_t ownership = (char*) parse_ctx_peek_data_take(ctx);
+    token_string_data_t *string_data = (token_string_data_t*) parse_ctx_peek_data(ctx);
     *ctx->i += 1;
-    return ownership;
+    return strclone(string_data->array);
 }
 
 // =================================================
@@ -190,7 +197,7 @@ maybe_null_weak_cstr_t parse_grab_string(parse_ctx_t *ctx, const char *error){
     
     if(id == TOKEN_CSTRING || id == TOKEN_STRING){
         // Do lazy conversion to weak c-string
-        return ((token_string_data_t*) ctx->tokenlist->tokens[(*ctx->i)].data)->array;
+        return ((token_string_data_t*) tokenlist_data(ctx->tokenlist, *ctx->i))->array;
     }
 
     // ERROR: That token isn't a string
@@ -208,22 +215,19 @@ void parse_prepend_namespace(parse_ctx_t *ctx, strong_cstr_t *inout_name){
 }
 
 tokenid_t parse_ctx_peek(parse_ctx_t *ctx){
-    return ctx->tokenlist->tokens[*ctx->i].id;
+    return ctx->tokenlist->ids[*ctx->i];
 }
 
 source_t parse_ctx_peek_source(parse_ctx_t *ctx){
-    return ctx->tokenlist->sources[*ctx->i];
+    return tokenlist_source(ctx->tokenlist, *ctx->i);
 }
 
 void *parse_ctx_peek_data(parse_ctx_t *ctx){
-    return ctx->tokenlist->tokens[*ctx->i].data;
+    return tokenlist_data(ctx->tokenlist, *ctx->i);
 }
 
 void *parse_ctx_peek_data_take(parse_ctx_t *ctx){
-    token_t *token = &ctx->tokenlist->tokens[*ctx->i];
-    void *tmp = token->data;
-    token->data = NULL;
-    return tmp;
+    return strclone(tokenlist_data(ctx->tokenlist, *ctx->i));
 }
 
 bool parse_ctx_at_end(parse_ctx_t *ctx){
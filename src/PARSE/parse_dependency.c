@@ -5,6 +5,7 @@
 #include <string.h>
 
 #include "AST/ast.h"
+#include "DRVR/ast_cache.h"
 #include "DRVR/compiler.h"
 #include "DRVR/object.h"
 #include "LEX/token.h"
@@ -16,8 +17,36 @@
 #include "UTIL/ground.h"
 #include "UTIL/string.h"
 #include "UTIL/string_list.h"
+#include "UTIL/string_map.h"
 #include "UTIL/util.h"
 
+static maybe_null_strong_cstr_t parse_search_for_import(compiler_t *compiler, maybe_null_strong_cstr_t local, weak_cstr_t filename){
+    // NOTE: Takes ownership of 'local'
+    strong_cstr_t test;
+
+    if(local){
+        if(file_exists(local)) return local;
+        free(local);
+    }
+
+    test = filename_adept_import(compiler->root, filename);
+    if(file_exists(test)) return test;
+    free(test);
+
+    for(length_t i = 0; i != compiler->user_search_paths.length; i++){
+        weak_cstr_t path = compiler->user_search_paths.items[i];
+        length_t path_length = strlen(path);
+        
+        bool append_slash = path_length && path[path_length - 1] != '/' && path[path_length - 1] != '\\';
+        test = mallocandsprintf(append_slash ? "%s/%s" : "%s%s", path, filename);
+        if(file_exists(test)) return test;
+
+        free(test);
+    }
+    
+    return NULL;
+}
+
 errorcode_t parse_import(parse_ctx_t *ctx){
     // import 'some_file.adept'
     //   ^
@@ -28,45 +57,52 @@ errorcode_t parse_import(parse_ctx_t *ctx){
         return FAILURE;
     }
 
-    // Figure out the filename
+    // Figure out what to import
     source_t source = NULL_SOURCE;
-    maybe_null_strong_cstr_t file = NULL;
-    bool is_standard_library_component = ctx->tokenlist->tokens[*ctx->i + 1].id == TOKEN_WORD;
+    bool is_standard_library_component = ctx->tokenlist->ids[*ctx->i + 1] == TOKEN_WORD;
 
     if(is_standard_library_component){
         // import standard_library_module
         //   ^
 
-        // Get stdlib location
-        strong_cstr_t standard_library_folder = compiler_get_stdlib(ctx->compiler, ctx->object);
-
         strong_cstr_t full_component = parse_standard_library_component(ctx, &source);
         if(full_component == NULL) return FAILURE;
 
-        // Combine standard library and component name to create the filename
-        file = mallocandsprintf("%s%s.adept", standard_library_folder, full_component);
+        errorcode_t errorcode = parse_import_dependency(ctx, full_component, true, source);
         free(full_component);
-        free(standard_library_folder);
+        return errorcode;
     } else {
         // Grab filename string of what file to import
-        file = parse_grab_string(ctx, "Expected filename string or standard library component after 'import' keyword");
-
-        // Make it a 'strong_cstr_t'
-        file = file ? strclone(file) : NULL;
+        weak_cstr_t file = parse_grab_string(ctx, "Expected filename string or standard library component after 'import' keyword");
+        if(file == NULL) return FAILURE;
 
         // Set code source
-        source = ctx->tokenlist->sources[(*ctx->i)++];
+        source = tokenlist_source(ctx->tokenlist, (*ctx->i)++);
+        return parse_import_dependency(ctx, file, false, source);
     }
-    
-    if(file == NULL) return FAILURE;
+}
 
-    if(parse_do_import(ctx, file, source, !is_standard_library_component)){
-        free(file);
-        return FAILURE;
+errorcode_t parse_import_dependency(parse_ctx_t *ctx, weak_cstr_t target, bool is_standard_library_component, source_t source){
+    ast_cache_recording_t *recording = ctx->ast_cache_recording;
+    if(recording) ast_cache_record_import(recording, ctx->ast, target, is_standard_library_component, source);
+
+    strong_cstr_t file;
+
+    if(is_standard_library_component){
+        // Combine standard library and component name to create the filename
+        strong_cstr_t standard_library_folder = compiler_get_stdlib(ctx->compiler, ctx->object);
+        file = mallocandsprintf("%s%s.adept", standard_library_folder, target);
+        free(standard_library_folder);
+    } else {
+        file = strclone(target);
     }
-    
+
+    errorcode_t errorcode = parse_do_import(ctx, file, source, !is_standard_library_component);
     free(file);
-    return SUCCESS;
+
+    // Declarations from the imported file belong to its own cache entry
+    if(recording) ast_cache_record_skip(recording, ctx->ast);
+    return errorcode;
 }
 
 errorcode_t parse_do_import(parse_ctx_t *ctx, weak_cstr_t file, source_t source, bool allow_local){
@@ -112,17 +148,17 @@ errorcode_t parse_foreign_library(parse_ctx_t *ctx){
     char kind = LIBRARY_KIND_NONE;
 
     length_t *i = ctx->i;
-    token_t *tokens = ctx->tokenlist->tokens;
+    tokenid_t *ids = ctx->tokenlist->ids;
 
-    if(tokens[*i + 1].id == TOKEN_WORD){
-        const char *data = tokens[++(*i)].data;
+    if(ids[*i + 1] == TOKEN_WORD){
+        const char *data = tokenlist_data(ctx->tokenlist, ++(*i));
 
         if(streq(data, "framework")){
             kind = LIBRARY_KIND_FRAMEWORK;
         } else if(streq(data, "library")){
             kind = LIBRARY_KIND_LIBRARY;
         } else {
-            compiler_panicf(ctx->compiler, ctx->tokenlist->sources[*i], "Unrecognized foreign library type '%s'", data);
+            compiler_panicf(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Unrecognized foreign library type '%s'", data);
             return FAILURE;
         }
     }
@@ -165,7 +201,7 @@ maybe_null_strong_cstr_t parse_standard_library_component(parse_ctx_t *ctx, sour
     // Set base source
     *out_source = parse_ctx_peek_source(ctx);
 
-    while(ctx->tokenlist->tokens[*ctx->i + 1].id == TOKEN_DIVIDE){
+    while(ctx->tokenlist->ids[*ctx->i + 1] == TOKEN_DIVIDE){
         // Skip over previous component name
         (*ctx->i)++;
 
@@ -201,48 +237,62 @@ maybe_null_strong_cstr_t parse_standard_library_component(parse_ctx_t *ctx, sour
 }
 
 maybe_null_strong_cstr_t parse_find_import(parse_ctx_t *ctx, weak_cstr_t filename, source_t source, bool allow_local_import){
-    strong_cstr_t test;
+    maybe_null_strong_cstr_t found = parse_find_import_quietly(ctx->compiler, ctx->object->filename, filename, allow_local_import);
 
-    if(allow_local_import){
-        test = filename_local(ctx->object->filename, filename);
-        if(file_exists(test)) return test;
-        free(test);
+    if(found == NULL){
+        compiler_panicf(ctx->compiler, source, "The file '%s' doesn't exist", filename);
     }
 
-    test = filename_adept_import(ctx->compiler->root, filename);
-    if(file_exists(test)) return test;
-    free(test);
+    return found;
+}
 
-    for(length_t i = 0; i != ctx->compiler->user_search_paths.length; i++){
-        weak_cstr_t path = ctx->compiler->user_search_paths.items[i];
-        length_t path_length = strlen(path);
-        
-        bool append_slash = path_length && path[path_length - 1] != '/' && path[path_length - 1] != '\\';
-        test = mallocandsprintf(append_slash ? "%s/%s" : "%s%s", path, filename);
-        if(file_exists(test)) return test;
+maybe_null_strong_cstr_t parse_find_import_quietly(compiler_t *compiler, weak_cstr_t current_filename, weak_cstr_t filename, bool allow_local_import){
+    // Where an import ends up only depends on the local candidate (if any) and the requested filename,
+    // so remember the result for when the same request is made again
+    strong_cstr_t local = allow_local_import ? filename_local(current_filename, filename) : NULL;
+    strong_cstr_t key = mallocandsprintf("%s\n%s", local ? local : "", filename);
 
-        free(test);
+    maybe_null_weak_cstr_t cached = string_map_find(&compiler->import_resolutions, key);
+
+    if(cached){
+        free(local);
+        free(key);
+        return strclone(cached);
     }
-    
-    compiler_panicf(ctx->compiler, source, "The file '%s' doesn't exist", filename);
-    return NULL;
+
+    maybe_null_strong_cstr_t found = parse_search_for_import(compiler, local, filename);
+
+    if(found){
+        // NOTE: Search paths are only ever appended to, so a found file will always be found first
+        string_map_insert(&compiler->import_resolutions, key, strclone(found));
+    } else {
+        free(key);
+    }
+
+    return found;
 }
 
 maybe_null_strong_cstr_t parse_resolve_import(parse_ctx_t *ctx, weak_cstr_t filename){
-    char *absolute = filename_absolute(filename);
+    char *absolute = parse_resolve_import_quietly(ctx->compiler, filename);
     if(absolute) return absolute;
 
     compiler_panicf(ctx->compiler, parse_ctx_peek_source(ctx), "INTERNAL ERROR: Failed to get absolute path of filename '%s'", filename);
     return NULL;
 }
 
-bool already_imported(parse_ctx_t *ctx, weak_cstr_t filename){
-    object_t **objects = ctx->compiler->objects;
-    length_t objects_length = ctx->compiler->objects_length;
+maybe_null_strong_cstr_t parse_resolve_import_quietly(compiler_t *compiler, weak_cstr_t filename){
+    maybe_null_weak_cstr_t cached = string_map_find(&compiler->absolute_filenames, filename);
+    if(cached) return strclone(cached);
+
+    maybe_null_strong_cstr_t absolute = filename_absolute(filename);
 
-    for(length_t i = 0; i != objects_length; i++){
-        if(streq(objects[i]->full_filename, filename)) return true;
+    if(absolute){
+        string_map_insert(&compiler->absolute_filenames, strclone(filename), strclone(absolute));
     }
 
-    return false;
+    return absolute;
+}
+
+bool already_imported(parse_ctx_t *ctx, weak_cstr_t filename){
+    return string_map_has(&ctx->compiler->imported_files, filename);
 }
@@ -44,11 +44,14 @@ errorcode_t parse_enum(parse_ctx_t *ctx, bool is_foreign){
     if(parse_enum_body(ctx, &kinds, &length)) return FAILURE;
 
     ast_add_enum(ctx->ast, name, kinds, length, source);
+    free(name);
 
     if(is_foreign){
+        weak_cstr_t enum_name = ctx->ast->enums[ctx->ast->enums_length - 1].name;
+
         // Automatically add defines so using the enum name is optional
         for(length_t i = 0; i != length; i++){
-            ast_expr_t *value = ast_expr_create_enum_value(name, kinds[i], source);
+            ast_expr_t *value = ast_expr_create_enum_value(enum_name, kinds[i], source);
             ast_add_global_named_expression(ctx->ast, ast_named_expression_create(strclone(kinds[i]), value, TRAIT_NONE, source));
         }
     }
@@ -58,7 +61,6 @@ errorcode_t parse_enum(parse_ctx_t *ctx, bool is_foreign){
 
 errorcode_t parse_enum_body(parse_ctx_t *ctx, weak_cstr_t **kinds, length_t *length){
     length_t *i = ctx->i;
-    source_t *sources = ctx->tokenlist->sources;
     length_t capacity = 0;
 
     *kinds = NULL;
@@ -86,7 +88,7 @@ errorcode_t parse_enum_body(parse_ctx_t *ctx, weak_cstr_t **kinds, length_t *len
         }
 
         if(parse_eat(ctx, TOKEN_NEXT, NULL) != SUCCESS && parse_ctx_peek(ctx) != TOKEN_CLOSE){
-            compiler_panic(ctx->compiler, sources[*i], "Expected ',' after element");
+            compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Expected ',' after element");
             goto failure;
         }
 
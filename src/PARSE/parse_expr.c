@@ -6,6 +6,7 @@
 
 #include "AST/ast.h"
 #include "AST/ast_expr.h"
+#include "AST/ast_node_alloc.h"
 #include "AST/ast_type.h"
 #include "AST/meta_directives.h"
 #include "DRVR/compiler.h"
@@ -34,18 +35,17 @@ errorcode_t parse_expr(parse_ctx_t *ctx, ast_expr_t **out_expr){
 
 errorcode_t parse_primary_expr(parse_ctx_t *ctx, ast_expr_t **out_expr){
     length_t *i = ctx->i;
-    token_t *tokens = ctx->tokenlist->tokens;
-    source_t *sources = ctx->tokenlist->sources;
+    tokenid_t *ids = ctx->tokenlist->ids;
 
     #define LITERAL_TO_EXPR(expr_type, expr_id, storage_type){                \
-        *out_expr = (ast_expr_t*) malloc(sizeof(expr_type));                  \
+        *out_expr = (ast_expr_t*) ast_node_alloc(sizeof(expr_type));          \
         ((expr_type *)*out_expr)->id = expr_id;                               \
-        ((expr_type *)*out_expr)->value = *((storage_type *)tokens[*i].data); \
-        ((expr_type *)*out_expr)->source = sources[(*i)++];                   \
+        ((expr_type *)*out_expr)->value = *((storage_type *)tokenlist_data(ctx->tokenlist, *i)); \
+        ((expr_type *)*out_expr)->source = tokenlist_source(ctx->tokenlist, (*i)++);                   \
     }
     
     // TODO: CLEANUP: This code should be cleaned up
-    switch (tokens[*i].id){
+    switch (ids[*i]){
     case TOKEN_BYTE:
         LITERAL_TO_EXPR(ast_expr_byte_t, EXPR_BYTE, adept_byte);
         break;
@@ -86,25 +86,25 @@ errorcode_t parse_primary_expr(parse_ctx_t *ctx, ast_expr_t **out_expr){
         LITERAL_TO_EXPR(ast_expr_generic_float_t, EXPR_GENERIC_FLOAT, adept_generic_float);
         break;
     case TOKEN_TRUE:
-        *out_expr = ast_expr_create_bool(true, sources[(*i)++]);
+        *out_expr = ast_expr_create_bool(true, tokenlist_source(ctx->tokenlist, (*i)++));
         break;
     case TOKEN_FALSE:
-        *out_expr = ast_expr_create_bool(false, sources[(*i)++]);
+        *out_expr = ast_expr_create_bool(false, tokenlist_source(ctx->tokenlist, (*i)++));
         break;
     case TOKEN_CSTRING: {
-            token_string_data_t *string_data = (token_string_data_t*) tokens[*i].data;
-            *out_expr = ast_expr_create_cstring_of_length(string_data->array, string_data->length, sources[*i]);
+            token_string_data_t *string_data = (token_string_data_t*) tokenlist_data(ctx->tokenlist, *i);
+            *out_expr = ast_expr_create_cstring_of_length(string_data->array, string_data->length, tokenlist_source(ctx->tokenlist, *i));
             *i += 1;
         }
         break;
     case TOKEN_STRING: {
-            token_string_data_t *string_data = (token_string_data_t*) tokens[*i].data;
-            *out_expr = ast_expr_create_string(string_data->array, string_data->length, sources[*i]);
+            token_string_data_t *string_data = (token_string_data_t*) tokenlist_data(ctx->tokenlist, *i);
+            *out_expr = ast_expr_create_string(string_data->array, string_data->length, tokenlist_source(ctx->tokenlist, *i));
             *i += 1;
         }
         break;
     case TOKEN_NULL:
-        *out_expr = ast_expr_create_null(sources[(*i)++]);
+        *out_expr = ast_expr_create_null(tokenlist_source(ctx->tokenlist, (*i)++));
         break;
     case TOKEN_WORD:
         if(parse_expr_word(ctx, out_expr)) return FAILURE;
@@ -170,19 +170,22 @@ errorcode_t parse_primary_expr(parse_ctx_t *ctx, ast_expr_t **out_expr){
         if(parse_expr_mutable_unary_prefix(ctx, EXPR_PREDECREMENT, "--", out_expr)) return FAILURE;
         break;
     case TOKEN_META: {
-            weak_cstr_t directive = tokens[(*i)++].data;
+            weak_cstr_t directive = tokenlist_data(ctx->tokenlist, (*i)++);
 
             if(!streq(directive, "get")){
-                compiler_panicf(ctx->compiler, sources[*i - 1], "Unexpected meta directive '%s' in expression", directive);
+                compiler_panicf(ctx->compiler, tokenlist_source(ctx->tokenlist, *i - 1), "Unexpected meta directive '%s' in expression", directive);
                 return FAILURE;
             }
 
+            // The value of a transcendant variable isn't part of the AST
+            parse_ctx_forbid_caching(ctx);
+
             // Parse name of transcendant variable to get
             weak_cstr_t transcendant_name = parse_eat_word(ctx, "Expected transcendant variable name after '#get'");
             if(transcendant_name == NULL) return FAILURE;
 
             meta_expr_t *value;
-            meta_expr_t *special_result = meta_get_special_variable(ctx->compiler, ctx->object, transcendant_name, sources[*i - 1]);
+            meta_expr_t *special_result = meta_get_special_variable(ctx->compiler, ctx->object, transcendant_name, tokenlist_source(ctx->tokenlist, *i - 1));
 
             if(special_result){
                 value = special_result;
@@ -190,7 +193,7 @@ errorcode_t parse_primary_expr(parse_ctx_t *ctx, ast_expr_t **out_expr){
                 meta_definition_t *definition = meta_definition_find(ctx->ast->meta_definitions, ctx->ast->meta_definitions_length, transcendant_name);
 
                 if(definition == NULL){
-                    compiler_panicf(ctx->compiler, sources[*i - 1], "Transcendant variable '%s' does not exist", transcendant_name);
+                    compiler_panicf(ctx->compiler, tokenlist_source(ctx->tokenlist, *i - 1), "Transcendant variable '%s' does not exist", transcendant_name);
                     return FAILURE;
                 }
 
@@ -198,37 +201,37 @@ errorcode_t parse_primary_expr(parse_ctx_t *ctx, ast_expr_t **out_expr){
             }
 
             if(!IS_META_EXPR_ID_COLLAPSED(value->id)){
-                compiler_panicf(ctx->compiler, sources[*i - 1], "INTERNAL ERROR: Meta expression expected to be collapsed");
+                compiler_panicf(ctx->compiler, tokenlist_source(ctx->tokenlist, *i - 1), "INTERNAL ERROR: Meta expression expected to be collapsed");
                 return FAILURE;
             }
 
             switch(value->id){
              case META_EXPR_UNDEF: case META_EXPR_NULL:
-                *out_expr = ast_expr_create_null(sources[*i - 1]);
+                *out_expr = ast_expr_create_null(tokenlist_source(ctx->tokenlist, *i - 1));
                 break;
             case META_EXPR_TRUE:
-                *out_expr = ast_expr_create_bool(true, sources[*i - 1]);
+                *out_expr = ast_expr_create_bool(true, tokenlist_source(ctx->tokenlist, *i - 1));
                 break;
             case META_EXPR_FALSE:
-                *out_expr = ast_expr_create_bool(false, sources[*i - 1]);
+                *out_expr = ast_expr_create_bool(false, tokenlist_source(ctx->tokenlist, *i - 1));
                 break;
             case META_EXPR_STR: {
                     meta_expr_str_t *str = (meta_expr_str_t*) value;
-                    *out_expr = ast_expr_create_string(str->value, strlen(str->value), sources[*i - 1]);
+                    *out_expr = ast_expr_create_string(str->value, strlen(str->value), tokenlist_source(ctx->tokenlist, *i - 1));
                 }
                 break;
             case META_EXPR_INT: {
                     meta_expr_int_t *integer = (meta_expr_int_t*) value;
-                    *out_expr = ast_expr_create_long(integer->value, sources[*i - 1]);
+                    *out_expr = ast_expr_create_long(integer->value, tokenlist_source(ctx->tokenlist, *i - 1));
                 }
                 break;
             case META_EXPR_FLOAT: {
                     meta_expr_float_t *floating_point = (meta_expr_float_t*) value;
-                    *out_expr = ast_expr_create_double(floating_point->value, sources[*i - 1]);
+                    *out_expr = ast_expr_create_double(floating_point->value, tokenlist_source(ctx->tokenlist, *i - 1));
                 }
                 break;
             default:
-                compiler_panicf(ctx->compiler, sources[*i - 1], "INTERNAL ERROR: '#get %s' failed to morph transcendant value into literal\n", transcendant_name);
+                compiler_panicf(ctx->compiler, tokenlist_source(ctx->tokenlist, *i - 1), "INTERNAL ERROR: '#get %s' failed to morph transcendant value into literal\n", transcendant_name);
                 return FAILURE;
             }
             break;
@@ -237,7 +240,7 @@ errorcode_t parse_primary_expr(parse_ctx_t *ctx, ast_expr_t **out_expr){
             // va_arg(list, Type)
             //   ^
             
-            source_t source = sources[(*i)++];
+            source_t source = tokenlist_source(ctx->tokenlist, (*i)++);
 
             // Eat '('
             if(parse_eat(ctx, TOKEN_OPEN, "Expected '(' after va_arg keyword")) return FAILURE;
@@ -271,11 +274,11 @@ errorcode_t parse_primary_expr(parse_ctx_t *ctx, ast_expr_t **out_expr){
         if(parse_expr_initlist(ctx, out_expr)) return FAILURE;
         break;
     case TOKEN_POLYCOUNT:
-        *out_expr = ast_expr_create_polycount(sources[*i], (strong_cstr_t) parse_ctx_peek_data_take(ctx));
+        *out_expr = ast_expr_create_polycount(tokenlist_source(ctx->tokenlist, *i), (strong_cstr_t) parse_ctx_peek_data_take(ctx));
         *i += 1;
         break;
     case TOKEN_TYPENAMEOF: {
-            source_t source = sources[(*i)++];
+            source_t source = tokenlist_source(ctx->tokenlist, (*i)++);
             
             ast_type_t type;
             if(parse_type(ctx, &type)) return FAILURE;
@@ -284,7 +287,7 @@ errorcode_t parse_primary_expr(parse_ctx_t *ctx, ast_expr_t **out_expr){
         }
         break;
     case TOKEN_EMBED: {
-            source_t source = sources[(*i)++];
+            source_t source = tokenlist_source(ctx->tokenlist, (*i)++);
 
             maybe_null_weak_cstr_t filename = parse_eat_string(ctx, "Expected filename after 'embed' keyword");
             if(filename == NULL) return FAILURE;
@@ -293,7 +296,7 @@ errorcode_t parse_primary_expr(parse_ctx_t *ctx, ast_expr_t **out_expr){
         }
         break;
     case TOKEN_ASSOCIATE: {
-            source_t source = sources[(*i)++];
+            source_t source = tokenlist_source(ctx->tokenlist, (*i)++);
 
             weak_cstr_t kind_name = parse_eat_word(ctx, "Expected enum value name after '::' operator");
             if(kind_name == NULL) return FAILURE;
@@ -303,7 +306,7 @@ errorcode_t parse_primary_expr(parse_ctx_t *ctx, ast_expr_t **out_expr){
         }
         break;
     default:
-        parse_panic_token(ctx, sources[*i], tokens[*i].id, "Unexpected token '%s' in expression");
+        parse_panic_token(ctx, tokenlist_source(ctx->tokenlist, *i), ids[*i], "Unexpected token '%s' in expression");
         return FAILURE;
     }
 
@@ -320,15 +323,14 @@ errorcode_t parse_expr_post(parse_ctx_t *ctx, ast_expr_t **inout_expr){
     // Handle [] and '.' operators etc.
 
     length_t *i = ctx->i;
-    token_t *tokens = ctx->tokenlist->tokens;
-    source_t *sources = ctx->tokenlist->sources;
+    tokenid_t *ids = ctx->tokenlist->ids;
 
     // TODO: CLEANUP: Clean up this messy code
     while(true){
-        switch(tokens[*i].id){
+        switch(ids[*i]){
         case TOKEN_BRACKET_OPEN: {
                 ast_expr_t *index_expr;
-                source_t source = sources[(*i)++];
+                source_t source = tokenlist_source(ctx->tokenlist, (*i)++);
                 
                 if(parse_expr(ctx, &index_expr)) return FAILURE;
 
@@ -366,7 +368,7 @@ errorcode_t parse_expr_post(parse_ctx_t *ctx, ast_expr_t **inout_expr){
                     if(parse_expr_arguments(ctx, &call_expr->args, &call_expr->arity, NULL)){
                         ctx->ignore_newlines_in_expr_depth--;
                         free(call_expr->name);
-                        free(call_expr);
+                        ast_node_free(call_expr);
                         return FAILURE;
                     }
 
@@ -377,7 +379,7 @@ errorcode_t parse_expr_post(parse_ctx_t *ctx, ast_expr_t **inout_expr){
                         if(parse_type(ctx, &call_expr->gives)){
                             ast_exprs_free_fully(call_expr->args, call_expr->arity);
                             free(call_expr->name);
-                            free(call_expr);
+                            ast_node_free(call_expr);
                             return FAILURE;
                         }
                     } else {
@@ -400,7 +402,7 @@ errorcode_t parse_expr_post(parse_ctx_t *ctx, ast_expr_t **inout_expr){
             if(parse_expr_at(ctx, inout_expr)) return FAILURE;
             break;
         case TOKEN_INCREMENT: case TOKEN_DECREMENT: {
-                source_t source = sources[*i];
+                source_t source = tokenlist_source(ctx->tokenlist, *i);
                 bool is_increment = parse_ctx_peek(ctx) == TOKEN_INCREMENT;
 
                 *i += 1;
@@ -419,11 +421,11 @@ errorcode_t parse_expr_post(parse_ctx_t *ctx, ast_expr_t **inout_expr){
             break;
         case TOKEN_TOGGLE: {
                 if(!expr_is_mutable(*inout_expr)){
-                    compiler_panic(ctx->compiler, sources[*i], "Cannot perform '!!' operator on immutable values");
+                    compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Cannot perform '!!' operator on immutable values");
                     return FAILURE;
                 }
 
-                *inout_expr = ast_expr_create_toggle(sources[(*i)++], *inout_expr);
+                *inout_expr = ast_expr_create_toggle(tokenlist_source(ctx->tokenlist, (*i)++), *inout_expr);
             }
             break;
         default:
@@ -531,7 +533,7 @@ static errorcode_t parse_expr_ternary(parse_ctx_t *ctx, ast_expr_t **inout_condi
 
     // Expect ':'
     if(parse_ctx_peek(ctx) != TOKEN_COLON){
-        compiler_panic(ctx->compiler, ctx->tokenlist->sources[*ctx->i], "Ternary operator expected ':' after expression");
+        compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *ctx->i), "Ternary operator expected ':' after expression");
         goto failure;
     }
     *ctx->i += 1;
@@ -559,8 +561,7 @@ failure:
 
 errorcode_t parse_op_expr(parse_ctx_t *ctx, int precedence, ast_expr_t **inout_left, bool keep_mutable){
     length_t *i = ctx->i;
-    token_t *tokens = ctx->tokenlist->tokens;
-    source_t *sources = ctx->tokenlist->sources;
+    tokenid_t *ids = ctx->tokenlist->ids;
 
     while(*i != ctx->tokenlist->length) {
         int operator;
@@ -568,8 +569,8 @@ errorcode_t parse_op_expr(parse_ctx_t *ctx, int precedence, ast_expr_t **inout_l
 
         // Await possible termination operators
         while(true){
-            operator = tokens[*i].id;
-            source = sources[*i];
+            operator = ids[*i];
+            source = tokenlist_source(ctx->tokenlist, *i);
 
             // If there is still more to the expression, keep going
             if(!parse_expr_has_terminating_token(operator)) break;
@@ -660,7 +661,7 @@ errorcode_t parse_op_expr(parse_ctx_t *ctx, int precedence, ast_expr_t **inout_l
             if(parse_expr_ternary(ctx, inout_left, source)) return FAILURE;
             break;
         default:
-            parse_panic_token(ctx, sources[*i], tokens[*i].id, "Unrecognized operator '%s' in expression");
+            parse_panic_token(ctx, tokenlist_source(ctx->tokenlist, *i), ids[*i], "Unrecognized operator '%s' in expression");
             ast_expr_free_fully(*inout_left);
             return FAILURE;
         }
@@ -678,13 +679,13 @@ errorcode_t parse_rhs_expr(parse_ctx_t *ctx, ast_expr_t **left, ast_expr_t **out
     // Expects 'i' to point to the operator token
 
     length_t *i = ctx->i;
-    token_t *tokens = ctx->tokenlist->tokens;
+    tokenid_t *ids = ctx->tokenlist->ids;
 
     (*i)++; // Skip over operator token
 
     if(parse_ignore_newlines(ctx, "Unexpected expression termination")) return FAILURE;
 
-    if(parse_primary_expr(ctx, out_right) || (op_prec < parse_get_precedence(tokens[*i].id) && parse_op_expr(ctx, op_prec + 1, out_right, false))){
+    if(parse_primary_expr(ctx, out_right) || (op_prec < parse_get_precedence(ids[*i]) && parse_op_expr(ctx, op_prec + 1, out_right, false))){
         ast_expr_free_fully(*left);
         return FAILURE;
     }
@@ -694,22 +695,22 @@ errorcode_t parse_rhs_expr(parse_ctx_t *ctx, ast_expr_t **left, ast_expr_t **out
 
 errorcode_t parse_expr_word(parse_ctx_t *ctx, ast_expr_t **out_expr){
     length_t *i = ctx->i;
-    token_t *tokens = ctx->tokenlist->tokens;
+    tokenid_t *ids = ctx->tokenlist->ids;
 
-    switch(tokens[*i + 1].id){
+    switch(ids[*i + 1]){
     case TOKEN_OPEN:      return parse_expr_call(ctx, out_expr, false);
     case TOKEN_ASSOCIATE: return parse_expr_enum_value(ctx, out_expr);
     }
 
-    weak_cstr_t variable_name = tokens[*i].data;
-    *out_expr = ast_expr_create_variable(variable_name, ctx->tokenlist->sources[(*i)++]);
+    weak_cstr_t variable_name = tokenlist_data(ctx->tokenlist, *i);
+    *out_expr = ast_expr_create_variable(variable_name, tokenlist_source(ctx->tokenlist, (*i)++));
     return SUCCESS;
 }
 
 errorcode_t parse_expr_call(parse_ctx_t *ctx, ast_expr_t **out_expr, bool allow_tentative){
     // NOTE: Assumes name and open token
 
-    source_t source = ctx->tokenlist->sources[*ctx->i];
+    source_t source = tokenlist_source(ctx->tokenlist, *ctx->i);
 
     strong_cstr_t name = parse_take_word(ctx, "Expected function name");
     if(name == NULL) return FAILURE;
@@ -785,12 +786,12 @@ errorcode_t parse_expr_arguments(parse_ctx_t *ctx, ast_expr_t ***out_args, lengt
     // (arg1, arg2, arg3)
     //  ^
 
-    token_t *tokens = ctx->tokenlist->tokens;
+    tokenid_t *ids = ctx->tokenlist->ids;
     length_t *i = ctx->i;
 
     ast_expr_list_t args = ast_expr_list_create(0);
 
-    while(tokens[*i].id != TOKEN_CLOSE){
+    while(ids[*i] != TOKEN_CLOSE){
         ast_expr_t *arg_expr;
 
         if(parse_ignore_newlines(ctx, "Expected argument") || parse_expr(ctx, &arg_expr)){
@@ -803,10 +804,10 @@ errorcode_t parse_expr_arguments(parse_ctx_t *ctx, ast_expr_t ***out_args, lengt
             goto failure;
         }
 
-        if(tokens[*i].id == TOKEN_NEXT){
+        if(ids[*i] == TOKEN_NEXT){
             (*i)++;
-        } else if(tokens[*i].id != TOKEN_CLOSE){
-            compiler_panic(ctx->compiler, ctx->tokenlist->sources[*i], "Expected ',' or ')' after expression");
+        } else if(ids[*i] != TOKEN_CLOSE){
+            compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Expected ',' or ')' after expression");
             goto failure;
         }
     }
@@ -828,10 +829,9 @@ errorcode_t parse_expr_enum_value(parse_ctx_t *ctx, ast_expr_t **out_expr){
     // NOTE: Assumes name and open token
 
     length_t *i = ctx->i;
-    token_t *tokens = ctx->tokenlist->tokens;
 
-    weak_cstr_t enum_name = tokens[*i].data;
-    source_t source = ctx->tokenlist->sources[(*i)++];
+    weak_cstr_t enum_name = tokenlist_data(ctx->tokenlist, *i);
+    source_t source = tokenlist_source(ctx->tokenlist, (*i)++);
 
     // (Shouldn't fail unless something weird is going on)
     if(parse_eat(ctx, TOKEN_ASSOCIATE, "Expected '::' operator for enum value")) return FAILURE;
@@ -844,12 +844,12 @@ errorcode_t parse_expr_enum_value(parse_ctx_t *ctx, ast_expr_t **out_expr){
 }
 
 errorcode_t parse_expr_address(parse_ctx_t *ctx, ast_expr_t **out_expr){
-    ast_expr_unary_t *addr_expr = malloc(sizeof(ast_expr_unary_t));
+    ast_expr_unary_t *addr_expr = ast_node_alloc(sizeof(ast_expr_unary_t));
     addr_expr->id = EXPR_ADDRESS;
-    addr_expr->source = ctx->tokenlist->sources[(*ctx->i)++];
+    addr_expr->source = tokenlist_source(ctx->tokenlist, (*ctx->i)++);
 
     if(parse_primary_expr(ctx, &addr_expr->value) || parse_op_expr(ctx, 0, &addr_expr->value, true)){
-        free(addr_expr);
+        ast_node_free(addr_expr);
         return FAILURE;
     }
 
@@ -864,13 +864,13 @@ errorcode_t parse_expr_address(parse_ctx_t *ctx, ast_expr_t **out_expr){
 }
 
 int parse_expr_func_address(parse_ctx_t *ctx, ast_expr_t **out_expr){
-    ast_expr_func_addr_t *func_addr_expr = malloc(sizeof(ast_expr_func_addr_t));
+    ast_expr_func_addr_t *func_addr_expr = ast_node_alloc(sizeof(ast_expr_func_addr_t));
 
     length_t *i = ctx->i;
-    token_t *tokens = ctx->tokenlist->tokens;
+    tokenid_t *ids = ctx->tokenlist->ids;
 
     func_addr_expr->id = EXPR_FUNC_ADDR;
-    func_addr_expr->source = ctx->tokenlist->sources[(*i)++];
+    func_addr_expr->source = tokenlist_source(ctx->tokenlist, (*i)++);
     func_addr_expr->traits = TRAIT_NONE;
     func_addr_expr->match_args = NULL;
     func_addr_expr->match_args_length = 0;
@@ -878,25 +878,25 @@ int parse_expr_func_address(parse_ctx_t *ctx, ast_expr_t **out_expr){
     func_addr_expr->has_match_args = false;
 
     // Optionally enable tentative function lookup: 'func null &functionName'
-    if(tokens[*i].id == TOKEN_NULL){
+    if(ids[*i] == TOKEN_NULL){
         func_addr_expr->tentative = true;
         (*i)++;
     }
 
     if(parse_eat(ctx, TOKEN_ADDRESS, "Expected '&' after 'func' keyword in expression")){
-        free(func_addr_expr);
+        ast_node_free(func_addr_expr);
         return FAILURE;
     }
 
     func_addr_expr->name = parse_eat_word(ctx, "Expected function name after 'func &' operator");
 
     if(func_addr_expr->name == NULL){
-        free(func_addr_expr);
+        ast_node_free(func_addr_expr);
         return FAILURE;
     }
 
 
-    if(tokens[*i].id == TOKEN_OPEN){
+    if(ids[*i] == TOKEN_OPEN){
         ast_type_t arg_type;
 
         ast_type_t *args = NULL;
@@ -905,28 +905,28 @@ int parse_expr_func_address(parse_ctx_t *ctx, ast_expr_t **out_expr){
         func_addr_expr->has_match_args = true;
         (*i)++;
 
-        while(*i != ctx->tokenlist->length && tokens[*i].id != TOKEN_CLOSE){
+        while(*i != ctx->tokenlist->length && ids[*i] != TOKEN_CLOSE){
             grow((void**) &args, sizeof(ast_type_t), arity + 1);
 
             if(parse_ignore_newlines(ctx, "Expected function argument") || parse_type(ctx, &arg_type)){
                 ast_types_free_fully(args, arity);
-                free(func_addr_expr);
+                ast_node_free(func_addr_expr);
                 return FAILURE;
             }
 
             args[arity++] = arg_type;
 
-            if(tokens[*i].id == TOKEN_NEXT){
-                if(tokens[++(*i)].id == TOKEN_CLOSE){
-                    compiler_panic(ctx->compiler, ctx->tokenlist->sources[*i], "Expected type after ',' in argument list");
+            if(ids[*i] == TOKEN_NEXT){
+                if(ids[++(*i)] == TOKEN_CLOSE){
+                    compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Expected type after ',' in argument list");
                     ast_types_free_fully(args, arity);
-                    free(func_addr_expr);
+                    ast_node_free(func_addr_expr);
                     return FAILURE;
                 }
-            } else if(tokens[*i].id != TOKEN_CLOSE){
-                compiler_panic(ctx->compiler, ctx->tokenlist->sources[*i], "Expected ',' after argument type");
+            } else if(ids[*i] != TOKEN_CLOSE){
+                compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Expected ',' after argument type");
                 ast_types_free_fully(args, arity);
-                free(func_addr_expr);
+                ast_node_free(func_addr_expr);
                 return FAILURE;
             }
         }
@@ -941,12 +941,12 @@ int parse_expr_func_address(parse_ctx_t *ctx, ast_expr_t **out_expr){
 }
 
 errorcode_t parse_expr_dereference(parse_ctx_t *ctx, ast_expr_t **out_expr){
-    ast_expr_unary_t *deref_expr = malloc(sizeof(ast_expr_unary_t));
+    ast_expr_unary_t *deref_expr = ast_node_alloc(sizeof(ast_expr_unary_t));
     deref_expr->id = EXPR_DEREFERENCE;
-    deref_expr->source = ctx->tokenlist->sources[(*ctx->i)++];
+    deref_expr->source = tokenlist_source(ctx->tokenlist, (*ctx->i)++);
     
     if(parse_primary_expr(ctx, &deref_expr->value) || parse_op_expr(ctx, 0, &deref_expr->value, true)){
-        free(deref_expr);
+        ast_node_free(deref_expr);
         return FAILURE;
     }
 
@@ -990,7 +990,7 @@ errorcode_t parse_expr_cast(parse_ctx_t *ctx, ast_expr_t **out_expr){
         return FAILURE;
     }
 
-    ast_expr_cast_t *cast_expr = malloc(sizeof(ast_expr_cast_t));
+    ast_expr_cast_t *cast_expr = ast_node_alloc(sizeof(ast_expr_cast_t));
     cast_expr->id = EXPR_CAST;
     cast_expr->source = source;
     cast_expr->to = to;
@@ -1023,7 +1023,7 @@ errorcode_t parse_expr_at(parse_ctx_t *ctx, ast_expr_t **inout_expr){
     ast_expr_t *index_expr;
     if(parse_primary_expr(ctx, &index_expr)) return FAILURE;
 
-    ast_expr_array_access_t *at_expr = malloc(sizeof(ast_expr_array_access_t));
+    ast_expr_array_access_t *at_expr = ast_node_alloc(sizeof(ast_expr_array_access_t));
     at_expr->id = EXPR_AT;
     at_expr->source = source;
     at_expr->value = *inout_expr;
@@ -1042,7 +1042,7 @@ errorcode_t parse_expr_sizeof(parse_ctx_t *ctx, ast_expr_t **out_expr){
         ast_expr_t *value;
         if(parse_primary_expr(ctx, &value)) return FAILURE;
 
-        ast_expr_sizeof_value_t *sizeof_value_expr = malloc(sizeof(ast_expr_sizeof_value_t));
+        ast_expr_sizeof_value_t *sizeof_value_expr = ast_node_alloc(sizeof(ast_expr_sizeof_value_t));
         sizeof_value_expr->id = EXPR_SIZEOF_VALUE;
         sizeof_value_expr->source = source;
         sizeof_value_expr->value = value;
@@ -1053,7 +1053,7 @@ errorcode_t parse_expr_sizeof(parse_ctx_t *ctx, ast_expr_t **out_expr){
         ast_type_t type;
         if(parse_type(ctx, &type)) return FAILURE;
 
-        ast_expr_sizeof_t *sizeof_expr = malloc(sizeof(ast_expr_sizeof_t));
+        ast_expr_sizeof_t *sizeof_expr = ast_node_alloc(sizeof(ast_expr_sizeof_t));
         sizeof_expr->id = EXPR_SIZEOF;
         sizeof_expr->source = source;
         sizeof_expr->type = type;
@@ -1072,7 +1072,7 @@ errorcode_t parse_expr_alignof(parse_ctx_t *ctx, ast_expr_t **out_expr){
     ast_type_t type;
     if(parse_type(ctx, &type)) return FAILURE;
 
-    ast_expr_alignof_t *alignof_expr = malloc(sizeof(ast_expr_alignof_t));
+    ast_expr_alignof_t *alignof_expr = ast_node_alloc(sizeof(ast_expr_alignof_t));
     alignof_expr->id = EXPR_ALIGNOF;
     alignof_expr->source = source;
     alignof_expr->type = type;
@@ -1087,7 +1087,7 @@ errorcode_t parse_expr_unary(parse_ctx_t *ctx, unsigned int expr_id, ast_expr_t
     ast_expr_t *value;
     if(parse_primary_expr(ctx, &value)) return FAILURE;
 
-    ast_expr_unary_t *unary_expr = malloc(sizeof(ast_expr_unary_t));
+    ast_expr_unary_t *unary_expr = ast_node_alloc(sizeof(ast_expr_unary_t));
     unary_expr->id = expr_id;
     unary_expr->source = source;
     unary_expr->value = value;
@@ -1099,7 +1099,7 @@ errorcode_t parse_expr_new(parse_ctx_t *ctx, ast_expr_t **out_expr){
     // NOTE: Assumes current token is 'new' keyword
 
     length_t *i = ctx->i;
-    source_t source = ctx->tokenlist->sources[*i];
+    source_t source = tokenlist_source(ctx->tokenlist, *i);
 
     // Skip over 'new' keyword
     *i += 1;
@@ -1110,7 +1110,7 @@ errorcode_t parse_expr_new(parse_ctx_t *ctx, ast_expr_t **out_expr){
 
         token_string_data_t *string_data = (token_string_data_t*) parse_ctx_peek_data(ctx);
 
-        *out_expr = (ast_expr_t*) malloc_init(ast_expr_new_cstring_t, {
+        *out_expr = (ast_expr_t*) ast_node_alloc_init(ast_expr_new_cstring_t, {
             .id = EXPR_NEW_CSTRING,
             .source = source,
             .array = string_data->array,
@@ -1121,16 +1121,14 @@ errorcode_t parse_expr_new(parse_ctx_t *ctx, ast_expr_t **out_expr){
         return SUCCESS;
     }
 
-    ast_expr_new_t *new_expr = malloc(sizeof(ast_expr_new_t));
-
-    *new_expr = (ast_expr_new_t){
+    ast_expr_new_t *new_expr = ast_node_alloc_init(ast_expr_new_t, {
         .id = EXPR_NEW,
         .type = (ast_type_t){0},
         .amount = NULL,
         .is_undef = false,
         .source = source,
         .inputs = (optional_ast_expr_list_t){0},
-    };
+    });
 
     if(parse_eat(ctx, TOKEN_UNDEF, NULL) == SUCCESS){
         new_expr->is_undef = true;
@@ -1168,14 +1166,13 @@ errorcode_t parse_expr_static(parse_ctx_t *ctx, ast_expr_t **out_expr){
     // NOTE: Assumes current token is 'static' keyword
 
     length_t *i = ctx->i;
-    token_t *tokens = ctx->tokenlist->tokens;
-    source_t *sources = ctx->tokenlist->sources;
+    tokenid_t *ids = ctx->tokenlist->ids;
 
-    ast_expr_static_data_t *static_array = malloc(sizeof(ast_expr_static_data_t));
-    static_array->source = sources[(*i)++];
+    ast_expr_static_data_t *static_array = ast_node_alloc(sizeof(ast_expr_static_data_t));
+    static_array->source = tokenlist_source(ctx->tokenlist, (*i)++);
 
     if(parse_type(ctx, &static_array->type)){
-        free(static_array);
+        ast_node_free(static_array);
         return FAILURE;
     }
 
@@ -1185,10 +1182,10 @@ errorcode_t parse_expr_static(parse_ctx_t *ctx, ast_expr_t **out_expr){
     length_t members_capacity = 0;
 
     tokenid_t finish_token;
-    tokenid_t static_kind = tokens[*i].id;
+    tokenid_t static_kind = ids[*i];
 
     if(static_kind != TOKEN_BEGIN && static_kind != TOKEN_OPEN){
-        compiler_panic(ctx->compiler, sources[*i], "Expected '(' or '{' after given type");
+        compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Expected '(' or '{' after given type");
         return FAILURE;
     }
 
@@ -1202,7 +1199,7 @@ errorcode_t parse_expr_static(parse_ctx_t *ctx, ast_expr_t **out_expr){
 
     (*i)++;
 
-    while(tokens[*i].id != finish_token){
+    while(ids[*i] != finish_token){
         if(parse_ignore_newlines(ctx, "Expected expression")){
             ast_exprs_free_fully(members, members_length);
             return FAILURE;
@@ -1222,10 +1219,10 @@ errorcode_t parse_expr_static(parse_ctx_t *ctx, ast_expr_t **out_expr){
             return FAILURE;
         }
 
-        if(tokens[*i].id == TOKEN_NEXT){
+        if(ids[*i] == TOKEN_NEXT){
             (*i)++;
-        } else if(tokens[*i].id != finish_token){
-            compiler_panic(ctx->compiler, sources[*i], finish_token == TOKEN_END ? "Expected ',' or '}' after expression" : "Expected ',' or ')' after expression");
+        } else if(ids[*i] != finish_token){
+            compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), finish_token == TOKEN_END ? "Expected ',' or '}' after expression" : "Expected ',' or ')' after expression");
             ast_exprs_free_fully(members, members_length);
             return FAILURE;
         }
@@ -1243,12 +1240,11 @@ errorcode_t parse_expr_def(parse_ctx_t *ctx, ast_expr_t **out_expr){
     // NOTE: Assume either 'def' or 'undef' keyword in expression
 
     length_t *i = ctx->i;
-    token_t *tokens = ctx->tokenlist->tokens;
-    source_t *sources = ctx->tokenlist->sources;
+    tokenid_t *ids = ctx->tokenlist->ids;
     trait_t traits = TRAIT_NONE;
 
-    unsigned int expr_id = (tokens[*i].id == TOKEN_UNDEF ? EXPR_ILDECLAREUNDEF : EXPR_ILDECLARE);
-    source_t source = sources[(*i)++];
+    unsigned int expr_id = (ids[*i] == TOKEN_UNDEF ? EXPR_ILDECLAREUNDEF : EXPR_ILDECLARE);
+    source_t source = tokenlist_source(ctx->tokenlist, (*i)++);
 
     maybe_null_weak_cstr_t name = parse_eat_word(ctx, "Expected variable name for inline declaration");
     if(name == NULL) return FAILURE;
@@ -1264,7 +1260,7 @@ errorcode_t parse_expr_def(parse_ctx_t *ctx, ast_expr_t **out_expr){
 
     if(parse_eat(ctx, TOKEN_ASSIGN, NULL) == SUCCESS){
         if(expr_id == EXPR_ILDECLAREUNDEF){
-            compiler_panic(ctx->compiler, sources[*i - 1], "Can't initialize undefined inline variable");
+            compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i - 1), "Can't initialize undefined inline variable");
             printf("\nDid you mean to use 'def' instead of 'undef'?\n");
             ast_type_free(&type);
             return FAILURE;
@@ -1285,12 +1281,12 @@ errorcode_t parse_expr_def(parse_ctx_t *ctx, ast_expr_t **out_expr){
 }
 
 errorcode_t parse_expr_typeinfo(parse_ctx_t *ctx, ast_expr_t **out_expr){
-    ast_expr_typeinfo_t *typeinfo = malloc(sizeof(ast_expr_typeinfo_t));
+    ast_expr_typeinfo_t *typeinfo = ast_node_alloc(sizeof(ast_expr_typeinfo_t));
     typeinfo->id = EXPR_TYPEINFO;
-    typeinfo->source = ctx->tokenlist->sources[(*ctx->i)++];
+    typeinfo->source = tokenlist_source(ctx->tokenlist, (*ctx->i)++);
 
     if(parse_type(ctx, &typeinfo->type)){
-        free(typeinfo);
+        ast_node_free(typeinfo);
         return FAILURE;
     }
 
@@ -1299,7 +1295,7 @@ errorcode_t parse_expr_typeinfo(parse_ctx_t *ctx, ast_expr_t **out_expr){
 }
 
 errorcode_t parse_expr_mutable_unary_prefix(parse_ctx_t *ctx, unsigned int unary_expr_id, const char *readable_operator, ast_expr_t **out_expr){
-    source_t source = ctx->tokenlist->sources[(*ctx->i)++];
+    source_t source = tokenlist_source(ctx->tokenlist, (*ctx->i)++);
 
     ast_expr_t *value;
 
@@ -1320,7 +1316,7 @@ errorcode_t parse_expr_initlist(parse_ctx_t *ctx, ast_expr_t **out_expr){
     // NOTE: Assumes first token is '{'
     
     ast_expr_list_t values = (ast_expr_list_t){0};
-    source_t source = ctx->tokenlist->sources[(*ctx->i)++];
+    source_t source = tokenlist_source(ctx->tokenlist, (*ctx->i)++);
 
     if(parse_ignore_newlines(ctx, "Expected '}' or ',' in initializer list before end of file")){
         goto failure;
@@ -7,6 +7,7 @@
 #include "AST/TYPE/ast_type_make.h"
 #include "AST/ast.h"
 #include "AST/ast_expr.h"
+#include "AST/ast_node_alloc.h"
 #include "AST/ast_type.h"
 #include "DRVR/compiler.h"
 #include "LEX/token.h"
@@ -19,6 +20,7 @@
 #include "PARSE/parse_util.h"
 #include "TOKEN/token_data.h"
 #include "UTIL/ground.h"
+#include "UTIL/intern.h"
 #include "UTIL/string.h"
 #include "UTIL/trait.h"
 #include "UTIL/util.h"
@@ -55,7 +57,7 @@ static errorcode_t add_dispatcher(parse_ctx_t *ctx, func_id_t virtual_origin){
     length_t arity = virtual->arity;
 
     ast_func_head_t func_head = (ast_func_head_t){
-        .name = strclone(virtual->name),
+        .name = virtual->name,
         .source = virtual->source,
         .is_foreign = false,
         .is_entry = false,
@@ -100,10 +102,10 @@ static errorcode_t add_dispatcher(parse_ctx_t *ctx, func_id_t virtual_origin){
 
 errorcode_t parse_func(parse_ctx_t *ctx){
     ast_t *ast = ctx->ast;
-    token_t *tokens = ctx->tokenlist->tokens;
+    tokenid_t *ids = ctx->tokenlist->ids;
     source_t source = parse_ctx_peek_source(ctx);
 
-    if(tokens[*ctx->i + 1].id == TOKEN_ALIAS && tokens[*ctx->i].id == TOKEN_FUNC){
+    if(ids[*ctx->i + 1] == TOKEN_ALIAS && ids[*ctx->i] == TOKEN_FUNC){
         // Parse function alias instead of regular function
         return parse_func_alias(ctx);
     }
@@ -139,10 +141,10 @@ errorcode_t parse_func(parse_ctx_t *ctx){
         func->traits |= AST_FUNC_NO_DISCARD;
     }
 
-    tokenid_t beginning_token_id = tokens[*ctx->i].id;
+    tokenid_t beginning_token_id = ids[*ctx->i];
 
     if(!func_head.is_foreign && (beginning_token_id == TOKEN_BEGIN || beginning_token_id == TOKEN_ASSIGN)){
-        func->return_type = ast_type_make_base(strclone("void"));
+        func->return_type = ast_type_make_base("void");
     } else {
         if(parse_type(ctx, &func->return_type)){
             func->return_type = (ast_type_t){0};
@@ -151,8 +153,8 @@ errorcode_t parse_func(parse_ctx_t *ctx){
     }
 
     // TODO: CLEANUP: This is a little ugly
-    if(ctx->tokenlist->tokens[*ctx->i].id == TOKEN_ASSIGN
-    && ctx->tokenlist->tokens[*ctx->i + 1].id == TOKEN_DELETE){
+    if(ctx->tokenlist->ids[*ctx->i] == TOKEN_ASSIGN
+    && ctx->tokenlist->ids[*ctx->i + 1] == TOKEN_DELETE){
         func->traits |= AST_FUNC_DISALLOW;
         *(ctx->i) += 2;
     }
@@ -220,7 +222,7 @@ void parse_func_solidify_constructor(compiler_t *compiler, ast_t *ast, ast_func_
     weak_cstr_t struct_name = ast_type_base_name(&this_pointee_type_view);
 
     ast_func_head_t func_head = (ast_func_head_t){
-        .name = strclone(struct_name),
+        .name = struct_name,
         .source = source,
         .is_foreign = false,
         .is_entry = false,
@@ -235,8 +237,11 @@ void parse_func_solidify_constructor(compiler_t *compiler, ast_t *ast, ast_func_
         .export_name = NULL
     };
 
+    // Creating the new function may move 'ast->funcs', so re-obtain the constructor afterwards
+    func_id_t constructor_id = (func_id_t) (constructor - ast->funcs);
     func_id_t ast_func_id = ast_new_func(ast);
     ast_func_t *func = &ast->funcs[ast_func_id];
+    constructor = &ast->funcs[constructor_id];
 
     ast_func_create_template(compiler, func, &func_head);
 
@@ -307,7 +312,7 @@ errorcode_t parse_func_head(parse_ctx_t *ctx, ast_func_head_t *out_head, ast_fun
     bool is_constructor = id == TOKEN_CONSTRUCTOR;
 
     if(id != TOKEN_FUNC && !is_constructor && !is_foreign){
-        compiler_panic(ctx->compiler, ctx->tokenlist->sources[*ctx->i - 1], "Expected 'func' or 'foreign' or 'constructor' keyword");
+        compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *ctx->i - 1), "Expected 'func' or 'foreign' or 'constructor' keyword");
         return FAILURE;
     }
 
@@ -347,7 +352,7 @@ errorcode_t parse_func_head(parse_ctx_t *ctx, ast_func_head_t *out_head, ast_fun
     bool is_entry = streq(ctx->compiler->entry_point, name);
 
     *out_head = (ast_func_head_t){
-        .name = name,
+        .name = intern_name(name),
         .source = source,
         .is_foreign = is_foreign,
         .is_entry = is_entry,
@@ -355,6 +360,8 @@ errorcode_t parse_func_head(parse_ctx_t *ctx, ast_func_head_t *out_head, ast_fun
         .export_name = export_name,
     };
 
+    free(name);
+
     *out_info = (ast_func_head_parse_info_t){
         .is_constructor = is_constructor,
         .is_in_only_constructor = is_in_only_constructor,
@@ -429,8 +436,7 @@ success:
 
 errorcode_t parse_func_arguments(parse_ctx_t *ctx, ast_func_t *func){
     length_t *i = ctx->i;
-    token_t *tokens = ctx->tokenlist->tokens;
-    source_t *sources = ctx->tokenlist->sources;
+    tokenid_t *ids = ctx->tokenlist->ids;
 
     bool is_solid;
     length_t backfill = 0;
@@ -459,7 +465,7 @@ errorcode_t parse_func_arguments(parse_ctx_t *ctx, ast_func_t *func){
             }
 
             ast_elem_t *pointer = ast_elem_pointer_make(NULL_SOURCE);
-            ast_elem_t *generic_base = ast_elem_generic_base_make(strclone(ctx->composite_association->name), NULL_SOURCE, generics, generics_length);
+            ast_elem_t *generic_base = ast_elem_generic_base_make(ctx->composite_association->name, NULL_SOURCE, generics, generics_length);
 
             ast_elem_t **elements = malloc(sizeof(ast_elem_t*) * 2);
             elements[0] = pointer;
@@ -472,7 +478,7 @@ errorcode_t parse_func_arguments(parse_ctx_t *ctx, ast_func_t *func){
             };
         } else {
             // Insert pointer type of 'this' as first argument to function
-            func->arg_types[0] = ast_type_make_base_ptr(strclone(ctx->composite_association->name));
+            func->arg_types[0] = ast_type_make_base_ptr(ctx->composite_association->name);
         }
 
         func->arg_names[0] = strclone("this");
@@ -489,7 +495,7 @@ errorcode_t parse_func_arguments(parse_ctx_t *ctx, ast_func_t *func){
     ctx->allow_polymorphic_prereqs = true;
 
     // Parse parameters
-    while(tokens[*i].id != TOKEN_CLOSE){
+    while(ids[*i] != TOKEN_CLOSE){
         if(parse_ignore_newlines(ctx, "Expected function argument")){
             parse_free_unbackfilled_arguments(func, backfill);
             ctx->allow_polymorphic_prereqs = false;
@@ -513,18 +519,18 @@ errorcode_t parse_func_arguments(parse_ctx_t *ctx, ast_func_t *func){
             return FAILURE;
         }
         
-        if(tokens[*i].id == TOKEN_NEXT && !takes_variable_arity){
-            if(tokens[++(*i)].id == TOKEN_CLOSE){
-                compiler_panic(ctx->compiler, sources[*i], "Expected type after ',' in argument list");
+        if(ids[*i] == TOKEN_NEXT && !takes_variable_arity){
+            if(ids[++(*i)] == TOKEN_CLOSE){
+                compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Expected type after ',' in argument list");
                 parse_free_unbackfilled_arguments(func, backfill);
                 ctx->allow_polymorphic_prereqs = false;
                 return FAILURE;
             }
-        } else if(tokens[*i].id != TOKEN_CLOSE){
+        } else if(ids[*i] != TOKEN_CLOSE){
             const char *error_message = takes_variable_arity
                     ? "Expected ')' after variadic argument"
                     : "Expected ',' after argument type";
-            compiler_panic(ctx->compiler, sources[*i], error_message);
+            compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), error_message);
             parse_free_unbackfilled_arguments(func, backfill);
             ctx->allow_polymorphic_prereqs = false;
             return FAILURE;
@@ -535,7 +541,7 @@ errorcode_t parse_func_arguments(parse_ctx_t *ctx, ast_func_t *func){
     ctx->allow_polymorphic_prereqs = false;
     
     if(backfill != 0){
-        compiler_panic(ctx->compiler, sources[*i], "Expected argument type before end of argument list");
+        compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Expected argument type before end of argument list");
         parse_free_unbackfilled_arguments(func, backfill);
         return FAILURE;
     }
@@ -549,17 +555,16 @@ errorcode_t parse_func_arguments(parse_ctx_t *ctx, ast_func_t *func){
 
 errorcode_t parse_func_argument(parse_ctx_t *ctx, ast_func_t *func, length_t capacity, length_t *backfill, bool *out_is_solid){
     length_t *i = ctx->i;
-    token_t *tokens = ctx->tokenlist->tokens;
-    source_t *sources = ctx->tokenlist->sources;
+    tokenid_t *ids = ctx->tokenlist->ids;
 
-    switch(tokens[*i].id){
+    switch(ids[*i]){
     case TOKEN_IN:    func->arg_flows[func->arity + *backfill] = FLOW_IN;    (*i)++; break;
     case TOKEN_OUT:   func->arg_flows[func->arity + *backfill] = FLOW_OUT;   (*i)++; break;
     case TOKEN_INOUT: func->arg_flows[func->arity + *backfill] = FLOW_INOUT; (*i)++; break;
     default:          func->arg_flows[func->arity + *backfill] = FLOW_IN;    break;
     }
 
-    func->arg_sources[func->arity + *backfill] = sources[*i];
+    func->arg_sources[func->arity + *backfill] = tokenlist_source(ctx->tokenlist, *i);
 
     if(func->arg_defaults)
         func->arg_defaults[func->arity + *backfill] = NULL;
@@ -568,7 +573,7 @@ errorcode_t parse_func_argument(parse_ctx_t *ctx, ast_func_t *func, length_t cap
         // Alone ellipsis, used for c-style varargs
 
         if(*backfill != 0){
-            compiler_panic(ctx->compiler, sources[*i - 1], "Expected type for previous arguments before ellipsis");
+            compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i - 1), "Expected type for previous arguments before ellipsis");
             parse_free_unbackfilled_arguments(func, *backfill);
             return FAILURE;
         }
@@ -587,14 +592,14 @@ errorcode_t parse_func_argument(parse_ctx_t *ctx, ast_func_t *func, length_t cap
         length_t lookahead = *i;
         bool is_argument_name = NULL;
 
-        if(tokens[lookahead].id == TOKEN_WORD){
+        if(ids[lookahead] == TOKEN_WORD){
             lookahead++;
 
-            while(tokens[lookahead].id == TOKEN_NEWLINE){
+            while(ids[lookahead] == TOKEN_NEWLINE){
                 lookahead++;
             }
 
-            if(tokens[lookahead].id != TOKEN_NEXT && tokens[lookahead].id != TOKEN_CLOSE){
+            if(ids[lookahead] != TOKEN_NEXT && ids[lookahead] != TOKEN_CLOSE){
                 is_argument_name = true;
             }
         }
@@ -632,16 +637,16 @@ errorcode_t parse_func_argument(parse_ctx_t *ctx, ast_func_t *func, length_t cap
         func->arg_names[func->arity + *backfill] = name;
     }
 
-    if(tokens[*i].id == TOKEN_ELLIPSIS){
+    if(ids[*i] == TOKEN_ELLIPSIS){
         // Ellipsis as type, used for modern variadic argument
 
         if(func->traits & AST_FUNC_FOREIGN){
-            compiler_panic(ctx->compiler, sources[*i - 1], "Foreign functions cannot have Adept-style named variadic arguments");
+            compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i - 1), "Foreign functions cannot have Adept-style named variadic arguments");
             goto failure;
         }
 
         if(*backfill != 0){
-            compiler_panic(ctx->compiler, sources[*i], "Expected type for previous arguments before ellipsis");
+            compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Expected type for previous arguments before ellipsis");
             goto failure;
         }
 
@@ -654,7 +659,7 @@ errorcode_t parse_func_argument(parse_ctx_t *ctx, ast_func_t *func, length_t cap
         func->arg_names[func->arity + *backfill] = NULL;
 
         // Assign variadic source
-        func->variadic_source = sources[*i - 2];
+        func->variadic_source = tokenlist_source(ctx->tokenlist, *i - 2);
         return SUCCESS;
     }
 
@@ -664,9 +669,9 @@ errorcode_t parse_func_argument(parse_ctx_t *ctx, ast_func_t *func, length_t cap
         goto failure;
     }
 
-    if(!(func->traits & AST_FUNC_FOREIGN) && tokens[*i].id == TOKEN_NEXT){
-        if(tokens[++(*i)].id == TOKEN_CLOSE){
-            compiler_panic(ctx->compiler, sources[*i], "Expected type after ',' in argument list");
+    if(!(func->traits & AST_FUNC_FOREIGN) && ids[*i] == TOKEN_NEXT){
+        if(ids[++(*i)] == TOKEN_CLOSE){
+            compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Expected type after ',' in argument list");
             goto failure;
         }
 
@@ -675,7 +680,7 @@ errorcode_t parse_func_argument(parse_ctx_t *ctx, ast_func_t *func, length_t cap
         return SUCCESS;
     }
 
-    if(tokens[*i].id == TOKEN_POD){
+    if(ids[*i] == TOKEN_POD){
         func->arg_type_traits[func->arity + *backfill] = AST_FUNC_ARG_TYPE_TRAIT_POD;
         (*i)++;
     } else {
@@ -816,7 +821,7 @@ errorcode_t parse_func_alias(parse_ctx_t *ctx){
     //  ^
 
     ast_t *ast = ctx->ast;
-    source_t source = ctx->tokenlist->sources[(*ctx->i)++];
+    source_t source = tokenlist_source(ctx->tokenlist, (*ctx->i)++);
 
     // Eat 'alias' keyword
     if(parse_eat(ctx, TOKEN_ALIAS, "Expected 'alias' keyword for function alias")) return FAILURE;
@@ -878,13 +883,13 @@ errorcode_t parse_func_alias_args(parse_ctx_t *ctx, ast_type_t **out_arg_types,
     //                   ^
 
     length_t *i = ctx->i;
-    token_t *tokens = ctx->tokenlist->tokens;
+    tokenid_t *ids = ctx->tokenlist->ids;
     length_t args_capacity = 0;
 
     *out_required_traits = TRAIT_NONE;
     *out_arity = 0;
     *out_arg_types = NULL;
-    *out_match_first_of_name = tokens[*i].id != TOKEN_OPEN;
+    *out_match_first_of_name = ids[*i] != TOKEN_OPEN;
 
     // Don't parse argument types if we're going to match the first of the same name
     if(*out_match_first_of_name) return SUCCESS;
@@ -892,16 +897,16 @@ errorcode_t parse_func_alias_args(parse_ctx_t *ctx, ast_type_t **out_arg_types,
     // Eat '('
     if(parse_eat(ctx, TOKEN_OPEN, "Expected '(' after function alias name")) return FAILURE;
 
-    while(tokens[*i].id != TOKEN_CLOSE){
+    while(ids[*i] != TOKEN_CLOSE){
         expand((void**) out_arg_types, sizeof(ast_type_t), *out_arity, &args_capacity, 1, 4);
 
         if(parse_ignore_newlines(ctx, "Expected argument type for function alias")) goto failure;
 
-        if(tokens[*i].id == TOKEN_ELLIPSIS){
+        if(ids[*i] == TOKEN_ELLIPSIS){
             // '...'
             *out_required_traits |= AST_FUNC_VARARG;
             (*i)++;
-        } else if(tokens[*i].id == TOKEN_RANGE){
+        } else if(ids[*i] == TOKEN_RANGE){
             // '..'
             *out_required_traits |= AST_FUNC_VARIADIC;
             (*i)++;
@@ -915,24 +920,24 @@ errorcode_t parse_func_alias_args(parse_ctx_t *ctx, ast_type_t **out_arg_types,
 
         if(parse_ignore_newlines(ctx, "Expected argument type for function alias")) goto failure;
 
-        if(tokens[*i].id == TOKEN_NEXT){
+        if(ids[*i] == TOKEN_NEXT){
             if(*out_required_traits & AST_FUNC_VARARG || *out_required_traits & AST_FUNC_VARIADIC){
-                compiler_panic(ctx->compiler, ctx->tokenlist->sources[*i], "Expected ')' after variadic argument");
+                compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Expected ')' after variadic argument");
                 goto failure;
             }
 
-            if(tokens[++(*i)].id == TOKEN_CLOSE){
-                compiler_panic(ctx->compiler, ctx->tokenlist->sources[*i], "Expected type after ',' in argument types");
+            if(ids[++(*i)] == TOKEN_CLOSE){
+                compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Expected type after ',' in argument types");
                 goto failure;
             }
-        } else if(tokens[*i].id != TOKEN_CLOSE){
+        } else if(ids[*i] != TOKEN_CLOSE){
             bool takes_variable_arity = *out_required_traits & AST_FUNC_VARIADIC || *out_required_traits & AST_FUNC_VARARG;
 
             const char *error_message = takes_variable_arity
                     ? "Expected ')' after variadic argument"
                     : "Expected ',' after argument type";
             
-            compiler_panic(ctx->compiler, ctx->tokenlist->sources[*i], error_message);
+            compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), error_message);
             goto failure;
         }
     }
@@ -976,13 +981,11 @@ void parse_collapse_polycount_var_fixed_arrays_for_type(ast_type_t *type){
                 ast_elem_free(type->elements[i]);
 
                 // Replace with unwrapped version
-                ast_elem_polycount_t *new_elem = (ast_elem_polycount_t*) malloc(sizeof(ast_elem_polycount_t));
-
-                *new_elem = (ast_elem_polycount_t){
+                ast_elem_polycount_t *new_elem = ast_node_alloc_init(ast_elem_polycount_t, {
                     .id =  AST_ELEM_POLYCOUNT,
                     .source = source,
                     .name = name,
-                };
+                });
 
                 type->elements[i] = (ast_elem_t*) new_elem;
             }
@@ -18,8 +18,8 @@
 
 errorcode_t parse_global(parse_ctx_t *ctx){
     length_t *i = ctx->i;
-    token_t *tokens = ctx->tokenlist->tokens;
-    source_t source = ctx->tokenlist->sources[*i];
+    tokenid_t *ids = ctx->tokenlist->ids;
+    source_t source = tokenlist_source(ctx->tokenlist, *i);
     ast_t *ast = ctx->ast;
     trait_t traits = TRAIT_NONE;
 
@@ -29,13 +29,13 @@ errorcode_t parse_global(parse_ctx_t *ctx){
     }
 
     while(true){
-        if(tokens[*i].id == TOKEN_EXTERNAL){
+        if(ids[*i] == TOKEN_EXTERNAL){
             traits |= AST_GLOBAL_EXTERNAL;
             (*i)++;
             continue;
         }
 
-        if(tokens[*i].id == TOKEN_THREAD_LOCAL){
+        if(ids[*i] == TOKEN_THREAD_LOCAL){
             traits |= AST_GLOBAL_THREAD_LOCAL;
             (*i)++;
             continue;
@@ -96,7 +96,7 @@ errorcode_t parse_named_expression_definition(parse_ctx_t *ctx, ast_named_expres
     //   ^
 
     // NOTE: Assumes first token is 'define' keyword
-    source_t source = ctx->tokenlist->sources[(*ctx->i)++];
+    source_t source = tokenlist_source(ctx->tokenlist, (*ctx->i)++);
 
     // Parse name for the named expression
     strong_cstr_t name;
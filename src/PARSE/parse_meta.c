@@ -222,9 +222,9 @@ static errorcode_t parse_meta_directive_conditional(parse_ctx_t *ctx, enum meta_
     length_t ends_needed = 1;
 
     while(++(*i) != tokenlist->length && ends_needed != 0){
-        if(tokenlist->tokens[*i].id != TOKEN_META) continue;
+        if(tokenlist->ids[*i] != TOKEN_META) continue;
 
-        char *pass_over_directive_name = (char*) tokenlist->tokens[*i].data;
+        char *pass_over_directive_name = (char*) tokenlist_data(tokenlist, *i);
         maybe_index_t pass_id = binary_string_search_const(standard_directives, sizeof(standard_directives) / sizeof(char*), pass_over_directive_name);
 
         if(pass_id == META_DIRECTIVE_IF || pass_id == META_DIRECTIVE_UNLESS){
@@ -248,7 +248,7 @@ static errorcode_t parse_meta_directive_conditional(parse_ctx_t *ctx, enum meta_
 
                 if(whether){   
                     if(ctx->meta_ends_expected++ == 256){
-                        compiler_panic(ctx->compiler, tokenlist->sources[*i], "Exceeded maximum meta conditional depth of 256");
+                        compiler_panic(ctx->compiler, tokenlist_source(tokenlist, *i), "Exceeded maximum meta conditional depth of 256");
                         return FAILURE;
                     }
                     parse_ctx_set_meta_else_allowed(ctx, ctx->meta_ends_expected, true);
@@ -258,14 +258,14 @@ static errorcode_t parse_meta_directive_conditional(parse_ctx_t *ctx, enum meta_
         } else if(pass_id == META_DIRECTIVE_ELSE){
             if(ends_needed == 1){
                 if(ctx->meta_ends_expected++ == 256){
-                    compiler_panic(ctx->compiler, tokenlist->sources[*i], "Exceeded maximum meta conditional depth of 256");
+                    compiler_panic(ctx->compiler, tokenlist_source(tokenlist, *i), "Exceeded maximum meta conditional depth of 256");
                     return FAILURE;
                 }
                 parse_ctx_set_meta_else_allowed(ctx, ctx->meta_ends_expected, false);
                 break;
             }
         } else if(pass_id == -1){
-            compiler_panicf(ctx->compiler, tokenlist->sources[*i], "Unrecognized meta directive #%s", pass_over_directive_name);
+            compiler_panicf(ctx->compiler, tokenlist_source(tokenlist, *i), "Unrecognized meta directive #%s", pass_over_directive_name);
             return FAILURE;
         }
     }
@@ -281,9 +281,12 @@ static errorcode_t parse_meta_directive_conditional(parse_ctx_t *ctx, enum meta_
 errorcode_t parse_meta(parse_ctx_t *ctx){
     assert(parse_ctx_peek(ctx) == TOKEN_META);
 
+    // Meta directives depend on and affect more than just the AST
+    parse_ctx_forbid_caching(ctx);
+
     length_t *i = ctx->i;
     tokenlist_t *tokenlist = ctx->tokenlist;
-    source_t source = tokenlist->sources[*i];
+    source_t source = tokenlist_source(tokenlist, *i);
 
     weak_cstr_t directive_name = (weak_cstr_t) parse_ctx_peek_data(ctx);
     maybe_index_t directive = binary_string_search_const(standard_directives, sizeof(standard_directives) / sizeof(char*), directive_name);
@@ -316,7 +319,7 @@ errorcode_t parse_meta(parse_ctx_t *ctx){
 
             if(parse_ctx_peek(ctx) == TOKEN_LESSTHAN){
                 // Do special stuff for #import <library>
-                if(parse_meta_import_stdlib(ctx, ctx->tokenlist->sources[old_i])) return FAILURE;
+                if(parse_meta_import_stdlib(ctx, tokenlist_source(ctx->tokenlist, old_i))) return FAILURE;
                 return SUCCESS;
             }
             
@@ -469,7 +472,7 @@ errorcode_t parse_meta(parse_ctx_t *ctx){
             (*i)++;
 
             meta_expr_t *value;
-            source_t source_on_error = ctx->tokenlist->sources[*i];
+            source_t source_on_error = tokenlist_source(ctx->tokenlist, *i);
 
             if(parse_meta_expr(ctx, &value)) return FAILURE;
             if(meta_collapse(ctx->compiler, ctx->object, ctx->ast->meta_definitions, ctx->ast->meta_definitions_length, &value)) return FAILURE;
@@ -520,11 +523,11 @@ errorcode_t parse_meta(parse_ctx_t *ctx){
 
             meta_expr_t *value = NULL;
 
-            if(tokenlist->tokens[++(*i)].id == TOKEN_NEWLINE){
+            if(tokenlist->ids[++(*i)] == TOKEN_NEWLINE){
                 if(directive == META_DIRECTIVE_DEFINE){
-                    compiler_panicf(ctx->compiler, tokenlist->sources[*i], "Expected initial value for meta variable definition");
+                    compiler_panicf(ctx->compiler, tokenlist_source(tokenlist, *i), "Expected initial value for meta variable definition");
                 } else {
-                    compiler_panicf(ctx->compiler, tokenlist->sources[*i], "Expected new value for meta variable");
+                    compiler_panicf(ctx->compiler, tokenlist_source(tokenlist, *i), "Expected new value for meta variable");
                 }
 
                 printf("Did you mean to use:\n    #%s %s true\n", directive_name, definition_name);
@@ -612,10 +615,9 @@ errorcode_t parse_meta_expr(parse_ctx_t *ctx, meta_expr_t **out_expr){
 
 errorcode_t parse_meta_primary_expr(parse_ctx_t *ctx, meta_expr_t **out_expr){
     length_t *i = ctx->i;
-    token_t *tokens = ctx->tokenlist->tokens;
-    source_t *sources = ctx->tokenlist->sources;
+    tokenid_t *ids = ctx->tokenlist->ids;
 
-    switch (tokens[*i].id){
+    switch (ids[*i]){
     case TOKEN_TRUE:
         *out_expr = malloc(sizeof(meta_expr_t));
         (*out_expr)->id = META_EXPR_TRUE;
@@ -632,7 +634,7 @@ errorcode_t parse_meta_primary_expr(parse_ctx_t *ctx, meta_expr_t **out_expr){
         (*i)++;
         break;
     case TOKEN_CSTRING: case TOKEN_STRING: {
-            token_string_data_t *token_data = tokens[*i].data;
+            token_string_data_t *token_data = tokenlist_data(ctx->tokenlist, *i);
             meta_expr_str_t *str_expr = malloc(sizeof(meta_expr_str_t));
             str_expr->id = META_EXPR_STR;
             str_expr->value = malloc(token_data->length + 1);
@@ -645,20 +647,20 @@ errorcode_t parse_meta_primary_expr(parse_ctx_t *ctx, meta_expr_t **out_expr){
     case TOKEN_WORD:
         *out_expr = malloc(sizeof(meta_expr_var_t));
         (*out_expr)->id = META_EXPR_VAR;
-        ((meta_expr_var_t*) *out_expr)->name = strclone(tokens[*i].data);
-        ((meta_expr_var_t*) *out_expr)->source = sources[*i];
+        ((meta_expr_var_t*) *out_expr)->name = strclone(tokenlist_data(ctx->tokenlist, *i));
+        ((meta_expr_var_t*) *out_expr)->source = tokenlist_source(ctx->tokenlist, *i);
         (*i)++;
         break;
     case TOKEN_GENERIC_INT:
         *out_expr = malloc(sizeof(meta_expr_int_t));
         (*out_expr)->id = META_EXPR_INT;
-        ((meta_expr_int_t*) *out_expr)->value = *((adept_generic_int*) tokens[*i].data);
+        ((meta_expr_int_t*) *out_expr)->value = *((adept_generic_int*) tokenlist_data(ctx->tokenlist, *i));
         (*i)++;
         break;
     case TOKEN_GENERIC_FLOAT:
         *out_expr = malloc(sizeof(meta_expr_float_t));
         (*out_expr)->id = META_EXPR_FLOAT;
-        ((meta_expr_float_t*) *out_expr)->value = *((double*) tokens[*i].data);
+        ((meta_expr_float_t*) *out_expr)->value = *((double*) tokenlist_data(ctx->tokenlist, *i));
         (*i)++;
         break;
     case TOKEN_OPEN:
@@ -676,7 +678,7 @@ errorcode_t parse_meta_primary_expr(parse_ctx_t *ctx, meta_expr_t **out_expr){
         }
         break;
     default:
-        parse_panic_token(ctx, sources[*i], tokens[*i].id, "Unexpected token '%s' in meta expression");
+        parse_panic_token(ctx, tokenlist_source(ctx->tokenlist, *i), ids[*i], "Unexpected token '%s' in meta expression");
         return FAILURE;
     }
 
@@ -685,12 +687,11 @@ errorcode_t parse_meta_primary_expr(parse_ctx_t *ctx, meta_expr_t **out_expr){
 
 errorcode_t parse_meta_op_expr(parse_ctx_t *ctx, int precedence, meta_expr_t **inout_left){
     length_t *i = ctx->i;
-    token_t *tokens = ctx->tokenlist->tokens;
-    source_t *sources = ctx->tokenlist->sources;
+    tokenid_t *ids = ctx->tokenlist->ids;
     meta_expr_t *right, *expr;
 
     while(*i != ctx->tokenlist->length) {
-        int operator = tokens[*i].id;
+        int operator = ids[*i];
         int operator_precedence;
 
         switch(operator){
@@ -715,14 +716,14 @@ errorcode_t parse_meta_op_expr(parse_ctx_t *ctx, int precedence, meta_expr_t **i
             operator_precedence =  6;
             break;
         case TOKEN_MULTIPLY:
-            operator_precedence = (*i + 1 != ctx->tokenlist->length && tokens[*i + 1].id == TOKEN_MULTIPLY) ? 7 : 6;
+            operator_precedence = (*i + 1 != ctx->tokenlist->length && ids[*i + 1] == TOKEN_MULTIPLY) ? 7 : 6;
             break;
         default:
             operator_precedence =  0;
         }
 
         if(operator_precedence < precedence) return SUCCESS;
-        //source_t source = sources[*i];
+        //source_t source = tokenlist_source(ctx->tokenlist, *i);
 
         if(operator == TOKEN_NEWLINE || operator == TOKEN_CLOSE || operator == TOKEN_NEXT
             || operator == TOKEN_BEGIN || operator == TOKEN_BRACKET_CLOSE) return SUCCESS;
@@ -740,7 +741,7 @@ errorcode_t parse_meta_op_expr(parse_ctx_t *ctx, int precedence, meta_expr_t **i
         case TOKEN_ADD:            BUILD_MATH_META_EXPR_MACRO(META_EXPR_ADD);        break;
         case TOKEN_SUBTRACT:       BUILD_MATH_META_EXPR_MACRO(META_EXPR_SUB);        break;
         case TOKEN_MULTIPLY:
-            if(*i + 1 != ctx->tokenlist->length && tokens[*i + 1].id == TOKEN_MULTIPLY){    
+            if(*i + 1 != ctx->tokenlist->length && ids[*i + 1] == TOKEN_MULTIPLY){    
                 (*i)++;
                 BUILD_MATH_META_EXPR_MACRO(META_EXPR_POW);
                 break;
@@ -761,7 +762,7 @@ errorcode_t parse_meta_op_expr(parse_ctx_t *ctx, int precedence, meta_expr_t **i
         case TOKEN_LESSTHANEQ:     BUILD_MATH_META_EXPR_MACRO(META_EXPR_LTE);        break;
         case TOKEN_GREATERTHANEQ:  BUILD_MATH_META_EXPR_MACRO(META_EXPR_GTE);        break;
         default:
-            parse_panic_token(ctx, sources[*i], tokens[*i].id, "Unrecognized operator '%s' in meta expression");
+            parse_panic_token(ctx, tokenlist_source(ctx->tokenlist, *i), ids[*i], "Unrecognized operator '%s' in meta expression");
             meta_expr_free_fully(*inout_left);
             return FAILURE;
         }
@@ -781,13 +782,13 @@ errorcode_t meta_parse_rhs_expr(parse_ctx_t *ctx, meta_expr_t **left, meta_expr_
     // Expects 'i' to point to the operator token
 
     length_t *i = ctx->i;
-    token_t *tokens = ctx->tokenlist->tokens;
+    tokenid_t *ids = ctx->tokenlist->ids;
 
     (*i)++; // Skip over operator token
 
     if(parse_ignore_newlines(ctx, "Unexpected meta expression termination")) return FAILURE;
 
-    if(parse_meta_primary_expr(ctx, out_right) || (op_prec < parse_get_precedence(tokens[*i].id) && parse_meta_op_expr(ctx, op_prec + 1, out_right))){
+    if(parse_meta_primary_expr(ctx, out_right) || (op_prec < parse_get_precedence(ids[*i]) && parse_meta_op_expr(ctx, op_prec + 1, out_right))){
         meta_expr_free_fully(*left);
         return FAILURE;
     }
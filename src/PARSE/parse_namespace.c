@@ -16,16 +16,16 @@ errorcode_t parse_namespace(parse_ctx_t *ctx){
     // namespace my_namespace
     //     ^
 
-    token_t *tokens = ctx->tokenlist->tokens;
+    tokenid_t *ids = ctx->tokenlist->ids;
     length_t *i = ctx->i;
 
     if(ctx->composite_association != NULL){
-        compiler_panicf(ctx->compiler, ctx->tokenlist->sources[*i], "Cannot change namespaces within struct domain");
+        compiler_panicf(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Cannot change namespaces within struct domain");
         return FAILURE;
     }
 
     if(ctx->has_namespace_scope){
-        compiler_panicf(ctx->compiler, ctx->tokenlist->sources[*i], "Cannot change namespaces while already inside scoped namespace");
+        compiler_panicf(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Cannot change namespaces while already inside scoped namespace");
         return FAILURE;
     }
 
@@ -33,7 +33,7 @@ errorcode_t parse_namespace(parse_ctx_t *ctx){
 
     bool has_prename = ctx->compiler->traits & COMPILER_COLON_COLON && ctx->prename;
 
-    if(tokens[*i].id == TOKEN_NEWLINE && !has_prename){
+    if(ids[*i] == TOKEN_NEWLINE && !has_prename){
         free(ctx->object->current_namespace);
 
         // Reset namespace to no namespace
@@ -4,6 +4,7 @@
 #include <stdlib.h>
 
 #include "AST/ast.h"
+#include "DRVR/ast_cache.h"
 #include "DRVR/compiler.h"
 #include "DRVR/object.h"
 #include "LEX/token.h"
@@ -24,9 +25,12 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
     //   ^
 
     length_t *i = ctx->i;
-    token_t *tokens = ctx->tokenlist->tokens;
+    tokenid_t *ids = ctx->tokenlist->ids;
     maybe_null_weak_cstr_t read = NULL;
 
+    // Pragma directives affect the compiler instead of the AST
+    parse_ctx_forbid_caching(ctx);
+
     if(ctx->composite_association != NULL){
         compiler_panicf(ctx->compiler, parse_ctx_peek_source(ctx), "Cannot pass pragma directives within struct domain");
         return FAILURE;
@@ -34,7 +38,7 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
 
     // NOTE: Must be presorted alphabetically and match with indicies below
     const char * const directives[] = {
-        "__builtin_warn_bad_printf_format", "compiler_supports", "compiler_version", "default_stdlib", "deprecated", "disable_warnings", "dylib",
+        "__builtin_warn_bad_printf_format", "ast_cache", "compiler_supports", "compiler_version", "default_stdlib", "deprecated", "disable_warnings", "dylib",
         "enable_warnings", "entry_point", "help", "ignore_all", "ignore_deprecation", "ignore_early_return", "ignore_obsolete",
         "ignore_partial_support", "ignore_unrecognized_directives", "ignore_unused", "libm", "linux_only", "mac_only", "mwindows",
         "no_type_info", "no_typeinfo", "no_undef", "null_checks", "optimization", "options", "package", "project_name", "search_path",
@@ -47,44 +51,45 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
     if(directive_string == NULL) return FAILURE;
 
     #define PRAGMA___BUILTIN_WARN_BAD_PRINTF_FORMAT 0x00000000
-    #define PRAGMA_COMPILER_SUPPORTS                0x00000001
-    #define PRAGMA_COMPILER_VERSION                 0x00000002
-    #define PRAGMA_DEFAULT_STDLIB                   0x00000003
-    #define PRAGMA_DEPRECATED                       0x00000004
-    #define PRAGMA_DISABLE_WARNINGS                 0x00000005
-    #define PRAGMA_DYLIB                            0x00000006
-    #define PRAGMA_ENABLE_WARNINGS                  0x00000007
-    #define PRAGMA_ENTRY_POINT                      0x00000008
-    #define PRAGMA_HELP                             0x00000009
-    #define PRAGMA_IGNORE_ALL                       0x0000000A
-    #define PRAGMA_IGNORE_DEPRECATION               0x0000000B
-    #define PRAGMA_IGNORE_EARLY_RETURN              0x0000000C
-    #define PRAGMA_IGNORE_OBSOLETE                  0x0000000D
-    #define PRAGMA_IGNORE_PARTIAL_SUPPORT           0x0000000E
-    #define PRAGMA_IGNORE_UNRECOGNIZED_DIRECTIVES   0x0000000F
-    #define PRAGMA_IGNORE_UNUSED                    0x00000010
-    #define PRAGMA_LIBM                             0x00000011
-    #define PRAGMA_LINUX_ONLY                       0x00000012
-    #define PRAGMA_MAC_ONLY                         0x00000013
-    #define PRAGMA_MWINDOWS                         0x00000014
-    #define PRAGMA_NO_TYPE_INFO                     0x00000015
-    #define PRAGMA_NO_TYPEINFO                      0x00000016
-    #define PRAGMA_NO_UNDEF                         0x00000017
-    #define PRAGMA_NULL_CHECKS                      0x00000018
-    #define PRAGMA_OPTIMIZATION                     0x00000019
-    #define PRAGMA_OPTIONS                          0x0000001A
-    #define PRAGMA_PACKAGE                          0x0000001B
-    #define PRAGMA_PROJECT_NAME                     0x0000001C
-    #define PRAGMA_SEARCH_PATH                      0x0000001D
-    #define PRAGMA_SHORT_WARNINGS                   0x0000001E
-    #define PRAGMA_UNSAFE_META                      0x0000001F
-    #define PRAGMA_UNSAFE_NEW                       0x00000020
-    #define PRAGMA_UNSUPPORTED                      0x00000021
-    #define PRAGMA_WARN_AS_ERROR                    0x00000022
-    #define PRAGMA_WARN_SHORT                       0x00000023
-    #define PRAGMA_WINDOWED                         0x00000024
-    #define PRAGMA_WINDOWS_ONLY                     0x00000025
-    #define PRAGMA_WINDRES                          0x00000026
+    #define PRAGMA_AST_CACHE                        0x00000001
+    #define PRAGMA_COMPILER_SUPPORTS                0x00000002
+    #define PRAGMA_COMPILER_VERSION                 0x00000003
+    #define PRAGMA_DEFAULT_STDLIB                   0x00000004
+    #define PRAGMA_DEPRECATED                       0x00000005
+    #define PRAGMA_DISABLE_WARNINGS                 0x00000006
+    #define PRAGMA_DYLIB                            0x00000007
+    #define PRAGMA_ENABLE_WARNINGS                  0x00000008
+    #define PRAGMA_ENTRY_POINT                      0x00000009
+    #define PRAGMA_HELP                             0x0000000A
+    #define PRAGMA_IGNORE_ALL                       0x0000000B
+    #define PRAGMA_IGNORE_DEPRECATION               0x0000000C
+    #define PRAGMA_IGNORE_EARLY_RETURN              0x0000000D
+    #define PRAGMA_IGNORE_OBSOLETE                  0x0000000E
+    #define PRAGMA_IGNORE_PARTIAL_SUPPORT           0x0000000F
+    #define PRAGMA_IGNORE_UNRECOGNIZED_DIRECTIVES   0x00000010
+    #define PRAGMA_IGNORE_UNUSED                    0x00000011
+    #define PRAGMA_LIBM                             0x00000012
+    #define PRAGMA_LINUX_ONLY                       0x00000013
+    #define PRAGMA_MAC_ONLY                         0x00000014
+    #define PRAGMA_MWINDOWS                         0x00000015
+    #define PRAGMA_NO_TYPE_INFO                     0x00000016
+    #define PRAGMA_NO_TYPEINFO                      0x00000017
+    #define PRAGMA_NO_UNDEF                         0x00000018
+    #define PRAGMA_NULL_CHECKS                      0x00000019
+    #define PRAGMA_OPTIMIZATION                     0x0000001A
+    #define PRAGMA_OPTIONS                          0x0000001B
+    #define PRAGMA_PACKAGE                          0x0000001C
+    #define PRAGMA_PROJECT_NAME                     0x0000001D
+    #define PRAGMA_SEARCH_PATH                      0x0000001E
+    #define PRAGMA_SHORT_WARNINGS                   0x0000001F
+    #define PRAGMA_UNSAFE_META                      0x00000020
+    #define PRAGMA_UNSAFE_NEW                       0x00000021
+    #define PRAGMA_UNSUPPORTED                      0x00000022
+    #define PRAGMA_WARN_AS_ERROR                    0x00000023
+    #define PRAGMA_WARN_SHORT                       0x00000024
+    #define PRAGMA_WINDOWED                         0x00000025
+    #define PRAGMA_WINDOWS_ONLY                     0x00000026
+    #define PRAGMA_WINDRES                          0x00000027
 
     maybe_index_t directive = binary_string_search_const(directives, directives_length, directive_string);
 
@@ -92,6 +97,11 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
     case PRAGMA___BUILTIN_WARN_BAD_PRINTF_FORMAT: // '__builtin_warn_bad_printf_format' directive
         ctx->next_builtin_traits |= AST_FUNC_WARN_BAD_PRINTF_FORMAT;
         return SUCCESS;
+    case PRAGMA_AST_CACHE: // 'ast_cache' directive
+        if(ctx->compiler->ast_cache_directory == NULL){
+            ctx->compiler->ast_cache_directory = ast_cache_default_directory(ctx->compiler);
+        }
+        return SUCCESS;
     case PRAGMA_COMPILER_SUPPORTS: // 'compiler_supports' directive
     case PRAGMA_COMPILER_VERSION: // 'compiler_version' directive
         read = parse_grab_string(ctx, directive == 0
@@ -106,7 +116,7 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
         // Check to make sure we support the target version
         if(streq(read, "2.0") || streq(read, "2.1")){
             if(!(ctx->compiler->ignore & COMPILER_IGNORE_PARTIAL_SUPPORT)){
-                if(compiler_warnf(ctx->compiler, ctx->tokenlist->sources[*i], "This compiler only partially supports version '%s'", read))
+                if(compiler_warnf(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "This compiler only partially supports version '%s'", read))
                     return FAILURE;
             }
         } else if(!streq(read, "2.2") 
@@ -116,7 +126,7 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
                && !streq(read, "2.6")
                && !streq(read, "2.7")
                && !streq(read, "2.8")){
-            compiler_panicf(ctx->compiler, ctx->tokenlist->sources[*i], "This compiler doesn't support version '%s'", read);
+            compiler_panicf(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "This compiler doesn't support version '%s'", read);
             puts("\nSupported Versions: '2.8', '2.7', '2.6', '2.5', '2.4', '2.3', '2.2', '2.1', '2.0'");
             return FAILURE;
         }
@@ -131,7 +141,7 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
         read = parse_grab_string(ctx, NULL);
 
         if(read == NULL){
-            compiler_panicf(ctx->compiler, ctx->tokenlist->sources[*i], "Expected version string after 'pragma default_stdlib', such as '%s'", ADEPT_VERSION_STRING);
+            compiler_panicf(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Expected version string after 'pragma default_stdlib', such as '%s'", ADEPT_VERSION_STRING);
             return FAILURE;
         }
         
@@ -149,8 +159,8 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
         read = parse_grab_string(ctx, NULL);
 
         if(read == NULL){
-            if(tokens[*i].id != TOKEN_NEWLINE){
-                compiler_panic(ctx->compiler, ctx->tokenlist->sources[*i - 1], "Expected message after 'pragma deprecated'");
+            if(ids[*i] != TOKEN_NEWLINE){
+                compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i - 1), "Expected message after 'pragma deprecated'");
                 return FAILURE;
             } else (*i)--;
         }
@@ -159,9 +169,9 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
             bool should_exit = false;
 
             if(read != NULL){
-                should_exit = compiler_warnf(ctx->compiler, ctx->tokenlist->sources[*i - 1], "This file is deprecated and may be removed in the future\n %s %s", BOX_DRAWING_UP_RIGHT, read);
+                should_exit = compiler_warnf(ctx->compiler, tokenlist_source(ctx->tokenlist, *i - 1), "This file is deprecated and may be removed in the future\n %s %s", BOX_DRAWING_UP_RIGHT, read);
             } else {
-                should_exit = compiler_warn(ctx->compiler, ctx->tokenlist->sources[*i], "This file is deprecated and may be removed in the future");
+                should_exit = compiler_warn(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "This file is deprecated and may be removed in the future");
             }
 
             if(should_exit) return FAILURE;
@@ -173,21 +183,21 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
     case PRAGMA_DYLIB: { // 'dylib' directive
             // Don't allow changing the binary type after functions are declared
             if(ctx->object->ast.funcs_length != 0){
-                compiler_panicf(ctx->compiler, ctx->tokenlist->sources[*i - 1], "Cannot change output type to dynamic library after functions are already defined");
+                compiler_panicf(ctx->compiler, tokenlist_source(ctx->tokenlist, *i - 1), "Cannot change output type to dynamic library after functions are already defined");
                 return FAILURE;
             }
 
             maybe_null_weak_cstr_t init_point = parse_grab_word(ctx, NULL);
 
             if(init_point == NULL){
-                compiler_panic(ctx->compiler, ctx->tokenlist->sources[*i - 1], "Expected dynamic library init function name after 'pragma dylib'");
+                compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i - 1), "Expected dynamic library init function name after 'pragma dylib'");
                 return FAILURE;
             }
 
             maybe_null_weak_cstr_t deinit_point = parse_grab_word(ctx, NULL);
 
             if(deinit_point == NULL){
-                compiler_panic(ctx->compiler, ctx->tokenlist->sources[*i - 1], "Expected dynamic library deinit function name after init function name for 'pragma dylib'");
+                compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i - 1), "Expected dynamic library deinit function name after init function name for 'pragma dylib'");
                 return FAILURE;
             }
 
@@ -212,19 +222,19 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
         
         // Make sure we got the name of the new entry point
         if(read == NULL){
-            compiler_panicf(ctx->compiler, ctx->tokenlist->sources[*i - 1], "Expected entry point name after 'pragma entry_point'");
+            compiler_panicf(ctx->compiler, tokenlist_source(ctx->tokenlist, *i - 1), "Expected entry point name after 'pragma entry_point'");
             return FAILURE;
         }
 
         // Don't allow changing the name of the entry point if functions are already defined
         if(ctx->object->ast.funcs_length != 0){
-            compiler_panicf(ctx->compiler, ctx->tokenlist->sources[*i - 1], "Cannot set entry point after functions are already defined");
+            compiler_panicf(ctx->compiler, tokenlist_source(ctx->tokenlist, *i - 1), "Cannot set entry point after functions are already defined");
             return FAILURE;
         }
 
         // Don't allow changing the name of the entry point if it was already changed to something that wasn't main
         if(!streq(ctx->compiler->entry_point, "main")){
-            compiler_panicf(ctx->compiler, ctx->tokenlist->sources[*i - 1], "Entry point is already defined as '%s'", ctx->compiler->entry_point);
+            compiler_panicf(ctx->compiler, tokenlist_source(ctx->tokenlist, *i - 1), "Entry point is already defined as '%s'", ctx->compiler->entry_point);
             return FAILURE;
         }
 
@@ -261,12 +271,12 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
     case PRAGMA_MAC_ONLY: // 'mac_only' directive
         #if defined(__APPLE__) && TARGET_OS_MAC
         if(ctx->compiler->cross_compile_for != CROSS_COMPILE_NONE){
-            if(compiler_weak_panicf(ctx->compiler, ctx->tokenlist->sources[*i], "This file only works on Mac"))
+            if(compiler_weak_panicf(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "This file only works on Mac"))
                 return FAILURE;
         }
         #else
         if(ctx->compiler->cross_compile_for != CROSS_COMPILE_MACOS){
-            if(compiler_weak_panicf(ctx->compiler, ctx->tokenlist->sources[*i], "This file only works on Mac"))
+            if(compiler_weak_panicf(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "This file only works on Mac"))
                 return FAILURE;
         }
         #endif
@@ -274,17 +284,17 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
     case PRAGMA_LINUX_ONLY: // 'linux_only' directive
         #ifdef __linux__
         if(ctx->compiler->cross_compile_for != CROSS_COMPILE_NONE){
-            if(compiler_weak_panicf(ctx->compiler, ctx->tokenlist->sources[*i], "This file only works on Linux"))
+            if(compiler_weak_panicf(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "This file only works on Linux"))
                 return FAILURE;
         }
         #else
-        if(compiler_weak_panicf(ctx->compiler, ctx->tokenlist->sources[*i], "This file only works on Linux"))
+        if(compiler_weak_panicf(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "This file only works on Linux"))
             return FAILURE;
         #endif
         return SUCCESS;
     case PRAGMA_NO_TYPE_INFO: // 'no_type_info' directive
         if(!(ctx->compiler->ignore & COMPILER_IGNORE_OBSOLETE)){
-            if(compiler_warn(ctx->compiler, ctx->tokenlist->sources[*i], "WARNING: 'pragma no_type_info' is obsolete, use 'pragma no_typeinfo' instead"))
+            if(compiler_warn(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "WARNING: 'pragma no_type_info' is obsolete, use 'pragma no_typeinfo' instead"))
                 return FAILURE;
         }
         // fallthrough
@@ -313,7 +323,7 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
         else if(streq(read, "nothing"))    ctx->compiler->optimization = OPTIMIZATION_ABSOLUTELY_NOTHING;
         else {
             // Invalid optimization level
-            compiler_panic(ctx->compiler, ctx->tokenlist->sources[*i], "Invalid optimization level after 'pragma optimization'");
+            compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Invalid optimization level after 'pragma optimization'");
             printf("Possible levels are: none, less, normal or aggressive\n");
             return FAILURE;
         }
@@ -321,11 +331,9 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
     case PRAGMA_OPTIONS: // 'options' directive
         return parse_pragma_cloptions(ctx);
     case PRAGMA_PACKAGE: // 'package' directive
-        if(ctx->compiler->traits & COMPILER_INFLATE_PACKAGE) return SUCCESS;
-        if(compiler_create_package(ctx->compiler, ctx->object) == 0){
-            ctx->compiler->result_flags |= COMPILER_RESULT_SUCCESS;
-        }
-        return FAILURE;
+        // The package is created once parsing has finished
+        if(!(ctx->compiler->traits & COMPILER_INFLATE_PACKAGE)) ctx->compiler->traits |= COMPILER_MAKE_PACKAGE;
+        return SUCCESS;
     case PRAGMA_PROJECT_NAME: // 'project_name' directive
         read = parse_grab_string(ctx, "Expected string containing project name after 'pragma project_name'");
         if(read == NULL) return FAILURE;
@@ -349,8 +357,8 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
         read = parse_grab_string(ctx, NULL);
 
         if(read == NULL){
-            if(tokens[*i].id != TOKEN_NEWLINE){
-                compiler_panic(ctx->compiler, ctx->tokenlist->sources[*i - 1], "Expected message after 'pragma unsupported'");
+            if(ids[*i] != TOKEN_NEWLINE){
+                compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i - 1), "Expected message after 'pragma unsupported'");
                 return FAILURE;
             } else (*i)--;
         }
@@ -359,7 +367,7 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
             object_panic_plain(ctx->object, "This file is no longer supported or was never supported to begin with!");
             redprintf(" %s %s\n", BOX_DRAWING_UP_RIGHT, read);
         } else {
-            compiler_panic(ctx->compiler, ctx->tokenlist->sources[*i], "This file is no longer supported or never was unsupported");
+            compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "This file is no longer supported or never was unsupported");
         }
         return FAILURE;
     case PRAGMA_WARN_AS_ERROR: // 'warn_as_error' directive
@@ -376,12 +384,12 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
     case PRAGMA_WINDOWS_ONLY: // 'windows_only' directive
         #ifdef _WIN32
         if(ctx->compiler->cross_compile_for != CROSS_COMPILE_NONE){
-            if(compiler_weak_panicf(ctx->compiler, ctx->tokenlist->sources[*i], "This file only works on Windows"))
+            if(compiler_weak_panicf(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "This file only works on Windows"))
                 return FAILURE;
         }
         #else
         if(ctx->compiler->cross_compile_for != CROSS_COMPILE_WINDOWS){
-            if(compiler_weak_panicf(ctx->compiler, ctx->tokenlist->sources[*i], "This file only works on Windows"))
+            if(compiler_weak_panicf(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "This file only works on Windows"))
                 return FAILURE;
         }
         #endif
@@ -395,10 +403,10 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
     default:
         if(ctx->compiler->ignore & COMPILER_IGNORE_UNRECOGNIZED_DIRECTIVES){
             // Skip over the rest of the line
-            while(tokens[*i].id != TOKEN_NEWLINE) (*i)++;
+            while(ids[*i] != TOKEN_NEWLINE) (*i)++;
             (*i)--;
         } else {
-            compiler_panicf(ctx->compiler, ctx->tokenlist->sources[*i], "Unrecognized pragma option '%s'", directive_string);
+            compiler_panicf(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Unrecognized pragma option '%s'", directive_string);
             return FAILURE;
         }
     }
@@ -427,12 +435,5 @@ errorcode_t parse_pragma_cloptions(parse_ctx_t *ctx){
     for(int a = 1; a != options_argc; a++) free(options_argv[a]);
     free(options_argv);
 
-    // Perform actions needed for flags for previously missed events
-    // Export as a package if the flag was set, because we missed the time to do it earlier
-    if(ctx->compiler->traits & COMPILER_MAKE_PACKAGE){
-        if(compiler_create_package(ctx->compiler, ctx->object) == 0) ctx->compiler->result_flags |= COMPILER_RESULT_SUCCESS;
-        return FAILURE;
-    }
-
     return SUCCESS;
 }
@@ -5,6 +5,7 @@
 
 #include "AST/ast_expr.h"
 #include "AST/ast_named_expression.h"
+#include "AST/ast_node_alloc.h"
 #include "AST/ast_type.h"
 #include "DRVR/compiler.h"
 #include "DRVR/object.h"
@@ -89,8 +90,7 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
     // NOTE: Even if this function returns FAILURE, statements appended to stmt_list still must be freed
 
     length_t *i = ctx->i;
-    token_t *tokens = ctx->tokenlist->tokens;
-    source_t *sources = ctx->tokenlist->sources;
+    tokenid_t *ids = ctx->tokenlist->ids;
 
     source_t source = (source_t){
         .index = 0,
@@ -109,9 +109,9 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
             return SUCCESS;
         case TOKEN_RETURN: {
                 ast_expr_t *return_expression;
-                source = sources[(*i)++]; // Pass over return keyword
+                source = tokenlist_source(ctx->tokenlist, (*i)++); // Pass over return keyword
 
-                if(tokens[*i].id == TOKEN_NEWLINE){
+                if(ids[*i] == TOKEN_NEWLINE){
                     return_expression = NULL;
                 } else if(parse_expr(ctx, &return_expression)){
                     return FAILURE;
@@ -136,10 +136,10 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
             }
             break;
         case TOKEN_DEFINE:
-            if(parse_local_named_expression_declaration(ctx, stmt_list, sources[*i])) return FAILURE;
+            if(parse_local_named_expression_declaration(ctx, stmt_list, tokenlist_source(ctx->tokenlist, *i))) return FAILURE;
             break;
         case TOKEN_WORD: {
-                source = sources[(*i)++]; // Read ahead to see what type of statement this is
+                source = tokenlist_source(ctx->tokenlist, (*i)++); // Read ahead to see what type of statement this is
 
                 switch(parse_ctx_peek(ctx)){
                 case TOKEN_MAYBE:
@@ -202,23 +202,23 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
 
                 if(parse_ctx_peek(ctx) == TOKEN_BREAK || parse_ctx_peek(ctx) == TOKEN_CONTINUE){
                     // 'while continue' or 'until break' loop
-                    unsigned int condition_break_or_continue = tokens[*i].id;
+                    unsigned int condition_break_or_continue = ids[*i];
 
                     if(conditional_type == TOKEN_WHILE && condition_break_or_continue != TOKEN_CONTINUE){
-                        compiler_panic(ctx->compiler, sources[*i - 1], "Did you mean to use 'while continue'? There is no such conditional as 'while break'");
+                        compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i - 1), "Did you mean to use 'while continue'? There is no such conditional as 'while break'");
                         return FAILURE;
                     } else if(conditional_type == TOKEN_UNTIL && condition_break_or_continue != TOKEN_BREAK){
-                        compiler_panic(ctx->compiler, sources[*i - 1], "Did you mean to use 'until break'? There is no such conditional as 'until continue'");
+                        compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i - 1), "Did you mean to use 'until break'? There is no such conditional as 'until continue'");
                         return FAILURE;
                     }
 
-                    if(tokens[++(*i)].id == TOKEN_WORD){
-                        label = tokens[(*i)++].data;
+                    if(ids[++(*i)] == TOKEN_WORD){
+                        label = tokenlist_data(ctx->tokenlist, (*i)++);
                     }
                 } else {
                     // standard 'while <expr>' or 'until <expr>' loop
-                    if(tokens[*i].id == TOKEN_WORD && tokens[*i + 1].id == TOKEN_COLON){
-                        label = tokens[*i].data;
+                    if(ids[*i] == TOKEN_WORD && ids[*i + 1] == TOKEN_COLON){
+                        label = tokenlist_data(ctx->tokenlist, *i);
                         *i += 2;
                     }
 
@@ -255,7 +255,7 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
 
                 if(conditional == NULL){
                     // 'while continue' or 'until break' loop
-                    ast_expr_whilecontinue_t *stmt = malloc(sizeof(ast_expr_whilecontinue_t));
+                    ast_expr_whilecontinue_t *stmt = ast_node_alloc(sizeof(ast_expr_whilecontinue_t));
                     stmt->id = (conditional_type == TOKEN_UNTIL) ? EXPR_UNTILBREAK : EXPR_WHILECONTINUE;
                     stmt->source = source;
                     stmt->label = label;
@@ -264,7 +264,7 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
                     ast_expr_list_append_unchecked(stmt_list, (ast_expr_t*) stmt);
                 } else {
                     // 'while <expr>' or 'until <expr>' loop
-                    ast_expr_while_t *stmt = malloc(sizeof(ast_expr_while_t));
+                    ast_expr_while_t *stmt = ast_node_alloc(sizeof(ast_expr_while_t));
                     stmt->id = (conditional_type == TOKEN_UNTIL) ? EXPR_UNTIL : EXPR_WHILE;
                     stmt->source = source;
                     stmt->label = label;
@@ -275,7 +275,7 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
             }
             break;
         case TOKEN_EACH: {
-                source = sources[(*i)++];
+                source = tokenlist_source(ctx->tokenlist, (*i)++);
 
                 maybe_null_strong_cstr_t it_name = NULL;
                 ast_type_t *it_type = NULL;
@@ -290,12 +290,12 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
                 ast_expr_t *list_expr = NULL;
 
                 // Attach label if present
-                if(tokens[*i].id == TOKEN_WORD && tokens[*i + 1].id == TOKEN_COLON){
-                    label = tokens[*i].data; *i += 2;
+                if(ids[*i] == TOKEN_WORD && ids[*i + 1] == TOKEN_COLON){
+                    label = tokenlist_data(ctx->tokenlist, *i); *i += 2;
                 }
                 
                 // Record override variable name for 'it' if present
-                if(tokens[*i].id == TOKEN_WORD && tokens[*i + 1].id != TOKEN_IN){
+                if(ids[*i] == TOKEN_WORD && ids[*i + 1] != TOKEN_IN){
                     it_name = parse_take_word(ctx, "Expected name for 'it' variable");
                     if(!it_name) return FAILURE;
                 }
@@ -309,11 +309,11 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
                     return FAILURE;
                 }
 
-                bool is_static = tokens[*i].id == TOKEN_STATIC;
+                bool is_static = ids[*i] == TOKEN_STATIC;
                 if(is_static) *i += 1;
 
                 // Handle values given for 'each in [array, length]' statement
-                if(tokens[*i].id == TOKEN_BRACKET_OPEN){
+                if(ids[*i] == TOKEN_BRACKET_OPEN){
                     (*i)++;
 
                     if(parse_expr(ctx, &low_array)){
@@ -322,8 +322,8 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
                         return FAILURE;
                     }
 
-                    if(tokens[(*i)++].id != TOKEN_NEXT){
-                        compiler_panic(ctx->compiler, sources[*i - 1], "Expected ',' after low-level array data in 'each in' statement");
+                    if(ids[(*i)++] != TOKEN_NEXT){
+                        compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i - 1), "Expected ',' after low-level array data in 'each in' statement");
                         ast_type_free_fully(it_type);
                         free(it_name);
                         return FAILURE;
@@ -336,8 +336,8 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
                         return FAILURE;
                     }
 
-                    if(tokens[(*i)++].id != TOKEN_BRACKET_CLOSE){
-                        compiler_panic(ctx->compiler, sources[*i - 1], "Expected ']' after low-level array data and length in 'each in' statement");
+                    if(ids[(*i)++] != TOKEN_BRACKET_CLOSE){
+                        compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i - 1), "Expected ']' after low-level array data and length in 'each in' statement");
                         ast_type_free_fully(it_type);
                         ast_expr_free_fully(low_array);
                         ast_expr_free_fully(length_limit);
@@ -394,7 +394,7 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
                 }
 
                 // 'each in list' or 'each in [array, length]
-                ast_expr_each_in_t *stmt = malloc(sizeof(ast_expr_each_in_t));
+                ast_expr_each_in_t *stmt = ast_node_alloc(sizeof(ast_expr_each_in_t));
                 stmt->id = EXPR_EACH_IN;
                 stmt->source = source;
                 stmt->label = label;
@@ -409,14 +409,14 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
             }
             break;
         case TOKEN_REPEAT: {
-                source = sources[(*i)++];
+                source = tokenlist_source(ctx->tokenlist, (*i)++);
                 ast_expr_t *limit = NULL;
                 trait_t stmts_mode;
                 maybe_null_weak_cstr_t label = NULL;
                 maybe_null_weak_cstr_t idx_name = NULL;
 
-                if(tokens[*i].id == TOKEN_WORD && tokens[*i + 1].id == TOKEN_COLON){
-                    label = tokens[*i].data;
+                if(ids[*i] == TOKEN_WORD && ids[*i + 1] == TOKEN_COLON){
+                    label = tokenlist_data(ctx->tokenlist, *i);
                     *i += 2;
                 }
 
@@ -429,7 +429,7 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
                     return FAILURE;
                 }
 
-                if(tokens[*i].id == TOKEN_USING){
+                if(ids[*i] == TOKEN_USING){
                     idx_name = parse_grab_word(ctx, "Expected name for 'idx' variable after 'using' keyword");
 
                     if(idx_name == NULL){
@@ -469,7 +469,7 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
                     *i += 1;
                 }
 
-                ast_expr_repeat_t *stmt = malloc(sizeof(ast_expr_repeat_t));
+                ast_expr_repeat_t *stmt = ast_node_alloc(sizeof(ast_expr_repeat_t));
                 stmt->id = EXPR_REPEAT;
                 stmt->source = source;
                 stmt->label = label;
@@ -494,7 +494,7 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
             }
             break;
         case TOKEN_DELETE: {
-                source = sources[(*i)++];
+                source = tokenlist_source(ctx->tokenlist, (*i)++);
 
                 ast_expr_t *value;
                 if(parse_primary_expr(ctx, &value)) return FAILURE;
@@ -503,19 +503,19 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
             }
             break;
         case TOKEN_BREAK: {
-                if(tokens[++(*i)].id == TOKEN_WORD){
-                    ast_expr_break_to_t *stmt = malloc(sizeof(ast_expr_break_to_t));
+                if(ids[++(*i)] == TOKEN_WORD){
+                    ast_expr_break_to_t *stmt = ast_node_alloc(sizeof(ast_expr_break_to_t));
                     stmt->id = EXPR_BREAK_TO;
-                    stmt->source = sources[*i - 1];
-                    stmt->label_source = sources[*i];
-                    stmt->label = tokens[(*i)++].data;
+                    stmt->source = tokenlist_source(ctx->tokenlist, *i - 1);
+                    stmt->label_source = tokenlist_source(ctx->tokenlist, *i);
+                    stmt->label = tokenlist_data(ctx->tokenlist, (*i)++);
 
                     defer_scope_rewind(defer_scope, stmt_list, BREAKABLE, stmt->label);
                     ast_expr_list_append_unchecked(stmt_list, (ast_expr_t*) stmt);
                 } else {
-                    ast_expr_break_t *stmt = malloc(sizeof(ast_expr_break_t));
+                    ast_expr_break_t *stmt = ast_node_alloc(sizeof(ast_expr_break_t));
                     stmt->id = EXPR_BREAK;
-                    stmt->source = sources[*i - 1];
+                    stmt->source = tokenlist_source(ctx->tokenlist, *i - 1);
 
                     defer_scope_rewind(defer_scope, stmt_list, BREAKABLE, NULL);
                     ast_expr_list_append_unchecked(stmt_list, (ast_expr_t*) stmt);
@@ -523,19 +523,19 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
             }
             break;
         case TOKEN_CONTINUE: {
-                if(tokens[++(*i)].id == TOKEN_WORD){
-                    ast_expr_continue_to_t *stmt = malloc(sizeof(ast_expr_continue_to_t));
+                if(ids[++(*i)] == TOKEN_WORD){
+                    ast_expr_continue_to_t *stmt = ast_node_alloc(sizeof(ast_expr_continue_to_t));
                     stmt->id = EXPR_CONTINUE_TO;
-                    stmt->source = sources[*i - 1];
-                    stmt->label_source = sources[*i];
-                    stmt->label = tokens[(*i)++].data;
+                    stmt->source = tokenlist_source(ctx->tokenlist, *i - 1);
+                    stmt->label_source = tokenlist_source(ctx->tokenlist, *i);
+                    stmt->label = tokenlist_data(ctx->tokenlist, (*i)++);
 
                     defer_scope_rewind(defer_scope, stmt_list, CONTINUABLE, stmt->label);
                     ast_expr_list_append_unchecked(stmt_list, (ast_expr_t*) stmt);
                 } else {
-                    ast_expr_continue_t *stmt = malloc(sizeof(ast_expr_continue_t));
+                    ast_expr_continue_t *stmt = ast_node_alloc(sizeof(ast_expr_continue_t));
                     stmt->id = EXPR_CONTINUE;
-                    stmt->source = sources[*i - 1];
+                    stmt->source = tokenlist_source(ctx->tokenlist, *i - 1);
 
                     defer_scope_rewind(defer_scope, stmt_list, CONTINUABLE, NULL);
                     ast_expr_list_append_unchecked(stmt_list, (ast_expr_t*) stmt);
@@ -543,12 +543,10 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
             }
             break;
         case TOKEN_FALLTHROUGH: {
-                ast_expr_fallthrough_t *stmt = malloc(sizeof(ast_expr_fallthrough_t));
-
-                *stmt = (ast_expr_fallthrough_t){
+                ast_expr_fallthrough_t *stmt = ast_node_alloc_init(ast_expr_fallthrough_t, {
                     .id = EXPR_FALLTHROUGH,
-                    .source = sources[(*i)++],
-                };
+                    .source = tokenlist_source(ctx->tokenlist, (*i)++),
+                });
 
                 defer_scope_rewind(defer_scope, stmt_list, FALLTHROUGHABLE, NULL);
                 ast_expr_list_append_unchecked(stmt_list, (ast_expr_t*) stmt);
@@ -566,7 +564,7 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
             break;
         case TOKEN_VA_START: case TOKEN_VA_END: {
                 unsigned int expr_id = parse_ctx_peek(ctx) == TOKEN_VA_START ? EXPR_VA_START : EXPR_VA_END;
-                source = sources[(*i)++];
+                source = tokenlist_source(ctx->tokenlist, (*i)++);
 
                 ast_expr_t *value;
                 if(parse_expr(ctx, &value)) return FAILURE;
@@ -578,7 +576,7 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
                 // va_copy(dest, src)
                 //    ^
 
-                source = sources[(*i)++];
+                source = tokenlist_source(ctx->tokenlist, (*i)++);
 
                 ast_expr_t *dest_value = NULL;
                 ast_expr_t *src_value = NULL;
@@ -604,14 +602,14 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
                 ast_expr_t *condition = NULL;
                 ast_expr_list_t before, after, statements;
                 weak_cstr_t label = NULL;
-                source = sources[*i];
+                source = tokenlist_source(ctx->tokenlist, *i);
                 
                 memset(&before, 0, sizeof(ast_expr_list_t));
                 memset(&after, 0, sizeof(ast_expr_list_t));
                 memset(&statements, 0, sizeof(ast_expr_list_t));
 
-                if(tokens[*i].id == TOKEN_WORD && tokens[*i + 1].id == TOKEN_COLON){
-                    label = tokens[*i].data;
+                if(ids[*i] == TOKEN_WORD && ids[*i + 1] == TOKEN_COLON){
+                    label = tokenlist_data(ctx->tokenlist, *i);
                     *i += 2;
                 }
 
@@ -621,9 +619,9 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
                 (*i)++;
 
                 // Eat '(' if it exists
-                if(tokens[*i].id == TOKEN_OPEN) (*i)++;
+                if(ids[*i] == TOKEN_OPEN) (*i)++;
 
-                if(tokens[*i].id != TOKEN_TERMINATE_JOIN && parse_stmts(ctx, &before, &for_defer_scope, PARSE_STMTS_SINGLE | PARSE_STMTS_NO_JOINING | PARSE_STMTS_PARENT_DEFER_SCOPE)){
+                if(ids[*i] != TOKEN_TERMINATE_JOIN && parse_stmts(ctx, &before, &for_defer_scope, PARSE_STMTS_SINGLE | PARSE_STMTS_NO_JOINING | PARSE_STMTS_PARENT_DEFER_SCOPE)){
                     defer_scope_free(&for_defer_scope);
                     return FAILURE;
                 }
@@ -634,7 +632,7 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
                     return FAILURE;
                 }
 
-                if(tokens[*i].id != TOKEN_TERMINATE_JOIN && parse_expr(ctx, &condition)){
+                if(ids[*i] != TOKEN_TERMINATE_JOIN && parse_expr(ctx, &condition)){
                     ast_exprs_free_fully(before.statements, before.length);
                     defer_scope_free(&for_defer_scope);
                     return FAILURE;
@@ -647,7 +645,7 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
                     return FAILURE;
                 }
 
-                if(tokens[*i].id != TOKEN_NEXT && tokens[*i].id != TOKEN_BEGIN && tokens[*i].id != TOKEN_NEWLINE && tokens[*i].id != TOKEN_CLOSE){
+                if(ids[*i] != TOKEN_NEXT && ids[*i] != TOKEN_BEGIN && ids[*i] != TOKEN_NEWLINE && ids[*i] != TOKEN_CLOSE){
                     // Put the 'after' statement directly in the defer statements of the 'for' loop
                     if(parse_stmts(ctx, &after, &for_defer_scope, PARSE_STMTS_SINGLE | PARSE_STMTS_NO_JOINING | PARSE_STMTS_PARENT_DEFER_SCOPE)){
                         ast_expr_free(condition);
@@ -658,7 +656,7 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
                 }
 
                 // Eat ')' if it exists
-                if(tokens[*i].id == TOKEN_CLOSE) (*i)++;
+                if(ids[*i] == TOKEN_CLOSE) (*i)++;
 
                 if(parse_ignore_newlines(ctx, "Expected '{' or ',' after conditional expression")){
                     ast_expr_free(condition);
@@ -670,11 +668,11 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
 
                 // Eat '{' or ','
                 unsigned int stmts_mode;
-                switch(tokens[(*i)++].id){
+                switch(ids[(*i)++]){
                 case TOKEN_BEGIN: stmts_mode = PARSE_STMTS_STANDARD; break;
                 case TOKEN_NEXT:  stmts_mode = PARSE_STMTS_SINGLE;   break;
                 default:
-                    compiler_panic(ctx->compiler, sources[*i - 1], "Expected '{' or ',' after beginning parts of 'for' loop");
+                    compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i - 1), "Expected '{' or ',' after beginning parts of 'for' loop");
                     ast_expr_free(condition);
                     ast_exprs_free_fully(before.statements, before.length);
                     ast_exprs_free_fully(after.statements, after.length);
@@ -712,11 +710,11 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
             if(parse_assert(ctx, stmt_list)) return FAILURE;
             break;
         default:
-            parse_panic_token(ctx, sources[*i], tokens[*i].id, "Encountered unexpected token '%s' at beginning of statement");
+            parse_panic_token(ctx, tokenlist_source(ctx->tokenlist, *i), ids[*i], "Encountered unexpected token '%s' at beginning of statement");
             return FAILURE;
         }
 
-        if(tokens[*i].id == TOKEN_TERMINATE_JOIN && !(mode & PARSE_STMTS_NO_JOINING)){
+        if(ids[*i] == TOKEN_TERMINATE_JOIN && !(mode & PARSE_STMTS_NO_JOINING)){
             // Bypass single statement flag by "joining" 2+ statements
             (*i)++;
             continue;
@@ -724,13 +722,13 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
 
         // Continue over newline token
         // TODO: INVESTIGATE: Investigate whether TOKEN_META #else/#elif should be having (*i)++ here
-        tokenid_t ending = tokens[*i].id;
-        const void *ending_data = tokens[*i].data;
+        tokenid_t ending = ids[*i];
+        const void *ending_data = tokenlist_data(ctx->tokenlist, *i);
 
         if(ending == TOKEN_NEWLINE || (ending == TOKEN_META && (streq(ending_data, "else") || streq(ending_data, "elif")))){
             (*i)++;
         } else if(ending != TOKEN_ELSE && ending != TOKEN_TERMINATE_JOIN && ending != TOKEN_CLOSE && ending != TOKEN_BEGIN && ending != TOKEN_NEXT){
-            parse_panic_token(ctx, sources[*i], ending, "Encountered unexpected token '%s' at end of statement");
+            parse_panic_token(ctx, tokenlist_source(ctx->tokenlist, *i), ending, "Encountered unexpected token '%s' at end of statement");
             return FAILURE;
         }
 
@@ -912,7 +910,7 @@ errorcode_t parse_switch(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_sco
     //    ^
 
     length_t beginning_index = *ctx->i - (is_exhaustive ? 1 : 0);
-    source_t source = ctx->tokenlist->sources[beginning_index];
+    source_t source = tokenlist_source(ctx->tokenlist, beginning_index);
 
     if(parse_eat(ctx, TOKEN_SWITCH, "Expected 'switch' keyword after 'exhaustive' keyword")) return FAILURE;
 
@@ -999,7 +997,7 @@ failure:
 }
 
 errorcode_t parse_conditionless_block(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scope_t *defer_scope){
-    source_t source = ctx->tokenlist->sources[(*ctx->i)++];
+    source_t source = tokenlist_source(ctx->tokenlist, (*ctx->i)++);
 
     ast_expr_list_t block_stmt_list = ast_expr_list_create(4);
     defer_scope_t block_defer_scope = defer_scope_create(defer_scope, NULL, TRAIT_NONE);
@@ -1014,7 +1012,7 @@ errorcode_t parse_conditionless_block(parse_ctx_t *ctx, ast_expr_list_t *stmt_li
 
     defer_scope_free(&block_defer_scope);
 
-    ast_expr_list_append_unchecked(stmt_list, (ast_expr_t*) malloc_init(ast_expr_conditionless_block_t, {
+    ast_expr_list_append_unchecked(stmt_list, (ast_expr_t*) ast_node_alloc_init(ast_expr_conditionless_block_t, {
         .id = EXPR_CONDITIONLESS_BLOCK,
         .source = source,
         .statements = block_stmt_list,
@@ -1026,7 +1024,7 @@ errorcode_t parse_conditionless_block(parse_ctx_t *ctx, ast_expr_list_t *stmt_li
 errorcode_t parse_assert(parse_ctx_t *ctx, ast_expr_list_t *stmt_list){
     ast_expr_t *assertion = NULL, *message = NULL;
 
-    source_t source = ctx->tokenlist->sources[(*ctx->i)++];
+    source_t source = tokenlist_source(ctx->tokenlist, (*ctx->i)++);
 
     if(parse_expr(ctx, &assertion)){
         goto failure;
@@ -1036,7 +1034,7 @@ errorcode_t parse_assert(parse_ctx_t *ctx, ast_expr_list_t *stmt_list){
         goto failure;
     }
 
-    ast_expr_list_append_unchecked(stmt_list, (ast_expr_t*) malloc_init(ast_expr_assert_t, {
+    ast_expr_list_append_unchecked(stmt_list, (ast_expr_t*) ast_node_alloc_init(ast_expr_assert_t, {
         .id = EXPR_ASSERT,
         .source = source,
         .assertion = assertion,
@@ -1052,11 +1050,11 @@ failure:
 }
 
 errorcode_t parse_onetime_conditional(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scope_t *defer_scope){
-    token_t *tokens = ctx->tokenlist->tokens;
+    tokenid_t *ids = ctx->tokenlist->ids;
     length_t *i = ctx->i;
 
-    unsigned int conditional_type = tokens[*i].id;
-    source_t source = ctx->tokenlist->sources[(*ctx->i)++];
+    unsigned int conditional_type = ids[*i];
+    source_t source = tokenlist_source(ctx->tokenlist, (*ctx->i)++);
 
     ast_expr_t *condition;
     trait_t stmts_mode;
@@ -1091,14 +1089,14 @@ errorcode_t parse_onetime_conditional(parse_ctx_t *ctx, ast_expr_list_t *stmt_li
 
     // Read ahead of newlines to check for 'else'
     length_t i_readahead = *i;
-    while(tokens[i_readahead].id == TOKEN_NEWLINE && i_readahead != ctx->tokenlist->length){
+    while(ids[i_readahead] == TOKEN_NEWLINE && i_readahead != ctx->tokenlist->length){
         i_readahead++;
     }
 
-    if(tokens[i_readahead].id == TOKEN_ELSE){
+    if(ids[i_readahead] == TOKEN_ELSE){
         *i = i_readahead;
 
-        switch(tokens[++(*i)].id){
+        switch(ids[++(*i)]){
         case TOKEN_NEXT:
             stmts_mode = PARSE_STMTS_SINGLE;
             *i += 1;
@@ -1129,7 +1127,7 @@ errorcode_t parse_onetime_conditional(parse_ctx_t *ctx, ast_expr_list_t *stmt_li
             *i += 1;
         }
 
-        ast_expr_ifelse_t *stmt = malloc(sizeof(ast_expr_ifelse_t));
+        ast_expr_ifelse_t *stmt = ast_node_alloc(sizeof(ast_expr_ifelse_t));
         stmt->id = (conditional_type == TOKEN_UNLESS) ? EXPR_UNLESSELSE : EXPR_IFELSE;
         stmt->source = source;
         stmt->label = NULL;
@@ -1161,10 +1159,9 @@ errorcode_t parse_ambiguous_open_bracket(parse_ctx_t *ctx, ast_expr_list_t *stmt
     // variable[value][value] ...
     // variable [value] [value] Type
 
-    token_t *tokens = ctx->tokenlist->tokens;
-    source_t *sources = ctx->tokenlist->sources;
+    tokenid_t *ids = ctx->tokenlist->ids;
     length_t *i = ctx->i;
-    source_t source = sources[*i];
+    source_t source = tokenlist_source(ctx->tokenlist, *i);
 
     // word [
     //   ^
@@ -1181,10 +1178,10 @@ errorcode_t parse_ambiguous_open_bracket(parse_ctx_t *ctx, ast_expr_list_t *stmt
     ast_expr_list_t expr_list = ast_expr_list_create(4);
 
     // Parse ahead
-    while(tokens[*i].id == TOKEN_BRACKET_OPEN){
+    while(ids[*i] == TOKEN_BRACKET_OPEN){
         expand((void**) &expr_source_list, sizeof(source_t), expr_source_list_length, &expr_source_list_capacity, 1, 4);
 
-        expr_source_list[expr_source_list_length++] = sources[*i];
+        expr_source_list[expr_source_list_length++] = tokenlist_source(ctx->tokenlist, *i);
         (*i)++;
 
         ast_expr_t *sub_expr;
@@ -1208,7 +1205,7 @@ errorcode_t parse_ambiguous_open_bracket(parse_ctx_t *ctx, ast_expr_list_t *stmt
 
     // Determine if this statement should be treated as a declaration,
     // or as a mutable value operation
-    tokenid_t id = tokens[*i].id;
+    tokenid_t id = ids[*i];
     bool is_declaration = parse_can_type_start_with(id, false) || id == TOKEN_NEXT;
 
     if(is_declaration){
@@ -1232,7 +1229,7 @@ errorcode_t parse_ambiguous_open_bracket(parse_ctx_t *ctx, ast_expr_list_t *stmt
 
         for(length_t i = 0; i != expr_list.length; i++){
             ast_elem_var_fixed_array_t **element = (ast_elem_var_fixed_array_t**) &new_elements[i];
-            *element = malloc(sizeof(ast_elem_var_fixed_array_t));
+            *element = ast_node_alloc(sizeof(ast_elem_var_fixed_array_t));
             (*element)->id = AST_ELEM_VAR_FIXED_ARRAY;
             (*element)->source = expr_source_list[i];
             (*element)->length = expr_list.statements[i];
@@ -1323,8 +1320,7 @@ errorcode_t parse_mid_mutable_expr_operation(parse_ctx_t *ctx, ast_expr_list_t *
     // NOTE: expand() should've already been used on stmt_list to make room
     // NOTE: Takes ownership of 'mutable_expr' and will free it in the case of failure
 
-    token_t *tokens = ctx->tokenlist->tokens;
-    source_t *sources = ctx->tokenlist->sources;
+    tokenid_t *ids = ctx->tokenlist->ids;
     length_t *i = ctx->i;
     
     // For some expressions, bypass and treat as statement
@@ -1348,7 +1344,7 @@ errorcode_t parse_mid_mutable_expr_operation(parse_ctx_t *ctx, ast_expr_list_t *
     }
 
     // NOTE: This is not the only place which assignment operators are handled
-    unsigned int id = tokens[(*i)++].id;
+    unsigned int id = ids[(*i)++];
 
     // Otherwise, it must be some type of assignment
     switch(id){
@@ -1367,7 +1363,7 @@ errorcode_t parse_mid_mutable_expr_operation(parse_ctx_t *ctx, ast_expr_list_t *
     case TOKEN_BIT_LGC_RSHIFT_ASSIGN:
         break;
     default:
-        compiler_panic(ctx->compiler, sources[(*i) - 1], "Expected assignment operator after expression");
+        compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, (*i) - 1), "Expected assignment operator after expression");
         ast_expr_free_fully(mutable_expr);
         return FAILURE;
     }
@@ -1375,7 +1371,7 @@ errorcode_t parse_mid_mutable_expr_operation(parse_ctx_t *ctx, ast_expr_list_t *
     bool is_pod = (parse_eat(ctx, TOKEN_POD, NULL) == SUCCESS);
 
     if(!expr_is_mutable(mutable_expr)){
-        compiler_panic(ctx->compiler, sources[*i], "Can't modify expression because it is immutable");
+        compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Can't modify expression because it is immutable");
         ast_expr_free_fully(mutable_expr);
         return FAILURE;
     }
@@ -1402,7 +1398,7 @@ errorcode_t parse_mid_mutable_expr_operation(parse_ctx_t *ctx, ast_expr_list_t *
     case TOKEN_BIT_LGC_LSHIFT_ASSIGN: stmt_id = EXPR_LGC_LSHIFT_ASSIGN;   break;
     case TOKEN_BIT_LGC_RSHIFT_ASSIGN: stmt_id = EXPR_LGC_RSHIFT_ASSIGN;   break;
     default:
-        compiler_panic(ctx->compiler, sources[*i], "INTERNAL ERROR: parse_stmts() came across unknown assignment operator");
+        compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "INTERNAL ERROR: parse_stmts() came across unknown assignment operator");
         ast_expr_free_fully(mutable_expr);
         ast_expr_free_fully(value_expression);
         return FAILURE;
@@ -1417,8 +1413,8 @@ errorcode_t parse_llvm_asm(parse_ctx_t *ctx, ast_expr_list_t *stmt_list){
     //    ^
 
     length_t *i = ctx->i;
-    token_t *tokens = ctx->tokenlist->tokens;
-    source_t source = ctx->tokenlist->sources[*i];
+    tokenid_t *ids = ctx->tokenlist->ids;
+    source_t source = tokenlist_source(ctx->tokenlist, *i);
 
     // Eat 'llvm_asm'
     if(parse_eat(ctx, TOKEN_LLVM_ASM, "Expected 'llvm_asm' keyword for inline LLVM assembly code")) return FAILURE;
@@ -1459,10 +1455,10 @@ errorcode_t parse_llvm_asm(parse_ctx_t *ctx, ast_expr_list_t *stmt_list){
 
     if(parse_eat(ctx, TOKEN_BEGIN, "Expected '{' after llvm_asm dialect")) return FAILURE;
 
-    while(tokens[*i].id != TOKEN_END){
-        switch(tokens[*i].id){
+    while(ids[*i] != TOKEN_END){
+        switch(ids[*i]){
         case TOKEN_STRING: case TOKEN_CSTRING: {
-                token_string_data_t *string_data = (token_string_data_t*) tokens[*i].data;
+                token_string_data_t *string_data = (token_string_data_t*) tokenlist_data(ctx->tokenlist, *i);
                 string_builder_append_view(&builder, string_data->array, string_data->length);
                 string_builder_append_char(&builder, '\n');
             }
@@ -1471,13 +1467,13 @@ errorcode_t parse_llvm_asm(parse_ctx_t *ctx, ast_expr_list_t *stmt_list){
         case TOKEN_NEWLINE:
             break;
         default:
-            compiler_panicf(ctx->compiler, ctx->tokenlist->sources[*i], "Expected string or ',' while inside { ... } for inline LLVM assembly");
+            compiler_panicf(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Expected string or ',' while inside { ... } for inline LLVM assembly");
             string_builder_abandon(&builder);
             return FAILURE;
         }
         
         if(++(*i) == ctx->tokenlist->length){
-            compiler_panicf(ctx->compiler, ctx->tokenlist->sources[*i], "Expected '}' for inline LLVM assembly before end-of-file");
+            compiler_panicf(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Expected '}' for inline LLVM assembly before end-of-file");
             string_builder_abandon(&builder);
             return FAILURE;
         }
@@ -1501,7 +1497,7 @@ errorcode_t parse_llvm_asm(parse_ctx_t *ctx, ast_expr_list_t *stmt_list){
         return FAILURE;
     }
 
-    while(tokens[*i].id != TOKEN_CLOSE){
+    while(ids[*i] != TOKEN_CLOSE){
         ast_expr_t *arg;
 
         if( parse_ignore_newlines(ctx, "Expected argument to LLVM assembly")
@@ -1513,10 +1509,10 @@ errorcode_t parse_llvm_asm(parse_ctx_t *ctx, ast_expr_list_t *stmt_list){
         
         ast_expr_list_append(&args, arg);
 
-        if(tokens[*i].id == TOKEN_NEXT){
+        if(ids[*i] == TOKEN_NEXT){
             (*i)++;
-        } else if(tokens[*i].id != TOKEN_CLOSE){
-            compiler_panic(ctx->compiler, ctx->tokenlist->sources[*i], "Expected ',' or ')' after after argument to LLVM assembly");
+        } else if(ids[*i] != TOKEN_CLOSE){
+            compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Expected ',' or ')' after after argument to LLVM assembly");
             goto failure;
         }
     }
@@ -1524,7 +1520,7 @@ errorcode_t parse_llvm_asm(parse_ctx_t *ctx, ast_expr_list_t *stmt_list){
     // Move past closing ')'
     *i += 1;
 
-    ast_expr_llvm_asm_t *stmt = malloc(sizeof(ast_expr_llvm_asm_t));
+    ast_expr_llvm_asm_t *stmt = ast_node_alloc(sizeof(ast_expr_llvm_asm_t));
     stmt->id = EXPR_LLVM_ASM;
     stmt->source = source;
     stmt->assembly = strong_cstr_empty_if_null(assembly);
@@ -1589,7 +1585,7 @@ errorcode_t parse_block_beginning(parse_ctx_t *ctx, weak_cstr_t block_readable_m
         *out_stmts_mode = PARSE_STMTS_SINGLE;
         return SUCCESS;
     default:
-        compiler_panicf(ctx->compiler, ctx->tokenlist->sources[*ctx->i - 1], "Expected '{' or ',' after %s expression", block_readable_mother);
+        compiler_panicf(ctx->compiler, tokenlist_source(ctx->tokenlist, *ctx->i - 1), "Expected '{' or ',' after %s expression", block_readable_mother);
         return FAILURE;
     }
     return FAILURE;
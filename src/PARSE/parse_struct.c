@@ -43,7 +43,7 @@ errorcode_t parse_generics(parse_ctx_t *ctx, strong_cstr_t **out_generics, lengt
             }
 
             if(parse_ctx_peek(ctx) != TOKEN_POLYMORPH){
-                compiler_panic(ctx->compiler, ctx->tokenlist->sources[*ctx->i], "Expected polymorphic generic type");
+                compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *ctx->i), "Expected polymorphic generic type");
                 goto failure;
             }
 
@@ -56,11 +56,11 @@ errorcode_t parse_generics(parse_ctx_t *ctx, strong_cstr_t **out_generics, lengt
 
             if(parse_eat(ctx, TOKEN_NEXT, NULL) == SUCCESS){
                 if(parse_ctx_peek(ctx) == TOKEN_GREATERTHAN){
-                    compiler_panic(ctx->compiler, ctx->tokenlist->sources[*ctx->i], "Expected polymorphic generic type after ',' in generics list");
+                    compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *ctx->i), "Expected polymorphic generic type after ',' in generics list");
                     goto failure;
                 }
             } else if(parse_ctx_peek(ctx) != TOKEN_GREATERTHAN){
-                compiler_panic(ctx->compiler, ctx->tokenlist->sources[*ctx->i], "Expected ',' after polymorphic generic type");
+                compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *ctx->i), "Expected ',' after polymorphic generic type");
                 goto failure;
             }
         }
@@ -127,11 +127,14 @@ errorcode_t parse_composite(parse_ctx_t *ctx, bool is_union){
     } else {
         domain = ast_add_composite(ast, name, layout, source, maybe_parent_class, is_class);
     }
+
+    // The composite has its own interned copy of the name
+    free(name);
     
     if(is_record){
         // Create constructor function if composite is a record type
         // NOTE: Ownership of 'return_type' is given away
-        if(parse_create_record_constructor(ctx, name, generics, generics_length, &layout, source)) return FAILURE;
+        if(parse_create_record_constructor(ctx, domain->name, generics, generics_length, &layout, source)) return FAILURE;
     }
 
     if(parse_composite_domain(ctx, domain)) return FAILURE;
@@ -197,7 +200,7 @@ errorcode_t parse_composite_head(
     length_t *out_generics_length
 ){
     length_t *i = ctx->i;
-    token_t *tokens = ctx->tokenlist->tokens;
+    tokenid_t *ids = ctx->tokenlist->ids;
 
     *out_is_packed = false;
     *out_is_record = false;
@@ -207,15 +210,15 @@ errorcode_t parse_composite_head(
     if(is_union){
         if(parse_eat(ctx, TOKEN_UNION, "Expected 'union' keyword for union definition")) return FAILURE;
     } else {
-        if(tokens[*i].id == TOKEN_PACKED){
+        if(ids[*i] == TOKEN_PACKED){
             *out_is_packed = true;
             *i += 1;
         }
         
-        if(tokens[*i].id == TOKEN_RECORD){
+        if(ids[*i] == TOKEN_RECORD){
             *out_is_record = true;
             *i += 1;
-        } else if(tokens[*i].id == TOKEN_CLASS){
+        } else if(ids[*i] == TOKEN_CLASS){
             *out_is_class = true;
             *i += 1;
         } else if(parse_eat(ctx, TOKEN_STRUCT, "Expected 'struct' keyword after 'packed' keyword")){
@@ -263,17 +266,16 @@ errorcode_t parse_composite_body(
     // Parses root-level composite fields
 
     length_t *i = ctx->i;
-    token_t *tokens = ctx->tokenlist->tokens;
-    source_t *sources = ctx->tokenlist->sources;
+    tokenid_t *ids = ctx->tokenlist->ids;
 
     if(parse_ignore_newlines(ctx, "Expected '(' or '{' after composite name")) return FAILURE;
 
-    if(tokens[*i].id != TOKEN_OPEN && tokens[*i].id != TOKEN_BEGIN){
-        compiler_panic(ctx->compiler, sources[*i], "Expected '(' or '{' after composite name");
+    if(ids[*i] != TOKEN_OPEN && ids[*i] != TOKEN_BEGIN){
+        compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Expected '(' or '{' after composite name");
         return FAILURE;
     }
 
-    ctx->struct_closer = tokens[(*i)++].id == TOKEN_OPEN ? TOKEN_CLOSE : TOKEN_END;
+    ctx->struct_closer = ids[(*i)++] == TOKEN_OPEN ? TOKEN_CLOSE : TOKEN_END;
     ctx->struct_closer_char = ctx->struct_closer == TOKEN_CLOSE ? ')' : '}';
 
     ast_field_map_init(out_field_map);
@@ -287,7 +289,7 @@ errorcode_t parse_composite_body(
         if(!AST_TYPE_IS_NONE(maybe_parent_class)){
             if(parse_composite_integrate_another(ctx, out_field_map, out_skeleton, &next_endpoint, &maybe_parent_class, true)) goto failure;
         } else {
-            ast_type_t vtable_ast_type = ast_type_make_base(strclone("ptr"));
+            ast_type_t vtable_ast_type = ast_type_make_base("ptr");
 
             ast_field_map_add(out_field_map, strclone("__vtable__"), next_endpoint);
             ast_layout_endpoint_increment(&next_endpoint);
@@ -297,9 +299,9 @@ errorcode_t parse_composite_body(
 
     if(parse_ignore_newlines(ctx, "Expected name of field")) return FAILURE;
 
-    while((tokens[*i].id != ctx->struct_closer && !parse_struct_is_function_like_beginning(tokens[*i].id)) || backfill != 0){
+    while((ids[*i] != ctx->struct_closer && !parse_struct_is_function_like_beginning(ids[*i])) || backfill != 0){
         // Be lenient with unnecessary preceding commas
-        if(tokens[*i].id == TOKEN_NEXT){
+        if(ids[*i] == TOKEN_NEXT){
             (*i)++;
         }
 
@@ -310,12 +312,12 @@ errorcode_t parse_composite_body(
         }
 
         // Handle whitespace
-        bool auto_comma = tokens[*i].id == TOKEN_NEWLINE;
+        bool auto_comma = ids[*i] == TOKEN_NEWLINE;
         if(parse_ignore_newlines(ctx, ctx->struct_closer_char == ')' ? "Expected ')' or ',' after field" : "Expected '}' or ',' after field")){
             goto failure;
         }
 
-        if(tokens[*i].id == TOKEN_NEXT){
+        if(ids[*i] == TOKEN_NEXT){
             // Handle ',' token 
             (*i)++;
 
@@ -324,19 +326,19 @@ errorcode_t parse_composite_body(
             }
 
             // Allow for unnecessary tailing comma when closing
-            tokenid_t ending = tokens[*i].id;
+            tokenid_t ending = ids[*i];
             if(ending == ctx->struct_closer || parse_struct_is_function_like_beginning(ending)){
                 break;
             }
-        } else if(tokens[*i].id != ctx->struct_closer && !parse_struct_is_function_like_beginning(tokens[*i].id) && !auto_comma){
+        } else if(ids[*i] != ctx->struct_closer && !parse_struct_is_function_like_beginning(ids[*i]) && !auto_comma){
             // Expect closing ')' unless auto comma activated
-            compiler_panic(ctx->compiler, sources[*i], "Expected ',' after field name and type");
+            compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Expected ',' after field name and type");
             goto failure;
         }
     }
 
     if(backfill != 0){
-        compiler_panicf(ctx->compiler, sources[*i], "Expected field type for last field");
+        compiler_panicf(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Expected field type for last field");
         return FAILURE;
     }
 
@@ -356,17 +358,16 @@ errorcode_t parse_composite_field(
     ast_layout_endpoint_t *inout_next_endpoint
 ){
     length_t *i = ctx->i;
-    token_t *tokens = ctx->tokenlist->tokens;
-    source_t *sources = ctx->tokenlist->sources;
+    tokenid_t *ids = ctx->tokenlist->ids;
 
-    const tokenid_t leading_token = tokens[*i].id;
+    const tokenid_t leading_token = ids[*i];
 
     // TODO: Cleanup condition
-    if(leading_token == TOKEN_STRUCT && tokens[*i + 1].id != TOKEN_OPEN && tokens[*i + 1].id != TOKEN_BRACKET_OPEN){
+    if(leading_token == TOKEN_STRUCT && ids[*i + 1] != TOKEN_OPEN && ids[*i + 1] != TOKEN_BRACKET_OPEN){
         // Struct Integration Field
 
         if(*inout_backfill != 0){
-            compiler_panicf(ctx->compiler, sources[*i], "Expected field type for previous fields before integrated struct");
+            compiler_panicf(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Expected field type for previous fields before integrated struct");
             return FAILURE;
         }
 
@@ -386,7 +387,7 @@ errorcode_t parse_composite_field(
 
         if(*inout_backfill != 0){
             const char *kind_name = leading_token == TOKEN_UNION ? "union" : "struct";
-            compiler_panicf(ctx->compiler, sources[*i], "Expected field type for previous fields before anonymous %s", kind_name);
+            compiler_panicf(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Expected field type for previous fields before anonymous %s", kind_name);
             return FAILURE;
         }
 
@@ -401,7 +402,7 @@ errorcode_t parse_composite_field(
     ast_field_map_add(inout_field_map, field_name, *inout_next_endpoint);
     ast_layout_endpoint_increment(inout_next_endpoint);
 
-    if(tokens[*i].id == TOKEN_NEXT || tokens[*i].id == TOKEN_NEWLINE){
+    if(ids[*i] == TOKEN_NEXT || ids[*i] == TOKEN_NEWLINE){
         // This field is part of a field list where all the fields have the same type,
         // and the type is specified at the end
         (*inout_backfill)++;
@@ -510,6 +511,11 @@ errorcode_t parse_composite_integrate_another(
         return FAILURE;
     }
 
+    // Integrated fields would become stale if the other file changed
+    if(composite->source.object_index != ctx->object->index){
+        parse_ctx_forbid_caching(ctx);
+    }
+
     ast_layout_t layout_storage;
     ast_layout_t *layout;
 
@@ -565,14 +571,13 @@ errorcode_t parse_anonymous_composite(
     //   ^
 
     length_t *i = ctx->i;
-    token_t *tokens = ctx->tokenlist->tokens;
-    source_t *sources = ctx->tokenlist->sources;
+    tokenid_t *ids = ctx->tokenlist->ids;
 
-    bool is_packed = tokens[*i].id == TOKEN_PACKED;
+    bool is_packed = ids[*i] == TOKEN_PACKED;
     if(is_packed) (*i)++;
 
     // Assumes either TOKEN_STRUCT or TOKEN_UNION
-    ast_layout_bone_kind_t bone_kind = tokens[*i].id == TOKEN_STRUCT ? AST_LAYOUT_BONE_KIND_STRUCT : AST_LAYOUT_BONE_KIND_UNION;
+    ast_layout_bone_kind_t bone_kind = ids[*i] == TOKEN_STRUCT ? AST_LAYOUT_BONE_KIND_STRUCT : AST_LAYOUT_BONE_KIND_UNION;
     (*i)++;
 
     trait_t bone_traits = is_packed ? AST_LAYOUT_BONE_PACKED : TRAIT_NONE;
@@ -580,7 +585,7 @@ errorcode_t parse_anonymous_composite(
     ast_layout_endpoint_t child_next_endpoint = *inout_next_endpoint;
 
     if(!ast_layout_endpoint_add_index(&child_next_endpoint, 0)){
-        compiler_panicf(ctx->compiler, sources[*i], "Maximum depth of anonymous composites exceeded - No more than %d are allowed", AST_LAYOUT_MAX_DEPTH);
+        compiler_panicf(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Maximum depth of anonymous composites exceeded - No more than %d are allowed", AST_LAYOUT_MAX_DEPTH);
         return FAILURE;
     }
 
@@ -591,26 +596,26 @@ errorcode_t parse_anonymous_composite(
         return FAILURE;
     }
 
-    while(tokens[*i].id != TOKEN_CLOSE || backfill != 0){
+    while(ids[*i] != TOKEN_CLOSE || backfill != 0){
         if(parse_ignore_newlines(ctx, "Expected name of field")
         || parse_composite_field(ctx, inout_field_map, child_skeleton, &backfill, &child_next_endpoint)
         || parse_ignore_newlines(ctx, "Expected ')' or ',' after field")){
             return FAILURE;
         }
 
-        if(tokens[*i].id == TOKEN_NEXT){
-            if(tokens[++(*i)].id == TOKEN_CLOSE){
-                compiler_panic(ctx->compiler, sources[*i], "Expected field name and type after ',' in field list");
+        if(ids[*i] == TOKEN_NEXT){
+            if(ids[++(*i)] == TOKEN_CLOSE){
+                compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Expected field name and type after ',' in field list");
                 return FAILURE;
             }
-        } else if(tokens[*i].id != TOKEN_CLOSE){
-            compiler_panic(ctx->compiler, sources[*i], "Expected ',' after field name and type");
+        } else if(ids[*i] != TOKEN_CLOSE){
+            compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Expected ',' after field name and type");
             return FAILURE;
         }
     }
 
     if(backfill != 0){
-        compiler_panicf(ctx->compiler, sources[*i], "Expected field type for last field");
+        compiler_panicf(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Expected field type for last field");
         return FAILURE;
     }
 
@@ -650,7 +655,7 @@ errorcode_t parse_create_record_constructor(parse_ctx_t *ctx, weak_cstr_t name,
     ast_func_t *func = &ast->funcs[ast_func_id];
 
     ast_func_create_template(ctx->compiler, func, &(ast_func_head_t){
-        .name = strclone(name),
+        .name = name,
         .source = NULL_SOURCE,
         .is_foreign = false,
         .is_entry = false,
@@ -665,9 +670,9 @@ errorcode_t parse_create_record_constructor(parse_ctx_t *ctx, weak_cstr_t name,
 
     // Figure out AST type to return for record
     if(generics){
-        func->return_type = ast_type_make_base_with_polymorphs(strclone(name), generics, generics_length);
+        func->return_type = ast_type_make_base_with_polymorphs(name, generics, generics_length);
     } else {
-        func->return_type = ast_type_make_base(strclone(name));
+        func->return_type = ast_type_make_base(name);
     }
 
     // Track whether or not all fields are primitive builtin types,
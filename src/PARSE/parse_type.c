@@ -7,6 +7,7 @@
 #include "AST/ast.h"
 #include "AST/ast_expr.h"
 #include "AST/ast_layout.h"
+#include "AST/ast_node_alloc.h"
 #include "AST/ast_type.h"
 #include "DRVR/compiler.h"
 #include "LEX/token.h"
@@ -31,20 +32,19 @@ errorcode_t parse_type(parse_ctx_t *ctx, ast_type_t *out_type){
     // 'out_type' is not guaranteed to be in the same state
 
     length_t *i = ctx->i;
-    token_t *tokens = ctx->tokenlist->tokens;
-    source_t *sources = ctx->tokenlist->sources;
+    tokenid_t *ids = ctx->tokenlist->ids;
     length_t start = *i;
 
     out_type->elements = NULL;
     out_type->elements_length = 0;
 
     length_t elements_capacity = 0;
-    tokenid_t id = tokens[*i].id;
+    tokenid_t id = ids[*i];
 
     if(ctx->compiler->traits & COMPILER_TYPE_COLON && id == TOKEN_COLON){
         // Skip over colon for experimental ": int" syntax
         start = ++(*i);
-        id = tokens[start].id;
+        id = ids[start];
     }
 
     while(id == TOKEN_MULTIPLY || id == TOKEN_GENERIC_INT || id == TOKEN_POLYCOUNT || id == TOKEN_BRACKET_OPEN){
@@ -52,16 +52,16 @@ errorcode_t parse_type(parse_ctx_t *ctx, ast_type_t *out_type){
 
         switch(id){
         case TOKEN_MULTIPLY: {
-                out_type->elements[out_type->elements_length++] = malloc_init(ast_elem_pointer_t, {
+                out_type->elements[out_type->elements_length++] = ast_node_alloc_init(ast_elem_pointer_t, {
                     .id = AST_ELEM_POINTER,
-                    .source = sources[*i],
+                    .source = tokenlist_source(ctx->tokenlist, *i),
                 });
-                id = tokens[++(*i)].id;
+                id = ids[++(*i)];
             }
             break;
         case TOKEN_GENERIC_INT: {
-                out_type->elements[out_type->elements_length++] = ast_elem_fixed_array_make(sources[*i], *((adept_generic_int*) tokens[*i].data));
-                id = tokens[++(*i)].id;
+                out_type->elements[out_type->elements_length++] = ast_elem_fixed_array_make(tokenlist_source(ctx->tokenlist, *i), *((adept_generic_int*) tokenlist_data(ctx->tokenlist, *i)));
+                id = ids[++(*i)];
             }
             break;
         case TOKEN_BRACKET_OPEN: {
@@ -71,24 +71,24 @@ errorcode_t parse_type(parse_ctx_t *ctx, ast_type_t *out_type){
                 ast_expr_t *length;
                 if(parse_expr(ctx, &length)) goto failure;
 
-                out_type->elements[out_type->elements_length++] = (ast_elem_t*) malloc_init(ast_elem_var_fixed_array_t, {
+                out_type->elements[out_type->elements_length++] = (ast_elem_t*) ast_node_alloc_init(ast_elem_var_fixed_array_t, {
                     .id = AST_ELEM_VAR_FIXED_ARRAY,
-                    .source = sources[*i],
+                    .source = tokenlist_source(ctx->tokenlist, *i),
                     .length = length,
                 });
 
                 if(parse_eat(ctx, TOKEN_BRACKET_CLOSE, "Expected ']' after size of fixed array in type")) goto failure;
-                id = tokens[*i].id;
+                id = ids[*i];
             }
             break;
         case TOKEN_POLYCOUNT: {
-                out_type->elements[out_type->elements_length++] = (ast_elem_t*) malloc_init(ast_elem_polycount_t, {
+                out_type->elements[out_type->elements_length++] = (ast_elem_t*) ast_node_alloc_init(ast_elem_polycount_t, {
                     .id = AST_ELEM_POLYCOUNT,
                     .name = parse_ctx_peek_data_take(ctx),
-                    .source = sources[*i],
+                    .source = tokenlist_source(ctx->tokenlist, *i),
                 });
 
-                id = tokens[++(*i)].id;
+                id = ids[++(*i)];
             }
             break;
         }
@@ -98,19 +98,15 @@ errorcode_t parse_type(parse_ctx_t *ctx, ast_type_t *out_type){
 
     switch(id){
     case TOKEN_WORD: {
-            out_type->elements[out_type->elements_length] = ast_elem_base_make(parse_ctx_peek_data_take(ctx), sources[*i]);
+            out_type->elements[out_type->elements_length] = ast_elem_base_make(parse_ctx_peek_data(ctx), tokenlist_source(ctx->tokenlist, *i));
             *i += 1;
         }
         break;
     case TOKEN_FUNC: case TOKEN_STDCALL: {
-            ast_elem_func_t *func_elem = malloc(sizeof(ast_elem_func_t));
+            ast_elem_func_t func_elem;
+            if(parse_type_func(ctx, &func_elem)) goto failure;
 
-            if(parse_type_func(ctx, func_elem)){
-                free(func_elem);
-                goto failure;
-            }
-
-            out_type->elements[out_type->elements_length] = (ast_elem_t*) func_elem;
+            out_type->elements[out_type->elements_length] = ast_node_memclone(&func_elem, sizeof func_elem);
         }
         break;
     case TOKEN_PACKED: case TOKEN_STRUCT: case TOKEN_UNION: {
@@ -132,9 +128,9 @@ errorcode_t parse_type(parse_ctx_t *ctx, ast_type_t *out_type){
             // Pass over closing ')'
             (*i)++;
             
-            ast_elem_layout_t *layout_elem = malloc(sizeof(ast_elem_layout_t));
+            ast_elem_layout_t *layout_elem = ast_node_alloc(sizeof(ast_elem_layout_t));
             layout_elem->id = AST_ELEM_LAYOUT;
-            layout_elem->source = sources[*i];
+            layout_elem->source = tokenlist_source(ctx->tokenlist, *i);
             ast_layout_init(&layout_elem->layout, layout_kind, field_map, skeleton, traits);
 
             out_type->elements[out_type->elements_length] = (ast_elem_t*) layout_elem;
@@ -142,7 +138,7 @@ errorcode_t parse_type(parse_ctx_t *ctx, ast_type_t *out_type){
         break;
     case TOKEN_POLYMORPH: {
             strong_cstr_t name = parse_ctx_peek_data_take(ctx);
-            source_t source = sources[(*i)++];
+            source_t source = tokenlist_source(ctx->tokenlist, (*i)++);
             bool allow_auto_conversion = false;
 
             maybe_null_strong_cstr_t similar = NULL;
@@ -157,7 +153,7 @@ errorcode_t parse_type(parse_ctx_t *ctx, ast_type_t *out_type){
             if(parse_eat(ctx, TOKEN_BIT_COMPLEMENT, NULL) == SUCCESS){
                 if(!ctx->allow_polymorphic_prereqs){
                     free(name);
-                    compiler_panicf(ctx->compiler, sources[*i], "Polymorphic prerequisites are not allowed here");
+                    compiler_panicf(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Polymorphic prerequisites are not allowed here");
                     goto failure;
                 }
 
@@ -196,7 +192,7 @@ errorcode_t parse_type(parse_ctx_t *ctx, ast_type_t *out_type){
             length_t generics_length = 0;
             length_t generics_capacity = 0;
             
-            while(tokens[*i].id != TOKEN_GREATERTHAN){
+            while(ids[*i] != TOKEN_GREATERTHAN){
                 expand((void**) &generics, sizeof(ast_type_t), generics_length, &generics_capacity, 1, 4);
 
                 if(parse_ignore_newlines(ctx, "Expected type in polymorphic generics")){
@@ -216,35 +212,35 @@ errorcode_t parse_type(parse_ctx_t *ctx, ast_type_t *out_type){
                     goto failure;
                 }
 
-                if(tokens[*i].id == TOKEN_NEXT){
-                    if(tokens[++(*i)].id == TOKEN_GREATERTHAN){
-                        compiler_panic(ctx->compiler, ctx->tokenlist->sources[*i], "Expected type after ',' in polymorphic generics");
+                if(ids[*i] == TOKEN_NEXT){
+                    if(ids[++(*i)] == TOKEN_GREATERTHAN){
+                        compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Expected type after ',' in polymorphic generics");
                         ast_types_free_fully(generics, generics_length);
                         goto failure;
                     }
-                } else if(tokens[*i].id != TOKEN_GREATERTHAN){
-                    compiler_panic(ctx->compiler, ctx->tokenlist->sources[*i], "Expected ',' after type in polymorphic generics");
+                } else if(ids[*i] != TOKEN_GREATERTHAN){
+                    compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Expected ',' after type in polymorphic generics");
                     ast_types_free_fully(generics, generics_length);
                     goto failure;
                 }
             }
 
-            strong_cstr_t base_name;
+            weak_cstr_t base_name;
             if(
                 parse_eat(ctx, TOKEN_GREATERTHAN, "Expected '>' after polymorphic generics")
-                || (base_name = parse_take_word(ctx, "Expected type name")) == NULL
+                || (base_name = parse_eat_word(ctx, "Expected type name")) == NULL
             ){
                 ast_types_free_fully(generics, generics_length);
                 goto failure;
             }
 
-            out_type->elements[out_type->elements_length] = ast_elem_generic_base_make(base_name, sources[*i - 1], generics, generics_length);
+            out_type->elements[out_type->elements_length] = ast_elem_generic_base_make(base_name, tokenlist_source(ctx->tokenlist, *i - 1), generics, generics_length);
         }
         break;
     case TOKEN_ENUM: {
             weak_cstr_t *raw_kinds;
             length_t raw_kinds_length;
-            source_t source = sources[(*i)++];
+            source_t source = tokenlist_source(ctx->tokenlist, (*i)++);
 
             if(parse_enum_body(ctx, &raw_kinds, &raw_kinds_length)){
                 return FAILURE;
@@ -272,21 +268,21 @@ errorcode_t parse_type(parse_ctx_t *ctx, ast_type_t *out_type){
                 return FAILURE;
             }
 
-            out_type->elements[out_type->elements_length] = (ast_elem_t*) malloc_init(ast_elem_anonymous_enum_t, {
+            out_type->elements[out_type->elements_length] = (ast_elem_t*) ast_node_alloc_init(ast_elem_anonymous_enum_t, {
                 .id = AST_ELEM_ANONYMOUS_ENUM,
                 .source = source,
                 .kinds = kinds,
             });
 
-            id = tokens[++(*i)].id;
+            id = ids[++(*i)];
         }
         break;
     default:
-        compiler_panic(ctx->compiler, sources[start], "Expected type");
+        compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, start), "Expected type");
         goto failure;
     }
 
-    out_type->source = sources[start];
+    out_type->source = tokenlist_source(ctx->tokenlist, start);
     out_type->elements_length++;
     return SUCCESS;
 
@@ -302,12 +298,11 @@ errorcode_t parse_type_func(parse_ctx_t *ctx, ast_elem_func_t *out_func_elem){
     //  ^
 
     length_t *i = ctx->i;
-    token_t *tokens = ctx->tokenlist->tokens;
-    source_t *sources = ctx->tokenlist->sources;
+    tokenid_t *ids = ctx->tokenlist->ids;
 
     *out_func_elem = (ast_elem_func_t){
         .id = AST_ELEM_FUNC,
-        .source = sources[*i],
+        .source = tokenlist_source(ctx->tokenlist, *i),
         .arg_types = NULL,
         .arity = 0,
         .return_type = NULL,
@@ -325,16 +320,16 @@ errorcode_t parse_type_func(parse_ctx_t *ctx, ast_elem_func_t *out_func_elem){
     if(parse_eat(ctx, TOKEN_FUNC, "Expected 'func' keyword in function type")) goto failure;
     if(parse_eat(ctx, TOKEN_OPEN, "Expected '(' after 'func' keyword in type")) goto failure;
 
-    while(tokens[*i].id != TOKEN_CLOSE){
+    while(ids[*i] != TOKEN_CLOSE){
         if(is_vararg){
-            compiler_panic(ctx->compiler, sources[*i], "Expected ')' after variadic argument");
+            compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Expected ')' after variadic argument");
             goto failure;
         }
 
         expand((void**) &out_func_elem->arg_types, sizeof(ast_type_t), out_func_elem->arity, &args_capacity, 1, 4);
 
         // Ignore argument flow
-        switch(tokens[*i].id){
+        switch(ids[*i]){
         case TOKEN_IN:    (*i)++; break;
         case TOKEN_OUT:   (*i)++; break;
         case TOKEN_INOUT: (*i)++; break;
@@ -349,17 +344,17 @@ errorcode_t parse_type_func(parse_ctx_t *ctx, ast_elem_func_t *out_func_elem){
             out_func_elem->arity++;
         }
 
-        if(tokens[*i].id == TOKEN_NEXT){
-            if(tokens[++(*i)].id == TOKEN_CLOSE){
-                compiler_panic(ctx->compiler, sources[*i], "Expected type after ',' in argument list");
+        if(ids[*i] == TOKEN_NEXT){
+            if(ids[++(*i)] == TOKEN_CLOSE){
+                compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Expected type after ',' in argument list");
                 ast_types_free_fully(out_func_elem->arg_types, out_func_elem->arity);
                 return FAILURE;
             }
-        } else if(tokens[*i].id != TOKEN_CLOSE){
+        } else if(ids[*i] != TOKEN_CLOSE){
             if(is_vararg){
-                compiler_panic(ctx->compiler, sources[*i], "Expected ')' after variadic argument");
+                compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Expected ')' after variadic argument");
             } else {
-                compiler_panic(ctx->compiler, sources[*i], "Expected ',' after argument type");
+                compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i), "Expected ',' after argument type");
             }
             goto failure;
         }
@@ -4,7 +4,6 @@
 
 #include "DRVR/compiler.h"
 #include "DRVR/object.h"
-#include "LEX/lex.h"
 #include "LEX/token.h"
 #include "PARSE/parse_ctx.h"
 #include "PARSE/parse_util.h"
@@ -15,11 +14,11 @@
 
 errorcode_t parse_ignore_newlines(parse_ctx_t *ctx, const char *error_message){
     length_t *i = ctx->i;
-    token_t *tokens = ctx->tokenlist->tokens;
+    tokenid_t *ids = ctx->tokenlist->ids;
     length_t length = ctx->tokenlist->length;
 
-    while(tokens[*i].id == TOKEN_NEWLINE) if(length == ++(*i)){
-        if(error_message) compiler_panic(ctx->compiler, ctx->tokenlist->sources[*i - 1], error_message);
+    while(ids[*i] == TOKEN_NEWLINE) if(length == ++(*i)){
+        if(error_message) compiler_panic(ctx->compiler, tokenlist_source(ctx->tokenlist, *i - 1), error_message);
         return FAILURE;
     }
 
@@ -35,7 +34,7 @@ void parse_panic_token(parse_ctx_t *ctx, source_t source, unsigned int token_id,
     if(ctx->object->traits & OBJECT_PACKAGE){
         printf("%s: ", filename_name_const(ctx->object->filename));
     } else {
-        lex_get_location(ctx->object->buffer, source.index, &line, &column);
+        object_get_location(ctx->object, source.index, &line, &column);
         printf("%s:%d:%d: ", filename_name_const(ctx->object->filename), line, column);
     }
 
@@ -231,3 +231,42 @@ const char *global_token_keywords_list[] = {
 };
 
 unsigned long long global_token_keywords_list_length = 73;
+
+const unsigned char global_token_keywords_hash_associated_values[] = {
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,  24,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,  56,
+     75,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,  93,  18,  77,  43,  51, 109,  63,  35, 122,   0,  64,  37, 117,  38,  63,
+     46,   0, 101, 113,  69,  80,  62,  73,  56,  67,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+};
+
+// Keyword index + 1 for each hash slot (or 0 if no keyword has that hash)
+const unsigned char global_token_keywords_hash_table[] = {
+     21,  15,   0,  54,  20,   0,   0,  55,   0,   0,   0,  22,  40,   0,  25,   0,
+      0,   0,  48,  68,   0,   0,   0,  14,  30,   8,  65,  62,   0,  53,   5,  36,
+      0,   0,  23,   0,   0,   0,   0,  44,   0,  52,   0,  66,   0,   0,  50,   0,
+     57,  59,   0,   0,  31,   3,  35,  27,  39,   0,  38,  13,  60,  18,  61,   0,
+     51,  72,  37,   0,  42,  67,   7,  12,   0,  73,  43,  49,   0,  70,  56,  16,
+     34,   0,   9,  29,   0,   2,   1,   4,  41,  11,   0,   0,  19,   0,  64,   0,
+     63,   0,   0,  45,  10,   0,  24,   0,  71,   0,   0,  47,  33,   0,  32,  46,
+      0,   0,  69,  28,   0,  26,  58,   0,   0,   0,   0,  17,   0,   0,   6,   0,
+};
+
+const unsigned char global_token_keywords_length_list[] = {
+     3,  5,  7,  3,  2,  6,  2,  5,  4,  4,  5,  5, 11,  8,  3,  7,
+     5,  6,  6,  4,  4,  5,  4, 10,  7,  8, 11,  5,  3,  7,  4,  7,
+     6,  2,  8,  6,  2,  5,  8,  9,  3,  4,  2,  3,  8,  6,  6,  7,
+     6,  6,  6,  6,  6,  6,  7,  6,  6, 12,  4,  8, 10,  5,  5,  6,
+     5,  5,  6,  7,  6,  8,  8,  7,  5,
+};
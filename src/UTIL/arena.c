@@ -0,0 +1,80 @@
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "UTIL/arena.h"
+#include "UTIL/ground.h"
+#include "UTIL/util.h"
+
+#define ARENA_DEFAULT_CHUNK_SIZE 4096
+#define ARENA_MAX_ALIGNMENT _Alignof(max_align_t)
+
+// Chunk headers are padded so that chunk data always starts at maximum alignment
+#define ARENA_CHUNK_HEADER_SIZE ((sizeof(arena_chunk_t) + ARENA_MAX_ALIGNMENT - 1) & ~(ARENA_MAX_ALIGNMENT - 1))
+
+static inline char *arena_chunk_data(arena_chunk_t *chunk){
+    return (char*) chunk + ARENA_CHUNK_HEADER_SIZE;
+}
+
+void arena_init(arena_t *arena, length_t chunk_size){
+    *arena = (arena_t){
+        .head = NULL,
+        .chunk_size = chunk_size,
+    };
+}
+
+void *arena_alloc(arena_t *arena, length_t size, length_t alignment){
+    arena_chunk_t *head = arena->head;
+
+    if(head){
+        length_t position = (head->used + alignment - 1) & ~(alignment - 1);
+
+        if(position + size <= head->capacity){
+            head->used = position + size;
+            return arena_chunk_data(head) + position;
+        }
+    }
+
+    // Chunk data is maximally aligned, so new chunks don't need any padding
+    length_t chunk_size = arena->chunk_size ? arena->chunk_size : ARENA_DEFAULT_CHUNK_SIZE;
+    length_t capacity = length_max(chunk_size, size);
+
+    arena_chunk_t *chunk = malloc(ARENA_CHUNK_HEADER_SIZE + capacity);
+    chunk->prev = head;
+    chunk->used = size;
+    chunk->capacity = capacity;
+
+    // Keep allocating from the current chunk if the new one is only for a single large allocation
+    if(head && capacity == size){
+        chunk->prev = head->prev;
+        head->prev = chunk;
+        return arena_chunk_data(chunk);
+    }
+
+    arena->head = chunk;
+    return arena_chunk_data(chunk);
+}
+
+void *arena_memclone(arena_t *arena, const void *data, length_t size){
+    return memcpy(arena_alloc(arena, size, ARENA_MAX_ALIGNMENT), data, size);
+}
+
+char *arena_strndup(arena_t *arena, const char *string, length_t length){
+    char *result = arena_alloc(arena, length + 1, 1);
+    memcpy(result, string, length);
+    result[length] = '\0';
+    return result;
+}
+
+void arena_free(arena_t *arena){
+    arena_chunk_t *chunk = arena->head;
+
+    while(chunk){
+        arena_chunk_t *prev = chunk->prev;
+        free(chunk);
+        chunk = prev;
+    }
+
+    arena->head = NULL;
+}
@@ -274,6 +274,11 @@ void filename_append_if_missing(strong_cstr_t *out_filename, const char *additio
     }
 }
 
+bool filename_is_package(const char *filename){
+    length_t length = strlen(filename);
+    return length >= 4 && streq(&filename[length - 4], ".dep");
+}
+
 strong_cstr_t filename_without_ext(char *filename){
 	length_t i;
     length_t filename_length = strlen(filename);
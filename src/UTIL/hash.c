@@ -1,13 +1,53 @@
+#include <stdint.h>
+#include <string.h>
 
 #include "UTIL/ground.h"
 #include "UTIL/hash.h"
 
+// Primes from xxHash64
+#define HASH_PRIME_1 0x9E3779B185EBCA87ULL
+#define HASH_PRIME_2 0xC2B2AE3D27D4EB4FULL
+#define HASH_PRIME_3 0x165667B19E3779F9ULL
+
+static inline uint64_t hash_rotl(uint64_t x, int bits){
+    return (x << bits) | (x >> (64 - bits));
+}
+
+static inline uint64_t hash_round(uint64_t hash, uint64_t word){
+    return hash_rotl(hash ^ (word * HASH_PRIME_2), 31) * HASH_PRIME_1;
+}
+
+static inline uint64_t hash_avalanche(uint64_t hash){
+    // Makes every bit of the input affect every bit of the output
+    hash ^= hash >> 33;
+    hash *= HASH_PRIME_2;
+    hash ^= hash >> 29;
+    hash *= HASH_PRIME_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
 hash_t hash_data(const void *data, length_t size){
-    hash_t hash = 0;
-    for(length_t i = 0; i != size; i++){
-        hash = (hash * 31) + (hash_t)((char*) data)[i];
+    const unsigned char *bytes = data;
+    uint64_t hash = HASH_PRIME_3 ^ ((uint64_t) size * HASH_PRIME_1);
+
+    // Hash eight bytes at a time
+    while(size >= 8){
+        uint64_t word;
+        memcpy(&word, bytes, 8);
+        hash = hash_round(hash, word);
+        bytes += 8;
+        size -= 8;
     }
-    return hash;
+
+    // Hash any remaining bytes as a final partial word
+    if(size != 0){
+        uint64_t word = 0;
+        memcpy(&word, bytes, size);
+        hash = hash_round(hash, word);
+    }
+
+    return (hash_t) hash_avalanche(hash);
 }
 
 hash_t hash_string(const char *s){
@@ -26,10 +66,11 @@ hash_t hash_strings(char *strings[], length_t num_strings){
     return hash;
 }
 
+hash_t hash_pointer(const void *pointer){
+    return (hash_t) hash_avalanche((uint64_t) (uintptr_t) pointer);
+}
+
 hash_t hash_combine(hash_t h1, hash_t h2){
-    hash_t hash = h1;
-    for(length_t i = 0; i != sizeof(h2); i++){
-        hash = (hash * 31) + (hash_t)((char*) &h2)[i];
-    }
-    return hash;
+    // Order matters, so 'h1' and 'h2' are mixed differently
+    return (hash_t) hash_avalanche((uint64_t) h1 * HASH_PRIME_1 + hash_rotl((uint64_t) h2, 27) + HASH_PRIME_3);
 }
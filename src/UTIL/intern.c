@@ -0,0 +1,58 @@
+
+#include <string.h>
+
+#include "UTIL/arena.h"
+#include "UTIL/ground.h"
+#include "UTIL/hash.h"
+#include "UTIL/intern.h"
+#include "UTIL/set.h"
+#include "UTIL/threads.h"
+#include "UTIL/util.h"
+
+static intern_table_t intern_names;
+static adept_mutex_t intern_names_lock = ADEPT_MUTEX_INITIALIZER;
+
+static hash_t intern_hash(const void *string){
+    return hash_string(string);
+}
+
+static bool intern_equals(const void *a, const void *b){
+    return streq(a, b);
+}
+
+void intern_table_free(intern_table_t *table){
+    set_free(&table->atoms, NULL);
+    arena_free(&table->strings);
+}
+
+weak_cstr_t intern(intern_table_t *table, const char *string){
+    if(table->atoms.capacity == 0){
+        set_init(&table->atoms, 0, &intern_hash, &intern_equals, NULL);
+    }
+
+    hash_t hash = hash_string(string);
+    weak_cstr_t atom = set_find_hashed(&table->atoms, string, hash);
+    if(atom) return atom;
+
+    atom = arena_strndup(&table->strings, string, strlen(string));
+    set_insert_hashed(&table->atoms, atom, hash);
+    return atom;
+}
+
+maybe_null_weak_cstr_t intern_find(intern_table_t *table, const char *string){
+    return set_find(&table->atoms, string);
+}
+
+weak_cstr_t intern_name(const char *name){
+    adept_mutex_lock(&intern_names_lock);
+    weak_cstr_t atom = intern(&intern_names, name);
+    adept_mutex_unlock(&intern_names_lock);
+    return atom;
+}
+
+maybe_null_weak_cstr_t intern_name_find(const char *name){
+    adept_mutex_lock(&intern_names_lock);
+    maybe_null_weak_cstr_t atom = intern_find(&intern_names, name);
+    adept_mutex_unlock(&intern_names_lock);
+    return atom;
+}
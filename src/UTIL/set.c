@@ -1,6 +1,41 @@
 
 #include "UTIL/set.h"
 
+static set_entry_t *set_slot(const set_t *set, const void *item, hash_t hash){
+    // Returns the entry that holds 'item', or the empty entry where it would be placed
+    length_t mask = set->capacity - 1;
+
+    for(length_t i = hash & mask; true; i = (i + 1) & mask){
+        set_entry_t *entry = &set->entries[i];
+
+        if(entry->data == NULL || (entry->hash == hash && (*set->equals_func)(entry->data, item))){
+            return entry;
+        }
+    }
+}
+
+static void set_grow(set_t *set, length_t new_capacity){
+    set_entry_t *old_entries = set->entries;
+    length_t old_capacity = set->capacity;
+
+    set->entries = calloc(new_capacity, sizeof(set_entry_t));
+    set->capacity = new_capacity;
+
+    // Hashes are cached, so items don't need to be hashed again
+    for(length_t i = 0; i != old_capacity; i++){
+        set_entry_t *old_entry = &old_entries[i];
+        if(old_entry->data == NULL) continue;
+
+        length_t mask = new_capacity - 1;
+        length_t j = old_entry->hash & mask;
+
+        while(set->entries[j].data) j = (j + 1) & mask;
+        set->entries[j] = *old_entry;
+    }
+
+    free(old_entries);
+}
+
 void set_init(
     set_t *set,
     length_t starting_capacity,
@@ -8,9 +43,12 @@ void set_init(
     set_equals_func_t equals_func,
     set_preinsert_clone_func_t optional_preinsert_clone_func
 ){
+    length_t capacity = 16;
+    while(capacity / 4 * 3 < starting_capacity) capacity *= 2;
+
     *set = (set_t){
-        .entries = calloc(starting_capacity, sizeof(set_entry_t)),
-        .capacity = starting_capacity,
+        .entries = calloc(capacity, sizeof(set_entry_t)),
+        .capacity = capacity,
         .count = 0,
         .hash_func = hash_func,
         .equals_func = equals_func,
@@ -23,80 +61,85 @@ void set_free(set_t *set, set_free_item_func_t optional_free_func){
         set_traverse(set, optional_free_func);
     }
 
-    for(length_t i = 0; i != set->capacity; i++){
-        set_entry_t *entry = set->entries[i];
-
-        while(entry){
-            set_entry_t *next = entry->next;
-            free(entry);
-            entry = next;
-        }
-    }
+    free(set->entries);
+    *set = (set_t){0};
 }
 
 bool set_insert(set_t *set, void *item){
-    hash_t hash = (*set->hash_func)((const void*) item);
-    set_entry_t **slot = &set->entries[hash % set->capacity];
-
-    if(*slot == NULL){
-        *slot = malloc_init(set_entry_t, {
-            .data = set->optional_preinsert_clone_func ? (*set->optional_preinsert_clone_func)((const void*) item) : item,
-            .next = NULL,
-        });
-    } else {
-        set_entry_t *entry = *slot, *prev;
-
-        while(entry){
-            if((*set->equals_func)(entry->data, item)){
-                return false;
-            }
-
-            prev = entry;
-            entry = entry->next;
-        }
+    return set_insert_hashed(set, item, (*set->hash_func)((const void*) item));
+}
+
+bool set_insert_hashed(set_t *set, void *item, hash_t hash){
+    set_entry_t *entry = set_slot(set, item, hash);
+
+    if(entry->data != NULL){
+        return false;
+    }
+
+    *entry = (set_entry_t){
+        .data = set->optional_preinsert_clone_func ? (*set->optional_preinsert_clone_func)((const void*) item) : item,
+        .hash = hash,
+    };
 
-        prev->next = malloc_init(set_entry_t, {
-            .data = set->optional_preinsert_clone_func ? (*set->optional_preinsert_clone_func)((const void*) item) : item,
-            .next = NULL,
-        });
+    // Keep the load factor at or below 3/4
+    if(++set->count > set->capacity / 4 * 3){
+        set_grow(set, set->capacity * 2);
     }
 
-    set->count++;
     return true;
 }
 
+void *set_find(const set_t *set, const void *item){
+    if(set->count == 0) return NULL;
+    return set_slot(set, item, (*set->hash_func)(item))->data;
+}
+
+void *set_find_hashed(const set_t *set, const void *item, hash_t hash){
+    if(set->count == 0) return NULL;
+    return set_slot(set, item, hash)->data;
+}
+
+bool set_contains(const set_t *set, const void *item){
+    return set_find(set, item) != NULL;
+}
+
 void set_traverse(set_t *set, set_traverse_func_t run_func){
     for(length_t i = 0; i != set->capacity; i++){
-        set_entry_t *entry = set->entries[i];
+        set_entry_t *entry = &set->entries[i];
 
-        while(entry){
+        if(entry->data){
             (*run_func)(entry->data);
-            entry = entry->next;
         }
     }
 }
 
 void set_collect(set_t *set, set_collect_func_t collect_func, void *user_pointer){
     for(length_t i = 0; i != set->capacity; i++){
-        set_entry_t *entry = set->entries[i];
+        set_entry_t *entry = &set->entries[i];
 
-        while(entry){
+        if(entry->data){
             (*collect_func)(entry->data, user_pointer);
-            entry = entry->next;
         }
     }
 }
 
 void set_print_statistics(set_t *set){
-    length_t buckets_used = 0;
+    length_t mask = set->capacity - 1;
+    length_t total_probe_length = 0;
+    length_t longest_probe_length = 0;
 
     for(length_t i = 0; i != set->capacity; i++){
-        set_entry_t *entry = set->entries[i];
+        set_entry_t *entry = &set->entries[i];
+        if(entry->data == NULL) continue;
 
-        if(entry){
-            buckets_used++;
-        }
+        // Number of slots visited to find this item
+        length_t probe_length = ((i - (entry->hash & mask)) & mask) + 1;
+        total_probe_length += probe_length;
+        if(probe_length > longest_probe_length) longest_probe_length = probe_length;
     }
 
-    printf("[set statistics : %d items, %d / %d buckets, alpha=%f]\n", (int) set->count, (int) buckets_used, (int) set->capacity, (double) set->count / (double) set->capacity);
+    double average_probe_length = set->count ? (double) total_probe_length / (double) set->count : 0.0;
+
+    printf("[set statistics : %d items, %d slots, alpha=%f, average probe=%f, longest probe=%d]\n",
+        (int) set->count, (int) set->capacity, (double) set->count / (double) set->capacity, average_probe_length, (int) longest_probe_length);
 }
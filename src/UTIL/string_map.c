@@ -0,0 +1,54 @@
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "UTIL/arena.h"
+#include "UTIL/ground.h"
+#include "UTIL/hash.h"
+#include "UTIL/set.h"
+#include "UTIL/string_map.h"
+#include "UTIL/util.h"
+
+static hash_t string_map_hash(const void *entry){
+    return hash_string(((const string_map_entry_t*) entry)->key);
+}
+
+static bool string_map_equals(const void *a, const void *b){
+    return streq(((const string_map_entry_t*) a)->key, ((const string_map_entry_t*) b)->key);
+}
+
+void string_map_init(string_map_t *map, length_t starting_capacity){
+    *map = (string_map_t){0};
+    set_init(&map->impl, starting_capacity, &string_map_hash, &string_map_equals, NULL);
+}
+
+void string_map_free(string_map_t *map){
+    set_free(&map->impl, NULL);
+    arena_free(&map->entries);
+}
+
+void *string_map_find(string_map_t *map, const char *key){
+    string_map_entry_t *entry = set_find(&map->impl, &(string_map_entry_t){ .key = (weak_cstr_t) key });
+    return entry ? entry->value : NULL;
+}
+
+bool string_map_has(string_map_t *map, const char *key){
+    return set_contains(&map->impl, &(string_map_entry_t){ .key = (weak_cstr_t) key });
+}
+
+bool string_map_insert(string_map_t *map, weak_cstr_t key, void *value){
+    if(map->impl.capacity == 0){
+        set_init(&map->impl, 0, &string_map_hash, &string_map_equals, NULL);
+    }
+
+    string_map_entry_t probe = (string_map_entry_t){
+        .key = key,
+        .value = value,
+    };
+
+    hash_t hash = string_map_hash(&probe);
+    if(set_find_hashed(&map->impl, &probe, hash)) return false;
+
+    set_insert_hashed(&map->impl, arena_memclone(&map->entries, &probe, sizeof probe), hash);
+    return true;
+}
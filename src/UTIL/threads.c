@@ -0,0 +1,140 @@
+
+#include <stdlib.h>
+
+#include "UTIL/ground.h"
+#include "UTIL/threads.h"
+#include "UTIL/util.h"
+
+#if !defined(ADEPT_NO_THREADS) && !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+typedef struct {
+    adept_mutex_t lock;
+    length_t next;
+    length_t count;
+    parallel_task_func_t task;
+    void *user_data;
+} parallel_for_ctx_t;
+
+#if defined(ADEPT_NO_THREADS)
+
+void adept_mutex_init(adept_mutex_t *mutex){ (void) mutex; }
+void adept_mutex_lock(adept_mutex_t *mutex){ (void) mutex; }
+void adept_mutex_unlock(adept_mutex_t *mutex){ (void) mutex; }
+void adept_mutex_destroy(adept_mutex_t *mutex){ (void) mutex; }
+
+#elif defined(_WIN32)
+
+void adept_mutex_init(adept_mutex_t *mutex){ InitializeSRWLock(mutex); }
+void adept_mutex_lock(adept_mutex_t *mutex){ AcquireSRWLockExclusive(mutex); }
+void adept_mutex_unlock(adept_mutex_t *mutex){ ReleaseSRWLockExclusive(mutex); }
+void adept_mutex_destroy(adept_mutex_t *mutex){ (void) mutex; }
+
+#else
+
+void adept_mutex_init(adept_mutex_t *mutex){ pthread_mutex_init(mutex, NULL); }
+void adept_mutex_lock(adept_mutex_t *mutex){ pthread_mutex_lock(mutex); }
+void adept_mutex_unlock(adept_mutex_t *mutex){ pthread_mutex_unlock(mutex); }
+void adept_mutex_destroy(adept_mutex_t *mutex){ pthread_mutex_destroy(mutex); }
+
+#endif
+
+static void parallel_for_worker(parallel_for_ctx_t *ctx){
+    while(true){
+        adept_mutex_lock(&ctx->lock);
+        length_t task_index = ctx->next++;
+        adept_mutex_unlock(&ctx->lock);
+
+        if(task_index >= ctx->count) return;
+        ctx->task(task_index, ctx->user_data);
+    }
+}
+
+#if !defined(ADEPT_NO_THREADS)
+#ifdef _WIN32
+static DWORD WINAPI parallel_for_thread_entry(LPVOID ctx){
+    parallel_for_worker((parallel_for_ctx_t*) ctx);
+    return 0;
+}
+#else
+static void *parallel_for_thread_entry(void *ctx){
+    parallel_for_worker((parallel_for_ctx_t*) ctx);
+    return NULL;
+}
+#endif
+#endif
+
+void parallel_for(length_t count, length_t num_threads, parallel_task_func_t task, void *user_data){
+    parallel_for_ctx_t ctx = {
+        .next = 0,
+        .count = count,
+        .task = task,
+        .user_data = user_data,
+    };
+
+    adept_mutex_init(&ctx.lock);
+
+    #if defined(ADEPT_NO_THREADS)
+    length_t num_helpers = 0;
+    (void) num_threads;
+    #else
+    // The calling thread does work too, so only spawn helpers for the remainder
+    length_t num_helpers = length_min(num_threads, count);
+    num_helpers = num_helpers > 1 ? num_helpers - 1 : 0;
+    #endif
+
+    #if defined(_WIN32) && !defined(ADEPT_NO_THREADS)
+    HANDLE *helpers = num_helpers ? malloc(sizeof(HANDLE) * num_helpers) : NULL;
+    length_t num_spawned = 0;
+
+    for(length_t i = 0; i != num_helpers; i++){
+        HANDLE handle = CreateThread(NULL, 0, parallel_for_thread_entry, &ctx, 0, NULL);
+        if(handle == NULL) break;
+        helpers[num_spawned++] = handle;
+    }
+
+    parallel_for_worker(&ctx);
+
+    for(length_t i = 0; i != num_spawned; i++){
+        WaitForSingleObject(helpers[i], INFINITE);
+        CloseHandle(helpers[i]);
+    }
+
+    free(helpers);
+    #elif !defined(ADEPT_NO_THREADS)
+    pthread_t *helpers = num_helpers ? malloc(sizeof(pthread_t) * num_helpers) : NULL;
+    length_t num_spawned = 0;
+
+    for(length_t i = 0; i != num_helpers; i++){
+        // If we fail to create a thread, the remaining threads will pick up the slack
+        if(pthread_create(&helpers[num_spawned], NULL, parallel_for_thread_entry, &ctx) != 0) break;
+        num_spawned++;
+    }
+
+    parallel_for_worker(&ctx);
+
+    for(length_t i = 0; i != num_spawned; i++){
+        pthread_join(helpers[i], NULL);
+    }
+
+    free(helpers);
+    #else
+    parallel_for_worker(&ctx);
+    #endif
+
+    adept_mutex_destroy(&ctx.lock);
+}
+
+length_t threads_available(void){
+    #if defined(ADEPT_NO_THREADS)
+    return 1;
+    #elif defined(_WIN32)
+    SYSTEM_INFO system_info;
+    GetSystemInfo(&system_info);
+    return system_info.dwNumberOfProcessors ? system_info.dwNumberOfProcessors : 1;
+    #else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (length_t) count : 1;
+    #endif
+}
@@ -13,6 +13,19 @@
 #include "UTIL/ground.h"
 #include "UTIL/util.h"
 
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ADEPT_CAN_MAP_FILES 1
+#else
+#define ADEPT_CAN_MAP_FILES 0
+#endif
+
+// Files smaller than this are read instead of memory-mapped
+#define FILE_MAPPING_THRESHOLD (16 * 1024)
+
 void expand(void **inout_memory, length_t unit_size, length_t length, length_t *inout_capacity, length_t amount, length_t default_capacity){
     // Expands an array in memory to be able to fit more units
 
@@ -185,6 +198,67 @@ bool file_text_contents(weak_cstr_t filename, strong_cstr_t *out_contents, lengt
     return true;
 }
 
+bool file_text_contents_mapped(weak_cstr_t filename, char **out_contents, length_t *out_length, length_t *out_mapping_size){
+    *out_mapping_size = 0;
+
+    #if ADEPT_CAN_MAP_FILES
+    int fd = open(filename, O_RDONLY);
+    if(fd < 0) return false;
+
+    struct stat file_stat;
+
+    // Small files are cheaper to just read
+    if(fstat(fd, &file_stat) != 0 || !S_ISREG(file_stat.st_mode) || file_stat.st_size < FILE_MAPPING_THRESHOLD){
+        close(fd);
+        return file_text_contents(filename, out_contents, out_length, true);
+    }
+
+    length_t size = file_stat.st_size;
+    length_t page_size = sysconf(_SC_PAGESIZE);
+    length_t mapping_size = (size + 2 + page_size - 1) / page_size * page_size;
+
+    // Reserve enough zeroed memory to hold the file and the '\n\0' terminator,
+    // and then map the file over the beginning of it. The tail is private, so it can be written to.
+    char *region = mmap(NULL, mapping_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if(region == MAP_FAILED){
+        close(fd);
+        return file_text_contents(filename, out_contents, out_length, true);
+    }
+
+    if(mmap(region, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED){
+        munmap(region, mapping_size);
+        close(fd);
+        return file_text_contents(filename, out_contents, out_length, true);
+    }
+
+    close(fd);
+
+    region[size] = '\n';
+    region[size + 1] = '\0';
+
+    *out_contents = region;
+    *out_length = size + 1;
+    *out_mapping_size = mapping_size;
+    return true;
+    #else
+    return file_text_contents(filename, out_contents, out_length, true);
+    #endif
+}
+
+void file_text_contents_release(char *contents, length_t mapping_size){
+    #if ADEPT_CAN_MAP_FILES
+    if(mapping_size != 0){
+        munmap(contents, mapping_size);
+        return;
+    }
+    #else
+    (void) mapping_size;
+    #endif
+
+    free(contents);
+}
+
 bool file_binary_contents(weak_cstr_t filename, strong_cstr_t *out_contents, length_t *out_length){
     char *buffer;
     length_t buffer_size;
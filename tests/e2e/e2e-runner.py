@@ -61,6 +61,10 @@ def run_all_tests():
         lambda output: b"main.adept:2:1: error: Class is missing constructor\n  2| class ThisIsMissingConstructor ()" in output,
         expected_exitcode=1)
     test("class_virtual_methods_1", [executable, join(src_dir, "class_virtual_methods_1/main.adept")], compiles)
+    test("class_virtual_methods_10",
+        [executable, join(src_dir, "class_virtual_methods_10/main.adept"), "-e"],
+        lambda output: b"26 1 13\n260 10 130\n260 100 130\n" in output
+    )
     test("class_virtual_methods_2", [executable, join(src_dir, "class_virtual_methods_2/main.adept")], compiles)
     test("class_virtual_methods_3_missing_override",
         [executable, join(src_dir, "class_virtual_methods_3_missing_override/main.adept")],
@@ -178,6 +182,22 @@ def run_all_tests():
     test("int_to_float_promotion_in_math", [executable, join(src_dir, "int_to_float_promotion_in_math/main.adept")], compiles)
     test("internal_deference", [executable, join(src_dir, "internal_deference/main.adept")], compiles)
     test("internal_deference_generic", [executable, join(src_dir, "internal_deference_generic/main.adept")], compiles)
+    test("lazy_ir",
+        [executable, join(src_dir, "lazy_ir/main.adept"), "-e"],
+        lambda output: b"init\n9\n16\ndeinit 300\n" in output
+    )
+    test("lazy_ir with --lazy-ir",
+        [executable, join(src_dir, "lazy_ir/main.adept"), "--lazy-ir", "-e"],
+        lambda output: b"init\n9\n16\ndeinit 300\n" in output
+    )
+    test("lazy_ir keeps unreferenced functions without --lazy-ir",
+        [executable, join(src_dir, "lazy_ir/main.adept"), "--llvmir", "--no-result"],
+        lambda output: b"neverCalled was called" in output
+    )
+    test("lazy_ir leaves out unreferenced functions with --lazy-ir",
+        [executable, join(src_dir, "lazy_ir/main.adept"), "--lazy-ir", "--llvmir", "--no-result"],
+        lambda output: b"define i32 @main" in output and b"neverCalled was called" not in output
+    )
     test("list_map", [executable, join(src_dir, "list_map/main.adept")], compiles)
     test("llvm_asm", [executable, join(src_dir, "llvm_asm/main.adept")], compiles)
     test("loose_struct_syntax", [executable, join(src_dir, "loose_struct_syntax/main.adept")], compiles)
@@ -0,0 +1,33 @@
+
+#ifndef _ISAAC_BENCHMARK_H
+#define _ISAAC_BENCHMARK_H
+
+#include <stdio.h>
+#include <time.h>
+
+// ---------------- benchmark_seconds ----------------
+// Returns the current processor time in seconds
+static inline double benchmark_seconds(void){
+    return (double) clock() / CLOCKS_PER_SEC;
+}
+
+// ---------------- benchmark_wall_seconds ----------------
+// Returns the current wall clock time in seconds
+// (Processor time adds up the time of every thread, so multi-threaded work is timed with this instead)
+static inline double benchmark_wall_seconds(void){
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (double) now.tv_sec + (double) now.tv_nsec / 1e9;
+}
+
+// ---------------- benchmark_report ----------------
+// Prints the throughput of a benchmarked operation
+static inline void benchmark_report(const char *name, const char *unit, double count, double seconds){
+    printf("    %-40s %14.0f %s/second  (%.3fs)\n", name, seconds > 0 ? count / seconds : 0.0, unit, seconds);
+}
+
+// ---------------- benchmark_sink ----------------
+// Used to keep results alive so that benchmarked work isn't optimized away
+extern volatile long long benchmark_sink;
+
+#endif // _ISAAC_BENCHMARK_H
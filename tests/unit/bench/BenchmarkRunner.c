@@ -0,0 +1,25 @@
+
+#include <stdio.h>
+
+#include "Benchmark.h"
+
+volatile long long benchmark_sink;
+
+void BENCH_compile_overloads(void);
+void BENCH_compile_parallel(void);
+void BENCH_compile_polymorphic(void);
+void BENCH_hash_types(void);
+void BENCH_lex_keywords(void);
+void BENCH_lex_scan(void);
+
+int main(void){
+    printf("Running all benchmarks:\n");
+
+    BENCH_lex_keywords();
+    BENCH_lex_scan();
+    BENCH_compile_polymorphic();
+    BENCH_compile_overloads();
+    BENCH_compile_parallel();
+    BENCH_hash_types();
+    return 0;
+}
@@ -0,0 +1,158 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Benchmark.h"
+#include "DRVR/compiler.h"
+#include "DRVR/object.h"
+#include "INFER/infer.h"
+#include "IRGEN/ir_gen.h"
+#include "LEX/lex.h"
+#include "PARSE/parse.h"
+#include "UTIL/ground.h"
+#include "UTIL/string.h"
+#include "UTIL/string_builder.h"
+
+#define BENCHMARK_POLYMORPHIC_TYPES 400
+#define BENCHMARK_OVERLOADS 300
+
+static strong_cstr_t benchmark_polymorphic_source(void){
+    // Many types that each instantiate the same polymorphic functions and structs
+    string_builder_t builder;
+    string_builder_init(&builder);
+
+    string_builder_append(&builder,
+        "struct <$T> Box (value $T, count int) {\n"
+        "    func get() $T = this.value\n"
+        "    func put(value $T) void {\n"
+        "        this.value = value\n"
+        "        this.count++\n"
+        "    }\n"
+        "}\n"
+        "func pick(a $T, b $T, first bool) $T = first ? a : b\n"
+        "func wrap(value $T) <$T> Box {\n"
+        "    box <$T> Box\n"
+        "    box.put(value)\n"
+        "    return box\n"
+        "}\n"
+        "func main {}\n"
+    );
+
+    for(int i = 0; i != BENCHMARK_POLYMORPHIC_TYPES; i++){
+        char buffer[512];
+        snprintf(buffer, sizeof buffer,
+            "struct Item%d (id, weight int, next *Item%d)\n"
+            "func useItem%d int {\n"
+            "    a, b Item%d\n"
+            "    c Item%d = pick(a, b, true)\n"
+            "    box <Item%d> Box = wrap(c)\n"
+            "    box.put(pick(box.get(), a, false))\n"
+            "    d Item%d = box.get()\n"
+            "    return d.id + box.count\n"
+            "}\n",
+            i, i, i, i, i, i, i
+        );
+        string_builder_append(&builder, buffer);
+    }
+
+    return string_builder_finalize(&builder);
+}
+
+static strong_cstr_t benchmark_overloads_source(void){
+    // Many overloads of the same function, each called from many places
+    string_builder_t builder;
+    string_builder_init(&builder);
+
+    for(int i = 0; i != BENCHMARK_OVERLOADS; i++){
+        char buffer[256];
+        snprintf(buffer, sizeof buffer,
+            "struct Shape%d (width, height int)\n"
+            "func area(shape *Shape%d) int = shape.width * shape.height + %d\n"
+            "func area(shape *Shape%d, scale int) int = area(shape) * scale\n",
+            i, i, i, i
+        );
+        string_builder_append(&builder, buffer);
+    }
+
+    string_builder_append(&builder, "func main {}\n");
+
+    for(int i = 0; i != BENCHMARK_OVERLOADS; i++){
+        char buffer[256];
+        snprintf(buffer, sizeof buffer,
+            "func measure%d(shape *Shape%d) int {\n"
+            "    return area(shape) + area(shape, 2) + area(shape) * area(shape, 3)\n"
+            "}\n",
+            i, i
+        );
+        string_builder_append(&builder, buffer);
+    }
+
+    return string_builder_finalize(&builder);
+}
+
+static void benchmark_compile(strong_cstr_t source){
+    length_t source_length = strlen(source);
+    const int rounds = 5;
+
+    double lex_and_parse = 0, infer_and_ir_gen = 0, teardown = 0;
+    length_t funcs_length = 0, poly_reused = 0, poly_created = 0, proc_hits = 0, proc_misses = 0;
+
+    for(int round = 0; round != rounds; round++){
+        compiler_t compiler;
+        compiler_init(&compiler);
+        compiler.traits |= COMPILER_NO_TYPEINFO;
+
+        object_t *object = compiler_new_object(&compiler);
+        object->filename = strclone("benchmark.adept");
+        object->full_filename = strclone("benchmark.adept");
+        object->buffer = strclone(source);
+        object->buffer_length = source_length;
+
+        double start = benchmark_seconds();
+        errorcode_t error = lex_buffer(&compiler, object) || parse(&compiler, object);
+        double middle = benchmark_seconds();
+        error = error || infer(&compiler, object) || ir_gen(&compiler, object);
+        double end = benchmark_seconds();
+
+        if(error){
+            printf("    Failed to compile benchmark source\n");
+            compiler_free(&compiler);
+            break;
+        }
+
+        lex_and_parse += middle - start;
+        infer_and_ir_gen += end - middle;
+        funcs_length = object->ir_module.funcs.length;
+        poly_reused = object->ir_module.poly_cache.reused;
+        poly_created = object->ir_module.poly_cache.created;
+        proc_hits = object->ir_module.proc_cache.hits;
+        proc_misses = object->ir_module.proc_cache.misses;
+
+        start = benchmark_seconds();
+        compiler_free(&compiler);
+        teardown += benchmark_seconds() - start;
+    }
+
+    benchmark_report("lex + parse", "bytes", (double) source_length * rounds, lex_and_parse);
+    benchmark_report("infer + ir_gen", "IR functions", (double) funcs_length * rounds, infer_and_ir_gen);
+    benchmark_report("teardown", "IR functions", (double) funcs_length * rounds, teardown);
+    printf("    %-40s %14d reused, %d created\n", "polymorphic instantiations", (int) poly_reused, (int) poly_created);
+    printf("    %-40s %14d cached, %d swept\n", "overload resolutions", (int) proc_hits, (int) proc_misses);
+}
+
+void BENCH_compile_polymorphic(void){
+    strong_cstr_t source = benchmark_polymorphic_source();
+
+    printf("  Compiling up to IR (%d polymorphic instantiations of each kind):\n", BENCHMARK_POLYMORPHIC_TYPES);
+    benchmark_compile(source);
+    free(source);
+}
+
+void BENCH_compile_overloads(void){
+    strong_cstr_t source = benchmark_overloads_source();
+
+    printf("  Compiling up to IR (%d overloads of each function):\n", BENCHMARK_OVERLOADS);
+    benchmark_compile(source);
+    free(source);
+}
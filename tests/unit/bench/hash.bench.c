@@ -0,0 +1,338 @@
+
+#if !defined(_WIN32)
+    #include <dirent.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "AST/TYPE/ast_type_hash.h"
+#include "AST/TYPE/ast_type_identical.h"
+#include "AST/TYPE/ast_type_table.h"
+#include "AST/ast.h"
+#include "AST/ast_layout.h"
+#include "AST/ast_type.h"
+#include "Benchmark.h"
+#include "DRVR/compiler.h"
+#include "DRVR/object.h"
+#include "LEX/lex.h"
+#include "PARSE/parse.h"
+#include "UTIL/filename.h"
+#include "UTIL/ground.h"
+#include "UTIL/hash.h"
+#include "UTIL/list.h"
+#include "UTIL/string.h"
+#include "UTIL/util.h"
+
+typedef listof(ast_type_t, types) benchmark_type_list_t;
+typedef listof(char*, strings) benchmark_string_list_t;
+typedef listof(compiler_t*, compilers) benchmark_compiler_list_t;
+
+static hash_t old_hash_data(const void *data, length_t size){
+    // What 'hash_data' used to do
+    hash_t hash = 0;
+    for(length_t i = 0; i != size; i++){
+        hash = (hash * 31) + (hash_t)((char*) data)[i];
+    }
+    return hash;
+}
+
+static hash_t old_hash_string(const char *s){
+    return old_hash_data(s, strlen(s));
+}
+
+static void benchmark_collect_type(benchmark_type_list_t *types, const ast_type_t *type){
+    if(type->elements_length == 0) return;
+
+    // Variable fixed arrays can't be hashed until they are collapsed
+    for(length_t i = 0; i != type->elements_length; i++){
+        if(type->elements[i]->id == AST_ELEM_VAR_FIXED_ARRAY) return;
+    }
+
+    list_append(types, ast_type_clone(type), ast_type_t);
+}
+
+static void benchmark_collect_layout(benchmark_type_list_t *types, ast_layout_t *layout){
+    ast_field_map_t *field_map = &layout->field_map;
+
+    for(length_t i = 0; i != field_map->arrows_length; i++){
+        ast_type_t *type = ast_layout_skeleton_get_type(&layout->skeleton, field_map->arrows[i].endpoint);
+        if(type) benchmark_collect_type(types, type);
+    }
+}
+
+static void benchmark_collect_ast(benchmark_type_list_t *types, ast_t *ast){
+    for(length_t i = 0; i != ast->funcs_length; i++){
+        ast_func_t *func = &ast->funcs[i];
+
+        for(length_t a = 0; a != func->arity; a++){
+            benchmark_collect_type(types, &func->arg_types[a]);
+        }
+
+        benchmark_collect_type(types, &func->return_type);
+    }
+
+    for(length_t i = 0; i != ast->composites_length; i++){
+        benchmark_collect_layout(types, &ast->composites[i].layout);
+    }
+
+    for(length_t i = 0; i != ast->poly_composites_length; i++){
+        benchmark_collect_layout(types, &ast->poly_composites[i].layout);
+    }
+
+    for(length_t i = 0; i != ast->globals_length; i++){
+        benchmark_collect_type(types, &ast->globals[i].type);
+    }
+
+    for(length_t i = 0; i != ast->aliases_length; i++){
+        benchmark_collect_type(types, &ast->aliases[i].type);
+    }
+}
+
+static strong_cstr_t benchmark_read_without_imports(const char *filename, length_t *out_length){
+    // Reads a file, blanking out 'import' lines, so that
+    // parsing doesn't need anything outside of the file
+    FILE *file = fopen(filename, "rb");
+    if(file == NULL) return NULL;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    strong_cstr_t buffer = malloc(size + 1);
+    length_t length = fread(buffer, 1, size, file);
+    buffer[length] = '\0';
+    fclose(file);
+
+    for(char *line = buffer; line; line = strchr(line, '\n')){
+        while(*line == '\n' || *line == ' ' || *line == '\t') line++;
+
+        if(strncmp(line, "import", 6) == 0 || strncmp(line, "#import", 7) == 0){
+            for(char *c = line; *c && *c != '\n'; c++) *c = ' ';
+        }
+    }
+
+    *out_length = length;
+    return buffer;
+}
+
+static void benchmark_collect_e2e_file(benchmark_compiler_list_t *compilers, benchmark_type_list_t *types, length_t *out_files, const char *test_name){
+    strong_cstr_t filename = mallocandsprintf(ADEPT_E2E_SOURCE_DIR "/%s/main.adept", test_name);
+    length_t buffer_length;
+    strong_cstr_t buffer = benchmark_read_without_imports(filename, &buffer_length);
+
+    if(buffer == NULL){
+        free(filename);
+        return;
+    }
+
+    compiler_t *compiler = malloc(sizeof(compiler_t));
+    compiler_init(compiler);
+    compiler->traits |= COMPILER_NO_WARN;
+    list_append(compilers, compiler, compiler_t*);
+
+    object_t *object = compiler_new_object(compiler);
+    object->filename = strclone(filename);
+    object->full_filename = filename;
+    object->buffer = buffer;
+    object->buffer_length = buffer_length;
+
+    // Keep whatever was parsed, even if some of the file couldn't be
+    if(lex_buffer(compiler, object) == SUCCESS){
+        parse(compiler, object);
+        benchmark_collect_ast(types, &object->ast);
+        *out_files += 1;
+    }
+}
+
+#if defined(_WIN32)
+// Used instead of every e2e test where there's no 'opendir'
+static const char *benchmark_e2e_corpus[] = {
+    "aliases_polymorphic", "anonymous_composites", "any_fixed_array", "any_type_info",
+    "circular_pointers", "class_virtual_methods_9", "complex_composite_rtti", "each_in_list",
+    "fixed_array_var_size_field", "funcptr", "inner_struct_polymorphic", "list_map",
+    "polymorphic_anonymous_composites", "polymorphic_methods", "polymorphic_structs",
+    "records_polymorphic", "static_structs", "super_polymorphic", "union", "variadic",
+};
+#endif
+
+static void benchmark_collect_e2e_types(benchmark_compiler_list_t *compilers, benchmark_type_list_t *types, length_t *out_files){
+    // NOTE: Types can reference tokens, so the compilers are kept alive until the caller is done
+    #if defined(_WIN32)
+    for(length_t i = 0; i != sizeof benchmark_e2e_corpus / sizeof *benchmark_e2e_corpus; i++){
+        benchmark_collect_e2e_file(compilers, types, out_files, benchmark_e2e_corpus[i]);
+    }
+    #else
+    DIR *directory = opendir(ADEPT_E2E_SOURCE_DIR);
+    if(directory == NULL) return;
+
+    // Some of the files are expected to fail, so hide what the compiler says about them
+    fflush(stdout);
+    int original_stdout = dup(STDOUT_FILENO);
+    int null_output = open("/dev/null", O_WRONLY);
+    if(null_output >= 0) dup2(null_output, STDOUT_FILENO);
+
+    struct dirent *entry;
+
+    while((entry = readdir(directory))){
+        if(entry->d_name[0] == '.') continue;
+        benchmark_collect_e2e_file(compilers, types, out_files, entry->d_name);
+    }
+
+    fflush(stdout);
+    dup2(original_stdout, STDOUT_FILENO);
+    close(original_stdout);
+    if(null_output >= 0) close(null_output);
+
+    closedir(directory);
+    #endif
+}
+
+static length_t benchmark_count_bucket_collisions(hash_t *hashes, length_t length){
+    // Counts how many hashes land in an already used bucket,
+    // when there are about twice as many buckets as hashes
+    length_t buckets_length = 1;
+    while(buckets_length < length * 2) buckets_length *= 2;
+
+    bool *used = calloc(buckets_length, sizeof(bool));
+    length_t collisions = 0;
+
+    for(length_t i = 0; i != length; i++){
+        length_t bucket = hashes[i] & (buckets_length - 1);
+        if(used[bucket]) collisions++;
+        used[bucket] = true;
+    }
+
+    free(used);
+    return collisions;
+}
+
+static int benchmark_compare_hashes(const void *a, const void *b){
+    hash_t x = *(const hash_t*) a;
+    hash_t y = *(const hash_t*) b;
+    return (x > y) - (x < y);
+}
+
+static length_t benchmark_count_full_collisions(hash_t *hashes, length_t length){
+    // Counts how many distinct items share their entire hash with another
+    hash_t *sorted = memcpy(malloc(sizeof(hash_t) * length), hashes, sizeof(hash_t) * length);
+    qsort(sorted, length, sizeof(hash_t), &benchmark_compare_hashes);
+
+    length_t collisions = 0;
+    for(length_t i = 1; i < length; i++){
+        if(sorted[i] == sorted[i - 1]) collisions++;
+    }
+
+    free(sorted);
+    return collisions;
+}
+
+static void benchmark_report_collisions(const char *name, hash_t *hashes, length_t length){
+    printf("    %-40s %14d full, %d bucket collisions\n", name, (int) benchmark_count_full_collisions(hashes, length), (int) benchmark_count_bucket_collisions(hashes, length));
+}
+
+static void benchmark_free_compilers(benchmark_compiler_list_t *compilers){
+    for(length_t i = 0; i != compilers->length; i++){
+        compiler_free(compilers->compilers[i]);
+        free(compilers->compilers[i]);
+    }
+    free(compilers->compilers);
+}
+
+void BENCH_hash_types(void){
+    benchmark_compiler_list_t compilers = {0};
+    benchmark_type_list_t all_types = {0};
+    length_t files = 0;
+
+    benchmark_collect_e2e_types(&compilers, &all_types, &files);
+
+    if(all_types.length == 0){
+        printf("  Hashing types: (no types found in '%s')\n", ADEPT_E2E_SOURCE_DIR);
+        benchmark_free_compilers(&compilers);
+        return;
+    }
+
+    // Remove duplicate types, so that every collision is a real one
+    ast_type_table_t table = {0};
+    benchmark_type_list_t types = {0};
+
+    for(length_t i = 0; i != all_types.length; i++){
+        length_t count_before = table.impl.count;
+        const ast_type_t *canonical = ast_type_table_canonical(&table, &all_types.types[i]);
+
+        if(table.impl.count != count_before){
+            list_append(&types, *canonical, ast_type_t);
+        }
+    }
+
+    benchmark_string_list_t names = {0};
+    length_t names_bytes = 0;
+
+    for(length_t i = 0; i != types.length; i++){
+        char *name = ast_type_str(&types.types[i]);
+        names_bytes += strlen(name);
+        list_append(&names, name, char*);
+    }
+
+    printf("  Hashing types (%d distinct out of %d from %d e2e files):\n", (int) types.length, (int) all_types.length, (int) files);
+
+    const int rounds = 2000;
+    hash_t *hashes = malloc(sizeof(hash_t) * types.length);
+    long long sum = 0;
+
+    double start = benchmark_seconds();
+    for(int round = 0; round != rounds; round++){
+        for(length_t i = 0; i != names.length; i++){
+            sum += old_hash_string(names.strings[i]);
+        }
+    }
+    benchmark_report("type names, byte at a time (old)", "bytes", (double) names_bytes * rounds, benchmark_seconds() - start);
+
+    start = benchmark_seconds();
+    for(int round = 0; round != rounds; round++){
+        for(length_t i = 0; i != names.length; i++){
+            sum += hash_string(names.strings[i]);
+        }
+    }
+    benchmark_report("type names, hash_string", "bytes", (double) names_bytes * rounds, benchmark_seconds() - start);
+
+    start = benchmark_seconds();
+    for(int round = 0; round != rounds; round++){
+        for(length_t i = 0; i != types.length; i++){
+            sum += ast_type_hash(&types.types[i]);
+        }
+    }
+    benchmark_report("ast_type_hash", "types", (double) types.length * rounds, benchmark_seconds() - start);
+
+    start = benchmark_seconds();
+    for(int round = 0; round != rounds; round++){
+        for(length_t i = 0; i != types.length; i++){
+            sum += ast_canonical_type_hash(ast_type_table_canonical(&table, &types.types[i]));
+        }
+    }
+    benchmark_report("ast_type_table_canonical", "types", (double) types.length * rounds, benchmark_seconds() - start);
+
+    benchmark_sink = sum;
+
+    printf("  Hash collisions:\n");
+
+    for(length_t i = 0; i != names.length; i++) hashes[i] = old_hash_string(names.strings[i]);
+    benchmark_report_collisions("type names, byte at a time (old)", hashes, names.length);
+
+    for(length_t i = 0; i != names.length; i++) hashes[i] = hash_string(names.strings[i]);
+    benchmark_report_collisions("type names, hash_string", hashes, names.length);
+
+    for(length_t i = 0; i != types.length; i++) hashes[i] = ast_type_hash(&types.types[i]);
+    benchmark_report_collisions("ast_type_hash", hashes, types.length);
+
+    free(hashes);
+    free_strings(names.strings, names.length);
+    free(types.types);
+    ast_type_table_free(&table);
+    ast_types_free_fully(all_types.types, all_types.length);
+    benchmark_free_compilers(&compilers);
+}
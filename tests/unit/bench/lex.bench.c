@@ -0,0 +1,157 @@
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Benchmark.h"
+#include "DRVR/object.h"
+#include "LEX/lex.h"
+#include "LEX/lex_scan.h"
+#include "LEX/token.h"
+#include "TOKEN/token_data.h"
+#include "UTIL/ground.h"
+#include "UTIL/search.h"
+#include "UTIL/string_builder.h"
+
+static const char *benchmark_source =
+    "import basics\n"
+    "\n"
+    "struct Person (name String, age int, friends <*Person> List) {\n"
+    "    func greet(other *Person) void {\n"
+    "        if other == null || this.age < 0, return\n"
+    "        print(\"Hello \" + other.name + \", I'm \" + this.name)\n"
+    "    }\n"
+    "}\n"
+    "\n"
+    "func main {\n"
+    "    people <Person> List\n"
+    "    repeat static 100 {\n"
+    "        person *Person = people.add()\n"
+    "        person.age = cast int idx\n"
+    "        unless person.age % 2 == 0, continue\n"
+    "        each Person in static people.getPointer() as current, current.greet(person)\n"
+    "    }\n"
+    "    defer people.clear()\n"
+    "    while people.length > 0 && sizeof Person != 0 { delete people.pop() }\n"
+    "}\n";
+
+typedef struct {
+    const char *word;
+    length_t length;
+} benchmark_word_t;
+
+static maybe_index_t old_keyword_index(const char *word, length_t length){
+    // What the lexer used to do for every word
+    char *identifier = memcpy(malloc(length + 1), word, length);
+    identifier[length] = '\0';
+
+    maybe_index_t index = binary_string_search_const(global_token_keywords_list, global_token_keywords_list_length, identifier);
+    free(identifier);
+    return index;
+}
+
+void BENCH_lex_keywords(void){
+    string_builder_t builder;
+    string_builder_init(&builder);
+
+    for(int i = 0; i != 2000; i++){
+        string_builder_append(&builder, benchmark_source);
+    }
+
+    object_t object = {0};
+    object.buffer = string_builder_finalize(&builder);
+    object.buffer_length = strlen(object.buffer);
+
+    if(lex_buffer(NULL, &object)){
+        printf("    Failed to lex benchmark source\n");
+        free(object.buffer);
+        return;
+    }
+
+    // Collect every word and keyword so that lookups can be measured on their own
+    benchmark_word_t *words = malloc(sizeof(benchmark_word_t) * object.tokenlist.length);
+    length_t words_length = 0;
+
+    for(length_t i = 0; i != object.tokenlist.length; i++){
+        tokenid_t id = object.tokenlist.ids[i];
+
+        if(id == TOKEN_WORD || id >= BEGINNING_OF_KEYWORD_TOKENS){
+            source_t source = tokenlist_source(&object.tokenlist, i);
+            words[words_length++] = (benchmark_word_t){&object.buffer[source.index], source.stride};
+        }
+    }
+
+    printf("  Keyword lookup (%d words):\n", (int) words_length);
+
+    const int rounds = 20;
+    long long found = 0;
+
+    double start = benchmark_seconds();
+    for(int round = 0; round != rounds; round++){
+        for(length_t i = 0; i != words_length; i++){
+            found += old_keyword_index(words[i].word, words[i].length) != -1;
+        }
+    }
+    benchmark_report("copy + binary search (old)", "words", (double) words_length * rounds, benchmark_seconds() - start);
+
+    start = benchmark_seconds();
+    for(int round = 0; round != rounds; round++){
+        for(length_t i = 0; i != words_length; i++){
+            found += lex_keyword_index(words[i].word, words[i].length) != -1;
+        }
+    }
+    benchmark_report("perfect hash (lex_keyword_index)", "words", (double) words_length * rounds, benchmark_seconds() - start);
+
+    benchmark_sink = found;
+
+    // Whole lexer throughput for reference
+    length_t tokens_length = object.tokenlist.length;
+    free(object.newlines);
+    tokenlist_free(&object.tokenlist);
+
+    start = benchmark_seconds();
+    for(int round = 0; round != rounds / 4; round++){
+        if(lex_buffer(NULL, &object)) break;
+        free(object.newlines);
+        tokenlist_free(&object.tokenlist);
+    }
+    benchmark_report("lex_buffer", "tokens", (double) tokens_length * (rounds / 4), benchmark_seconds() - start);
+
+    free(words);
+    free(object.buffer);
+}
+
+void BENCH_lex_scan(void){
+    string_builder_t builder;
+    string_builder_init(&builder);
+
+    for(int i = 0; i != 2000; i++){
+        string_builder_append(&builder, benchmark_source);
+        string_builder_append(&builder, "\n    // A comment that goes on for a while, as comments in real code tend to do\n");
+        string_builder_append(&builder, "    /* And a block comment\n       that spans multiple lines */\n");
+    }
+
+    object_t object = {0};
+    object.buffer = string_builder_finalize(&builder);
+    object.buffer_length = strlen(object.buffer);
+
+    const char *names[] = {"scalar", "SSE2", "AVX2"};
+    lex_scan_impl_t best = lex_scan_get_impl();
+    const int rounds = 10;
+
+    printf("  Lexing with each scanning implementation (%d bytes):\n", (int) object.buffer_length);
+
+    for(lex_scan_impl_t impl = LEX_SCAN_SCALAR; impl <= LEX_SCAN_AVX2; impl++){
+        if(!lex_scan_set_impl(impl)) continue;
+
+        double start = benchmark_seconds();
+        for(int round = 0; round != rounds; round++){
+            if(lex_buffer(NULL, &object)) break;
+            free(object.newlines);
+            tokenlist_free(&object.tokenlist);
+        }
+        benchmark_report(names[impl], "bytes", (double) object.buffer_length * rounds, benchmark_seconds() - start);
+    }
+
+    lex_scan_set_impl(best);
+    free(object.buffer);
+}
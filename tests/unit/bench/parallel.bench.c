@@ -0,0 +1,116 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Benchmark.h"
+#include "DRVR/compiler.h"
+#include "DRVR/object.h"
+#include "INFER/infer.h"
+#include "IRGEN/ir_gen.h"
+#include "LEX/lex.h"
+#include "PARSE/parse.h"
+#include "UTIL/ground.h"
+#include "UTIL/string.h"
+#include "UTIL/string_builder.h"
+#include "UTIL/threads.h"
+
+#define BENCHMARK_PARALLEL_FUNCTIONS 2000
+
+static strong_cstr_t benchmark_parallel_source(void){
+    // Many independent function bodies, which can all be generated at the same time
+    string_builder_t builder;
+    string_builder_init(&builder);
+
+    string_builder_append(&builder,
+        "struct Vector (x, y, z double)\n"
+        "func dot(a, b *Vector) double = a.x * b.x + a.y * b.y + a.z * b.z\n"
+        "func scale(v *Vector, factor double) void {\n"
+        "    v.x *= factor\n"
+        "    v.y *= factor\n"
+        "    v.z *= factor\n"
+        "}\n"
+        "func main {}\n"
+    );
+
+    for(int i = 0; i != BENCHMARK_PARALLEL_FUNCTIONS; i++){
+        char buffer[512];
+        snprintf(buffer, sizeof buffer,
+            "func work%d(count int) double {\n"
+            "    a, b Vector\n"
+            "    total double = %d.0\n"
+            "    repeat count {\n"
+            "        scale(&a, 0.5)\n"
+            "        if dot(&a, &b) > total, total += dot(&b, &a) else total -= 1.0\n"
+            "    }\n"
+            "    return total\n"
+            "}\n",
+            i, i
+        );
+        string_builder_append(&builder, buffer);
+    }
+
+    return string_builder_finalize(&builder);
+}
+
+static void benchmark_parallel_compile(strong_cstr_t source, length_t threads, const char *label){
+    length_t source_length = strlen(source);
+    const int rounds = 3;
+
+    double ir_gen_seconds = 0;
+    length_t funcs_length = 0;
+    ir_speculation_stats_t stats = {0};
+
+    for(int round = 0; round != rounds; round++){
+        compiler_t compiler;
+        compiler_init(&compiler);
+        compiler.traits |= COMPILER_NO_TYPEINFO;
+        compiler.threads = threads;
+
+        object_t *object = compiler_new_object(&compiler);
+        object->filename = strclone("benchmark.adept");
+        object->full_filename = strclone("benchmark.adept");
+        object->buffer = strclone(source);
+        object->buffer_length = source_length;
+
+        errorcode_t error = lex_buffer(&compiler, object) || parse(&compiler, object) || infer(&compiler, object);
+
+        double start = benchmark_wall_seconds();
+        error = error || ir_gen(&compiler, object);
+        double end = benchmark_wall_seconds();
+
+        if(error){
+            printf("    Failed to compile benchmark source\n");
+            compiler_free(&compiler);
+            return;
+        }
+
+        ir_gen_seconds += end - start;
+        funcs_length = object->ir_module.funcs.length;
+        stats = object->ir_module.speculation_stats;
+        compiler_free(&compiler);
+    }
+
+    char name[64];
+    snprintf(name, sizeof name, "ir_gen (%d threads%s)", (int) threads, label);
+
+    benchmark_report(name, "IR functions", (double) funcs_length * rounds, ir_gen_seconds);
+    printf("    %-40s %14d committed, %d aborted, %d invalidated\n", "speculated function bodies", (int) stats.committed, (int) stats.aborted, (int) stats.invalidated);
+}
+
+void BENCH_compile_parallel(void){
+    strong_cstr_t source = benchmark_parallel_source();
+    length_t available = threads_available();
+
+    printf("  Compiling up to IR using multiple threads (%d function bodies, %d hardware threads):\n", BENCHMARK_PARALLEL_FUNCTIONS, (int) available);
+
+    for(length_t threads = 1; threads < available; threads *= 2){
+        benchmark_parallel_compile(source, threads, "");
+    }
+
+    benchmark_parallel_compile(source, available, "");
+
+    // More threads than hardware threads (which '--threads' never uses), for comparison
+    benchmark_parallel_compile(source, available * 2, ", oversubscribed");
+    free(source);
+}
@@ -3,8 +3,20 @@
 
 #include "CuTest.h"
 
+CuSuite *CuSuite_for_ast_cache(void);
+CuSuite *CuSuite_for_ast_composite_index(void);
 CuSuite *CuSuite_for_ast_expr(void);
+CuSuite *CuSuite_for_ast_layout(void);
+CuSuite *CuSuite_for_ast_serialize(void);
+CuSuite *CuSuite_for_ast_type_table(void);
+CuSuite *CuSuite_for_bridge(void);
+CuSuite *CuSuite_for_intern(void);
+CuSuite *CuSuite_for_ir_cache(void);
+CuSuite *CuSuite_for_ir_proc_map(void);
+CuSuite *CuSuite_for_ir_type_map(void);
 CuSuite *CuSuite_for_lex(void);
+CuSuite *CuSuite_for_set(void);
+CuSuite *CuSuite_for_string_map(void);
 
 int RunAllTests(void){
     printf("Running all unit tests:\n");
@@ -12,8 +24,20 @@ int RunAllTests(void){
     CuString *output = CuStringNew();
     CuSuite* suite = CuSuiteNew();
 
+    CuSuiteAddSuite(suite, CuSuite_for_ast_cache());
+    CuSuiteAddSuite(suite, CuSuite_for_ast_composite_index());
     CuSuiteAddSuite(suite, CuSuite_for_ast_expr());
+    CuSuiteAddSuite(suite, CuSuite_for_ast_layout());
+    CuSuiteAddSuite(suite, CuSuite_for_ast_serialize());
+    CuSuiteAddSuite(suite, CuSuite_for_ast_type_table());
+    CuSuiteAddSuite(suite, CuSuite_for_bridge());
+    CuSuiteAddSuite(suite, CuSuite_for_intern());
+    CuSuiteAddSuite(suite, CuSuite_for_ir_cache());
+    CuSuiteAddSuite(suite, CuSuite_for_ir_proc_map());
+    CuSuiteAddSuite(suite, CuSuite_for_ir_type_map());
     CuSuiteAddSuite(suite, CuSuite_for_lex());
+    CuSuiteAddSuite(suite, CuSuite_for_set());
+    CuSuiteAddSuite(suite, CuSuite_for_string_map());
 
     CuSuiteRun(suite);
     CuSuiteSummary(suite, output);
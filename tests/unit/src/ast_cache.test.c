@@ -0,0 +1,170 @@
+
+#ifdef _WIN32
+    #include <direct.h>
+    #include <io.h>
+
+    #define makedir(a) _mkdir(a)
+    #define removedir(a) _rmdir(a)
+#else
+    #include <sys/stat.h>
+    #include <unistd.h>
+
+    #define makedir(a) mkdir(a, 0777)
+    #define removedir(a) rmdir(a)
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "AST/ast.h"
+#include "AST/ast_serialize.h"
+#include "CuTest.h"
+#include "DRVR/ast_cache.h"
+#include "DRVR/compiler.h"
+#include "DRVR/object.h"
+#include "LEX/lex.h"
+#include "PARSE/parse.h"
+#include "UTIL/ground.h"
+#include "UTIL/string.h"
+
+static const char *ast_cache_test_main =
+    "func identity(value $T) $T = value\n"
+    "import 'dependency.adept'\n"
+    "struct Line (from, to Point)\n"
+    "import 'settings.adept'\n"
+    "func length(line *Line) int = twice(line.to.x - line.from.x)\n";
+
+static const char *ast_cache_test_dependency =
+    "struct Point (x, y int)\n"
+    "func twice(value int) int = value * 2\n";
+
+// Pragmas affect the compiler, so files that use them can't be cached
+static const char *ast_cache_test_settings =
+    "pragma ignore_unused\n"
+    "func settings {}\n";
+
+static maybe_null_strong_cstr_t make_temporary_directory(void){
+    #ifdef _WIN32
+    const char *temporary = getenv("TEMP");
+    strong_cstr_t directory = mallocandsprintf("%s\\adept_ast_cache_XXXXXX", temporary ? temporary : ".");
+
+    if(_mktemp_s(directory, strlen(directory) + 1) != 0 || makedir(directory) != 0){
+        free(directory);
+        return NULL;
+    }
+
+    return directory;
+    #else
+    const char *temporary = getenv("TMPDIR");
+    strong_cstr_t directory = mallocandsprintf("%s/adept_ast_cache_XXXXXX", temporary ? temporary : "/tmp");
+
+    if(mkdtemp(directory) == NULL){
+        free(directory);
+        return NULL;
+    }
+
+    return directory;
+    #endif
+}
+
+static strong_cstr_t write_file(weak_cstr_t directory, weak_cstr_t name, const char *contents){
+    strong_cstr_t filename = mallocandsprintf("%s/%s", directory, name);
+    FILE *file = fopen(filename, "wb");
+
+    if(file){
+        fputs(contents, file);
+        fclose(file);
+    }
+
+    return filename;
+}
+
+static errorcode_t compile_main(compiler_t *compiler, weak_cstr_t directory, weak_cstr_t main_filename, strong_cstr_t *out_serialized, length_t *out_serialized_length){
+    compiler_init(compiler);
+    compiler->ast_cache_directory = strclone(directory);
+
+    object_t *object = compiler_new_object(compiler);
+    object->filename = strclone(main_filename);
+    object->full_filename = strclone(main_filename);
+    object->buffer = strclone(ast_cache_test_main);
+    object->buffer_length = strlen(object->buffer);
+
+    if(ast_cache_lex_buffer(compiler, object, directory) || parse(compiler, object)) return FAILURE;
+    return ast_serialize(&object->ast, out_serialized, out_serialized_length);
+}
+
+static void TEST_ast_cache_round_trip(CuTest *test){
+    strong_cstr_t directory = make_temporary_directory();
+    CuAssert(test, "Failed to create temporary directory", directory != NULL);
+
+    strong_cstr_t main_filename = write_file(directory, "main.adept", ast_cache_test_main);
+    strong_cstr_t dependency_filename = write_file(directory, "dependency.adept", ast_cache_test_dependency);
+    strong_cstr_t settings_filename = write_file(directory, "settings.adept", ast_cache_test_settings);
+
+    // The first build parses everything and fills the cache
+    compiler_t cold;
+    strong_cstr_t cold_serialized;
+    length_t cold_serialized_length;
+    CuAssert(test, "Failed to compile without cache", compile_main(&cold, directory, main_filename, &cold_serialized, &cold_serialized_length) == SUCCESS);
+    CuAssertIntEquals(test, 3, cold.objects_length);
+
+    for(length_t i = 0; i != cold.objects_length; i++){
+        CuAssertTrue(test, !(cold.objects[i]->traits & OBJECT_CACHED));
+    }
+
+    uint64_t config_hash = ast_cache_config_hash(&cold);
+
+    // The second build must end up with exactly the same AST, in the same order
+    compiler_t warm;
+    strong_cstr_t warm_serialized;
+    length_t warm_serialized_length;
+    CuAssert(test, "Failed to compile with cache", compile_main(&warm, directory, main_filename, &warm_serialized, &warm_serialized_length) == SUCCESS);
+    CuAssertIntEquals(test, 3, warm.objects_length);
+    CuAssertTrue(test, warm.objects[0]->traits & OBJECT_CACHED);
+    CuAssertTrue(test, warm.objects[1]->traits & OBJECT_CACHED);
+    CuAssertTrue(test, !(warm.objects[2]->traits & OBJECT_CACHED));
+
+    CuAssertIntEquals(test, cold_serialized_length, warm_serialized_length);
+    CuAssert(test, "Cached AST differs", memcmp(cold_serialized, warm_serialized, cold_serialized_length) == 0);
+
+    // Different contents or settings must never be served from the cache
+    // NOTE: Files are looked up by their contents as the compiler read them
+    object_t *dependency = cold.objects[1];
+    object_t *settings = cold.objects[2];
+    ast_cache_entry_t entry;
+    CuAssertTrue(test, ast_cache_load(directory, config_hash, dependency->buffer, dependency->buffer_length, &entry));
+    ast_cache_entry_free(&entry);
+    CuAssertTrue(test, !ast_cache_load(directory, config_hash, dependency->buffer, dependency->buffer_length - 1, &entry));
+    CuAssertTrue(test, !ast_cache_load(directory, config_hash + 1, dependency->buffer, dependency->buffer_length, &entry));
+    CuAssertTrue(test, !ast_cache_load(directory, config_hash, settings->buffer, settings->buffer_length, &entry));
+
+    // Clean up after ourselves
+    for(length_t i = 0; i != 2; i++){
+        object_t *object = cold.objects[i];
+        strong_cstr_t entry_filename = ast_cache_entry_filename(directory, config_hash, object->buffer, object->buffer_length);
+        CuAssertTrue(test, remove(entry_filename) == 0);
+        free(entry_filename);
+    }
+
+    free(cold_serialized);
+    free(warm_serialized);
+    compiler_free(&cold);
+    compiler_free(&warm);
+
+    CuAssertTrue(test, remove(main_filename) == 0);
+    CuAssertTrue(test, remove(dependency_filename) == 0);
+    CuAssertTrue(test, remove(settings_filename) == 0);
+    CuAssert(test, "Temporary directory wasn't empty", removedir(directory) == 0);
+
+    free(main_filename);
+    free(dependency_filename);
+    free(settings_filename);
+    free(directory);
+}
+
+CuSuite *CuSuite_for_ast_cache(void){
+    CuSuite *suite = CuSuiteNew();
+    SUITE_ADD_TEST(suite, TEST_ast_cache_round_trip);
+    return suite;
+}
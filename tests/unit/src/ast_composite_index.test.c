@@ -0,0 +1,74 @@
+
+#include <stdlib.h>
+
+#include "AST/ast_composite_index.h"
+#include "CuTest.h"
+#include "UTIL/ground.h"
+#include "UTIL/intern.h"
+#include "UTIL/util.h"
+
+static weak_cstr_t ast_composite_index_test_name(length_t i){
+    strong_cstr_t name = mallocandsprintf("Composite%d", (int) i);
+    weak_cstr_t atom = intern_name(name);
+    free(name);
+    return atom;
+}
+
+static void TEST_ast_composite_index_growth(CuTest *test){
+    length_t count = 1000;
+
+    ast_composite_index_t index = {0};
+
+    // Every name is used both with and without generics
+    for(length_t i = 0; i != count; i++){
+        weak_cstr_t name = ast_composite_index_test_name(i);
+        ast_composite_index_insert(&index, name, 0, i);
+        ast_composite_index_insert(&index, name, 2, count + i);
+    }
+
+    CuAssertIntEquals(test, count * 2, index.impl.count);
+
+    for(length_t i = 0; i != count; i++){
+        weak_cstr_t name = ast_composite_index_test_name(i);
+        CuAssertIntEquals(test, i, ast_composite_index_find(&index, name, 0));
+        CuAssertIntEquals(test, count + i, ast_composite_index_find(&index, name, 2));
+    }
+
+    ast_composite_index_free(&index);
+}
+
+static void TEST_ast_composite_index_duplicates(CuTest *test){
+    weak_cstr_t name = intern_name("Duplicate");
+
+    ast_composite_index_t index = {0};
+
+    // The earliest composite wins
+    ast_composite_index_insert(&index, name, 1, 3);
+    ast_composite_index_insert(&index, name, 1, 7);
+    CuAssertIntEquals(test, 1, index.impl.count);
+    CuAssertIntEquals(test, 3, ast_composite_index_find(&index, name, 1));
+
+    ast_composite_index_free(&index);
+}
+
+static void TEST_ast_composite_index_misses(CuTest *test){
+    weak_cstr_t name = intern_name("Present");
+
+    // Zero-initialized composite indices are empty
+    ast_composite_index_t index = {0};
+    CuAssertIntEquals(test, -1, ast_composite_index_find(&index, name, 0));
+
+    ast_composite_index_insert(&index, name, 0, 0);
+    CuAssertIntEquals(test, -1, ast_composite_index_find(&index, name, 1));
+    CuAssertIntEquals(test, -1, ast_composite_index_find(&index, intern_name("Missing"), 0));
+
+    ast_composite_index_free(&index);
+}
+
+CuSuite *CuSuite_for_ast_composite_index(void){
+    CuSuite *suite = CuSuiteNew();
+    SUITE_ADD_TEST(suite, TEST_ast_composite_index_growth);
+    SUITE_ADD_TEST(suite, TEST_ast_composite_index_duplicates);
+    SUITE_ADD_TEST(suite, TEST_ast_composite_index_misses);
+    return suite;
+}
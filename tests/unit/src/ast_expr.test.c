@@ -118,7 +118,7 @@ static void TEST_ast_expr_call_str_6(CuTest *test){
     bool is_tentative = false;
     length_t args_length = 3;
     ast_expr_t **args = malloc(sizeof(ast_expr_t*) * args_length);
-    ast_type_t gives = ast_type_make_base(strclone("ResultingType"));
+    ast_type_t gives = ast_type_make_base("ResultingType");
 
     args[0] = ast_expr_create_long(12345, NULL_SOURCE);
     args[1] = ast_expr_create_long(67890, NULL_SOURCE);
@@ -141,7 +141,7 @@ static void TEST_ast_expr_call_str_7(CuTest *test){
     bool is_tentative = true;
     length_t args_length = 3;
     ast_expr_t **args = malloc(sizeof(ast_expr_t*) * args_length);
-    ast_type_t gives = ast_type_make_base(strclone("ResultingType"));
+    ast_type_t gives = ast_type_make_base("ResultingType");
 
     args[0] = ast_expr_create_long(11111, NULL_SOURCE);
     args[1] = ast_expr_create_long(22222, NULL_SOURCE);
@@ -164,7 +164,7 @@ static void TEST_ast_expr_call_str_8(CuTest *test){
     bool is_tentative = true;
     length_t args_length = 1;
     ast_expr_t **args = malloc(sizeof(ast_expr_t*) * args_length);
-    ast_type_t gives = ast_type_make_base(strclone("Return"));
+    ast_type_t gives = ast_type_make_base("Return");
 
     args[0] = ast_expr_create_long(13579, NULL_SOURCE);
 
@@ -0,0 +1,106 @@
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "AST/ast_layout.h"
+#include "CuTest.h"
+#include "UTIL/ground.h"
+#include "UTIL/string.h"
+#include "UTIL/util.h"
+
+static ast_layout_endpoint_t ast_layout_test_endpoint(uint16_t a, uint16_t b){
+    uint16_t indices[] = {a, b};
+
+    ast_layout_endpoint_t endpoint;
+    ast_layout_endpoint_init_with(&endpoint, indices, 2);
+    return endpoint;
+}
+
+static void TEST_ast_field_map_growth(CuTest *test){
+    length_t count = 300;
+
+    ast_field_map_t field_map;
+    ast_field_map_init(&field_map);
+
+    for(length_t i = 0; i != count; i++){
+        ast_field_map_add(&field_map, mallocandsprintf("field%d", (int) i), ast_layout_test_endpoint(i / 16, i % 16));
+
+        // Lookups in between additions build the index early,
+        // so it has to be kept up to date (and rebuilt when the arrows move)
+        ast_layout_endpoint_t endpoint;
+        CuAssertTrue(test, ast_field_map_find(&field_map, field_map.arrows[i / 2].name, &endpoint));
+        CuAssertTrue(test, ast_layout_endpoint_equals(&endpoint, &field_map.arrows[i / 2].endpoint));
+    }
+
+    CuAssertTrue(test, field_map.maybe_index != NULL);
+
+    for(length_t i = 0; i != count; i++){
+        strong_cstr_t name = mallocandsprintf("field%d", (int) i);
+
+        ast_layout_endpoint_t expected = ast_layout_test_endpoint(i / 16, i % 16);
+        ast_layout_endpoint_t endpoint;
+        CuAssertTrue(test, ast_field_map_find(&field_map, name, &endpoint));
+        CuAssertTrue(test, ast_layout_endpoint_equals(&endpoint, &expected));
+        CuAssertStrEquals(test, name, ast_field_map_get_name_of_endpoint(&field_map, expected));
+
+        free(name);
+    }
+
+    // Clones of indexed field maps are indexed too
+    ast_field_map_t clone = ast_field_map_clone(&field_map);
+    CuAssertTrue(test, clone.maybe_index != NULL);
+    CuAssertStrEquals(test, "field123", ast_field_map_get_name_of_endpoint(&clone, ast_layout_test_endpoint(123 / 16, 123 % 16)));
+
+    ast_field_map_free(&clone);
+    ast_field_map_free(&field_map);
+}
+
+static void TEST_ast_field_map_duplicates(CuTest *test){
+    ast_field_map_t field_map;
+    ast_field_map_init(&field_map);
+
+    for(length_t i = 0; i != AST_FIELD_MAP_INDEX_THRESHOLD * 2; i++){
+        ast_field_map_add(&field_map, mallocandsprintf("field%d", (int) i), ast_layout_test_endpoint(0, i));
+    }
+
+    // Earlier arrows take priority over later ones, both by name and by endpoint
+    ast_field_map_add(&field_map, strclone("field3"), ast_layout_test_endpoint(1, 0));
+    ast_field_map_add(&field_map, strclone("alias"), ast_layout_test_endpoint(0, 5));
+
+    ast_layout_endpoint_t expected = ast_layout_test_endpoint(0, 3);
+    ast_layout_endpoint_t endpoint;
+    CuAssertTrue(test, ast_field_map_find(&field_map, "field3", &endpoint));
+    CuAssertTrue(test, field_map.maybe_index != NULL);
+    CuAssertTrue(test, ast_layout_endpoint_equals(&endpoint, &expected));
+    CuAssertStrEquals(test, "field5", ast_field_map_get_name_of_endpoint(&field_map, ast_layout_test_endpoint(0, 5)));
+
+    ast_field_map_free(&field_map);
+}
+
+static void TEST_ast_field_map_misses(CuTest *test){
+    ast_field_map_t field_map;
+    ast_field_map_init(&field_map);
+
+    for(length_t i = 0; i != AST_FIELD_MAP_INDEX_THRESHOLD * 2; i++){
+        ast_field_map_add(&field_map, mallocandsprintf("field%d", (int) i), ast_layout_test_endpoint(0, i));
+    }
+
+    ast_layout_endpoint_t endpoint;
+    CuAssertTrue(test, !ast_field_map_find(&field_map, "field", &endpoint));
+    CuAssertTrue(test, field_map.maybe_index != NULL);
+    CuAssertTrue(test, !ast_field_map_find(&field_map, "field32", &endpoint));
+    CuAssertTrue(test, !ast_field_map_find(&field_map, "", &endpoint));
+    CuAssertPtrEquals(test, NULL, ast_field_map_get_name_of_endpoint(&field_map, ast_layout_test_endpoint(1, 0)));
+    CuAssertPtrEquals(test, NULL, ast_field_map_get_name_of_endpoint(&field_map, ast_layout_test_endpoint(0, 100)));
+
+    ast_field_map_free(&field_map);
+}
+
+CuSuite *CuSuite_for_ast_layout(void){
+    CuSuite *suite = CuSuiteNew();
+    SUITE_ADD_TEST(suite, TEST_ast_field_map_growth);
+    SUITE_ADD_TEST(suite, TEST_ast_field_map_duplicates);
+    SUITE_ADD_TEST(suite, TEST_ast_field_map_misses);
+    return suite;
+}
@@ -0,0 +1,122 @@
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "AST/ast.h"
+#include "AST/ast_serialize.h"
+#include "CuTest.h"
+#include "DRVR/compiler.h"
+#include "DRVR/object.h"
+#include "LEX/lex.h"
+#include "PARSE/parse.h"
+#include "UTIL/arena.h"
+#include "UTIL/ground.h"
+#include "UTIL/string.h"
+
+static const char *ast_serialize_test_code =
+    "foreign printf(*ubyte, ...) int\n"
+    "foreign 'libm.a'\n"
+    "struct Point (x, y int) {\n"
+    "    func sum() int = this.x + this.y\n"
+    "}\n"
+    "union Number (i int, f float)\n"
+    "struct <$T> Box (value $T) {\n"
+    "    func get() $T = this.value\n"
+    "}\n"
+    "enum Color (RED, GREEN, BLUE)\n"
+    "alias Callback = func(int, ptr) void\n"
+    "Counter int = 10\n"
+    "define LIMIT = 42\n"
+    "#set greeting 'hello'\n"
+    "func add(a, b int = 1) int = a + b\n"
+    "func twice(value $T~__number__) $T = value * 2\n"
+    "func describe(c Color) *ubyte {\n"
+    "    switch c {\n"
+    "    case ::RED, return 'red'\n"
+    "    case Color::GREEN, fallthrough\n"
+    "    default return \"other\".array\n"
+    "    }\n"
+    "    return null\n"
+    "}\n"
+    "func loops(n int, values ...) float {\n"
+    "    total double = 0.5\n"
+    "    numbers 3 int\n"
+    "    repeat n, total += idx as double\n"
+    "    each int in static numbers, total += it as double\n"
+    "    while outer : n > 0 {\n"
+    "        for i int = 0; i < 3; i++ {\n"
+    "            if i == 1, continue outer\n"
+    "        }\n"
+    "        unless n != 2 {\n"
+    "            break\n"
+    "        } else {\n"
+    "            total -= 1.0\n"
+    "        }\n"
+    "    }\n"
+    "    while total > 100.0 && n != 0, total /= 2.0\n"
+    "    name *ubyte = n < 0 ? 'negative' : 'positive'\n"
+    "    return cast float (total + sizeof int + 0xFFFFFFFF + -7sb + 3.25f)\n"
+    "}\n";
+
+static void TEST_ast_serialize_round_trip(CuTest *test){
+    compiler_t compiler;
+    compiler_init(&compiler);
+
+    object_t *object = compiler_new_object(&compiler);
+    object->filename = strclone("fake_filename.adept");
+    object->full_filename = strclone("fake_filename.adept");
+    object->buffer = strclone(ast_serialize_test_code);
+    object->buffer_length = strlen(object->buffer);
+
+    CuAssert(test, "Failed to lex", lex_buffer(&compiler, object) == SUCCESS);
+    CuAssert(test, "Failed to parse", parse(&compiler, object) == SUCCESS);
+
+    strong_cstr_t serialized;
+    length_t serialized_length;
+    CuAssert(test, "Failed to serialize", ast_serialize(&object->ast, &serialized, &serialized_length) == SUCCESS);
+
+    // Reading the AST back and serializing it again should give the same bytes
+    arena_t strings = (arena_t){0};
+    ast_t ast;
+    ast_init(&ast, compiler.cross_compile_for);
+    CuAssert(test, "Failed to deserialize", ast_deserialize(&ast, serialized, serialized_length, &strings, -1) == SUCCESS);
+    CuAssertIntEquals(test, object->ast.funcs_length, ast.funcs_length);
+    CuAssertIntEquals(test, object->ast.poly_funcs_length, ast.poly_funcs_length);
+
+    strong_cstr_t reserialized;
+    length_t reserialized_length;
+    CuAssert(test, "Failed to reserialize", ast_serialize(&ast, &reserialized, &reserialized_length) == SUCCESS);
+    CuAssertIntEquals(test, serialized_length, reserialized_length);
+    CuAssert(test, "Serialized ASTs differ", memcmp(serialized, reserialized, serialized_length) == 0);
+
+    // Appending to an AST that already has declarations must keep them intact
+    ast_t appended_ast;
+    ast_init(&appended_ast, compiler.cross_compile_for);
+
+    for(int i = 0; i != 3; i++){
+        CuAssert(test, "Failed to append AST", ast_deserialize(&appended_ast, serialized, serialized_length, &strings, -1) == SUCCESS);
+    }
+
+    CuAssertIntEquals(test, 3 * object->ast.funcs_length, appended_ast.funcs_length);
+    CuAssertStrEquals(test, object->ast.funcs[0].name, appended_ast.funcs[0].name);
+    CuAssertStrEquals(test, object->ast.funcs[object->ast.funcs_length - 1].name, appended_ast.funcs[appended_ast.funcs_length - 1].name);
+
+    // Truncated data must be rejected without crashing
+    ast_t truncated_ast;
+    ast_init(&truncated_ast, compiler.cross_compile_for);
+    CuAssert(test, "Accepted truncated AST", ast_deserialize(&truncated_ast, serialized, serialized_length / 2, &strings, -1) == FAILURE);
+
+    free(serialized);
+    free(reserialized);
+    ast_free(&truncated_ast);
+    ast_free(&appended_ast);
+    ast_free(&ast);
+    arena_free(&strings);
+    compiler_free(&compiler);
+}
+
+CuSuite *CuSuite_for_ast_serialize(void){
+    CuSuite *suite = CuSuiteNew();
+    SUITE_ADD_TEST(suite, TEST_ast_serialize_round_trip);
+    return suite;
+}
@@ -0,0 +1,124 @@
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "AST/TYPE/ast_type_hash.h"
+#include "AST/TYPE/ast_type_make.h"
+#include "AST/TYPE/ast_type_table.h"
+#include "AST/ast_type.h"
+#include "CuTest.h"
+#include "UTIL/ground.h"
+#include "UTIL/util.h"
+
+static ast_type_t ast_type_table_test_type(length_t i){
+    // Makes the 'i'th of many different types
+    strong_cstr_t name = mallocandsprintf("Type%d", (int) (i / 2));
+    ast_type_t type = i % 2 ? ast_type_make_base_ptr(name) : ast_type_make_base(name);
+    free(name);
+    return type;
+}
+
+static void TEST_ast_type_table_growth(CuTest *test){
+    length_t count = 1000;
+    const ast_type_t *canonical_types[1000];
+
+    ast_type_table_t table = {0};
+
+    for(length_t i = 0; i != count; i++){
+        ast_type_t type = ast_type_table_test_type(i);
+        canonical_types[i] = ast_type_table_canonical(&table, &type);
+
+        // Canonical types are copies, with their hashes cached
+        CuAssertTrue(test, canonical_types[i] != &type);
+        CuAssertTrue(test, ast_canonical_type_hash(canonical_types[i]) == ast_type_hash(&type));
+        ast_type_free(&type);
+    }
+
+    CuAssertIntEquals(test, count, table.impl.count);
+
+    // Canonical types stay the same after the table grows
+    for(length_t i = 0; i != count; i++){
+        ast_type_t type = ast_type_table_test_type(i);
+        CuAssertPtrEquals(test, (void*) canonical_types[i], (void*) ast_type_table_find(&table, &type));
+        CuAssertPtrEquals(test, (void*) canonical_types[i], (void*) ast_type_table_canonical(&table, &type));
+        ast_type_free(&type);
+    }
+
+    CuAssertIntEquals(test, count, table.impl.count);
+    ast_type_table_free(&table);
+}
+
+static void TEST_ast_type_table_duplicates(CuTest *test){
+    ast_type_table_t table = {0};
+
+    ast_type_t first = ast_type_make_base_ptr("ubyte");
+    ast_type_t second = ast_type_make_base_ptr("ubyte");
+    first.source.index = 1;
+    second.source.index = 2;
+
+    // Identical types share the first canonical type, which keeps the first source
+    const ast_type_t *canonical = ast_type_table_canonical(&table, &first);
+    CuAssertPtrEquals(test, (void*) canonical, (void*) ast_type_table_canonical(&table, &second));
+    CuAssertPtrEquals(test, (void*) canonical, (void*) ast_type_table_canonical(&table, canonical));
+    CuAssertIntEquals(test, 1, table.impl.count);
+    CuAssertIntEquals(test, 1, canonical->source.index);
+
+    ast_type_free(&first);
+    ast_type_free(&second);
+    ast_type_table_free(&table);
+}
+
+static void TEST_ast_type_table_misses(CuTest *test){
+    ast_type_t int_type = ast_type_make_base("int");
+    ast_type_t int_ptr_type = ast_type_make_base_ptr("int");
+    ast_type_t long_type = ast_type_make_base("long");
+
+    // Zero-initialized type tables are empty
+    ast_type_table_t table = {0};
+    CuAssertPtrEquals(test, NULL, (void*) ast_type_table_find(&table, &int_type));
+
+    ast_type_table_canonical(&table, &int_type);
+    CuAssertPtrEquals(test, NULL, (void*) ast_type_table_find(&table, &int_ptr_type));
+    CuAssertPtrEquals(test, NULL, (void*) ast_type_table_find(&table, &long_type));
+    CuAssertIntEquals(test, 1, table.impl.count);
+
+    ast_type_free(&int_type);
+    ast_type_free(&int_ptr_type);
+    ast_type_free(&long_type);
+    ast_type_table_free(&table);
+}
+
+static void TEST_ast_type_table_identical(CuTest *test){
+    ast_type_t int_type = ast_type_make_base("int");
+    ast_type_t long_type = ast_type_make_base("long");
+    ast_type_t usize_type = ast_type_make_base_ptr("usize");
+    ast_type_t ulong_type = ast_type_make_base_ptr("ulong");
+
+    ast_type_table_t table = {0};
+    const ast_type_t *canonical_int = ast_type_table_canonical(&table, &int_type);
+    const ast_type_t *canonical_long = ast_type_table_canonical(&table, &long_type);
+    const ast_type_t *canonical_usize = ast_type_table_canonical(&table, &usize_type);
+    const ast_type_t *canonical_ulong = ast_type_table_canonical(&table, &ulong_type);
+
+    CuAssertTrue(test, ast_canonical_types_identical(canonical_int, canonical_int));
+    CuAssertTrue(test, !ast_canonical_types_identical(canonical_int, canonical_long));
+
+    // Some different types are still identical (see 'ast_types_identical')
+    CuAssertTrue(test, ast_canonical_types_identical(canonical_usize, canonical_ulong));
+    CuAssertTrue(test, !ast_canonical_types_identical(canonical_usize, canonical_long));
+
+    ast_type_free(&int_type);
+    ast_type_free(&long_type);
+    ast_type_free(&usize_type);
+    ast_type_free(&ulong_type);
+    ast_type_table_free(&table);
+}
+
+CuSuite *CuSuite_for_ast_type_table(void){
+    CuSuite *suite = CuSuiteNew();
+    SUITE_ADD_TEST(suite, TEST_ast_type_table_growth);
+    SUITE_ADD_TEST(suite, TEST_ast_type_table_duplicates);
+    SUITE_ADD_TEST(suite, TEST_ast_type_table_misses);
+    SUITE_ADD_TEST(suite, TEST_ast_type_table_identical);
+    return suite;
+}
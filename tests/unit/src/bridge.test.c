@@ -0,0 +1,126 @@
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "BRIDGE/bridge.h"
+#include "CuTest.h"
+#include "UTIL/ground.h"
+#include "UTIL/intern.h"
+#include "UTIL/util.h"
+
+static weak_cstr_t bridge_test_name(length_t i){
+    strong_cstr_t name = mallocandsprintf("variable%d", (int) i);
+    weak_cstr_t atom = intern_name(name);
+    free(name);
+    return atom;
+}
+
+static bridge_var_t bridge_test_var(weak_cstr_t name, index_id_t id){
+    return (bridge_var_t){
+        .name = name,
+        .ast_type = NULL,
+        .id = id,
+        .static_id = INVALID_INDEX_ID,
+        .traits = TRAIT_NONE,
+        .source = NULL_SOURCE,
+    };
+}
+
+static void TEST_bridge_scope_growth(CuTest *test){
+    length_t count = 1000;
+
+    bridge_scope_t scope;
+    bridge_scope_init(&scope, NULL);
+
+    for(length_t i = 0; i != count; i++){
+        bridge_scope_add_var(&scope, bridge_test_var(bridge_test_name(i), i));
+
+        // Lookups in between additions use the names set once there are enough variables,
+        // so it has to be kept up to date (and rebuilt when the variables move)
+        bridge_var_t *var = bridge_scope_find_var(&scope, bridge_test_name(i / 2));
+        CuAssertPtrEquals(test, &scope.list.variables[i / 2], var);
+    }
+
+    CuAssertIntEquals(test, count, scope.names.count);
+
+    for(length_t i = 0; i != count; i++){
+        weak_cstr_t name = bridge_test_name(i);
+        bridge_var_t *var = bridge_scope_find_var(&scope, name);
+
+        CuAssertPtrEquals(test, &scope.list.variables[i], var);
+        CuAssertPtrEquals(test, (void*) name, (void*) var->name);
+        CuAssertIntEquals(test, i, var->id);
+        CuAssertPtrEquals(test, var, bridge_scope_find_var_by_id(&scope, i));
+    }
+
+    bridge_scope_free(&scope);
+}
+
+static void TEST_bridge_scope_duplicates(CuTest *test){
+    weak_cstr_t name = intern_name("shadowed");
+
+    bridge_scope_t parent;
+    bridge_scope_init(&parent, NULL);
+    bridge_scope_add_var(&parent, bridge_test_var(name, 0));
+
+    bridge_scope_t scope;
+    bridge_scope_init(&scope, &parent);
+
+    // Earlier variables of the same name within a scope win,
+    // both before and after the names of the scope are hashed
+    bridge_scope_add_var(&scope, bridge_test_var(name, 1));
+    bridge_scope_add_var(&scope, bridge_test_var(name, 2));
+    CuAssertIntEquals(test, 1, bridge_scope_find_var(&scope, name)->id);
+
+    for(length_t i = 0; i != BRIDGE_SCOPE_HASH_THRESHOLD * 4; i++){
+        bridge_scope_add_var(&scope, bridge_test_var(i % 2 ? name : bridge_test_name(i), INVALID_INDEX_ID));
+    }
+
+    CuAssertIntEquals(test, 1, bridge_scope_find_var(&scope, name)->id);
+    CuAssertTrue(test, bridge_scope_var_already_in_list(&scope, name));
+
+    // Variables of child scopes shadow those of their parent scopes
+    CuAssertIntEquals(test, 0, bridge_scope_find_var(&parent, name)->id);
+
+    bridge_scope_free(&scope);
+    bridge_scope_free(&parent);
+}
+
+static void TEST_bridge_scope_misses(CuTest *test){
+    weak_cstr_t missing = intern_name("missing");
+    weak_cstr_t in_parent = intern_name("in_parent");
+
+    bridge_scope_t parent;
+    bridge_scope_init(&parent, NULL);
+    CuAssertPtrEquals(test, NULL, bridge_scope_find_var(&parent, missing));
+
+    bridge_scope_add_var(&parent, bridge_test_var(in_parent, INVALID_INDEX_ID));
+
+    bridge_scope_t scope;
+    bridge_scope_init(&scope, &parent);
+
+    for(length_t i = 0; i != BRIDGE_SCOPE_HASH_THRESHOLD * 4; i++){
+        bridge_scope_add_var(&scope, bridge_test_var(bridge_test_name(i), INVALID_INDEX_ID));
+    }
+
+    CuAssertPtrEquals(test, NULL, bridge_scope_find_var(&scope, missing));
+    CuAssertTrue(test, !bridge_scope_var_already_in_list(&scope, missing));
+
+    // Variables of parent scopes are found, but aren't in the list of the scope itself
+    CuAssertPtrEquals(test, &parent.list.variables[0], bridge_scope_find_var(&scope, in_parent));
+    CuAssertTrue(test, !bridge_scope_var_already_in_list(&scope, in_parent));
+
+    // Variables without ids can't be found by id
+    CuAssertPtrEquals(test, NULL, bridge_scope_find_var_by_id(&parent, 0));
+
+    bridge_scope_free(&scope);
+    bridge_scope_free(&parent);
+}
+
+CuSuite *CuSuite_for_bridge(void){
+    CuSuite *suite = CuSuiteNew();
+    SUITE_ADD_TEST(suite, TEST_bridge_scope_growth);
+    SUITE_ADD_TEST(suite, TEST_bridge_scope_duplicates);
+    SUITE_ADD_TEST(suite, TEST_bridge_scope_misses);
+    return suite;
+}
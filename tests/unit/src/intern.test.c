@@ -0,0 +1,93 @@
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "CuTest.h"
+#include "UTIL/ground.h"
+#include "UTIL/intern.h"
+#include "UTIL/string.h"
+#include "UTIL/util.h"
+
+static void TEST_intern_growth(CuTest *test){
+    length_t count = 1000;
+    weak_cstr_t atoms[1000];
+
+    intern_table_t table = {0};
+
+    for(length_t i = 0; i != count; i++){
+        strong_cstr_t string = mallocandsprintf("atom%d", (int) i);
+        atoms[i] = intern(&table, string);
+
+        // Atoms are copies
+        CuAssertTrue(test, atoms[i] != string);
+        CuAssertStrEquals(test, string, atoms[i]);
+        free(string);
+    }
+
+    CuAssertIntEquals(test, count, table.atoms.count);
+
+    // Atoms stay the same after the table grows
+    for(length_t i = 0; i != count; i++){
+        strong_cstr_t string = mallocandsprintf("atom%d", (int) i);
+        CuAssertPtrEquals(test, (void*) atoms[i], (void*) intern_find(&table, string));
+        CuAssertPtrEquals(test, (void*) atoms[i], (void*) intern(&table, string));
+        free(string);
+    }
+
+    CuAssertIntEquals(test, count, table.atoms.count);
+    intern_table_free(&table);
+}
+
+static void TEST_intern_duplicates(CuTest *test){
+    intern_table_t table = {0};
+
+    // Interning the same contents again gives back the first atom
+    strong_cstr_t first = strclone("duplicate");
+    strong_cstr_t second = strclone("duplicate");
+
+    weak_cstr_t atom = intern(&table, first);
+    CuAssertPtrEquals(test, (void*) atom, (void*) intern(&table, second));
+    CuAssertPtrEquals(test, (void*) atom, (void*) intern(&table, atom));
+    CuAssertIntEquals(test, 1, table.atoms.count);
+
+    free(first);
+    free(second);
+    intern_table_free(&table);
+}
+
+static void TEST_intern_misses(CuTest *test){
+    // Zero-initialized intern tables are empty
+    intern_table_t table = {0};
+    CuAssertPtrEquals(test, NULL, (void*) intern_find(&table, "missing"));
+
+    intern(&table, "present");
+    CuAssertPtrEquals(test, NULL, (void*) intern_find(&table, "missing"));
+    CuAssertPtrEquals(test, NULL, (void*) intern_find(&table, "presen"));
+    CuAssertPtrEquals(test, NULL, (void*) intern_find(&table, "present "));
+    CuAssertPtrEquals(test, NULL, (void*) intern_find(&table, ""));
+
+    intern_table_free(&table);
+}
+
+static void TEST_intern_name(CuTest *test){
+    // Names are interned into a process-wide table
+    CuAssertPtrEquals(test, NULL, (void*) intern_name_find("intern_name_test_never_interned"));
+
+    weak_cstr_t atom = intern_name("intern_name_test");
+    strong_cstr_t copy = strclone("intern_name_test");
+
+    CuAssertPtrEquals(test, (void*) atom, (void*) intern_name(copy));
+    CuAssertPtrEquals(test, (void*) atom, (void*) intern_name_find(copy));
+    CuAssertPtrEquals(test, NULL, (void*) intern_name_find("intern_name_tes"));
+
+    free(copy);
+}
+
+CuSuite *CuSuite_for_intern(void){
+    CuSuite *suite = CuSuiteNew();
+    SUITE_ADD_TEST(suite, TEST_intern_growth);
+    SUITE_ADD_TEST(suite, TEST_intern_duplicates);
+    SUITE_ADD_TEST(suite, TEST_intern_misses);
+    SUITE_ADD_TEST(suite, TEST_intern_name);
+    return suite;
+}
@@ -0,0 +1,389 @@
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "AST/TYPE/ast_type_make.h"
+#include "AST/TYPE/ast_type_table.h"
+#include "AST/ast.h"
+#include "AST/ast_poly_catalog.h"
+#include "AST/ast_type.h"
+#include "CuTest.h"
+#include "IR/ir_func_endpoint.h"
+#include "IRGEN/ir_cache.h"
+#include "UTIL/ground.h"
+#include "UTIL/util.h"
+
+static ast_type_t ir_cache_test_type(length_t i){
+    strong_cstr_t name = mallocandsprintf("Cached%d", (int) i);
+    ast_type_t type = ast_type_make_base(name);
+    free(name);
+    return type;
+}
+
+static void TEST_ir_gen_sf_cache_growth(CuTest *test){
+    length_t count = 1000;
+    ir_gen_sf_cache_entry_t *entries[1000];
+
+    ast_type_table_t type_table = {0};
+    ir_gen_sf_cache_t cache;
+    ir_gen_sf_cache_init(&cache, &type_table, 4);
+
+    for(length_t i = 0; i != count; i++){
+        ast_type_t type = ir_cache_test_type(i);
+        entries[i] = ir_gen_sf_cache_locate_or_insert(&cache, &type);
+        entries[i]->pass = (func_pair_t){ .ast_func_id = i, .ir_func_id = i };
+        ast_type_free(&type);
+    }
+
+    CuAssertIntEquals(test, count, cache.entries.count);
+    CuAssertIntEquals(test, count, cache.misses);
+
+    // Entries stay where they are as the cache grows
+    for(length_t i = 0; i != count; i++){
+        ast_type_t type = ir_cache_test_type(i);
+        CuAssertPtrEquals(test, entries[i], ir_gen_sf_cache_locate(&cache, &type));
+        CuAssertPtrEquals(test, entries[i], ir_gen_sf_cache_locate_or_insert(&cache, &type));
+        CuAssertIntEquals(test, i, entries[i]->pass.ast_func_id);
+        ast_type_free(&type);
+    }
+
+    CuAssertIntEquals(test, count, cache.entries.count);
+    CuAssertIntEquals(test, count, cache.hits);
+
+    ir_gen_sf_cache_free(&cache);
+    ast_type_table_free(&type_table);
+}
+
+static void TEST_ir_gen_sf_cache_duplicates(CuTest *test){
+    ast_type_t first = ast_type_make_base_ptr("ubyte");
+    ast_type_t second = ast_type_make_base_ptr("ubyte");
+
+    ast_type_table_t type_table = {0};
+    ir_gen_sf_cache_t cache;
+    ir_gen_sf_cache_init(&cache, &type_table, 4);
+
+    // Identical types share the first entry
+    ir_gen_sf_cache_entry_t *entry = ir_gen_sf_cache_locate_or_insert(&cache, &first);
+    entry->has_pass = TROOLEAN_TRUE;
+
+    CuAssertPtrEquals(test, entry, ir_gen_sf_cache_locate_or_insert(&cache, &second));
+    CuAssertIntEquals(test, TROOLEAN_TRUE, entry->has_pass);
+    CuAssertIntEquals(test, 1, cache.entries.count);
+
+    ast_type_free(&first);
+    ast_type_free(&second);
+    ir_gen_sf_cache_free(&cache);
+    ast_type_table_free(&type_table);
+}
+
+static void TEST_ir_gen_sf_cache_misses(CuTest *test){
+    ast_type_t present = ast_type_make_base("int");
+    ast_type_t missing = ast_type_make_base_ptr("int");
+
+    ast_type_table_t type_table = {0};
+    ir_gen_sf_cache_t cache;
+    ir_gen_sf_cache_init(&cache, &type_table, 4);
+    CuAssertPtrEquals(test, NULL, ir_gen_sf_cache_locate(&cache, &present));
+
+    ir_gen_sf_cache_locate_or_insert(&cache, &present);
+    CuAssertPtrEquals(test, NULL, ir_gen_sf_cache_locate(&cache, &missing));
+
+    // Types that are known but have no entry are misses too
+    ast_type_table_canonical(&type_table, &missing);
+    CuAssertPtrEquals(test, NULL, ir_gen_sf_cache_locate(&cache, &missing));
+    CuAssertIntEquals(test, 1, cache.entries.count);
+
+    ast_type_free(&present);
+    ast_type_free(&missing);
+    ir_gen_sf_cache_free(&cache);
+    ast_type_table_free(&type_table);
+}
+
+static void TEST_ir_gen_poly_cache_growth(CuTest *test){
+    length_t count = 500;
+    ir_gen_poly_cache_entry_t *entries[500];
+
+    ast_type_table_t type_table = {0};
+    ir_gen_poly_cache_t cache;
+    ir_gen_poly_cache_init(&cache, &type_table, 4);
+
+    for(length_t i = 0; i != count; i++){
+        ast_type_t type = ir_cache_test_type(i);
+
+        ast_poly_catalog_t catalog;
+        ast_poly_catalog_init(&catalog);
+        ast_poly_catalog_add_type(&catalog, "T", &type);
+        ast_poly_catalog_add_count(&catalog, "N", i % 3);
+
+        entries[i] = ir_gen_poly_cache_locate_or_insert(&cache, i % 2, &catalog);
+        CuAssertIntEquals(test, INVALID_FUNC_ID, entries[i]->instance.ir_func_id);
+        entries[i]->instance = (ir_func_endpoint_t){ .ast_func_id = i, .ir_func_id = i };
+
+        ast_poly_catalog_free(&catalog);
+        ast_type_free(&type);
+    }
+
+    CuAssertIntEquals(test, count, cache.entries.count);
+
+    // Entries stay where they are as the cache grows, and the order of bindings doesn't matter
+    for(length_t i = 0; i != count; i++){
+        ast_type_t type = ir_cache_test_type(i);
+
+        ast_poly_catalog_t catalog;
+        ast_poly_catalog_init(&catalog);
+        ast_poly_catalog_add_count(&catalog, "N", i % 3);
+        ast_poly_catalog_add_type(&catalog, "T", &type);
+
+        CuAssertPtrEquals(test, entries[i], ir_gen_poly_cache_locate(&cache, i % 2, &catalog));
+        CuAssertPtrEquals(test, entries[i], ir_gen_poly_cache_locate_or_insert(&cache, i % 2, &catalog));
+        CuAssertIntEquals(test, i, entries[i]->instance.ir_func_id);
+
+        ast_poly_catalog_free(&catalog);
+        ast_type_free(&type);
+    }
+
+    CuAssertIntEquals(test, count, cache.entries.count);
+
+    ir_gen_poly_cache_free(&cache);
+    ast_type_table_free(&type_table);
+}
+
+static void TEST_ir_gen_poly_cache_duplicates(CuTest *test){
+    ast_type_t first_type = ast_type_make_base("int");
+    ast_type_t second_type = ast_type_make_base("int");
+
+    ast_type_table_t type_table = {0};
+    ir_gen_poly_cache_t cache;
+    ir_gen_poly_cache_init(&cache, &type_table, 4);
+
+    ast_poly_catalog_t first;
+    ast_poly_catalog_init(&first);
+    ast_poly_catalog_add_type(&first, "T", &first_type);
+
+    ast_poly_catalog_t second;
+    ast_poly_catalog_init(&second);
+    ast_poly_catalog_add_type(&second, "T", &second_type);
+
+    // Identical bindings share the first entry
+    ir_gen_poly_cache_entry_t *entry = ir_gen_poly_cache_locate_or_insert(&cache, 7, &first);
+    entry->instance = (ir_func_endpoint_t){ .ast_func_id = 7, .ir_func_id = 3 };
+
+    CuAssertPtrEquals(test, entry, ir_gen_poly_cache_locate_or_insert(&cache, 7, &second));
+    CuAssertIntEquals(test, 3, entry->instance.ir_func_id);
+    CuAssertIntEquals(test, 1, cache.entries.count);
+
+    ast_poly_catalog_free(&first);
+    ast_poly_catalog_free(&second);
+    ast_type_free(&first_type);
+    ast_type_free(&second_type);
+    ir_gen_poly_cache_free(&cache);
+    ast_type_table_free(&type_table);
+}
+
+static void TEST_ir_gen_poly_cache_misses(CuTest *test){
+    ast_type_t int_type = ast_type_make_base("int");
+    ast_type_t long_type = ast_type_make_base("long");
+
+    ast_type_table_t type_table = {0};
+    ir_gen_poly_cache_t cache;
+    ir_gen_poly_cache_init(&cache, &type_table, 4);
+
+    ast_poly_catalog_t catalog;
+    ast_poly_catalog_init(&catalog);
+    ast_poly_catalog_add_type(&catalog, "T", &int_type);
+    CuAssertPtrEquals(test, NULL, ir_gen_poly_cache_locate(&cache, 0, &catalog));
+
+    ir_gen_poly_cache_locate_or_insert(&cache, 0, &catalog);
+
+    // Different polymorphic function
+    CuAssertPtrEquals(test, NULL, ir_gen_poly_cache_locate(&cache, 1, &catalog));
+
+    // Different binding
+    ast_poly_catalog_t other;
+    ast_poly_catalog_init(&other);
+    ast_poly_catalog_add_type(&other, "T", &long_type);
+    CuAssertPtrEquals(test, NULL, ir_gen_poly_cache_locate(&cache, 0, &other));
+    ast_poly_catalog_free(&other);
+
+    // Different binding name
+    ast_poly_catalog_init(&other);
+    ast_poly_catalog_add_type(&other, "U", &int_type);
+    CuAssertPtrEquals(test, NULL, ir_gen_poly_cache_locate(&cache, 0, &other));
+    ast_poly_catalog_free(&other);
+
+    // Extra binding
+    ast_poly_catalog_add_count(&catalog, "N", 4);
+    CuAssertPtrEquals(test, NULL, ir_gen_poly_cache_locate(&cache, 0, &catalog));
+    CuAssertIntEquals(test, 1, cache.entries.count);
+
+    ast_poly_catalog_free(&catalog);
+    ast_type_free(&int_type);
+    ast_type_free(&long_type);
+    ir_gen_poly_cache_free(&cache);
+    ast_type_table_free(&type_table);
+}
+
+static ir_gen_proc_cache_key_t ir_cache_test_proc_key(const ir_func_endpoint_list_t *candidates){
+    return (ir_gen_proc_cache_key_t){
+        .candidates = candidates,
+        .conform_mode = 0,
+        .traits_mask = 0,
+        .traits_match = 0,
+        .forbid_traits = 0,
+        .conform = false,
+        .is_method = false,
+    };
+}
+
+static void TEST_ir_gen_proc_cache_growth(CuTest *test){
+    length_t count = 1000;
+    ir_gen_proc_cache_entry_t *entries[1000];
+    ir_func_endpoint_list_t candidates = {0};
+
+    ast_type_table_t type_table = {0};
+    ir_gen_proc_cache_t cache;
+    ir_gen_proc_cache_init(&cache, &type_table, 4);
+
+    ir_gen_proc_cache_key_t key = ir_cache_test_proc_key(&candidates);
+
+    for(length_t i = 0; i != count; i++){
+        ast_type_t arg_types[2] = {ir_cache_test_type(i), ir_cache_test_type(i + 1)};
+
+        entries[i] = ir_gen_proc_cache_locate_or_insert(&cache, &key, arg_types, 2, NULL);
+        CuAssertIntEquals(test, 0, entries[i]->candidates_length);
+        entries[i]->candidates_length = 1;
+        entries[i]->chosen = i;
+
+        ast_types_free(arg_types, 2);
+    }
+
+    CuAssertIntEquals(test, count, cache.entries.count);
+
+    // Entries stay where they are as the cache grows
+    for(length_t i = 0; i != count; i++){
+        ast_type_t arg_types[2] = {ir_cache_test_type(i), ir_cache_test_type(i + 1)};
+
+        CuAssertPtrEquals(test, entries[i], ir_gen_proc_cache_locate(&cache, &key, arg_types, 2, NULL));
+        CuAssertPtrEquals(test, entries[i], ir_gen_proc_cache_locate_or_insert(&cache, &key, arg_types, 2, NULL));
+        CuAssertIntEquals(test, i, entries[i]->chosen);
+
+        ast_types_free(arg_types, 2);
+    }
+
+    CuAssertIntEquals(test, count, cache.entries.count);
+
+    ir_gen_proc_cache_free(&cache);
+    ast_type_table_free(&type_table);
+}
+
+static void TEST_ir_gen_proc_cache_duplicates(CuTest *test){
+    ir_func_endpoint_list_t candidates = {0};
+    ast_type_t first = ast_type_make_base_ptr("ubyte");
+    ast_type_t second = ast_type_make_base_ptr("ubyte");
+    ast_type_t gives = ast_type_make_base("int");
+
+    ast_type_table_t type_table = {0};
+    ir_gen_proc_cache_t cache;
+    ir_gen_proc_cache_init(&cache, &type_table, 4);
+
+    ir_gen_proc_cache_key_t key = ir_cache_test_proc_key(&candidates);
+
+    // Identical argument types share the first entry
+    ir_gen_proc_cache_entry_t *entry = ir_gen_proc_cache_locate_or_insert(&cache, &key, &first, 1, &gives);
+    entry->candidates_length = 4;
+    entry->chosen = 2;
+
+    CuAssertPtrEquals(test, entry, ir_gen_proc_cache_locate_or_insert(&cache, &key, &second, 1, &gives));
+    CuAssertIntEquals(test, 2, entry->chosen);
+    CuAssertIntEquals(test, 1, cache.entries.count);
+
+    ast_type_free(&first);
+    ast_type_free(&second);
+    ast_type_free(&gives);
+    ir_gen_proc_cache_free(&cache);
+    ast_type_table_free(&type_table);
+}
+
+static void TEST_ir_gen_proc_cache_misses(CuTest *test){
+    ir_func_endpoint_list_t candidates = {0};
+    ir_func_endpoint_list_t other_candidates = {0};
+    ast_type_t int_type = ast_type_make_base("int");
+    ast_type_t long_type = ast_type_make_base("long");
+
+    ast_type_table_t type_table = {0};
+    ir_gen_proc_cache_t cache;
+    ir_gen_proc_cache_init(&cache, &type_table, 4);
+
+    ir_gen_proc_cache_key_t key = ir_cache_test_proc_key(&candidates);
+    CuAssertPtrEquals(test, NULL, ir_gen_proc_cache_locate(&cache, &key, &int_type, 1, NULL));
+
+    ir_gen_proc_cache_locate_or_insert(&cache, &key, &int_type, 1, NULL);
+    ast_type_table_canonical(&type_table, &long_type);
+
+    // Different argument types, return type, or key
+    CuAssertPtrEquals(test, NULL, ir_gen_proc_cache_locate(&cache, &key, &long_type, 1, NULL));
+    CuAssertPtrEquals(test, NULL, ir_gen_proc_cache_locate(&cache, &key, &int_type, 1, &int_type));
+    CuAssertPtrEquals(test, NULL, ir_gen_proc_cache_locate(&cache, &key, &int_type, 0, NULL));
+
+    ir_gen_proc_cache_key_t other_key = ir_cache_test_proc_key(&other_candidates);
+    CuAssertPtrEquals(test, NULL, ir_gen_proc_cache_locate(&cache, &other_key, &int_type, 1, NULL));
+
+    other_key = key;
+    other_key.conform = true;
+    CuAssertPtrEquals(test, NULL, ir_gen_proc_cache_locate(&cache, &other_key, &int_type, 1, NULL));
+    CuAssertIntEquals(test, 1, cache.entries.count);
+
+    ast_type_free(&int_type);
+    ast_type_free(&long_type);
+    ir_gen_proc_cache_free(&cache);
+    ast_type_table_free(&type_table);
+}
+
+static void TEST_ir_gen_proc_cache_func_arg_types(CuTest *test){
+    length_t count = 100;
+    ast_type_t arg_types[2] = {ast_type_make_base("int"), ast_type_make_base_ptr("ubyte")};
+    ast_func_t func = (ast_func_t){
+        .arg_types = arg_types,
+        .arity = 2,
+    };
+
+    ast_type_table_t type_table = {0};
+    ir_gen_proc_cache_t cache;
+    ir_gen_proc_cache_init(&cache, &type_table, 4);
+
+    // Nothing is canonicalized unless it may be
+    CuAssertPtrEquals(test, NULL, (void*) ir_gen_proc_cache_func_arg_types(&cache, &func, 3, false));
+
+    const ast_type_t **canonical = ir_gen_proc_cache_func_arg_types(&cache, &func, 3, true);
+    CuAssertTrue(test, canonical != NULL);
+    CuAssertPtrEquals(test, (void*) ast_type_table_find(&type_table, &arg_types[0]), (void*) canonical[0]);
+    CuAssertPtrEquals(test, (void*) ast_type_table_find(&type_table, &arg_types[1]), (void*) canonical[1]);
+
+    // Canonical argument types stay where they are as more functions are added
+    for(length_t i = 0; i != count; i++){
+        CuAssertTrue(test, ir_gen_proc_cache_func_arg_types(&cache, &func, i, true) != NULL);
+    }
+
+    CuAssertPtrEquals(test, (void*) canonical, (void*) ir_gen_proc_cache_func_arg_types(&cache, &func, 3, false));
+    CuAssertPtrEquals(test, NULL, (void*) ir_gen_proc_cache_func_arg_types(&cache, &func, count, false));
+    CuAssertIntEquals(test, 2, type_table.impl.count);
+
+    ast_types_free(arg_types, 2);
+    ir_gen_proc_cache_free(&cache);
+    ast_type_table_free(&type_table);
+}
+
+CuSuite *CuSuite_for_ir_cache(void){
+    CuSuite *suite = CuSuiteNew();
+    SUITE_ADD_TEST(suite, TEST_ir_gen_sf_cache_growth);
+    SUITE_ADD_TEST(suite, TEST_ir_gen_sf_cache_duplicates);
+    SUITE_ADD_TEST(suite, TEST_ir_gen_sf_cache_misses);
+    SUITE_ADD_TEST(suite, TEST_ir_gen_poly_cache_growth);
+    SUITE_ADD_TEST(suite, TEST_ir_gen_poly_cache_duplicates);
+    SUITE_ADD_TEST(suite, TEST_ir_gen_poly_cache_misses);
+    SUITE_ADD_TEST(suite, TEST_ir_gen_proc_cache_growth);
+    SUITE_ADD_TEST(suite, TEST_ir_gen_proc_cache_duplicates);
+    SUITE_ADD_TEST(suite, TEST_ir_gen_proc_cache_misses);
+    SUITE_ADD_TEST(suite, TEST_ir_gen_proc_cache_func_arg_types);
+    return suite;
+}
@@ -0,0 +1,107 @@
+
+#include <stdlib.h>
+
+#include "CuTest.h"
+#include "IR/ir_func_endpoint.h"
+#include "IR/ir_proc_map.h"
+#include "UTIL/ground.h"
+#include "UTIL/intern.h"
+#include "UTIL/util.h"
+
+static ir_func_key_t ir_proc_map_test_key(length_t i){
+    strong_cstr_t name = mallocandsprintf("proc%d", (int) i);
+    ir_func_key_t key = (ir_func_key_t){ .name = intern_name(name) };
+    free(name);
+    return key;
+}
+
+static ir_func_endpoint_t ir_proc_map_test_endpoint(length_t id){
+    return (ir_func_endpoint_t){
+        .ast_func_id = id,
+        .ir_func_id = id,
+    };
+}
+
+static void TEST_ir_proc_map_growth(CuTest *test){
+    length_t count = 1000;
+
+    ir_proc_map_t map;
+    ir_proc_map_init(&map, sizeof(ir_func_key_t), 0, &hash_ir_func_key, &equals_ir_func_key);
+
+    for(length_t i = 0; i != count; i++){
+        ir_func_key_t key = ir_proc_map_test_key(i);
+        ir_proc_map_insert(&map, &key, ir_proc_map_test_endpoint(i));
+    }
+
+    CuAssertIntEquals(test, count, map.length);
+    CuAssertIntEquals(test, count, map.keys.count);
+
+    for(length_t i = 0; i != count; i++){
+        ir_func_key_t key = ir_proc_map_test_key(i);
+        ir_func_endpoint_list_t *endpoint_list = ir_proc_map_find(&map, &key);
+
+        // Endpoint lists are kept in insertion order
+        CuAssertPtrEquals(test, map.endpoint_lists[i], endpoint_list);
+        CuAssertIntEquals(test, 1, endpoint_list->length);
+        CuAssertIntEquals(test, i, endpoint_list->endpoints[0].ast_func_id);
+    }
+
+    ir_proc_map_free(&map);
+}
+
+static void TEST_ir_proc_map_duplicates(CuTest *test){
+    ir_func_key_t key = ir_proc_map_test_key(0);
+
+    ir_proc_map_t map;
+    ir_proc_map_init(&map, sizeof(ir_func_key_t), 4, &hash_ir_func_key, &equals_ir_func_key);
+
+    ir_proc_map_insert(&map, &key, ir_proc_map_test_endpoint(5));
+    ir_func_endpoint_list_t *endpoint_list = ir_proc_map_find(&map, &key);
+
+    // Keys that already exist get more endpoints (non-polymorphic ones first, then in the
+    // order that they were defined), and the endpoint list stays where it was
+    for(length_t i = 0; i != 100; i++){
+        ir_func_key_t other = ir_proc_map_test_key(i + 1);
+        ir_proc_map_insert(&map, &other, ir_proc_map_test_endpoint(i));
+    }
+
+    ir_proc_map_insert(&map, &key, (ir_func_endpoint_t){ .ast_func_id = 1, .ir_func_id = INVALID_FUNC_ID });
+    ir_proc_map_insert(&map, &key, ir_proc_map_test_endpoint(9));
+    ir_proc_map_insert(&map, &key, ir_proc_map_test_endpoint(2));
+
+    CuAssertIntEquals(test, 101, map.length);
+    CuAssertPtrEquals(test, endpoint_list, ir_proc_map_find(&map, &key));
+    CuAssertIntEquals(test, 4, endpoint_list->length);
+    CuAssertIntEquals(test, 2, endpoint_list->endpoints[0].ast_func_id);
+    CuAssertIntEquals(test, 5, endpoint_list->endpoints[1].ast_func_id);
+    CuAssertIntEquals(test, 9, endpoint_list->endpoints[2].ast_func_id);
+    CuAssertIntEquals(test, 1, endpoint_list->endpoints[3].ast_func_id);
+
+    ir_proc_map_free(&map);
+}
+
+static void TEST_ir_proc_map_misses(CuTest *test){
+    ir_method_key_t key = (ir_method_key_t){
+        .struct_name = "Shape",
+        .method_name = "area",
+    };
+
+    ir_proc_map_t map;
+    ir_proc_map_init(&map, sizeof(ir_method_key_t), 4, &hash_ir_method_key, &equals_ir_method_key);
+    CuAssertPtrEquals(test, NULL, ir_proc_map_find(&map, &key));
+
+    ir_proc_map_insert(&map, &key, ir_proc_map_test_endpoint(0));
+    CuAssertPtrEquals(test, NULL, ir_proc_map_find(&map, &(ir_method_key_t){ .struct_name = "Shape", .method_name = "perimeter" }));
+    CuAssertPtrEquals(test, NULL, ir_proc_map_find(&map, &(ir_method_key_t){ .struct_name = "Circle", .method_name = "area" }));
+    CuAssertPtrEquals(test, NULL, ir_proc_map_find(&map, &(ir_method_key_t){ .struct_name = "area", .method_name = "Shape" }));
+
+    ir_proc_map_free(&map);
+}
+
+CuSuite *CuSuite_for_ir_proc_map(void){
+    CuSuite *suite = CuSuiteNew();
+    SUITE_ADD_TEST(suite, TEST_ir_proc_map_growth);
+    SUITE_ADD_TEST(suite, TEST_ir_proc_map_duplicates);
+    SUITE_ADD_TEST(suite, TEST_ir_proc_map_misses);
+    return suite;
+}
@@ -0,0 +1,99 @@
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "CuTest.h"
+#include "IR/ir_type.h"
+#include "IR/ir_type_map.h"
+#include "UTIL/ground.h"
+#include "UTIL/intern.h"
+#include "UTIL/util.h"
+
+static weak_cstr_t ir_type_map_test_name(length_t i){
+    strong_cstr_t name = mallocandsprintf("Mapped%d", (int) i);
+    weak_cstr_t atom = intern_name(name);
+    free(name);
+    return atom;
+}
+
+static void TEST_ir_type_map_growth(CuTest *test){
+    length_t count = 1000;
+    ir_type_t types[1000];
+
+    ir_type_map_t type_map = {0};
+
+    for(length_t i = 0; i != count; i++){
+        types[i] = (ir_type_t){ .kind = TYPE_KIND_S32 };
+        ir_type_map_append(&type_map, ir_type_mapping_create(ir_type_map_test_name(i), &types[i]));
+    }
+
+    ir_type_map_index(&type_map);
+    CuAssertIntEquals(test, count, type_map.by_name.count);
+
+    for(length_t i = 0; i != count; i++){
+        ir_type_t *type = NULL;
+        CuAssertTrue(test, ir_type_map_find(&type_map, ir_type_map_test_name(i), &type));
+        CuAssertPtrEquals(test, &types[i], type);
+    }
+
+    // Indexing again after more mappings are appended keeps every mapping
+    ir_type_t extra = (ir_type_t){ .kind = TYPE_KIND_BOOLEAN };
+    ir_type_map_append(&type_map, ir_type_mapping_create(ir_type_map_test_name(count), &extra));
+    ir_type_map_index(&type_map);
+
+    ir_type_t *type = NULL;
+    CuAssertIntEquals(test, count + 1, type_map.by_name.count);
+    CuAssertTrue(test, ir_type_map_find(&type_map, ir_type_map_test_name(count), &type));
+    CuAssertPtrEquals(test, &extra, type);
+    CuAssertTrue(test, ir_type_map_find(&type_map, ir_type_map_test_name(0), &type));
+    CuAssertPtrEquals(test, &types[0], type);
+
+    ir_type_map_free(&type_map);
+}
+
+static void TEST_ir_type_map_duplicates(CuTest *test){
+    weak_cstr_t name = intern_name("MappedTwice");
+    ir_type_t first = (ir_type_t){ .kind = TYPE_KIND_U8 };
+    ir_type_t second = (ir_type_t){ .kind = TYPE_KIND_U16 };
+
+    ir_type_map_t type_map = {0};
+
+    // The first mapping wins
+    ir_type_map_append(&type_map, ir_type_mapping_create(name, &first));
+    ir_type_map_append(&type_map, ir_type_mapping_create(name, &second));
+    ir_type_map_index(&type_map);
+
+    ir_type_t *type = NULL;
+    CuAssertIntEquals(test, 1, type_map.by_name.count);
+    CuAssertTrue(test, ir_type_map_find(&type_map, name, &type));
+    CuAssertPtrEquals(test, &first, type);
+
+    ir_type_map_free(&type_map);
+}
+
+static void TEST_ir_type_map_misses(CuTest *test){
+    weak_cstr_t name = intern_name("MappedOnce");
+    ir_type_t present = (ir_type_t){ .kind = TYPE_KIND_U8 };
+    ir_type_t *type = &present;
+
+    // Zero-initialized type maps are empty
+    ir_type_map_t type_map = {0};
+    CuAssertTrue(test, !ir_type_map_find(&type_map, name, &type));
+
+    ir_type_map_append(&type_map, ir_type_mapping_create(name, &present));
+    ir_type_map_index(&type_map);
+
+    type = NULL;
+    CuAssertTrue(test, !ir_type_map_find(&type_map, intern_name("NeverMapped"), &type));
+    CuAssertPtrEquals(test, NULL, type);
+
+    ir_type_map_free(&type_map);
+}
+
+CuSuite *CuSuite_for_ir_type_map(void){
+    CuSuite *suite = CuSuiteNew();
+    SUITE_ADD_TEST(suite, TEST_ir_type_map_growth);
+    SUITE_ADD_TEST(suite, TEST_ir_type_map_duplicates);
+    SUITE_ADD_TEST(suite, TEST_ir_type_map_misses);
+    return suite;
+}
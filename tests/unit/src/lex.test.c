@@ -6,6 +6,7 @@
 #include "DRVR/compiler.h"
 #include "DRVR/object.h"
 #include "LEX/lex.h"
+#include "LEX/lex_scan.h"
 #include "LEX/token.h"
 #include "TOKEN/token_data.h"
 #include "UTIL/ground.h"
@@ -41,9 +42,9 @@ static void TEST_lex_1(CuTest *test){
     CuAssertTrue(test, object->tokenlist.length == sizeof(expected_token_ids) / sizeof(tokenid_t));
 
     for(length_t i = 0; i < object->tokenlist.length; i++){
-        CuAssertTrue(test, object->tokenlist.tokens[i].id == expected_token_ids[i]);
+        CuAssertTrue(test, object->tokenlist.ids[i] == expected_token_ids[i]);
         
-        source_t actual = object->tokenlist.sources[i];
+        source_t actual = tokenlist_source(&object->tokenlist, i);
         source_t expected = expected_sources[i];
 
         CuAssertIntEquals_Msgf(test, "incorrect sources[%d].object_index", expected.object_index, actual.object_index, i);
@@ -91,9 +92,9 @@ static void TEST_lex_2(CuTest *test){
     CuAssertIntEquals(test, sizeof(expected_token_ids) / sizeof(tokenid_t), sizeof(expected_sources) / sizeof(source_t));
 
     for(length_t i = 0; i < object->tokenlist.length; i++){
-        CuAssertTrue(test, object->tokenlist.tokens[i].id == expected_token_ids[i]);
+        CuAssertTrue(test, object->tokenlist.ids[i] == expected_token_ids[i]);
 
-        source_t actual = object->tokenlist.sources[i];
+        source_t actual = tokenlist_source(&object->tokenlist, i);
         source_t expected = expected_sources[i];
 
         CuAssertIntEquals_Msgf(test, "incorrect sources[%d].object_index", expected.object_index, actual.object_index, i);
@@ -104,9 +105,130 @@ static void TEST_lex_2(CuTest *test){
     compiler_free(&compiler);
 }
 
+static void TEST_lex_keyword_index(CuTest *test){
+    for(length_t i = 0; i != global_token_keywords_list_length; i++){
+        const char *keyword = global_token_keywords_list[i];
+        CuAssertIntEquals_Msgf(test, "incorrect keyword index for '%s'", (int) i, (int) lex_keyword_index(keyword, strlen(keyword)), keyword);
+    }
+
+    const char *not_keywords[] = {
+        "x", "i", "elif", "functions", "Func", "pod", "define_", "va_", "va_arg2", "thread_locals",
+        "deletes", "delete\\x", "my:func", "ifs", "a_", "xyzzy", "printf", "String", "main", "in_",
+    };
+
+    for(length_t i = 0; i != NUM_ITEMS(not_keywords); i++){
+        const char *word = not_keywords[i];
+        CuAssertIntEquals_Msgf(test, "'%s' should not be a keyword", -1, (int) lex_keyword_index(word, strlen(word)), word);
+    }
+
+    // Words don't have to be null-terminated
+    CuAssertIntEquals(test, (int) lex_keyword_index("func", 4), (int) lex_keyword_index("funcptr", 4));
+    CuAssertIntEquals(test, -1, (int) lex_keyword_index("funcptr", 5));
+}
+
+static void TEST_lex_newline_index(CuTest *test){
+    compiler_t compiler;
+    compiler_init(&compiler);
+
+    object_t *object = compiler_new_object(&compiler);
+    object->filename = strclone("fake_filename.adept");
+    object->full_filename = strclone("fake_filename.adept");
+    object->buffer = strclone("\nfunc main {\n\n    /* multi\n line */ x int\n}\n");
+    object->buffer_length = strlen(object->buffer);
+
+    CuAssert(test, "Failed to lex", lex_buffer(&compiler, object) == SUCCESS);
+    CuAssertIntEquals(test, 6, object->newlines_length);
+
+    for(length_t i = 0; i != object->buffer_length; i++){
+        int expected_line, expected_column, actual_line, actual_column;
+        lex_get_location(object->buffer, i, &expected_line, &expected_column);
+        object_get_location(object, i, &actual_line, &actual_column);
+
+        CuAssertIntEquals_Msgf(test, "incorrect line for index %d", expected_line, actual_line, (int) i);
+        CuAssertIntEquals_Msgf(test, "incorrect column for index %d", expected_column, actual_column, (int) i);
+    }
+
+    CuAssertIntEquals(test, 0, object_line_start(object, 1));
+    CuAssertIntEquals(test, 1, object_line_start(object, 2));
+    CuAssertIntEquals(test, 14, object_line_start(object, 4));
+
+    compiler_free(&compiler);
+}
+
+static void TEST_lex_scan_impls(CuTest *test){
+    // Lexing must produce the same tokens no matter which scanning implementation is used
+    const char *source =
+        "func main {\n"
+        "    \t  \t                                        \t  x int = 10 // trailing comment that is long enough to span a few chunks\n"
+        "    an_identifier_that_is_much_longer_than_thirty_two_characters_Z9 = 'c'ub\n"
+        "    name\\space\\thing:more $T $#Count $~T\n"
+        "    /* block comment * with / stars ** and slashes that spans past 32 characters **/ y\n"
+        "    /*/ x */ print(\"escaped \\\" quote \\\\ and \\n newline after enough text to cross a boundary\")\n"
+        "    s *ubyte = 'cstring \\' with escaped quote'\n"
+        "    z := \"\xC3\xA9\xE2\x82\xAC non-ascii\" // \xF0\x9F\x98\x80\n"
+        "}\n";
+
+    lex_scan_impl_t best = lex_scan_get_impl();
+
+    compiler_t compiler;
+    compiler_init(&compiler);
+
+    object_t *expected = compiler_new_object(&compiler);
+    expected->filename = strclone("fake_filename.adept");
+    expected->full_filename = strclone("fake_filename.adept");
+    expected->buffer = strclone(source);
+    expected->buffer_length = strlen(expected->buffer);
+
+    CuAssert(test, "Failed to select scalar scanning", lex_scan_set_impl(LEX_SCAN_SCALAR));
+    CuAssert(test, "Failed to lex", lex_buffer(&compiler, expected) == SUCCESS);
+
+    for(lex_scan_impl_t impl = LEX_SCAN_SCALAR; impl <= LEX_SCAN_AVX2; impl++){
+        if(!lex_scan_set_impl(impl)) continue;
+
+        // Existing tests must also pass with every implementation
+        TEST_lex_1(test);
+        TEST_lex_2(test);
+        TEST_lex_newline_index(test);
+
+        object_t *actual = compiler_new_object(&compiler);
+        actual->filename = strclone("fake_filename.adept");
+        actual->full_filename = strclone("fake_filename.adept");
+        actual->buffer = strclone(source);
+        actual->buffer_length = strlen(actual->buffer);
+
+        CuAssert(test, "Failed to lex", lex_buffer(&compiler, actual) == SUCCESS);
+        CuAssertIntEquals_Msgf(test, "incorrect number of tokens for implementation %d", (int) expected->tokenlist.length, (int) actual->tokenlist.length, (int) impl);
+
+        for(length_t i = 0; i != actual->tokenlist.length; i++){
+            token_t expected_token = tokenlist_token(&expected->tokenlist, i);
+            token_t actual_token = tokenlist_token(&actual->tokenlist, i);
+
+            CuAssertIntEquals_Msgf(test, "incorrect tokens[%d].id", expected_token.id, actual_token.id, (int) i);
+            CuAssertIntEquals_Msgf(test, "incorrect sources[%d].index", expected->tokenlist.spans[i].index, actual->tokenlist.spans[i].index, (int) i);
+            CuAssertIntEquals_Msgf(test, "incorrect sources[%d].stride", expected->tokenlist.spans[i].stride, actual->tokenlist.spans[i].stride, (int) i);
+
+            if(expected_token.id == TOKEN_WORD || expected_token.id == TOKEN_POLYMORPH || expected_token.id == TOKEN_POLYCOUNT){
+                CuAssertStrEquals(test, (char*) expected_token.data, (char*) actual_token.data);
+            } else if(expected_token.id == TOKEN_STRING || expected_token.id == TOKEN_CSTRING){
+                token_string_data_t *expected_string = expected_token.data;
+                token_string_data_t *actual_string = actual_token.data;
+
+                CuAssertIntEquals(test, expected_string->length, actual_string->length);
+                CuAssertTrue(test, memcmp(expected_string->array, actual_string->array, expected_string->length) == 0);
+            }
+        }
+    }
+
+    lex_scan_set_impl(best);
+    compiler_free(&compiler);
+}
+
 CuSuite *CuSuite_for_lex(void){
     CuSuite *suite = CuSuiteNew();
     SUITE_ADD_TEST(suite, TEST_lex_1);
     SUITE_ADD_TEST(suite, TEST_lex_2);
+    SUITE_ADD_TEST(suite, TEST_lex_keyword_index);
+    SUITE_ADD_TEST(suite, TEST_lex_newline_index);
+    SUITE_ADD_TEST(suite, TEST_lex_scan_impls);
     return suite;
 }
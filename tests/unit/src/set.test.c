@@ -0,0 +1,137 @@
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "CuTest.h"
+#include "CuTestExtras.h"
+#include "UTIL/ground.h"
+#include "UTIL/hash.h"
+#include "UTIL/set.h"
+#include "UTIL/util.h"
+
+typedef struct {
+    length_t key;
+    length_t value;
+} set_test_item_t;
+
+static hash_t set_test_hash(const void *item){
+    length_t key = ((const set_test_item_t*) item)->key;
+    return hash_data(&key, sizeof key);
+}
+
+static hash_t set_test_colliding_hash(const void *item){
+    // Only a few different hashes, so most items have to be probed for
+    return ((const set_test_item_t*) item)->key % 4;
+}
+
+static bool set_test_equals(const void *a, const void *b){
+    return ((const set_test_item_t*) a)->key == ((const set_test_item_t*) b)->key;
+}
+
+static set_test_item_t *set_test_items(length_t count){
+    set_test_item_t *items = malloc(sizeof(set_test_item_t) * count);
+
+    for(length_t i = 0; i != count; i++){
+        items[i] = (set_test_item_t){
+            .key = i,
+            .value = i * 3,
+        };
+    }
+
+    return items;
+}
+
+static void set_test_growth(CuTest *test, set_hash_func_t hash_func, length_t count){
+    set_test_item_t *items = set_test_items(count);
+
+    set_t set;
+    set_init(&set, 0, hash_func, &set_test_equals, NULL);
+    length_t starting_capacity = set.capacity;
+
+    for(length_t i = 0; i != count; i++){
+        CuAssertTrue(test, set_insert(&set, &items[i]));
+        CuAssertIntEquals(test, i + 1, set.count);
+
+        // Load factor must stay at or below 3/4
+        CuAssertTrue(test, set.count <= set.capacity / 4 * 3);
+    }
+
+    CuAssertTrue(test, set.capacity > starting_capacity);
+    CuAssertTrue(test, (set.capacity & (set.capacity - 1)) == 0);
+
+    // Everything must still be found after being moved around by growing
+    for(length_t i = 0; i != count; i++){
+        set_test_item_t *found = set_find(&set, &(set_test_item_t){ .key = i });
+        CuAssertPtrEquals(test, &items[i], found);
+        CuAssertIntEquals_Msgf(test, "incorrect value for key %d", i * 3, found->value, (int) i);
+    }
+
+    set_free(&set, NULL);
+    free(items);
+}
+
+static void TEST_set_growth(CuTest *test){
+    set_test_growth(test, &set_test_hash, 1000);
+}
+
+static void TEST_set_growth_with_collisions(CuTest *test){
+    set_test_growth(test, &set_test_colliding_hash, 200);
+}
+
+static void TEST_set_duplicates(CuTest *test){
+    set_test_item_t first = { .key = 7, .value = 1 };
+    set_test_item_t second = { .key = 7, .value = 2 };
+
+    set_t set;
+    set_init(&set, 4, &set_test_hash, &set_test_equals, NULL);
+
+    // The first item inserted wins
+    CuAssertTrue(test, set_insert(&set, &first));
+    CuAssertTrue(test, !set_insert(&set, &second));
+    CuAssertTrue(test, !set_insert_hashed(&set, &second, set_test_hash(&second)));
+    CuAssertIntEquals(test, 1, set.count);
+
+    set_test_item_t *found = set_find(&set, &(set_test_item_t){ .key = 7 });
+    CuAssertPtrEquals(test, &first, found);
+    CuAssertIntEquals(test, 1, found->value);
+
+    set_free(&set, NULL);
+}
+
+static void TEST_set_misses(CuTest *test){
+    // Zero-initialized sets are empty
+    set_t empty = {0};
+    CuAssertPtrEquals(test, NULL, set_find(&empty, &(set_test_item_t){ .key = 0 }));
+    CuAssertTrue(test, !set_contains(&empty, &(set_test_item_t){ .key = 0 }));
+    set_free(&empty, NULL);
+
+    set_test_item_t *items = set_test_items(100);
+
+    set_t set;
+    set_init(&set, 0, &set_test_colliding_hash, &set_test_equals, NULL);
+
+    // Only even keys are inserted
+    for(length_t i = 0; i != 100; i += 2){
+        set_insert(&set, &items[i]);
+    }
+
+    for(length_t i = 0; i != 100; i++){
+        set_test_item_t probe = { .key = i };
+        CuAssertTrue(test, set_contains(&set, &probe) == (i % 2 == 0));
+        CuAssertTrue(test, (set_find_hashed(&set, &probe, set_test_colliding_hash(&probe)) != NULL) == (i % 2 == 0));
+    }
+
+    CuAssertPtrEquals(test, NULL, set_find(&set, &(set_test_item_t){ .key = 1000 }));
+
+    set_free(&set, NULL);
+    free(items);
+}
+
+CuSuite *CuSuite_for_set(void){
+    CuSuite *suite = CuSuiteNew();
+    SUITE_ADD_TEST(suite, TEST_set_growth);
+    SUITE_ADD_TEST(suite, TEST_set_growth_with_collisions);
+    SUITE_ADD_TEST(suite, TEST_set_duplicates);
+    SUITE_ADD_TEST(suite, TEST_set_misses);
+    return suite;
+}
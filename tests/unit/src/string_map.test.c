@@ -0,0 +1,104 @@
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "CuTest.h"
+#include "UTIL/ground.h"
+#include "UTIL/string.h"
+#include "UTIL/string_map.h"
+#include "UTIL/util.h"
+
+static strong_cstr_t *string_map_test_keys(length_t count){
+    strong_cstr_t *keys = malloc(sizeof(strong_cstr_t) * count);
+
+    for(length_t i = 0; i != count; i++){
+        keys[i] = mallocandsprintf("key%d", (int) i);
+    }
+
+    return keys;
+}
+
+static void string_map_test_free_keys(strong_cstr_t *keys, length_t count){
+    for(length_t i = 0; i != count; i++){
+        free(keys[i]);
+    }
+    free(keys);
+}
+
+static void TEST_string_map_growth(CuTest *test){
+    length_t count = 1000;
+    strong_cstr_t *keys = string_map_test_keys(count);
+    int values[1000];
+
+    string_map_t map;
+    string_map_init(&map, 0);
+    length_t starting_capacity = map.impl.capacity;
+
+    for(length_t i = 0; i != count; i++){
+        CuAssertTrue(test, string_map_insert(&map, keys[i], &values[i]));
+    }
+
+    CuAssertTrue(test, map.impl.capacity > starting_capacity);
+    CuAssertIntEquals(test, count, map.impl.count);
+
+    // Lookups use the contents of keys, not their addresses
+    for(length_t i = 0; i != count; i++){
+        strong_cstr_t key = strclone(keys[i]);
+        CuAssertPtrEquals(test, &values[i], string_map_find(&map, key));
+        CuAssertTrue(test, string_map_has(&map, key));
+        free(key);
+    }
+
+    string_map_free(&map);
+    string_map_test_free_keys(keys, count);
+}
+
+static void TEST_string_map_duplicates(CuTest *test){
+    int first, second;
+
+    // Zero-initialized string maps can be inserted into
+    string_map_t map = {0};
+
+    // The first value inserted for a key wins
+    CuAssertTrue(test, string_map_insert(&map, "name", &first));
+    CuAssertTrue(test, !string_map_insert(&map, "name", &second));
+    CuAssertIntEquals(test, 1, map.impl.count);
+    CuAssertPtrEquals(test, &first, string_map_find(&map, "name"));
+
+    string_map_free(&map);
+}
+
+static void TEST_string_map_misses(CuTest *test){
+    // Zero-initialized string maps are empty
+    string_map_t empty = {0};
+    CuAssertPtrEquals(test, NULL, string_map_find(&empty, "anything"));
+    CuAssertTrue(test, !string_map_has(&empty, "anything"));
+    string_map_free(&empty);
+
+    length_t count = 100;
+    strong_cstr_t *keys = string_map_test_keys(count);
+    int value;
+
+    string_map_t map;
+    string_map_init(&map, 0);
+
+    for(length_t i = 0; i != count; i++){
+        string_map_insert(&map, keys[i], &value);
+    }
+
+    CuAssertPtrEquals(test, NULL, string_map_find(&map, "key100"));
+    CuAssertPtrEquals(test, NULL, string_map_find(&map, "key"));
+    CuAssertPtrEquals(test, NULL, string_map_find(&map, ""));
+    CuAssertTrue(test, !string_map_has(&map, "Key0"));
+
+    string_map_free(&map);
+    string_map_test_free_keys(keys, count);
+}
+
+CuSuite *CuSuite_for_string_map(void){
+    CuSuite *suite = CuSuiteNew();
+    SUITE_ADD_TEST(suite, TEST_string_map_growth);
+    SUITE_ADD_TEST(suite, TEST_string_map_duplicates);
+    SUITE_ADD_TEST(suite, TEST_string_map_misses);
+    return suite;
+}